@@ -49,6 +49,9 @@ typedef NS_ENUM(NSUInteger, OCAuthenticationMethodType)
 
 	@private
 	id _cachedAuthenticationSecret;
+
+	dispatch_source_t _tokenRefreshTimer;
+	__weak OCConnection *_tokenRefreshConnection;
 }
 
 #pragma mark - Registration
@@ -97,6 +100,12 @@ typedef NS_ENUM(NSUInteger, OCAuthenticationMethodType)
 #pragma mark - Wait for authentication
 - (BOOL)canSendAuthenticatedRequestsForConnection:(OCConnection *)connection withAvailabilityHandler:(OCConnectionAuthenticationAvailabilityHandler)availabilityHandler; //!< This method is called by the -[OCConnection canSendAuthenticatedRequestsForQueue:availabilityHandler:] to determine if the authentication method is currently in the position to authenticate requests for the given connection. If it is, YES should be returned and the availabilityHandler shouldn't be used. If it is not (if, f.ex. a token has expired and needs to be renewed first), this method should return NO, attempt the necessary changes (if this involves scheduling requests, make sure these don't have OCConnectionSignalIDAuthenticationAvailable in their requiredSignals) and then call the availabilityHandler with the outcome. If an error is returned, all queued requests fail with the provided error.
 
+#pragma mark - Scheduled token refresh
+- (nullable NSDate *)tokenRefreshDateForConnection:(OCConnection *)connection; //!< The date at which the authentication data should be refreshed proactively - or nil if no proactive refresh is needed. Implemented by subclasses, the default implementation returns nil.
+- (void)refreshTokenForConnection:(OCConnection *)connection completionHandler:(void(^)(NSError * _Nullable error))completionHandler; //!< Refreshes the authentication data of the connection without holding back requests. Implementations need to coalesce concurrent refreshes - including those from other processes. Implemented by subclasses, the default implementation returns without error.
+- (void)scheduleTokenRefreshForConnection:(OCConnection *)connection; //!< (Re)schedules a proactive refresh for the date returned by -tokenRefreshDateForConnection:. Called after authenticating the connection and whenever the authentication data changes.
+- (void)cancelScheduledTokenRefresh; //!< Cancels a scheduled proactive refresh. Called when deauthenticating the connection.
+
 #pragma mark - Handle responses before they are delivered to the request senders
 - (nullable NSError *)handleRequest:(OCHTTPRequest *)request response:(OCHTTPResponse *)response forConnection:(OCConnection *)connection withError:(NSError *)error; //!< This method is called for every finished request before the response gets delivered to the sender. Gives the authentication method a chance to get knowledge of and react to error infos contained in response
 
@@ -138,6 +138,11 @@
 
 - (void)dealloc
 {
+	if (_tokenRefreshTimer != nil)
+	{
+		dispatch_source_cancel(_tokenRefreshTimer);
+	}
+
 	[[OCIPNotificationCenter sharedNotificationCenter] removeObserver:self forName:OCBookmark.bookmarkAuthUpdateNotificationName];
 
 	[[NSNotificationCenter defaultCenter] removeObserver:self name:OCBookmarkAuthenticationDataChangedNotification object:nil];
@@ -170,6 +175,19 @@
 	OCLogDebug(@"Received %@ notification to flush auth secret", (remotely ? @"remote" : @"local"));
 
 	[self flushCachedAuthenticationSecret];
+
+	// Reschedule proactive token refresh for the changed authentication data
+	OCConnection *tokenRefreshConnection;
+
+	@synchronized(self)
+	{
+		tokenRefreshConnection = _tokenRefreshConnection;
+	}
+
+	if (tokenRefreshConnection != nil)
+	{
+		[self scheduleTokenRefreshForConnection:tokenRefreshConnection];
+	}
 }
 
 #pragma mark - Authentication Method Detection
@@ -190,6 +208,8 @@
 - (void)authenticateConnection:(OCConnection *)connection withCompletionHandler:(OCAuthenticationMethodAuthenticationCompletionHandler)completionHandler
 {
 	// Implemented by subclasses
+	[self scheduleTokenRefreshForConnection:connection];
+
 	if (completionHandler != nil)
 	{
 		completionHandler(nil,nil);
@@ -199,6 +219,8 @@
 - (void)deauthenticateConnection:(OCConnection *)connection withCompletionHandler:(OCAuthenticationMethodAuthenticationCompletionHandler)completionHandler
 {
 	// Implemented by subclasses
+	[self cancelScheduledTokenRefresh];
+
 	if (completionHandler != nil)
 	{
 		completionHandler(nil,nil);
@@ -209,6 +231,16 @@
 {
 	NSError *error = nil;
 	NSDictionary<NSString *, NSString *> *authHeaders;
+	NSDate *holdBackDate;
+
+	// Report time the request was held back waiting for authentication to become available (f.ex. during a token refresh)
+	if ((holdBackDate = request.authenticationHoldBackDate) != nil)
+	{
+		request.authenticationStallTime = -holdBackDate.timeIntervalSinceNow;
+		request.authenticationHoldBackDate = nil;
+
+		OCLogDebug(@"Request %@ was held back for %.3f sec waiting for authentication", request.identifier, request.authenticationStallTime);
+	}
 
 	if ((authHeaders = [self authorizationHeadersForConnection:connection error:&error]) != nil)
 	{
@@ -305,6 +337,117 @@
 	return (YES);
 }
 
+#pragma mark - Scheduled token refresh
+- (NSDate *)tokenRefreshDateForConnection:(OCConnection *)connection
+{
+	return (nil);
+}
+
+- (void)refreshTokenForConnection:(OCConnection *)connection completionHandler:(void (^)(NSError * _Nullable))completionHandler
+{
+	// Implemented by subclasses
+	if (completionHandler != nil)
+	{
+		completionHandler(nil);
+	}
+}
+
+- (void)scheduleTokenRefreshForConnection:(OCConnection *)connection
+{
+	NSDate *refreshDate = [self tokenRefreshDateForConnection:connection];
+
+	@synchronized(self)
+	{
+		_tokenRefreshConnection = connection;
+
+		if (_tokenRefreshTimer != nil)
+		{
+			dispatch_source_cancel(_tokenRefreshTimer);
+			_tokenRefreshTimer = nil;
+		}
+
+		if (refreshDate != nil)
+		{
+			__weak OCAuthenticationMethod *weakSelf = self;
+			NSTimeInterval delay = MAX(refreshDate.timeIntervalSinceNow, 0);
+
+			// Use wall time, so the timer also fires on time after the device has been asleep
+			_tokenRefreshTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0));
+			dispatch_source_set_timer(_tokenRefreshTimer, dispatch_walltime(NULL, (int64_t)(delay * NSEC_PER_SEC)), DISPATCH_TIME_FOREVER, 5 * NSEC_PER_SEC);
+			dispatch_source_set_event_handler(_tokenRefreshTimer, ^{
+				[weakSelf _performScheduledTokenRefresh];
+			});
+			dispatch_resume(_tokenRefreshTimer);
+
+			OCLogDebug(@"Scheduled proactive token refresh for %@", refreshDate);
+		}
+	}
+}
+
+- (void)cancelScheduledTokenRefresh
+{
+	@synchronized(self)
+	{
+		_tokenRefreshConnection = nil;
+
+		if (_tokenRefreshTimer != nil)
+		{
+			dispatch_source_cancel(_tokenRefreshTimer);
+			_tokenRefreshTimer = nil;
+		}
+	}
+}
+
+- (void)_performScheduledTokenRefresh
+{
+	OCConnection *connection;
+	NSDate *refreshDate;
+
+	@synchronized(self)
+	{
+		if (_tokenRefreshTimer != nil)
+		{
+			dispatch_source_cancel(_tokenRefreshTimer);
+			_tokenRefreshTimer = nil;
+		}
+
+		connection = _tokenRefreshConnection;
+	}
+
+	if (connection == nil)
+	{
+		return;
+	}
+
+	// The authentication data may have been refreshed in the meantime (f.ex. by another process)
+	if ((refreshDate = [self tokenRefreshDateForConnection:connection]) == nil)
+	{
+		return;
+	}
+
+	if (refreshDate.timeIntervalSinceNow > 0)
+	{
+		[self scheduleTokenRefreshForConnection:connection];
+		return;
+	}
+
+	OCLogDebug(@"Performing scheduled token refresh");
+
+	__weak OCAuthenticationMethod *weakSelf = self;
+
+	[self refreshTokenForConnection:connection completionHandler:^(NSError * _Nullable error) {
+		if (error != nil)
+		{
+			// Leave it to the refresh performed around expiration or following an UNAUTHORIZED response
+			OCWLogWarning(@"Scheduled token refresh failed with error=%@", error);
+		}
+		else
+		{
+			[weakSelf scheduleTokenRefreshForConnection:connection];
+		}
+	}];
+}
+
 #pragma mark - Handle responses before they are delivered to the request senders
 - (NSError *)handleRequest:(OCHTTPRequest *)request response:(OCHTTPResponse *)response forConnection:(OCConnection *)connection withError:(NSError *)error
 {
@@ -70,5 +70,6 @@ extern OCClassSettingsKey OCAuthenticationMethodOAuth2ClientSecret;
 extern OCClassSettingsKey OCAuthenticationMethodOAuth2ExpirationOverrideSeconds;
 extern OCClassSettingsKey OCAuthenticationMethodOAuth2OmitAuthorizationParameters;
 extern OCClassSettingsKey OCAuthenticationMethodOAuth2PostClientIDAndSecret;
+extern OCClassSettingsKey OCAuthenticationMethodOAuth2TokenRefreshLifetimeFraction;
 
 NS_ASSUME_NONNULL_END
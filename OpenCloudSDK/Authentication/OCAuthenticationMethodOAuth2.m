@@ -94,6 +94,8 @@ static Class sBrowserSessionClass;
 	id _authenticationSession;
 	BOOL _receivedUnauthorizedResponse;
 	BOOL _tokenRefreshFollowingUnauthorizedResponseFailed;
+
+	NSMutableArray<OCConnectionAuthenticationAvailabilityHandler> *_pendingTokenRefreshAvailabilityHandlers;
 }
 @end
 
@@ -116,7 +118,8 @@ OCAuthenticationMethodAutoRegister
 		OCAuthenticationMethodOAuth2RedirectURI 	  : @"oc://ios.opencloud.eu",
 		OCAuthenticationMethodOAuth2ClientID 		  : @"OpenCloudIOS",
 		OCAuthenticationMethodOAuth2ClientSecret 	  : @"",
-		OCAuthenticationMethodOAuth2PostClientIDAndSecret : @(NO)
+		OCAuthenticationMethodOAuth2PostClientIDAndSecret : @(NO),
+		OCAuthenticationMethodOAuth2TokenRefreshLifetimeFraction : @(0.75)
 	});
     // Ref https://github.com/opencloud-eu/opencloud/blob/main/services/idp/pkg/config/defaults/defaultconfig.go#L106
 }
@@ -172,6 +175,12 @@ OCAuthenticationMethodAutoRegister
 			OCClassSettingsMetadataKeyDescription 	: @"Send Client ID and Client Secret in the body of POST requests to the token endpoint. As per RFC 6749 section 2.3.1, this should only be used if the token endpoint does not support receiving these via Basic authentication.",
 			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
 			OCClassSettingsMetadataKeyCategory	: @"OAuth2"
+		},
+		OCAuthenticationMethodOAuth2TokenRefreshLifetimeFraction : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeFloat,
+			OCClassSettingsMetadataKeyDescription 	: @"Fraction of a token's lifetime after which it is refreshed proactively in the background, without holding back requests. A value of 0 or 1 disables proactive refreshes, leaving refreshes to happen shortly before expiration.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"OAuth2"
 		}
 	});
 }
@@ -764,21 +773,147 @@ OCAuthenticationMethodAutoRegister
 - (void)_refreshTokenForConnection:(OCConnection *)connection availabilityHandler:(OCConnectionAuthenticationAvailabilityHandler)availabilityHandler
 {
 	__weak OCAuthenticationMethodOAuth2 *weakSelf = self;
+	OCAuthenticationDataID staleAuthenticationDataID;
+	NSMutableArray<OCConnectionAuthenticationAvailabilityHandler> *pendingAvailabilityHandlers;
+
+	// Coalesce concurrent refreshes (f.ex. scheduled and request-triggered) into a single one
+	@synchronized(self)
+	{
+		BOOL refreshInProgress = (_pendingTokenRefreshAvailabilityHandlers != nil);
+
+		if (!refreshInProgress)
+		{
+			_pendingTokenRefreshAvailabilityHandlers = [NSMutableArray new];
+		}
+
+		if (availabilityHandler != nil)
+		{
+			[_pendingTokenRefreshAvailabilityHandlers addObject:[availabilityHandler copy]];
+		}
+
+		if (refreshInProgress)
+		{
+			OCLogDebug(@"Token refresh already in progress - waiting for its outcome");
+			return;
+		}
+
+		pendingAvailabilityHandlers = _pendingTokenRefreshAvailabilityHandlers;
+	}
+
+	// Remember the authentication data that needs a refresh
+	[self cachedAuthenticationSecretForConnection:connection];
+	staleAuthenticationDataID = self.cachedAuthenticationDataID;
 
 	OCLockRequest *lockRequest = [[OCLockRequest alloc] initWithResourceIdentifier:[NSString stringWithFormat:@"authentication-data-update:%@", connection.bookmark.uuid.UUIDString] acquiredHandler:^(NSError * _Nullable error, OCLock * _Nullable lock) {
-		// Wait for exclusive lock on authentication data before performing the refresh
-		[weakSelf __refreshTokenForConnection:connection availabilityHandler:^(NSError *error, BOOL authenticationIsAvailable) {
-			// Invoke original availabilityHandler
-			availabilityHandler(error, authenticationIsAvailable);
+		OCAuthenticationMethodOAuth2 *strongSelf;
+
+		if ((strongSelf = weakSelf) == nil)
+		{
+			// Authentication method was deallocated while waiting for the lock - don't leave the waiting requests hanging
+			for (OCConnectionAuthenticationAvailabilityHandler availabilityHandler in pendingAvailabilityHandlers)
+			{
+				availabilityHandler(OCError(OCErrorInternal), NO);
+			}
+
+			[lock releaseLock];
+			return;
+		}
+
+		OCConnectionAuthenticationAvailabilityHandler refreshCompletionHandler = ^(NSError *error, BOOL authenticationIsAvailable) {
+			NSArray<OCConnectionAuthenticationAvailabilityHandler> *availabilityHandlers;
+
+			@synchronized(strongSelf)
+			{
+				availabilityHandlers = strongSelf->_pendingTokenRefreshAvailabilityHandlers;
+				strongSelf->_pendingTokenRefreshAvailabilityHandlers = nil;
+			}
+
+			// Invoke original availabilityHandlers
+			for (OCConnectionAuthenticationAvailabilityHandler availabilityHandler in availabilityHandlers)
+			{
+				availabilityHandler(error, authenticationIsAvailable);
+			}
 
 			// Release lock
 			[lock releaseLock];
-		}];
+		};
+
+		// Wait for exclusive lock on authentication data before performing the refresh - and skip the refresh if another process already performed it while waiting for the lock
+		if ([strongSelf _authenticationDataForConnection:connection wasRefreshedSince:staleAuthenticationDataID])
+		{
+			OCLogDebug(@"Token was refreshed elsewhere in the meantime - using the refreshed token");
+
+			strongSelf->_receivedUnauthorizedResponse = NO;
+			strongSelf->_tokenRefreshFollowingUnauthorizedResponseFailed = NO;
+
+			refreshCompletionHandler(nil, YES);
+		}
+		else
+		{
+			[strongSelf __refreshTokenForConnection:connection availabilityHandler:refreshCompletionHandler];
+		}
 	}];
 
 	[OCLockManager.sharedLockManager requestLock:lockRequest];
 }
 
+- (BOOL)_authenticationDataForConnection:(OCConnection *)connection wasRefreshedSince:(OCAuthenticationDataID)staleAuthenticationDataID
+{
+	NSDictionary<NSString *, id> *authSecret;
+
+	// Read the authentication data from the keychain, where another process may have stored a refreshed token
+	[connection.bookmark considerAuthenticationDataFlush];
+	[self flushCachedAuthenticationSecret];
+
+	if ((staleAuthenticationDataID != nil) &&
+	    ((authSecret = [self cachedAuthenticationSecretForConnection:connection]) != nil) &&
+	    OCNANotEqual(self.cachedAuthenticationDataID, staleAuthenticationDataID))
+	{
+		NSTimeInterval timeLeftUntilExpiration = [((NSDate *)[authSecret valueForKeyPath:OA2ExpirationDate]) timeIntervalSinceNow];
+
+		return (timeLeftUntilExpiration > OA2RefreshSafetyMarginInSeconds);
+	}
+
+	return (NO);
+}
+
+#pragma mark - Scheduled token refresh
+- (NSDate *)tokenRefreshDateForConnection:(OCConnection *)connection
+{
+	NSDictionary<NSString *, id> *authSecret;
+	double lifetimeFraction = [[self classSettingForOCClassSettingsKey:OCAuthenticationMethodOAuth2TokenRefreshLifetimeFraction] doubleValue];
+
+	if ((lifetimeFraction <= 0) || (lifetimeFraction >= 1))
+	{
+		// Proactive refresh disabled
+		return (nil);
+	}
+
+	if ((authSecret = [self cachedAuthenticationSecretForConnection:connection]) != nil)
+	{
+		NSDate *expirationDate = OCTypedCast([authSecret valueForKeyPath:OA2ExpirationDate], NSDate);
+		NSNumber *expiresInSeconds = OCTypedCast([authSecret valueForKeyPath:OA2ExpirationTimePeriod], NSNumber);
+
+		if ((expirationDate != nil) && (expiresInSeconds.doubleValue > 0) && ([authSecret valueForKeyPath:OA2RefreshToken] != nil))
+		{
+			// Refresh once lifetimeFraction of the token's lifetime has passed
+			return ([expirationDate dateByAddingTimeInterval:-(expiresInSeconds.doubleValue * (1.0 - lifetimeFraction))]);
+		}
+	}
+
+	return (nil);
+}
+
+- (void)refreshTokenForConnection:(OCConnection *)connection completionHandler:(void (^)(NSError * _Nullable))completionHandler
+{
+	[self _refreshTokenForConnection:connection availabilityHandler:^(NSError *error, BOOL authenticationIsAvailable) {
+		if (completionHandler != nil)
+		{
+			completionHandler(error);
+		}
+	}];
+}
+
 - (void)__refreshTokenForConnection:(OCConnection *)connection availabilityHandler:(OCConnectionAuthenticationAvailabilityHandler)availabilityHandler
 {
 	NSDictionary<NSString *, id> *authSecret;
@@ -1179,3 +1314,4 @@ OCClassSettingsKey OCAuthenticationMethodOAuth2ClientSecret = @"oa2-client-secre
 OCClassSettingsKey OCAuthenticationMethodOAuth2ExpirationOverrideSeconds = @"oa2-expiration-override-seconds";
 OCClassSettingsKey OCAuthenticationMethodOAuth2OmitAuthorizationParameters = @"omit-authorization-parameters";
 OCClassSettingsKey OCAuthenticationMethodOAuth2PostClientIDAndSecret = @"post-client-id-and-secret";
+OCClassSettingsKey OCAuthenticationMethodOAuth2TokenRefreshLifetimeFraction = @"oa2-token-refresh-lifetime-fraction";
@@ -80,6 +80,9 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)setValuesFrom:(OCBookmark *)sourceBookmark; //!< Replaces all values in the receiving bookmark with those in the source bookmark.
 - (void)setLastUserName:(nullable NSString *)userName; //!< Replaces the internally stored fallback user name returned by .userName for when no authentication data is available.
 
+#pragma mark - Authentication data
+- (void)considerAuthenticationDataFlush; //!< Drops the in-memory copy of keychain-backed .authenticationData, so it is read from the keychain on next access.
+
 #pragma mark - Capabilities
 @property(strong,nullable,nonatomic) NSSet<OCBookmarkCapability> *capabilities;
 - (void)addCapability:(OCBookmarkCapability)capability;
@@ -98,6 +101,7 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 extern OCBookmarkUserInfoKey OCBookmarkUserInfoKeyStatusInfo; //!<  .userInfo key with a NSDictionary holding the info from "status.php".
+extern OCBookmarkUserInfoKey OCBookmarkUserInfoKeyCapabilities; //!<  .userInfo key with NSData holding the JSON of the capabilities last retrieved from the server. Used for fast connects.
 extern OCBookmarkUserInfoKey OCBookmarkUserInfoKeyAllowHTTPConnection; //!< .userInfo key with a NSDate value. To be set to the date that the user was informed and allowed the usage of HTTP. To be removed otherwise.
 extern OCBookmarkUserInfoKey OCBookmarkUserInfoKeyBookmarkCreation; //!<  .userInfo key with a NSDictionary holding information on the creation of the bookmark.
 
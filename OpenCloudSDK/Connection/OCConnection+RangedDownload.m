@@ -0,0 +1,494 @@
+//
+//  OCConnection+RangedDownload.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCConnection.h"
+#import "OCRangedDownloadJob.h"
+#import "NSError+OCError.h"
+#import "OCLogger.h"
+#import "OCMacros.h"
+#import "NSProgress+OCEvent.h"
+#import "NSProgress+OCExtensions.h"
+#import "OCHTTPResponse+DAVError.h"
+#import "OCFile.h"
+
+typedef NSString* OCRangedDownloadInfoKey;
+
+static OCRangedDownloadInfoKey OCRangedDownloadInfoKeyJob = @"job";
+static OCRangedDownloadInfoKey OCRangedDownloadInfoKeyRangeIndex = @"range";
+
+@interface OCConnection (Download)
+- (NSError *)_errorForDownloadRequest:(OCHTTPRequest *)request item:(nullable OCItem *)item; // implemented in OCConnection.m
+@end
+
+@implementation OCConnection (RangedDownload)
+
+/*
+	Ranged downloads:
+	- files at or above OCConnectionRangedDownloadThreshold are split into ranges of OCConnectionRangedDownloadRangeSize bytes
+	- up to OCConnectionRangedDownloadMaximumConcurrentRanges ranges are requested concurrently through the transfer pipeline
+	- each range is written into the preallocated target file as soon as it arrives, and the completed ranges
+	  are persisted to a checkpoint file next to it (see OCRangedDownloadJob), so that a later download to the
+	  same target URL only requests the missing ranges
+	- every range request carries an If-Range header with the ETag of the item. If the file changed on the server,
+	  the server responds with the entire (new) file instead of the range, the partial download is discarded and
+	  the download ends with an OCErrorItemChanged error
+	- until the server confirmed range support by responding with the requested Content-Range, only a single range
+	  is requested. If the server responds with the entire file instead, that file is used. If it responds without
+	  Content-Range, the file is downloaded with a single, non-ranged request.
+	- if a range fails, all other ranges still in flight are cancelled and the job ends with that error
+*/
+
+#pragma mark - Job registry
++ (NSMutableDictionary<NSString *, OCRangedDownloadJob *> *)_rangedDownloadJobsByID
+{
+	static dispatch_once_t onceToken;
+	static NSMutableDictionary<NSString *, OCRangedDownloadJob *> *jobsByID;
+
+	dispatch_once(&onceToken, ^{
+		jobsByID = [NSMutableDictionary new];
+	});
+
+	return (jobsByID);
+}
+
+- (OCRangedDownloadJob *)_registeredRangedDownloadJobFor:(OCRangedDownloadJob *)requestJob
+{
+	NSMutableDictionary<NSString *, OCRangedDownloadJob *> *jobsByID = OCConnection._rangedDownloadJobsByID;
+	OCRangedDownloadJob *job = nil;
+
+	if (requestJob.jobID == nil)
+	{
+		return (nil);
+	}
+
+	@synchronized(jobsByID)
+	{
+		if (requestJob.ended)
+		{
+			// Job has already ended (f.ex. due to an error in another range) => ignore
+			return (nil);
+		}
+
+		if ((job = jobsByID[requestJob.jobID]) == nil)
+		{
+			// Result for a job not known to this process (f.ex. after relaunch) => adopt it with the latest checkpointed state
+			NSData *checkpointData;
+
+			if ((checkpointData = [NSData dataWithContentsOfURL:requestJob.checkpointURL]) != nil)
+			{
+				job = [NSKeyedUnarchiver unarchivedObjectOfClass:OCRangedDownloadJob.class fromData:checkpointData error:NULL];
+			}
+
+			if ((job == nil) || ![job.jobID isEqual:requestJob.jobID] || job.ended)
+			{
+				// Checkpoint was removed, taken over by a newer run of the download - or the job ended before the relaunch
+				return (nil);
+			}
+
+			jobsByID[job.jobID] = job;
+		}
+	}
+
+	return (job);
+}
+
+- (BOOL)_endRangedDownloadJob:(OCRangedDownloadJob *)job
+{
+	NSMutableDictionary<NSString *, OCRangedDownloadJob *> *jobsByID = OCConnection._rangedDownloadJobsByID;
+	BOOL wasActive = NO;
+
+	@synchronized(jobsByID)
+	{
+		wasActive = !job.ended;
+		job.ended = YES;
+
+		[jobsByID removeObjectForKey:job.jobID];
+	}
+
+	if (wasActive)
+	{
+		// Cancel ranges that are still in flight
+		for (OCHTTPRequest *request in [job removeAllScheduledRequests])
+		{
+			[request.progress.progress cancel];
+		}
+
+		[self finishActionWithTrackingID:job.trackingID];
+	}
+
+	return (wasActive); // only the first caller to end a job gets YES and delivers the result
+}
+
+#pragma mark - Eligibility
++ (BOOL)shouldDownloadItemInRanges:(OCItem *)item
+{
+	NSNumber *threshold = OCTypedCast([self classSettingForOCClassSettingsKey:OCConnectionRangedDownloadThreshold], NSNumber);
+
+	return ((threshold.unsignedLongLongValue > 0) && (item.size > 0) && (item.eTag != nil) && ((unsigned long long)item.size >= threshold.unsignedLongLongValue));
+}
+
+#pragma mark - Download
+- (OCProgress *)downloadItemInRanges:(OCItem *)item to:(NSURL *)targetURL options:(OCConnectionOptions)options resultTarget:(OCEventTarget *)eventTarget
+{
+	OCActionTrackingID actionTrackingID = OCConnectionInferActionTrackingID(options, eventTarget);
+	OCRangedDownloadJob *job;
+	NSError *error = nil;
+
+	if (item == nil)
+	{
+		return (nil);
+	}
+
+	if (actionTrackingID == nil)
+	{
+		// Progress of the ranges is aggregated via the action tracking ID
+		actionTrackingID = NSUUID.UUID.UUIDString;
+	}
+
+	// Resume from checkpoint - or start a new job
+	if ((job = [OCRangedDownloadJob checkpointedJobForItem:item targetURL:targetURL]) != nil)
+	{
+		OCLogDebug(@"Resuming ranged download %@", job);
+	}
+	else
+	{
+		NSNumber *rangeSize = OCTypedCast([self classSettingForOCClassSettingsKey:OCConnectionRangedDownloadRangeSize], NSNumber);
+
+		job = [[OCRangedDownloadJob alloc] initWithItem:item targetURL:targetURL rangeSize:rangeSize.unsignedLongLongValue];
+	}
+
+	job.eventTarget = eventTarget;
+	job.trackingID = actionTrackingID;
+	job.requiredCellularSwitch = options[OCConnectionOptionRequiredCellularSwitchKey];
+
+	if (![job preallocateTargetWithError:&error])
+	{
+		[eventTarget handleError:error type:OCEventTypeDownload uuid:nil sender:self];
+		return (nil);
+	}
+
+	@synchronized(OCConnection._rangedDownloadJobsByID)
+	{
+		OCConnection._rangedDownloadJobsByID[job.jobID] = job;
+	}
+
+	// Set up progress
+	NSProgress *actionProgress = [self progressForActionTrackingID:actionTrackingID provider:^NSProgress * _Nonnull(NSProgress * _Nonnull progress) {
+		progress.totalUnitCount = (int64_t)job.fileSize;
+		progress.completedUnitCount = (int64_t)job.completedBytes;
+
+		return (progress);
+	}];
+
+	actionProgress.eventType = OCEventTypeDownload;
+	actionProgress.localizedDescription = [NSString stringWithFormat:OCLocalizedString(@"Downloading %@…",nil), item.name];
+
+	OCProgress *downloadProgress = [[OCProgress alloc] initWithPath:((self.bookmark.uuid != nil) ?
+								@[ OCProgressPathElementIdentifierCoreRoot, self.bookmark.uuid.UUIDString, OCProgressPathElementIdentifierCoreConnectionPath, actionTrackingID ] :
+								@[])
+							   progress:actionProgress];
+
+	OCLogDebug(@"Starting ranged download %@", job);
+
+	// Attach to pipelines
+	[self attachToPipelines];
+
+	// Schedule ranges
+	[self _continueRangedDownloadJob:job];
+
+	return (downloadProgress);
+}
+
+- (void)_continueRangedDownloadJob:(OCRangedDownloadJob *)job
+{
+	NSUInteger maxConcurrentRanges = OCTypedCast([self classSettingForOCClassSettingsKey:OCConnectionRangedDownloadMaximumConcurrentRanges], NSNumber).unsignedIntegerValue;
+	NSMutableArray<OCHTTPRequest *> *requests = [NSMutableArray new];
+	NSURL *downloadURL = [[self URLForEndpoint:OCConnectionEndpointIDWebDAVRoot options:@{ OCConnectionEndpointURLOptionDriveID : OCNullProtect(job.item.driveID) }] URLByAppendingPathComponent:job.item.path];
+	BOOL isComplete = NO, hasScheduledRanges = NO;
+
+	if (maxConcurrentRanges == 0)
+	{
+		maxConcurrentRanges = 1;
+	}
+
+	if (downloadURL == nil)
+	{
+		// WebDAV root could not be generated (likely due to lack of username)
+		if ([self _endRangedDownloadJob:job])
+		{
+			[job.eventTarget handleError:OCError(OCErrorInternal) type:OCEventTypeDownload uuid:nil sender:self];
+		}
+		return;
+	}
+
+	if (!job.rangeSupportConfirmed)
+	{
+		// Probe range support with a single range first
+		maxConcurrentRanges = 1;
+	}
+
+	@synchronized(job)
+	{
+		if ((isComplete = job.isComplete) == YES)
+		{
+			hasScheduledRanges = (job.scheduledRanges.count > 0);
+		}
+		else if (job.singleDownload)
+		{
+			// Server doesn't support ranges => download the entire file with a single request (tracked as range 0)
+			if (job.scheduledRanges.count == 0)
+			{
+				OCHTTPRequest *request = [OCHTTPRequest requestWithURL:downloadURL];
+
+				request.method = OCHTTPMethodGET;
+				request.requiredSignals = self.actionSignals;
+
+				request.resultHandlerAction = @selector(_handleRangedDownloadResult:error:);
+				request.userInfo = @{
+					OCRangedDownloadInfoKeyJob : job,
+					OCRangedDownloadInfoKeyRangeIndex : @(0)
+				};
+				request.eventTarget = job.eventTarget;
+				request.downloadRequest = YES;
+				request.forceCertificateDecisionDelegation = YES;
+				request.autoResume = YES;
+				request.actionTrackingID = job.trackingID;
+
+				if (job.requiredCellularSwitch != nil)
+				{
+					request.requiredCellularSwitch = job.requiredCellularSwitch;
+				}
+
+				[job addScheduledRequest:request forRangeIndex:0];
+				[requests addObject:request];
+			}
+		}
+		else
+		{
+			NSIndexSet *missingRanges = job.missingRanges;
+			NSUInteger rangeIndex = missingRanges.firstIndex;
+
+			while ((job.scheduledRanges.count < maxConcurrentRanges) && (rangeIndex != NSNotFound))
+			{
+				NSRange byteRange = [job byteRangeForRangeIndex:rangeIndex];
+				OCHTTPRequest *request = [OCHTTPRequest requestWithURL:downloadURL];
+
+				request.method = OCHTTPMethodGET;
+				request.requiredSignals = self.actionSignals;
+
+				request.resultHandlerAction = @selector(_handleRangedDownloadResult:error:);
+				request.userInfo = @{
+					OCRangedDownloadInfoKeyJob : job,
+					OCRangedDownloadInfoKeyRangeIndex : @(rangeIndex)
+				};
+				request.eventTarget = job.eventTarget;
+				request.downloadRequest = YES;
+				request.forceCertificateDecisionDelegation = YES;
+				request.autoResume = YES;
+				request.actionTrackingID = job.trackingID;
+
+				[request setValue:[NSString stringWithFormat:@"bytes=%lu-%lu", (unsigned long)byteRange.location, (unsigned long)(NSMaxRange(byteRange) - 1)] forHeaderField:OCHTTPHeaderFieldNameRange];
+				[request setValue:job.eTag forHeaderField:OCHTTPHeaderFieldNameIfRange]; // server returns the complete file instead of the range if the ETag no longer matches
+
+				if (job.requiredCellularSwitch != nil)
+				{
+					request.requiredCellularSwitch = job.requiredCellularSwitch;
+				}
+
+				[job addScheduledRequest:request forRangeIndex:rangeIndex];
+				[requests addObject:request];
+
+				rangeIndex = [missingRanges indexGreaterThanIndex:rangeIndex];
+			}
+		}
+	}
+
+	if (isComplete)
+	{
+		if (!hasScheduledRanges)
+		{
+			[self _completeRangedDownloadJob:job];
+		}
+		return;
+	}
+
+	NSProgress *actionProgress = [self progressForActionTrackingID:job.trackingID provider:nil];
+
+	for (OCHTTPRequest *request in requests)
+	{
+		NSRange byteRange = [job byteRangeForRangeIndex:OCTypedCast(request.userInfo[OCRangedDownloadInfoKeyRangeIndex], NSNumber).unsignedIntegerValue];
+		NSUInteger expectedLength = job.singleDownload ? (NSUInteger)(job.fileSize - job.completedBytes) : byteRange.length;
+		NSProgress *progress = request.progress.progress;
+
+		if ((progress != nil) && (actionProgress != nil))
+		{
+			[actionProgress addChild:progress withPendingUnitCount:(int64_t)expectedLength];
+		}
+
+		[[self transferPipelineForRequest:request withExpectedResponseLength:expectedLength] enqueueRequest:request forPartitionID:self.partitionID];
+	}
+}
+
+- (void)_handleRangedDownloadResult:(OCHTTPRequest *)request error:(NSError *)error
+{
+	OCRangedDownloadJob *job = [self _registeredRangedDownloadJobFor:OCTypedCast(request.userInfo[OCRangedDownloadInfoKeyJob], OCRangedDownloadJob)];
+	NSNumber *rangeIndexNumber = OCTypedCast(request.userInfo[OCRangedDownloadInfoKeyRangeIndex], NSNumber);
+	OCRangedDownloadRangeIndex rangeIndex;
+
+	if ((job == nil) || (rangeIndexNumber == nil))
+	{
+		OCLogDebug(@"Ignoring ranged download result for ended job %@", request.userInfo[OCRangedDownloadInfoKeyJob]);
+		return;
+	}
+
+	rangeIndex = rangeIndexNumber.unsignedIntegerValue;
+
+	[job removeScheduledRequestForRangeIndex:rangeIndex];
+
+	if (request.cancelled)
+	{
+		error = OCError(OCErrorCancelled);
+	}
+	else if (error == nil)
+	{
+		error = request.error;
+	}
+
+	if (error == nil)
+	{
+		OCHTTPStatusCode statusCode = request.httpResponse.status.code;
+		OCChecksumHeaderString checksumString;
+
+		if ((checksumString = request.httpResponse.headerFields[@"oc-checksum"]) != nil)
+		{
+			job.checksum = [OCChecksum checksumFromHeaderString:checksumString];
+		}
+
+		if ((statusCode == OCHTTPStatusCodePARTIAL_CONTENT) && !job.singleDownload)
+		{
+			// Range received => write to target
+			NSString *contentRange = request.httpResponse.headerFields[OCHTTPHeaderFieldNameContentRange];
+			NSString *expectedRangePrefix = [NSString stringWithFormat:@"bytes %lu-", (unsigned long)[job byteRangeForRangeIndex:rangeIndex].location];
+
+			if (contentRange == nil)
+			{
+				if (!job.rangeSupportConfirmed)
+				{
+					// Range can't be verified => fall back to a single download
+					OCLogWarning(@"Range response without Content-Range for %@ => falling back to single download", job);
+					job.singleDownload = YES;
+				}
+				else
+				{
+					OCLogError(@"Missing Content-Range for range %lu of %@", (unsigned long)rangeIndex, job);
+					error = OCError(OCErrorResponseUnknownFormat);
+				}
+			}
+			else if (![contentRange hasPrefix:expectedRangePrefix])
+			{
+				OCLogError(@"Unexpected Content-Range %@ for range %lu of %@", contentRange, (unsigned long)rangeIndex, job);
+				error = OCError(OCErrorResponseUnknownFormat);
+			}
+			else if ([job writeRangeAtIndex:rangeIndex fromFileURL:request.httpResponse.bodyURL error:&error])
+			{
+				job.rangeSupportConfirmed = YES;
+			}
+		}
+		else if (statusCode == OCHTTPStatusCodeOK)
+		{
+			// Entire file received instead of range
+			OCFileETag eTag = request.httpResponse.headerFields[@"oc-etag"];
+
+			if (eTag == nil)
+			{
+				eTag = request.httpResponse.headerFields[@"Etag"];
+			}
+
+			if ((eTag != nil) && ![eTag isEqual:job.eTag])
+			{
+				// If-Range didn't match => file changed on the server, discard what has been downloaded so far
+				OCLogWarning(@"ETag changed from %@ to %@ during ranged download => restarting", job.eTag, eTag);
+
+				[job reset];
+				error = OCError(OCErrorItemChanged);
+			}
+			else
+			{
+				// Server doesn't support ranges (or this is the response to the single download) => use the file as-is
+				[job replaceTargetWithFileURL:request.httpResponse.bodyURL error:&error];
+			}
+		}
+		else
+		{
+			error = [self _errorForDownloadRequest:request item:job.item];
+		}
+	}
+
+	if (error != nil)
+	{
+		// Keep the checkpoint, so the download can resume with the missing ranges later on
+		if ([self _endRangedDownloadJob:job])
+		{
+			OCLogError(@"Ranged download of %@ ended with error %@", job, error);
+
+			if ([NSFileManager.defaultManager fileExistsAtPath:job.checkpointURL.path])
+			{
+				[job saveCheckpointWithError:NULL]; // persist .ended, so results arriving after a relaunch are ignored
+			}
+
+			OCErrorAddDateFromResponse(error, request.httpResponse);
+
+			[job.eventTarget handleError:error type:OCEventTypeDownload uuid:request.identifier sender:self];
+		}
+		return;
+	}
+
+	[self _continueRangedDownloadJob:job];
+}
+
+- (void)_completeRangedDownloadJob:(OCRangedDownloadJob *)job
+{
+	OCEvent *event;
+
+	if (![self _endRangedDownloadJob:job])
+	{
+		// Result was already delivered
+		return;
+	}
+
+	OCLogDebug(@"Ranged download completed: %@", job);
+
+	[job removeCheckpoint];
+
+	if ((event = [OCEvent eventForEventTarget:job.eventTarget type:OCEventTypeDownload uuid:job.jobID attributes:nil]) != nil)
+	{
+		OCFile *file = [OCFile new];
+
+		file.item = job.item;
+		file.url = job.targetURL;
+		file.checksum = job.checksum;
+		file.eTag = job.eTag;
+		file.fileID = job.item.fileID;
+
+		event.file = file;
+
+		[job.eventTarget handleEvent:event sender:self];
+	}
+}
+
+@end
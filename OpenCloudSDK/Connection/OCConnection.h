@@ -251,6 +251,12 @@ NS_ASSUME_NONNULL_BEGIN
 - (nullable OCProgress *)uploadFileFromURL:(NSURL *)sourceURL withName:(nullable NSString *)fileName to:(OCItem *)newParentDirectory replacingItem:(nullable OCItem *)replacedItem options:(nullable OCConnectionOptions)options resultTarget:(OCEventTarget *)eventTarget;
 @end
 
+#pragma mark - RANGED DOWNLOAD
+@interface OCConnection (RangedDownload)
++ (BOOL)shouldDownloadItemInRanges:(OCItem *)item; //!< Returns YES if the item is large enough to be downloaded in ranges (see OCConnectionRangedDownloadThreshold)
+- (nullable OCProgress *)downloadItemInRanges:(OCItem *)item to:(NSURL *)targetURL options:(nullable OCConnectionOptions)options resultTarget:(OCEventTarget *)eventTarget; //!< Downloads the item to targetURL via concurrent HTTP Range requests. Completed ranges are checkpointed next to targetURL, so that a later call with the same targetURL only requests the missing ranges.
+@end
+
 #pragma mark - SIGNALS
 @interface OCConnection (Signals)
 - (void)setSignal:(OCConnectionSignalID)signal on:(BOOL)on;
@@ -484,6 +490,12 @@ extern OCClassSettingsKey OCConnectionAlwaysRequestPrivateLink; //!< Controls wh
 extern OCClassSettingsKey OCConnectionTransparentTemporaryRedirect; //!< Allows (TRUE) transparent handling of 307 redirects at the HTTP pipeline level.
 extern OCClassSettingsKey OCConnectionValidatorFlags; //!< Allows fine-tuning the behavior of the connection validator.
 extern OCClassSettingsKey OCConnectionBlockPasswordRemovalDefault; //!< Controls the value of the `block_password_removal`-based capabilities if the server provides no value for it. This controls whether passwords can be removed from an existing link even though passwords need to be enforced on creation as per capabilities.
+extern OCClassSettingsKey OCConnectionRangedDownloadThreshold; //!< Minimum size (in bytes) of files to download in ranges. A value of 0 disables ranged downloads. Defaults to 64 MB.
+extern OCClassSettingsKey OCConnectionRangedDownloadRangeSize; //!< Size (in bytes) of the individual ranges of a ranged download. Defaults to 8 MB.
+extern OCClassSettingsKey OCConnectionRangedDownloadMaximumConcurrentRanges; //!< Maximum number of ranges of a ranged download to request concurrently. Defaults to 4.
+extern OCClassSettingsKey OCConnectionFastConnect; //!< Controls whether -connectWithCompletionHandler: completes with the capabilities, user and drive list cached from the last connect and refreshes them in the background. Defaults to FALSE.
+
+extern NSNotificationName OCConnectionCapabilitiesChangedNotification; //!< Posted after a fast connect if the capabilities refreshed in the background differ meaningfully (product, version, spaces or favorites support) from the cached ones, but the server is still supported. The object is the OCConnection, whose .capabilities already reflect the change.
 
 extern OCConnectionOptionKey OCConnectionOptionRequestObserverKey;
 extern OCConnectionOptionKey OCConnectionOptionLastModificationDateKey; //!< Last modification date for uploads
@@ -497,6 +509,7 @@ extern OCConnectionOptionKey OCConnectionOptionTemporarySegmentFolderURLKey; //!
 extern OCConnectionOptionKey OCConnectionOptionForceReplaceKey; //!< If YES, force replace existing items.
 extern OCConnectionOptionKey OCConnectionOptionResponseDestinationURL; //!< NSURL of where to store a (raw) response
 extern OCConnectionOptionKey OCConnectionOptionResponseStreamHandler; //!< Response stream handler (OCHTTPRequestEphermalStreamHandler) to receive the response body stream
+extern OCConnectionOptionKey OCConnectionOptionKnownItemsProvider; //!< Block (OCHTTPDAVRequestKnownItemsProvider) returning the locally known items by fileID. Unchanged items are then returned as the known instances, rather than being built from the PROPFIND response.
 extern OCConnectionOptionKey OCConnectionOptionDriveID; //!< Drive ID (OCDriveID) to target.
 extern OCConnectionOptionKey OCConnectionOptionParentItem; //!< Parent item (OCItem)
 extern OCConnectionOptionKey OCConnectionOptionSyncRecordID; //!< Sync Record ID (OCSyncRecordID), typically of the sync record performing the operation.
@@ -53,6 +53,7 @@
 #import "OCBookmarkManager.h"
 #import "OCConnection+GraphAPI.h"
 #import "NSError+OCNetworkFailure.h"
+#import "OCMeasurement.h"
 #import "OCLocaleFilterVariables.h"
 
 // Imported to use the identifiers in OCConnectionPreferredAuthenticationMethodIDs only
@@ -157,7 +158,11 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		OCConnectionPlainHTTPPolicy			: @"warn",
 		OCConnectionAlwaysRequestPrivateLink		: @(NO),
 		OCConnectionTransparentTemporaryRedirect	: @(NO),
-		OCConnectionBlockPasswordRemovalDefault		: @(YES)
+		OCConnectionBlockPasswordRemovalDefault		: @(YES),
+		OCConnectionRangedDownloadThreshold		: @(64 * 1024 * 1024),
+		OCConnectionRangedDownloadRangeSize		: @(8 * 1024 * 1024),
+		OCConnectionRangedDownloadMaximumConcurrentRanges : @(4),
+		OCConnectionFastConnect				: @(NO)
 	});
 }
 
@@ -367,6 +372,36 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
 			OCClassSettingsMetadataKeyCategory	: @"Security",
 			OCClassSettingsMetadataKeyFlags		: @(OCClassSettingsFlagDenyUserPreferences)
+		},
+
+		// Ranged downloads
+		OCConnectionRangedDownloadThreshold : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Minimum size (in bytes) of files to download as concurrently requested, individually resumable ranges. A value of 0 disables ranged downloads.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		OCConnectionRangedDownloadRangeSize : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Size (in bytes) of the individual ranges of a ranged download.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		OCConnectionRangedDownloadMaximumConcurrentRanges : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Maximum number of ranges of a ranged download that are requested concurrently.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		// Fast connect
+		OCConnectionFastConnect : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeBoolean,
+			OCClassSettingsMetadataKeyDescription 	: @"Controls whether connections complete using the capabilities, user and drive list cached from the last connect, refreshing them in the background. Changes to the server version or key capabilities are reconciled once the refresh completes.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
 		}
 	});
 }
@@ -817,7 +852,21 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		[self setSignal:OCConnectionSignalIDAuthenticationAvailable on:authenticationAvailable];
 	}
 
-	return ([self meetsSignalRequirements:requiredSignals]);
+	BOOL meetsSignalRequirements = [self meetsSignalRequirements:requiredSignals];
+
+	// Remember when requests first got held back waiting for authentication, so the stall time can be reported when they get authorized
+	if (!meetsSignalRequirements && (task != nil) &&
+	    [requiredSignals containsObject:OCConnectionSignalIDAuthenticationAvailable] && ![self isSignalOn:OCConnectionSignalIDAuthenticationAvailable])
+	{
+		OCHTTPRequest *request = task.request;
+
+		if (request.authenticationHoldBackDate == nil)
+		{
+			request.authenticationHoldBackDate = [NSDate new];
+		}
+	}
+
+	return (meetsSignalRequirements);
 }
 
 - (BOOL)pipeline:(OCHTTPPipeline *)pipeline partitionID:(OCHTTPPipelinePartitionID)partitionID simulateRequestHandling:(OCHTTPRequest *)request completionHandler:(void (^)(OCHTTPResponse * _Nonnull))completionHandler
@@ -1257,6 +1306,233 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 	}
 }
 
+#pragma mark - Connection state
+static BOOL OCConnectionCapabilitiesDifferMeaningfully(OCCapabilities *capabilities, OCCapabilities *otherCapabilities)
+{
+	return (!OCNAIsEqual(capabilities.productName, otherCapabilities.productName) ||
+		!OCNAIsEqual(capabilities.version, otherCapabilities.version) ||
+		!OCNAIsEqual(capabilities.longProductVersionString, otherCapabilities.longProductVersionString) ||
+		(capabilities.spacesEnabled.boolValue != otherCapabilities.spacesEnabled.boolValue) ||
+		(capabilities.supportsFavorites.boolValue != otherCapabilities.supportsFavorites.boolValue));
+}
+
+- (BOOL)_restoreCachedConnectionState
+{
+	NSData *capabilitiesJSONData;
+	NSDictionary<NSString *, id> *capabilitiesJSON;
+	OCCapabilities *capabilities;
+	OCUser *user;
+
+	if (![[self classSettingForOCClassSettingsKey:OCConnectionFastConnect] boolValue])
+	{
+		return (NO);
+	}
+
+	if (((capabilitiesJSONData = OCTypedCast(_bookmark.userInfo[OCBookmarkUserInfoKeyCapabilities], NSData)) == nil) ||
+	    ((capabilitiesJSON = OCTypedCast([NSJSONSerialization JSONObjectWithData:capabilitiesJSONData options:0 error:NULL], NSDictionary)) == nil) ||
+	    ((capabilities = [[OCCapabilities alloc] initWithRawJSON:capabilitiesJSON]) == nil) ||
+	    ((user = _bookmark.user) == nil))
+	{
+		return (NO);
+	}
+
+	// Cached capabilities must still meet the minimum version requirement
+	if ([self supportsServerVersion:capabilities.version product:capabilities.productName longVersion:capabilities.longProductVersionString allowHiddenVersion:NO] != nil)
+	{
+		return (NO);
+	}
+
+	// Drive-based accounts also need a drive list (f.ex. provided by OCCore from the vault)
+	if ((capabilities.spacesEnabled.boolValue || [_bookmark hasCapability:OCBookmarkCapabilityDrives]) && (self.drives.count == 0))
+	{
+		return (NO);
+	}
+
+	self.capabilities = capabilities;
+	self.loggedInUser = user;
+
+	return (YES);
+}
+
+- (void)_reconcileCachedCapabilities:(OCCapabilities *)cachedCapabilities withRefreshedCapabilities:(nullable OCCapabilities *)capabilities error:(nullable NSError *)error
+{
+	if ([error isOCErrorWithCode:OCErrorServerVersionNotSupported])
+	{
+		// Server no longer supported => disconnect and let the delegate know
+		OCLogWarning(@"Server version no longer supported after fast connect (%@ %@ -> %@ %@)", cachedCapabilities.productName, cachedCapabilities.longProductVersionString, capabilities.productName, capabilities.longProductVersionString);
+
+		self.state = OCConnectionStateDisconnected;
+
+		if ((_delegate != nil) && [_delegate respondsToSelector:@selector(connection:handleError:)])
+		{
+			[_delegate connection:self handleError:error];
+		}
+	}
+	else if (error != nil)
+	{
+		OCLogWarning(@"Background refresh of connection state failed - continuing with cached state: %@", error);
+	}
+	else if ((capabilities != nil) && OCConnectionCapabilitiesDifferMeaningfully(cachedCapabilities, capabilities))
+	{
+		// Server still supported, but changed => self.capabilities, the bookmark and the drive list have already been updated by the refresh, so let observers re-evaluate
+		OCLog(@"Server capabilities changed meaningfully since last connect (%@ %@ -> %@ %@)", cachedCapabilities.productName, cachedCapabilities.longProductVersionString, capabilities.productName, capabilities.longProductVersionString);
+
+		[NSNotificationCenter.defaultCenter postNotificationName:OCConnectionCapabilitiesChangedNotification object:self];
+	}
+}
+
+- (void)_retrieveConnectionStateWithProgress:(NSProgress *)connectProgress measurement:(OCMeasurement *)measurement completionHandler:(void(^)(NSError * _Nullable error, OCCapabilities * _Nullable capabilities))completionHandler
+{
+	dispatch_group_t retrievalGroup = dispatch_group_create();
+	__block NSError *capabilitiesError = nil, *userError = nil, *drivesError = nil;
+	__block OCCapabilities *retrievedCapabilities = nil;
+	__block OCUser *retrievedUser = nil;
+	__block BOOL retrievingDrives = NO;
+
+	void (^RetrieveDriveList)(void) = ^{
+		// May be called from the calling thread and from the capabilities completion handler - only retrieve the drive list once
+		@synchronized(retrievalGroup)
+		{
+			if (retrievingDrives)
+			{
+				return;
+			}
+
+			retrievingDrives = YES;
+		}
+
+		OCMeasureEventBegin(measurement, @"connect.drives", drivesRef, @"Retrieving drive list");
+
+		dispatch_group_enter(retrievalGroup);
+
+		[self retrieveDriveListWithCompletionHandler:^(NSError * _Nullable error, NSArray<OCDrive *> * _Nullable drives) {
+			OCMeasureEventEnd(measurement, @"connect.drives", drivesRef, @"Retrieved drive list");
+
+			drivesError = error;
+
+			dispatch_group_leave(retrievalGroup);
+		}];
+	};
+
+	connectProgress.localizedDescription = OCLocalizedString(@"Retrieving capabilities…", @"");
+
+	// Drive-based accounts are known from the bookmark, so their drive list doesn't need to wait for the capabilities
+	if ([_bookmark hasCapability:OCBookmarkCapabilityDrives])
+	{
+		RetrieveDriveList();
+	}
+
+	// Capabilities
+	OCMeasureEventBegin(measurement, @"connect.capabilities", capabilitiesRef, @"Retrieving capabilities");
+
+	dispatch_group_enter(retrievalGroup);
+
+	[self retrieveCapabilitiesWithCompletionHandler:^(NSError * _Nullable error, OCCapabilities * _Nullable capabilities) {
+		OCMeasureEventEnd(measurement, @"connect.capabilities", capabilitiesRef, @"Retrieved capabilities");
+
+		capabilitiesError = error;
+		retrievedCapabilities = capabilities;
+
+		// Capabilities may reveal the drive API for accounts not yet known to use it
+		if ((error == nil) && self.useDriveAPI)
+		{
+			RetrieveDriveList();
+		}
+
+		dispatch_group_leave(retrievalGroup);
+	}];
+
+	// User
+	OCMeasureEventBegin(measurement, @"connect.user", userRef, @"Retrieving user");
+
+	dispatch_group_enter(retrievalGroup);
+
+	[self retrieveLoggedInUserWithCompletionHandler:^(NSError *error, OCUser *loggedInUser) {
+		OCMeasureEventEnd(measurement, @"connect.user", userRef, @"Retrieved user");
+
+		userError = error;
+		retrievedUser = loggedInUser;
+
+		dispatch_group_leave(retrievalGroup);
+	}];
+
+	dispatch_group_notify(retrievalGroup, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+		NSError *minimumVersionError;
+		BOOL saveBookmark = NO;
+
+		if (capabilitiesError != nil)
+		{
+			completionHandler(capabilitiesError, nil);
+			return;
+		}
+
+		// Check minimum version
+		if ((minimumVersionError = [self supportsServerVersion:retrievedCapabilities.version product:retrievedCapabilities.productName longVersion:retrievedCapabilities.longProductVersionString allowHiddenVersion:NO]) != nil)
+		{
+			completionHandler(minimumVersionError, retrievedCapabilities);
+			return;
+		}
+
+		// Keep a copy of the capabilities for fast connects
+		if (retrievedCapabilities.rawJSON != nil)
+		{
+			NSData *capabilitiesJSONData;
+
+			if (((capabilitiesJSONData = [NSJSONSerialization dataWithJSONObject:retrievedCapabilities.rawJSON options:NSJSONWritingSortedKeys error:NULL]) != nil) &&
+			    ![capabilitiesJSONData isEqual:self->_bookmark.userInfo[OCBookmarkUserInfoKeyCapabilities]])
+			{
+				self->_bookmark.userInfo[OCBookmarkUserInfoKeyCapabilities] = capabilitiesJSONData;
+				saveBookmark = YES;
+			}
+		}
+
+		if (userError == nil)
+		{
+			self.loggedInUser = retrievedUser;
+
+			// Update bookmark.userDisplayName if it has changed
+			if (((retrievedUser.displayName != nil) && ![retrievedUser.displayName isEqual:self.bookmark.userDisplayName]) ||
+			    (![retrievedUser isEqual:self.bookmark.user]))
+			{
+				self.bookmark.user = retrievedUser;
+				self.bookmark.userDisplayName = retrievedUser.displayName;
+
+				saveBookmark = YES;
+			}
+
+			// Favorites
+			if (retrievedCapabilities.supportsFavorites.boolValue != [self.bookmark hasCapability:OCBookmarkCapabilityFavorites])
+			{
+				if (retrievedCapabilities.supportsFavorites.boolValue)
+				{
+					[self.bookmark addCapability:OCBookmarkCapabilityFavorites];
+				}
+				else
+				{
+					[self.bookmark removeCapability:OCBookmarkCapabilityFavorites];
+				}
+
+				saveBookmark = YES;
+			}
+
+			// Drives: make sure drives capability is present in bookmark
+			if (self.useDriveAPI && ![self.bookmark hasCapability:OCBookmarkCapabilityDrives])
+			{
+				[self.bookmark addCapability:OCBookmarkCapabilityDrives];
+				saveBookmark = YES;
+			}
+		}
+
+		if (saveBookmark && (self.bookmark.authenticationDataStorage == OCBookmarkAuthenticationDataStorageKeychain))
+		{
+			// Update bookmark - IF it is not a working copy
+			[OCBookmarkManager.sharedBookmarkManager updateBookmark:self.bookmark];
+		}
+
+		completionHandler(((userError != nil) ? userError : drivesError), retrievedCapabilities);
+	});
+}
+
 #pragma mark - Connect & Disconnect
 - (NSProgress *)connectWithCompletionHandler:(void(^)(NSError *error, OCIssue *issue))completionHandler
 {
@@ -1280,6 +1556,10 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		3) Make authenticated WebDAV endpoint request
 			- if redirection or issue: create issue & complete
 			- if neither, complete with success
+
+		In practice, step 3) retrieves capabilities, user and drive list concurrently. With OCConnectionFastConnect enabled and
+		cached copies of all three available, the connection completes right after step 2) using the cached copies and refreshes
+		them in the background (stale-while-revalidate).
 	*/
 	
 	OCAuthenticationMethod *authMethod;
@@ -1308,6 +1588,10 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 
 		self.state = OCConnectionStateConnecting;
 
+		// Measure connect latency
+		OCMeasurement *measurement = [OCMeasurement measurementWithTitle:[NSString stringWithFormat:@"Connect to %@", self.bookmark.url]];
+		OCMeasureEventBegin(measurement, @"connect", connectRef, @"Connecting");
+
 		completionHandler = ^(NSError *error, OCIssue *issue) {
 			if ((error != nil) && (issue != nil))
 			{
@@ -1403,7 +1687,11 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		// Check status
 		if ((statusRequest =  [OCHTTPRequest requestWithURL:[self URLForEndpoint:OCConnectionEndpointIDStatus options:nil]]) != nil)
 		{
+			OCMeasureEventBegin(measurement, @"connect.status", statusRef, @"Requesting status");
+
 			[self sendRequest:statusRequest ephermalCompletionHandler:CompletionHandlerWithResultHandler(^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+				OCMeasureEventEnd(measurement, @"connect.status", statusRef, @"Received status");
+
 				self.connectionInitializationPhaseCompleted = YES;
 
 				if ((error == nil) && (response.status.isSuccess))
@@ -1455,6 +1743,8 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 						// Authenticate connection
 						connectProgress.localizedDescription = OCLocalizedString(@"Authenticating…", @"");
 
+						OCMeasureEventBegin(measurement, @"connect.authenticate", authenticateRef, @"Authenticating connection");
+
 						[authMethod authenticateConnection:self withCompletionHandler:^(NSError *authConnError, OCIssue *authConnIssue) {
 							if ((authConnError!=nil) || (authConnIssue!=nil))
 							{
@@ -1463,115 +1753,52 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 							}
 							else
 							{
-								// Connection authenticated. Now send an authenticated capabilities request.
+								OCMeasureEventEnd(measurement, @"connect.authenticate", authenticateRef, @"Authenticated connection");
 
-								// Retrieve capabilities
-								connectProgress.localizedDescription = OCLocalizedString(@"Retrieving capabilities…", @"");
+								if ([self _restoreCachedConnectionState])
+								{
+									// Fast connect: cached capabilities, user and drive list have been restored, so the connection can be used right away.
+									// Fresh copies are retrieved in the background and only reconciled if they differ in a meaningful way.
+									OCCapabilities *cachedCapabilities = self.capabilities;
 
-								[self retrieveCapabilitiesWithCompletionHandler:^(NSError * _Nullable error, OCCapabilities * _Nullable capabilities) {
-									if (error == nil)
-									{
-										// Check minimum version
-										NSError *minimumVersionError;
+									OCMeasureEvent(measurement, @"connect.restore", @"Restored capabilities, user and drives from cache");
 
-										if ((minimumVersionError = [self supportsServerVersion:capabilities.version product:capabilities.productName longVersion:capabilities.longProductVersionString allowHiddenVersion:NO]) != nil)
-										{
-											completionHandler(minimumVersionError, [OCIssue issueForError:minimumVersionError level:OCIssueLevelError issueHandler:nil]);
+									connectProgress.localizedDescription = OCLocalizedString(@"Connected", @"");
 
-											return;
-										}
+									self.state = OCConnectionStateConnected;
 
-										// Get user info
-										connectProgress.localizedDescription = OCLocalizedString(@"Fetching user information…", @"");
+									OCMeasureEventEnd(measurement, @"connect", connectRef, @"Connect done (cached state)");
 
-										[self retrieveLoggedInUserWithCompletionHandler:^(NSError *error, OCUser *loggedInUser) {
-											BOOL saveBookmark = NO;
+									completionHandler(nil, nil);
 
-											self.loggedInUser = loggedInUser;
+									OCMeasureEventBegin(measurement, @"connect.refresh", refreshRef, @"Refreshing connection state in the background");
 
-											// Update bookmark.userDisplayName if it has changed
-											if ((((loggedInUser.displayName != nil) && ![loggedInUser.displayName isEqual:self.bookmark.userDisplayName]) ||
-											    (![loggedInUser isEqual:self.bookmark.user])) && (error == nil))
-											{
-												self.bookmark.user = loggedInUser;
-												self.bookmark.userDisplayName = loggedInUser.displayName;
+									[self _retrieveConnectionStateWithProgress:nil measurement:measurement completionHandler:^(NSError * _Nullable error, OCCapabilities * _Nullable capabilities) {
+										OCMeasureEventEnd(measurement, @"connect.refresh", refreshRef, @"Refreshed connection state");
 
-												saveBookmark = YES;
-											}
+										[self _reconcileCachedCapabilities:cachedCapabilities withRefreshedCapabilities:capabilities error:error];
+									}];
+								}
+								else
+								{
+									// Retrieve capabilities, user and drive list
+									[self _retrieveConnectionStateWithProgress:connectProgress measurement:measurement completionHandler:^(NSError * _Nullable error, OCCapabilities * _Nullable capabilities) {
+										OCMeasureEventEnd(measurement, @"connect", connectRef, @"Connect done");
 
+										if (error != nil)
+										{
+											completionHandler(error, [OCIssue issueForError:error level:OCIssueLevelError issueHandler:nil]);
+										}
+										else
+										{
 											connectProgress.localizedDescription = OCLocalizedString(@"Connected", @"");
 
-											if (error!=nil)
-											{
-												completionHandler(error, [OCIssue issueForError:error level:OCIssueLevelError issueHandler:nil]);
-											}
-											else
-											{
-												// Favorites
-												if (capabilities.supportsFavorites.boolValue != [self.bookmark hasCapability:OCBookmarkCapabilityFavorites])
-												{
-													if (capabilities.supportsFavorites.boolValue)
-													{
-														[self.bookmark addCapability:OCBookmarkCapabilityFavorites];
-													}
-													else
-													{
-														[self.bookmark removeCapability:OCBookmarkCapabilityFavorites];
-													}
-
-													saveBookmark = YES;
-												}
-
-												// Drives
-												if (self.useDriveAPI)
-												{
-													// Drives
-													// Make sure drives capability is present in bookmark
-													if (![self.bookmark hasCapability:OCBookmarkCapabilityDrives])
-													{
-														[self.bookmark addCapability:OCBookmarkCapabilityDrives];
-														saveBookmark = YES;
-													}
-
-													// Get a list of drives
-													[self retrieveDriveListWithCompletionHandler:^(NSError * _Nullable error, NSArray<OCDrive *> * _Nullable drives) {
-														if (error!=nil)
-														{
-															completionHandler(error, [OCIssue issueForError:error level:OCIssueLevelError issueHandler:nil]);
-														}
-														else
-														{
-															connectProgress.localizedDescription = OCLocalizedString(@"Connected", @"");
-
-															self.state = OCConnectionStateConnected;
-
-															completionHandler(error, nil);
-														}
-													}];
-												}
-												else
-												{
-													// No drives? DONE!
-													connectProgress.localizedDescription = OCLocalizedString(@"Connected", @"");
-
-													self.state = OCConnectionStateConnected;
-
-													completionHandler(nil, nil);
-												}
-
-												if (saveBookmark && (self.bookmark.authenticationDataStorage == OCBookmarkAuthenticationDataStorageKeychain))
-												{
-													// Update bookmark - IF it is not a working copy
-													[OCBookmarkManager.sharedBookmarkManager updateBookmark:self.bookmark];
-												}
-											}
-										}];
-									}
-									else
-									{
-										completionHandler(error, [OCIssue issueForError:error level:OCIssueLevelError issueHandler:nil]);
-									}
-								}];
+											self.state = OCConnectionStateConnected;
+
+											completionHandler(nil, nil);
+										}
+									}];
+								}
 							}
 						}];
 					}
@@ -1899,6 +2126,15 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 				[(NSMutableDictionary *)options removeObjectForKey:OCConnectionOptionResponseStreamHandler];
 			}
 
+			if (options[OCConnectionOptionKnownItemsProvider] != nil)
+			{
+				davRequest.ephermalKnownItemsProvider = options[OCConnectionOptionKnownItemsProvider];
+
+				// Remove block from options as it can't be serialized otherwise
+				options = [options mutableCopy];
+				[(NSMutableDictionary *)options removeObjectForKey:OCConnectionOptionKnownItemsProvider];
+			}
+
 			// davRequest.requiredSignals = self.actionSignals;
 			davRequest.resultHandlerAction = @selector(_handleRetrieveItemListAtPathResult:error:);
 			davRequest.userInfo = @{
@@ -2048,7 +2284,9 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 
 			// OCLogDebug(@"Error: %@ - Response: %@", OCLogPrivate(error), ((request.downloadRequest && (request.downloadedFileURL != nil)) ? OCLogPrivate([NSString stringWithContentsOfURL:request.downloadedFileURL encoding:NSUTF8StringEncoding error:NULL]) : nil));
 
-			items = [((OCHTTPDAVRequest *)request) responseItemsForBasePath:endpointURL.path drives:nil reuseUsersByID:_usersByUserID driveID:driveID withErrors:&errors];
+			OCHTTPDAVRequestKnownItemsProvider knownItemsProvider = ((OCHTTPDAVRequest *)request).ephermalKnownItemsProvider;
+
+			items = [((OCHTTPDAVRequest *)request) responseItemsForBasePath:endpointURL.path drives:nil reuseUsersByID:_usersByUserID driveID:driveID knownItemsByFileID:((knownItemsProvider != nil) ? knownItemsProvider() : nil) withErrors:&errors];
 
 			if ((items.count == 0) && (errors.count > 0) && (event.error == nil))
 			{
@@ -2237,6 +2475,12 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		return (nil);
 	}
 
+	if ([OCConnection shouldDownloadItemInRanges:item])
+	{
+		// Large file => download via concurrent, resumable ranges
+		return ([self downloadItemInRanges:item to:targetURL options:options resultTarget:eventTarget]);
+	}
+
 	if ((downloadURL = [[self URLForEndpoint:OCConnectionEndpointIDWebDAVRoot options:@{ OCConnectionEndpointURLOptionDriveID : OCNullProtect(item.driveID) }] URLByAppendingPathComponent:item.path]) != nil)
 	{
 		OCHTTPRequest *request = [OCHTTPRequest requestWithURL:downloadURL];
@@ -2337,66 +2581,75 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 				}
 				else
 				{
-					switch (request.httpResponse.status.code)
-					{
-						case OCHTTPStatusCodePRECONDITION_FAILED: {
-							NSError *davError;
+					event.error = [self _errorForDownloadRequest:request item:OCTypedCast(request.userInfo[@"item"], OCItem)];
+				}
+			}
+		}
 
-							if (((davError = request.httpResponse.bodyParsedAsDAVError) != nil) && (davError.code == OCDAVErrorItemDoesNotExist))
-							{
-								event.error = OCErrorFromError(OCErrorItemNotFound, davError);
-							}
-							else
-							{
-								event.error = OCErrorFromError(OCErrorItemChanged, request.httpResponse.status.error);
-							}
-						}
-						break;
+		OCErrorAddDateFromResponse(event.error, request.httpResponse);
 
-						case OCHTTPStatusCodeTOO_EARLY: {
-							NSString *itemName = OCTypedCast(request.userInfo[@"item"], OCItem).name;
+		[request.eventTarget handleEvent:event sender:self];
+	}
+}
 
-							if (itemName == nil)
-							{
-								itemName = OCLocalizedString(@"File",nil);
-							}
+- (NSError *)_errorForDownloadRequest:(OCHTTPRequest *)request item:(OCItem *)item
+{
+	NSError *error = nil;
 
-							event.error = OCErrorWithDescriptionFromError(OCErrorItemProcessing, OCLocalizedFormat(@"{{itemName}} is currently processed on the server and can't be downloaded until it finishes processing.", @{
-								@"itemName" : itemName
-							}), request.httpResponse.status.error);
-						}
-						break;
+	switch (request.httpResponse.status.code)
+	{
+		case OCHTTPStatusCodePRECONDITION_FAILED: {
+			NSError *davError;
 
-						case OCHTTPStatusCodeFORBIDDEN: {
-							NSError *davError;
+			if (((davError = request.httpResponse.bodyParsedAsDAVError) != nil) && (davError.code == OCDAVErrorItemDoesNotExist))
+			{
+				error = OCErrorFromError(OCErrorItemNotFound, davError);
+			}
+			else
+			{
+				error = OCErrorFromError(OCErrorItemChanged, request.httpResponse.status.error);
+			}
+		}
+		break;
 
-							if ((davError = request.httpResponse.bodyParsedAsDAVError) != nil)
-							{
-								event.error = OCErrorWithDescriptionFromError(OCErrorItemInsufficientPermissions, davError.davExceptionMessage, davError);
-							}
-							else
-							{
-								event.error = OCErrorFromError(OCErrorItemInsufficientPermissions, request.httpResponse.status.error);
-							}
-						}
-						break;
+		case OCHTTPStatusCodeTOO_EARLY: {
+			NSString *itemName = item.name;
 
-						case OCHTTPStatusCodeNOT_FOUND:
-							event.error = OCErrorFromError(OCErrorItemNotFound, request.httpResponse.status.error);
-						break;
+			if (itemName == nil)
+			{
+				itemName = OCLocalizedString(@"File",nil);
+			}
 
-						default:
-							event.error = request.httpResponse.status.error;
-						break;
-					}
-				}
+			error = OCErrorWithDescriptionFromError(OCErrorItemProcessing, OCLocalizedFormat(@"{{itemName}} is currently processed on the server and can't be downloaded until it finishes processing.", @{
+				@"itemName" : itemName
+			}), request.httpResponse.status.error);
+		}
+		break;
+
+		case OCHTTPStatusCodeFORBIDDEN: {
+			NSError *davError;
+
+			if ((davError = request.httpResponse.bodyParsedAsDAVError) != nil)
+			{
+				error = OCErrorWithDescriptionFromError(OCErrorItemInsufficientPermissions, davError.davExceptionMessage, davError);
+			}
+			else
+			{
+				error = OCErrorFromError(OCErrorItemInsufficientPermissions, request.httpResponse.status.error);
 			}
 		}
+		break;
 
-		OCErrorAddDateFromResponse(event.error, request.httpResponse);
+		case OCHTTPStatusCodeNOT_FOUND:
+			error = OCErrorFromError(OCErrorItemNotFound, request.httpResponse.status.error);
+		break;
 
-		[request.eventTarget handleEvent:event sender:self];
+		default:
+			error = request.httpResponse.status.error;
+		break;
 	}
+
+	return (error);
 }
 
 #pragma mark - Action: Item update
@@ -3422,6 +3675,12 @@ OCClassSettingsKey OCConnectionAlwaysRequestPrivateLink = @"always-request-priva
 OCClassSettingsKey OCConnectionTransparentTemporaryRedirect = @"transparent-temporary-redirect";
 OCClassSettingsKey OCConnectionValidatorFlags = @"validator-flags";
 OCClassSettingsKey OCConnectionBlockPasswordRemovalDefault = @"block-password-removal-default";
+OCClassSettingsKey OCConnectionRangedDownloadThreshold = @"ranged-download-threshold";
+OCClassSettingsKey OCConnectionRangedDownloadRangeSize = @"ranged-download-range-size";
+OCClassSettingsKey OCConnectionRangedDownloadMaximumConcurrentRanges = @"ranged-download-maximum-concurrent-ranges";
+OCClassSettingsKey OCConnectionFastConnect = @"fast-connect";
+
+NSNotificationName OCConnectionCapabilitiesChangedNotification = @"OCConnectionCapabilitiesChanged";
 
 OCConnectionOptionKey OCConnectionOptionRequestObserverKey = @"request-observer";
 OCConnectionOptionKey OCConnectionOptionLastModificationDateKey = @"last-modification-date";
@@ -3435,6 +3694,7 @@ OCConnectionOptionKey OCConnectionOptionTemporarySegmentFolderURLKey = @"tempora
 OCConnectionOptionKey OCConnectionOptionForceReplaceKey = @"force-replace";
 OCConnectionOptionKey OCConnectionOptionResponseDestinationURL = @"response-destination-url";
 OCConnectionOptionKey OCConnectionOptionResponseStreamHandler = @"response-stream-handler";
+OCConnectionOptionKey OCConnectionOptionKnownItemsProvider = @"known-items-provider";
 OCConnectionOptionKey OCConnectionOptionDriveID = @"drive-id";
 OCConnectionOptionKey OCConnectionOptionParentItem = @"parent-item";
 OCConnectionOptionKey OCConnectionOptionSyncRecordID = @"sync-record-id";
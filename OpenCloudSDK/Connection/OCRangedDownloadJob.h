@@ -0,0 +1,82 @@
+//
+//  OCRangedDownloadJob.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCItem.h"
+#import "OCEventTarget.h"
+#import "OCCellularSwitch.h"
+#import "OCChecksum.h"
+#import "OCHTTPRequest.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NSUInteger OCRangedDownloadRangeIndex; //!< Index of a range, with range n spanning bytes [n * rangeSize, MIN((n+1) * rangeSize, fileSize))
+
+@interface OCRangedDownloadJob : NSObject <NSSecureCoding>
+
+@property(strong) NSString *jobID; //!< Unique ID of the job run, used to route range results back to the job. Renewed when resuming from a checkpoint, so results of earlier runs can be told apart.
+
+@property(strong) OCItem *item; //!< The item to download
+@property(strong,readonly) OCFileETag eTag; //!< ETag of the item version the ranges were downloaded for (used for If-Range)
+@property(assign,readonly) unsigned long long fileSize; //!< Size of the file in bytes
+@property(assign,readonly) unsigned long long rangeSize; //!< Size of the individual ranges in bytes
+
+@property(strong) NSURL *targetURL; //!< URL of the (preallocated) file the ranges are written to
+@property(strong,readonly,nonatomic) NSURL *checkpointURL; //!< URL of the checkpoint file storing the completed ranges next to the .targetURL
+
+@property(strong,nullable) OCEventTarget *eventTarget;
+@property(strong,nullable) OCActionTrackingID trackingID;
+@property(strong,nullable) OCCellularSwitchIdentifier requiredCellularSwitch;
+
+@property(strong,nullable) OCChecksum *checksum; //!< Checksum of the entire file, as returned by the server with the range responses (not persisted)
+
+@property(strong,readonly,nonatomic) NSIndexSet *completedRanges; //!< Indexes of the ranges that have been written to .targetURL
+@property(strong,readonly,nonatomic) NSIndexSet *scheduledRanges; //!< Indexes of the ranges currently scheduled with the HTTP pipeline (not persisted). Returns a copy.
+
+@property(assign) BOOL ended; //!< YES once the result of the job run has been delivered. Results arriving for an ended job are ignored. Reset when resuming from a checkpoint.
+@property(assign) BOOL rangeSupportConfirmed; //!< YES once the server responded to a range request with the requested Content-Range (not persisted). Until then, only a single range is requested at a time.
+@property(assign) BOOL singleDownload; //!< YES if the server responded to a range request without Content-Range and the file is downloaded with a single, non-ranged request instead (not persisted)
+
+@property(readonly,nonatomic) NSUInteger rangeCount;
+@property(readonly,nonatomic) unsigned long long completedBytes;
+@property(readonly,nonatomic) BOOL isComplete;
+
+- (instancetype)initWithItem:(OCItem *)item targetURL:(NSURL *)targetURL rangeSize:(unsigned long long)rangeSize;
+
++ (nullable instancetype)checkpointedJobForItem:(OCItem *)item targetURL:(NSURL *)targetURL; //!< Returns the job persisted in the checkpoint file for targetURL - or nil if there's none, or if it was created for a different version of the item.
++ (NSURL *)checkpointURLForTargetURL:(NSURL *)targetURL; //!< URL of the checkpoint file for the provided target URL
+
+- (NSRange)byteRangeForRangeIndex:(OCRangedDownloadRangeIndex)rangeIndex;
+- (NSIndexSet *)missingRanges; //!< Ranges that are neither completed nor currently scheduled
+
+- (void)addScheduledRequest:(OCHTTPRequest *)request forRangeIndex:(OCRangedDownloadRangeIndex)rangeIndex; //!< Adds the range to .scheduledRanges and keeps a reference to the request downloading it
+- (void)removeScheduledRequestForRangeIndex:(OCRangedDownloadRangeIndex)rangeIndex; //!< Removes the range from .scheduledRanges
+- (NSArray<OCHTTPRequest *> *)removeAllScheduledRequests; //!< Removes all ranges from .scheduledRanges and returns the requests downloading them (f.ex. to cancel them)
+
+- (BOOL)preallocateTargetWithError:(NSError * _Nullable * _Nullable)outError; //!< Creates the target file at its full size if it doesn't exist yet or has a different size. Resets all completed ranges if the file needs to be (re)created.
+- (BOOL)writeRangeAtIndex:(OCRangedDownloadRangeIndex)rangeIndex fromFileURL:(NSURL *)rangeFileURL error:(NSError * _Nullable * _Nullable)outError; //!< Copies the contents of rangeFileURL into the target file at the offset of the range, marks the range as completed and saves the checkpoint.
+
+- (BOOL)replaceTargetWithFileURL:(NSURL *)fileURL error:(NSError * _Nullable * _Nullable)outError; //!< Replaces the target with a copy of the complete file at fileURL and marks all ranges as completed. Used if a server responds to a range request with the entire file.
+
+- (BOOL)saveCheckpointWithError:(NSError * _Nullable * _Nullable)outError;
+- (void)removeCheckpoint; //!< Removes the checkpoint file (f.ex. after the download completed)
+- (void)reset; //!< Forgets all completed ranges and removes checkpoint and target file
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,482 @@
+//
+//  OCRangedDownloadJob.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCRangedDownloadJob.h"
+#import "OCLogger.h"
+#import "NSError+OCError.h"
+#import "OCMacros.h"
+
+@interface OCRangedDownloadJob ()
+{
+	NSMutableIndexSet *_completedRanges;
+	NSMutableIndexSet *_scheduledRanges;
+	NSMutableDictionary<NSNumber *, OCHTTPRequest *> *_scheduledRequestsByRangeIndex;
+}
+@end
+
+@implementation OCRangedDownloadJob
+
+- (instancetype)initWithItem:(OCItem *)item targetURL:(NSURL *)targetURL rangeSize:(unsigned long long)rangeSize
+{
+	if ((self = [super init]) != nil)
+	{
+		_jobID = NSUUID.UUID.UUIDString;
+
+		_item = item;
+		_eTag = item.eTag;
+		_fileSize = (item.size > 0) ? (unsigned long long)item.size : 0;
+		_rangeSize = (rangeSize > 0) ? rangeSize : _fileSize;
+
+		_targetURL = targetURL;
+
+		_completedRanges = [NSMutableIndexSet new];
+		_scheduledRanges = [NSMutableIndexSet new];
+		_scheduledRequestsByRangeIndex = [NSMutableDictionary new];
+	}
+
+	return (self);
+}
+
++ (instancetype)checkpointedJobForItem:(OCItem *)item targetURL:(NSURL *)targetURL
+{
+	OCRangedDownloadJob *job = nil;
+	NSURL *checkpointURL = [self checkpointURLForTargetURL:targetURL];
+	NSData *checkpointData;
+
+	if ((checkpointData = [NSData dataWithContentsOfURL:checkpointURL]) != nil)
+	{
+		NSError *error = nil;
+
+		if ((job = [NSKeyedUnarchiver unarchivedObjectOfClass:OCRangedDownloadJob.class fromData:checkpointData error:&error]) == nil)
+		{
+			OCLogError(@"Error decoding ranged download checkpoint at %@: %@", checkpointURL, error);
+		}
+		else if (![job.eTag isEqual:item.eTag] || (job.fileSize != (unsigned long long)item.size))
+		{
+			// Checkpoint belongs to a different version of the item => discard
+			OCLogDebug(@"Discarding ranged download checkpoint for eTag %@ (current: %@)", job.eTag, item.eTag);
+
+			job.targetURL = targetURL; // the container path may have changed since the checkpoint was written
+			[job reset];
+			job = nil;
+		}
+		else
+		{
+			job.item = item;
+			job.targetURL = targetURL; // the container path may have changed since the checkpoint was written
+			job.jobID = NSUUID.UUID.UUIDString;
+			job.ended = NO;
+		}
+	}
+
+	return (job);
+}
+
++ (NSURL *)checkpointURLForTargetURL:(NSURL *)targetURL
+{
+	return ([targetURL URLByAppendingPathExtension:@"ranges"]);
+}
+
+#pragma mark - Ranges
+- (NSURL *)checkpointURL
+{
+	return ([OCRangedDownloadJob checkpointURLForTargetURL:_targetURL]);
+}
+
+- (NSUInteger)rangeCount
+{
+	if (_rangeSize == 0)
+	{
+		return (0);
+	}
+
+	return ((NSUInteger)((_fileSize + _rangeSize - 1) / _rangeSize));
+}
+
+- (NSRange)byteRangeForRangeIndex:(OCRangedDownloadRangeIndex)rangeIndex
+{
+	unsigned long long offset = rangeIndex * _rangeSize;
+	unsigned long long length = _rangeSize;
+
+	if (offset >= _fileSize)
+	{
+		return (NSMakeRange(NSNotFound, 0));
+	}
+
+	if ((offset + length) > _fileSize)
+	{
+		length = _fileSize - offset;
+	}
+
+	return (NSMakeRange((NSUInteger)offset, (NSUInteger)length));
+}
+
+- (NSIndexSet *)completedRanges
+{
+	@synchronized(self)
+	{
+		return ([_completedRanges copy]);
+	}
+}
+
+- (NSIndexSet *)scheduledRanges
+{
+	@synchronized(self)
+	{
+		return ([_scheduledRanges copy]);
+	}
+}
+
+- (void)addScheduledRequest:(OCHTTPRequest *)request forRangeIndex:(OCRangedDownloadRangeIndex)rangeIndex
+{
+	@synchronized(self)
+	{
+		[_scheduledRanges addIndex:rangeIndex];
+		_scheduledRequestsByRangeIndex[@(rangeIndex)] = request;
+	}
+}
+
+- (void)removeScheduledRequestForRangeIndex:(OCRangedDownloadRangeIndex)rangeIndex
+{
+	@synchronized(self)
+	{
+		[_scheduledRanges removeIndex:rangeIndex];
+		_scheduledRequestsByRangeIndex[@(rangeIndex)] = nil;
+	}
+}
+
+- (NSArray<OCHTTPRequest *> *)removeAllScheduledRequests
+{
+	NSArray<OCHTTPRequest *> *requests;
+
+	@synchronized(self)
+	{
+		requests = _scheduledRequestsByRangeIndex.allValues;
+
+		[_scheduledRanges removeAllIndexes];
+		[_scheduledRequestsByRangeIndex removeAllObjects];
+	}
+
+	return (requests);
+}
+
+- (NSIndexSet *)missingRanges
+{
+	NSMutableIndexSet *missingRanges = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, self.rangeCount)];
+
+	@synchronized(self)
+	{
+		[missingRanges removeIndexes:_completedRanges];
+		[missingRanges removeIndexes:_scheduledRanges];
+	}
+
+	return (missingRanges);
+}
+
+- (unsigned long long)completedBytes
+{
+	__block unsigned long long completedBytes = 0;
+
+	@synchronized(self)
+	{
+		[_completedRanges enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL * _Nonnull stop) {
+			completedBytes += [self byteRangeForRangeIndex:idx].length;
+		}];
+	}
+
+	return (completedBytes);
+}
+
+- (BOOL)isComplete
+{
+	@synchronized(self)
+	{
+		return (_completedRanges.count == self.rangeCount);
+	}
+}
+
+#pragma mark - File handling
+- (BOOL)preallocateTargetWithError:(NSError * _Nullable __autoreleasing *)outError
+{
+	NSNumber *existingFileSize = nil;
+	NSError *error = nil;
+
+	if ([_targetURL getResourceValue:&existingFileSize forKey:NSURLFileSizeKey error:NULL] && (existingFileSize.unsignedLongLongValue == _fileSize))
+	{
+		// Target already exists with expected size
+		return (YES);
+	}
+
+	@synchronized(self)
+	{
+		[_completedRanges removeAllIndexes];
+	}
+
+	if (![NSFileManager.defaultManager createFileAtPath:_targetURL.path contents:nil attributes:@{ NSFileProtectionKey : NSFileProtectionCompleteUntilFirstUserAuthentication }])
+	{
+		OCLogError(@"Error creating ranged download target %@", _targetURL);
+		if (outError != NULL) { *outError = OCError(OCErrorInternal); }
+		return (NO);
+	}
+
+	NSFileHandle *fileHandle;
+
+	if ((fileHandle = [NSFileHandle fileHandleForWritingToURL:_targetURL error:&error]) != nil)
+	{
+		// Extend file to its final size (sparse where supported by the file system)
+		[fileHandle truncateAtOffset:_fileSize error:&error];
+		[fileHandle closeAndReturnError:NULL];
+	}
+
+	OCFileOpLog(@"prealloc", error, @"Preallocated %llu bytes for ranged download at %@", _fileSize, _targetURL.path);
+
+	if (error != nil)
+	{
+		if (outError != NULL) { *outError = error; }
+		return (NO);
+	}
+
+	return ([self saveCheckpointWithError:outError]);
+}
+
+- (BOOL)writeRangeAtIndex:(OCRangedDownloadRangeIndex)rangeIndex fromFileURL:(NSURL *)rangeFileURL error:(NSError * _Nullable __autoreleasing *)outError
+{
+	NSRange byteRange = [self byteRangeForRangeIndex:rangeIndex];
+	NSFileHandle *srcFile = nil, *dstFile = nil;
+	NSUInteger copyChunkSize = 1024 * 1024;
+	NSUInteger bytesCopied = 0;
+	NSError *error = nil;
+
+	if (byteRange.location == NSNotFound)
+	{
+		if (outError != NULL) { *outError = OCError(OCErrorInsufficientParameters); }
+		return (NO);
+	}
+
+	do
+	{
+		if ((srcFile = [NSFileHandle fileHandleForReadingFromURL:rangeFileURL error:&error]) == nil)
+		{
+			OCLogError(@"Error opening range file %@ for reading: %@", rangeFileURL, error);
+			break;
+		}
+
+		if ((dstFile = [NSFileHandle fileHandleForWritingToURL:_targetURL error:&error]) == nil)
+		{
+			OCLogError(@"Error opening ranged download target %@ for writing: %@", _targetURL, error);
+			break;
+		}
+
+		if (![dstFile seekToOffset:byteRange.location error:&error])
+		{
+			OCLogError(@"Error seeking to position %lu in file %@: %@", (unsigned long)byteRange.location, _targetURL, error);
+			break;
+		}
+
+		while (bytesCopied < byteRange.length)
+		{
+			@autoreleasepool {
+				NSData *data;
+
+				if ((data = [srcFile readDataUpToLength:MIN(copyChunkSize, byteRange.length - bytesCopied) error:&error]) == nil) { break; }
+				if (data.length == 0) { break; }
+
+				if (![dstFile writeData:data error:&error]) { break; }
+
+				bytesCopied += data.length;
+			}
+		}
+	} while(0);
+
+	[srcFile closeAndReturnError:NULL];
+	[dstFile closeAndReturnError:NULL];
+
+	if ((error == nil) && (bytesCopied != byteRange.length))
+	{
+		// Range response was truncated
+		OCLogError(@"Range %lu of %@ has %lu bytes, expected %lu", (unsigned long)rangeIndex, _targetURL, (unsigned long)bytesCopied, (unsigned long)byteRange.length);
+		error = OCError(OCErrorResponseUnknownFormat);
+	}
+
+	if (error != nil)
+	{
+		if (outError != NULL) { *outError = error; }
+		return (NO);
+	}
+
+	@synchronized(self)
+	{
+		[_completedRanges addIndex:rangeIndex];
+	}
+
+	return ([self saveCheckpointWithError:outError]);
+}
+
+- (BOOL)replaceTargetWithFileURL:(NSURL *)fileURL error:(NSError * _Nullable __autoreleasing *)outError
+{
+	NSError *error = nil;
+
+	if ([NSFileManager.defaultManager fileExistsAtPath:_targetURL.path])
+	{
+		[NSFileManager.defaultManager removeItemAtURL:_targetURL error:&error];
+	}
+
+	if ((error == nil) && [NSFileManager.defaultManager copyItemAtURL:fileURL toURL:_targetURL error:&error])
+	{
+		@synchronized(self)
+		{
+			[_completedRanges addIndexesInRange:NSMakeRange(0, self.rangeCount)];
+		}
+	}
+
+	OCFileOpLog(@"cp", error, @"Replaced ranged download target %@ with complete file %@", _targetURL.path, fileURL.path);
+
+	if (error != nil)
+	{
+		if (outError != NULL) { *outError = error; }
+		return (NO);
+	}
+
+	return ([self saveCheckpointWithError:outError]);
+}
+
+#pragma mark - Checkpoint
+- (BOOL)saveCheckpointWithError:(NSError * _Nullable __autoreleasing *)outError
+{
+	NSError *error = nil;
+	NSData *checkpointData;
+
+	@synchronized(self)
+	{
+		checkpointData = [NSKeyedArchiver archivedDataWithRootObject:self requiringSecureCoding:YES error:&error];
+	}
+
+	if (checkpointData != nil)
+	{
+		[checkpointData writeToURL:self.checkpointURL options:NSDataWritingAtomic error:&error];
+	}
+
+	if (error != nil)
+	{
+		OCLogError(@"Error saving ranged download checkpoint to %@: %@", self.checkpointURL, error);
+		if (outError != NULL) { *outError = error; }
+		return (NO);
+	}
+
+	return (YES);
+}
+
+- (void)removeCheckpoint
+{
+	NSError *error = nil;
+
+	if ([NSFileManager.defaultManager fileExistsAtPath:self.checkpointURL.path])
+	{
+		[NSFileManager.defaultManager removeItemAtURL:self.checkpointURL error:&error];
+
+		OCFileOpLog(@"rm", error, @"Removed ranged download checkpoint at %@", self.checkpointURL.path);
+	}
+}
+
+- (void)reset
+{
+	NSError *error = nil;
+
+	@synchronized(self)
+	{
+		[_completedRanges removeAllIndexes];
+	}
+
+	[self removeCheckpoint];
+
+	if ([NSFileManager.defaultManager fileExistsAtPath:_targetURL.path])
+	{
+		[NSFileManager.defaultManager removeItemAtURL:_targetURL error:&error];
+
+		OCFileOpLog(@"rm", error, @"Removed ranged download target at %@", _targetURL.path);
+	}
+}
+
+#pragma mark - Secure coding
++ (BOOL)supportsSecureCoding
+{
+	return (YES);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder
+{
+	if ((self = [super init]) != nil)
+	{
+		_jobID = [coder decodeObjectOfClass:NSString.class forKey:@"jobID"];
+
+		_item = [coder decodeObjectOfClass:OCItem.class forKey:@"item"];
+		_eTag = [coder decodeObjectOfClass:NSString.class forKey:@"eTag"];
+		_fileSize = (unsigned long long)[coder decodeInt64ForKey:@"fileSize"];
+		_rangeSize = (unsigned long long)[coder decodeInt64ForKey:@"rangeSize"];
+
+		_targetURL = [coder decodeObjectOfClass:NSURL.class forKey:@"targetURL"];
+
+		_eventTarget = [coder decodeObjectOfClass:OCEventTarget.class forKey:@"eventTarget"];
+		_trackingID = [coder decodeObjectOfClass:NSString.class forKey:@"trackingID"];
+		_requiredCellularSwitch = [coder decodeObjectOfClass:NSString.class forKey:@"requiredCellularSwitch"];
+
+		_ended = [coder decodeBoolForKey:@"ended"];
+
+		_completedRanges = [[coder decodeObjectOfClass:NSIndexSet.class forKey:@"completedRanges"] mutableCopy];
+		_scheduledRanges = [NSMutableIndexSet new];
+		_scheduledRequestsByRangeIndex = [NSMutableDictionary new];
+
+		if (_completedRanges == nil)
+		{
+			_completedRanges = [NSMutableIndexSet new];
+		}
+	}
+
+	return (self);
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder
+{
+	[coder encodeObject:_jobID forKey:@"jobID"];
+
+	[coder encodeObject:_item forKey:@"item"];
+	[coder encodeObject:_eTag forKey:@"eTag"];
+	[coder encodeInt64:(int64_t)_fileSize forKey:@"fileSize"];
+	[coder encodeInt64:(int64_t)_rangeSize forKey:@"rangeSize"];
+
+	[coder encodeObject:_targetURL forKey:@"targetURL"];
+
+	[coder encodeObject:_eventTarget forKey:@"eventTarget"];
+	[coder encodeObject:_trackingID forKey:@"trackingID"];
+	[coder encodeObject:_requiredCellularSwitch forKey:@"requiredCellularSwitch"];
+
+	[coder encodeBool:_ended forKey:@"ended"];
+
+	@synchronized(self)
+	{
+		[coder encodeObject:[_completedRanges copy] forKey:@"completedRanges"];
+	}
+}
+
+#pragma mark - Description
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, jobID: %@, eTag: %@, fileSize: %llu, rangeSize: %llu, completed: %lu/%lu, scheduled: %@>", NSStringFromClass(self.class), self, _jobID, _eTag, _fileSize, _rangeSize, (unsigned long)self.completedRanges.count, (unsigned long)self.rangeCount, self.scheduledRanges]);
+}
+
+@end
@@ -26,6 +26,27 @@
 #import "OCCore+Internal.h"
 #import "OCLogger.h"
 #import "OCCore+ItemUpdates.h"
+#import "OCCore+SubtreeRetrieval.h"
+
+// Available offline folder trie
+// - one trie per driveID, with one node (NSMutableDictionary) per path component
+// - nodes of folders with an available offline policy contain OCAvailableOfflineTrieCoveredKey (which can't collide with a path component)
+static NSString *OCAvailableOfflineTrieCoveredKey = @"";
+
+static NSArray<NSString *> *OCAvailableOfflinePathComponents(OCPath path)
+{
+	NSMutableArray<NSString *> *pathComponents = [NSMutableArray new];
+
+	for (NSString *pathComponent in [path componentsSeparatedByString:@"/"])
+	{
+		if (pathComponent.length > 0)
+		{
+			[pathComponents addObject:pathComponent];
+		}
+	}
+
+	return (pathComponents);
+}
 
 @implementation OCCore (AvailableOffline)
 
@@ -109,6 +130,24 @@
 		};
 	}
 
+	if ((item.type == OCItemTypeCollection) && self.supportsSubtreeRetrieval)
+	{
+		// Retrieve the folder's entire contents in one request, rather than discovering them one folder level at a time
+		OCCoreItemPolicyCompletionHandler policyCompletionHandler = completionHandler;
+
+		completionHandler = ^(NSError * _Nullable error, OCItemPolicy * _Nullable itemPolicy) {
+			if ((error == nil) && (itemPolicy != nil))
+			{
+				[self retrieveSubtreeForUpdateScanAtLocation:item.location];
+			}
+
+			if (policyCompletionHandler != nil)
+			{
+				policyCompletionHandler(error, itemPolicy);
+			}
+		};
+	}
+
 	if (OCTypedCast(options[OCCoreOptionSkipRedundancyChecks], NSNumber).boolValue)
 	{
 		// Skip redundancy checks
@@ -251,12 +290,41 @@
 
 		[_availableOfflineFolderLocations removeAllObjects];
 		[_availableOfflineIDs removeAllObjects];
+		[_availableOfflineFolderTriesByDriveID removeAllObjects];
 
 		for (OCItemPolicy *policy in availableOfflinePolicies)
 		{
 			if (policy.location.path != nil)
 			{
 				[_availableOfflineFolderLocations addObject:policy.location];
+
+				if (policy.location.path.isNormalizedDirectoryPath)
+				{
+					// Add folder to trie
+					id driveKey = (policy.location.driveID != nil) ? policy.location.driveID : NSNull.null;
+					NSMutableDictionary *node;
+
+					if ((node = _availableOfflineFolderTriesByDriveID[driveKey]) == nil)
+					{
+						node = [NSMutableDictionary new];
+						_availableOfflineFolderTriesByDriveID[driveKey] = node;
+					}
+
+					for (NSString *pathComponent in OCAvailableOfflinePathComponents(policy.location.path))
+					{
+						NSMutableDictionary *childNode;
+
+						if ((childNode = node[pathComponent]) == nil)
+						{
+							childNode = [NSMutableDictionary new];
+							node[pathComponent] = childNode;
+						}
+
+						node = childNode;
+					}
+
+					node[OCAvailableOfflineTrieCoveredKey] = @(YES);
+				}
 			}
 
 			if (policy.localID != nil)
@@ -269,41 +337,95 @@
 	}
 }
 
+- (NSDictionary *)_availableOfflineFolderTrieNodeForFolderPath:(OCPath)folderPath driveID:(OCDriveID)driveID covered:(BOOL *)outCovered
+{
+	NSDictionary *node = _availableOfflineFolderTriesByDriveID[(driveID != nil) ? driveID : NSNull.null];
+	BOOL covered = (node[OCAvailableOfflineTrieCoveredKey] != nil);
+
+	if (node != nil)
+	{
+		for (NSString *pathComponent in OCAvailableOfflinePathComponents(folderPath))
+		{
+			if ((node = node[pathComponent]) == nil)
+			{
+				break;
+			}
+
+			covered = covered || (node[OCAvailableOfflineTrieCoveredKey] != nil);
+		}
+	}
+
+	*outCovered = covered;
+
+	return (node);
+}
+
 - (OCCoreAvailableOfflineCoverage)availableOfflinePolicyCoverageOfItem:(OCItem *)item
 {
-	OCCoreAvailableOfflineCoverage coverage = OCCoreAvailableOfflineCoverageNone;
+	if (item == nil) { return (OCCoreAvailableOfflineCoverageNone); }
+
+	return ((OCCoreAvailableOfflineCoverage)[self availableOfflinePolicyCoverageOfItems:@[ item ]].firstObject.unsignedIntegerValue);
+}
+
+- (NSArray <NSNumber *> *)availableOfflinePolicyCoverageOfItems:(NSArray <OCItem *> *)items
+{
+	NSMutableArray <NSNumber *> *coverages = [[NSMutableArray alloc] initWithCapacity:items.count];
 
 	@synchronized(_availableOfflineFolderLocations)
 	{
+		NSMutableDictionary<NSString *, NSArray *> *parentLookupsByParentLocation = [NSMutableDictionary new];
+
 		[self _updateAvailableOfflineCaches];
 
-		if ((item.localID!=nil) && [_availableOfflineIDs containsObject:item.localID])
-		{
-			coverage = OCCoreAvailableOfflineCoverageDirect;
-		}
-		else
+		for (OCItem *item in items)
 		{
+			OCCoreAvailableOfflineCoverage coverage = OCCoreAvailableOfflineCoverageNone;
 			OCLocation *itemLocation;
 
-			if ((itemLocation = item.location) != nil)
+			if (((item.localID!=nil) && [_availableOfflineIDs containsObject:item.localID]) ||
+			    (((itemLocation = item.location) != nil) && [_availableOfflineFolderLocations containsObject:itemLocation]))
 			{
-				for (OCLocation *folderLocation in _availableOfflineFolderLocations)
+				coverage = OCCoreAvailableOfflineCoverageDirect;
+			}
+			else if ((itemLocation.path != nil) && (_availableOfflineFolderTriesByDriveID.count > 0))
+			{
+				// Look up the parent folder (once per parent folder)
+				OCPath itemPath = itemLocation.path;
+				OCPath parentPath = itemPath.parentPath;
+				NSString *parentLocationKey = [NSString stringWithFormat:@"%@:%@", itemLocation.driveID, parentPath];
+				NSArray *parentLookup;
+
+				if ((parentLookup = parentLookupsByParentLocation[parentLocationKey]) == nil)
 				{
-					if ([folderLocation isEqual:itemLocation])
-					{
-						coverage = OCCoreAvailableOfflineCoverageDirect;
-						break;
-					}
-					else if ([itemLocation isLocatedIn:folderLocation])
+					BOOL parentCovered = NO;
+					NSDictionary *parentNode = [self _availableOfflineFolderTrieNodeForFolderPath:parentPath driveID:itemLocation.driveID covered:&parentCovered];
+
+					parentLookup = @[ @(parentCovered), ((parentNode != nil) ? parentNode : NSNull.null) ];
+					parentLookupsByParentLocation[parentLocationKey] = parentLookup;
+				}
+
+				if (((NSNumber *)parentLookup[0]).boolValue)
+				{
+					// Located inside an available offline folder
+					coverage = OCCoreAvailableOfflineCoverageIndirect;
+				}
+				else if (itemPath.isNormalizedDirectoryPath && !itemPath.isRootPath)
+				{
+					// Folder itself is available offline (under a location not equal to itemLocation)
+					NSDictionary *parentNode = OCTypedCast(parentLookup[1], NSDictionary);
+
+					if (((NSDictionary *)parentNode[itemPath.lastPathComponent])[OCAvailableOfflineTrieCoveredKey] != nil)
 					{
 						coverage = OCCoreAvailableOfflineCoverageIndirect;
 					}
 				}
 			}
+
+			[coverages addObject:@(coverage)];
 		}
 	}
 
-	return (coverage);
+	return (coverages);
 }
 
 @end
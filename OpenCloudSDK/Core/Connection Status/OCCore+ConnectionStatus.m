@@ -401,6 +401,11 @@
 			case OCErrorServerInMaintenanceMode:
 				[self reportResponseIndicatingMaintenanceMode];
 			break;
+
+			case OCErrorServerVersionNotSupported:
+				// Server version changed to an unsupported one after a fast connect
+				[self sendError:error issue:[OCIssue issueForError:error level:OCIssueLevelError issueHandler:nil]];
+			break;
 		}
 	}
 }
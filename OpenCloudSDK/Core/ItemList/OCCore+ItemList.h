@@ -49,6 +49,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface OCCore (ItemListInternal)
 - (void)scheduleNextItemListTask;
+- (void)_updateBackgroundScanActivityWithIncrement:(BOOL)increment currentLocationChange:(nullable OCLocation *)currentLocationChange;
 @end
 
 extern OCActivityIdentifier OCActivityIdentifierPendingServerScanJobsSummary; //!< The activity reporting the progress of background checks for updates
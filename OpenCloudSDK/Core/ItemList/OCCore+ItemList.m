@@ -40,6 +40,7 @@
 #import "OCConnection+GraphAPI.h"
 #import "GADrive.h"
 #import "GADriveItem.h"
+#import "OCCore+SubtreeRetrieval.h"
 #import <objc/runtime.h>
 
 static OCHTTPRequestGroupID OCCoreItemListTaskGroupQueryTasks = @"queryItemListTasks";
@@ -1388,8 +1389,19 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 											{
 												OCWTLogDebug((@[@"ScanChanges", @"Drives"]), @"Root eTag changed %@ -> %@ for %@", lastETag, subscribedDriveETag, subscribedDrive);
 
+												OCLocation *driveRootLocation = [[OCLocation alloc] initWithDriveID:subscribedDriveID path:@"/"];
+
 												foundChanges = YES;
-												[strongSelf scheduleUpdateScanForLocation:[[OCLocation alloc] initWithDriveID:subscribedDriveID path:@"/"] waitForNextQueueCycle:NO];
+
+												if ((lastETag == nil) && strongSelf.supportsSubtreeRetrieval && ([strongSelf.vault.database retrieveCacheItemsSyncAtLocation:driveRootLocation itemOnly:YES error:NULL syncAnchor:NULL].count == 0))
+												{
+													// Drive has never been scanned before => retrieve its entire contents in one request (schedules the update scan when done)
+													[strongSelf retrieveSubtreeForUpdateScanAtLocation:driveRootLocation];
+												}
+												else
+												{
+													[strongSelf scheduleUpdateScanForLocation:driveRootLocation waitForNextQueueCycle:NO];
+												}
 
 												strongSelf->_lastRootETagsByDriveID[subscribedDriveID] = subscribedDriveETag;
 											}
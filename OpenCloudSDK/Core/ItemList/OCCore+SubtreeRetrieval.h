@@ -0,0 +1,41 @@
+//
+//  OCCore+SubtreeRetrieval.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCCore.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void(^OCCoreSubtreeRetrievalProgressHandler)(NSUInteger folderCount, NSUInteger fileCount);
+typedef void(^OCCoreSubtreeRetrievalCompletionHandler)(NSError * _Nullable error, NSUInteger folderCount, NSUInteger fileCount);
+typedef BOOL(^OCCoreSubtreeItemListsHandler)(NSDictionary<OCPath, NSArray<OCItem *> *> * _Nullable itemListsByPath, NSUInteger folderCount, NSUInteger fileCount); //!< Receives a batch of completed item lists - or nil for a progress update. An empty list indicates that the folder's list turned out to be incomplete and any list handed over for it before needs to be discarded. Return NO to abort parsing.
+
+@interface OCCore (SubtreeRetrieval)
+
+@property(readonly,nonatomic) BOOL supportsSubtreeRetrieval; //!< YES if the server supports Depth:infinity PROPFINDs and subtree retrieval is enabled
+
+- (nullable NSProgress *)retrieveSubtreeAtLocation:(OCLocation *)location progressHandler:(nullable OCCoreSubtreeRetrievalProgressHandler)progressHandler completionHandler:(nullable OCCoreSubtreeRetrievalCompletionHandler)completionHandler; //!< Retrieves the entire folder hierarchy at location with a single, streamed Depth:infinity PROPFIND, splits the response into per-folder item lists and stores them in the database in batches. Once the response has been parsed, an update scan is scheduled for location, whose item list tasks then consume these lists instead of sending one PROPFIND per folder. The completionHandler is called after the update scan has been scheduled.
+- (void)retrieveSubtreeForUpdateScanAtLocation:(OCLocation *)location; //!< Starts a subtree retrieval as part of the background scan: its progress is reported through the background scan activity and failures are logged.
+
+- (nullable NSArray<OCItem *> *)consumePrefetchedItemListForLocation:(OCLocation *)location; //!< Returns and removes the item list (folder item first, followed by its immediate children) retrieved for location by a subtree retrieval - or nil if none is available.
+
++ (nullable NSError *)splitSubtreeResponseStream:(NSInputStream *)inputStream basePath:(NSString *)basePath driveID:(nullable OCDriveID)driveID batchSize:(NSUInteger)batchSize itemListsHandler:(OCCoreSubtreeItemListsHandler)itemListsHandler; //!< Parses a Depth:infinity PROPFIND response and passes the item lists of all folders whose contents are complete to itemListsHandler, in batches of at least batchSize items. Folders whose contents are not received in depth-first order are handed over again with an empty list.
+
+@end
+
+NS_ASSUME_NONNULL_END
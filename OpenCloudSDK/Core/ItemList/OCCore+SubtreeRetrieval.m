@@ -0,0 +1,399 @@
+//
+//  OCCore+SubtreeRetrieval.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCCore+SubtreeRetrieval.h"
+#import "OCCore+ItemList.h"
+#import "OCCore+Internal.h"
+#import "OCConnection.h"
+#import "OCXMLParser.h"
+#import "OCDatabase.h"
+#import "OCActivityUpdate.h"
+#import "OCMacros.h"
+#import "OCLogger.h"
+#import "NSError+OCError.h"
+#import "NSString+OCPath.h"
+
+@implementation OCCore (SubtreeRetrieval)
+
+- (BOOL)supportsSubtreeRetrieval
+{
+	if (!OCTypedCast([self classSettingForOCClassSettingsKey:OCCoreSubtreeRetrievalEnabled], NSNumber).boolValue)
+	{
+		return (NO);
+	}
+
+	return (self.connection.capabilities.davPropfindSupportsDepthInfinity.boolValue);
+}
+
+- (nullable NSProgress *)retrieveSubtreeAtLocation:(OCLocation *)location progressHandler:(nullable OCCoreSubtreeRetrievalProgressHandler)progressHandler completionHandler:(nullable OCCoreSubtreeRetrievalCompletionHandler)completionHandler
+{
+	NSProgress *retrievalProgress = [NSProgress indeterminateProgress];
+	NSString *retrievalID = NSUUID.UUID.UUIDString;
+	OCDriveID driveID = location.driveID;
+	__block NSProgress *propFindProgress = nil;
+	__block BOOL retrievalCancelled = NO, retrievalEnded = NO;
+	__block NSError *requestError = nil;
+
+	void (^EndRetrieval)(NSError *error, NSUInteger folderCount, NSUInteger fileCount) = ^(NSError *error, NSUInteger folderCount, NSUInteger fileCount) {
+		@synchronized(retrievalProgress)
+		{
+			if (retrievalEnded) { return; }
+			retrievalEnded = YES;
+		}
+
+		OCTLogDebug(@[@"SubtreeRetrieval"], @"Subtree retrieval for %@ ended with error=%@, folders=%lu, files=%lu", location, error, (unsigned long)folderCount, (unsigned long)fileCount);
+
+		if (retrievalCancelled)
+		{
+			// Drop what was retrieved so far
+			[self.database removePrefetchedItemListsForRetrievalID:retrievalID completionHandler:^(OCDatabase *db, NSError *dbError) {
+				if (completionHandler != nil)
+				{
+					completionHandler(OCError(OCErrorCancelled), folderCount, fileCount);
+				}
+
+				[self endActivity:@"Subtree retrieval"];
+			}];
+		}
+		else
+		{
+			// Let the update scan pick up the retrieved item lists (and fall back to regular PROPFINDs for anything that wasn't retrieved)
+			[self queueBlock:^{
+				[self scheduleUpdateScanForLocation:location waitForNextQueueCycle:NO];
+
+				if (completionHandler != nil)
+				{
+					completionHandler(error, folderCount, fileCount);
+				}
+
+				[self endActivity:@"Subtree retrieval"];
+			}];
+		}
+	};
+
+	BOOL (^StoreItemLists)(NSDictionary<OCPath, NSArray<OCItem *> *> *itemListsByPath) = ^(NSDictionary<OCPath, NSArray<OCItem *> *> *itemListsByPath) {
+		NSTimeInterval lifetime = OCTypedCast([self classSettingForOCClassSettingsKey:OCCoreSubtreeRetrievalListLifetime], NSNumber).doubleValue;
+		NSMutableDictionary<OCLocationString, NSArray<OCItem *> *> *itemListsByLocationString = [NSMutableDictionary new];
+		__block NSError *storeError = nil;
+
+		[itemListsByPath enumerateKeysAndObjectsUsingBlock:^(OCPath path, NSArray<OCItem *> *items, BOOL * _Nonnull stop) {
+			itemListsByLocationString[[[OCLocation alloc] initWithDriveID:driveID path:path].string] = items;
+		}];
+
+		// Wait for the batch to be written, so that parsing can't outpace the database and no more than one batch is held in memory
+		OCSyncExec(storeItemLists, {
+			[self.database addPrefetchedItemLists:itemListsByLocationString retrievalID:retrievalID lifetime:lifetime completionHandler:^(OCDatabase *db, NSError *error) {
+				storeError = error;
+				OCSyncExecDone(storeItemLists);
+			}];
+		});
+
+		if (storeError != nil)
+		{
+			OCTLogError(@[@"SubtreeRetrieval"], @"Error storing prefetched item lists: %@", storeError);
+			return (NO);
+		}
+
+		@synchronized(self)
+		{
+			self->_prefetchedItemListsAvailable = YES;
+		}
+
+		return (YES);
+	};
+
+	[self beginActivity:@"Subtree retrieval"];
+
+	// Stream the Depth:infinity PROPFIND response into the parser
+	__block BOOL initialStreamHandlerCallback = YES;
+
+	OCHTTPRequestEphermalStreamHandler streamHandler = ^(OCHTTPRequest *request, OCHTTPResponse * _Nullable response, NSInputStream * _Nullable inputStream, NSError * _Nullable error) {
+		if (initialStreamHandlerCallback)
+		{
+			initialStreamHandlerCallback = NO;
+
+			if ((error != nil) || (inputStream == nil))
+			{
+				EndRetrieval((error != nil) ? error : OCError(OCErrorInternal), 0, 0);
+				return;
+			}
+
+			NSString *basePath = [((NSURL *)request.userInfo[@"endpointURL"]) path];
+
+			// Parsing blocks while waiting for data from the stream, so it needs to happen on its own thread
+			dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+				__block NSUInteger lastFolderCount = 0, lastFileCount = 0;
+				__block BOOL storeFailed = NO;
+				NSError *parseError;
+
+				parseError = [OCCore splitSubtreeResponseStream:inputStream basePath:basePath driveID:driveID batchSize:200 itemListsHandler:^BOOL(NSDictionary<OCPath,NSArray<OCItem *> *> * _Nullable itemListsByPath, NSUInteger folderCount, NSUInteger fileCount) {
+					lastFolderCount = folderCount;
+					lastFileCount = fileCount;
+
+					if (retrievalCancelled)
+					{
+						return (NO);
+					}
+
+					if (itemListsByPath == nil)
+					{
+						if (progressHandler != nil)
+						{
+							progressHandler(folderCount, fileCount);
+						}
+
+						return (YES);
+					}
+
+					return (!(storeFailed = !StoreItemLists(itemListsByPath)));
+				}];
+
+				if ((parseError != nil) && !retrievalCancelled)
+				{
+					if (storeFailed)
+					{
+						parseError = OCError(OCErrorInternal);
+					}
+					else if (requestError != nil)
+					{
+						parseError = requestError;
+					}
+				}
+
+				EndRetrieval(parseError, lastFolderCount, lastFileCount);
+			});
+		}
+	};
+
+	propFindProgress = [self.connection retrieveItemListAtLocation:location depth:OCPropfindDepthInfinity options:[NSDictionary dictionaryWithObjectsAndKeys:
+		[streamHandler copy],			OCConnectionOptionResponseStreamHandler,
+		self.connection.propFindSignals,	OCConnectionOptionRequiredSignalsKey,
+	nil] resultTarget:[OCEventTarget eventTargetWithEphermalEventHandlerBlock:^(OCEvent * _Nonnull event, id  _Nonnull sender) {
+		requestError = event.error;
+
+		if ((event.error != nil) && initialStreamHandlerCallback)
+		{
+			// The request failed before a response stream was received
+			EndRetrieval(event.error, 0, 0);
+		}
+	} userInfo:nil ephermalUserInfo:nil]];
+
+	retrievalProgress.cancellationHandler = ^{
+		retrievalCancelled = YES;
+		[propFindProgress cancel];
+	};
+
+	return (retrievalProgress);
+}
+
+- (void)retrieveSubtreeForUpdateScanAtLocation:(OCLocation *)location
+{
+	// Count the retrieval as pending update job, so the background scan activity is published (and not ended) while it runs
+	@synchronized(_scheduledDirectoryUpdateJobIDs)
+	{
+		_pendingScheduledDirectoryUpdateJobs++;
+
+		[self _updateBackgroundScanActivityWithIncrement:NO currentLocationChange:nil];
+	}
+
+	[self retrieveSubtreeAtLocation:location progressHandler:^(NSUInteger folderCount, NSUInteger fileCount) {
+		[self.activityManager update:[[OCActivityUpdate updatingActivityForIdentifier:OCActivityIdentifierPendingServerScanJobsSummary] withStatusMessage:[NSString stringWithFormat:OCLocalizedString(@"Retrieved %lu folders and %lu files…",nil), (unsigned long)folderCount, (unsigned long)fileCount]]];
+	} completionHandler:^(NSError * _Nullable error, NSUInteger folderCount, NSUInteger fileCount) {
+		if ((error != nil) && ![error isOCErrorWithCode:OCErrorCancelled])
+		{
+			OCTLogError(@[@"SubtreeRetrieval"], @"Subtree retrieval for %@ failed after %lu folders and %lu files - falling back to update scan: %@", location, (unsigned long)folderCount, (unsigned long)fileCount, error);
+		}
+
+		// The update scan for location has been scheduled at this point (unless cancelled)
+		@synchronized(self->_scheduledDirectoryUpdateJobIDs)
+		{
+			self->_pendingScheduledDirectoryUpdateJobs--;
+
+			[self _updateBackgroundScanActivityWithIncrement:NO currentLocationChange:nil];
+		}
+	}];
+}
+
++ (nullable NSError *)splitSubtreeResponseStream:(NSInputStream *)inputStream basePath:(NSString *)basePath driveID:(nullable OCDriveID)driveID batchSize:(NSUInteger)batchSize itemListsHandler:(OCCoreSubtreeItemListsHandler)itemListsHandler
+{
+	OCXMLParser *parser;
+	NSMutableDictionary<OCPath, NSMutableArray<OCItem *> *> *openItemListsByPath = [NSMutableDictionary new];
+	NSMutableDictionary<OCPath, NSMutableArray<OCItem *> *> *closedItemListsByPath = [NSMutableDictionary new];
+	NSMutableArray<OCPath> *openPaths = [NSMutableArray new];
+	NSMutableSet<OCPath> *closedPaths = [NSMutableSet new];
+	__block NSUInteger itemCount = 0, folderCount = 0, closedItemCount = 0;
+	__block NSError *parseError = nil;
+
+	if ((parser = [[OCXMLParser alloc] initWithParser:[[NSXMLParser alloc] initWithStream:inputStream]]) == nil)
+	{
+		return (OCError(OCErrorInternal));
+	}
+
+	parser.options = [NSMutableDictionary dictionaryWithObjectsAndKeys:
+		basePath, 			@"basePath",
+		[NSMutableDictionary new], 	@"usersByUserID",
+	nil];
+
+	parser.parsedObjectStreamConsumer = ^(OCXMLParser *parser, NSError *error, id parsedObject) {
+		if ((parseError == nil) && (error != nil))
+		{
+			parseError = error;
+		}
+
+		if ((parseError == nil) && [parsedObject isKindOfClass:NSError.class])
+		{
+			parseError = parsedObject;
+		}
+
+		if (parseError != nil)
+		{
+			[parser abort];
+			return;
+		}
+
+		if ([parsedObject isKindOfClass:OCItem.class])
+		{
+			OCItem *item = parsedObject;
+			OCPath itemPath = item.path;
+			NSMutableArray<OCItem *> *parentItemList;
+
+			item.driveID = driveID;
+
+			// Close all folders that are not parents of this item: all of their contents have been received
+			while ((openPaths.lastObject != nil) && ![itemPath hasPrefix:openPaths.lastObject])
+			{
+				OCPath closedPath = openPaths.lastObject;
+
+				closedItemListsByPath[closedPath] = openItemListsByPath[closedPath];
+				closedItemCount += openItemListsByPath[closedPath].count;
+				[closedPaths addObject:closedPath];
+
+				[openItemListsByPath removeObjectForKey:closedPath];
+				[openPaths removeLastObject];
+			}
+
+			// Add item to the list of its parent folder
+			if ((parentItemList = openItemListsByPath[itemPath.parentPath]) != nil)
+			{
+				[parentItemList addObject:item];
+			}
+			else if ([closedPaths containsObject:itemPath.parentPath])
+			{
+				// The response is not in depth-first order and the parent folder's list was closed prematurely. Since it is incomplete, hand over
+				// an empty list instead, so that any list already stored for the folder is discarded and it is retrieved with a regular PROPFIND.
+				OCPath invalidPath = itemPath.parentPath;
+
+				OCTLogWarning(@[@"SubtreeRetrieval"], @"Received %@ after its parent folder was closed - discarding the item list of %@", OCLogPrivate(itemPath), OCLogPrivate(invalidPath));
+
+				closedItemCount -= closedItemListsByPath[invalidPath].count;
+				closedItemListsByPath[invalidPath] = [NSMutableArray new];
+
+				[closedPaths removeObject:invalidPath]; // further items in the folder can be ignored
+			}
+
+			if (item.type == OCItemTypeCollection)
+			{
+				// Start a new list for the folder, led by (a copy of) the folder item - just like in a Depth:1 response
+				openItemListsByPath[itemPath] = [NSMutableArray arrayWithObject:((parentItemList != nil) ? [item copy] : item)];
+				[openPaths addObject:itemPath];
+
+				folderCount++;
+			}
+
+			itemCount++;
+
+			if ((itemCount % 1000) == 0)
+			{
+				if (!itemListsHandler(nil, folderCount, itemCount-folderCount))
+				{
+					parseError = OCError(OCErrorCancelled);
+				}
+			}
+
+			// Hand over completed item lists in batches
+			if ((parseError == nil) && (closedItemCount >= batchSize))
+			{
+				if (!itemListsHandler(closedItemListsByPath, folderCount, itemCount-folderCount))
+				{
+					parseError = OCError(OCErrorCancelled);
+				}
+
+				[closedItemListsByPath removeAllObjects];
+				closedItemCount = 0;
+			}
+
+			if (parseError != nil)
+			{
+				[parser abort];
+			}
+		}
+	};
+
+	[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+	if (![parser parse] && (parseError == nil))
+	{
+		parseError = OCError(OCErrorResponseUnknownFormat);
+	}
+
+	if (parseError == nil)
+	{
+		// All remaining open folders are complete, too
+		[closedItemListsByPath addEntriesFromDictionary:openItemListsByPath];
+
+		if ((closedItemListsByPath.count > 0) && !itemListsHandler(closedItemListsByPath, folderCount, itemCount-folderCount))
+		{
+			parseError = OCError(OCErrorCancelled);
+		}
+	}
+
+	return (parseError);
+}
+
+- (nullable NSArray<OCItem *> *)consumePrefetchedItemListForLocation:(OCLocation *)location
+{
+	NSArray<OCItem *> *items = nil;
+	NSUInteger remainingCount = 0;
+	OCLocationString locationString;
+
+	if ((locationString = location.string) == nil)
+	{
+		return (nil);
+	}
+
+	@synchronized(self) // serializes with the flag being set after storing a batch, so that no stored batch is missed
+	{
+		if (!_prefetchedItemListsAvailable)
+		{
+			// Avoid database roundtrips while no subtree retrieval stored any lists
+			return (nil);
+		}
+
+		items = [self.database consumePrefetchedItemListForLocationString:locationString lifetime:OCTypedCast([self classSettingForOCClassSettingsKey:OCCoreSubtreeRetrievalListLifetime], NSNumber).doubleValue remainingCount:&remainingCount];
+
+		if (remainingCount == 0)
+		{
+			_prefetchedItemListsAvailable = NO;
+		}
+	}
+
+	return (items);
+}
+
+@end
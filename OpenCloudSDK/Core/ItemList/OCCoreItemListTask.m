@@ -28,10 +28,13 @@
 #import "OCMacros.h"
 #import "NSProgress+OCExtensions.h"
 #import "OCCoreDirectoryUpdateJob.h"
+#import "OCCore+SubtreeRetrieval.h"
 
 @interface OCCoreItemListTask ()
 {
 	OCActivityIdentifier _activityIdentifier;
+
+	NSArray<OCItem *> *_knownItemsSnapshot; //!< Items of the cached set, captured on the core queue for matching PROPFIND responses on the connection's queue
 }
 
 @end
@@ -117,6 +120,11 @@
 
 			[self->_cachedSet updateWithError:error items:items];
 
+			@synchronized(self)
+			{
+				self->_knownItemsSnapshot = (self->_cachedSet.state == OCCoreItemListStateSuccess) ? [self->_cachedSet.items copy] : nil;
+			}
+
 			if (notifyChange && ((self->_cachedSet.state == OCCoreItemListStateSuccess) || (self->_cachedSet.state == OCCoreItemListStateFailed)))
 			{
 				if (self.changeHandler != nil)
@@ -150,6 +158,33 @@
 	}];
 }
 
+- (NSDictionary<OCFileID, OCItem *> *)_knownItemsByFileID
+{
+	NSArray<OCItem *> *cachedItems;
+	NSMutableDictionary<OCFileID, OCItem *> *knownItemsByFileID = nil;
+
+	// Called from the connection's queue, so use the snapshot of the cached set's items taken on the core queue
+	@synchronized(self)
+	{
+		cachedItems = _knownItemsSnapshot;
+	}
+
+	if (cachedItems != nil)
+	{
+		knownItemsByFileID = [[NSMutableDictionary alloc] initWithCapacity:cachedItems.count];
+
+		for (OCItem *item in cachedItems)
+		{
+			if (item.fileID != nil)
+			{
+				knownItemsByFileID[item.fileID] = item;
+			}
+		}
+	}
+
+	return (knownItemsByFileID);
+}
+
 - (void)_updateRetrievedSet
 {
 	// Request item list from server
@@ -164,20 +199,9 @@
 			[self->_core queueConnectivityBlock:^{
 				[self->_core queueRequestJob:^(dispatch_block_t completionHandler) {
 					NSProgress *retrievalProgress;
+					NSArray<OCItem *> *prefetchedItems;
 
-					OCMeasureEventEnd(self, @"core.queue", propFindEvenRef, @"Beginning PROPFIND");
-
-					OCMeasureEventBegin(self, @"network.propfind", propFindEvenRef, ([NSString stringWithFormat:@"Starting PROPFIND for %@", self.location]));
-
-					retrievalProgress = [self->_core.connection retrieveItemListAtLocation:self.location depth:1 options:[NSDictionary dictionaryWithObjectsAndKeys:
-						// For background scan jobs, wait with scheduling until there is connectivity
-						((self.updateJob.isForQuery) ? self.core.connection.propFindSignals : self.core.connection.actionSignals), 	OCConnectionOptionRequiredSignalsKey,
-
-						// Schedule in a particular group
-						((self.groupID != nil) ? self.groupID : nil), 									OCConnectionOptionGroupIDKey,
-					nil] completionHandler:^(NSError *error, NSArray<OCItem *> *items) {
-						OCMeasureEventEnd(self, @"network.propfind", propFindEvenRef, ([NSString stringWithFormat:@"Completed PROPFIND for %@", self.location]));
-
+					void (^HandleRetrievedItems)(NSError *error, NSArray<OCItem *> *items) = ^(NSError *error, NSArray<OCItem *> *items) {
 						if (self.core.state != OCCoreStateRunning)
 						{
 							// Skip processing the response if the core is not starting or running
@@ -300,6 +324,32 @@
 
 							completionHandler();
 						}];
+					};
+
+					OCMeasureEventEnd(self, @"core.queue", propFindEvenRef, @"Beginning PROPFIND");
+
+					if ((prefetchedItems = [self->_core consumePrefetchedItemListForLocation:self.location]) != nil)
+					{
+						// Items were already retrieved as part of a subtree retrieval => skip the PROPFIND
+						HandleRetrievedItems(nil, prefetchedItems);
+						return;
+					}
+
+					OCMeasureEventBegin(self, @"network.propfind", propFindEvenRef, ([NSString stringWithFormat:@"Starting PROPFIND for %@", self.location]));
+
+					retrievalProgress = [self->_core.connection retrieveItemListAtLocation:self.location depth:1 options:[NSDictionary dictionaryWithObjectsAndKeys:
+						// For background scan jobs, wait with scheduling until there is connectivity
+						((self.updateJob.isForQuery) ? self.core.connection.propFindSignals : self.core.connection.actionSignals), 	OCConnectionOptionRequiredSignalsKey,
+
+						// Match the response against the cached set, so that only new and changed items need to be fully parsed
+						[^{ return ([self _knownItemsByFileID]); } copy],								OCConnectionOptionKnownItemsProvider,
+
+						// Schedule in a particular group
+						((self.groupID != nil) ? self.groupID : nil), 									OCConnectionOptionGroupIDKey,
+					nil] completionHandler:^(NSError *error, NSArray<OCItem *> *items) {
+						OCMeasureEventEnd(self, @"network.propfind", propFindEvenRef, ([NSString stringWithFormat:@"Completed PROPFIND for %@", self.location]));
+
+						HandleRetrievedItems(error, items);
 					}];
 
 					if (retrievalProgress != nil)
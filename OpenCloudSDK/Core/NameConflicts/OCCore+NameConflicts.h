@@ -32,10 +32,12 @@ NS_ASSUME_NONNULL_BEGIN
 typedef BOOL(^OCCoreUnusedNameSuggestionFilter)(NSString *suggestedName); //!< Block to filter suggestions. Return YES if a suggestion should be further considered, NO if it should not.
 
 typedef void(^OCCoreUnusedNameSuggestionResultHandler)(NSString * _Nullable suggestedName, NSArray<NSString *> * _Nullable rejectedAndTakenNames); //!< Block to receive the suggestedName as well as an array of (filter-)rejected and (cache-)taken names.
+typedef void(^OCCoreUnusedNamesSuggestionResultHandler)(NSArray<NSString *> * _Nullable suggestedNames, NSArray<NSString *> * _Nullable rejectedAndTakenNames); //!< Block to receive the suggestedNames as well as an array of (filter-)rejected and (cache-)taken names.
 
 @interface OCCore (NameConflicts)
 
 - (void)suggestUnusedNameBasedOn:(NSString *)name atLocation:(OCLocation *)location isDirectory:(BOOL)isDirectory usingNameStyle:(OCCoreDuplicateNameStyle)nameStyle filteredBy:(nullable OCCoreUnusedNameSuggestionFilter)filter resultHandler:(OCCoreUnusedNameSuggestionResultHandler)resultHandler; //!< Request a suggestion for an unused item name based on a given name and path, filtered by an optional block, returning a suggested name and an array of evaluated, but taken names. 
+- (void)suggestUnusedNames:(NSUInteger)count basedOn:(NSString *)name atLocation:(OCLocation *)location isDirectory:(BOOL)isDirectory usingNameStyle:(OCCoreDuplicateNameStyle)nameStyle filteredBy:(nullable OCCoreUnusedNameSuggestionFilter)filter resultHandler:(OCCoreUnusedNamesSuggestionResultHandler)resultHandler; //!< Like -suggestUnusedNameBasedOn:…, but returns count distinct unused names (f.ex. for a batch of same-named uploads), in ascending order of their duplicate count.
 
 @end
 
@@ -20,6 +20,9 @@
 #import "NSString+NameConflicts.h"
 #import "NSString+OCPath.h"
 #import "OCCore+Internal.h"
+#import "OCDatabase.h"
+#import "OCMacros.h"
+#import "OCLogger.h"
 
 @implementation OCCore (NameConflicts)
 
@@ -31,14 +34,51 @@
 	} allowInlining:YES];
 }
 
+- (void)suggestUnusedNames:(NSUInteger)count basedOn:(NSString *)itemName atLocation:(OCLocation *)location isDirectory:(BOOL)isDirectory usingNameStyle:(OCCoreDuplicateNameStyle)style filteredBy:(nullable OCCoreUnusedNameSuggestionFilter)filter resultHandler:(OCCoreUnusedNamesSuggestionResultHandler)resultHandler
+{
+	[self queueBlock:^{
+		[self _suggestUnusedNames:count basedOn:itemName atLocation:location isDirectory:isDirectory usingNameStyle:style filteredBy:filter resultHandler:resultHandler];
+	} allowInlining:YES];
+}
+
 - (void)_suggestUnusedNameBasedOn:(NSString *)itemName atLocation:(OCLocation *)location isDirectory:(BOOL)isDirectory usingNameStyle:(OCCoreDuplicateNameStyle)style filteredBy:(nullable OCCoreUnusedNameSuggestionFilter)filter resultHandler:(OCCoreUnusedNameSuggestionResultHandler)resultHandler
+{
+	[self _suggestUnusedNames:1 basedOn:itemName atLocation:location isDirectory:isDirectory usingNameStyle:style filteredBy:filter resultHandler:^(NSArray<NSString *> * _Nullable suggestedNames, NSArray<NSString *> * _Nullable rejectedAndTakenNames) {
+		resultHandler(suggestedNames.firstObject, rejectedAndTakenNames);
+	}];
+}
+
+- (nullable NSSet<OCPath> *)_takenPathsInParentLocation:(OCLocation *)location withNamePrefix:(NSString *)namePrefix
+{
+	__block NSSet<OCPath> *takenPaths = nil;
+
+	OCSyncExec(retrieveTakenPaths, {
+		[self.vault.database retrieveCacheItemPathsInParentLocation:location withNamePrefix:namePrefix completionHandler:^(OCDatabase *db, NSError *error, NSSet<OCPath> *paths) {
+			if (error == nil)
+			{
+				takenPaths = paths;
+			}
+			else
+			{
+				OCLogWarning(@"Error retrieving sibling paths for name conflict resolution: %@", error);
+			}
+
+			OCSyncExecDone(retrieveTakenPaths);
+		}];
+	});
+
+	return (takenPaths);
+}
+
+- (void)_suggestUnusedNames:(NSUInteger)count basedOn:(NSString *)itemName atLocation:(OCLocation *)location isDirectory:(BOOL)isDirectory usingNameStyle:(OCCoreDuplicateNameStyle)style filteredBy:(nullable OCCoreUnusedNameSuggestionFilter)filter resultHandler:(OCCoreUnusedNamesSuggestionResultHandler)resultHandler
 {
 	OCCoreDuplicateNameStyle nameStyle = style;
 	NSNumber *duplicateCountNumber = nil;
 	NSString *baseName = nil;
 	NSUInteger duplicateCount = 0;
-	NSString *returnSuggestedName = nil;
+	NSMutableArray <NSString *> *returnSuggestedNames = [NSMutableArray new];
 	NSMutableArray <NSString *> *duplicateNames = [NSMutableArray new];
+	NSSet<OCPath> *takenPaths = nil;
 
 	// Extract information from itemName
 	baseName = [itemName itemBaseNameWithStyle:&nameStyle
@@ -56,8 +96,15 @@
 		nameStyle = style;
 	}
 
-	// Find unused name
-	do
+	// Retrieve the paths of all items whose name starts with the base name (sans extension) in a single query,
+	// so that candidates can be checked in memory rather than with one query per candidate
+	NSRange extensionDotRange = [baseName rangeOfString:@"." options:NSBackwardsSearch];
+	NSString *namePrefix = (extensionDotRange.location != NSNotFound) ? [baseName substringToIndex:extensionDotRange.location] : baseName;
+
+	takenPaths = [self _takenPathsInParentLocation:location withNamePrefix:namePrefix];
+
+	// Find unused names
+	while (returnSuggestedNames.count < count)
 	{
 		// Compute suggested name
 		NSString *suggestedName;
@@ -88,20 +135,39 @@
 		}
 
 		// Check for existing item
-		NSError *error = nil;
+		OCPath suggestedPath = [location.path stringByAppendingPathComponent:suggestedName];
+		BOOL isTaken = NO;
 
-		if ([self cachedItemInParentLocation:location withName:suggestedName isDirectory:isDirectory error:&error] != nil)
+		if (isDirectory)
+		{
+			suggestedPath = suggestedPath.normalizedDirectoryPath;
+		}
+
+		if (takenPaths != nil)
+		{
+			isTaken = [takenPaths containsObject:suggestedPath];
+		}
+		else
+		{
+			// Fall back to checking each candidate individually
+			NSError *error = nil;
+
+			isTaken = ([self cachedItemInParentLocation:location withName:suggestedName isDirectory:isDirectory error:&error] != nil);
+		}
+
+		if (isTaken)
 		{
 			[duplicateNames addObject:suggestedName];
-			duplicateCount++;
 		}
 		else
 		{
-			returnSuggestedName = suggestedName;
+			[returnSuggestedNames addObject:suggestedName];
 		}
-	}while(returnSuggestedName == nil);
 
-	resultHandler(returnSuggestedName, (duplicateNames.count > 0) ? duplicateNames : nil);
+		duplicateCount++;
+	};
+
+	resultHandler(returnSuggestedNames, (duplicateNames.count > 0) ? duplicateNames : nil);
 }
 
 @end
@@ -53,9 +53,10 @@ typedef NS_ENUM(NSUInteger, OCCoreDataSourcePollType)
 - (void)_attemptConnect;
 
 #pragma mark - Inter-Process change notification/handling
+- (NSTimeInterval)ipcNotificationCoalescingInterval; //!< Minimum interval between two inter-process notifications posted for core and sync record updates
 - (void)postIPCChangeNotification;
 - (void)_checkForChangesByOtherProcessesAndUpdateQueries;
-- (void)_replayChangesSinceSyncAnchor:(OCSyncAnchor)fromSyncAnchor;
+- (void)_replayChangesSinceSyncAnchor:(OCSyncAnchor)fromSyncAnchor toSyncAnchor:(nullable OCSyncAnchor)toSyncAnchor; //!< Replays changes made since fromSyncAnchor. toSyncAnchor is the latest sync anchor committed to the database - or nil to have it retrieved after the changes.
 
 #pragma mark - Share queries
 - (void)startShareQuery:(OCShareQuery *)shareQuery;
@@ -27,6 +27,8 @@
 #import "OCCore+FileProvider.h"
 #import "OCCore+ItemPolicies.h"
 #import "NSString+OCPath.h"
+#import "OCVault+Internal.h"
+#import "OCVaultChangeJournal.h"
 
 @implementation OCCore (ItemUpdates)
 
@@ -126,6 +128,12 @@
 
 		// Wait for updates to complete
 		OCWaitForCompletion(cacheUpdatesGroup);
+
+		// Record changes in the vault's change journal, so other processes can replay them without comparing them against their queries' results
+		if (!skipDatabase && (databaseError == nil))
+		{
+			[self.vault.changeJournal appendChangesForAddedItems:addedItems removedItems:removedItems updatedItems:updatedItems syncAnchor:newSyncAnchor];
+		}
 	}
 
 	if ((beforeQueryUpdatesAction!=nil) && skipDatabase)
@@ -151,6 +151,9 @@ typedef id<NSObject> OCCoreItemTracking;
 	OCConnection *_connection;
 	BOOL _attemptConnect;
 
+	OCMeasurement *_startupMeasurement;
+	BOOL _startupMeasurementConnectPending;
+
 	OCPlatformMemoryConfiguration _memoryConfiguration;
 
 	NSMutableArray <OCQuery *> *_queries;
@@ -211,6 +214,7 @@ typedef id<NSObject> OCCoreItemTracking;
 	OCLock *_scanForChangesLock;
 	OCLockRequest *_scanForChangesLockRequest;
 	NSTimeInterval _nextCoordinatedScanRetryTime;
+	BOOL _prefetchedItemListsAvailable;
 
 	NSMutableArray <OCItemPolicy *> *_itemPolicies;
 	NSMutableArray <OCItemPolicyProcessor *> *_itemPolicyProcessors;
@@ -219,6 +223,7 @@ typedef id<NSObject> OCCoreItemTracking;
 
 	NSMutableSet <OCLocation *> *_availableOfflineFolderLocations;
 	NSMutableSet <OCLocalID> *_availableOfflineIDs;
+	NSMutableDictionary <id, NSMutableDictionary *> *_availableOfflineFolderTriesByDriveID; //!< Path component tries of available offline folder locations, by driveID (NSNull for locations without driveID)
 	BOOL _availableOfflineCacheValid;
 	NSMapTable <OCClaimIdentifier, NSObject *> *_claimTokensByClaimIdentifier;
 
@@ -325,6 +330,8 @@ typedef id<NSObject> OCCoreItemTracking;
 
 @property(assign) BOOL postFileProviderNotifications; //!< YES if the core should post file provider notifications and integrate with file provider APIs.
 
+@property(strong,readonly,nullable) OCMeasurement *startupMeasurement; //!< Timing of the phases of the most recent start of the core, up to the completion of the first connect. nil if measurements are disabled.
+
 @property(readonly, strong) OCSyncAnchor latestSyncAnchor;
 
 @property(strong) OCChecksumAlgorithmIdentifier preferredChecksumAlgorithm; //!< Identifier of the preferred checksum algorithm
@@ -475,6 +482,7 @@ typedef id<NSObject> OCCoreItemTracking;
 - (nullable NSArray <OCItemPolicy *> *)retrieveAvailableOfflinePoliciesCoveringItem:(nullable OCItem *)item completionHandler:(nullable OCCoreItemPoliciesCompletionHandler)completionHandler; //!< Retrieves an array of item policies that request offline availability for this item. Passing nil for completionHandler makes this call return results synchronously. Passing nil for item returns all available offline policies.
 - (void)removeAvailableOfflinePolicy:(OCItemPolicy *)itemPolicy completionHandler:(nullable OCCoreCompletionHandler)completionHandler; //!< Removes the provided available offline item policy.
 - (OCCoreAvailableOfflineCoverage)availableOfflinePolicyCoverageOfItem:(OCItem *)item; //!< Determines the available offline coverage for an item. Meant to be used for displaying coverage status.
+- (NSArray <NSNumber *> *)availableOfflinePolicyCoverageOfItems:(NSArray <OCItem *> *)items; //!< Determines the available offline coverage (OCCoreAvailableOfflineCoverage wrapped in NSNumber) for each of the items, in the same order. Items sharing the same parent folder (f.ex. a directory listing) are resolved with a single lookup of the parent folder.
 @end
 
 @interface OCCore (CommandDownload)
@@ -496,6 +504,7 @@ typedef id<NSObject> OCCoreItemTracking;
 
 @interface OCCore (CommandDelete)
 - (nullable NSProgress *)deleteItem:(OCItem *)item requireMatch:(BOOL)requireMatch resultHandler:(nullable OCCoreActionResultHandler)resultHandler;
+- (nullable NSProgress *)deleteItems:(NSArray<OCItem *> *)items requireMatch:(BOOL)requireMatch resultHandler:(nullable OCCoreActionResultHandler)resultHandler; //!< Deletes several items at once, enqueuing all sync records in a single transaction. The resultHandler is called once for every item.
 - (nullable NSProgress *)deleteLocalCopyOfItem:(OCItem *)item resultHandler:(nullable OCCoreActionResultHandler)resultHandler;
 @end
 
@@ -514,8 +523,12 @@ extern OCClassSettingsKey OCCoreThumbnailAvailableForMIMETypePrefixes;
 extern OCClassSettingsKey OCCoreOverrideReachabilitySignal;
 extern OCClassSettingsKey OCCoreOverrideAvailabilitySignal;
 extern OCClassSettingsKey OCCoreActionConcurrencyBudgets;
+extern OCClassSettingsKey OCCoreSyncLaneSchedulingQuantum;
+extern OCClassSettingsKey OCCoreSubtreeRetrievalEnabled;
+extern OCClassSettingsKey OCCoreSubtreeRetrievalListLifetime;
 extern OCClassSettingsKey OCCoreCookieSupportEnabled;
 extern OCClassSettingsKey OCCoreScanForChangesInterval;
+extern OCClassSettingsKey OCCoreIPCNotificationCoalescingInterval;
 
 extern OCDatabaseCounterIdentifier OCCoreSyncAnchorCounter;
 extern OCDatabaseCounterIdentifier OCCoreSyncJournalCounter;
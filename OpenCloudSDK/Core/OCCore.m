@@ -68,6 +68,7 @@
 #import "OCCore+DataSources.h"
 #import "OCDataSourceKVO.h"
 #import "OCVault+Internal.h"
+#import "OCVaultChangeJournal.h"
 #import "OCLocale+SystemLanguage.h"
 #import "OCCore+DataSources.h"
 #import "OCSignalManager.h"
@@ -113,6 +114,8 @@
 
 @synthesize postFileProviderNotifications = _postFileProviderNotifications;
 
+@synthesize startupMeasurement = _startupMeasurement;
+
 @synthesize delegate = _delegate;
 
 @synthesize preferredChecksumAlgorithm = _preferredChecksumAlgorithm;
@@ -166,7 +169,11 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 						OCSyncActionCategoryDownloadWifiOnly   	    : @(2), // Limit number of concurrent downloads by WiFi-only transfers to 2 (leaving at least one spot empty for cellular)
 						OCSyncActionCategoryDownloadWifiAndCellular : @(3) // Limit number of concurrent downloads by WiFi and Cellular transfers to 3
 		},
-		OCCoreCookieSupportEnabled : @(YES)
+		OCCoreSyncLaneSchedulingQuantum : @(8), // Process up to 8 sync records on a lane before giving independent lanes a turn
+		OCCoreSubtreeRetrievalEnabled : @(YES),
+		OCCoreSubtreeRetrievalListLifetime : @(600), // Discard item lists retrieved by a subtree retrieval if they haven't been used for 10 minutes
+		OCCoreCookieSupportEnabled : @(YES),
+		OCCoreIPCNotificationCoalescingInterval : @(250) // Post core and sync record update notifications to other processes at most 4 times per second
 	});
 }
 
@@ -208,6 +215,27 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 			OCClassSettingsMetadataKeyCategory	: @"Connection"
 		},
 
+		OCCoreSyncLaneSchedulingQuantum : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Maximum number of sync records processed on a sync lane before the sync engine moves on to lanes that are independent of it. A value of 0 processes every lane to completion before moving on.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		OCCoreSubtreeRetrievalEnabled : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeBoolean,
+			OCClassSettingsMetadataKeyDescription 	: @"Retrieve entire folder hierarchies with a single Depth:infinity PROPFIND on initial sync and when making folders available offline, if the server supports it.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		OCCoreSubtreeRetrievalListLifetime : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Number of seconds after which unused folder contents retrieved by a subtree retrieval are discarded.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
 		OCCoreScanForChangesInterval : @{
 			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
 			OCClassSettingsMetadataKeyDescription 	: @"Minimum number of milliseconds until the next scan for changes, measured from the completion of the previous scan. If no value is provided, uses the poll interval provided in the server's capabilities (in milliseconds) if it is greater or equal 5 seconds. Defaults to 10 seconds otherwise.",
@@ -215,6 +243,13 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 			OCClassSettingsMetadataKeyCategory	: @"Connection",
 		},
 
+		OCCoreIPCNotificationCoalescingInterval : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Minimum number of milliseconds between two inter-process notifications about core and sync record updates. Bursts of updates within that interval are coalesced into a single notification at the end of the interval. A value of 0 posts every notification immediately.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection",
+		},
+
 		OCCoreAddAcceptLanguageHeader : @{
 			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeBoolean,
 			OCClassSettingsMetadataKeyDescription 	: @"Add an `Accept-Language` HTTP header using the preferred languages set on the device.",
@@ -273,6 +308,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 		_shareQueries = [NSMutableArray new];
 
 		_itemListTasksByLocationString = [NSMutableDictionary new];
+		_prefetchedItemListsAvailable = YES; // item lists stored by a previous run may still exist in the database
 		_queuedItemListTaskUpdateJobs = [NSMutableArray new];
 		_scheduledItemListTasks = [NSMutableArray new];
 		_scheduledDirectoryUpdateJobIDs = [NSMutableSet new];
@@ -324,6 +360,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 
 		_availableOfflineFolderLocations = [NSMutableSet new];
 		_availableOfflineIDs = [NSMutableSet new];
+		_availableOfflineFolderTriesByDriveID = [NSMutableDictionary new];
 
 		_claimTokensByClaimIdentifier = [NSMapTable strongToWeakObjectsMapTable];
 
@@ -463,13 +500,23 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 
 	OCTLogDebug(startTags, @"queuing start request in work queue");
 
+	// Measure startup phases
+	OCMeasurement *startupMeasurement = [OCMeasurement measurementWithTitle:[NSString stringWithFormat:@"Start core for %@", self.bookmark.uuid.UUIDString]];
+	OCMeasureEventBegin(startupMeasurement, @"core.start", startRef, @"Starting core");
+	OCMeasureEventBegin(startupMeasurement, @"core.start.queue", queueRef, @"Queuing start request");
+
 	[self queueBlock:^{
 		OCTLogDebug(startTags, @"performing start request");
 
+		OCMeasureEventEnd(startupMeasurement, @"core.start.queue", queueRef, @"Performing start request");
+
 		if (self->_state == OCCoreStateStopped)
 		{
 			__block NSError *startError = nil;
 
+			self->_startupMeasurement = startupMeasurement;
+			self->_startupMeasurementConnectPending = NO;
+
 			[self recomputeConnectionStatus];
 
 			[self _updateState:OCCoreStateStarting];
@@ -486,10 +533,16 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 				// Configure vault / database
 				self.vault.database.sqlDB.allowMigrations = !OCProcessManager.isProcessExtension;
 
+				OCMeasureEventBegin(startupMeasurement, @"core.start.vault-open", vaultOpenRef, @"Opening vault");
+				[self.vault.database attachMeasurement:startupMeasurement];
+
 				OCSyncExec(openVault, {
 					[self.vault openWithCompletionHandler:^(id sender, NSError *error) {
 						startError = error;
 
+						[self.vault.database detachMeasurement:startupMeasurement];
+						OCMeasureEventEnd(startupMeasurement, @"core.start.vault-open", vaultOpenRef, @"Opened vault");
+
 						if ([startError.domain isEqual:OCSQLiteDBErrorDomain] && (startError.code == OCSQLiteDBErrorMigrationsNotAllowed))
 						{
 							startError = OCError(OCErrorDatabaseMigrationRequired);
@@ -501,42 +554,59 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 			}
 
 			// Find and restart stuck sync records
+			OCMeasureEventBegin(startupMeasurement, @"core.start.stuck-sync-records", stuckSyncRecordsRef, @"Restarting stuck sync records");
 			[self restartStuckSyncRecordsWithFilter:nil];
+			OCMeasureEventEnd(startupMeasurement, @"core.start.stuck-sync-records", stuckSyncRecordsRef, @"Restarted stuck sync records");
 
 			// Get latest sync anchor
 			if (startError == nil)
 			{
+				OCMeasureEventBegin(startupMeasurement, @"core.start.sync-anchor", syncAnchorRef, @"Retrieving latest sync anchor");
+
 				OCSyncExec(retrieveSyncAnchor, {
 					[self retrieveLatestSyncAnchorWithCompletionHandler:^(NSError *error, OCSyncAnchor latestSyncAnchor) {
 						OCSyncExecDone(retrieveSyncAnchor);
 					}];
 				});
+
+				OCMeasureEventEnd(startupMeasurement, @"core.start.sync-anchor", syncAnchorRef, @"Retrieved latest sync anchor");
 			}
 
 			// Get latest drive list
 			if (startError == nil)
 			{
+				OCMeasureEventBegin(startupMeasurement, @"core.start.drives", drivesRef, @"Initializing drives");
+
 				[self initializeWithDrives];
 
 				self->_connection.drives = self.vault.activeDrives;
+
+				OCMeasureEventEnd(startupMeasurement, @"core.start.drives", drivesRef, @"Initialized drives");
 			}
 
 			// Proceed with connecting - or stop
 			if (startError == nil)
 			{
 				// Setup sync engine
+				OCMeasureEventBegin(startupMeasurement, @"core.start.sync-engine", syncEngineRef, @"Setting up sync engine");
 				[self setupSyncEngine];
+				OCMeasureEventEnd(startupMeasurement, @"core.start.sync-engine", syncEngineRef, @"Set up sync engine");
 
 				// Setup item policies
+				OCMeasureEventBegin(startupMeasurement, @"core.start.item-policies", itemPoliciesRef, @"Setting up item policies");
 				[self setupItemPolicies];
+				OCMeasureEventEnd(startupMeasurement, @"core.start.item-policies", itemPoliciesRef, @"Set up item policies");
 
 				// Core is ready
 				[self _updateState:OCCoreStateReady];
 
 				// Attempt connecting
+				self->_startupMeasurementConnectPending = YES;
 				self->_attemptConnect = YES;
 				[self _attemptConnect];
 
+				OCMeasureEventBegin(startupMeasurement, @"core.start.message-queue", messageQueueRef, @"Registering with message queue and resource manager");
+
 				// Register as message autoResolver
 				[self.messageQueue addAutoResolver:self];
 
@@ -550,6 +620,8 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 				[self.vault.resourceManager addSource:[[OCResourceSourceItemLocalThumbnails alloc] initWithCore:self]];
 				[self.vault.resourceManager addSource:[[OCResourceSourceDriveItems alloc] initWithCore:self]];
 				[self.vault.resourceManager addSource:[[OCResourceSourceURLItems alloc] initWithCore:self]];
+
+				OCMeasureEventEnd(startupMeasurement, @"core.start.message-queue", messageQueueRef, @"Registered with message queue and resource manager");
 			}
 			else
 			{
@@ -558,6 +630,13 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 				[self _updateState:OCCoreStateStopped];
 			}
 
+			OCMeasureEventEnd(startupMeasurement, @"core.start", startRef, ((startError != nil) ? @"Start failed" : @"Core started"));
+
+			if (startError != nil)
+			{
+				[startupMeasurement terminate];
+			}
+
 			if (completionHandler != nil)
 			{
 				completionHandler(self, startError);
@@ -733,12 +812,26 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 	[self queueConnectivityBlock:^{
 		if ((self->_state == OCCoreStateReady) && self->_attemptConnect)
 		{
+			OCMeasurement *startupMeasurement = nil;
+
+			// Measure the first connect after start as part of the startup
+			if (self->_startupMeasurementConnectPending)
+			{
+				self->_startupMeasurementConnectPending = NO;
+				startupMeasurement = self->_startupMeasurement;
+			}
+
 			// Open connection
 			dispatch_suspend(self->_connectivityQueue);
 
 			[self beginActivity:@"Connection connect"];
 
+			OCMeasureEventBegin(startupMeasurement, @"core.connect", connectRef, @"Connecting");
+
 			[self.connection connectWithCompletionHandler:^(NSError *error, OCIssue *issue) {
+				OCMeasureEventEnd(startupMeasurement, @"core.connect", connectRef, ((error != nil) ? @"Connect failed" : @"Connected"));
+				[startupMeasurement terminate];
+
 				if (error == nil)
 				{
 					OCChecksumAlgorithmIdentifier preferredUploadChecksumType;
@@ -1049,8 +1142,15 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 }
 
 #pragma mark - Inter-Process change notification/handling
+- (NSTimeInterval)ipcNotificationCoalescingInterval
+{
+	return ([[self classSettingForOCClassSettingsKey:OCCoreIPCNotificationCoalescingInterval] doubleValue] / 1000.0);
+}
+
 - (void)startIPCObservation
 {
+	[_ipNotificationCenter setMinimumInterval:self.ipcNotificationCoalescingInterval forName:self.bookmark.coreUpdateNotificationName];
+
 	[_ipNotificationCenter addObserver:self forName:self.bookmark.coreUpdateNotificationName withHandler:^(OCIPNotificationCenter * _Nonnull notificationCenter, OCCore *  _Nonnull core, OCIPCNotificationName  _Nonnull notificationName) {
 		[core handleIPCChangeNotification];
 	}];
@@ -1168,7 +1268,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 
 			// Sync anchor changed, so there may be changes => replay any you can find
 			_latestSyncAnchor = lastKnownSyncAnchor;
-			[self _replayChangesSinceSyncAnchor:lastKnownSyncAnchor];
+			[self _replayChangesSinceSyncAnchor:lastKnownSyncAnchor toSyncAnchor:nil];
 		}
 		else
 		{
@@ -1181,7 +1281,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 	}
 }
 
-- (void)_replayChangesSinceSyncAnchor:(OCSyncAnchor)fromSyncAnchor
+- (void)_replayChangesSinceSyncAnchor:(OCSyncAnchor)fromSyncAnchor toSyncAnchor:(OCSyncAnchor)toSyncAnchor
 {
 	[self beginActivity:@"Replaying changes since sync anchor"];
 
@@ -1205,14 +1305,55 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 
 		if ((addedOrUpdatedItems.count > 0) || (removedItems.count > 0))
 		{
-			OCCoreItemList *addedOrUpdatedItemsList = [OCCoreItemList itemListWithItems:addedOrUpdatedItems];
+			NSArray<OCVaultChangeJournalEntry *> *journalEntries;
+			OCCoreItemUpdateAction findMovedItemsAction = nil;
+			__block OCSyncAnchor latestSyncAnchor = toSyncAnchor;
 
-			[self performUpdatesForAddedItems:nil
-			   	removedItems:removedItems
-				updatedItems:addedOrUpdatedItems
-				refreshLocations:nil
-				newSyncAnchor:syncAnchor
-				beforeQueryUpdates:^(dispatch_block_t  _Nonnull completionHandler) {
+			if (latestSyncAnchor == nil)
+			{
+				// Retrieved after the changes, so it is at least as new as any of them (runs inline, as this is called on the SQLite thread)
+				[self.vault.database retrieveValueForCounter:OCCoreSyncAnchorCounter completionHandler:^(NSError *error, NSNumber *counterValue) {
+					latestSyncAnchor = counterValue;
+				}];
+			}
+
+			if ((journalEntries = [self.vault.changeJournal entriesSinceSyncAnchor:fromSyncAnchor untilSyncAnchor:latestSyncAnchor]) != nil)
+			{
+				// The change journal covers all changes since fromSyncAnchor and tells where moved items came from
+				NSMutableDictionary<OCLocalID, OCPath> *previousPathsByLocalID = [NSMutableDictionary new];
+
+				for (OCVaultChangeJournalEntry *entry in journalEntries)
+				{
+					if (entry.kind == OCVaultChangeKindMoved)
+					{
+						if (previousPathsByLocalID[entry.localID] == nil) // Keep the path from before the first move
+						{
+							previousPathsByLocalID[entry.localID] = entry.previousPath;
+						}
+					}
+				}
+
+				for (OCItem *item in addedOrUpdatedItems)
+				{
+					OCPath previousPath;
+
+					if ((item.localID != nil) && ((previousPath = previousPathsByLocalID[item.localID]) != nil) &&
+					    ![item.path.stringByDeletingLastPathComponent isEqual:previousPath.stringByDeletingLastPathComponent])
+					{
+						OCTLogDebug(@[@"Replay"], @"Found moved item in change journal (from=%@ to=%@)", previousPath, item.path);
+
+						item.previousPath = previousPath;
+					}
+				}
+
+				OCTLogDebug(@[@"Replay"], @"Used %lu change journal entries to find moved items", (unsigned long)journalEntries.count);
+			}
+			else
+			{
+				// Change journal doesn't cover the changes, so compare against the contents of the running queries
+				OCCoreItemList *addedOrUpdatedItemsList = [OCCoreItemList itemListWithItems:addedOrUpdatedItems];
+
+				findMovedItemsAction = ^(dispatch_block_t  _Nonnull completionHandler) {
 					// Find items that moved to a different path
 					NSArray *queries;
 
@@ -1250,7 +1391,15 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 					}
 
 					completionHandler();
-				}
+				};
+			}
+
+			[self performUpdatesForAddedItems:nil
+			   	removedItems:removedItems
+				updatedItems:addedOrUpdatedItems
+				refreshLocations:nil
+				newSyncAnchor:syncAnchor
+				beforeQueryUpdates:findMovedItemsAction
 				afterQueryUpdates:nil
 				queryPostProcessor:nil
 				skipDatabase:YES
@@ -2537,8 +2686,12 @@ OCClassSettingsKey OCCoreThumbnailAvailableForMIMETypePrefixes = @"thumbnail-ava
 OCClassSettingsKey OCCoreOverrideReachabilitySignal = @"override-reachability-signal";
 OCClassSettingsKey OCCoreOverrideAvailabilitySignal = @"override-availability-signal";
 OCClassSettingsKey OCCoreActionConcurrencyBudgets = @"action-concurrency-budgets";
+OCClassSettingsKey OCCoreSyncLaneSchedulingQuantum = @"sync-lane-scheduling-quantum";
+OCClassSettingsKey OCCoreSubtreeRetrievalEnabled = @"subtree-retrieval-enabled";
+OCClassSettingsKey OCCoreSubtreeRetrievalListLifetime = @"subtree-retrieval-list-lifetime";
 OCClassSettingsKey OCCoreCookieSupportEnabled = @"cookie-support-enabled";
 OCClassSettingsKey OCCoreScanForChangesInterval = @"scan-for-changes-interval";
+OCClassSettingsKey OCCoreIPCNotificationCoalescingInterval = @"ipc-notification-coalescing-interval";
 
 OCDatabaseCounterIdentifier OCCoreSyncAnchorCounter = @"syncAnchor";
 OCDatabaseCounterIdentifier OCCoreSyncJournalCounter = @"syncJournal";
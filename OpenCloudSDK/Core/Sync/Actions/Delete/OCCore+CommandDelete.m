@@ -28,6 +28,32 @@
 	return ([self _enqueueSyncRecordWithAction:[[OCSyncActionDelete alloc] initWithItem:item requireMatch:requireMatch] cancellable:NO resultHandler:resultHandler]);
 }
 
+- (nullable NSProgress *)deleteItems:(NSArray<OCItem *> *)items requireMatch:(BOOL)requireMatch resultHandler:(nullable OCCoreActionResultHandler)resultHandler
+{
+	NSMutableArray<OCSyncAction *> *actions = [[NSMutableArray alloc] initWithCapacity:items.count];
+	NSArray<NSProgress *> *itemProgresses;
+	NSProgress *progress;
+
+	if (items.count == 0) { return (nil); }
+
+	for (OCItem *item in items)
+	{
+		[actions addObject:[[OCSyncActionDelete alloc] initWithItem:item requireMatch:requireMatch]];
+	}
+
+	itemProgresses = [self _enqueueSyncRecordsWithActions:actions cancellable:NO preflightResultHandler:nil resultHandler:resultHandler];
+
+	progress = [NSProgress progressWithTotalUnitCount:itemProgresses.count];
+	progress.cancellable = NO;
+
+	for (NSProgress *itemProgress in itemProgresses)
+	{
+		[progress addChild:itemProgress withPendingUnitCount:1];
+	}
+
+	return (progress);
+}
+
 - (nullable NSProgress *)deleteLocalCopyOfItem:(OCItem *)item resultHandler:(nullable OCCoreActionResultHandler)resultHandler
 {
 	return ([self _enqueueSyncRecordWithAction:[[OCSyncActionLocalCopyDelete alloc] initWithItem:item] cancellable:NO resultHandler:resultHandler]);
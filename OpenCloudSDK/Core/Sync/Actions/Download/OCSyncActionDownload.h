@@ -21,6 +21,7 @@
 @interface OCSyncActionDownload : OCSyncAction <OCSyncActionOptions>
 
 @property(assign) NSUInteger resolutionRetries;
+@property(strong) NSString *rangedDownloadFileName; //!< Name of the temporary file ranged downloads are written to. Persisted with the sync record, so an interrupted ranged download can resume with the missing ranges.
 
 - (instancetype)initWithItem:(OCItem *)item options:(NSDictionary<OCCoreOption,id> *)options;
 
@@ -23,6 +23,7 @@
 #import "OCCore+Claims.h"
 #import "OCWaitConditionMetaDataRefresh.h"
 #import "OCCellularManager.h"
+#import "OCRangedDownloadJob.h"
 
 static OCMessageTemplateIdentifier OCMessageTemplateIdentifierDownloadOverwrite = @"download.overwrite";
 static OCMessageTemplateIdentifier OCMessageTemplateIdentifierDownloadRetry = @"download.retry";
@@ -213,6 +214,19 @@ OCSYNCACTION_REGISTER_ISSUETEMPLATES
 
 		syncContext.updatedItems = @[ item ];
 	}
+
+	[self removeRangedDownloadFiles];
+}
+
+- (void)removeRangedDownloadFiles
+{
+	if (_rangedDownloadFileName != nil)
+	{
+		NSURL *rangedDownloadFileURL = [self.core.vault.temporaryDownloadURL URLByAppendingPathComponent:_rangedDownloadFileName];
+
+		[NSFileManager.defaultManager removeItemAtURL:rangedDownloadFileURL error:NULL];
+		[NSFileManager.defaultManager removeItemAtURL:[OCRangedDownloadJob checkpointURLForTargetURL:rangedDownloadFileURL] error:NULL];
+	}
 }
 
 - (OCCoreSyncInstruction)scheduleWithContext:(OCSyncContext *)syncContext
@@ -316,7 +330,23 @@ OCSYNCACTION_REGISTER_ISSUETEMPLATES
 		NSDictionary *options = self.options;
 
 		NSURL *temporaryDirectoryURL = self.core.vault.temporaryDownloadURL;
-		NSURL *temporaryFileURL = [temporaryDirectoryURL URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+		NSURL *temporaryFileURL = nil;
+
+		if ([OCConnection shouldDownloadItemInRanges:item])
+		{
+			// Ranged downloads always use the same temporary file, so that an interrupted download can resume from its checkpoint
+			if (_rangedDownloadFileName == nil)
+			{
+				_rangedDownloadFileName = NSUUID.UUID.UUIDString;
+				syncContext.updateStoredSyncRecordAfterItemUpdates = YES; // Update sync record in db, so rangedDownloadFileName is persisted
+			}
+
+			temporaryFileURL = [temporaryDirectoryURL URLByAppendingPathComponent:_rangedDownloadFileName];
+		}
+		else
+		{
+			temporaryFileURL = [temporaryDirectoryURL URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+		}
 
 		OCLogDebug(@"record %@ download: setting up directory", syncContext.syncRecord);
 
@@ -575,6 +605,8 @@ OCSYNCACTION_REGISTER_ISSUETEMPLATES
 		if ([downloadError isOCErrorWithCode:OCErrorCancelled])
 		{
 			// Download has been cancelled by the user => create no issue, remove sync record reference and the record itself instead
+			[self removeRangedDownloadFiles];
+
 			if (item != nil)
 			{
 				[item removeSyncRecordID:syncContext.syncRecord.recordID activity:OCItemSyncActivityDownloading];
@@ -790,12 +822,14 @@ OCSYNCACTION_REGISTER_ISSUETEMPLATES
 {
 	self.options = [decoder decodeObjectOfClasses:OCEvent.safeClasses forKey:@"options"];
 	_resolutionRetries = (NSUInteger)[decoder decodeIntForKey:@"resolutionRetries"];
+	_rangedDownloadFileName = [decoder decodeObjectOfClass:NSString.class forKey:@"rangedDownloadFileName"];
 }
 
 - (void)encodeActionData:(NSCoder *)coder
 {
 	[coder encodeObject:self.options forKey:@"options"];
 	[coder encodeInteger:_resolutionRetries forKey:@"resolutionRetries"];
+	[coder encodeObject:_rangedDownloadFileName forKey:@"rangedDownloadFileName"];
 }
 
 @end
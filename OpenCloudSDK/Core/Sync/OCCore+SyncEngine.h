@@ -52,6 +52,7 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)setNeedsToProcessSyncRecords;
 
 - (void)submitSyncRecord:(OCSyncRecord *)record withPreflightResultHandler:(nullable OCCoreCompletionHandler)preflightResultHandler;
+- (void)submitSyncRecords:(NSArray<OCSyncRecord *> *)records withPreflightResultHandler:(nullable OCCoreCompletionHandler)preflightResultHandler; //!< Submits several records in one transaction, with one lane assignment pass and one change notification. Records failing pre-flight are cleaned up and completed individually, exactly like with -submitSyncRecord:…, so their result handlers receive their own errors. The preflightResultHandler is called once for the entire batch, with the first error encountered (if any).
 - (void)rescheduleSyncRecord:(OCSyncRecord *)syncRecord withUpdates:(NSError * _Nullable (^ _Nullable)(OCSyncRecord *record))applyUpdates;
 - (void)descheduleSyncRecord:(OCSyncRecord *)syncRecord completeWithError:(nullable NSError *)completionError parameter:(nullable id)parameter;
 
@@ -68,6 +69,7 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Sync enqueue utilities
 - (nullable NSProgress *)_enqueueSyncRecordWithAction:(OCSyncAction *)action cancellable:(BOOL)cancellable resultHandler:(nullable OCCoreActionResultHandler)resultHandler;
 - (nullable NSProgress *)_enqueueSyncRecordWithAction:(OCSyncAction *)action cancellable:(BOOL)cancellable preflightResultHandler:(nullable OCCoreCompletionHandler)preflightResultHandler resultHandler:(nullable OCCoreActionResultHandler)resultHandler;
+- (NSArray<NSProgress *> *)_enqueueSyncRecordsWithActions:(NSArray<OCSyncAction *> *)actions cancellable:(BOOL)cancellable preflightResultHandler:(nullable OCCoreCompletionHandler)preflightResultHandler resultHandler:(nullable OCCoreActionResultHandler)resultHandler; //!< Bulk version of -_enqueueSyncRecordWithAction:…: creates and submits the sync records for all actions in a single transaction. The resultHandler is called once per action.
 
 #pragma mark - Sync action utilities
 - (OCEventTarget *)_eventTargetWithSyncRecord:(OCSyncRecord *)syncRecord userInfo:(nullable NSDictionary *)userInfo ephermal:(nullable NSDictionary *)ephermalUserInfo;
@@ -34,6 +34,7 @@
 #import "OCWaitCondition.h"
 #import "OCProcessManager.h"
 #import "OCSyncLane.h"
+#import "OCSyncLaneScheduler.h"
 #import "OCSyncRecordActivity.h"
 #import "OCEventRecord.h"
 #import "OCEventQueue.h"
@@ -90,6 +91,8 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 		[core setNeedsToProcessSyncRecords];
 	}];
 
+	[OCIPNotificationCenter.sharedNotificationCenter setMinimumInterval:self.ipcNotificationCoalescingInterval forName:updateRecordsNotificationName];
+
 	[OCIPNotificationCenter.sharedNotificationCenter addObserver:self forName:updateRecordsNotificationName withHandler:^(OCIPNotificationCenter * _Nonnull notificationCenter, OCCore * _Nonnull core, OCIPCNotificationName  _Nonnull notificationName) {
 		[core updatePublishedSyncRecordActivities];
 	}];
@@ -218,7 +221,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 		{
 			// => changes have been happening outside this process => replay to update queries
 			self->_latestSyncAnchor = previousCounterValue;
-			[self _replayChangesSinceSyncAnchor:self->_latestSyncAnchor];
+			[self _replayChangesSinceSyncAnchor:self->_latestSyncAnchor toSyncAnchor:previousCounterValue];
 		}
 
 		if (protectedBlock != nil)
@@ -286,6 +289,52 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 	NSProgress *progress = nil;
 	OCSyncRecord *syncRecord;
 
+	if ((syncRecord = [self _syncRecordWithAction:action cancellable:cancellable resultHandler:resultHandler progress:&progress]) != nil)
+	{
+		[self submitSyncRecord:syncRecord withPreflightResultHandler:preflightResultHandler];
+	}
+
+	return(progress);
+}
+
+- (NSArray<NSProgress *> *)_enqueueSyncRecordsWithActions:(NSArray<OCSyncAction *> *)actions cancellable:(BOOL)cancellable preflightResultHandler:(nullable OCCoreCompletionHandler)preflightResultHandler resultHandler:(nullable OCCoreActionResultHandler)resultHandler
+{
+	NSMutableArray<NSProgress *> *progresses = [[NSMutableArray alloc] initWithCapacity:actions.count];
+	NSMutableArray<OCSyncRecord *> *syncRecords = [[NSMutableArray alloc] initWithCapacity:actions.count];
+
+	for (OCSyncAction *action in actions)
+	{
+		NSProgress *progress = nil;
+		OCSyncRecord *syncRecord;
+
+		if ((syncRecord = [self _syncRecordWithAction:action cancellable:cancellable resultHandler:resultHandler progress:&progress]) != nil)
+		{
+			[syncRecords addObject:syncRecord];
+		}
+
+		if (progress != nil)
+		{
+			[progresses addObject:progress];
+		}
+	}
+
+	if (syncRecords.count > 0)
+	{
+		[self submitSyncRecords:syncRecords withPreflightResultHandler:preflightResultHandler];
+	}
+	else if (preflightResultHandler != nil)
+	{
+		preflightResultHandler(OCError(OCErrorInsufficientParameters));
+	}
+
+	return (progresses);
+}
+
+- (nullable OCSyncRecord *)_syncRecordWithAction:(OCSyncAction *)action cancellable:(BOOL)cancellable resultHandler:(OCCoreActionResultHandler)resultHandler progress:(NSProgress * _Nullable * _Nonnull)outProgress
+{
+	NSProgress *progress = nil;
+	OCSyncRecord *syncRecord = nil;
+
 	if (action != nil)
 	{
 		OCSignalUUID resultSignalUUID = nil;
@@ -341,11 +390,90 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 			// Without resultHandler, the syncRecord can be processed on any process
 			// syncRecord.isProcessIndependent = YES; // commented out for now to limit the number of changes in 11.4.5
 		}
+	}
 
-		[self submitSyncRecord:syncRecord withPreflightResultHandler:preflightResultHandler];
+	*outProgress = progress;
+
+	return (syncRecord);
+}
+
+- (NSError *)_preflightSyncRecord:(OCSyncRecord *)record removedSelf:(BOOL *)outRecordRemovedSelf
+{
+	NSError *error = nil;
+	BOOL recordRemovedSelf = NO;
+
+	OCSyncAction *syncAction;
+
+	if ((syncAction = record.action) != nil)
+	{
+		OCSyncContext *syncContext;
+
+		OCLogDebug(@"record %@ enters preflight", record);
+
+		if ((syncContext = [OCSyncContext preflightContextWithSyncRecord:record]) != nil)
+		{
+			// Run pre-flight
+			error = [self processWithContext:syncContext block:^NSError *(OCSyncAction *action) {
+				if ([syncAction implements:@selector(preflightWithContext:)])
+				{
+					[action preflightWithContext:syncContext];
+				}
+
+				if ([action conformsToProtocol:@protocol(OCSyncActionOptions)])
+				{
+					// Implement globally managed options
+					OCSyncAction<OCSyncActionOptions> *actionWithOptions = (OCSyncAction<OCSyncActionOptions> *)action;
+
+					// Check for and add wait conditions
+					NSArray<OCWaitCondition *> *waitConditions;
+					if ((waitConditions = actionWithOptions.options[OCCoreOptionWaitConditions]) != nil)
+					{
+						// Add wait conditions
+						for (OCWaitCondition *waitCondition in waitConditions)
+						{
+							[syncContext addWaitCondition:waitCondition];
+						}
+					}
+				}
+
+				if (syncContext.error == nil)
+				{
+					// Pre-flight successful, so this can progress to ready
+					[syncContext transitionToState:OCSyncRecordStateReady withWaitConditions:nil];
+				}
+
+				return (syncContext.error);
+			}];
+
+			if ([syncContext.removeRecords containsObject:record])
+			{
+				recordRemovedSelf = YES;
+			}
+
+			OCLogDebug(@"record %@ returns from preflight with addedItems=%@, removedItems=%@, updatedItems=%@, refreshLocations=%@, removeRecords=%@, updateStoredSyncRecordAfterItemUpdates=%d, error=%@", record, syncContext.addedItems, syncContext.removedItems, syncContext.updatedItems, syncContext.refreshLocations, syncContext.removeRecords, syncContext.updateStoredSyncRecordAfterItemUpdates, syncContext.error);
+		}
+	}
+	else
+	{
+		// Records needs to contain an action
+		error = OCError(OCErrorInsufficientParameters);
 	}
 
-	return(progress);
+	*outRecordRemovedSelf = recordRemovedSelf;
+
+	return (error);
+}
+
+- (void)_cleanUpSyncRecord:(OCSyncRecord *)record afterPreflightError:(NSError *)preflightError
+{
+	OCLogDebug(@"record %@ completed preflight with error=%@", record, preflightError);
+
+	if ((record.recordID != nil) && !record.removed)
+	{
+		// Record still has a recordID and has not been removed, so wasn't included in syncContext.removeRecords.
+		// -> remove now
+		[self removeSyncRecords:@[ record ] completionHandler:nil];
+	}
 }
 
 - (void)submitSyncRecord:(OCSyncRecord *)record withPreflightResultHandler:(OCCoreCompletionHandler)preflightResultHandler
@@ -370,62 +498,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 		if (blockError == nil)
 		{
-			OCSyncAction *syncAction;
-
-			if ((syncAction = record.action) != nil)
-			{
-				OCSyncContext *syncContext;
-
-				OCLogDebug(@"record %@ enters preflight", record);
-
-				if ((syncContext = [OCSyncContext preflightContextWithSyncRecord:record]) != nil)
-				{
-					// Run pre-flight
-					blockError = [self processWithContext:syncContext block:^NSError *(OCSyncAction *action) {
-						if ([syncAction implements:@selector(preflightWithContext:)])
-						{
-							[action preflightWithContext:syncContext];
-						}
-
-						if ([action conformsToProtocol:@protocol(OCSyncActionOptions)])
-						{
-							// Implement globally managed options
-							OCSyncAction<OCSyncActionOptions> *actionWithOptions = (OCSyncAction<OCSyncActionOptions> *)action;
-
-							// Check for and add wait conditions
-							NSArray<OCWaitCondition *> *waitConditions;
-							if ((waitConditions = actionWithOptions.options[OCCoreOptionWaitConditions]) != nil)
-							{
-								// Add wait conditions
-								for (OCWaitCondition *waitCondition in waitConditions)
-								{
-									[syncContext addWaitCondition:waitCondition];
-								}
-							}
-						}
-
-						if (syncContext.error == nil)
-						{
-							// Pre-flight successful, so this can progress to ready
-							[syncContext transitionToState:OCSyncRecordStateReady withWaitConditions:nil];
-						}
-
-						return (syncContext.error);
-					}];
-
-					if ([syncContext.removeRecords containsObject:record])
-					{
-						recordRemovedSelf = YES;
-					}
-
-					OCLogDebug(@"record %@ returns from preflight with addedItems=%@, removedItems=%@, updatedItems=%@, refreshLocations=%@, removeRecords=%@, updateStoredSyncRecordAfterItemUpdates=%d, error=%@", record, syncContext.addedItems, syncContext.removedItems, syncContext.updatedItems, syncContext.refreshLocations, syncContext.removeRecords, syncContext.updateStoredSyncRecordAfterItemUpdates, syncContext.error);
-				}
-			}
-			else
-			{
-				// Records needs to contain an action
-				blockError = OCError(OCErrorInsufficientParameters);
-			}
+			blockError = [self _preflightSyncRecord:record removedSelf:&recordRemovedSelf];
 		}
 
 		// Assign to lane
@@ -462,14 +535,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 		// Handle errors during pre-flight
 		if (blockError != nil)
 		{
-			OCLogDebug(@"record %@ completed preflight with error=%@", record, blockError);
-
-			if ((record.recordID != nil) && !record.removed)
-			{
-				// Record still has a recordID and has not been removed, so wasn't included in syncContext.removeRecords.
-				// -> remove now
-				[self removeSyncRecords:@[ record ] completionHandler:nil];
-			}
+			[self _cleanUpSyncRecord:record afterPreflightError:blockError];
 		}
 
 		return (blockError);
@@ -493,6 +559,130 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 	}];
 }
 
+- (void)submitSyncRecords:(NSArray<OCSyncRecord *> *)records withPreflightResultHandler:(OCCoreCompletionHandler)preflightResultHandler
+{
+	NSMutableArray<OCSyncRecord *> *failedRecords = [NSMutableArray new];
+	NSMapTable<OCSyncRecord *, NSError *> *errorsByRecord = [NSMapTable strongToStrongObjectsMapTable];
+
+	OCLogDebug(@"%lu records submitted", records.count);
+
+	[self performProtectedSyncBlock:^NSError *{
+		__block NSError *addError = nil;
+		NSMutableArray<OCSyncRecord *> *laneRecords = [[NSMutableArray alloc] initWithCapacity:records.count];
+		NSMutableArray<NSSet<OCSyncLaneTag> *> *laneTagSets = [[NSMutableArray alloc] initWithCapacity:records.count];
+
+		// Add all sync records to database in a single transaction (=> ensures they are persisted and have a recordID)
+		[self addSyncRecords:records completionHandler:^(OCDatabase *db, NSError *error) {
+			addError = error;
+		}];
+
+		OCLogDebug(@"%lu records added to database with error %@", records.count, addError);
+
+		if (addError != nil)
+		{
+			// Rolls back the transaction, so that none of the records is persisted
+			return (addError);
+		}
+
+		// Pre-flight
+		for (OCSyncRecord *record in records)
+		{
+			BOOL recordRemovedSelf = NO;
+			NSError *preflightError;
+
+			// Set sync record's progress path
+			record.progress.path = @[OCProgressPathElementIdentifierCoreRoot, self.bookmark.uuid.UUIDString, OCProgressPathElementIdentifierCoreSyncRecordPath, [record.recordID stringValue]];
+
+			if ((preflightError = [self _preflightSyncRecord:record removedSelf:&recordRemovedSelf]) != nil)
+			{
+				// Clean up right away, just like -submitSyncRecord:… does, so that the pre-flight of the following records doesn't encounter it
+				[self _cleanUpSyncRecord:record afterPreflightError:preflightError];
+
+				[errorsByRecord setObject:preflightError forKey:record];
+				[failedRecords addObject:record];
+			}
+			else if (recordRemovedSelf)
+			{
+				OCLogDebug(@"record %@ removed itself during preflight via the context's .removeRecords", record);
+			}
+			else
+			{
+				[laneRecords addObject:record];
+				[laneTagSets addObject:((record.laneTags != nil) ? record.laneTags : [NSSet new])];
+			}
+		}
+
+		// Assign to lanes in a single pass
+		if (laneRecords.count > 0)
+		{
+			NSArray *lanes;
+			BOOL updatedLanes = NO;
+			__block NSError *updateError = nil;
+
+			lanes = [self.database lanesForTagSets:laneTagSets updatedLanes:&updatedLanes];
+
+			[lanes enumerateObjectsUsingBlock:^(id lane, NSUInteger idx, BOOL * _Nonnull stop) {
+				if ([lane isKindOfClass:OCSyncLane.class])
+				{
+					laneRecords[idx].laneID = ((OCSyncLane *)lane).identifier;
+				}
+			}];
+
+			[self updateSyncRecords:laneRecords completionHandler:^(OCDatabase *db, NSError *error) {
+				updateError = error;
+			}];
+
+			if (updateError != nil)
+			{
+				OCLogError(@"Error %@ updating %lu sync records after assigning lanes", updateError, laneRecords.count);
+				return (updateError);
+			}
+
+			OCLogDebug(@"%lu records added to %lu lanes", laneRecords.count, [NSSet setWithArray:lanes].count);
+
+			if (updatedLanes)
+			{
+				[self setNeedsToProcessSyncRecords];
+			}
+		}
+
+		return (nil);
+	} completionHandler:^(NSError *error) {
+		NSError *firstError = error;
+
+		if (error != nil)
+		{
+			// Transaction failed as a whole
+			for (OCSyncRecord *record in records)
+			{
+				[record completeWithError:error core:self item:record.action.localItem parameter:record];
+			}
+		}
+		else
+		{
+			// Individual records failed pre-flight
+			for (OCSyncRecord *record in failedRecords)
+			{
+				NSError *recordError = [errorsByRecord objectForKey:record];
+
+				if (firstError == nil) { firstError = recordError; }
+
+				[record completeWithError:recordError core:self item:record.action.localItem parameter:record];
+			}
+		}
+
+		if (preflightResultHandler != nil)
+		{
+			// Call preflight handler on a different thread to avoid dead-locks
+			dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+				preflightResultHandler(firstError);
+			});
+		}
+
+		[self setNeedsToProcessSyncRecords];
+	}];
+}
+
 - (NSError *)_rescheduleSyncRecord:(OCSyncRecord *)syncRecord withUpdates:(NSError *(^)(OCSyncRecord *record))applyUpdates
 {
 	__block NSError *error = nil;
@@ -788,7 +978,6 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 	[self performProtectedSyncBlock:^NSError *{
 		__block NSArray <OCSyncLane *> *lanes = nil;
 		NSMutableSet<OCSyncLaneID> *activeLaneIDs = [NSMutableSet new];
-		NSUInteger activeLanes = 0;
 		NSDictionary<OCSyncActionCategory, NSNumber *> *actionBudgetsByCategory = [self classSettingForOCClassSettingsKey:OCCoreActionConcurrencyBudgets];
 		NSMutableDictionary<OCSyncActionCategory, NSNumber *> *runningActionsByCategory = [NSMutableDictionary new];
 		void (^UpdateRunningActionCategories)(NSArray <OCSyncActionCategory> *categories, NSInteger change) = ^(NSArray <OCSyncActionCategory> *categories, NSInteger change) {
@@ -828,12 +1017,19 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 			[activeLaneIDs addObject:lane.identifier];
 		}
 
-		for (OCSyncLane *lane in lanes)
-		{
+		// Process lanes in shards of lanes that share neither tags nor dependencies, giving each shard a turn of up to
+		// quantum records before moving on to the next shard - so that a long lane can't hold up independent lanes
+		OCSyncLaneScheduler *laneScheduler = [[OCSyncLaneScheduler alloc] initWithLanes:lanes];
+
+		laneScheduler.quantum = OCTypedCast([self classSettingForOCClassSettingsKey:OCCoreSyncLaneSchedulingQuantum], NSNumber).unsignedIntegerValue;
+		laneScheduler.maximumActiveLanes = self.maximumSyncLanes; // Enforce active lane limit
+
+		OCLogDebug(@"processing %lu sync lanes in %lu shards", lanes.count, laneScheduler.shards.count);
+
+		[laneScheduler runWithLaneProcessor:^OCSyncLaneSchedulerLaneStatus(OCSyncLane *lane, OCSyncLaneCursor *cursor, NSUInteger quantum) {
 			__block BOOL stopProcessing = NO;
-			__block OCSyncRecordID lastSyncRecordID = nil;
-			__block NSUInteger recordsOnLane = 0;
-			__block NSError *error = nil;
+			__block NSError *error = cursor.error;
+			NSUInteger recordsProcessedInTurn = 0;
 
 			OCLogDebug(@"processing sync records on lane %@", lane);
 
@@ -851,14 +1047,28 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 						OCLogDebug(@"skipping lane %@ because lanes it is waiting for are still active: %@", lane, blockingLaneIDs);
 					}
 
-					continue;
+					cursor.skipped = YES;
+
+					return (OCSyncLaneSchedulerLaneStatusCompleted);
 				}
 			}
 
 			while (!stopProcessing)
 			{
+				if ((quantum > 0) && (recordsProcessedInTurn >= quantum))
+				{
+					// Quantum used up => yield to other shards
+					OCLogDebug(@"lane %@ yields after processing %lu records", lane, recordsProcessedInTurn);
+
+					cursor.error = error;
+
+					return (OCSyncLaneSchedulerLaneStatusYield);
+				}
+
+				recordsProcessedInTurn++;
+
 				// Fetch next sync record
-				[self.database retrieveSyncRecordAfterID:lastSyncRecordID onLaneID:lane.identifier completionHandler:^(OCDatabase *db, NSError *dbError, OCSyncRecord *syncRecord) {
+				[self.database retrieveSyncRecordAfterID:cursor.lastSyncRecordID onLaneID:lane.identifier completionHandler:^(OCDatabase *db, NSError *dbError, OCSyncRecord *syncRecord) {
 					OCCoreSyncInstruction nextInstruction;
 
 					if (syncRecord == nil)
@@ -875,7 +1085,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 						return;
 					}
 
-					recordsOnLane++;
+					cursor.recordsOnLane++;
 
 					// Check available action category budget
 					NSArray <OCSyncActionCategory> *actionCategories = syncRecord.action.categories;
@@ -962,19 +1172,19 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 							if (error == nil)
 							{
-								recordsOnLane--;
+								cursor.recordsOnLane--;
 							}
 
 							// Update budget usage
 							UpdateRunningActionCategories(actionCategories, -1);
 
 							// Process next
-							lastSyncRecordID = syncRecord.recordID;
+							cursor.lastSyncRecordID = syncRecord.recordID;
 						break;
 
 						case OCCoreSyncInstructionProcessNext:
 							// Process next
-							lastSyncRecordID = syncRecord.recordID;
+							cursor.lastSyncRecordID = syncRecord.recordID;
 						break;
 					}
 
@@ -986,26 +1196,24 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 				}];
 			};
 
+			cursor.error = error;
+
+			return (OCSyncLaneSchedulerLaneStatusCompleted);
+		} laneCompletionHandler:^BOOL(OCSyncLane *lane, OCSyncLaneCursor *cursor) {
 			OCLogDebug(@"done processing sync records on lane %@", lane);
 
-			if ((recordsOnLane > 0) || (error != nil))
+			if (cursor.skipped)
 			{
-				activeLanes++;
-
-				if ((activeLanes > self.maximumSyncLanes) && (self.maximumSyncLanes != 0))
-				{
-					// Enforce active lane limit
-					break;
-				}
+				return (YES);
 			}
 
-			if (error != nil)
+			if (cursor.error != nil)
 			{
 				// Make sure not to proceed to removing seemingly empty lane on errors
-				continue;
+				return (YES);
 			}
 
-			if (recordsOnLane == 0)
+			if (cursor.recordsOnLane == 0)
 			{
 				__block BOOL laneIsEmpty = NO;
 
@@ -1029,7 +1237,9 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 					}];
 				}
 			}
-		}
+
+			return (YES);
+		}];
 
 		if (activeLaneIDs.count == 0)
 		{
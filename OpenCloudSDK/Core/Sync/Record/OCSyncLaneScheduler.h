@@ -0,0 +1,63 @@
+//
+//  OCSyncLaneScheduler.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCSyncLane.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, OCSyncLaneSchedulerLaneStatus)
+{
+	OCSyncLaneSchedulerLaneStatusYield,	//!< The lane used up its quantum and may have more records to process. The scheduler will return to it after serving the other shards.
+	OCSyncLaneSchedulerLaneStatusCompleted	//!< No more records can be processed on the lane in this pass.
+};
+
+@interface OCSyncLaneCursor : NSObject
+
+@property(strong,nullable) OCSyncRecordID lastSyncRecordID; //!< ID of the last sync record processed on the lane
+@property(assign) NSUInteger recordsOnLane; //!< Number of records found on the lane so far
+@property(strong,nullable) NSError *error; //!< Error that occured processing the lane
+@property(assign) BOOL skipped; //!< YES if the lane was skipped (f.ex. because lanes it depends on are still active)
+
+@end
+
+typedef OCSyncLaneSchedulerLaneStatus(^OCSyncLaneSchedulerLaneProcessor)(OCSyncLane *lane, OCSyncLaneCursor *cursor, NSUInteger quantum); //!< Processes up to quantum records on the lane (0 = no limit), starting after cursor.lastSyncRecordID, and returns the status of the lane.
+typedef BOOL(^OCSyncLaneSchedulerLaneCompletionHandler)(OCSyncLane *lane, OCSyncLaneCursor *cursor); //!< Called once processing of a lane has completed. Return NO to stop scheduling altogether.
+
+@interface OCSyncLaneShard : NSObject
+
+@property(strong,readonly) NSArray<OCSyncLane *> *lanes; //!< Lanes in the shard, ordered by lane ID (and therefore in dependency order)
+@property(strong,readonly) NSSet<OCSyncLaneTag> *tags; //!< Union of the tags of all lanes in the shard
+
+@end
+
+@interface OCSyncLaneScheduler : NSObject
+
+@property(strong,readonly) NSArray<OCSyncLaneShard *> *shards; //!< Shards of lanes that share neither tags nor dependencies with lanes in other shards
+@property(assign) NSUInteger quantum; //!< Maximum number of records processed on a lane before yielding to the next shard. A value of 0 processes each lane to completion before moving on (default: 0).
+@property(assign) NSUInteger maximumActiveLanes; //!< Maximum number of active lanes. A lane is active from its first turn until it completes - and remains so if it completed with records on it or an error. Once the limit is reached, no further lanes are started. A value of 0 equals no limit (default: 0).
+
++ (NSArray<OCSyncLaneShard *> *)shardsForLanes:(NSArray<OCSyncLane *> *)lanes; //!< Partitions the lanes into independent shards. Two lanes end up in the same shard if one depends on the other or their tags overlap.
+
+- (instancetype)initWithLanes:(NSArray<OCSyncLane *> *)lanes;
+
+- (void)runWithLaneProcessor:(OCSyncLaneSchedulerLaneProcessor)laneProcessor laneCompletionHandler:(OCSyncLaneSchedulerLaneCompletionHandler)laneCompletionHandler; //!< Processes the shards round-robin, one quantum per turn. Lanes within a shard are processed strictly in order.
+
+@end
+
+NS_ASSUME_NONNULL_END
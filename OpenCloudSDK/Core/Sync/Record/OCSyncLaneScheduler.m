@@ -0,0 +1,280 @@
+//
+//  OCSyncLaneScheduler.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCSyncLaneScheduler.h"
+
+@interface OCSyncLaneCursor ()
+@property(assign) BOOL started;
+@end
+
+@implementation OCSyncLaneCursor
+@end
+
+@interface OCSyncLaneShard ()
+{
+	NSMutableArray<OCSyncLane *> *_lanes;
+	NSMutableSet<OCSyncLaneTag> *_tags;
+
+	@public
+	NSUInteger _currentLaneIndex;
+	OCSyncLaneCursor *_currentLaneCursor;
+}
+@end
+
+@implementation OCSyncLaneShard
+
+@synthesize lanes = _lanes;
+@synthesize tags = _tags;
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_lanes = [NSMutableArray new];
+		_tags = [NSMutableSet new];
+	}
+
+	return (self);
+}
+
+- (void)addLane:(OCSyncLane *)lane
+{
+	[_lanes addObject:lane];
+
+	if (lane.tags != nil)
+	{
+		[_tags unionSet:lane.tags];
+	}
+}
+
+- (nullable OCSyncLane *)currentLane
+{
+	return ((_currentLaneIndex < _lanes.count) ? _lanes[_currentLaneIndex] : nil);
+}
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, lanes: %@>", NSStringFromClass(self.class), self, [_lanes valueForKeyPath:@"identifier"]]);
+}
+
+@end
+
+@implementation OCSyncLaneScheduler
+
+#pragma mark - Sharding
+static NSUInteger OCSyncLaneShardRoot(NSUInteger *parents, NSUInteger idx)
+{
+	while (parents[idx] != idx)
+	{
+		parents[idx] = parents[parents[idx]]; // path halving
+		idx = parents[idx];
+	}
+
+	return (idx);
+}
+
+static void OCSyncLaneShardUnion(NSUInteger *parents, NSUInteger idx1, NSUInteger idx2)
+{
+	NSUInteger root1 = OCSyncLaneShardRoot(parents, idx1);
+	NSUInteger root2 = OCSyncLaneShardRoot(parents, idx2);
+
+	if (root1 != root2)
+	{
+		// Always keep the lower index as root, so shards are ordered by their first lane
+		if (root1 < root2)
+		{
+			parents[root2] = root1;
+		}
+		else
+		{
+			parents[root1] = root2;
+		}
+	}
+}
+
++ (NSArray<OCSyncLaneShard *> *)shardsForLanes:(NSArray<OCSyncLane *> *)inLanes
+{
+	NSArray<OCSyncLane *> *lanes;
+	NSUInteger laneCount;
+	NSMutableArray<OCSyncLaneShard *> *shards = [NSMutableArray new];
+
+	if ((laneCount = inLanes.count) == 0)
+	{
+		return (shards);
+	}
+
+	// Order lanes by ID - lanes can only depend on lanes that existed before them, so this is also dependency order
+	lanes = [inLanes sortedArrayUsingComparator:^NSComparisonResult(OCSyncLane * _Nonnull lane1, OCSyncLane * _Nonnull lane2) {
+		return ([lane1.identifier compare:lane2.identifier]);
+	}];
+
+	NSUInteger *parents = calloc(laneCount, sizeof(NSUInteger));
+	NSMutableDictionary<OCSyncLaneID, NSNumber *> *indexByLaneID = [NSMutableDictionary new];
+
+	for (NSUInteger idx=0; idx < laneCount; idx++)
+	{
+		OCSyncLane *lane = lanes[idx];
+
+		parents[idx] = idx;
+
+		if (lane.identifier != nil)
+		{
+			indexByLaneID[lane.identifier] = @(idx);
+		}
+	}
+
+	for (NSUInteger idx=0; idx < laneCount; idx++)
+	{
+		OCSyncLane *lane = lanes[idx];
+
+		// Dependencies
+		for (OCSyncLaneID afterLaneID in lane.afterLanes)
+		{
+			NSNumber *afterLaneIndex;
+
+			if ((afterLaneIndex = indexByLaneID[afterLaneID]) != nil)
+			{
+				OCSyncLaneShardUnion(parents, idx, afterLaneIndex.unsignedIntegerValue);
+			}
+		}
+
+		// Overlapping tags
+		for (NSUInteger otherIdx=idx+1; otherIdx < laneCount; otherIdx++)
+		{
+			if (OCSyncLaneShardRoot(parents, idx) == OCSyncLaneShardRoot(parents, otherIdx))
+			{
+				// Already in the same shard
+				continue;
+			}
+
+			if ([lanes[otherIdx] coversTags:lane.tags prefixMatches:NULL identicalTags:NULL])
+			{
+				OCSyncLaneShardUnion(parents, idx, otherIdx);
+			}
+		}
+	}
+
+	// Build shards
+	NSMutableDictionary<NSNumber *, OCSyncLaneShard *> *shardsByRoot = [NSMutableDictionary new];
+
+	for (NSUInteger idx=0; idx < laneCount; idx++)
+	{
+		NSNumber *root = @(OCSyncLaneShardRoot(parents, idx));
+		OCSyncLaneShard *shard;
+
+		if ((shard = shardsByRoot[root]) == nil)
+		{
+			shard = [OCSyncLaneShard new];
+			shardsByRoot[root] = shard;
+
+			[shards addObject:shard];
+		}
+
+		[shard addLane:lanes[idx]];
+	}
+
+	free(parents);
+
+	return (shards);
+}
+
+#pragma mark - Init
+- (instancetype)initWithLanes:(NSArray<OCSyncLane *> *)lanes
+{
+	if ((self = [super init]) != nil)
+	{
+		_shards = [OCSyncLaneScheduler shardsForLanes:lanes];
+	}
+
+	return (self);
+}
+
+#pragma mark - Scheduling
+- (void)runWithLaneProcessor:(OCSyncLaneSchedulerLaneProcessor)laneProcessor laneCompletionHandler:(OCSyncLaneSchedulerLaneCompletionHandler)laneCompletionHandler
+{
+	NSMutableArray<OCSyncLaneShard *> *pendingShards = [_shards mutableCopy];
+	NSUInteger quantum = _quantum;
+	NSUInteger maximumActiveLanes = _maximumActiveLanes, activeLaneCount = 0;
+
+	for (OCSyncLaneShard *shard in pendingShards)
+	{
+		shard->_currentLaneIndex = 0;
+		shard->_currentLaneCursor = [OCSyncLaneCursor new];
+	}
+
+	while (pendingShards.count > 0)
+	{
+		NSMutableArray<OCSyncLaneShard *> *completedShards = nil;
+
+		for (OCSyncLaneShard *shard in pendingShards)
+		{
+			OCSyncLane *lane;
+
+			if ((lane = shard.currentLane) != nil)
+			{
+				OCSyncLaneCursor *cursor = shard->_currentLaneCursor;
+
+				if (!cursor.started)
+				{
+					if ((maximumActiveLanes > 0) && (activeLaneCount >= maximumActiveLanes))
+					{
+						// Active lane limit reached: don't start any more lanes of this shard in this pass
+						shard->_currentLaneIndex = shard.lanes.count;
+						lane = nil;
+					}
+					else
+					{
+						cursor.started = YES;
+						activeLaneCount++;
+					}
+				}
+
+				if ((lane != nil) && (laneProcessor(lane, cursor, quantum) == OCSyncLaneSchedulerLaneStatusCompleted))
+				{
+					if (cursor.skipped || ((cursor.recordsOnLane == 0) && (cursor.error == nil)))
+					{
+						// Lane didn't become active
+						activeLaneCount--;
+					}
+
+					shard->_currentLaneIndex++;
+					shard->_currentLaneCursor = [OCSyncLaneCursor new];
+
+					if (!laneCompletionHandler(lane, cursor))
+					{
+						// Stop scheduling altogether
+						return;
+					}
+				}
+			}
+
+			if (shard.currentLane == nil)
+			{
+				if (completedShards == nil) { completedShards = [NSMutableArray new]; }
+				[completedShards addObject:shard];
+			}
+		}
+
+		if (completedShards != nil)
+		{
+			[pendingShards removeObjectsInArray:completedShards];
+		}
+	}
+}
+
+@end
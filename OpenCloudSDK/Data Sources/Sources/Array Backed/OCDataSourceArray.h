@@ -35,6 +35,8 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)setItems:(nullable NSArray<id<OCDataItem>> *)items updated:(nullable NSSet<id<OCDataItem>> *)updatedItems; //!< Uses item IDs to populate the data source
 - (void)setVersionedItems:(nullable NSArray<id<OCDataItem,OCDataItemVersioning>> *)items; //!< Uses item versions and item IDs to populate the data source
 
+- (BOOL)applyChangeSet:(OCDataSourceChangeSet *)changeSet items:(nullable NSArray<id<OCDataItem>> *)changedItems; //!< Incrementally applies changeSet. changedItems must contain the items for all inserted and updated item references.
+
 @end
 
 NS_ASSUME_NONNULL_END
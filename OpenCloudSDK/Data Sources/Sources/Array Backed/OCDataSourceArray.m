@@ -115,6 +115,46 @@
 	[self setItems:items updated:updatedItems];
 }
 
+- (BOOL)applyChangeSet:(OCDataSourceChangeSet *)changeSet items:(nullable NSArray<id<OCDataItem>> *)changedItems
+{
+	@synchronized(_subscriptions)
+	{
+		if (![changeSet isApplicableToNumberOfItems:_itemReferences.count])
+		{
+			OCLogError(@"Change set %@ not applicable to data source %@ with %lu items", changeSet, self, (unsigned long)_itemReferences.count);
+			return (NO);
+		}
+
+		if (_itemsByReference == nil)
+		{
+			_itemsByReference = [NSMapTable strongToStrongObjectsMapTable];
+		}
+
+		for (OCDataItemReference itemRef in changeSet.deletedItemRefs)
+		{
+			[_itemsByReference removeObjectForKey:itemRef];
+			[_versionsByReference removeObjectForKey:itemRef];
+		}
+
+		for (id<OCDataItem> item in changedItems)
+		{
+			OCDataItemReference itemRef;
+
+			if ((itemRef = item.dataItemReference) != nil)
+			{
+				[_itemsByReference setObject:item forKey:itemRef];
+
+				if (_trackItemVersions && [item conformsToProtocol:@protocol(OCDataItemVersioning)])
+				{
+					[_versionsByReference setObject:((id<OCDataItemVersioning>)item).dataItemVersion forKey:itemRef];
+				}
+			}
+		}
+
+		return ([self applyChangeSet:changeSet]);
+	}
+}
+
 - (void)setTrackItemVersions:(BOOL)trackItemVersions
 {
 	if (_trackItemVersions && !trackItemVersions) {
@@ -43,6 +43,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property(copy,nullable,nonatomic) OCDataSourceItemFilter filter; //!< Filter to apply to the combined item set
 @property(copy,nullable,nonatomic) OCDataSourceItemComparator sortComparator; //!< Sort comparator to apply to the combined item set
 
+@property(assign) BOOL allowsConcurrentProcessing; //!< If YES, filters and sort comparators are invoked concurrently for large item sets and must therefore be thread-safe. Defaults to NO.
+
 #pragma mark - Filtering and sorting (individual sources)
 - (void)setInclude:(BOOL)include forSource:(OCDataSource *)source; //!< Include or exclude items from an individual source
 - (void)setFilter:(nullable OCDataSourceItemFilter)filter forSource:(OCDataSource *)source; //!< Filter to apply to an individual source
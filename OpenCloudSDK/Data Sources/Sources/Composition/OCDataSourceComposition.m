@@ -20,6 +20,13 @@
 #import "NSArray+OCFiltering.h"
 #import "OCMacros.h"
 
+static const NSUInteger OCDataSourceCompositionConcurrentProcessingThreshold = 2000; //!< Minimum number of items for filtering and sorting to be performed concurrently
+
+typedef struct
+{
+	__unsafe_unretained OCDataItemReference itemRef;
+} OCDataSourceCompositionMergeEntry;
+
 #pragma mark - Record definition
 @interface OCDataSourceCompositionRecord : NSObject
 
@@ -30,6 +37,7 @@
 @property(strong,readonly) OCDataSource *source;
 @property(strong,nullable) OCDataSourceSubscription *subscription;
 @property(strong,nullable) OCDataSourceSnapshot *activeSnapshot;
+@property(strong,nullable) NSArray<OCDataSourceChangeSet *> *pendingChangeSets; //!< Change sets of the activeSnapshot, not yet applied to the composition
 
 @property(copy,nullable) OCDataSourceItemFilter filter;
 @property(copy,nullable) OCDataSourceItemComparator sortComparator;
@@ -38,6 +46,9 @@
 
 @property(assign) BOOL hasUpdates;
 
+@property(strong,nullable) NSArray<OCDataItemReference> *composedItemReferences; //!< Items of the activeSnapshot after filtering and source-specific sorting (only used during composition)
+@property(strong,nullable) NSSet<OCDataItemReference> *excludedItemReferences; //!< Items of the activeSnapshot removed by filtering (only used during composition)
+
 - (instancetype)initWithSource:(OCDataSource *)source composition:(OCDataSourceComposition *)composition;
 
 @end
@@ -52,6 +63,7 @@
 	dispatch_queue_t _compositionQueue;
 
 	BOOL _compositionNeedsUpdate;
+	BOOL _compositionNeedsFullUpdate; //!< YES if sources, filters or sort comparators changed and the composition needs to be recomposed in full
 
 	BOOL _supressNeedsCompositionUpdates;
 }
@@ -59,16 +71,41 @@
 
 @implementation OCDataSourceComposition
 
-+ (dispatch_queue_t)sharedCompositionQueue
++ (NSUInteger)maximumConcurrentCompositionUpdates
 {
-	static dispatch_once_t onceToken;
-	static dispatch_queue_t sharedCompositionQueue;
+	return (MAX(1, MIN(NSProcessInfo.processInfo.activeProcessorCount, 4)));
+}
 
++ (dispatch_queue_t)targetQueueForNewComposition
+{
+	static dispatch_once_t onceToken;
+	static NSArray<dispatch_queue_t> *poolQueues;
+	static NSUInteger nextPoolQueueIndex;
+	dispatch_queue_t targetQueue;
+
+	/*
+		Every composition has its own serial queue, which targets one of a fixed number of serial pool queues. This
+		bounds the number of composition updates performed concurrently (and the number of threads used for it),
+		while a big composition only holds up the compositions sharing its pool queue - rather than all of them.
+	*/
 	dispatch_once(&onceToken, ^{
-		sharedCompositionQueue = dispatch_queue_create("DataSourceComposition queue", DISPATCH_QUEUE_SERIAL_WITH_AUTORELEASE_POOL);
+		NSMutableArray<dispatch_queue_t> *queues = [NSMutableArray new];
+
+		for (NSUInteger i=0; i<self.maximumConcurrentCompositionUpdates; i++)
+		{
+			[queues addObject:dispatch_queue_create("DataSourceComposition pool queue", DISPATCH_QUEUE_SERIAL_WITH_AUTORELEASE_POOL)];
+		}
+
+		poolQueues = queues;
 	});
 
-	return (sharedCompositionQueue);
+	@synchronized(poolQueues)
+	{
+		targetQueue = poolQueues[nextPoolQueueIndex % poolQueues.count];
+		nextPoolQueueIndex++;
+	}
+
+	return (targetQueue);
 }
 
 - (instancetype)initWithSources:(NSArray<OCDataSource *> *)sources applyCustomizations:(nullable void (^)(OCDataSourceComposition * _Nonnull))customizationApplicator
@@ -77,7 +114,8 @@
 	{
 		_sourceRecords = [NSMutableArray new];
 
-		_compositionQueue = OCDataSourceComposition.sharedCompositionQueue;
+		_compositionQueue = dispatch_queue_create_with_target("DataSourceComposition queue", DISPATCH_QUEUE_SERIAL_WITH_AUTORELEASE_POOL, OCDataSourceComposition.targetQueueForNewComposition);
+		_compositionNeedsFullUpdate = YES;
 
 		if (customizationApplicator != nil)
 		{
@@ -320,6 +358,16 @@
 }
 
 - (void)setNeedsCompositionUpdate
+{
+	[self _setNeedsCompositionUpdateInFull:YES];
+}
+
+- (void)setNeedsCompositionUpdateForSourceChanges
+{
+	[self _setNeedsCompositionUpdateInFull:NO];
+}
+
+- (void)_setNeedsCompositionUpdateInFull:(BOOL)inFull
 {
 	if (_supressNeedsCompositionUpdates)
 	{
@@ -329,6 +377,11 @@
 	@synchronized(self)
 	{
 		_compositionNeedsUpdate = YES;
+
+		if (inFull)
+		{
+			_compositionNeedsFullUpdate = YES;
+		}
 	}
 
 	__weak OCDataSourceComposition *weakSelf = self;
@@ -375,28 +428,31 @@
 	NSMutableSet<OCDataItemReference> *updatedItemReferences = [NSMutableSet new];
 	NSArray<OCDataSourceCompositionRecord *> *sourceRecords;
 	NSMapTable<OCDataItemReference, OCDataSourceCompositionRecord *> *compositionRecordByItemReference = nil;
+	OCDataSourceItemFilter filter;
+	OCDataSourceItemComparator sortComparator;
+	BOOL canUpdateIncrementally;
 
 	@synchronized(_sourceRecords)
 	{
 		sourceRecords = [_sourceRecords copy];
 	}
 
-	if (_sortComparator != nil)
+	@synchronized(self)
 	{
-		compositionRecordByItemReference = [NSMapTable strongToWeakObjectsMapTable];
+		filter = _filter;
+		sortComparator = _sortComparator;
+
+		canUpdateIncrementally = !_compositionNeedsFullUpdate && (filter == nil) && (sortComparator == nil);
+		_compositionNeedsFullUpdate = NO;
 	}
 
+	// Fetch updates where available
 	for (OCDataSourceCompositionRecord *record in sourceRecords)
 	{
-		NSRange itemRange = NSMakeRange(composedItemReferences.count, 0);
-
-		// Skip records that shouldn't be included
 		if (!record.include) {
-			record.itemRange = NSMakeRange(NSUIntegerMax, 0);
 			continue;
 		}
 
-		// Fetch updates where available
 		if (record.hasUpdates)
 		{
 			@synchronized(record)
@@ -406,97 +462,393 @@
 					OCDataSourceSnapshot *snapshot = [record.subscription snapshotResettingChangeTracking:YES];
 
 					record.activeSnapshot = snapshot;
+					record.pendingChangeSets = snapshot.changeSets;
 					record.hasUpdates = NO;
 
 					[updatedItemReferences unionSet:snapshot.updatedItems];
+
+					if ((snapshot.changeSets == nil) || (record.filter != nil) || (record.sortComparator != nil) || (record.itemRange.location == NSUIntegerMax))
+					{
+						canUpdateIncrementally = NO;
+					}
 				}
 			}
 		}
+	}
 
-		// Add to composed array
-		NSArray<OCDataItemReference> *snapshotItems;
+	// Apply changes incrementally where possible
+	if (canUpdateIncrementally && [self _applyPendingChangeSetsOfSourceRecords:sourceRecords])
+	{
+		return;
+	}
+
+	// Filter and sort the items of the individual sources - concurrently, if there are enough items to make it worthwhile
+	NSUInteger totalItemCount = 0;
 
-		if ((snapshotItems = record.activeSnapshot.items) != nil)
+	for (OCDataSourceCompositionRecord *record in sourceRecords)
+	{
+		if (record.include)
 		{
-			if (record.filter != nil)
-			{
-				// Apply source-specific filter
-				snapshotItems = [snapshotItems filteredArrayUsingBlock:^BOOL(OCDataItemReference  _Nonnull itemRef, BOOL * _Nonnull stop) {
-					if (record.filter(record.source, itemRef))
-					{
-						return (YES);
-					}
+			totalItemCount += record.activeSnapshot.items.count;
+		}
+	}
 
-					[updatedItemReferences removeObject:itemRef];
+	BOOL processConcurrently = _allowsConcurrentProcessing && (totalItemCount >= OCDataSourceCompositionConcurrentProcessingThreshold);
 
-					return (NO);
-				}];
-			}
+	if (processConcurrently && (sourceRecords.count > 1))
+	{
+		dispatch_apply(sourceRecords.count, DISPATCH_APPLY_AUTO, ^(size_t recordIndex) {
+			[self _processItemsOfSourceRecord:sourceRecords[recordIndex] filter:filter concurrently:processConcurrently];
+		});
+	}
+	else
+	{
+		for (OCDataSourceCompositionRecord *record in sourceRecords)
+		{
+			[self _processItemsOfSourceRecord:record filter:filter concurrently:processConcurrently];
+		}
+	}
+
+	// Merge results in the order of the sources
+	if (sortComparator != nil)
+	{
+		compositionRecordByItemReference = [NSMapTable strongToWeakObjectsMapTable];
+	}
+
+	for (OCDataSourceCompositionRecord *record in sourceRecords)
+	{
+		NSRange itemRange = NSMakeRange(composedItemReferences.count, 0);
+		NSArray<OCDataItemReference> *recordItemReferences;
 
-			if (record.sortComparator != nil)
+		record.pendingChangeSets = nil;
+
+		// Skip records that shouldn't be included
+		if (!record.include) {
+			record.itemRange = NSMakeRange(NSUIntegerMax, 0);
+			continue;
+		}
+
+		// Add to composed array
+		if ((recordItemReferences = record.composedItemReferences) != nil)
+		{
+			// Remove updates for items that are not in the composed set of items
+			if (record.excludedItemReferences != nil)
 			{
-				// Apply source-specific sorting
-				snapshotItems = [snapshotItems sortedArrayUsingComparator:^NSComparisonResult(OCDataItemReference itemRef1, OCDataItemReference itemRef2) {
-					return (record.sortComparator(record.source, itemRef1, record.source, itemRef2));
-				}];
+				[updatedItemReferences minusSet:record.excludedItemReferences];
 			}
 
-			if ((_sortComparator != nil) || (_filter != nil))
+			[composedItemReferences addObjectsFromArray:recordItemReferences];
+
+			if (sortComparator != nil)
 			{
-				for (OCDataItemReference itemRef in snapshotItems)
+				for (OCDataItemReference itemRef in recordItemReferences)
 				{
-					BOOL includeItem = YES;
+					[compositionRecordByItemReference setObject:record forKey:itemRef];
+				}
+			}
 
-					if (_filter != nil)
-					{
-						includeItem = _filter(record.source, itemRef);
-
-						if (includeItem)
-						{
-							// Only add items passing the filter
-							[composedItemReferences addObject:itemRef];
-						}
-						else
-						{
-							// Remove updates for items that are not in the composed set of items
-							[updatedItemReferences removeObject:itemRef];
-						}
-					}
+			itemRange.length = composedItemReferences.count - itemRange.location;
+		}
 
-					if ((_sortComparator != nil) && includeItem)
-					{
-						[compositionRecordByItemReference setObject:record forKey:itemRef];
-					}
+		record.itemRange = itemRange;
+
+		record.composedItemReferences = nil;
+		record.excludedItemReferences = nil;
+	}
+
+	// Sort items
+	if (sortComparator != nil)
+	{
+		// Make items available for lookup by reference, so the sort comparator - which is passed the composition - can retrieve their records
+		@synchronized(_subscriptions)
+		{
+			_compositionRecordByItemReference = compositionRecordByItemReference;
+		}
+
+		composedItemReferences = [self _sortItemReferences:composedItemReferences ofSourceRecords:sourceRecords sortComparator:sortComparator concurrently:processConcurrently];
+	}
+
+	// Propagate updates
+	@synchronized(_subscriptions)
+	{
+		// Make items available for lookup by reference
+		_compositionRecordByItemReference = compositionRecordByItemReference;
+
+		// Update data source
+		[self setItemReferences:composedItemReferences updated:updatedItemReferences];
+	}
+}
+
+- (void)_processItemsOfSourceRecord:(OCDataSourceCompositionRecord *)record filter:(nullable OCDataSourceItemFilter)filter concurrently:(BOOL)concurrently
+{
+	NSArray<OCDataItemReference> *itemReferences = record.activeSnapshot.items;
+	__block NSMutableSet<OCDataItemReference> *excludedItemReferences = nil;
+	OCDataSource *source = record.source;
+	OCDataSourceItemFilter recordFilter = record.filter;
+	OCDataSourceItemComparator recordSortComparator = record.sortComparator;
+	BOOL processItemsConcurrently = concurrently && (itemReferences.count >= OCDataSourceCompositionConcurrentProcessingThreshold);
+	NSSortOptions sortOptions = NSSortStable | (processItemsConcurrently ? NSSortConcurrent : 0);
+
+	if (!record.include || (itemReferences == nil))
+	{
+		record.composedItemReferences = nil;
+		record.excludedItemReferences = nil;
+		return;
+	}
+
+	NSArray<OCDataItemReference> *(^FilterItemReferences)(NSArray<OCDataItemReference> *itemRefs, OCDataSourceItemFilter itemFilter) = ^(NSArray<OCDataItemReference> *itemRefs, OCDataSourceItemFilter itemFilter) {
+		NSIndexSet *passingIndexes = [itemRefs indexesOfObjectsWithOptions:(processItemsConcurrently ? NSEnumerationConcurrent : 0) passingTest:^BOOL(OCDataItemReference itemRef, NSUInteger idx, BOOL * _Nonnull stop) {
+			return (itemFilter(source, itemRef));
+		}];
+
+		if (passingIndexes.count == itemRefs.count)
+		{
+			return (itemRefs);
+		}
+
+		NSMutableIndexSet *failingIndexes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, itemRefs.count)];
+		[failingIndexes removeIndexes:passingIndexes];
+
+		if (excludedItemReferences == nil)
+		{
+			excludedItemReferences = [NSMutableSet new];
+		}
+
+		[excludedItemReferences addObjectsFromArray:[itemRefs objectsAtIndexes:failingIndexes]];
+
+		return ([itemRefs objectsAtIndexes:passingIndexes]);
+	};
+
+	// Apply source-specific filter
+	if (recordFilter != nil)
+	{
+		itemReferences = FilterItemReferences(itemReferences, recordFilter);
+	}
+
+	// Apply source-specific sorting
+	if (recordSortComparator != nil)
+	{
+		itemReferences = [itemReferences sortedArrayWithOptions:sortOptions usingComparator:^NSComparisonResult(OCDataItemReference itemRef1, OCDataItemReference itemRef2) {
+			return (recordSortComparator(source, itemRef1, source, itemRef2));
+		}];
+	}
+
+	// Apply composition filter
+	if (filter != nil)
+	{
+		itemReferences = FilterItemReferences(itemReferences, filter);
+	}
+
+	record.composedItemReferences = itemReferences;
+	record.excludedItemReferences = excludedItemReferences;
+}
+
+- (NSMutableArray<OCDataItemReference> *)_sortItemReferences:(NSMutableArray<OCDataItemReference> *)itemReferences ofSourceRecords:(NSArray<OCDataSourceCompositionRecord *> *)sourceRecords sortComparator:(OCDataSourceItemComparator)sortComparator concurrently:(BOOL)concurrently
+{
+	/*
+		itemReferences consists of one run per source record (as described by the record's itemRange). The runs are
+		sorted individually first and then merged pairwise, level by level, until only one run is left. Merges are
+		stable and prefer the earlier run in case of equality, so that the result is deterministic and equal to a
+		stable sort of itemReferences.
+	*/
+	NSUInteger itemCount = itemReferences.count;
+	NSMutableArray<NSValue *> *runs = [NSMutableArray new];
+	NSMutableArray<NSArray<OCDataItemReference> *> *sortedRuns = [NSMutableArray new];
+	OCDataSourceCompositionMergeEntry *entries, *mergedEntries;
+	NSMutableArray<OCDataItemReference> *mergedItemReferences;
+	NSComparator comparator = ^NSComparisonResult(OCDataItemReference itemRef1, OCDataItemReference itemRef2) {
+		return (sortComparator(self, itemRef1, self, itemRef2));
+	};
+
+	if (itemCount < 2)
+	{
+		return (itemReferences);
+	}
+
+	if (((entries = calloc(itemCount, sizeof(OCDataSourceCompositionMergeEntry))) == NULL) ||
+	    ((mergedEntries = calloc(itemCount, sizeof(OCDataSourceCompositionMergeEntry))) == NULL))
+	{
+		free(entries);
+		return ([[itemReferences sortedArrayWithOptions:NSSortStable usingComparator:comparator] mutableCopy]);
+	}
+
+	for (OCDataSourceCompositionRecord *record in sourceRecords)
+	{
+		NSRange itemRange = record.itemRange;
+
+		if ((itemRange.location == NSUIntegerMax) || (itemRange.length == 0))
+		{
+			continue;
+		}
+
+		[runs addObject:[NSValue valueWithRange:itemRange]];
+		[sortedRuns addObject:[itemReferences subarrayWithRange:itemRange]];
+	}
+
+	// Sort runs
+	void (^SortRun)(NSUInteger runIndex) = ^(NSUInteger runIndex) {
+		NSArray<OCDataItemReference> *run;
+
+		@synchronized(sortedRuns)
+		{
+			run = sortedRuns[runIndex];
+		}
+
+		run = [run sortedArrayWithOptions:(NSSortStable | ((concurrently && (run.count >= OCDataSourceCompositionConcurrentProcessingThreshold)) ? NSSortConcurrent : 0)) usingComparator:comparator];
+
+		@synchronized(sortedRuns)
+		{
+			sortedRuns[runIndex] = run;
+		}
+	};
+
+	if (concurrently && (runs.count > 1))
+	{
+		dispatch_apply(runs.count, DISPATCH_APPLY_AUTO, ^(size_t runIndex) {
+			SortRun(runIndex);
+		});
+	}
+	else
+	{
+		for (NSUInteger runIndex=0; runIndex<runs.count; runIndex++)
+		{
+			SortRun(runIndex);
+		}
+	}
+
+	for (NSUInteger runIndex=0; runIndex<runs.count; runIndex++)
+	{
+		NSUInteger idx = runs[runIndex].rangeValue.location;
+
+		for (OCDataItemReference itemRef in sortedRuns[runIndex])
+		{
+			entries[idx++].itemRef = itemRef;
+		}
+	}
+
+	while (runs.count > 1)
+	{
+		NSUInteger pairCount = (runs.count + 1) / 2;
+		NSMutableArray<NSValue *> *mergedRuns = [NSMutableArray new];
+		OCDataSourceCompositionMergeEntry *sourceEntries = entries, *targetEntries = mergedEntries;
+
+		void (^MergePair)(NSUInteger pairIndex) = ^(NSUInteger pairIndex) {
+			NSRange leftRun = runs[pairIndex * 2].rangeValue;
+			NSRange rightRun = ((pairIndex * 2 + 1) < runs.count) ? runs[pairIndex * 2 + 1].rangeValue : NSMakeRange(NSMaxRange(leftRun), 0);
+			NSUInteger left = leftRun.location, leftEnd = NSMaxRange(leftRun);
+			NSUInteger right = rightRun.location, rightEnd = NSMaxRange(rightRun);
+			NSUInteger target = leftRun.location;
+
+			while ((left < leftEnd) && (right < rightEnd))
+			{
+				if (sortComparator(self, sourceEntries[left].itemRef, self, sourceEntries[right].itemRef) != NSOrderedDescending)
+				{
+					targetEntries[target++] = sourceEntries[left++];
+				}
+				else
+				{
+					targetEntries[target++] = sourceEntries[right++];
 				}
 			}
 
-			if (_filter == nil)
+			while (left < leftEnd)
 			{
-				[composedItemReferences addObjectsFromArray:snapshotItems];
+				targetEntries[target++] = sourceEntries[left++];
 			}
 
-			itemRange.length = composedItemReferences.count - itemRange.location;
+			while (right < rightEnd)
+			{
+				targetEntries[target++] = sourceEntries[right++];
+			}
+		};
+
+		if (concurrently && (pairCount > 1))
+		{
+			dispatch_apply(pairCount, DISPATCH_APPLY_AUTO, ^(size_t pairIndex) {
+				MergePair(pairIndex);
+			});
+		}
+		else
+		{
+			for (NSUInteger pairIndex=0; pairIndex<pairCount; pairIndex++)
+			{
+				MergePair(pairIndex);
+			}
 		}
 
-		record.itemRange = itemRange;
+		for (NSUInteger pairIndex=0; pairIndex<pairCount; pairIndex++)
+		{
+			NSRange leftRun = runs[pairIndex * 2].rangeValue;
+			NSUInteger end = ((pairIndex * 2 + 1) < runs.count) ? NSMaxRange(runs[pairIndex * 2 + 1].rangeValue) : NSMaxRange(leftRun);
+
+			[mergedRuns addObject:[NSValue valueWithRange:NSMakeRange(leftRun.location, end - leftRun.location)]];
+		}
+
+		runs = mergedRuns;
+
+		// Swap buffers
+		mergedEntries = entries;
+		entries = targetEntries;
 	}
 
-	// Propagate updates
+	mergedItemReferences = [[NSMutableArray alloc] initWithCapacity:itemCount];
+
+	for (NSUInteger idx=0; idx<itemCount; idx++)
+	{
+		[mergedItemReferences addObject:entries[idx].itemRef];
+	}
+
+	free(entries);
+	free(mergedEntries);
+
+	return (mergedItemReferences);
+}
+
+- (BOOL)_applyPendingChangeSetsOfSourceRecords:(NSArray<OCDataSourceCompositionRecord *> *)sourceRecords
+{
+	/*
+		Without composition-wide filtering and sorting, every source occupies a contiguous range of the composed
+		item references - in the order of the sources. The change sets of a source can therefore be applied to the
+		composition by offsetting their indexes by the location of the source's range - and only the ranges of the
+		sources that follow need to be adjusted.
+	*/
 	@synchronized(_subscriptions)
 	{
-		// Make items available for sorting by reference
-		_compositionRecordByItemReference = compositionRecordByItemReference;
+		NSUInteger location = 0;
+		BOOL success = YES;
 
-		// Sort items
-		if (_sortComparator != nil)
+		for (OCDataSourceCompositionRecord *record in sourceRecords)
 		{
-			[composedItemReferences sortUsingComparator:^NSComparisonResult(OCDataItemReference reference1, OCDataItemReference reference2) {
-				return (_sortComparator(self, reference1, self, reference2));
-			}];
+			NSRange itemRange = record.itemRange;
+
+			if (!record.include)
+			{
+				continue;
+			}
+
+			itemRange.location = location;
+
+			if (success)
+			{
+				for (OCDataSourceChangeSet *changeSet in record.pendingChangeSets)
+				{
+					if (![self applyChangeSet:[changeSet changeSetByOffsettingIndexesBy:location]])
+					{
+						success = NO;
+						break;
+					}
+
+					itemRange.length = (NSUInteger)((NSInteger)itemRange.length + changeSet.numberOfItemsDelta);
+				}
+			}
+
+			record.pendingChangeSets = nil;
+			record.itemRange = itemRange;
+
+			location += itemRange.length;
 		}
 
-		// Update data source
-		[self setItemReferences:composedItemReferences updated:updatedItemReferences];
+		return (success);
 	}
 }
 
@@ -598,7 +950,7 @@
 	@synchronized(self)
 	{
 		_hasUpdates = YES;
-		[_composition setNeedsCompositionUpdate];
+		[_composition setNeedsCompositionUpdateForSourceChanges];
 	}
 }
 
@@ -0,0 +1,48 @@
+//
+//  OCDataSourceDatabaseWindow.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCDataSource.h"
+#import "OCDatabase.h"
+#import "OCItem.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCDataSourceDatabaseWindow : OCDataSource
+
+@property(weak,nullable,readonly) OCDatabase *database;
+
+@property(strong,nullable,readonly) OCLocation *location; //!< Location whose children are provided by the data source
+@property(strong,nullable,readonly) OCQueryCondition *queryCondition; //!< Condition that items provided by the data source have to meet
+
+@property(strong,nullable,readonly) OCItemPropertyName sortPropertyName; //!< Property by which the items are sorted. Must be supported by an index, see +[OCDatabase supportsSortingByPropertyName:]
+@property(assign,readonly) BOOL sortAscending;
+
+@property(assign,nonatomic) NSUInteger prefetchMargin; //!< Number of items before and after the window that are materialized alongside it (default: 50)
+
+@property(readonly,nonatomic) NSRange window; //!< The range of item indexes currently requested by the consumer
+@property(readonly,nonatomic) NSUInteger numberOfMaterializedItems; //!< The number of OCItems currently held in memory
+
+- (nullable instancetype)initWithDatabase:(OCDatabase *)database location:(nullable OCLocation *)location queryCondition:(nullable OCQueryCondition *)queryCondition sortedBy:(nullable OCItemPropertyName)sortPropertyName ascending:(BOOL)ascending; //!< Creates a data source for the children of location and/or items matching queryCondition, sorted by an indexed property. Returns nil if neither location nor queryCondition are provided or sortPropertyName is not supported by an index.
+
+- (void)reloadWithCompletionHandler:(nullable void(^)(NSError * _Nullable error))completionHandler; //!< Retrieves the (sorted) database IDs of all matching items and updates the item references. Materialized items that have changed in the database are evicted and reported as updated. Call this initially and whenever the database contents may have changed.
+
+- (void)setWindow:(NSRange)window completionHandler:(nullable void(^)(NSError * _Nullable error))completionHandler; //!< Requests the items in window (plus prefetch margins) to be materialized and evicts all items outside of it. The completionHandler is called once all items in window have been materialized.
+
+@end
+
+NS_ASSUME_NONNULL_END
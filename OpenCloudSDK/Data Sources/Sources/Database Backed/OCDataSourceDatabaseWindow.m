@@ -0,0 +1,355 @@
+//
+//  OCDataSourceDatabaseWindow.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCDataSourceDatabaseWindow.h"
+#import "OCItem+OCDataItem.h"
+#import "NSError+OCError.h"
+#import "OCLogger.h"
+
+@interface OCDataSourceDatabaseWindow ()
+{
+	NSMutableDictionary<OCDatabaseID, OCItem *> *_materializedItemsByID;
+
+	NSRange _window;
+	NSRange _materializedRange;
+}
+@end
+
+@implementation OCDataSourceDatabaseWindow
+
+- (nullable instancetype)initWithDatabase:(OCDatabase *)database location:(nullable OCLocation *)location queryCondition:(nullable OCQueryCondition *)queryCondition sortedBy:(nullable OCItemPropertyName)sortPropertyName ascending:(BOOL)ascending
+{
+	if ((location == nil) && (queryCondition == nil))
+	{
+		OCLogError(@"Windowed data source needs a location and/or query condition");
+		return (nil);
+	}
+
+	if ((sortPropertyName != nil) && ![OCDatabase supportsSortingByPropertyName:sortPropertyName])
+	{
+		OCLogError(@"Windowed data source can't be sorted by %@, which is not backed by an index", sortPropertyName);
+		return (nil);
+	}
+
+	if ((self = [super init]) != nil)
+	{
+		_database = database;
+
+		_location = location;
+		_queryCondition = queryCondition;
+
+		_sortPropertyName = sortPropertyName;
+		_sortAscending = ascending;
+
+		_prefetchMargin = 50;
+
+		_materializedItemsByID = [NSMutableDictionary new];
+		_materializedRange = NSMakeRange(0, 0);
+
+		self.state = OCDataSourceStateLoading;
+	}
+
+	return (self);
+}
+
+#pragma mark - Window
+- (NSRange)window
+{
+	@synchronized(_subscriptions)
+	{
+		return (_window);
+	}
+}
+
+- (NSUInteger)numberOfMaterializedItems
+{
+	@synchronized(_subscriptions)
+	{
+		return (_materializedItemsByID.count);
+	}
+}
+
+- (NSRange)_materializedRangeForWindow:(NSRange)window
+{
+	// Requires lock on _subscriptions
+	NSUInteger numberOfItems = _itemReferences.count;
+	NSUInteger start = (window.location > _prefetchMargin) ? (window.location - _prefetchMargin) : 0;
+	NSUInteger end = MIN(NSMaxRange(window) + _prefetchMargin, numberOfItems);
+
+	if (start >= end)
+	{
+		return (NSMakeRange(0, 0));
+	}
+
+	return (NSMakeRange(start, end - start));
+}
+
+- (NSSet<OCDatabaseID> *)_materializedRangeIDs
+{
+	// Requires lock on _subscriptions
+	return ([NSSet setWithArray:[_itemReferences subarrayWithRange:_materializedRange]]);
+}
+
+- (void)setWindow:(NSRange)window completionHandler:(nullable void(^)(NSError * _Nullable error))completionHandler
+{
+	NSMutableArray<OCDatabaseID> *missingIDs = [NSMutableArray new];
+
+	@synchronized(_subscriptions)
+	{
+		NSSet<OCDatabaseID> *materializedRangeIDs;
+
+		_window = window;
+		_materializedRange = [self _materializedRangeForWindow:window];
+
+		materializedRangeIDs = [self _materializedRangeIDs];
+
+		// Evict items outside of the window and its prefetch margins
+		for (OCDatabaseID databaseID in _materializedItemsByID.allKeys)
+		{
+			if (![materializedRangeIDs containsObject:databaseID])
+			{
+				[_materializedItemsByID removeObjectForKey:databaseID];
+			}
+		}
+
+		// Determine items that still need to be retrieved
+		for (OCDatabaseID databaseID in [_itemReferences subarrayWithRange:_materializedRange])
+		{
+			if (_materializedItemsByID[databaseID] == nil)
+			{
+				[missingIDs addObject:databaseID];
+			}
+		}
+	}
+
+	if (missingIDs.count == 0)
+	{
+		if (completionHandler != nil)
+		{
+			completionHandler(nil);
+		}
+		return;
+	}
+
+	[self _materializeItemsWithIDs:missingIDs completionHandler:^(NSError * _Nullable error, NSArray<OCItem *> * _Nullable items) {
+		if (completionHandler != nil)
+		{
+			completionHandler(error);
+		}
+	}];
+}
+
+- (void)_materializeItemsWithIDs:(NSArray<OCDatabaseID> *)databaseIDs completionHandler:(void(^)(NSError * _Nullable error, NSArray<OCItem *> * _Nullable items))completionHandler
+{
+	OCDatabase *database;
+
+	if ((database = _database) == nil)
+	{
+		completionHandler(OCError(OCErrorInternal), nil);
+		return;
+	}
+
+	[database retrieveCacheItemsForDatabaseIDs:databaseIDs completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+		if (error == nil)
+		{
+			@synchronized(self->_subscriptions)
+			{
+				// Only keep items that are still inside the window and its prefetch margins by the time they arrive
+				NSSet<OCDatabaseID> *materializedRangeIDs = [self _materializedRangeIDs];
+
+				for (OCItem *item in items)
+				{
+					OCDatabaseID databaseID;
+
+					if ((databaseID = item.databaseID) != nil)
+					{
+						if ([materializedRangeIDs containsObject:databaseID])
+						{
+							self->_materializedItemsByID[databaseID] = item;
+						}
+						else
+						{
+							[self cacheItem:item forItemRef:databaseID];
+						}
+					}
+				}
+			}
+		}
+
+		completionHandler(error, items);
+	}];
+}
+
+#pragma mark - Reload
+- (void)reloadWithCompletionHandler:(nullable void(^)(NSError * _Nullable error))completionHandler
+{
+	OCDatabase *database;
+
+	if ((database = _database) == nil)
+	{
+		if (completionHandler != nil)
+		{
+			completionHandler(OCError(OCErrorInternal));
+		}
+		return;
+	}
+
+	[database retrieveCacheItemDatabaseIDsAtLocation:_location queryCondition:_queryCondition sortedBy:_sortPropertyName ascending:_sortAscending completionHandler:^(OCDatabase *db, NSError *error, NSArray<OCDatabaseID> *databaseIDs, NSArray<OCDatabaseTimestamp> *databaseTimestamps) {
+		NSRange window;
+
+		if (error != nil)
+		{
+			OCLogError(@"Error retrieving database IDs for %@: %@", self, error);
+
+			if (completionHandler != nil)
+			{
+				completionHandler(error);
+			}
+			return;
+		}
+
+		@synchronized(self->_subscriptions)
+		{
+			NSMutableSet<OCDataItemReference> *updatedItemRefs = nil;
+			NSMutableSet<OCDatabaseID> *retainedIDs = [NSMutableSet new];
+
+			// Only materialized items are compared against their current database timestamp. Changed items are evicted and
+			// reported as updated, so they are retrieved anew. Items that were not materialized will be retrieved fresh anyway.
+			[databaseIDs enumerateObjectsUsingBlock:^(OCDatabaseID databaseID, NSUInteger idx, BOOL * _Nonnull stop) {
+				OCItem *materializedItem;
+
+				if ((materializedItem = self->_materializedItemsByID[databaseID]) != nil)
+				{
+					if ([materializedItem.databaseTimestamp isEqual:databaseTimestamps[idx]])
+					{
+						[retainedIDs addObject:databaseID];
+					}
+					else
+					{
+						if (updatedItemRefs == nil) { updatedItemRefs = [NSMutableSet new]; }
+						[updatedItemRefs addObject:databaseID];
+					}
+				}
+			}];
+
+			for (OCDatabaseID databaseID in self->_materializedItemsByID.allKeys)
+			{
+				if (![retainedIDs containsObject:databaseID])
+				{
+					[self->_materializedItemsByID removeObjectForKey:databaseID];
+				}
+			}
+
+			// Items outside the window may have changed, too
+			[self invalidateCache];
+
+			[self setItemReferences:databaseIDs updated:updatedItemRefs];
+
+			window = self->_window;
+			self->_materializedRange = [self _materializedRangeForWindow:window];
+		}
+
+		// Re-materialize the window
+		[self setWindow:window completionHandler:^(NSError * _Nullable error) {
+			self.state = OCDataSourceStateIdle;
+
+			if (completionHandler != nil)
+			{
+				completionHandler(error);
+			}
+		}];
+	}];
+}
+
+#pragma mark - Item retrieval
+- (nullable OCItem *)_availableItemForRef:(OCDataItemReference)itemRef
+{
+	OCItem *item;
+
+	@synchronized(_subscriptions)
+	{
+		if ((item = _materializedItemsByID[itemRef]) == nil)
+		{
+			item = (OCItem *)[self cachedItemForItemRef:itemRef];
+		}
+	}
+
+	return (item);
+}
+
+- (OCDataItemRecord *)_recordForItemRef:(OCDataItemReference)itemRef item:(nullable OCItem *)item
+{
+	return ([[OCDataItemRecord alloc] initWithSource:self itemType:OCDataItemTypeItem itemReference:itemRef hasChildren:(item.type == OCItemTypeCollection) item:item]);
+}
+
+- (nullable OCDataItemRecord *)recordForItemRef:(OCDataItemReference)itemRef error:(NSError * _Nullable * _Nullable)error
+{
+	// Items not (yet) materialized are returned as record without item. OCDataItemRecord.retrieveItemWithCompletionHandler: then retrieves the item asynchronously.
+	return ([self _recordForItemRef:itemRef item:[self _availableItemForRef:itemRef]]);
+}
+
+- (void)retrieveItemForRef:(OCDataItemReference)itemRef reusingRecord:(nullable OCDataItemRecord *)reuseRecord completionHandler:(OCDataSourceItemForReferenceCompletionHandler)completionHandler
+{
+	OCItem *item;
+
+	void (^CompleteWithItem)(OCItem *item) = ^(OCItem *item) {
+		if (reuseRecord != nil)
+		{
+			reuseRecord.item = item;
+			reuseRecord.hasChildren = (item.type == OCItemTypeCollection);
+
+			completionHandler(nil, reuseRecord);
+		}
+		else
+		{
+			completionHandler(nil, [self _recordForItemRef:itemRef item:item]);
+		}
+	};
+
+	if ((item = [self _availableItemForRef:itemRef]) != nil)
+	{
+		CompleteWithItem(item);
+		return;
+	}
+
+	[self _materializeItemsWithIDs:@[ itemRef ] completionHandler:^(NSError * _Nullable error, NSArray<OCItem *> * _Nullable items) {
+		OCItem *item;
+
+		if (error != nil)
+		{
+			completionHandler(error, nil);
+			return;
+		}
+
+		if ((item = items.firstObject) == nil)
+		{
+			completionHandler(OCError(OCErrorItemNotFound), nil);
+			return;
+		}
+
+		CompleteWithItem(item);
+	}];
+}
+
+#pragma mark - Description
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, location: %@, condition: %@, sortedBy: %@ %@, items: %lu, window: %@, materialized: %lu>", NSStringFromClass(self.class), self, _location, _queryCondition, _sortPropertyName, (_sortAscending ? @"ASC" : @"DESC"), (unsigned long)self.numberOfItems, NSStringFromRange(self.window), (unsigned long)self.numberOfMaterializedItems]);
+}
+
+@end
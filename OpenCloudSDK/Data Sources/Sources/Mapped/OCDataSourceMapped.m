@@ -20,9 +20,11 @@
 
 @implementation OCDataSourceMapped
 {
-	NSMutableArray<id<OCDataItem>> *_mappedItems;
+	NSHashTable<id<OCDataItem>> *_mappedItems;
 	NSMapTable<OCDataItemReference, id<OCDataItem>> *_mappedItemBySourceItemReference;
 
+	BOOL _mirrorsSourceIndexes; //!< YES if every source item has a mapped item at the same index, so that source change sets can be applied incrementally
+
 	OCDataSourceSubscription *_subscription;
 
 	OCDataSourceMappedItemCreator _itemCreator;
@@ -40,7 +42,7 @@
 		_itemUpdater = itemUpdater;
 		_itemDestroyer = itemDestroyer;
 
-		_mappedItems = NSMutableArray.new;
+		_mappedItems = [NSHashTable hashTableWithOptions:NSPointerFunctionsStrongMemory|NSPointerFunctionsObjectPointerPersonality];
 		_mappedItemBySourceItemReference = NSMapTable.strongToWeakObjectsMapTable;
 
 		_queue = queue;
@@ -77,6 +79,7 @@
 	}
 
 	_source = source;
+	_mirrorsSourceIndexes = NO;
 
 	if (source != nil)
 	{
@@ -93,6 +96,41 @@
 }
 
 - (void)_handleSourceSnapshot:(OCDataSourceSnapshot *)snapshot
+{
+	NSMutableSet<id<OCDataItem>> *updatedItems = [NSMutableSet new];
+
+	if (_mirrorsSourceIndexes && (snapshot.changeSets != nil))
+	{
+		// Apply changes incrementally
+		if ([self _applySourceChangeSets:snapshot.changeSets updatedItems:updatedItems])
+		{
+			return;
+		}
+	}
+	else
+	{
+		[self _mapItemsFromSnapshot:snapshot updatedItems:updatedItems];
+	}
+
+	// Compose items array (establish same order and corresponding contents as source)
+	NSMutableArray<id<OCDataItem>> *items = [NSMutableArray new];
+
+	for (OCDataItemReference sourceItemReference in snapshot.items)
+	{
+		id<OCDataItem> mappedItem;
+
+		if ((mappedItem = [_mappedItemBySourceItemReference objectForKey:sourceItemReference]) != nil)
+		{
+			[items addObject:mappedItem];
+		}
+	}
+
+	_mirrorsSourceIndexes = (items.count == snapshot.items.count);
+
+	[self setItems:items updated:updatedItems];
+}
+
+- (void)_mapItemsFromSnapshot:(OCDataSourceSnapshot *)snapshot updatedItems:(NSMutableSet<id<OCDataItem>> *)updatedItems
 {
 	// Remove items
 	for (OCDataItemReference removedItemReference in snapshot.removedItems)
@@ -121,68 +159,186 @@
 
 	for (OCDataItemReference addedItemReference in addedItems)
 	{
-		NSError *error = nil;
-		OCDataItemRecord *addedItemRecord = [_source recordForItemRef:addedItemReference error:&error];
+		[self _createMappedItemForSourceItemReference:addedItemReference];
+	}
+
+	// Update items
+	for (OCDataItemReference updatedItemReference in snapshot.updatedItems)
+	{
+		id<OCDataItem> existingMappedItem = [_mappedItemBySourceItemReference objectForKey:updatedItemReference];
+		id<OCDataItem> updatedMappedItem;
 
-		if (addedItemRecord != nil)
+		if ((updatedMappedItem = [self _updateMappedItem:existingMappedItem forSourceItemReference:updatedItemReference]) != nil)
 		{
-			id<OCDataItem> mappedItem;
+			[updatedItems addObject:updatedMappedItem];
+		}
+	}
+}
 
-			if ((mappedItem = _itemCreator(self, addedItemRecord.item)) != nil)
-			{
-				[_mappedItems addObject:mappedItem];
-				[_mappedItemBySourceItemReference setObject:mappedItem forKey:addedItemReference];
-			}
+- (nullable id<OCDataItem>)_createMappedItemForSourceItemReference:(OCDataItemReference)sourceItemReference
+{
+	NSError *error = nil;
+	OCDataItemRecord *addedItemRecord = [_source recordForItemRef:sourceItemReference error:&error];
+
+	if (addedItemRecord != nil)
+	{
+		id<OCDataItem> mappedItem;
+
+		if ((mappedItem = _itemCreator(self, addedItemRecord.item)) != nil)
+		{
+			[_mappedItems addObject:mappedItem];
+			[_mappedItemBySourceItemReference setObject:mappedItem forKey:sourceItemReference];
+
+			return (mappedItem);
 		}
 	}
 
-	// Update items
-	NSMutableSet<id<OCDataItem>> *updatedItems = [NSMutableSet new];
+	return (nil);
+}
 
-	for (OCDataItemReference updatedItemReference in snapshot.updatedItems)
+- (nullable id<OCDataItem>)_updateMappedItem:(nullable id<OCDataItem>)existingMappedItem forSourceItemReference:(OCDataItemReference)sourceItemReference
+{
+	NSError *error = nil;
+	OCDataItemRecord *updatedItemRecord = [_source recordForItemRef:sourceItemReference error:&error];
+
+	if ((updatedItemRecord != nil) && (existingMappedItem != nil))
 	{
-		NSError *error = nil;
-		OCDataItemRecord *updatedItemRecord = [_source recordForItemRef:updatedItemReference error:&error];
-		id<OCDataItem> existingMappedItem = [_mappedItemBySourceItemReference objectForKey:updatedItemReference];
+		id<OCDataItem> updatedMappedItem;
 
-		if ((updatedItemRecord != nil) && (existingMappedItem != nil))
+		if (_itemUpdater != nil)
 		{
-			id<OCDataItem> updatedMappedItem;
+			updatedMappedItem = _itemUpdater(self, updatedItemRecord.item, existingMappedItem);
+		}
+		else
+		{
+			updatedMappedItem = existingMappedItem;
+		}
+
+		if (updatedMappedItem != existingMappedItem)
+		{
+			[_mappedItems removeObject:existingMappedItem];
+			[_mappedItems addObject:updatedMappedItem];
+			[_mappedItemBySourceItemReference setObject:updatedMappedItem forKey:sourceItemReference];
+		}
+
+		return (updatedMappedItem);
+	}
+
+	return (nil);
+}
+
+- (BOOL)_applySourceChangeSets:(NSArray<OCDataSourceChangeSet *> *)sourceChangeSets updatedItems:(NSMutableSet<id<OCDataItem>> *)updatedItems
+{
+	/*
+		Translates the source's change sets into change sets for the mapped items. Since mapped items are kept at the
+		same indexes as their source items, only the item references need to be translated. If that isn't possible (f.ex.
+		because the creator didn't return an item), the mapping is still performed, but NO is returned, so the caller can
+		compose the items array in full.
+	*/
+	NSMutableArray<OCDataSourceChangeSet *> *mappedChangeSets = [NSMutableArray new];
+	NSMutableArray<NSArray<id<OCDataItem>> *> *changedItemsByChangeSet = [NSMutableArray new];
+	BOOL mirrorsSourceIndexes = YES;
+
+	for (OCDataSourceChangeSet *changeSet in sourceChangeSets)
+	{
+		NSMutableArray<OCDataItemReference> *deletedItemRefs = [NSMutableArray new];
+		NSMutableArray<OCDataItemReference> *insertedItemRefs = [NSMutableArray new];
+		NSMutableArray<OCDataSourceChangeSetMove *> *moves = [NSMutableArray new];
+		NSMutableSet<OCDataItemReference> *updatedItemRefs = [NSMutableSet new];
+		NSMutableArray<id<OCDataItem>> *changedItems = [NSMutableArray new];
+
+		// Remove items
+		for (OCDataItemReference removedItemReference in changeSet.deletedItemRefs)
+		{
+			id<OCDataItem> mappedItem;
+
+			if ((mappedItem = [_mappedItemBySourceItemReference objectForKey:removedItemReference]) != nil)
+			{
+				if (_itemDestroyer != nil)
+				{
+					_itemDestroyer(self, removedItemReference, mappedItem);
+				}
+
+				[deletedItemRefs addObject:mappedItem.dataItemReference];
+
+				[_mappedItems removeObject:mappedItem];
+				[_mappedItemBySourceItemReference removeObjectForKey:removedItemReference];
+			}
+			else
+			{
+				mirrorsSourceIndexes = NO;
+			}
+		}
+
+		// Added items
+		for (OCDataItemReference addedItemReference in changeSet.insertedItemRefs)
+		{
+			id<OCDataItem> mappedItem;
 
-			if (_itemUpdater != nil)
+			if ((mappedItem = [self _createMappedItemForSourceItemReference:addedItemReference]) != nil)
 			{
-				updatedMappedItem = _itemUpdater(self, updatedItemRecord.item, existingMappedItem);
+				[insertedItemRefs addObject:mappedItem.dataItemReference];
+				[changedItems addObject:mappedItem];
 			}
 			else
 			{
-				updatedMappedItem = existingMappedItem;
+				mirrorsSourceIndexes = NO;
 			}
+		}
 
-			if (updatedMappedItem != existingMappedItem)
+		// Moved items
+		for (OCDataSourceChangeSetMove *move in changeSet.moves)
+		{
+			id<OCDataItem> mappedItem;
+
+			if ((mappedItem = [_mappedItemBySourceItemReference objectForKey:move.itemRef]) != nil)
+			{
+				[moves addObject:[[OCDataSourceChangeSetMove alloc] initWithItemRef:mappedItem.dataItemReference fromIndex:move.fromIndex toIndex:move.toIndex]];
+			}
+			else
 			{
-				[_mappedItems removeObject:existingMappedItem];
-				[_mappedItems addObject:updatedMappedItem];
-				[_mappedItemBySourceItemReference setObject:updatedMappedItem forKey:updatedItemReference];
+				mirrorsSourceIndexes = NO;
 			}
+		}
 
-			[updatedItems addObject:updatedMappedItem];
+		// Update items
+		for (OCDataItemReference updatedItemReference in changeSet.updatedItemRefs)
+		{
+			id<OCDataItem> existingMappedItem = [_mappedItemBySourceItemReference objectForKey:updatedItemReference];
+			id<OCDataItem> updatedMappedItem;
+
+			if ((updatedMappedItem = [self _updateMappedItem:existingMappedItem forSourceItemReference:updatedItemReference]) != nil)
+			{
+				if (![updatedMappedItem.dataItemReference isEqual:existingMappedItem.dataItemReference])
+				{
+					// Item reference changed, which can't be expressed as an update
+					mirrorsSourceIndexes = NO;
+				}
+
+				[updatedItemRefs addObject:updatedMappedItem.dataItemReference];
+				[changedItems addObject:updatedMappedItem];
+				[updatedItems addObject:updatedMappedItem];
+			}
 		}
-	}
 
-	// Compose items array (establish same order and corresponding contents as source)
-	NSMutableArray<id<OCDataItem>> *items = [NSMutableArray new];
+		[mappedChangeSets addObject:[[OCDataSourceChangeSet alloc] initWithDeletedIndexes:changeSet.deletedIndexes itemRefs:deletedItemRefs insertedIndexes:changeSet.insertedIndexes itemRefs:insertedItemRefs moves:moves updated:updatedItemRefs]];
+		[changedItemsByChangeSet addObject:changedItems];
+	}
 
-	for (OCDataItemReference sourceItemReference in snapshot.items)
+	if (!mirrorsSourceIndexes)
 	{
-		id<OCDataItem> mappedItem;
+		return (NO);
+	}
 
-		if ((mappedItem = [_mappedItemBySourceItemReference objectForKey:sourceItemReference]) != nil)
+	for (NSUInteger idx=0; idx < mappedChangeSets.count; idx++)
+	{
+		if (![self applyChangeSet:mappedChangeSets[idx] items:changedItemsByChangeSet[idx]])
 		{
-			[items addObject:mappedItem];
+			return (NO);
 		}
 	}
 
-	[self setItems:items updated:updatedItems];
+	return (YES);
 }
 
 @end
@@ -83,6 +83,7 @@ typedef NS_ENUM(NSInteger, OCDataSourceState)
 #pragma mark - Managing content
 - (void)setItemReferences:(nullable NSArray<OCDataItemReference> *)itemRefs updated:(nullable NSSet<OCDataItemReference> *)updatedItemRefs;
 - (void)signalUpdatesForItemReferences:(nullable NSSet<OCDataItemReference> *)updatedItemRefs;
+- (BOOL)applyChangeSet:(OCDataSourceChangeSet *)changeSet; //!< Incrementally applies the changes in changeSet to the item references and passes them on to subscribers without computing a full difference. Returns NO - and leaves the item references untouched - if the change set can't be applied.
 
 #pragma mark - Synchronization
 @property(strong,nullable) dispatch_group_t synchronizationGroup; //!< If the contents of several data sources should be updated "atomically", notifications need to be withheld until the last data source has completed updating. Providing this dispatch group allows synchronization of change notifications across data sources. The synchronizationGroup is only used for subscriptions with an .updateQueue. A warning is logged otherwise.
@@ -20,6 +20,7 @@
 #import "OCDataSourceSubscription.h"
 #import "OCDataSourceSubscription+Internal.h"
 #import "NSError+OCError.h"
+#import "OCLogger.h"
 
 @interface OCDataSource ()
 {
@@ -63,6 +64,15 @@
 	}
 }
 
+#pragma mark - Item count
+- (NSUInteger)numberOfItems
+{
+	@synchronized(_subscriptions)
+	{
+		return (_itemReferences.count);
+	}
+}
+
 #pragma mark - Item retrieval
 - (OCDataItemRecord *)recordForItemRef:(OCDataItemReference)itemRef error:(NSError * _Nullable __autoreleasing *)error
 {
@@ -219,16 +229,31 @@
 {
 	@synchronized (_subscriptions)
 	{
+		OCDataSourceChangeSet *changeSet = nil;
+
 		if (_synchronizationGroup != nil)
 		{
 			dispatch_group_enter(_synchronizationGroup);
 		}
 
+		if (_subscriptions.count > 0)
+		{
+			// Compute the difference once, so subscriptions and data sources consuming them only need to process the changes
+			changeSet = [OCDataSourceChangeSet changeSetFromItemReferences:_itemReferences toItemReferences:((itemRefs != nil) ? itemRefs : @[]) updated:updatedItemRefs];
+		}
+
 		[_itemReferences setArray:itemRefs];
 
 		for (OCDataSourceSubscription *subscription in _subscriptions)
 		{
-			[subscription _updateWithItemReferences:itemRefs updated:updatedItemRefs];
+			if (changeSet != nil)
+			{
+				[subscription _updateWithChangeSet:changeSet itemReferences:_itemReferences];
+			}
+			else
+			{
+				[subscription _updateWithItemReferences:itemRefs updated:updatedItemRefs];
+			}
 		}
 
 		if (_synchronizationGroup != nil)
@@ -238,13 +263,52 @@
 	}
 }
 
+- (BOOL)applyChangeSet:(OCDataSourceChangeSet *)changeSet
+{
+	@synchronized (_subscriptions)
+	{
+		if (![changeSet applyToItemReferences:_itemReferences])
+		{
+			OCLogError(@"Change set %@ not applicable to data source %@ with %lu items", changeSet, self, (unsigned long)_itemReferences.count);
+			return (NO);
+		}
+
+		if (_synchronizationGroup != nil)
+		{
+			dispatch_group_enter(_synchronizationGroup);
+		}
+
+		for (OCDataSourceSubscription *subscription in _subscriptions)
+		{
+			[subscription _updateWithChangeSet:changeSet itemReferences:_itemReferences];
+		}
+
+		if (_synchronizationGroup != nil)
+		{
+			dispatch_group_leave(_synchronizationGroup);
+		}
+	}
+
+	return (YES);
+}
+
 - (void)signalUpdatesForItemReferences:(nullable NSSet<OCDataItemReference> *)updatedItemRefs
 {
 	@synchronized (_subscriptions)
 	{
+		OCDataSourceChangeSet *changeSet = (updatedItemRefs.count > 0) ? [OCDataSourceChangeSet changeSetWithUpdatedItemRefs:updatedItemRefs] : nil;
+
 		for (OCDataSourceSubscription *subscription in _subscriptions)
 		{
-			[subscription _updateWithItemReferences:_itemReferences updated:updatedItemRefs];
+			if (changeSet != nil)
+			{
+				[subscription _updateWithChangeSet:changeSet itemReferences:_itemReferences];
+			}
+			else
+			{
+				// Without updated items, keep letting subscriptions re-evaluate their state as before
+				[subscription _updateWithItemReferences:_itemReferences updated:updatedItemRefs];
+			}
 		}
 	}
 }
@@ -0,0 +1,71 @@
+//
+//  OCDataSourceChangeSet.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCDataTypes.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCDataSourceChangeSetMove : NSObject
+
+@property(strong,readonly) OCDataItemReference itemRef;
+@property(assign,readonly) NSUInteger fromIndex; //!< Index of the item before the change set is applied
+@property(assign,readonly) NSUInteger toIndex; //!< Index of the item after the change set is applied
+
+- (instancetype)initWithItemRef:(OCDataItemReference)itemRef fromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex;
+
+@end
+
+/*
+	Change sets describe the difference between two versions of a data source's item references as a batch - using the same semantics as UICollectionView/UITableView batch updates:
+	- deletions and move sources use indexes in the item references BEFORE the change set is applied
+	- insertions and move targets use indexes in the item references AFTER the change set is applied
+*/
+@interface OCDataSourceChangeSet : NSObject
+
+@property(strong,readonly) NSIndexSet *deletedIndexes; //!< Indexes of deleted items before the change set is applied
+@property(strong,readonly) NSArray<OCDataItemReference> *deletedItemRefs; //!< Deleted item references, in ascending order of .deletedIndexes
+
+@property(strong,readonly) NSIndexSet *insertedIndexes; //!< Indexes of inserted items after the change set is applied
+@property(strong,readonly) NSArray<OCDataItemReference> *insertedItemRefs; //!< Inserted item references, in ascending order of .insertedIndexes
+
+@property(strong,readonly) NSArray<OCDataSourceChangeSetMove *> *moves; //!< Items that changed their position relative to the other items
+
+@property(strong,readonly) NSSet<OCDataItemReference> *updatedItemRefs; //!< Items whose content was updated
+
+@property(readonly,nonatomic) NSUInteger changeCount; //!< Total number of deletions, insertions, moves and updates
+@property(readonly,nonatomic) BOOL isEmpty;
+@property(readonly,nonatomic) NSInteger numberOfItemsDelta; //!< Difference in number of items after the change set is applied
+
+- (instancetype)initWithDeletedIndexes:(nullable NSIndexSet *)deletedIndexes itemRefs:(nullable NSArray<OCDataItemReference> *)deletedItemRefs insertedIndexes:(nullable NSIndexSet *)insertedIndexes itemRefs:(nullable NSArray<OCDataItemReference> *)insertedItemRefs moves:(nullable NSArray<OCDataSourceChangeSetMove *> *)moves updated:(nullable NSSet<OCDataItemReference> *)updatedItemRefs;
+
++ (instancetype)changeSetWithUpdatedItemRefs:(NSSet<OCDataItemReference> *)updatedItemRefs; //!< Change set that only updates items
+
+#pragma mark - Computing differences
++ (nullable instancetype)changeSetFromItemReferences:(NSArray<OCDataItemReference> *)oldItemRefs toItemReferences:(NSArray<OCDataItemReference> *)newItemRefs updated:(nullable NSSet<OCDataItemReference> *)updatedItemRefs; //!< Computes the change set that transforms oldItemRefs into newItemRefs, using a minimal number of moves. Returns nil if either array contains duplicate item references.
+
+#pragma mark - Applying
+- (BOOL)isApplicableToNumberOfItems:(NSUInteger)numberOfItems; //!< Returns YES if all indexes of the change set are within bounds for an array with numberOfItems items
+- (BOOL)applyToItemReferences:(NSMutableArray<OCDataItemReference> *)itemRefs; //!< Applies the change set to itemRefs. Returns NO without modifying itemRefs if the change set is not applicable.
+
+#pragma mark - Transformation
+- (OCDataSourceChangeSet *)changeSetByOffsettingIndexesBy:(NSUInteger)offset; //!< Returns a change set with all indexes shifted by offset, f.ex. to describe the changes of a data source that is part of a composition
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,360 @@
+//
+//  OCDataSourceChangeSet.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCDataSourceChangeSet.h"
+
+@implementation OCDataSourceChangeSetMove
+
+- (instancetype)initWithItemRef:(OCDataItemReference)itemRef fromIndex:(NSUInteger)fromIndex toIndex:(NSUInteger)toIndex
+{
+	if ((self = [super init]) != nil)
+	{
+		_itemRef = itemRef;
+		_fromIndex = fromIndex;
+		_toIndex = toIndex;
+	}
+
+	return (self);
+}
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, itemRef: %@, %lu -> %lu>", NSStringFromClass(self.class), self, _itemRef, (unsigned long)_fromIndex, (unsigned long)_toIndex]);
+}
+
+@end
+
+@implementation OCDataSourceChangeSet
+{
+	NSIndexSet *_removalIndexes; //!< Indexes of deleted items and move sources
+	NSIndexSet *_insertionIndexes; //!< Indexes of inserted items and move targets
+	NSArray<OCDataItemReference> *_insertionItemRefs; //!< Item references to insert at _insertionIndexes, in ascending order
+}
+
+- (instancetype)initWithDeletedIndexes:(NSIndexSet *)deletedIndexes itemRefs:(NSArray<OCDataItemReference> *)deletedItemRefs insertedIndexes:(NSIndexSet *)insertedIndexes itemRefs:(NSArray<OCDataItemReference> *)insertedItemRefs moves:(NSArray<OCDataSourceChangeSetMove *> *)moves updated:(NSSet<OCDataItemReference> *)updatedItemRefs
+{
+	if ((self = [super init]) != nil)
+	{
+		_deletedIndexes = (deletedIndexes != nil) ? deletedIndexes : [NSIndexSet new];
+		_deletedItemRefs = (deletedItemRefs != nil) ? deletedItemRefs : @[];
+
+		_insertedIndexes = (insertedIndexes != nil) ? insertedIndexes : [NSIndexSet new];
+		_insertedItemRefs = (insertedItemRefs != nil) ? insertedItemRefs : @[];
+
+		_updatedItemRefs = (updatedItemRefs != nil) ? updatedItemRefs : [NSSet new];
+
+		if (moves.count > 0)
+		{
+			NSMutableIndexSet *removalIndexes = [_deletedIndexes mutableCopy];
+			NSMutableIndexSet *insertionIndexes = [_insertedIndexes mutableCopy];
+			NSMutableArray<OCDataItemReference> *insertionItemRefs = [NSMutableArray arrayWithCapacity:_insertedItemRefs.count + moves.count];
+			NSUInteger insertedOffset = 0, insertedIndex = _insertedIndexes.firstIndex;
+
+			// Sort moves by target index
+			_moves = [moves sortedArrayUsingComparator:^NSComparisonResult(OCDataSourceChangeSetMove * _Nonnull move1, OCDataSourceChangeSetMove * _Nonnull move2) {
+				return ((move1.toIndex < move2.toIndex) ? NSOrderedAscending : ((move1.toIndex > move2.toIndex) ? NSOrderedDescending : NSOrderedSame));
+			}];
+
+			// Merge inserted items and move targets in ascending index order
+			for (OCDataSourceChangeSetMove *move in _moves)
+			{
+				while ((insertedIndex != NSNotFound) && (insertedIndex < move.toIndex))
+				{
+					[insertionItemRefs addObject:_insertedItemRefs[insertedOffset++]];
+					insertedIndex = [_insertedIndexes indexGreaterThanIndex:insertedIndex];
+				}
+
+				[insertionItemRefs addObject:move.itemRef];
+
+				[removalIndexes addIndex:move.fromIndex];
+				[insertionIndexes addIndex:move.toIndex];
+			}
+
+			while (insertedOffset < _insertedItemRefs.count)
+			{
+				[insertionItemRefs addObject:_insertedItemRefs[insertedOffset++]];
+			}
+
+			_removalIndexes = removalIndexes;
+			_insertionIndexes = insertionIndexes;
+			_insertionItemRefs = insertionItemRefs;
+		}
+		else
+		{
+			_moves = @[];
+
+			_removalIndexes = _deletedIndexes;
+			_insertionIndexes = _insertedIndexes;
+			_insertionItemRefs = _insertedItemRefs;
+		}
+	}
+
+	return (self);
+}
+
++ (instancetype)changeSetWithUpdatedItemRefs:(NSSet<OCDataItemReference> *)updatedItemRefs
+{
+	return ([[self alloc] initWithDeletedIndexes:nil itemRefs:nil insertedIndexes:nil itemRefs:nil moves:nil updated:updatedItemRefs]);
+}
+
+#pragma mark - Properties
+- (NSUInteger)changeCount
+{
+	return (_deletedIndexes.count + _insertedIndexes.count + _moves.count + _updatedItemRefs.count);
+}
+
+- (BOOL)isEmpty
+{
+	return (self.changeCount == 0);
+}
+
+- (NSInteger)numberOfItemsDelta
+{
+	return ((NSInteger)_insertedIndexes.count - (NSInteger)_deletedIndexes.count);
+}
+
+#pragma mark - Computing differences
++ (instancetype)changeSetFromItemReferences:(NSArray<OCDataItemReference> *)oldItemRefs toItemReferences:(NSArray<OCDataItemReference> *)newItemRefs updated:(NSSet<OCDataItemReference> *)updatedItemRefs
+{
+	NSUInteger oldCount = oldItemRefs.count, newCount = newItemRefs.count;
+	NSMapTable<OCDataItemReference, NSNumber *> *oldIndexByItemRef = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory valueOptions:NSPointerFunctionsStrongMemory capacity:oldCount];
+	NSMapTable<OCDataItemReference, NSNumber *> *newIndexByItemRef = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory valueOptions:NSPointerFunctionsStrongMemory capacity:newCount];
+	NSMutableIndexSet *deletedIndexes = [NSMutableIndexSet new], *insertedIndexes = [NSMutableIndexSet new];
+	NSMutableArray<OCDataItemReference> *deletedItemRefs = [NSMutableArray new], *insertedItemRefs = [NSMutableArray new];
+	NSMutableArray<OCDataSourceChangeSetMove *> *moves = [NSMutableArray new];
+	NSMutableSet<OCDataItemReference> *effectiveUpdatedItemRefs = nil;
+	NSUInteger *survivorOldIndexes, *survivorNewIndexes, *tailPositions, *predecessors;
+	NSUInteger survivorCount = 0, lisLength = 0;
+	BOOL *keep;
+
+	// Index item references
+	for (NSUInteger idx=0; idx < oldCount; idx++)
+	{
+		[oldIndexByItemRef setObject:@(idx) forKey:oldItemRefs[idx]];
+	}
+
+	for (NSUInteger idx=0; idx < newCount; idx++)
+	{
+		[newIndexByItemRef setObject:@(idx) forKey:newItemRefs[idx]];
+	}
+
+	if ((oldIndexByItemRef.count != oldCount) || (newIndexByItemRef.count != newCount))
+	{
+		// Duplicate item references
+		return (nil);
+	}
+
+	// Deletions
+	for (NSUInteger idx=0; idx < oldCount; idx++)
+	{
+		OCDataItemReference itemRef = oldItemRefs[idx];
+
+		if ([newIndexByItemRef objectForKey:itemRef] == nil)
+		{
+			[deletedIndexes addIndex:idx];
+			[deletedItemRefs addObject:itemRef];
+		}
+	}
+
+	// Insertions and items contained in both
+	survivorOldIndexes = malloc(sizeof(NSUInteger) * (newCount + 1));
+	survivorNewIndexes = malloc(sizeof(NSUInteger) * (newCount + 1));
+	tailPositions = malloc(sizeof(NSUInteger) * (newCount + 1));
+	predecessors = malloc(sizeof(NSUInteger) * (newCount + 1));
+	keep = calloc(newCount + 1, sizeof(BOOL));
+
+	if ((survivorOldIndexes == NULL) || (survivorNewIndexes == NULL) || (tailPositions == NULL) || (predecessors == NULL) || (keep == NULL))
+	{
+		free(survivorOldIndexes);
+		free(survivorNewIndexes);
+		free(tailPositions);
+		free(predecessors);
+		free(keep);
+
+		return (nil);
+	}
+
+	for (NSUInteger idx=0; idx < newCount; idx++)
+	{
+		OCDataItemReference itemRef = newItemRefs[idx];
+		NSNumber *oldIndex;
+
+		if ((oldIndex = [oldIndexByItemRef objectForKey:itemRef]) == nil)
+		{
+			[insertedIndexes addIndex:idx];
+			[insertedItemRefs addObject:itemRef];
+		}
+		else
+		{
+			survivorOldIndexes[survivorCount] = oldIndex.unsignedIntegerValue;
+			survivorNewIndexes[survivorCount] = idx;
+			survivorCount++;
+		}
+	}
+
+	// Find the longest subsequence of items that kept their relative order (O(n log n)) - all other items have moved
+	for (NSUInteger i=0; i < survivorCount; i++)
+	{
+		NSUInteger lo = 0, hi = lisLength;
+
+		while (lo < hi)
+		{
+			NSUInteger mid = (lo + hi) / 2;
+
+			if (survivorOldIndexes[tailPositions[mid]] < survivorOldIndexes[i])
+			{
+				lo = mid + 1;
+			}
+			else
+			{
+				hi = mid;
+			}
+		}
+
+		predecessors[i] = (lo > 0) ? tailPositions[lo - 1] : NSNotFound;
+		tailPositions[lo] = i;
+
+		if (lo == lisLength)
+		{
+			lisLength++;
+		}
+	}
+
+	for (NSUInteger i = (lisLength > 0) ? tailPositions[lisLength - 1] : NSNotFound; i != NSNotFound; i = predecessors[i])
+	{
+		keep[i] = YES;
+	}
+
+	for (NSUInteger i=0; i < survivorCount; i++)
+	{
+		if (!keep[i])
+		{
+			[moves addObject:[[OCDataSourceChangeSetMove alloc] initWithItemRef:newItemRefs[survivorNewIndexes[i]] fromIndex:survivorOldIndexes[i] toIndex:survivorNewIndexes[i]]];
+		}
+	}
+
+	free(survivorOldIndexes);
+	free(survivorNewIndexes);
+	free(tailPositions);
+	free(predecessors);
+	free(keep);
+
+	// Updates (only for items that are part of the new item references)
+	if (updatedItemRefs.count > 0)
+	{
+		effectiveUpdatedItemRefs = [NSMutableSet new];
+
+		for (OCDataItemReference itemRef in updatedItemRefs)
+		{
+			if ([newIndexByItemRef objectForKey:itemRef] != nil)
+			{
+				[effectiveUpdatedItemRefs addObject:itemRef];
+			}
+		}
+	}
+
+	return ([[self alloc] initWithDeletedIndexes:deletedIndexes itemRefs:deletedItemRefs insertedIndexes:insertedIndexes itemRefs:insertedItemRefs moves:moves updated:effectiveUpdatedItemRefs]);
+}
+
+#pragma mark - Applying
+- (BOOL)isApplicableToNumberOfItems:(NSUInteger)numberOfItems
+{
+	NSUInteger removalCount = _deletedIndexes.count + _moves.count;
+	NSUInteger insertionCount = _insertedIndexes.count + _moves.count;
+	NSUInteger newNumberOfItems;
+
+	if ((_removalIndexes.count != removalCount) || (_insertionIndexes.count != insertionCount))
+	{
+		// Overlapping indexes
+		return (NO);
+	}
+
+	if (removalCount > numberOfItems)
+	{
+		return (NO);
+	}
+
+	if ((removalCount > 0) && (_removalIndexes.lastIndex >= numberOfItems))
+	{
+		return (NO);
+	}
+
+	newNumberOfItems = numberOfItems - removalCount + insertionCount;
+
+	if ((insertionCount > 0) && (_insertionIndexes.lastIndex >= newNumberOfItems))
+	{
+		return (NO);
+	}
+
+	return (YES);
+}
+
+- (BOOL)applyToItemReferences:(NSMutableArray<OCDataItemReference> *)itemRefs
+{
+	if (![self isApplicableToNumberOfItems:itemRefs.count])
+	{
+		return (NO);
+	}
+
+	if (_removalIndexes.count > 0)
+	{
+		[itemRefs removeObjectsAtIndexes:_removalIndexes];
+	}
+
+	if (_insertionIndexes.count > 0)
+	{
+		[itemRefs insertObjects:_insertionItemRefs atIndexes:_insertionIndexes];
+	}
+
+	return (YES);
+}
+
+#pragma mark - Transformation
+- (OCDataSourceChangeSet *)changeSetByOffsettingIndexesBy:(NSUInteger)offset
+{
+	NSMutableIndexSet *deletedIndexes, *insertedIndexes;
+	NSMutableArray<OCDataSourceChangeSetMove *> *moves;
+
+	if (offset == 0)
+	{
+		return (self);
+	}
+
+	deletedIndexes = [_deletedIndexes mutableCopy];
+	[deletedIndexes shiftIndexesStartingAtIndex:0 by:offset];
+
+	insertedIndexes = [_insertedIndexes mutableCopy];
+	[insertedIndexes shiftIndexesStartingAtIndex:0 by:offset];
+
+	moves = [[NSMutableArray alloc] initWithCapacity:_moves.count];
+
+	for (OCDataSourceChangeSetMove *move in _moves)
+	{
+		[moves addObject:[[OCDataSourceChangeSetMove alloc] initWithItemRef:move.itemRef fromIndex:move.fromIndex+offset toIndex:move.toIndex+offset]];
+	}
+
+	return ([[OCDataSourceChangeSet alloc] initWithDeletedIndexes:deletedIndexes itemRefs:_deletedItemRefs insertedIndexes:insertedIndexes itemRefs:_insertedItemRefs moves:moves updated:_updatedItemRefs]);
+}
+
+#pragma mark - Description
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, deleted: %@, inserted: %@, moves: %@, updated: %@>", NSStringFromClass(self.class), self, _deletedIndexes, _insertedIndexes, _moves, _updatedItemRefs]);
+}
+
+@end
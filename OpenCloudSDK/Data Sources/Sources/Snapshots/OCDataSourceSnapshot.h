@@ -18,6 +18,7 @@
 
 #import <Foundation/Foundation.h>
 #import "OCDataTypes.h"
+#import "OCDataSourceChangeSet.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -31,6 +32,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property(strong,nullable) NSSet<OCDataItemReference> *updatedItems; //!< Updated items since last snapshot
 @property(strong,nullable) NSSet<OCDataItemReference> *removedItems; //!< Removed items since last snapshot
 
+@property(strong,nullable) NSArray<OCDataSourceChangeSet *> *changeSets; //!< Ordered change sets that transform the items of the last snapshot into .items. Only provided if the subscription tracks differences and the changes since the last snapshot are known incrementally. If nil, consumers need to process .items in full.
+
 @property(strong,nullable) NSDictionary<OCDataSourceSpecialItem, id<OCDataItem>> *specialItems; //!< The current special items at the time of snapshot
 
 @end
@@ -26,6 +26,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property(nonatomic) BOOL isInterDataSourceSubscription;
 
 - (void)_updateWithItemReferences:(nullable NSArray<OCDataItemReference> *)itemRefs updated:(nullable NSSet<OCDataItemReference> *)updatedItemRefs;
+- (void)_updateWithChangeSet:(OCDataSourceChangeSet *)changeSet itemReferences:(NSArray<OCDataItemReference> *)itemRefs; //!< Applies changeSet to the subscription's item references. itemRefs are the source's item references after applying changeSet and are used as fallback.
 - (void)setNeedsUpdateHandling;
 
 @end
@@ -20,6 +20,8 @@
 #import "OCDataSource.h"
 #import "OCLogger.h"
 
+static const NSUInteger OCDataSourceSubscriptionMinimumChangeSetsChangeCount = 256; //!< Change sets are accumulated until the number of changes exceeds the number of items or this value, whichever is greater
+
 @implementation OCDataSourceSubscription (Internal)
 
 - (void)setNeedsUpdateHandling
@@ -207,6 +209,9 @@
 				{
 					wasUpdated = YES;
 				}
+
+				// Changes were not provided as change set, so consumers need to process the items in full
+				_changeSets = nil;
 			}
 		}
 	}
@@ -218,6 +223,91 @@
 	}
 }
 
+- (void)_updateWithChangeSet:(OCDataSourceChangeSet *)changeSet itemReferences:(NSArray<OCDataItemReference> *)itemRefs
+{
+	if (changeSet.isEmpty)
+	{
+		if (!self.trackDifferences)
+		{
+			// Subscriptions not tracking differences are notified of every update
+			[self setNeedsUpdateHandling];
+		}
+
+		return;
+	}
+
+	@synchronized (_itemRefs)
+	{
+		if (![changeSet applyToItemReferences:_itemRefs])
+		{
+			// Out of sync with the source - fall back to full diff
+			OCLogWarning(@"Data Source Subscription could not apply change set %@ to %lu itemRefs - falling back to full update", changeSet, (unsigned long)_itemRefs.count);
+		}
+		else
+		{
+			if (self.trackDifferences)
+			{
+				// Deletion of previously added items -> drop any reference to item
+				for (OCDataItemReference itemRef in changeSet.deletedItemRefs)
+				{
+					if ([_addedItemRefs containsObject:itemRef])
+					{
+						[_addedItemRefs removeObject:itemRef];
+					}
+					else
+					{
+						[_removedItemRefs addObject:itemRef];
+					}
+
+					[_updatedItemRefs removeObject:itemRef];
+				}
+
+				// Insertion of previously removed items -> drop reference from removal, add to updates
+				for (OCDataItemReference itemRef in changeSet.insertedItemRefs)
+				{
+					if ([_removedItemRefs containsObject:itemRef])
+					{
+						[_removedItemRefs removeObject:itemRef];
+						[_updatedItemRefs addObject:itemRef];
+					}
+					else
+					{
+						[_addedItemRefs addObject:itemRef];
+					}
+				}
+
+				[_updatedItemRefs unionSet:changeSet.updatedItemRefs];
+
+				// Accumulate change sets - unless it'd be cheaper for consumers to process the items in full
+				if (_changeSets != nil)
+				{
+					_changeSetsChangeCount += changeSet.changeCount;
+
+					if (_changeSetsChangeCount > MAX(_itemRefs.count, OCDataSourceSubscriptionMinimumChangeSetsChangeCount))
+					{
+						_changeSets = nil;
+					}
+					else
+					{
+						[_changeSets addObject:changeSet];
+					}
+				}
+			}
+
+			changeSet = nil;
+		}
+	}
+
+	if (changeSet != nil)
+	{
+		[self _updateWithItemReferences:itemRefs updated:changeSet.updatedItemRefs];
+		return;
+	}
+
+	// Notify of changes
+	[self setNeedsUpdateHandling];
+}
+
 - (BOOL)isInterDataSourceSubscription
 {
 	return (_isInterDataSourceSubscription);
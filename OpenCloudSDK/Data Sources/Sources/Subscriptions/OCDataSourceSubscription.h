@@ -33,6 +33,9 @@ typedef void(^OCDataSourceSubscriptionUpdateHandler)(OCDataSourceSubscription *s
 	NSMutableSet<OCDataItemReference> *_updatedItemRefs;
 	NSMutableSet<OCDataItemReference> *_removedItemRefs;
 
+	NSMutableArray<OCDataSourceChangeSet *> *_changeSets; //!< Change sets since the last snapshot resetting change tracking. nil if not available.
+	NSUInteger _changeSetsChangeCount;
+
 	BOOL _needsUpdateHandling;
 
 	BOOL _isInterDataSourceSubscription;
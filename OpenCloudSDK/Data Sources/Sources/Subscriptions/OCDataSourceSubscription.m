@@ -57,6 +57,7 @@
 		[_addedItemRefs removeAllObjects];
 		[_updatedItemRefs removeAllObjects];
 		[_removedItemRefs removeAllObjects];
+		_changeSets = nil;
 
 		self.updateHandler = nil;
 	}
@@ -89,16 +90,22 @@
 			snapshot.addedItems = _addedItemRefs;
 			snapshot.updatedItems = _updatedItemRefs;
 			snapshot.removedItems = _removedItemRefs;
+			snapshot.changeSets = _changeSets;
 
 			_addedItemRefs = [NSMutableSet new];
 			_updatedItemRefs = [NSMutableSet new];
 			_removedItemRefs = [NSMutableSet new];
+
+			// The consumer of this snapshot is now in sync with _itemRefs, so changes can be tracked incrementally from here
+			_changeSets = _trackDifferences ? [NSMutableArray new] : nil;
+			_changeSetsChangeCount = 0;
 		}
 		else
 		{
 			snapshot.addedItems = [_addedItemRefs copy];
 			snapshot.updatedItems = [_updatedItemRefs copy];
 			snapshot.removedItems = [_removedItemRefs copy];
+			snapshot.changeSets = [_changeSets copy];
 		}
 
 		snapshot.specialItems = [_source.specialItems copy];
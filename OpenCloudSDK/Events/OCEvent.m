@@ -49,6 +49,7 @@
 #import "OCWaitCondition.h"
 #import "OCTUSJob.h"
 #import "OCTUSHeader.h"
+#import "OCRangedDownloadJob.h"
 #import "OCMessageChoice.h"
 #import "OCDAVRawResponse.h"
 #import "OCMessage.h"
@@ -120,6 +121,7 @@
 				OCTUSHeader.class,
 				OCTUSJob.class,
 				OCTUSJobSegment.class,
+				OCRangedDownloadJob.class,
 				OCMessage.class,
 				OCMessageChoice.class,
 				OCCoreUpdateScheduleRecord.class,
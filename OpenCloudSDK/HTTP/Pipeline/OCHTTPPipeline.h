@@ -148,6 +148,10 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Cerificate checks
 - (void)evaluateCertificate:(OCCertificate *)certificate forTask:(OCHTTPPipelineTask *)task proceedHandler:(OCConnectionCertificateProceedHandler)proceedHandler;
 
+@property(readonly) NSUInteger certificateEvaluationCacheHits; //!< Number of certificate evaluations answered from the certificate evaluation cache
+@property(readonly) NSUInteger certificateEvaluationCount; //!< Number of full certificate (trust) evaluations performed
+- (void)flushCertificateEvaluationCache; //!< Removes all cached certificate evaluation results
+
 #pragma mark - Background URL session finishing
 - (void)attachBackgroundURLSessionWithConfiguration:(NSURLSessionConfiguration *)backgroundSessionConfiguration handlingCompletionHandler:(dispatch_block_t)handlingCompletionHandler;
 
@@ -168,6 +172,7 @@ NS_ASSUME_NONNULL_BEGIN
 extern OCClassSettingsIdentifier OCClassSettingsIdentifierHTTP;
 extern OCClassSettingsKey OCHTTPPipelineSettingUserAgent;
 extern OCClassSettingsKey OCHTTPPipelineSettingTrafficLogFormat;
+extern OCClassSettingsKey OCHTTPPipelineSettingCertificateEvaluationCacheLimit;
 
 extern OCHTTPPipelineLogFormat OCHTTPPipelineLogFormatPlainText;
 extern OCHTTPPipelineLogFormat OCHTTPPipelineLogFormatJSON;
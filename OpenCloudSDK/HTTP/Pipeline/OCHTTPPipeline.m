@@ -37,6 +37,22 @@
 #import "OCHTTPRequest+Stream.h"
 #import "NSURLSessionTask+Debug.h"
 #import "NSURLSessionTaskMetrics+OCCompactSummary.h"
+#import "OCCache.h"
+#import "OCIPNotificationCenter.h"
+#import "OCBookmarkManager.h"
+
+#define OCHTTPPipelineCertificateEvaluationMaximumAge (60.0 * 60.0) // Re-evaluate cached certificate evaluation results at least once an hour, even if the certificate is valid for longer
+#define OCHTTPPipelineCertificateEvaluationUserAcceptedMaximumAge (60.0) // Re-evaluate cached results relying on user acceptance at least once a minute, as acceptance may be revoked by another process
+
+@interface OCHTTPPipelineCertificateEvaluation : NSObject
+
+@property(assign) OCCertificateValidationResult validationResult;
+@property(strong) NSDate *expirationDate;
+
+@end
+
+@implementation OCHTTPPipelineCertificateEvaluation
+@end
 
 @interface OCHTTPPipeline ()
 {
@@ -57,6 +73,11 @@
 	dispatch_group_t _busyGroup;
 
 	BOOL _observingCellularSwitchChanges;
+
+	OCCache<NSString *, OCHTTPPipelineCertificateEvaluation *> *_certificateEvaluationCache;
+	NSUInteger _certificateEvaluationCacheGeneration;
+	NSUInteger _certificateEvaluationCacheHits;
+	NSUInteger _certificateEvaluationCount;
 }
 
 - (void)queueBlock:(dispatch_block_t)block;
@@ -126,6 +147,8 @@
 		_partitionHandlersByID = [NSMapTable strongToWeakObjectsMapTable];
 		_recentlyScheduledGroupIDs = [NSMutableArray new];
 		_cachedCertificatesByHostnameAndPort = [NSMutableDictionary new];
+		_certificateEvaluationCache = [OCCache new];
+		_certificateEvaluationCache.countLimit = [[self classSettingForOCClassSettingsKey:OCHTTPPipelineSettingCertificateEvaluationCacheLimit] unsignedIntegerValue];
 		_taskIDsInDelivery = [NSMutableSet new];
 		_partitionEmptyHandlers = [NSMutableDictionary new];
 
@@ -161,11 +184,25 @@
 
 		// Prepare URL session creation
 		_sessionConfiguration = sessionConfiguration;
+
+		// Cached evaluation results of user-accepted certificates depend on the set of user-accepted certificates
+		[NSNotificationCenter.defaultCenter addObserver:self selector:@selector(_certificateUserAcceptanceDidChange:) name:OCCertificateUserAcceptanceDidChangeNotification object:nil];
+
+		// Certificate acceptance changes made by other processes arrive as bookmark changes
+		[OCIPNotificationCenter.sharedNotificationCenter addObserver:self forName:OCIPCNotificationNameBookmarkManagerListChanged withHandler:^(OCIPNotificationCenter * _Nonnull notificationCenter, OCHTTPPipeline *pipeline, OCIPCNotificationName  _Nonnull notificationName) {
+			[pipeline flushCertificateEvaluationCache];
+		}];
 	}
 
 	return (self);
 }
 
+- (void)dealloc
+{
+	[NSNotificationCenter.defaultCenter removeObserver:self name:OCCertificateUserAcceptanceDidChangeNotification object:nil];
+	[OCIPNotificationCenter.sharedNotificationCenter removeObserver:self forName:OCIPCNotificationNameBookmarkManagerListChanged];
+}
+
 - (void)startWithCompletionHandler:(OCCompletionHandler)completionHandler
 {
 	@synchronized(self)
@@ -2285,7 +2322,7 @@
 		return;
 	}
 
-	[certificate evaluateWithCompletionHandler:^(OCCertificate *certificate, OCCertificateValidationResult validationResult, NSError *validationError) {
+	[self _evaluateCertificate:certificate withCompletionHandler:^(OCCertificate *certificate, OCCertificateValidationResult validationResult, NSError *validationError) {
 		[self queueBlock:^{
 			OCHTTPResponse *response = [task responseFromURLSessionTask:nil];
 
@@ -2343,6 +2380,106 @@
 	}];
 }
 
+#pragma mark - Certificate evaluation cache
+@synthesize certificateEvaluationCacheHits = _certificateEvaluationCacheHits;
+@synthesize certificateEvaluationCount = _certificateEvaluationCount;
+
+- (NSString *)_certificateEvaluationCacheKeyForCertificate:(OCCertificate *)certificate
+{
+	NSString *sha256Fingerprint;
+
+	if ((certificate.hostName != nil) && ((sha256Fingerprint = [certificate.sha256Fingerprint asHexStringWithSeparator:@""]) != nil))
+	{
+		return ([NSString stringWithFormat:@"%@:%@", certificate.hostName.lowercaseString, sha256Fingerprint]);
+	}
+
+	return (nil);
+}
+
+- (void)_evaluateCertificate:(OCCertificate *)certificate withCompletionHandler:(void(^)(OCCertificate *certificate, OCCertificateValidationResult validationResult, NSError *validationError))completionHandler
+{
+	NSString *cacheKey = (_certificateEvaluationCache.countLimit > 0) ? [self _certificateEvaluationCacheKeyForCertificate:certificate] : nil;
+	OCHTTPPipelineCertificateEvaluation *cachedEvaluation = nil;
+	NSUInteger cacheGeneration = 0;
+
+	@synchronized(_certificateEvaluationCache)
+	{
+		if (cacheKey != nil)
+		{
+			if ((cachedEvaluation = [_certificateEvaluationCache objectForKey:cacheKey]) != nil)
+			{
+				if (cachedEvaluation.expirationDate.timeIntervalSinceNow <= 0)
+				{
+					// Expired
+					[_certificateEvaluationCache removeObjectForKey:cacheKey];
+					cachedEvaluation = nil;
+				}
+				else
+				{
+					_certificateEvaluationCacheHits++;
+				}
+			}
+		}
+
+		cacheGeneration = _certificateEvaluationCacheGeneration;
+	}
+
+	if (cachedEvaluation != nil)
+	{
+		// Use cached result
+		OCLogDebug(@"Using cached certificate evaluation result %lu for %@", (unsigned long)cachedEvaluation.validationResult, OCLogPrivate(certificate.hostName));
+		completionHandler(certificate, cachedEvaluation.validationResult, nil);
+		return;
+	}
+
+	[certificate evaluateWithCompletionHandler:^(OCCertificate *certificate, OCCertificateValidationResult validationResult, NSError *validationError) {
+		@synchronized(self->_certificateEvaluationCache)
+		{
+			self->_certificateEvaluationCount++;
+
+			// Cache definite results only - and only if no change to user-accepted certificates happened during evaluation
+			if ((cacheKey != nil) && (validationError == nil) &&
+			    (validationResult != OCCertificateValidationResultNone) && (validationResult != OCCertificateValidationResultError) &&
+			    (cacheGeneration == self->_certificateEvaluationCacheGeneration))
+			{
+				NSDate *expirationDate = [NSDate dateWithTimeIntervalSinceNow:((validationResult == OCCertificateValidationResultUserAccepted) ? OCHTTPPipelineCertificateEvaluationUserAcceptedMaximumAge : OCHTTPPipelineCertificateEvaluationMaximumAge)];
+				NSDate *validUntilDate;
+
+				if (((validUntilDate = certificate.validUntilDate) != nil) && ([validUntilDate compare:expirationDate] == NSOrderedAscending))
+				{
+					expirationDate = validUntilDate;
+				}
+
+				if (expirationDate.timeIntervalSinceNow > 0)
+				{
+					OCHTTPPipelineCertificateEvaluation *evaluation = [OCHTTPPipelineCertificateEvaluation new];
+
+					evaluation.validationResult = validationResult;
+					evaluation.expirationDate = expirationDate;
+
+					[self->_certificateEvaluationCache setObject:evaluation forKey:cacheKey];
+				}
+			}
+		}
+
+		completionHandler(certificate, validationResult, validationError);
+	}];
+}
+
+- (void)flushCertificateEvaluationCache
+{
+	@synchronized(_certificateEvaluationCache)
+	{
+		_certificateEvaluationCacheGeneration++;
+		[_certificateEvaluationCache clearCache];
+	}
+}
+
+- (void)_certificateUserAcceptanceDidChange:(NSNotification *)notification
+{
+	[self flushCertificateEvaluationCache];
+}
+
 + (void)_iteratePolicyHandlers:(NSArray<id<OCHTTPPipelinePolicyHandler>> *)policyHandlers index:(NSUInteger)index pipeline:(OCHTTPPipeline *)pipeline certificate:(OCCertificate *)certificate validationResult:(OCCertificateValidationResult)validationResult validationError:(NSError *)validationError task:(OCHTTPPipelineTask *)task  proceedHandler:(OCConnectionCertificateProceedHandler)proceedHandler
 {
 	id<OCHTTPPipelinePolicyHandler> policyHandler = policyHandlers[index];
@@ -2759,7 +2896,8 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCHTTPPipeline)
 {
 	return (@{
 		OCHTTPPipelineSettingUserAgent : @"OpenCloudApp/{{app.version}} ({{app.part}}/{{app.build}}; {{os.name}}/{{os.version}}; {{device.model}})",
-		OCHTTPPipelineSettingTrafficLogFormat : OCHTTPPipelineLogFormatJSON
+		OCHTTPPipelineSettingTrafficLogFormat : OCHTTPPipelineLogFormatJSON,
+		OCHTTPPipelineSettingCertificateEvaluationCacheLimit : @(32)
 	});
 }
 
@@ -2783,6 +2921,13 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCHTTPPipeline)
 				OCHTTPPipelineLogFormatPlainText : @"Plain text",
 				OCHTTPPipelineLogFormatJSON	 : @"JSON"
 			}
+		},
+
+		OCHTTPPipelineSettingCertificateEvaluationCacheLimit : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Maximum number of certificate evaluation results (by host and certificate fingerprint) to keep in memory. Cached results are reused until the certificate expires, the user-accepted certificates change or one hour passed. A value of 0 disables caching.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Security",
 		}
 	});
 }
@@ -2859,6 +3004,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCHTTPPipeline)
 OCClassSettingsIdentifier OCClassSettingsIdentifierHTTP = @"http";
 OCClassSettingsKey OCHTTPPipelineSettingUserAgent = @"user-agent";
 OCClassSettingsKey OCHTTPPipelineSettingTrafficLogFormat = @"traffic-log-format";
+OCClassSettingsKey OCHTTPPipelineSettingCertificateEvaluationCacheLimit = @"certificate-evaluation-cache-limit";
 
 OCHTTPPipelineLogFormat OCHTTPPipelineLogFormatPlainText = @"plain";
 OCHTTPPipelineLogFormat OCHTTPPipelineLogFormatJSON = @"json";
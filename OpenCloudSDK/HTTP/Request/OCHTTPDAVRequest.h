@@ -30,6 +30,8 @@ typedef NS_ENUM(NSInteger, OCPropfindDepth) {
 	OCPropfindDepthItemAndImmediateChildren
 };
 
+typedef NSDictionary<OCFileID, OCItem *> * _Nullable (^OCHTTPDAVRequestKnownItemsProvider)(void);
+
 @interface OCHTTPDAVRequest : OCHTTPRequest <NSXMLParserDelegate>
 {
 	// Parsing variables
@@ -45,6 +47,8 @@ typedef NS_ENUM(NSInteger, OCPropfindDepth) {
 
 @property(strong) OCXMLNode *xmlRequest;
 
+@property(copy) OCHTTPDAVRequestKnownItemsProvider ephermalKnownItemsProvider; //!< Provides the locally known items (by fileID) to compare the response against when parsing it. Ephermal [not serialized].
+
 + (instancetype)propfindRequestWithURL:(NSURL *)url depth:(OCPropfindDepth)depth;
 + (instancetype)proppatchRequestWithURL:(NSURL *)url content:(NSArray <OCXMLNode *> *)contentNodes;
 + (instancetype)reportRequestWithURL:(NSURL *)url rootElementName:(NSString *)rootElementName content:(NSArray <OCXMLNode *> *)contentNodes;
@@ -52,6 +56,7 @@ typedef NS_ENUM(NSInteger, OCPropfindDepth) {
 - (OCXMLNode *)xmlRequestPropAttribute;
 
 - (NSArray <OCItem *> *)responseItemsForBasePath:(NSString *)basePath drives:(NSArray<OCDrive *> *)drives reuseUsersByID:(NSMutableDictionary<NSString *,OCUser *> *)usersByUserID driveID:(OCDriveID)driveID withErrors:(NSArray <NSError *> **)errors;
+- (NSArray <OCItem *> *)responseItemsForBasePath:(NSString *)basePath drives:(NSArray<OCDrive *> *)drives reuseUsersByID:(NSMutableDictionary<NSString *,OCUser *> *)usersByUserID driveID:(OCDriveID)driveID knownItemsByFileID:(NSDictionary<OCFileID, OCItem *> *)knownItemsByFileID withErrors:(NSArray <NSError *> **)errors; //!< Returns the instances from knownItemsByFileID for responses describing them unchanged, so that OCItems only need to be built from XML for new and changed items
 - (NSDictionary <OCPath, OCHTTPDAVMultistatusResponse *> *)multistatusResponsesForBasePath:(NSString *)basePath;
 
 @end
@@ -19,6 +19,7 @@
 #import "OCHTTPDAVRequest.h"
 #import "OCItem.h"
 #import "OCXMLParser.h"
+#import "OCXMLItemScanner.h"
 #import "OCLogger.h"
 #import "OCHTTPDAVMultistatusResponse.h"
 
@@ -92,6 +93,11 @@
 }
 
 - (NSArray <OCItem *> *)responseItemsForBasePath:(NSString *)basePath drives:(NSArray<OCDrive *> *)drives reuseUsersByID:(NSMutableDictionary<NSString *,OCUser *> *)usersByUserID driveID:(nullable OCDriveID)driveID withErrors:(NSArray <NSError *> **)errors
+{
+	return ([self responseItemsForBasePath:basePath drives:drives reuseUsersByID:usersByUserID driveID:driveID knownItemsByFileID:nil withErrors:errors]);
+}
+
+- (NSArray <OCItem *> *)responseItemsForBasePath:(NSString *)basePath drives:(NSArray<OCDrive *> *)drives reuseUsersByID:(NSMutableDictionary<NSString *,OCUser *> *)usersByUserID driveID:(nullable OCDriveID)driveID knownItemsByFileID:(NSDictionary<OCFileID, OCItem *> *)knownItemsByFileID withErrors:(NSArray <NSError *> **)errors
 {
 	NSArray <OCItem *> *responseItems = nil;
 	NSData *responseData = self.httpResponse.bodyData;
@@ -103,66 +109,133 @@
 			responseItems = _parseResultItems;
 		}
 
-		if (responseItems == nil)
+		if ((responseItems == nil) && (knownItemsByFileID.count > 0) && (drives == nil))
 		{
-			OCXMLParser *parser;
+			// Fast path: determine which responses describe unchanged known items, which can then be returned
+			// instead of building OCItems from XML - so that only new and changed items need to be fully parsed
+			OCXMLItemScanner *scanner;
 
-			if ((parser = [[OCXMLParser alloc] initWithData:responseData]) != nil)
+			if (((scanner = [[OCXMLItemScanner alloc] initWithData:responseData basePath:basePath knownItemsByFileID:knownItemsByFileID]) != nil) && [scanner scan])
 			{
-				if (basePath != nil)
+				NSIndexSet *changedResponseIndexes = scanner.changedResponseIndexes;
+				NSArray<OCItem *> *changedItems = nil;
+
+				if (changedResponseIndexes.count > 0)
 				{
-					NSMutableDictionary<NSString *,id> *options = [NSMutableDictionary new];
-					NSMutableDictionary<NSString *, OCDriveID> *drivePrefixMap = nil;
+					__block NSUInteger responseIndex = 0;
 
-					if (drives != nil)
-					{
-						drivePrefixMap = [NSMutableDictionary new];
-						for (OCDrive *drive in drives)
+					changedItems = [self _parseResponseItemsForBasePath:basePath drives:drives reuseUsersByID:usersByUserID objectCreationFilter:^BOOL(OCXMLParser *parser, NSString *elementName) {
+						if ([elementName isEqualToString:@"d:response"])
 						{
-							if (drive.specialType != nil)
-							{
-								NSString *drivePrefixPath = [[NSString alloc] initWithFormat:@"/%@/", drive.identifier];
-								drivePrefixMap[drivePrefixPath] = drive.identifier;
-							}
+							return ([changedResponseIndexes containsIndex:responseIndex++]);
 						}
-					}
 
-					options[@"basePath"] = basePath;
-					options[@"usersByUserID"] = usersByUserID;
-					options[@"drivePrefixMap"] = drivePrefixMap;
-
-					parser.options = options;
+						return (YES);
+					} withErrors:errors];
 				}
 
-				[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
-
-				if ([parser parse])
+				if ((changedResponseIndexes.count == 0) || (changedItems.count == changedResponseIndexes.count))
 				{
-					// OCLogDebug(@"Parsed objects: %@", parser.parsedObjects);
+					NSMutableArray<OCItem *> *mergedItems = [[NSMutableArray alloc] initWithCapacity:scanner.responseCount];
+					NSUInteger changedItemIndex = 0;
 
-					@synchronized(self)
+					// Merge known and changed items in the order of the response
+					for (NSUInteger responseIndex=0; responseIndex < scanner.responseCount; responseIndex++)
 					{
-						responseItems = _parseResultItems = parser.parsedObjects;
+						OCItem *item;
 
-						if (driveID != nil)
+						if ((item = [scanner knownItemForResponseAtIndex:responseIndex]) == nil)
 						{
-							for (OCItem *item in responseItems)
-							{
-								item.driveID = driveID;
-							}
+							item = changedItems[changedItemIndex++];
 						}
+
+						[mergedItems addObject:item];
+					}
+
+					responseItems = mergedItems;
+
+					@synchronized(self)
+					{
+						_parseResultItems = mergedItems;
 					}
 				}
+			}
+		}
+
+		if (responseItems == nil)
+		{
+			responseItems = [self _parseResponseItemsForBasePath:basePath drives:drives reuseUsersByID:usersByUserID objectCreationFilter:nil withErrors:errors];
+
+			if (responseItems != nil)
+			{
+				@synchronized(self)
+				{
+					_parseResultItems = (NSMutableArray<OCItem *> *)responseItems;
+				}
+			}
+		}
+
+		if ((responseItems != nil) && (driveID != nil))
+		{
+			for (OCItem *item in responseItems)
+			{
+				item.driveID = driveID;
+			}
+		}
+	}
+
+	return (responseItems);
+}
+
+- (NSArray <OCItem *> *)_parseResponseItemsForBasePath:(NSString *)basePath drives:(NSArray<OCDrive *> *)drives reuseUsersByID:(NSMutableDictionary<NSString *,OCUser *> *)usersByUserID objectCreationFilter:(OCXMLParserObjectCreationFilter)objectCreationFilter withErrors:(NSArray <NSError *> **)errors
+{
+	NSArray <OCItem *> *responseItems = nil;
+	OCXMLParser *parser;
 
-				if (parser.errors.count > 0)
+	if ((parser = [[OCXMLParser alloc] initWithData:self.httpResponse.bodyData]) != nil)
+	{
+		if (basePath != nil)
+		{
+			NSMutableDictionary<NSString *,id> *options = [NSMutableDictionary new];
+			NSMutableDictionary<NSString *, OCDriveID> *drivePrefixMap = nil;
+
+			if (drives != nil)
+			{
+				drivePrefixMap = [NSMutableDictionary new];
+				for (OCDrive *drive in drives)
 				{
-					OCLogDebug(@"DAV Error(s): %@", parser.errors);
-					if (errors != NULL)
+					if (drive.specialType != nil)
 					{
-						*errors = parser.errors;
+						NSString *drivePrefixPath = [[NSString alloc] initWithFormat:@"/%@/", drive.identifier];
+						drivePrefixMap[drivePrefixPath] = drive.identifier;
 					}
 				}
 			}
+
+			options[@"basePath"] = basePath;
+			options[@"usersByUserID"] = usersByUserID;
+			options[@"drivePrefixMap"] = drivePrefixMap;
+
+			parser.options = options;
+		}
+
+		parser.objectCreationFilter = objectCreationFilter;
+
+		[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+		if ([parser parse])
+		{
+			// OCLogDebug(@"Parsed objects: %@", parser.parsedObjects);
+			responseItems = parser.parsedObjects;
+		}
+
+		if (parser.errors.count > 0)
+		{
+			OCLogDebug(@"DAV Error(s): %@", parser.errors);
+			if (errors != NULL)
+			{
+				*errors = parser.errors;
+			}
 		}
 	}
 
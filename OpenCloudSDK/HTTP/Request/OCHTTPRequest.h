@@ -97,6 +97,9 @@ typedef NSDictionary<OCHTTPRequestResumeInfoKey,id>* OCHTTPRequestResumeInfo;
 
 @property(strong) OCCellularSwitchIdentifier requiredCellularSwitch; //!< Switch that needs to be allowed before scheduling this request. This may change the order in which requests are sent - unless a groupID is set.
 
+@property(strong) NSDate *authenticationHoldBackDate; //!< Date the request was first held back waiting for authentication to become available (f.ex. during a token refresh). [not serialized]
+@property(assign) NSTimeInterval authenticationStallTime; //!< Number of seconds the request was held back waiting for authentication to become available. [not serialized]
+
 @property(assign) BOOL autoResume;				//!< For GET requests, try to automatically resume transfer if connection is cut off
 @property(strong) OCHTTPRequestResumeInfo autoResumeInfo;	//!< Resume information for auto resume
 
@@ -198,6 +201,9 @@ extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameOverwrite;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNamePrefer;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfMatch;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfNoneMatch;
+extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfRange;
+extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameRange;
+extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameContentRange;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameUserAgent;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameXOCMTime;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameOCChecksum;
@@ -755,6 +755,9 @@ OCHTTPHeaderFieldName OCHTTPHeaderFieldNameOverwrite = @"Overwrite";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNamePrefer = @"Prefer";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfMatch = @"If-Match";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfNoneMatch = @"If-None-Match";
+OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfRange = @"If-Range";
+OCHTTPHeaderFieldName OCHTTPHeaderFieldNameRange = @"Range";
+OCHTTPHeaderFieldName OCHTTPHeaderFieldNameContentRange = @"Content-Range";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameUserAgent = @"User-Agent";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameXOCMTime = @"X-OC-MTime";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameOCChecksum = @"OC-Checksum";
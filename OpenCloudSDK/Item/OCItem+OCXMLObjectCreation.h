@@ -18,7 +18,10 @@
 
 #import "OCItem.h"
 #import "OCXMLParser.h"
+#import "OCXMLParserNode.h"
 
 @interface OCItem (OCXMLObjectCreation) <OCXMLObjectCreation>
 
++ (OCXMLParserNodeKeyValueEnumeratorDictionary)sharedKeyValueEnumeratorDict; //!< Blocks applying the values of the d:prop elements in a PROPFIND response to an OCItem, by element name
+
 @end
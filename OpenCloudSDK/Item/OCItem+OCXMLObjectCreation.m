@@ -24,7 +24,7 @@
 
 @implementation OCItem (OCXMLObjectCreation)
 
-+ (OCXMLParserNodeKeyValueEnumeratorDictionary)_sharedKeyValueEnumeratorDict
++ (OCXMLParserNodeKeyValueEnumeratorDictionary)sharedKeyValueEnumeratorDict
 {
 	static OCXMLParserNodeKeyValueEnumeratorDictionary sharedKeyValueEnumeratorDict;
 	static dispatch_once_t onceToken;
@@ -331,11 +331,11 @@
 							item.type = isCollection ? OCItemTypeCollection : OCItemTypeFile;
 
 							[propNode enumerateChildNodesWithName:@"oc:share-types" usingBlock:^(OCXMLParserNode *shareTypesNode) {
-								[shareTypesNode enumerateKeyValuesForTarget:item withBlockForKeys:[[self class] _sharedKeyValueEnumeratorDict]];
+								[shareTypesNode enumerateKeyValuesForTarget:item withBlockForKeys:[[self class] sharedKeyValueEnumeratorDict]];
 							}];
 
 							[propNode enumerateChildNodesWithName:@"oc:checksums" usingBlock:^(OCXMLParserNode *shareTypesNode) {
-								[shareTypesNode enumerateKeyValuesForTarget:item withBlockForKeys:[[self class] _sharedKeyValueEnumeratorDict]];
+								[shareTypesNode enumerateKeyValuesForTarget:item withBlockForKeys:[[self class] sharedKeyValueEnumeratorDict]];
 							}];
 
 							// Share OCUser instances for owner
@@ -379,7 +379,7 @@
 							item.owner = owner;
 
 							// Parse remaining key-values
-							[propNode enumerateKeyValuesForTarget:item withBlockForKeys:[[self class] _sharedKeyValueEnumeratorDict]];
+							[propNode enumerateKeyValuesForTarget:item withBlockForKeys:[[self class] sharedKeyValueEnumeratorDict]];
 						}];
 					}
 				}
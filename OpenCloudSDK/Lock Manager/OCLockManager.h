@@ -19,17 +19,23 @@
 #import <Foundation/Foundation.h>
 #import "OCLock.h"
 #import "OCKeyValueStore.h"
+#import "OCClassSettings.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+typedef NSString* OCLockManagerBackend NS_TYPED_ENUM;
+
 @class OCLockRequest;
 
-@interface OCLockManager : NSObject
+@interface OCLockManager : NSObject <OCClassSettingsSupport>
 
 @property(class,nonatomic,readonly,strong) OCLockManager *sharedLockManager;
 
+@property(readonly,strong,nonatomic) OCLockManagerBackend backend;
+
 #pragma mark - Individual instances
-- (instancetype)initWithKeyValueStore:(OCKeyValueStore *)keyValueStore;
+- (instancetype)initWithKeyValueStore:(OCKeyValueStore *)keyValueStore; //!< Coordinates locks through an OCLockDatabase stored in keyValueStore. Locks expire unless kept alive.
+- (instancetype)initWithLockDirectoryURL:(NSURL *)lockDirectoryURL; //!< Coordinates locks through advisory file locks (flock) on one lock file per resource in lockDirectoryURL. Locks are released by the kernel when their process ends, so they don't expire.
 
 #pragma mark - Locking
 - (void)requestLock:(OCLockRequest *)lockRequest; //!< Requests a lock, allowing to coordinate changes across processes.
@@ -39,4 +45,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 extern OCKeyValueStoreKey OCKeyValueStoreKeyManagedLocks;
 
+extern OCLockManagerBackend OCLockManagerBackendKeyValueStore;
+extern OCLockManagerBackend OCLockManagerBackendFileLock;
+
+extern OCClassSettingsIdentifier OCClassSettingsIdentifierLockManager;
+extern OCClassSettingsKey OCClassSettingsKeyLockManagerBackend;
+
 NS_ASSUME_NONNULL_END
@@ -20,6 +20,7 @@
 #import "OCLockRequest.h"
 #import "OCAppIdentity.h"
 #import "NSError+OCError.h"
+#import <sys/file.h>
 
 #pragma mark - Database helper
 
@@ -77,9 +78,22 @@
 	BOOL _needsUpdate;
 
 	BOOL _keepAliveScheduled;
+
+	// File lock backend
+	NSURL *_lockDirectoryURL;
+	NSMutableDictionary<OCLockIdentifier, NSNumber *> *_fileDescriptorByLockIdentifier; //!< File descriptors holding the file lock of acquired locks
+	NSMutableDictionary<OCLockResourceIdentifier, NSNumber *> *_waitedFileDescriptorByResourceIdentifier; //!< File descriptors holding a file lock acquired by a waiter, but not yet handed to a request
+	NSMutableSet<OCLockResourceIdentifier> *_waitingResourceIdentifiers; //!< Resources for which a waiter is blocked in flock()
+	dispatch_queue_t _lockWaitQueue;
 }
 @end
 
+static void OCLockManagerUnlockFile(int fileDescriptor)
+{
+	flock(fileDescriptor, LOCK_UN);
+	close(fileDescriptor);
+}
+
 @implementation OCLockManager
 
 + (OCLockManager *)sharedLockManager
@@ -88,9 +102,16 @@
 	static OCLockManager *sharedLockManager = nil;
 
 	dispatch_once(&onceToken, ^{
-		NSURL *lockStoreURL;
+		NSURL *lockStoreURL, *lockDirectoryURL;
 		OCKeyValueStore *keyValueStore = nil;
 
+		if ([[self classSettingForOCClassSettingsKey:OCClassSettingsKeyLockManagerBackend] isEqual:OCLockManagerBackendFileLock] &&
+		    ((lockDirectoryURL = [OCAppIdentity.sharedAppIdentity.appGroupContainerURL URLByAppendingPathComponent:@"locks"]) != nil))
+		{
+			sharedLockManager = [[OCLockManager alloc] initWithLockDirectoryURL:lockDirectoryURL];
+			return;
+		}
+
 		if ((lockStoreURL = [OCAppIdentity.sharedAppIdentity.appGroupContainerURL URLByAppendingPathComponent:@"lockManager.db"]) != nil)
 		{
 			keyValueStore = [[OCKeyValueStore alloc] initWithURL:lockStoreURL identifier:@"OCLockManager"];
@@ -102,7 +123,7 @@
 	return (sharedLockManager);
 }
 
-- (instancetype)initWithKeyValueStore:(OCKeyValueStore *)keyValueStore
+- (instancetype)_init
 {
 	if ((self = [super init]) != nil)
 	{
@@ -113,6 +134,16 @@
 		_releasedLockIdentifiers = [NSMutableArray new];
 
 		_lockQueue = dispatch_queue_create("OCLockManager serial queue", DISPATCH_QUEUE_SERIAL_WITH_AUTORELEASE_POOL);
+	}
+
+	return (self);
+}
+
+- (instancetype)initWithKeyValueStore:(OCKeyValueStore *)keyValueStore
+{
+	if ((self = [self _init]) != nil)
+	{
+		_backend = OCLockManagerBackendKeyValueStore;
 
 		// Set up KVS
 		_keyValueStore = keyValueStore;
@@ -129,9 +160,46 @@
 	return (self);
 }
 
+- (instancetype)initWithLockDirectoryURL:(NSURL *)lockDirectoryURL
+{
+	if ((self = [self _init]) != nil)
+	{
+		NSError *error = nil;
+
+		_backend = OCLockManagerBackendFileLock;
+
+		_lockDirectoryURL = lockDirectoryURL;
+
+		_fileDescriptorByLockIdentifier = [NSMutableDictionary new];
+		_waitedFileDescriptorByResourceIdentifier = [NSMutableDictionary new];
+		_waitingResourceIdentifiers = [NSMutableSet new];
+
+		// Waiters block in flock() until the kernel hands them the lock, so they need their own threads
+		_lockWaitQueue = dispatch_queue_create("OCLockManager wait queue", DISPATCH_QUEUE_CONCURRENT_WITH_AUTORELEASE_POOL);
+
+		if (![NSFileManager.defaultManager createDirectoryAtURL:_lockDirectoryURL withIntermediateDirectories:YES attributes:nil error:&error])
+		{
+			OCLogError(@"Error creating lock directory %@: %@", _lockDirectoryURL, error);
+		}
+	}
+
+	return (self);
+}
+
 - (void)dealloc
 {
 	OCLogDebug(@"Dealloc %@", self);
+
+	// Release file locks still held by this lock manager
+	for (NSNumber *fileDescriptor in _fileDescriptorByLockIdentifier.allValues)
+	{
+		OCLockManagerUnlockFile(fileDescriptor.intValue);
+	}
+
+	for (NSNumber *fileDescriptor in _waitedFileDescriptorByResourceIdentifier.allValues)
+	{
+		OCLockManagerUnlockFile(fileDescriptor.intValue);
+	}
 }
 
 - (void)requestLock:(OCLockRequest *)lockRequest
@@ -194,6 +262,12 @@
 
 - (void)_updateLocks
 {
+	if (_lockDirectoryURL != nil)
+	{
+		[self _updateFileLocks];
+		return;
+	}
+
 	__block NSMutableArray<OCLockRequest *> *processedRequests = nil;
 	__block NSDate *nextRelevantExpirationDate = nil;
 	NSMutableArray<OCLockIdentifier> *invalidatedLockIdentifiers = nil;
@@ -336,47 +410,7 @@
 	}];
 
 	// Process request results
-	if (processedRequests.count > 0)
-	{
-		// Remove from requests
-		@synchronized (_requests)
-		{
-			[_requests removeObjectsInArray:processedRequests];
-		}
-
-		// Track lock
-		@synchronized (_locks)
-		{
-			for (OCLockRequest *request in processedRequests)
-			{
-				if (request.lock != nil)
-				{
-					[_locks addObject:request.lock];
-					[_lockIdentifiers addObject:request.lock.identifier];
-				}
-			}
-		}
-
-		// Notify requesters
-		for (OCLockRequest *request in processedRequests)
-		{
-			if (request.acquiredHandler != nil)
-			{
-				if (request.lock != nil)
-				{
-					// Notify with lock
-					request.acquiredHandler(nil, request.lock);
-				}
-				else if (request.invalidated)
-				{
-					// Notify about invalidation
-					request.acquiredHandler(OCError(OCErrorLockInvalidated), nil);
-				}
-
-				request.acquiredHandler = nil;
-			}
-		}
-	}
+	[self _processRequests:processedRequests];
 
 	// Invalidated locks
 	BOOL hasLocks = NO;
@@ -468,6 +502,279 @@
 	}
 }
 
+- (void)_processRequests:(NSArray<OCLockRequest *> *)processedRequests
+{
+	if (processedRequests.count > 0)
+	{
+		// Remove from requests
+		@synchronized (_requests)
+		{
+			[_requests removeObjectsInArray:processedRequests];
+		}
+
+		// Track lock
+		@synchronized (_locks)
+		{
+			for (OCLockRequest *request in processedRequests)
+			{
+				if (request.lock != nil)
+				{
+					[_locks addObject:request.lock];
+					[_lockIdentifiers addObject:request.lock.identifier];
+				}
+			}
+		}
+
+		// Notify requesters
+		for (OCLockRequest *request in processedRequests)
+		{
+			if (request.acquiredHandler != nil)
+			{
+				if (request.lock != nil)
+				{
+					// Notify with lock
+					request.acquiredHandler(nil, request.lock);
+				}
+				else if (request.invalidated)
+				{
+					// Notify about invalidation
+					request.acquiredHandler(OCError(OCErrorLockInvalidated), nil);
+				}
+
+				request.acquiredHandler = nil;
+			}
+		}
+	}
+}
+
+#pragma mark - File lock backend
+- (NSString *)_lockFilePathForResourceIdentifier:(OCLockResourceIdentifier)resourceIdentifier
+{
+	// Resource identifiers can contain characters that aren't safe for use in file names
+	NSString *fileName = [[resourceIdentifier dataUsingEncoding:NSUTF8StringEncoding] base64EncodedStringWithOptions:0];
+
+	fileName = [[fileName stringByReplacingOccurrencesOfString:@"/" withString:@"_"] stringByReplacingOccurrencesOfString:@"+" withString:@"-"];
+
+	return ([_lockDirectoryURL URLByAppendingPathComponent:[fileName stringByAppendingPathExtension:@"lock"]].path);
+}
+
+- (int)_openLockFileForResourceIdentifier:(OCLockResourceIdentifier)resourceIdentifier
+{
+	int fileDescriptor;
+
+	// Lock files are never removed, as removing them would race with other processes opening them
+	if ((fileDescriptor = open([self _lockFilePathForResourceIdentifier:resourceIdentifier].fileSystemRepresentation, O_RDWR|O_CREAT|O_CLOEXEC, S_IRUSR|S_IWUSR)) == -1)
+	{
+		OCLogError(@"Error opening lock file for %@: %@", resourceIdentifier, [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil]);
+	}
+
+	return (fileDescriptor);
+}
+
+- (void)_waitForFileLockOfResourceIdentifier:(OCLockResourceIdentifier)resourceIdentifier
+{
+	int fileDescriptor;
+
+	if ((fileDescriptor = [self _openLockFileForResourceIdentifier:resourceIdentifier]) == -1)
+	{
+		return;
+	}
+
+	[_waitingResourceIdentifiers addObject:resourceIdentifier];
+
+	dispatch_async(_lockWaitQueue, ^{
+		int result;
+
+		// Blocks until the lock is released by its holder - or the kernel releases it because the holding process ended
+		while (((result = flock(fileDescriptor, LOCK_EX)) != 0) && (errno == EINTR)) {};
+
+		dispatch_async(self->_lockQueue, ^{
+			[self->_waitingResourceIdentifiers removeObject:resourceIdentifier];
+
+			if (result == 0)
+			{
+				self->_waitedFileDescriptorByResourceIdentifier[resourceIdentifier] = @(fileDescriptor);
+			}
+			else
+			{
+				close(fileDescriptor);
+			}
+
+			[self _updateLocks];
+		});
+	});
+}
+
+- (void)_updateFileLocks
+{
+	NSMutableArray<OCLockRequest *> *processedRequests = nil;
+	NSMutableArray<OCLockIdentifier> *releasedLockIdentifiers = nil;
+
+	// Release locks
+	@synchronized(_locks)
+	{
+		if (_releasedLockIdentifiers.count > 0)
+		{
+			releasedLockIdentifiers = _releasedLockIdentifiers;
+			_releasedLockIdentifiers = [NSMutableArray new];
+		}
+	}
+
+	for (OCLockIdentifier lockIdentifier in releasedLockIdentifiers)
+	{
+		NSNumber *fileDescriptor;
+
+		if ((fileDescriptor = _fileDescriptorByLockIdentifier[lockIdentifier]) != nil)
+		{
+			OCLockManagerUnlockFile(fileDescriptor.intValue);
+			[_fileDescriptorByLockIdentifier removeObjectForKey:lockIdentifier];
+		}
+	}
+
+	// Fulfill requests
+	@synchronized(_requests)
+	{
+		for (OCLockRequest *request in _requests)
+		{
+			OCLockResourceIdentifier resourceIdentifier = request.resourceIdentifier;
+			NSNumber *waitedFileDescriptor;
+			int fileDescriptor = -1;
+
+			if (request.invalidated)
+			{
+				// Request processed, schedule for removal
+				if (processedRequests == nil) { processedRequests = [NSMutableArray new]; }
+				[processedRequests addObject:request];
+				continue;
+			}
+
+			if ([_waitingResourceIdentifiers containsObject:resourceIdentifier])
+			{
+				// A waiter is already blocked on this resource and will trigger an update once it has the lock
+				continue;
+			}
+
+			if ((waitedFileDescriptor = _waitedFileDescriptorByResourceIdentifier[resourceIdentifier]) != nil)
+			{
+				// Use lock acquired by a waiter
+				fileDescriptor = waitedFileDescriptor.intValue;
+				[_waitedFileDescriptorByResourceIdentifier removeObjectForKey:resourceIdentifier];
+			}
+			else if ((fileDescriptor = [self _openLockFileForResourceIdentifier:resourceIdentifier]) != -1)
+			{
+				// Try to acquire lock without blocking
+				if (flock(fileDescriptor, LOCK_EX|LOCK_NB) != 0)
+				{
+					int lockErrno = errno;
+
+					close(fileDescriptor);
+					fileDescriptor = -1;
+
+					if (lockErrno != EWOULDBLOCK)
+					{
+						OCLogError(@"Error locking file for %@: %@", resourceIdentifier, [NSError errorWithDomain:NSPOSIXErrorDomain code:lockErrno userInfo:nil]);
+						[request invalidate];
+					}
+				}
+			}
+			else
+			{
+				[request invalidate];
+			}
+
+			if (fileDescriptor == -1)
+			{
+				// Lock can't be acquired at this time
+				if (request.returnAfterFirstAttempt)
+				{
+					[request invalidate];
+				}
+
+				if (request.invalidated)
+				{
+					// Schedule request for removal
+					if (processedRequests == nil) { processedRequests = [NSMutableArray new]; }
+					[processedRequests addObject:request];
+				}
+				else
+				{
+					[self _waitForFileLockOfResourceIdentifier:resourceIdentifier];
+				}
+
+				continue;
+			}
+
+			// Schedule request for notification and removal
+			if (processedRequests == nil) { processedRequests = [NSMutableArray new]; }
+			[processedRequests addObject:request];
+
+			if ((request.lockNeededHandler != nil) && !request.lockNeededHandler(request))
+			{
+				// Lock no longer needed - pass it on to the next request for the same resource
+				_waitedFileDescriptorByResourceIdentifier[resourceIdentifier] = @(fileDescriptor);
+				continue;
+			}
+
+			// Create lock
+			OCLock *lock = [[OCLock alloc] initWithIdentifier:resourceIdentifier];
+			lock.manager = self;
+			lock.expirationDate = NSDate.distantFuture; // File locks don't need to be kept alive
+
+			_fileDescriptorByLockIdentifier[lock.identifier] = @(fileDescriptor);
+
+			// Store in request
+			request.lock = lock;
+		}
+	}
+
+	// Release locks acquired by waiters that no request needs anymore
+	for (NSNumber *fileDescriptor in _waitedFileDescriptorByResourceIdentifier.allValues)
+	{
+		OCLockManagerUnlockFile(fileDescriptor.intValue);
+	}
+
+	[_waitedFileDescriptorByResourceIdentifier removeAllObjects];
+
+	// Process request results
+	[self _processRequests:processedRequests];
+}
+
+#pragma mark - Class settings
++ (OCClassSettingsIdentifier)classSettingsIdentifier
+{
+	return (OCClassSettingsIdentifierLockManager);
+}
+
++ (nullable NSDictionary<OCClassSettingsKey,id> *)defaultSettingsForIdentifier:(nonnull OCClassSettingsIdentifier)identifier
+{
+	return (@{
+		OCClassSettingsKeyLockManagerBackend : OCLockManagerBackendKeyValueStore
+	});
+}
+
++ (OCClassSettingsMetadataCollection)classSettingsMetadata
+{
+	return (@{
+		OCClassSettingsKeyLockManagerBackend : @{
+			OCClassSettingsMetadataKeyType 		 : OCClassSettingsMetadataTypeString,
+			OCClassSettingsMetadataKeyDescription 	 : @"Backend used to coordinate locks across processes.",
+			OCClassSettingsMetadataKeyCategory	 : @"Connection",
+			OCClassSettingsMetadataKeyPossibleValues : @{
+				OCLockManagerBackendKeyValueStore : @"Lock database in a shared key-value store. Locks expire unless they are kept alive.",
+				OCLockManagerBackendFileLock : @"Advisory file locks on one lock file per resource. Locks are released by the system when their process ends."
+			},
+			OCClassSettingsMetadataKeyStatus	 : OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyFlags		 : @(OCClassSettingsFlagDenyUserPreferences)
+		}
+	});
+}
+
 @end
 
 OCKeyValueStoreKey OCKeyValueStoreKeyManagedLocks = @"managedLocks";
+
+OCLockManagerBackend OCLockManagerBackendKeyValueStore = @"kvs";
+OCLockManagerBackend OCLockManagerBackendFileLock = @"file-lock";
+
+OCClassSettingsIdentifier OCClassSettingsIdentifierLockManager = @"lock-manager";
+OCClassSettingsKey OCClassSettingsKeyLockManagerBackend = @"backend";
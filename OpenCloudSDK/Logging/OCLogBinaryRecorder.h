@@ -0,0 +1,43 @@
+//
+//  OCLogBinaryRecorder.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCLogger.h"
+#import "OCLogBinaryMessage.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void(^OCLogBinaryRecorderFlushHandler)(NSArray<OCLogBinaryMessage *> *messages);
+
+// Captures log calls without formatting them: format, raw arguments and timestamp are copied into a ring buffer owned by
+// the calling thread, so that producers never take a lock. Scalars and immutable objects (strings, numbers, dates, URLs, UUIDs)
+// are captured as-is, other objects by their -description, as they might be mutable or not thread-safe.
+
+@interface OCLogBinaryRecorder : NSObject
+
+@property(readonly) NSUInteger bufferSize; //!< Size of the ring buffer allocated for every logging thread
+
+- (instancetype)initWithBufferSize:(NSUInteger)bufferSize flushQueue:(dispatch_queue_t)flushQueue flushHandler:(OCLogBinaryRecorderFlushHandler)flushHandler;
+
+- (BOOL)recordLogLevel:(OCLogLevel)logLevel functionName:(nullable NSString *)functionName file:(nullable NSString *)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags format:(NSString *)format arguments:(va_list)args; //!< Records a message in the calling thread's ring buffer. Returns NO if the message can't be captured (f.ex. because the format contains unsupported specifiers or the ring is full), in which case the caller needs to format the message itself.
+
+- (void)flush; //!< Drains all ring buffers and passes the messages - ordered by timestamp - to the flush handler. Must be called on the flush queue.
+
+@end
+
+NS_ASSUME_NONNULL_END
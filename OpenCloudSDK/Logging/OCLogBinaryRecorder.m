@@ -0,0 +1,580 @@
+//
+//  OCLogBinaryRecorder.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <stdatomic.h>
+#import <pthread/pthread.h>
+
+#import "OCLogBinaryRecorder.h"
+#import "OCLogBinaryCoder.h"
+
+typedef NS_ENUM(uint8_t, OCLogRingRecordKind)
+{
+	OCLogRingRecordKindPadding,	//!< Unused space at the end of the ring
+	OCLogRingRecordKindMessage
+};
+
+typedef struct
+{
+	uint32_t length;		//!< Length of the record, including the header. Always a multiple of 8.
+	uint8_t kind;
+	int8_t logLevel;
+	uint16_t argumentCount;
+
+	uint64_t line;
+	CFAbsoluteTime timestamp;
+
+	const void *format;		//!< retained
+	const void *functionName;	//!< retained, optional
+	const void *file;		//!< retained, optional
+	const void *tags;		//!< retained, optional
+} OCLogRingRecord;
+
+typedef struct
+{
+	OCLogArgumentKind kind;
+
+	union
+	{
+		int64_t signedValue;
+		uint64_t unsignedValue;
+		double doubleValue;
+		const void *object;	//!< retained
+	};
+} OCLogRingArgument;
+
+typedef struct OCLogRing
+{
+	_Atomic(uint64_t) head;		//!< Write position - only advanced by the owning thread
+	_Atomic(uint64_t) tail;		//!< Read position - only advanced by the flush queue
+	_Atomic(bool) abandoned;	//!< Set when the owning thread exits
+
+	uint64_t threadID;
+	uint64_t capacity;		//!< Size of bytes, a power of two
+	uint8_t *bytes;
+
+	struct OCLogRing *next;
+} OCLogRing;
+
+typedef NS_OPTIONS(unsigned long, OCLogBinaryRecorderWakeUp)
+{
+	OCLogBinaryRecorderWakeUpScheduled = (1 << 0),	//!< Flush after OCLogBinaryRecorderFlushDelay
+	OCLogBinaryRecorderWakeUpUrgent = (1 << 1)	//!< Flush immediately
+};
+
+static const NSTimeInterval OCLogBinaryRecorderFlushDelay = 0.5;
+
+static void OCLogRingThreadExited(void *ring)
+{
+	atomic_store(&((OCLogRing *)ring)->abandoned, true);
+}
+
+static const void *OCLogCaptureObject(id object)
+{
+	static Class stringClass, numberClass, dateClass, urlClass, uuidClass, nullClass;
+	static dispatch_once_t onceToken;
+
+	dispatch_once(&onceToken, ^{
+		stringClass = NSString.class;
+		numberClass = NSNumber.class;
+		dateClass = NSDate.class;
+		urlClass = NSURL.class;
+		uuidClass = NSUUID.class;
+		nullClass = NSNull.class;
+	});
+
+	if (object == nil)
+	{
+		return (NULL);
+	}
+
+	if ([object isKindOfClass:stringClass])
+	{
+		// -copy only retains immutable strings
+		return (CFBridgingRetain([object copy]));
+	}
+
+	if ([object isKindOfClass:numberClass] || [object isKindOfClass:dateClass] || [object isKindOfClass:urlClass] || [object isKindOfClass:uuidClass] || [object isKindOfClass:nullClass])
+	{
+		return (CFBridgingRetain(object));
+	}
+
+	// Other objects may be mutable or not thread-safe, so their description needs to be composed now
+	return (CFBridgingRetain([object description]));
+}
+
+static void OCLogCaptureArguments(OCLogFormatSpecifier *specifiers, NSInteger specifierCount, va_list args, OCLogRingArgument *outArguments)
+{
+	NSUInteger argumentIdx = 0;
+
+	for (NSInteger specifierIdx=0; specifierIdx < specifierCount; specifierIdx++)
+	{
+		OCLogFormatSpecifier *specifier = &specifiers[specifierIdx];
+		OCLogRingArgument *argument;
+
+		for (NSUInteger starIdx=0; starIdx < specifier->starCount; starIdx++)
+		{
+			argument = &outArguments[argumentIdx++];
+			argument->kind = OCLogArgumentKindSigned;
+			argument->signedValue = va_arg(args, int);
+		}
+
+		argument = &outArguments[argumentIdx++];
+		argument->kind = specifier->kind;
+
+		switch (specifier->kind)
+		{
+			case OCLogArgumentKindSigned:
+				if ((specifier->conversion == 'c') || (specifier->conversion == 'C'))
+				{
+					argument->signedValue = va_arg(args, int);
+					break;
+				}
+
+				switch ((specifier->conversion == 'D') ? OCLogArgumentLengthLong : specifier->lengthModifier)
+				{
+					case OCLogArgumentLengthLong:	  argument->signedValue = va_arg(args, long);		break;
+					case OCLogArgumentLengthLongLong: argument->signedValue = va_arg(args, long long);	break;
+					case OCLogArgumentLengthSize:	  argument->signedValue = va_arg(args, ssize_t);	break;
+					case OCLogArgumentLengthPtrDiff:  argument->signedValue = va_arg(args, ptrdiff_t);	break;
+					case OCLogArgumentLengthIntMax:	  argument->signedValue = va_arg(args, intmax_t);	break;
+					default:			  argument->signedValue = va_arg(args, int);		break;
+				}
+			break;
+
+			case OCLogArgumentKindUnsigned:
+				switch (((specifier->conversion == 'U') || (specifier->conversion == 'O')) ? OCLogArgumentLengthLong : specifier->lengthModifier)
+				{
+					case OCLogArgumentLengthLong:	  argument->unsignedValue = va_arg(args, unsigned long);	break;
+					case OCLogArgumentLengthLongLong: argument->unsignedValue = va_arg(args, unsigned long long);	break;
+					case OCLogArgumentLengthSize:	  argument->unsignedValue = va_arg(args, size_t);		break;
+					case OCLogArgumentLengthPtrDiff:  argument->unsignedValue = (uint64_t)va_arg(args, ptrdiff_t);	break;
+					case OCLogArgumentLengthIntMax:	  argument->unsignedValue = va_arg(args, uintmax_t);		break;
+					default:			  argument->unsignedValue = va_arg(args, unsigned int);		break;
+				}
+			break;
+
+			case OCLogArgumentKindDouble:
+				if (specifier->lengthModifier == OCLogArgumentLengthLongDouble)
+				{
+					argument->doubleValue = (double)va_arg(args, long double);
+				}
+				else
+				{
+					argument->doubleValue = va_arg(args, double);
+				}
+			break;
+
+			case OCLogArgumentKindPointer:
+				argument->unsignedValue = (uint64_t)(uintptr_t)va_arg(args, void *);
+			break;
+
+			case OCLogArgumentKindCString: {
+				const char *cString = va_arg(args, const char *);
+				NSString *string = nil;
+
+				if (cString != NULL)
+				{
+					if ((string = [[NSString alloc] initWithUTF8String:cString]) == nil)
+					{
+						string = [[NSString alloc] initWithCString:cString encoding:NSISOLatin1StringEncoding];
+					}
+				}
+
+				if ((argument->object = ((string != nil) ? CFBridgingRetain(string) : NULL)) == NULL)
+				{
+					argument->kind = OCLogArgumentKindNull;
+				}
+			}
+			break;
+
+			case OCLogArgumentKindObject:
+				if ((argument->object = OCLogCaptureObject(va_arg(args, id))) == NULL)
+				{
+					argument->kind = OCLogArgumentKindNull;
+				}
+			break;
+
+			case OCLogArgumentKindNull:
+			break;
+		}
+	}
+}
+
+static OCLogBinaryMessage *OCLogConsumeRingRecord(OCLogRingRecord *record, uint64_t threadID, BOOL createMessage)
+{
+	// Takes over all references retained by the record
+	NSString *format = CFBridgingRelease(record->format);
+	NSString *functionName = (record->functionName != NULL) ? CFBridgingRelease(record->functionName) : nil;
+	NSString *file = (record->file != NULL) ? CFBridgingRelease(record->file) : nil;
+	NSArray<OCLogTagName> *tags = (record->tags != NULL) ? CFBridgingRelease(record->tags) : nil;
+	OCLogRingArgument *ringArguments = (OCLogRingArgument *)(record + 1);
+	NSMutableArray *arguments = createMessage ? [[NSMutableArray alloc] initWithCapacity:record->argumentCount] : nil;
+
+	for (NSUInteger argumentIdx=0; argumentIdx < record->argumentCount; argumentIdx++)
+	{
+		OCLogRingArgument *argument = &ringArguments[argumentIdx];
+		id argumentObject = nil;
+
+		switch (argument->kind)
+		{
+			case OCLogArgumentKindSigned:
+				argumentObject = createMessage ? @(argument->signedValue) : nil;
+			break;
+
+			case OCLogArgumentKindUnsigned:
+			case OCLogArgumentKindPointer:
+				argumentObject = createMessage ? @(argument->unsignedValue) : nil;
+			break;
+
+			case OCLogArgumentKindDouble:
+				argumentObject = createMessage ? @(argument->doubleValue) : nil;
+			break;
+
+			case OCLogArgumentKindCString:
+			case OCLogArgumentKindObject:
+				argumentObject = CFBridgingRelease(argument->object);
+			break;
+
+			case OCLogArgumentKindNull:
+			break;
+		}
+
+		[arguments addObject:((argumentObject != nil) ? argumentObject : NSNull.null)];
+	}
+
+	if (!createMessage)
+	{
+		return (nil);
+	}
+
+	return ([[OCLogBinaryMessage alloc] initWithLogLevel:record->logLevel timestamp:record->timestamp threadID:threadID functionName:functionName file:file line:(NSUInteger)record->line tags:tags format:format arguments:arguments]);
+}
+
+@interface OCLogBinaryRecorder ()
+{
+	pthread_key_t _ringKey;
+	BOOL _ringKeyCreated;
+
+	_Atomic(OCLogRing *) _rings;
+
+	dispatch_queue_t _flushQueue;
+	OCLogBinaryRecorderFlushHandler _flushHandler;
+
+	dispatch_source_t _wakeUpSource;
+	BOOL _flushScheduled;
+}
+@end
+
+@implementation OCLogBinaryRecorder
+
+- (instancetype)initWithBufferSize:(NSUInteger)bufferSize flushQueue:(dispatch_queue_t)flushQueue flushHandler:(OCLogBinaryRecorderFlushHandler)flushHandler
+{
+	if ((self = [super init]) != nil)
+	{
+		__weak OCLogBinaryRecorder *weakSelf = self;
+
+		// Round up to the next power of two
+		_bufferSize = 4096;
+
+		while (_bufferSize < bufferSize)
+		{
+			_bufferSize <<= 1;
+		}
+
+		_ringKeyCreated = (pthread_key_create(&_ringKey, OCLogRingThreadExited) == 0);
+		atomic_init(&_rings, NULL);
+
+		_flushQueue = flushQueue;
+		_flushHandler = [flushHandler copy];
+
+		_wakeUpSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_DATA_OR, 0, 0, flushQueue);
+
+		dispatch_source_set_event_handler(_wakeUpSource, ^{
+			OCLogBinaryRecorder *strongSelf;
+
+			if ((strongSelf = weakSelf) != nil)
+			{
+				[strongSelf _handleWakeUp:dispatch_source_get_data(strongSelf->_wakeUpSource)];
+			}
+		});
+
+		dispatch_resume(_wakeUpSource);
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	OCLogRing *ring;
+
+	dispatch_source_cancel(_wakeUpSource);
+
+	if (_ringKeyCreated)
+	{
+		pthread_key_delete(_ringKey);
+	}
+
+	// Release what's left in the rings and free them
+	ring = atomic_load(&_rings);
+
+	while (ring != NULL)
+	{
+		OCLogRing *nextRing = ring->next;
+
+		[self _drainRing:ring intoMessages:nil];
+
+		free(ring->bytes);
+		free(ring);
+
+		ring = nextRing;
+	}
+}
+
+#pragma mark - Recording
+- (OCLogRing *)_ringForCurrentThread
+{
+	OCLogRing *ring;
+
+	if (!_ringKeyCreated)
+	{
+		return (NULL);
+	}
+
+	if ((ring = pthread_getspecific(_ringKey)) == NULL)
+	{
+		OCLogRing *firstRing;
+
+		if ((ring = calloc(1, sizeof(OCLogRing))) == NULL)
+		{
+			return (NULL);
+		}
+
+		if ((ring->bytes = malloc(_bufferSize)) == NULL)
+		{
+			free(ring);
+			return (NULL);
+		}
+
+		ring->capacity = _bufferSize;
+		pthread_threadid_np(pthread_self(), &ring->threadID);
+
+		// Add to the list of rings (only the list head is ever modified by producers)
+		firstRing = atomic_load(&_rings);
+
+		do
+		{
+			ring->next = firstRing;
+		} while (!atomic_compare_exchange_weak(&_rings, &firstRing, ring));
+
+		pthread_setspecific(_ringKey, ring);
+	}
+
+	return (ring);
+}
+
+- (BOOL)recordLogLevel:(OCLogLevel)logLevel functionName:(NSString *)functionName file:(NSString *)file line:(NSUInteger)line tags:(NSArray<OCLogTagName> *)tags format:(NSString *)format arguments:(va_list)args
+{
+	OCLogFormatSpecifier specifiers[OCLogFormatMaximumSpecifierCount];
+	NSInteger specifierCount;
+	NSUInteger argumentCount = 0;
+	const char *formatChars;
+	uint64_t recordLength, head, tail, offset, padding;
+	OCLogRingRecord *record;
+	OCLogRing *ring;
+
+	// Formats are parsed in place, which requires direct access to their (ASCII) characters - as is the case for string literals
+	if ((formatChars = CFStringGetCStringPtr((__bridge CFStringRef)format, kCFStringEncodingASCII)) == NULL)
+	{
+		return (NO);
+	}
+
+	if ((specifierCount = OCLogParseFormat(formatChars, strlen(formatChars), specifiers, OCLogFormatMaximumSpecifierCount)) < 0)
+	{
+		return (NO);
+	}
+
+	for (NSInteger specifierIdx=0; specifierIdx < specifierCount; specifierIdx++)
+	{
+		argumentCount += specifiers[specifierIdx].starCount + 1;
+	}
+
+	if ((ring = [self _ringForCurrentThread]) == NULL)
+	{
+		return (NO);
+	}
+
+	// Reserve space
+	recordLength = (sizeof(OCLogRingRecord) + (argumentCount * sizeof(OCLogRingArgument)) + 7) & ~((uint64_t)7);
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	offset = head & (ring->capacity - 1);
+	padding = ((offset + recordLength) > ring->capacity) ? (ring->capacity - offset) : 0;
+
+	if ((recordLength > (ring->capacity / 2)) || (((head - tail) + padding + recordLength) > ring->capacity))
+	{
+		// Ring is full: have the flush queue catch up, let the caller format the message
+		dispatch_source_merge_data(_wakeUpSource, OCLogBinaryRecorderWakeUpUrgent);
+		return (NO);
+	}
+
+	if (padding > 0)
+	{
+		// Skip the rest of the ring (record lengths and offsets are multiples of 8, so there's always room for length and kind)
+		record = (OCLogRingRecord *)&ring->bytes[offset];
+		record->length = (uint32_t)padding;
+		record->kind = OCLogRingRecordKindPadding;
+
+		offset = 0;
+	}
+
+	// Write record
+	record = (OCLogRingRecord *)&ring->bytes[offset];
+
+	record->length = (uint32_t)recordLength;
+	record->kind = OCLogRingRecordKindMessage;
+	record->logLevel = (int8_t)logLevel;
+	record->argumentCount = (uint16_t)argumentCount;
+	record->line = line;
+	record->timestamp = CFAbsoluteTimeGetCurrent();
+
+	record->format = CFBridgingRetain(format);
+	record->functionName = (functionName != nil) ? CFBridgingRetain(functionName) : NULL;
+	record->file = (file != nil) ? CFBridgingRetain(file) : NULL;
+	record->tags = (tags != nil) ? CFBridgingRetain(tags) : NULL;
+
+	OCLogCaptureArguments(specifiers, specifierCount, args, (OCLogRingArgument *)(record + 1));
+
+	// Publish record, then check if the flush queue has already caught up with everything before it - in which case it needs to be woken up
+	atomic_store_explicit(&ring->head, head + padding + recordLength, memory_order_seq_cst);
+
+	if ((logLevel >= OCLogLevelError) || ((head + padding + recordLength - tail) > (ring->capacity / 2)))
+	{
+		dispatch_source_merge_data(_wakeUpSource, OCLogBinaryRecorderWakeUpUrgent);
+	}
+	else if (atomic_load_explicit(&ring->tail, memory_order_seq_cst) == head)
+	{
+		dispatch_source_merge_data(_wakeUpSource, OCLogBinaryRecorderWakeUpScheduled);
+	}
+
+	return (YES);
+}
+
+#pragma mark - Flushing
+- (void)_handleWakeUp:(unsigned long)wakeUp
+{
+	if ((wakeUp & OCLogBinaryRecorderWakeUpUrgent) != 0)
+	{
+		[self flush];
+	}
+	else if (!_flushScheduled)
+	{
+		__weak OCLogBinaryRecorder *weakSelf = self;
+
+		// Give more messages a chance to accumulate
+		_flushScheduled = YES;
+
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(OCLogBinaryRecorderFlushDelay * NSEC_PER_SEC)), _flushQueue, ^{
+			OCLogBinaryRecorder *strongSelf;
+
+			if ((strongSelf = weakSelf) != nil)
+			{
+				strongSelf->_flushScheduled = NO;
+				[strongSelf flush];
+			}
+		});
+	}
+}
+
+- (void)_drainRing:(OCLogRing *)ring intoMessages:(nullable NSMutableArray<OCLogBinaryMessage *> *)messages
+{
+	uint64_t mask = ring->capacity - 1;
+	uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	uint64_t head = atomic_load_explicit(&ring->head, memory_order_seq_cst);
+
+	while (tail != head)
+	{
+		@autoreleasepool
+		{
+			while (tail != head)
+			{
+				OCLogRingRecord *record = (OCLogRingRecord *)&ring->bytes[tail & mask];
+
+				if (record->kind == OCLogRingRecordKindMessage)
+				{
+					OCLogBinaryMessage *message;
+
+					if ((message = OCLogConsumeRingRecord(record, ring->threadID, (messages != nil))) != nil)
+					{
+						[messages addObject:message];
+					}
+				}
+
+				tail += record->length;
+			}
+		}
+
+		atomic_store_explicit(&ring->tail, tail, memory_order_seq_cst);
+		head = atomic_load_explicit(&ring->head, memory_order_seq_cst);
+	}
+}
+
+- (void)flush
+{
+	NSMutableArray<OCLogBinaryMessage *> *messages = [NSMutableArray new];
+	OCLogRing *ring = atomic_load(&_rings), *previousRing = NULL;
+
+	while (ring != NULL)
+	{
+		OCLogRing *nextRing = ring->next;
+		BOOL abandoned = atomic_load(&ring->abandoned); // read before draining, so that nothing can be added afterwards
+
+		[self _drainRing:ring intoMessages:messages];
+
+		if (abandoned && (previousRing != NULL))
+		{
+			// The owning thread has exited: unlink and free the ring. The first ring can't be unlinked as producers
+			// may be adding new rings in front of it - it's freed once it is no longer first.
+			previousRing->next = nextRing;
+
+			free(ring->bytes);
+			free(ring);
+		}
+		else
+		{
+			previousRing = ring;
+		}
+
+		ring = nextRing;
+	}
+
+	if (messages.count > 0)
+	{
+		// Interleave the messages of all threads in order
+		[messages sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(OCLogBinaryMessage * _Nonnull message1, OCLogBinaryMessage * _Nonnull message2) {
+			if (message1.timestamp < message2.timestamp) { return (NSOrderedAscending); }
+			if (message1.timestamp > message2.timestamp) { return (NSOrderedDescending); }
+			return (NSOrderedSame);
+		}];
+
+		_flushHandler(messages);
+	}
+}
+
+@end
@@ -41,7 +41,8 @@ typedef NS_ENUM(NSInteger, OCLogFormat)
 {
 	OCLogFormatText, //!< Plain-text log format
 	OCLogFormatJSON, //!< Log every message as one line of detailed JSON
-	OCLogFormatJSONComposed //!< Log every message as one line of composed/simplified JSON
+	OCLogFormatJSONComposed, //!< Log every message as one line of composed/simplified JSON
+	OCLogFormatBinary //!< Record messages unformatted into per-thread ring buffers and persist them in a compact binary format. Messages are only formatted where needed (writers without binary support, filters, export).
 };
 
 @class OCLogger;
@@ -50,6 +51,7 @@ typedef BOOL(^OCLogFilter)(OCLogger *logger, OCLogLevel logLevel, NSString * _Nu
 
 @class OCLogSource;
 @class OCLogWriter;
+@class OCLogBinaryRecorder;
 
 @protocol OCLogPrivacyMasking <NSObject>
 - (NSString *)privacyMaskedDescription;
@@ -76,6 +78,8 @@ typedef BOOL(^OCLogFilter)(OCLogger *logger, OCLogLevel logLevel, NSString * _Nu
 	NSMutableDictionary<OCLogComponentIdentifier, OCLogToggle *> *_togglesByIdentifier;
 
 	OCLogFilter _filter;
+
+	OCLogBinaryRecorder *_binaryRecorder;
 }
 
 @property(assign,class) OCLogLevel logLevel;
@@ -119,6 +123,10 @@ typedef BOOL(^OCLogFilter)(OCLogger *logger, OCLogLevel logLevel, NSString * _Nu
 - (nullable OCLogWriter *)writerWithIdentifier:(OCLogComponentIdentifier)identifier;
 - (void)pauseWritersWithIntermittentBlock:(dispatch_block_t)intermittentBlock; //!< Pauses log writing: closes all writers, executes intermittentBlock, opens all writers, resumes logging
 
+#pragma mark - Binary recording
+- (void)startBinaryRecordingWithBufferSize:(NSUInteger)bufferSize; //!< Starts recording messages unformatted into per-thread ring buffers of bufferSize bytes, which are flushed to the writers on the write queue. Called automatically for OCLogFormatBinary.
+- (void)flushBinaryRecordingWithCompletionHandler:(nullable dispatch_block_t)completionHandler; //!< Passes all recorded messages to the writers, then calls the completionHandler (on the write queue)
+
 #pragma mark - Toggles
 - (void)addToggle:(OCLogToggle *)logToggle; //!< Adds a toggle
 - (BOOL)isToggleEnabled:(OCLogComponentIdentifier)toggleIdentifier; //!< Returns YES if the toggle is enabled, NO otherwise
@@ -144,6 +152,9 @@ extern OCClassSettingsKey OCClassSettingsKeyLogSingleLined;
 extern OCClassSettingsKey OCClassSettingsKeyLogReplaceNewLine;
 extern OCClassSettingsKey OCClassSettingsKeyLogMaximumLogMessageSize;
 extern OCClassSettingsKey OCClassSettingsKeyLogFormat;
+extern OCClassSettingsKey OCClassSettingsKeyLogBinaryBufferSize;
+extern OCClassSettingsKey OCClassSettingsKeyLogCompressArchives;
+extern OCClassSettingsKey OCClassSettingsKeyLogMaximumStorageSize;
 
 @interface NSArray (OCLogTagMerge)
 - (NSArray<NSString *> *)arrayByMergingTagsFromArray:(NSArray<NSString *> *)mergeTags;
@@ -24,6 +24,7 @@
 #import "OCLogFileWriter.h"
 #import "OCLogSource.h"
 #import "OCLogFileSource.h"
+#import "OCLogBinaryRecorder.h"
 #import "OCAppIdentity.h"
 #import "OCIPNotificationCenter.h"
 #import "OCMacros.h"
@@ -90,6 +91,11 @@ static OCClassSettingsUserPreferencesMigrationIdentifier OCClassSettingsUserPref
 
 		[sharedLogger addWriter:[OCLogFileWriter new]];
 
+		if (OCLogger.logFormat == OCLogFormatBinary)
+		{
+			[sharedLogger startBinaryRecordingWithBufferSize:[[self classSettingForOCClassSettingsKey:OCClassSettingsKeyLogBinaryBufferSize] unsignedIntegerValue]];
+		}
+
 		[sharedLogger addToggle:[[OCLogToggle alloc] initWithIdentifier:OCLogOptionLogRequestsAndResponses localizedName:OCLocalizedString(@"Log HTTP requests and responses",nil)]];
 		[sharedLogger addToggle:[[OCLogToggle alloc] initWithIdentifier:OCLogOptionLogFileOperations localizedName:OCLocalizedString(@"Log internal file operations",nil)]];
 
@@ -211,7 +217,10 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCLogger)
 			OCClassSettingsKeyLogSingleLined	   : @(NO),
 			OCClassSettingsKeyLogReplaceNewLine	   : @(YES),
 			OCClassSettingsKeyLogMaximumLogMessageSize : @(0),
-			OCClassSettingsKeyLogFormat		   : @"text"
+			OCClassSettingsKeyLogFormat		   : @"text",
+			OCClassSettingsKeyLogBinaryBufferSize	   : @(64 * 1024),
+			OCClassSettingsKeyLogCompressArchives	   : @(YES),
+			OCClassSettingsKeyLogMaximumStorageSize	   : @(50 * 1024 * 1024)
 		});
 	}
 
@@ -333,11 +342,36 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCLogger)
 				@"text" : @"Standard logging as text.",
 				@"json" : @"Detailed JSON (one line per message).",
 				@"json-composed" : @"A simpler JSON version where details are already merged into the message.",
+				@"binary" : @"Compact binary format. Messages are recorded without formatting and only decoded to text on export.",
 			},
 			OCClassSettingsMetadataKeyStatus	 : OCClassSettingsKeyStatusAdvanced,
 			OCClassSettingsMetadataKeyFlags		 : @(OCClassSettingsFlagDenyUserPreferences)
 		},
 
+		OCClassSettingsKeyLogBinaryBufferSize : @{
+			OCClassSettingsMetadataKeyType 	      	 : OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	 : @"Size (in bytes) of the ring buffer every logging thread records messages into when using the binary log format.",
+			OCClassSettingsMetadataKeyCategory    	 : @"Logging",
+			OCClassSettingsMetadataKeyStatus	 : OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyFlags		 : @(OCClassSettingsFlagDenyUserPreferences)
+		},
+
+		OCClassSettingsKeyLogCompressArchives : @{
+			OCClassSettingsMetadataKeyType 	      	 : OCClassSettingsMetadataTypeBoolean,
+			OCClassSettingsMetadataKeyDescription 	 : @"Controls whether rotated log files are compressed.",
+			OCClassSettingsMetadataKeyCategory    	 : @"Logging",
+			OCClassSettingsMetadataKeyStatus	 : OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyFlags		 : @(OCClassSettingsFlagDenyUserPreferences)
+		},
+
+		OCClassSettingsKeyLogMaximumStorageSize : @{
+			OCClassSettingsMetadataKeyType 	      	 : OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	 : @"Maximum total size (in bytes) of all log files. Oldest logs are removed first when it is exceeded. A value of 0 means no limit.",
+			OCClassSettingsMetadataKeyCategory    	 : @"Logging",
+			OCClassSettingsMetadataKeyStatus	 : OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyFlags		 : @(OCClassSettingsFlagDenyUserPreferences)
+		},
+
 		OCClassSettingsKeyLogMaximumLogMessageSize : @{
 			OCClassSettingsMetadataKeyType 	      	 : OCClassSettingsMetadataTypeInteger,
 			OCClassSettingsMetadataKeyDescription 	 : @"Maximum length of a log message before the message is truncated. A value of 0 means no limit.",
@@ -466,6 +500,11 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCLogger)
 			{
 				return (OCLogFormatJSONComposed);
 			}
+
+			if ([logFormatString isEqual:@"binary"])
+			{
+				return (OCLogFormatBinary);
+			}
 		}
 
 		return (OCLogFormatText);
@@ -631,6 +670,22 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCLogger)
 		NSDate *timestamp;
 		uint64_t threadID = 0;
 
+		if ((_binaryRecorder != nil) && !forceSyncWrite && !OCLogger.synchronousLoggingEnabled)
+		{
+			va_list recordArgs;
+			BOOL recorded;
+
+			// Record the message without formatting it - falling back to formatting below if that's not possible
+			va_copy(recordArgs, args);
+			recorded = [_binaryRecorder recordLogLevel:logLevel functionName:functionName file:file line:line tags:tags format:formatString arguments:recordArgs];
+			va_end(recordArgs);
+
+			if (recorded)
+			{
+				return;
+			}
+		}
+
 		pthread_threadid_np(pthread_self(), &threadID);
 
 		if (_mainThreadThreadID == 0)
@@ -654,18 +709,18 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCLogger)
 	{
 		@synchronized(self)
 		{
-			[self _rawAppendLogLevel:logLevel functionName:functionName file:file line:line tags:tags logMessage:logMessage threadID:threadID timestamp:timestamp];
+			[self _rawAppendLogLevel:logLevel functionName:functionName file:file line:line tags:tags logMessage:logMessage threadID:threadID timestamp:timestamp excludingBinaryWriters:NO];
 		}
 	}
 	else
 	{
 		dispatch_async(_writeQueue, ^{
-			[self _rawAppendLogLevel:logLevel functionName:functionName file:file line:line tags:tags logMessage:logMessage threadID:threadID timestamp:timestamp];
+			[self _rawAppendLogLevel:logLevel functionName:functionName file:file line:line tags:tags logMessage:logMessage threadID:threadID timestamp:timestamp excludingBinaryWriters:NO];
 		});
 	}
 }
 
-- (void)_rawAppendLogLevel:(OCLogLevel)logLevel functionName:(NSString * _Nullable)functionName file:(NSString * _Nullable)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags logMessage:(NSString *)logMessage threadID:(uint64_t)threadID timestamp:(NSDate *)timestamp
+- (void)_rawAppendLogLevel:(OCLogLevel)logLevel functionName:(NSString * _Nullable)functionName file:(NSString * _Nullable)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags logMessage:(NSString *)logMessage threadID:(uint64_t)threadID timestamp:(NSDate *)timestamp excludingBinaryWriters:(BOOL)excludeBinaryWriters
 {
 	if (_filter != nil)
 	{
@@ -711,6 +766,11 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCLogger)
 
 	for (OCLogWriter *writer in self->_writers)
 	{
+		if (excludeBinaryWriters && writer.supportsBinaryMessages)
+		{
+			continue;
+		}
+
 		if ((sOCLogLevel != OCLogLevelOff) && writer.enabled)
 		{
 			if (!writer.isOpen)
@@ -854,6 +914,8 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCLogger)
 - (void)pauseWritersWithIntermittentBlock:(dispatch_block_t)intermittentBlock
 {
 	dispatch_async(_writeQueue, ^{
+		[self->_binaryRecorder flush];
+
 		[self _closeAllWriters];
 
 		intermittentBlock();
@@ -919,6 +981,82 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCLogger)
 	}
 }
 
+#pragma mark - Binary recording
+- (void)startBinaryRecordingWithBufferSize:(NSUInteger)bufferSize
+{
+	@synchronized(self)
+	{
+		if (_binaryRecorder == nil)
+		{
+			__weak OCLogger *weakSelf = self;
+
+			_binaryRecorder = [[OCLogBinaryRecorder alloc] initWithBufferSize:bufferSize flushQueue:_writeQueue flushHandler:^(NSArray<OCLogBinaryMessage *> * _Nonnull messages) {
+				[weakSelf _appendBinaryMessages:messages];
+			}];
+		}
+	}
+}
+
+- (void)flushBinaryRecordingWithCompletionHandler:(dispatch_block_t)completionHandler
+{
+	dispatch_async(_writeQueue, ^{
+		[self->_binaryRecorder flush];
+
+		if (completionHandler != nil)
+		{
+			completionHandler();
+		}
+	});
+}
+
+- (void)_appendBinaryMessages:(NSArray<OCLogBinaryMessage *> *)messages
+{
+	for (OCLogBinaryMessage *message in messages)
+	{
+		BOOL needsFormatting = (_filter != nil) || (sOCLogMessageMaximumSize != 0);
+
+		message.isMainThread = (message.threadID == _mainThreadThreadID);
+		message.privacyMasked = sOCLogMaskPrivateData;
+
+		if (!needsFormatting)
+		{
+			// Pass the message on unformatted to writers that support it
+			for (OCLogWriter *writer in _writers)
+			{
+				if ((sOCLogLevel != OCLogLevelOff) && writer.enabled)
+				{
+					if (!writer.supportsBinaryMessages)
+					{
+						needsFormatting = YES;
+						continue;
+					}
+
+					if (!writer.isOpen)
+					{
+						NSError *error;
+
+						if ((error = [writer open]) != nil)
+						{
+							NSLog(@"Error opening writer %@: %@", writer, error);
+						}
+					}
+
+					if (writer.isOpen)
+					{
+						[writer appendBinaryMessage:message];
+					}
+				}
+			}
+		}
+
+		if (needsFormatting)
+		{
+			// Filters and message size limits operate on the formatted message - and so does any writer without binary support
+			[self _rawAppendLogLevel:message.logLevel functionName:message.functionName file:message.file line:message.line tags:message.tags logMessage:message.message threadID:message.threadID timestamp:message.date excludingBinaryWriters:((_filter == nil) && (sOCLogMessageMaximumSize == 0))];
+		}
+	}
+}
+
 #pragma mark - Toggles
 - (void)addToggle:(OCLogToggle *)logToggle
 {
@@ -1060,3 +1198,6 @@ OCClassSettingsKey OCClassSettingsKeyLogSingleLined = @"single-lined";
 OCClassSettingsKey OCClassSettingsKeyLogReplaceNewLine = @"replace-newline";
 OCClassSettingsKey OCClassSettingsKeyLogMaximumLogMessageSize = @"maximum-message-size";
 OCClassSettingsKey OCClassSettingsKeyLogFormat = @"format";
+OCClassSettingsKey OCClassSettingsKeyLogBinaryBufferSize = @"binary-buffer-size";
+OCClassSettingsKey OCClassSettingsKeyLogCompressArchives = @"compress-archives";
+OCClassSettingsKey OCClassSettingsKeyLogMaximumStorageSize = @"maximum-storage-size";
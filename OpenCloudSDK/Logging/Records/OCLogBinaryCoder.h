@@ -0,0 +1,87 @@
+//
+//  OCLogBinaryCoder.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCLogBinaryMessage.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define OCLogFormatMaximumSpecifierCount 32
+
+typedef NS_ENUM(uint8_t, OCLogArgumentKind)
+{
+	OCLogArgumentKindNull,		//!< nil object or NULL C string
+	OCLogArgumentKindSigned,	//!< Signed integer (incl. characters and * width/precision values), stored as int64_t
+	OCLogArgumentKindUnsigned,	//!< Unsigned integer, stored as uint64_t
+	OCLogArgumentKindDouble,	//!< Floating point value, stored as double
+	OCLogArgumentKindPointer,	//!< Pointer (%p), stored as uint64_t
+	OCLogArgumentKindCString,	//!< C string (%s), stored as NSString
+	OCLogArgumentKindObject		//!< Object (%@), stored as the object if it is immutable, as its description otherwise
+};
+
+typedef NS_ENUM(uint8_t, OCLogArgumentLength)
+{
+	OCLogArgumentLengthDefault,
+	OCLogArgumentLengthChar,	//!< hh
+	OCLogArgumentLengthShort,	//!< h
+	OCLogArgumentLengthLong,	//!< l
+	OCLogArgumentLengthLongLong,	//!< ll, q
+	OCLogArgumentLengthLongDouble,	//!< L
+	OCLogArgumentLengthSize,	//!< z
+	OCLogArgumentLengthPtrDiff,	//!< t
+	OCLogArgumentLengthIntMax	//!< j
+};
+
+typedef struct
+{
+	NSUInteger location;		//!< Offset of the % character in the format
+	NSUInteger length;		//!< Length of the specifier, including the conversion character
+	NSUInteger modifierLocation;	//!< Offset of the length modifier (or conversion character if there is none)
+
+	NSUInteger starCount;		//!< Number of * width and precision arguments that precede the value
+
+	OCLogArgumentKind kind;
+	OCLogArgumentLength lengthModifier;
+	char conversion;
+} OCLogFormatSpecifier;
+
+extern NSInteger OCLogParseFormat(const char *format, size_t formatLength, OCLogFormatSpecifier *outSpecifiers, NSUInteger maximumSpecifierCount); //!< Parses the specifiers of a printf-style format into outSpecifiers and returns their number. Returns -1 if the format contains unsupported specifiers (f.ex. %n, %S or positional arguments) or more than maximumSpecifierCount specifiers.
+extern NSString *OCLogComposeMessage(NSString *format, NSArray *arguments); //!< Composes a message from a format and arguments captured for it.
+
+@interface OCLogBinaryEncoder : NSObject
+
+- (NSData *)sessionHeaderDataWithProcessName:(NSString *)processName processID:(pid_t)processID; //!< Starts a new session - and resets the string table. Needs to be written before the first message whenever a file is (re-)opened.
+- (NSData *)dataForMessage:(OCLogBinaryMessage *)message; //!< Encodes the message, preceded by definitions for strings not yet defined in the session.
+
+@end
+
+typedef void(^OCLogBinaryDecoderMessageHandler)(OCLogBinaryMessage *message, NSString *processName, pid_t processID, BOOL *stop);
+
+@interface OCLogBinaryDecoder : NSObject
+
++ (BOOL)isBinaryLogData:(NSData *)data; //!< Returns YES if data starts with a binary log session header
+
+- (instancetype)initWithData:(NSData *)data;
+
+- (void)enumerateMessagesUsingBlock:(OCLogBinaryDecoderMessageHandler)messageHandler; //!< Decodes all messages. Stops at the first truncated or malformed record.
+
+- (NSData *)composedTextData; //!< Decodes all messages and composes them as UTF-8 text, in the same way as OCLogFormatText
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,774 @@
+//
+//  OCLogBinaryCoder.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCLogBinaryCoder.h"
+#import "OCLogWriter.h"
+#import "OCMacros.h"
+
+#pragma mark - Format parsing
+NSInteger OCLogParseFormat(const char *format, size_t formatLength, OCLogFormatSpecifier *outSpecifiers, NSUInteger maximumSpecifierCount)
+{
+	NSInteger specifierCount = 0;
+
+	for (size_t idx=0; idx < formatLength; idx++)
+	{
+		OCLogFormatSpecifier specifier = { .location = idx };
+
+		if (format[idx] != '%') { continue; }
+
+		if (++idx >= formatLength) { return (-1); }
+
+		// Escaped %
+		if (format[idx] == '%') { continue; }
+
+		// Flags
+		while ((idx < formatLength) && ((format[idx] == '-') || (format[idx] == '+') || (format[idx] == ' ') || (format[idx] == '#') || (format[idx] == '0') || (format[idx] == '\'')))
+		{
+			idx++;
+		}
+
+		// Width
+		if ((idx < formatLength) && (format[idx] == '*'))
+		{
+			specifier.starCount++;
+			idx++;
+		}
+		else
+		{
+			while ((idx < formatLength) && (format[idx] >= '0') && (format[idx] <= '9')) { idx++; }
+		}
+
+		// Positional arguments are not supported
+		if ((idx < formatLength) && (format[idx] == '$')) { return (-1); }
+
+		// Precision
+		if ((idx < formatLength) && (format[idx] == '.'))
+		{
+			idx++;
+
+			if ((idx < formatLength) && (format[idx] == '*'))
+			{
+				specifier.starCount++;
+				idx++;
+			}
+			else
+			{
+				while ((idx < formatLength) && (format[idx] >= '0') && (format[idx] <= '9')) { idx++; }
+			}
+		}
+
+		// Length modifier
+		specifier.modifierLocation = idx;
+
+		if (idx < formatLength)
+		{
+			switch (format[idx])
+			{
+				case 'h':
+					if (((idx+1) < formatLength) && (format[idx+1] == 'h'))
+					{
+						specifier.lengthModifier = OCLogArgumentLengthChar;
+						idx++;
+					}
+					else
+					{
+						specifier.lengthModifier = OCLogArgumentLengthShort;
+					}
+					idx++;
+				break;
+
+				case 'l':
+					if (((idx+1) < formatLength) && (format[idx+1] == 'l'))
+					{
+						specifier.lengthModifier = OCLogArgumentLengthLongLong;
+						idx++;
+					}
+					else
+					{
+						specifier.lengthModifier = OCLogArgumentLengthLong;
+					}
+					idx++;
+				break;
+
+				case 'q': specifier.lengthModifier = OCLogArgumentLengthLongLong;   idx++; break;
+				case 'L': specifier.lengthModifier = OCLogArgumentLengthLongDouble; idx++; break;
+				case 'z': specifier.lengthModifier = OCLogArgumentLengthSize;       idx++; break;
+				case 't': specifier.lengthModifier = OCLogArgumentLengthPtrDiff;    idx++; break;
+				case 'j': specifier.lengthModifier = OCLogArgumentLengthIntMax;     idx++; break;
+			}
+		}
+
+		// Conversion
+		if (idx >= formatLength) { return (-1); }
+
+		specifier.conversion = format[idx];
+
+		switch (specifier.conversion)
+		{
+			case 'd': case 'i': case 'D':
+				specifier.kind = OCLogArgumentKindSigned;
+			break;
+
+			case 'c': case 'C':
+				if (specifier.lengthModifier != OCLogArgumentLengthDefault) { return (-1); } // wide characters
+				specifier.kind = OCLogArgumentKindSigned;
+			break;
+
+			case 'o': case 'u': case 'x': case 'X': case 'O': case 'U':
+				specifier.kind = OCLogArgumentKindUnsigned;
+			break;
+
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+				specifier.kind = OCLogArgumentKindDouble;
+			break;
+
+			case 's':
+				if (specifier.lengthModifier != OCLogArgumentLengthDefault) { return (-1); } // wide strings
+				specifier.kind = OCLogArgumentKindCString;
+			break;
+
+			case 'p':
+				specifier.kind = OCLogArgumentKindPointer;
+			break;
+
+			case '@':
+				specifier.kind = OCLogArgumentKindObject;
+			break;
+
+			default:
+				// %n, %S, %P, …
+				return (-1);
+			break;
+		}
+
+		specifier.length = idx + 1 - specifier.location;
+
+		if (specifierCount >= maximumSpecifierCount) { return (-1); }
+
+		outSpecifiers[specifierCount++] = specifier;
+	}
+
+	return (specifierCount);
+}
+
+#pragma mark - Message composition
+static void OCLogAppendLiteral(NSMutableString *message, const char *format, size_t location, size_t length)
+{
+	size_t segmentStart = location, end = location + length;
+
+	for (size_t idx=location; idx < end; idx++)
+	{
+		if ((format[idx] == '%') && ((idx+1) < end) && (format[idx+1] == '%'))
+		{
+			// Append up to and including the first %, skip the second
+			[message appendString:[[NSString alloc] initWithBytes:&format[segmentStart] length:(idx + 1 - segmentStart) encoding:NSUTF8StringEncoding]];
+			segmentStart = idx + 2;
+			idx++;
+		}
+	}
+
+	if (segmentStart < end)
+	{
+		[message appendString:[[NSString alloc] initWithBytes:&format[segmentStart] length:(end - segmentStart) encoding:NSUTF8StringEncoding]];
+	}
+}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wformat-nonliteral"
+
+#define OCLogFormatWithStars(...) ((specifier->starCount == 0) ? [[NSString alloc] initWithFormat:specifierFormat, __VA_ARGS__] : \
+				  ((specifier->starCount == 1) ? [[NSString alloc] initWithFormat:specifierFormat, stars[0], __VA_ARGS__] : \
+								 [[NSString alloc] initWithFormat:specifierFormat, stars[0], stars[1], __VA_ARGS__]))
+
+static NSString *OCLogFormatArgument(const char *format, OCLogFormatSpecifier *specifier, int *stars, id value)
+{
+	// Rewrite the specifier so that the captured (widened) value can be passed as-is
+	NSString *prefix = [[NSString alloc] initWithBytes:&format[specifier->location] length:(specifier->modifierLocation - specifier->location) encoding:NSUTF8StringEncoding];
+	NSString *specifierFormat = nil;
+	NSNumber *number = ([value isKindOfClass:NSNumber.class] ? value : nil);
+
+	if ([value isKindOfClass:NSNull.class])
+	{
+		value = nil;
+	}
+
+	switch (specifier->kind)
+	{
+		case OCLogArgumentKindSigned:
+			if ((specifier->conversion == 'c') || (specifier->conversion == 'C'))
+			{
+				specifierFormat = [prefix stringByAppendingFormat:@"%c", specifier->conversion];
+				return (OCLogFormatWithStars((int)number.longLongValue));
+			}
+
+			specifierFormat = [prefix stringByAppendingFormat:@"ll%c", ((specifier->conversion == 'D') ? 'd' : specifier->conversion)];
+			return (OCLogFormatWithStars(number.longLongValue));
+		break;
+
+		case OCLogArgumentKindUnsigned:
+			specifierFormat = [prefix stringByAppendingFormat:@"ll%c", ((specifier->conversion == 'U') ? 'u' : ((specifier->conversion == 'O') ? 'o' : specifier->conversion))];
+			return (OCLogFormatWithStars(number.unsignedLongLongValue));
+		break;
+
+		case OCLogArgumentKindDouble:
+			specifierFormat = [prefix stringByAppendingFormat:@"%c", specifier->conversion];
+			return (OCLogFormatWithStars(number.doubleValue));
+		break;
+
+		case OCLogArgumentKindPointer:
+			specifierFormat = [prefix stringByAppendingString:@"p"];
+			return (OCLogFormatWithStars((void *)(uintptr_t)number.unsignedLongLongValue));
+		break;
+
+		case OCLogArgumentKindCString:
+			specifierFormat = [prefix stringByAppendingString:@"s"];
+			return (OCLogFormatWithStars(((value != nil) ? [value description].UTF8String : NULL)));
+		break;
+
+		case OCLogArgumentKindObject:
+			specifierFormat = [prefix stringByAppendingString:@"@"];
+			return (OCLogFormatWithStars(value));
+		break;
+
+		case OCLogArgumentKindNull:
+		break;
+	}
+
+	return (@"");
+}
+
+#pragma clang diagnostic pop
+
+NSString *OCLogComposeMessage(NSString *format, NSArray *arguments)
+{
+	OCLogFormatSpecifier specifiers[OCLogFormatMaximumSpecifierCount];
+	const char *formatChars = format.UTF8String;
+	size_t formatLength = (formatChars != NULL) ? strlen(formatChars) : 0;
+	NSInteger specifierCount;
+
+	if ((specifierCount = OCLogParseFormat(formatChars, formatLength, specifiers, OCLogFormatMaximumSpecifierCount)) < 0)
+	{
+		// Formats are only captured if they can be parsed, so this should never happen
+		return (format);
+	}
+
+	NSMutableString *message = [[NSMutableString alloc] initWithCapacity:formatLength * 2];
+	NSUInteger argumentIndex = 0, argumentCount = arguments.count;
+	size_t literalLocation = 0;
+
+	for (NSInteger specifierIdx=0; specifierIdx < specifierCount; specifierIdx++)
+	{
+		OCLogFormatSpecifier *specifier = &specifiers[specifierIdx];
+		int stars[2] = { 0, 0 };
+
+		OCLogAppendLiteral(message, formatChars, literalLocation, specifier->location - literalLocation);
+		literalLocation = specifier->location + specifier->length;
+
+		if ((argumentIndex + specifier->starCount + 1) > argumentCount)
+		{
+			[message appendString:@"(missing)"];
+			continue;
+		}
+
+		for (NSUInteger starIdx=0; starIdx < specifier->starCount; starIdx++)
+		{
+			stars[starIdx] = OCTypedCast(arguments[argumentIndex++], NSNumber).intValue;
+		}
+
+		[message appendString:OCLogFormatArgument(formatChars, specifier, stars, arguments[argumentIndex++])];
+	}
+
+	OCLogAppendLiteral(message, formatChars, literalLocation, formatLength - literalLocation);
+
+	return (message);
+}
+
+#pragma mark - Encoding primitives
+typedef NS_ENUM(uint8_t, OCLogBinaryRecordKind)
+{
+	OCLogBinaryRecordKindSession = 1,
+	OCLogBinaryRecordKindString,
+	OCLogBinaryRecordKindMessage
+};
+
+typedef NS_ENUM(uint8_t, OCLogBinaryArgumentType)
+{
+	OCLogBinaryArgumentTypeNull,
+	OCLogBinaryArgumentTypeSigned,
+	OCLogBinaryArgumentTypeUnsigned,
+	OCLogBinaryArgumentTypeDouble,
+	OCLogBinaryArgumentTypeString
+};
+
+typedef NS_OPTIONS(uint8_t, OCLogBinaryMessageFlag)
+{
+	OCLogBinaryMessageFlagMainThread = (1 << 0),
+	OCLogBinaryMessageFlagPrivacyMasked = (1 << 1)
+};
+
+static const char OCLogBinarySessionMagic[4] = { 'O', 'C', 'L', 'B' };
+static const uint64_t OCLogBinaryFormatVersion = 1;
+
+static void OCLogAppendVarint(NSMutableData *data, uint64_t value)
+{
+	uint8_t bytes[10];
+	size_t length = 0;
+
+	do
+	{
+		bytes[length] = (value & 0x7F) | ((value > 0x7F) ? 0x80 : 0);
+		value >>= 7;
+		length++;
+	} while (value != 0);
+
+	[data appendBytes:bytes length:length];
+}
+
+static void OCLogAppendZigZag(NSMutableData *data, int64_t value)
+{
+	OCLogAppendVarint(data, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static void OCLogAppendDouble(NSMutableData *data, double value)
+{
+	uint64_t bits;
+
+	memcpy(&bits, &value, sizeof(bits));
+	bits = OSSwapHostToLittleInt64(bits);
+
+	[data appendBytes:&bits length:sizeof(bits)];
+}
+
+static void OCLogAppendString(NSMutableData *data, NSString *string)
+{
+	NSData *utf8Data = [string dataUsingEncoding:NSUTF8StringEncoding allowLossyConversion:YES];
+
+	OCLogAppendVarint(data, utf8Data.length);
+	[data appendData:utf8Data];
+}
+
+static void OCLogAppendRecord(NSMutableData *data, NSData *payload)
+{
+	OCLogAppendVarint(data, payload.length);
+	[data appendData:payload];
+}
+
+typedef struct
+{
+	const uint8_t *bytes;
+	size_t length;
+	size_t offset;
+	BOOL failed;
+} OCLogBinaryReader;
+
+static uint64_t OCLogReadVarint(OCLogBinaryReader *reader)
+{
+	uint64_t value = 0;
+
+	for (NSUInteger shift=0; shift < 64; shift += 7)
+	{
+		if (reader->offset >= reader->length) { break; }
+
+		uint8_t byte = reader->bytes[reader->offset++];
+
+		value |= ((uint64_t)(byte & 0x7F)) << shift;
+
+		if ((byte & 0x80) == 0)
+		{
+			return (value);
+		}
+	}
+
+	reader->failed = YES;
+	return (0);
+}
+
+static int64_t OCLogReadZigZag(OCLogBinaryReader *reader)
+{
+	uint64_t value = OCLogReadVarint(reader);
+
+	return ((int64_t)(value >> 1) ^ -(int64_t)(value & 1));
+}
+
+static double OCLogReadDouble(OCLogBinaryReader *reader)
+{
+	uint64_t bits;
+	double value;
+
+	if ((reader->offset + sizeof(bits)) > reader->length)
+	{
+		reader->failed = YES;
+		return (0);
+	}
+
+	memcpy(&bits, &reader->bytes[reader->offset], sizeof(bits));
+	reader->offset += sizeof(bits);
+
+	bits = OSSwapLittleToHostInt64(bits);
+	memcpy(&value, &bits, sizeof(value));
+
+	return (value);
+}
+
+static uint8_t OCLogReadByte(OCLogBinaryReader *reader)
+{
+	if (reader->offset >= reader->length)
+	{
+		reader->failed = YES;
+		return (0);
+	}
+
+	return (reader->bytes[reader->offset++]);
+}
+
+static NSString *OCLogReadString(OCLogBinaryReader *reader)
+{
+	uint64_t length = OCLogReadVarint(reader);
+
+	if (reader->failed || (length > (reader->length - reader->offset)))
+	{
+		reader->failed = YES;
+		return (nil);
+	}
+
+	NSString *string = [[NSString alloc] initWithBytes:&reader->bytes[reader->offset] length:(NSUInteger)length encoding:NSUTF8StringEncoding];
+	reader->offset += length;
+
+	return ((string != nil) ? string : @"");
+}
+
+#pragma mark - Encoder
+@interface OCLogBinaryEncoder ()
+{
+	NSMutableDictionary<NSString *, NSNumber *> *_stringIDs;
+	uint64_t _nextStringID;
+
+	NSMutableData *_payload;
+}
+@end
+
+@implementation OCLogBinaryEncoder
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_stringIDs = [NSMutableDictionary new];
+		_nextStringID = 1;
+
+		_payload = [NSMutableData new];
+	}
+
+	return (self);
+}
+
+- (NSData *)sessionHeaderDataWithProcessName:(NSString *)processName processID:(pid_t)processID
+{
+	NSMutableData *data = [NSMutableData new];
+
+	[_stringIDs removeAllObjects];
+	_nextStringID = 1;
+
+	_payload.length = 0;
+	[_payload appendBytes:&(uint8_t){ OCLogBinaryRecordKindSession } length:1];
+	[_payload appendBytes:OCLogBinarySessionMagic length:sizeof(OCLogBinarySessionMagic)];
+	OCLogAppendVarint(_payload, OCLogBinaryFormatVersion);
+	OCLogAppendVarint(_payload, (uint64_t)processID);
+	OCLogAppendString(_payload, processName);
+
+	OCLogAppendRecord(data, _payload);
+
+	return (data);
+}
+
+- (uint64_t)_idForString:(NSString *)string definingInto:(NSMutableData *)data
+{
+	NSNumber *stringID;
+
+	if (string == nil)
+	{
+		return (0);
+	}
+
+	if ((stringID = _stringIDs[string]) == nil)
+	{
+		NSMutableData *definition = [NSMutableData new];
+
+		stringID = @(_nextStringID++);
+		_stringIDs[string] = stringID;
+
+		[definition appendBytes:&(uint8_t){ OCLogBinaryRecordKindString } length:1];
+		OCLogAppendVarint(definition, stringID.unsignedLongLongValue);
+		OCLogAppendString(definition, string);
+
+		OCLogAppendRecord(data, definition);
+	}
+
+	return (stringID.unsignedLongLongValue);
+}
+
+- (NSData *)dataForMessage:(OCLogBinaryMessage *)message
+{
+	NSMutableData *data = [NSMutableData new];
+	NSArray<OCLogTagName> *tags = message.tags;
+	uint64_t formatID, functionID, fileID;
+	uint64_t tagIDs[tags.count + 1];
+
+	// Definitions
+	formatID = [self _idForString:message.format definingInto:data];
+	functionID = [self _idForString:message.functionName definingInto:data];
+	fileID = [self _idForString:message.file definingInto:data];
+
+	for (NSUInteger tagIdx=0; tagIdx < tags.count; tagIdx++)
+	{
+		tagIDs[tagIdx] = [self _idForString:tags[tagIdx] definingInto:data];
+	}
+
+	// Message
+	_payload.length = 0;
+
+	[_payload appendBytes:&(uint8_t){ OCLogBinaryRecordKindMessage } length:1];
+	OCLogAppendZigZag(_payload, message.logLevel);
+	OCLogAppendDouble(_payload, message.timestamp);
+	OCLogAppendVarint(_payload, message.threadID);
+	[_payload appendBytes:&(uint8_t){ (message.isMainThread ? OCLogBinaryMessageFlagMainThread : 0) | (message.privacyMasked ? OCLogBinaryMessageFlagPrivacyMasked : 0) } length:1];
+	OCLogAppendVarint(_payload, formatID);
+	OCLogAppendVarint(_payload, functionID);
+	OCLogAppendVarint(_payload, fileID);
+	OCLogAppendVarint(_payload, message.line);
+
+	OCLogAppendVarint(_payload, tags.count);
+	for (NSUInteger tagIdx=0; tagIdx < tags.count; tagIdx++)
+	{
+		OCLogAppendVarint(_payload, tagIDs[tagIdx]);
+	}
+
+	OCLogAppendVarint(_payload, message.arguments.count);
+	for (id argument in message.arguments)
+	{
+		if ([argument isKindOfClass:NSNumber.class])
+		{
+			NSNumber *number = argument;
+			const char *objCType = number.objCType;
+
+			if ((strcmp(objCType, @encode(double)) == 0) || (strcmp(objCType, @encode(float)) == 0))
+			{
+				[_payload appendBytes:&(uint8_t){ OCLogBinaryArgumentTypeDouble } length:1];
+				OCLogAppendDouble(_payload, number.doubleValue);
+			}
+			else if (strcmp(objCType, @encode(unsigned long long)) == 0)
+			{
+				[_payload appendBytes:&(uint8_t){ OCLogBinaryArgumentTypeUnsigned } length:1];
+				OCLogAppendVarint(_payload, number.unsignedLongLongValue);
+			}
+			else
+			{
+				[_payload appendBytes:&(uint8_t){ OCLogBinaryArgumentTypeSigned } length:1];
+				OCLogAppendZigZag(_payload, number.longLongValue);
+			}
+		}
+		else if ([argument isKindOfClass:NSNull.class])
+		{
+			[_payload appendBytes:&(uint8_t){ OCLogBinaryArgumentTypeNull } length:1];
+		}
+		else
+		{
+			// Strings and (immutable) objects are persisted by their description
+			[_payload appendBytes:&(uint8_t){ OCLogBinaryArgumentTypeString } length:1];
+			OCLogAppendString(_payload, [argument description]);
+		}
+	}
+
+	OCLogAppendRecord(data, _payload);
+
+	return (data);
+}
+
+@end
+
+#pragma mark - Decoder
+@interface OCLogBinaryDecoder ()
+{
+	NSData *_data;
+}
+@end
+
+@implementation OCLogBinaryDecoder
+
++ (BOOL)isBinaryLogData:(NSData *)data
+{
+	OCLogBinaryReader reader = { .bytes = data.bytes, .length = data.length };
+
+	OCLogReadVarint(&reader);
+
+	if (reader.failed || ((reader.offset + 1 + sizeof(OCLogBinarySessionMagic)) > reader.length))
+	{
+		return (NO);
+	}
+
+	return ((reader.bytes[reader.offset] == OCLogBinaryRecordKindSession) && (memcmp(&reader.bytes[reader.offset + 1], OCLogBinarySessionMagic, sizeof(OCLogBinarySessionMagic)) == 0));
+}
+
+- (instancetype)initWithData:(NSData *)data
+{
+	if ((self = [super init]) != nil)
+	{
+		_data = data;
+	}
+
+	return (self);
+}
+
+- (void)enumerateMessagesUsingBlock:(OCLogBinaryDecoderMessageHandler)messageHandler
+{
+	OCLogBinaryReader fileReader = { .bytes = _data.bytes, .length = _data.length };
+	NSMutableDictionary<NSNumber *, NSString *> *stringsByID = [NSMutableDictionary new];
+	NSString *processName = @"";
+	pid_t processID = 0;
+	BOOL stop = NO;
+
+	while ((fileReader.offset < fileReader.length) && !stop)
+	{
+		uint64_t recordLength = OCLogReadVarint(&fileReader);
+
+		if (fileReader.failed || (recordLength > (fileReader.length - fileReader.offset)))
+		{
+			// Truncated record (f.ex. from a crash during a write)
+			break;
+		}
+
+		OCLogBinaryReader reader = { .bytes = &fileReader.bytes[fileReader.offset], .length = (size_t)recordLength };
+		fileReader.offset += recordLength;
+
+		@autoreleasepool
+		{
+			switch (OCLogReadByte(&reader))
+			{
+				case OCLogBinaryRecordKindSession:
+					if ((reader.length < (1 + sizeof(OCLogBinarySessionMagic))) || (memcmp(&reader.bytes[1], OCLogBinarySessionMagic, sizeof(OCLogBinarySessionMagic)) != 0))
+					{
+						return;
+					}
+					reader.offset += sizeof(OCLogBinarySessionMagic);
+
+					if (OCLogReadVarint(&reader) > OCLogBinaryFormatVersion)
+					{
+						// Unknown format version
+						return;
+					}
+
+					processID = (pid_t)OCLogReadVarint(&reader);
+					processName = OCLogReadString(&reader);
+
+					[stringsByID removeAllObjects];
+				break;
+
+				case OCLogBinaryRecordKindString: {
+					uint64_t stringID = OCLogReadVarint(&reader);
+					NSString *string = OCLogReadString(&reader);
+
+					if (!reader.failed)
+					{
+						stringsByID[@(stringID)] = string;
+					}
+				}
+				break;
+
+				case OCLogBinaryRecordKindMessage: {
+					OCLogLevel logLevel = (OCLogLevel)OCLogReadZigZag(&reader);
+					NSTimeInterval timestamp = OCLogReadDouble(&reader);
+					uint64_t threadID = OCLogReadVarint(&reader);
+					uint8_t flags = OCLogReadByte(&reader);
+					NSString *format = stringsByID[@(OCLogReadVarint(&reader))];
+					NSString *functionName = stringsByID[@(OCLogReadVarint(&reader))];
+					NSString *file = stringsByID[@(OCLogReadVarint(&reader))];
+					NSUInteger line = (NSUInteger)OCLogReadVarint(&reader);
+					NSMutableArray<OCLogTagName> *tags = nil;
+					NSMutableArray *arguments = [NSMutableArray new];
+					uint64_t tagCount, argumentCount;
+
+					if ((tagCount = OCLogReadVarint(&reader)) > 0)
+					{
+						tags = [NSMutableArray new];
+
+						for (uint64_t tagIdx=0; (tagIdx < tagCount) && !reader.failed; tagIdx++)
+						{
+							NSString *tag;
+
+							if ((tag = stringsByID[@(OCLogReadVarint(&reader))]) != nil)
+							{
+								[tags addObject:tag];
+							}
+						}
+					}
+
+					argumentCount = OCLogReadVarint(&reader);
+
+					for (uint64_t argumentIdx=0; (argumentIdx < argumentCount) && !reader.failed; argumentIdx++)
+					{
+						id argument = nil;
+
+						switch (OCLogReadByte(&reader))
+						{
+							case OCLogBinaryArgumentTypeSigned:   argument = @(OCLogReadZigZag(&reader)); break;
+							case OCLogBinaryArgumentTypeUnsigned: argument = @(OCLogReadVarint(&reader)); break;
+							case OCLogBinaryArgumentTypeDouble:   argument = @(OCLogReadDouble(&reader)); break;
+							case OCLogBinaryArgumentTypeString:   argument = OCLogReadString(&reader); break;
+							default: break;
+						}
+
+						[arguments addObject:((argument != nil) ? argument : NSNull.null)];
+					}
+
+					if (!reader.failed && (format != nil))
+					{
+						OCLogBinaryMessage *message = [[OCLogBinaryMessage alloc] initWithLogLevel:logLevel timestamp:timestamp threadID:threadID functionName:functionName file:file line:line tags:tags format:format arguments:arguments];
+
+						message.isMainThread = ((flags & OCLogBinaryMessageFlagMainThread) != 0);
+						message.privacyMasked = ((flags & OCLogBinaryMessageFlagPrivacyMasked) != 0);
+
+						messageHandler(message, processName, processID, &stop);
+					}
+				}
+				break;
+
+				default:
+					// Skip unknown record kinds
+				break;
+			}
+		}
+	}
+}
+
+- (NSData *)composedTextData
+{
+	NSMutableData *textData = [NSMutableData new];
+
+	[self enumerateMessagesUsingBlock:^(OCLogBinaryMessage * _Nonnull message, NSString * _Nonnull processName, pid_t processID, BOOL * _Nonnull stop) {
+		NSString *line;
+
+		if ((line = [OCLogWriter composedTextLineWithLogLevel:message.logLevel date:message.date processName:processName processID:processID threadID:message.threadID isMainThread:message.isMainThread privacyMasked:message.privacyMasked file:message.file line:message.line tags:message.tags flags:(OCLogLineFlagLineFirst|OCLogLineFlagLineLast) message:[message.message stringByReplacingOccurrencesOfString:@"\n" withString:@"\\n"]]) != nil)
+		{
+			[textData appendData:[line dataUsingEncoding:NSUTF8StringEncoding]];
+		}
+	}];
+
+	return (textData);
+}
+
+@end
@@ -0,0 +1,48 @@
+//
+//  OCLogBinaryMessage.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCLogger.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCLogBinaryMessage : NSObject
+
+@property(readonly) OCLogLevel logLevel;
+@property(readonly) NSTimeInterval timestamp; //!< Seconds since the reference date
+@property(readonly,strong,nonatomic) NSDate *date;
+
+@property(readonly) uint64_t threadID;
+@property(assign) BOOL isMainThread;
+@property(assign) BOOL privacyMasked;
+
+@property(readonly,strong,nullable) NSString *functionName;
+@property(readonly,strong,nullable) NSString *file;
+@property(readonly) NSUInteger line;
+@property(readonly,strong,nullable) NSArray<OCLogTagName> *tags;
+
+@property(readonly,strong) NSString *format; //!< The printf-style format string, as passed to the logging call
+@property(readonly,strong) NSArray *arguments; //!< The arguments captured for the format: NSNumbers for scalar values, NSStrings or immutable objects for strings and objects, NSNull for nil
+
+@property(readonly,strong,nonatomic) NSString *message; //!< The message composed from format and arguments. Formatted on first access.
+
+- (instancetype)initWithLogLevel:(OCLogLevel)logLevel timestamp:(NSTimeInterval)timestamp threadID:(uint64_t)threadID functionName:(nullable NSString *)functionName file:(nullable NSString *)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags format:(NSString *)format arguments:(NSArray *)arguments;
+
+@end
+
+NS_ASSUME_NONNULL_END
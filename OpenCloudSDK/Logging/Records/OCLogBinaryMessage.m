@@ -0,0 +1,66 @@
+//
+//  OCLogBinaryMessage.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCLogBinaryMessage.h"
+#import "OCLogBinaryCoder.h"
+
+@implementation OCLogBinaryMessage
+
+@synthesize message = _message;
+
+- (instancetype)initWithLogLevel:(OCLogLevel)logLevel timestamp:(NSTimeInterval)timestamp threadID:(uint64_t)threadID functionName:(NSString *)functionName file:(NSString *)file line:(NSUInteger)line tags:(NSArray<OCLogTagName> *)tags format:(NSString *)format arguments:(NSArray *)arguments
+{
+	if ((self = [super init]) != nil)
+	{
+		_logLevel = logLevel;
+		_timestamp = timestamp;
+		_threadID = threadID;
+
+		_functionName = functionName;
+		_file = file;
+		_line = line;
+		_tags = tags;
+
+		_format = format;
+		_arguments = arguments;
+	}
+
+	return (self);
+}
+
+- (NSDate *)date
+{
+	return ([NSDate dateWithTimeIntervalSinceReferenceDate:_timestamp]);
+}
+
+- (NSString *)message
+{
+	if (_message == nil)
+	{
+		_message = OCLogComposeMessage(_format, _arguments);
+	}
+
+	return (_message);
+}
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, level: %ld, thread: %llu, message: %@>", NSStringFromClass(self.class), self, (long)_logLevel, _threadID, self.message]);
+}
+
+@end
@@ -28,8 +28,20 @@ NS_ASSUME_NONNULL_BEGIN
 @property(readonly, nullable) NSDate *creationDate;
 @property(readonly) int64_t size;
 
+@property(readonly,nonatomic) BOOL isBinary; //!< YES if the log file was written in OCLogFormatBinary
+@property(readonly,nonatomic) BOOL isCompressed; //!< YES if the log file is a compressed archive
+
 - (instancetype)initWithURL:(NSURL*)url;
 
+- (nullable NSData *)textDataWithError:(NSError * _Nullable * _Nullable)outError; //!< Returns the contents of the log file as UTF-8 text. Compressed and binary log files are decompressed and decoded on demand.
+- (nullable NSURL *)sharableURLWithError:(NSError * _Nullable * _Nullable)outError; //!< Returns the URL of a plain-text version of the log file, suitable for sharing. For compressed and binary log files, that's a temporary file the contents are decompressed and decoded into.
+
+#pragma mark - Compression
++ (nullable NSError *)compressFileAtURL:(NSURL *)sourceURL toURL:(NSURL *)targetURL inputSize:(nullable uint64_t *)outInputSize outputSize:(nullable uint64_t *)outOutputSize; //!< Compresses the file at sourceURL into targetURL using LZFSE, streaming it in chunks rather than loading it into memory
++ (nullable NSError *)compressFileAtURL:(NSURL *)sourceURL toURL:(NSURL *)targetURL inputSize:(nullable uint64_t *)outInputSize outputSize:(nullable uint64_t *)outOutputSize shouldContinue:(nullable BOOL(^)(void))shouldContinue; //!< Like -compressFileAtURL:toURL:inputSize:outputSize:, but calls shouldContinue after every chunk and stops with an OCErrorCancelled error (removing targetURL) if it returns NO
+
 @end
 
+extern NSString *OCLogFileRecordCompressedPathExtension;
+
 NS_ASSUME_NONNULL_END
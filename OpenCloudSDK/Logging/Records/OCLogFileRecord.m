@@ -18,6 +18,123 @@
 
 #import "OCLogFileRecord.h"
 #import <OpenCloudSDK/OCAppIdentity.h>
+#import "OCLogBinaryCoder.h"
+#import "NSError+OCError.h"
+#import <compression.h>
+
+typedef BOOL(^OCLogFileRecordOutputHandler)(const uint8_t *bytes, size_t length); //!< Receives transcoded output. Return NO to stop.
+
+static NSError *OCLogFileRecordTranscode(NSURL *sourceURL, compression_stream_operation operation, uint64_t *outInputSize, OCLogFileRecordOutputHandler outputHandler)
+{
+	const size_t bufferSize = 64 * 1024;
+	compression_stream stream;
+	uint8_t *inputBuffer = NULL, *outputBuffer = NULL;
+	uint64_t inputSize = 0;
+	BOOL inputEnded = NO;
+	NSError *error = nil;
+	int fd;
+
+	if ((fd = open(sourceURL.path.fileSystemRepresentation, O_RDONLY)) == -1)
+	{
+		return ([NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil]);
+	}
+
+	if (compression_stream_init(&stream, operation, COMPRESSION_LZFSE) != COMPRESSION_STATUS_OK)
+	{
+		close(fd);
+		return (OCError(OCErrorInternal));
+	}
+
+	inputBuffer = malloc(bufferSize);
+	outputBuffer = malloc(bufferSize);
+
+	if ((inputBuffer == NULL) || (outputBuffer == NULL))
+	{
+		error = OCError(OCErrorInternal);
+	}
+
+	stream.src_ptr = inputBuffer;
+	stream.src_size = 0;
+	stream.dst_ptr = outputBuffer;
+	stream.dst_size = bufferSize;
+
+	while (error == nil)
+	{
+		compression_status status;
+		size_t outputSpaceBefore;
+		BOOL madeProgress;
+
+		// Refill input
+		if ((stream.src_size == 0) && !inputEnded)
+		{
+			ssize_t readBytes;
+
+			if ((readBytes = read(fd, inputBuffer, bufferSize)) < 0)
+			{
+				error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+				break;
+			}
+
+			inputEnded = (readBytes == 0);
+			inputSize += (uint64_t)readBytes;
+
+			stream.src_ptr = inputBuffer;
+			stream.src_size = (size_t)readBytes;
+		}
+
+		outputSpaceBefore = stream.dst_size;
+
+		if ((status = compression_stream_process(&stream, (inputEnded ? COMPRESSION_STREAM_FINALIZE : 0))) == COMPRESSION_STATUS_ERROR)
+		{
+			error = OCError(OCErrorInternal);
+			break;
+		}
+
+		madeProgress = (stream.dst_size != outputSpaceBefore);
+
+		// Pass on output when the buffer is full or the stream has ended
+		if ((stream.dst_size == 0) || (status == COMPRESSION_STATUS_END))
+		{
+			size_t outputLength = bufferSize - stream.dst_size;
+
+			if ((outputLength > 0) && !outputHandler(outputBuffer, outputLength))
+			{
+				break;
+			}
+
+			stream.dst_ptr = outputBuffer;
+			stream.dst_size = bufferSize;
+		}
+
+		if (status == COMPRESSION_STATUS_END)
+		{
+			break;
+		}
+
+		if (inputEnded && (stream.src_size == 0) && !madeProgress)
+		{
+			// No further progress possible (truncated input): pass on what's there
+			if (stream.dst_size < bufferSize)
+			{
+				outputHandler(outputBuffer, bufferSize - stream.dst_size);
+			}
+			break;
+		}
+	}
+
+	compression_stream_destroy(&stream);
+
+	free(inputBuffer);
+	free(outputBuffer);
+	close(fd);
+
+	if (outInputSize != NULL)
+	{
+		*outInputSize = inputSize;
+	}
+
+	return (error);
+}
 
 @implementation OCLogFileRecord
 
@@ -37,6 +154,11 @@
 
 - (NSString*)name
 {
+	if (self.isCompressed)
+	{
+		return _url.lastPathComponent.stringByDeletingPathExtension;
+	}
+
 	return _url.lastPathComponent;
 }
 
@@ -63,4 +185,156 @@
 	return _creationDate;
 }
 
+- (BOOL)isCompressed
+{
+	return ([_url.pathExtension isEqual:OCLogFileRecordCompressedPathExtension]);
+}
+
+- (BOOL)isBinary
+{
+	NSMutableData *headerData = nil;
+
+	if (self.isCompressed)
+	{
+		// Only decompress the beginning
+		headerData = [NSMutableData new];
+
+		OCLogFileRecordTranscode(_url, COMPRESSION_STREAM_DECODE, NULL, ^BOOL(const uint8_t *bytes, size_t length) {
+			[headerData appendBytes:bytes length:MIN(length, 16)];
+			return (NO);
+		});
+	}
+	else
+	{
+		NSFileHandle *fileHandle;
+
+		if ((fileHandle = [NSFileHandle fileHandleForReadingFromURL:_url error:NULL]) != nil)
+		{
+			headerData = [[fileHandle readDataOfLength:16] mutableCopy];
+			[fileHandle closeFile];
+		}
+	}
+
+	return ((headerData != nil) && [OCLogBinaryDecoder isBinaryLogData:headerData]);
+}
+
+- (NSData *)textDataWithError:(NSError * _Nullable __autoreleasing *)outError
+{
+	NSData *data = nil;
+
+	if (self.isCompressed)
+	{
+		NSMutableData *decompressedData = [NSMutableData new];
+		NSError *error;
+
+		if ((error = OCLogFileRecordTranscode(_url, COMPRESSION_STREAM_DECODE, NULL, ^BOOL(const uint8_t *bytes, size_t length) {
+			[decompressedData appendBytes:bytes length:length];
+			return (YES);
+		})) != nil)
+		{
+			if (outError != NULL)
+			{
+				*outError = error;
+			}
+
+			return (nil);
+		}
+
+		data = decompressedData;
+	}
+	else
+	{
+		data = [NSData dataWithContentsOfURL:_url options:NSDataReadingMappedIfSafe error:outError];
+	}
+
+	if ((data != nil) && [OCLogBinaryDecoder isBinaryLogData:data])
+	{
+		data = [[[OCLogBinaryDecoder alloc] initWithData:data] composedTextData];
+	}
+
+	return (data);
+}
+
+- (NSURL *)sharableURLWithError:(NSError * _Nullable __autoreleasing *)outError
+{
+	NSURL *sharableURL = nil;
+	NSData *textData;
+
+	if (!self.isCompressed && !self.isBinary)
+	{
+		return (_url);
+	}
+
+	if ((textData = [self textDataWithError:outError]) != nil)
+	{
+		NSURL *temporaryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:self.name];
+
+		if ([textData writeToURL:temporaryURL options:NSDataWritingAtomic error:outError])
+		{
+			sharableURL = temporaryURL;
+		}
+	}
+
+	return (sharableURL);
+}
+
+#pragma mark - Compression
++ (NSError *)compressFileAtURL:(NSURL *)sourceURL toURL:(NSURL *)targetURL inputSize:(uint64_t *)outInputSize outputSize:(uint64_t *)outOutputSize
+{
+	return ([self compressFileAtURL:sourceURL toURL:targetURL inputSize:outInputSize outputSize:outOutputSize shouldContinue:nil]);
+}
+
++ (NSError *)compressFileAtURL:(NSURL *)sourceURL toURL:(NSURL *)targetURL inputSize:(uint64_t *)outInputSize outputSize:(uint64_t *)outOutputSize shouldContinue:(BOOL(^)(void))shouldContinue
+{
+	__block uint64_t outputSize = 0;
+	__block NSError *writeError = nil;
+	NSError *error;
+	int targetFD;
+
+	if ((targetFD = open(targetURL.path.fileSystemRepresentation, O_WRONLY|O_CREAT|O_TRUNC, S_IRUSR|S_IWUSR)) == -1)
+	{
+		return ([NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil]);
+	}
+
+	error = OCLogFileRecordTranscode(sourceURL, COMPRESSION_STREAM_ENCODE, outInputSize, ^BOOL(const uint8_t *bytes, size_t length) {
+		if (write(targetFD, bytes, length) != (ssize_t)length)
+		{
+			writeError = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+			return (NO);
+		}
+
+		outputSize += length;
+
+		if ((shouldContinue != nil) && !shouldContinue())
+		{
+			writeError = OCError(OCErrorCancelled);
+			return (NO);
+		}
+
+		return (YES);
+	});
+
+	close(targetFD);
+
+	if (error == nil)
+	{
+		error = writeError;
+	}
+
+	if (error != nil)
+	{
+		// Don't leave a partial archive behind
+		unlink(targetURL.path.fileSystemRepresentation);
+	}
+
+	if (outOutputSize != NULL)
+	{
+		*outOutputSize = outputSize;
+	}
+
+	return (error);
+}
+
 @end
+
+NSString *OCLogFileRecordCompressedPathExtension = @"lzfse";
@@ -19,8 +19,12 @@
 #import "OCLogFileWriter.h"
 #import "OCAppIdentity.h"
 #import "OCMacros.h"
+#import "OCLogBinaryCoder.h"
+#import "NSError+OCError.h"
 
 NSUInteger const OCDefaultMaxLogFileCount = 10;
+static NSString *OCLogFileWriterPartialArchivePathExtension = @"partial";
+static NSTimeInterval OCLogFileWriterStalePartialArchiveAge = 5.0 * 60.0; // partial archives that weren't modified for this long are leftovers of an interrupted compression
 NSTimeInterval const OCDefaultRotationTimeInterval = 60.0 * 60.0 * 24.0;
 int64_t const OCDefaultLogRotationFrequency = 60 * NSEC_PER_SEC;
 
@@ -33,7 +37,18 @@ OCIPCNotificationName OCLogFileWriterLogRecordsChangedRemoteNotification = @"org
 	dispatch_source_t _logRotationTimerSource;
 
 	NSUInteger _maximumLogFileCount;
+	uint64_t _maximumStorageSize;
 
+	BOOL _compressArchives;
+	dispatch_queue_t _archiveQueue; // serializes compression and clean up
+	NSUInteger _archiveGeneration; // incremented when removing all logs, so that queued and running compressions are discarded
+	BOOL _performedInitialCleanUp;
+
+	uint64_t _bytesWritten;
+	uint64_t _writeDuration;
+	uint64_t _writeStartTime;
+
+	OCLogBinaryEncoder *_binaryEncoder;
 }
 @end
 
@@ -69,6 +84,9 @@ static NSURL *sDefaultLogFileURL;
 		_logFileURL = url;
 		_maximumLogFileCount = OCDefaultMaxLogFileCount;
 		_rotationInterval = OCDefaultRotationTimeInterval;
+		_maximumStorageSize = [[OCLogger classSettingForOCClassSettingsKey:OCClassSettingsKeyLogMaximumStorageSize] unsignedLongLongValue];
+		_compressArchives = [[OCLogger classSettingForOCClassSettingsKey:OCClassSettingsKeyLogCompressArchives] boolValue];
+		_archiveQueue = dispatch_queue_create("OCLogFileWriter archive queue", DISPATCH_QUEUE_SERIAL_WITH_AUTORELEASE_POOL);
 
 		[OCIPNotificationCenter.sharedNotificationCenter addObserver:self forName:OCLogFileWriterLogRecordsChangedRemoteNotification withHandler:^(OCIPNotificationCenter * _Nonnull notificationCenter, id  _Nonnull observer, OCIPCNotificationName  _Nonnull notificationName) {
 			[[NSNotificationCenter defaultCenter] postNotificationName:OCLogFileWriterLogRecordsChangedNotification object:nil];
@@ -99,6 +117,21 @@ static NSURL *sDefaultLogFileURL;
 		{
 			_isOpen = YES;
 
+			_bytesWritten = 0;
+			_writeDuration = 0;
+			_writeStartTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+
+			if (self.supportsBinaryMessages)
+			{
+				// Every (re-)opened file starts a new session, which binary messages can be decoded from without any prior context
+				if (_binaryEncoder == nil)
+				{
+					_binaryEncoder = [OCLogBinaryEncoder new];
+				}
+
+				[self appendMessageData:[_binaryEncoder sessionHeaderDataWithProcessName:NSProcessInfo.processInfo.processName processID:getpid()]];
+			}
+
 			// Write the LogIntro synchronously to ensure these lines are written
 			// at the start of the logfile and can't get rerouted due to log rotation
 			OCPFSLog(nil, (@[@"LogIntro"]), @"Starting logging to %@", _logFileURL.path);
@@ -139,6 +172,16 @@ static NSURL *sDefaultLogFileURL;
 			dispatch_resume(_logFileVnodeSource);
 
 			[self _scheduleLogRotationTimer];
+
+			if (!_performedInitialCleanUp)
+			{
+				// Remove leftovers from, and complete, compressions interrupted by a previous termination
+				_performedInitialCleanUp = YES;
+
+				dispatch_async(_archiveQueue, ^{
+					[self _cleanUpLogs:NO];
+				});
+			}
 		}
 		else
 		{
@@ -174,15 +217,59 @@ static NSURL *sDefaultLogFileURL;
 	return (error);
 }
 
+- (BOOL)supportsBinaryMessages
+{
+	return (OCLogger.logFormat == OCLogFormatBinary);
+}
+
+- (void)appendBinaryMessage:(OCLogBinaryMessage *)message
+{
+	if (_isOpen && (_binaryEncoder != nil))
+	{
+		[self appendMessageData:[_binaryEncoder dataForMessage:message]];
+	}
+}
+
+- (void)appendMessageWithLogLevel:(OCLogLevel)logLevel date:(NSDate *)date threadID:(uint64_t)threadID isMainThread:(BOOL)isMainThread privacyMasked:(BOOL)privacyMasked functionName:(NSString *)functionName file:(NSString *)file line:(NSUInteger)line tags:(NSArray<OCLogTagName> *)tags flags:(OCLogLineFlag)flags message:(NSString *)message
+{
+	if (self.supportsBinaryMessages)
+	{
+		// Messages that have already been formatted (f.ex. synchronously written ones) are stored as binary messages with a single argument
+		OCLogBinaryMessage *binaryMessage = [[OCLogBinaryMessage alloc] initWithLogLevel:logLevel timestamp:date.timeIntervalSinceReferenceDate threadID:threadID functionName:functionName file:file line:line tags:tags format:@"%@" arguments:@[ message ]];
+
+		binaryMessage.isMainThread = isMainThread;
+		binaryMessage.privacyMasked = privacyMasked;
+
+		[self appendBinaryMessage:binaryMessage];
+		return;
+	}
+
+	[super appendMessageWithLogLevel:logLevel date:date threadID:threadID isMainThread:isMainThread privacyMasked:privacyMasked functionName:functionName file:file line:line tags:tags flags:flags message:message];
+}
+
 - (void)appendMessageData:(NSData *)data
 {
 	if (_isOpen && (data != nil))
 	{
-		write(_logFileFD, data.bytes, (size_t)data.length);
+		uint64_t startTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+		ssize_t writtenBytes;
+
+		if ((writtenBytes = write(_logFileFD, data.bytes, (size_t)data.length)) > 0)
+		{
+			_bytesWritten += (uint64_t)writtenBytes;
+		}
+
+		_writeDuration += clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - startTime;
 	}
 }
 
 - (NSArray<OCLogFileRecord*>*)logRecords
+{
+	// Skip archives that are still being compressed
+	return ([self _logRecordsIncludingPartialArchives:NO]);
+}
+
+- (NSArray<OCLogFileRecord*>*)_logRecordsIncludingPartialArchives:(BOOL)includePartialArchives
 {
 	NSError *error = nil;
 
@@ -197,6 +284,11 @@ static NSURL *sDefaultLogFileURL;
 	// Create an array of log records
 	for (NSURL* url in urls)
 	{
+		if (!includePartialArchives && [url.pathExtension isEqual:OCLogFileWriterPartialArchivePathExtension])
+		{
+			continue;
+		}
+
 		OCLogFileRecord *record = [[OCLogFileRecord alloc] initWithURL:url];
 		[records addObject:record];
 	}
@@ -227,12 +319,88 @@ static NSURL *sDefaultLogFileURL;
 
 - (void)cleanUpLogs:(BOOL)removeAll
 {
-	NSMutableArray<OCLogFileRecord*> *logRecords = [NSMutableArray arrayWithArray:[self logRecords]];
+	if (removeAll)
+	{
+		// Discard compressions that are queued or running, so they can't bring back archives
+		@synchronized(self)
+		{
+			_archiveGeneration++;
+		}
+	}
+
+	dispatch_sync(_archiveQueue, ^{
+		[self _cleanUpLogs:removeAll];
+	});
+}
+
+- (void)_cleanUpLogs:(BOOL)removeAll
+{
+	NSMutableArray<OCLogFileRecord*> *logRecords = [NSMutableArray new];
+	NSMutableArray<OCLogFileRecord*> *partialArchiveRecords = [NSMutableArray new];
+	NSString *currentLogFilePath = self.logFileURL.URLByStandardizingPath.path;
+	NSString *logFileName = self.logFileURL.lastPathComponent;
+	BOOL deletionRequired = NO;
+
+	for (OCLogFileRecord *record in [self _logRecordsIncludingPartialArchives:YES])
+	{
+		if ([record.url.pathExtension isEqual:OCLogFileWriterPartialArchivePathExtension])
+		{
+			NSDate *modificationDate = [self _attributesForPath:record.url.path][NSFileModificationDate];
+
+			// Remove partial archives, unless they are still being written to (f.ex. by another process)
+			if (removeAll || (modificationDate == nil) || (-modificationDate.timeIntervalSinceNow > OCLogFileWriterStalePartialArchiveAge))
+			{
+				[self deleteLogRecord:record];
+				deletionRequired = YES;
+			}
+			else
+			{
+				[partialArchiveRecords addObject:record];
+			}
+		}
+		else
+		{
+			[logRecords addObject:record];
+		}
+	}
+
+	if (_compressArchives && !removeAll)
+	{
+		// Compress archived logs whose compression was interrupted or never started
+		NSUInteger generation = [self _currentArchiveGeneration];
+
+		for (NSUInteger idx=0; idx < logRecords.count; idx++)
+		{
+			OCLogFileRecord *record = logRecords[idx];
+			BOOL compressionInProgress = NO;
+			NSURL *compressedURL;
+
+			if (record.isCompressed ||
+			    ![record.name hasPrefix:logFileName] ||
+			    [record.url.URLByStandardizingPath.path isEqual:currentLogFilePath])
+			{
+				continue;
+			}
+
+			for (OCLogFileRecord *partialArchiveRecord in partialArchiveRecords)
+			{
+				if ([partialArchiveRecord.name hasPrefix:record.name])
+				{
+					compressionInProgress = YES;
+					break;
+				}
+			}
+
+			if (!compressionInProgress && ((compressedURL = [self _compressArchivedLogAtPath:record.url.path generation:generation]) != nil))
+			{
+				logRecords[idx] = [[OCLogFileRecord alloc] initWithURL:compressedURL];
+			}
+		}
+	}
 
 	NSUInteger maxFileCountToKeep = removeAll ? 0 : _maximumLogFileCount;
 
-	BOOL deletionRequired = [logRecords count] > maxFileCountToKeep;
-	if (deletionRequired)
+	if ([logRecords count] > maxFileCountToKeep)
 	{
 		// Remove old files which are exceeding maximum allowed file count
 		while ([logRecords count] > maxFileCountToKeep) {
@@ -241,6 +409,41 @@ static NSURL *sDefaultLogFileURL;
 			[logRecords removeObjectAtIndex:0];
 		}
 
+		deletionRequired = YES;
+	}
+
+	if ((_maximumStorageSize > 0) && !removeAll)
+	{
+		uint64_t totalSize = 0;
+
+		// Archives being compressed take up storage, too
+		for (OCLogFileRecord *record in [logRecords arrayByAddingObjectsFromArray:partialArchiveRecords])
+		{
+			totalSize += (uint64_t)MAX(record.size, 0);
+		}
+
+		// Remove oldest files until the total size is within the storage budget, but always keep the current log file
+		for (OCLogFileRecord *record in [logRecords copy])
+		{
+			if (totalSize <= _maximumStorageSize)
+			{
+				break;
+			}
+
+			if ([record.url.URLByStandardizingPath.path isEqual:currentLogFilePath])
+			{
+				continue;
+			}
+
+			[self deleteLogRecord:record];
+			totalSize -= (uint64_t)MAX(record.size, 0);
+
+			deletionRequired = YES;
+		}
+	}
+
+	if (deletionRequired)
+	{
 		[self _notifyAboutChangesInLogStorage];
 	}
 }
@@ -255,14 +458,100 @@ static NSURL *sDefaultLogFileURL;
 
 	NSString *archivedLogPath = [self.logFileURL.path stringByAppendingFormat:@".%@", transformedTimestamp];
 
+	// Writer throughput since the log file was opened
+	uint64_t bytesWritten = _bytesWritten, writeDuration = _writeDuration;
+	NSTimeInterval openDuration = ((NSTimeInterval)(clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - _writeStartTime)) / NSEC_PER_SEC;
+
 	// Rename current log and start new one
-	[[NSFileManager defaultManager] moveItemAtPath:self.logFileURL.path toPath:archivedLogPath error:&error];
+	if (![[NSFileManager defaultManager] moveItemAtPath:self.logFileURL.path toPath:archivedLogPath error:&error])
+	{
+		archivedLogPath = nil;
+	}
 
 	// Notify about addition of a new file
 	[self _notifyAboutChangesInLogStorage];
 
-	// Check if some old logs can be deleted
-	[self cleanUpLogs:NO];
+	if (_compressArchives && (archivedLogPath != nil))
+	{
+		NSUInteger generation = [self _currentArchiveGeneration];
+
+		// Compress archived log in the background, then clean up
+		dispatch_async(_archiveQueue, ^{
+			[self _compressArchivedLogAtPath:archivedLogPath generation:generation];
+
+			OCTLogDebug(@[@"LogArchive"], @"Writer throughput: %llu bytes in %.1f sec, %.1f MB/s while writing", bytesWritten, openDuration, ((writeDuration > 0) ? (((double)bytesWritten / (1024.0 * 1024.0)) / ((double)writeDuration / NSEC_PER_SEC)) : 0));
+
+			[self _cleanUpLogs:NO];
+		});
+	}
+	else
+	{
+		// Check if some old logs can be deleted
+		dispatch_async(_archiveQueue, ^{
+			[self _cleanUpLogs:NO];
+		});
+	}
+}
+
+- (NSUInteger)_currentArchiveGeneration
+{
+	@synchronized(self)
+	{
+		return (_archiveGeneration);
+	}
+}
+
+- (nullable NSURL *)_compressArchivedLogAtPath:(NSString *)archivedLogPath generation:(NSUInteger)generation
+{
+	NSURL *sourceURL = [NSURL fileURLWithPath:archivedLogPath];
+	NSURL *partialURL = [sourceURL URLByAppendingPathExtension:[OCLogFileRecordCompressedPathExtension stringByAppendingFormat:@".%@", OCLogFileWriterPartialArchivePathExtension]];
+	NSURL *compressedURL = [sourceURL URLByAppendingPathExtension:OCLogFileRecordCompressedPathExtension];
+	NSDate *creationDate = [self _attributesForPath:archivedLogPath][NSFileCreationDate];
+	uint64_t inputSize = 0, outputSize = 0;
+	uint64_t startTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+	NSTimeInterval duration;
+	NSError *error;
+
+	if ([self _currentArchiveGeneration] != generation)
+	{
+		// All logs were removed since the compression was queued
+		return (nil);
+	}
+
+	if ((error = [OCLogFileRecord compressFileAtURL:sourceURL toURL:partialURL inputSize:&inputSize outputSize:&outputSize shouldContinue:^BOOL{
+		return ([self _currentArchiveGeneration] == generation);
+	}]) != nil)
+	{
+		if (![error isOCErrorWithCode:OCErrorCancelled])
+		{
+			OCTLogError(@[@"LogArchive"], @"Error compressing %@: %@", archivedLogPath.lastPathComponent, error);
+		}
+
+		return (nil);
+	}
+
+	// Preserve the creation date, so the archive keeps its place in the sort order of the log records
+	if (creationDate != nil)
+	{
+		[[NSFileManager defaultManager] setAttributes:@{ NSFileCreationDate : creationDate } ofItemAtPath:partialURL.path error:NULL];
+	}
+
+	if (![[NSFileManager defaultManager] moveItemAtURL:partialURL toURL:compressedURL error:&error])
+	{
+		OCTLogError(@[@"LogArchive"], @"Error moving compressed archive into place: %@", error);
+		[[NSFileManager defaultManager] removeItemAtURL:partialURL error:NULL];
+		return (nil);
+	}
+
+	[self _eraseOrTruncate:sourceURL];
+
+	duration = ((NSTimeInterval)(clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - startTime)) / NSEC_PER_SEC;
+
+	OCTLogDebug(@[@"LogArchive"], @"Compressed %@: %llu -> %llu bytes (ratio %.2f) in %.2f sec (%.1f MB/s)", compressedURL.lastPathComponent, inputSize, outputSize, ((outputSize > 0) ? ((double)inputSize / (double)outputSize) : 0), duration, ((duration > 0) ? (((double)inputSize / (1024.0 * 1024.0)) / duration) : 0));
+
+	[self _notifyAboutChangesInLogStorage];
+
+	return (compressedURL);
 }
 
 #pragma mark - Private methods
@@ -19,6 +19,7 @@
 #import <Foundation/Foundation.h>
 #import "OCLogger.h"
 #import "OCLogComponent.h"
+#import "OCLogBinaryMessage.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -59,7 +60,12 @@ typedef void(^OCLogWriteHandler)(NSData *messageData);
 - (void)appendMessageWithLogLevel:(OCLogLevel)logLevel date:(NSDate *)date threadID:(uint64_t)threadID isMainThread:(BOOL)isMainThread privacyMasked:(BOOL)privacyMasked functionName:(NSString *)functionName file:(NSString *)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags flags:(OCLogLineFlag)flags message:(NSString *)message; //!< By default composes the parameters and calls -appendMessage:
 - (void)appendMessageData:(NSData *)data; //!< Called by the default implementation of -appendMessageWithLogLevel:functionName:file:line:message:
 
+#pragma mark - Binary messages
+@property(readonly,nonatomic) BOOL supportsBinaryMessages; //!< YES if the writer can store binary messages without having them formatted first. NO by default.
+- (void)appendBinaryMessage:(OCLogBinaryMessage *)message; //!< Called for messages recorded in OCLogFormatBinary. By default formats the message and calls -appendMessageWithLogLevel:…
+
 + (NSString*)timestampStringFrom:(NSDate*)date;
++ (nullable NSString *)composedTextLineWithLogLevel:(OCLogLevel)logLevel date:(NSDate *)date processName:(NSString *)processName processID:(pid_t)processID threadID:(uint64_t)threadID isMainThread:(BOOL)isMainThread privacyMasked:(BOOL)privacyMasked file:(nullable NSString *)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags flags:(OCLogLineFlag)flags message:(NSString *)message; //!< Composes a line of text in the format used by OCLogFormatText
 
 @end
 
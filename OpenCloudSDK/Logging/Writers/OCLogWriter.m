@@ -20,6 +20,28 @@
 #import "OCAppIdentity.h"
 #import "OCMacros.h"
 
+static void OCLogWriterComposeTags(NSArray<OCLogTagName> *tags, NSString **outLeadingTags, NSString **outTrailingTags)
+{
+	if ((tags != nil) && (tags.count > 0))
+	{
+		if (tags.count < 3)
+		{
+			*outLeadingTags = [[NSString alloc] initWithFormat:@"[%@] ", [tags componentsJoinedByString:@", "]];
+			*outTrailingTags = @"";
+		}
+		else
+		{
+			*outLeadingTags = [[NSString alloc] initWithFormat:@"[%@, …] ", [[tags subarrayWithRange:NSMakeRange(0, 2)] componentsJoinedByString:@", "]];
+			*outTrailingTags = [[NSString alloc] initWithFormat:@" [… %@]", [[tags subarrayWithRange:NSMakeRange(2, tags.count-2)] componentsJoinedByString:@", "]];
+		}
+	}
+	else
+	{
+		*outLeadingTags = @"";
+		*outTrailingTags = @"";
+	}
+}
+
 @implementation OCLogWriter
 
 static NSString *processName;
@@ -75,103 +97,92 @@ static NSDateFormatter *jsonDateFormatter;
 	return [dateFormatter stringFromDate:date];
 }
 
-- (void)appendMessageWithLogLevel:(OCLogLevel)logLevel date:(NSDate *)date threadID:(uint64_t)threadID isMainThread:(BOOL)isMainThread privacyMasked:(BOOL)privacyMasked functionName:(NSString *)functionName file:(NSString *)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags flags:(OCLogLineFlag)flags message:(NSString *)message
++ (nullable NSString *)composedTextLineWithLogLevel:(OCLogLevel)logLevel date:(NSDate *)date processName:(NSString *)logProcessName processID:(pid_t)processID threadID:(uint64_t)threadID isMainThread:(BOOL)isMainThread privacyMasked:(BOOL)privacyMasked file:(nullable NSString *)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags flags:(OCLogLineFlag)flags message:(NSString *)message
 {
-	OCLogFormat logFormat = OCLogger.logFormat;
-	NSString *composedMessage = nil;
+	NSString *logLevelName = nil, *timestampString = nil, *leadingTags = nil, *trailingTags = nil, *separator = @"|";
 
-	if ((logFormat == OCLogFormatText) || (logFormat == OCLogFormatJSONComposed))
+	switch (logLevel)
 	{
-		NSString *logLevelName = nil, *timestampString = nil, *leadingTags = nil, *trailingTags = nil, *separator = @"|";
+		case OCLogLevelVerbose:
+			logLevelName = OCLogger.coloredLogging ? @"◻️" : @"[verb]";
+		break;
 
-		if (logFormat == OCLogFormatText)
-		{
-			switch (logLevel)
-			{
-				case OCLogLevelVerbose:
-					logLevelName = OCLogger.coloredLogging ? @"◻️" : @"[verb]";
-				break;
+		case OCLogLevelDebug:
+			logLevelName = OCLogger.coloredLogging ? @"⚪️" : @"[dbug]";
+		break;
 
-				case OCLogLevelDebug:
-					logLevelName = OCLogger.coloredLogging ? @"⚪️" : @"[dbug]";
-				break;
+		case OCLogLevelInfo:
+			logLevelName = OCLogger.coloredLogging ? @"🔵" : @"[info]";
+		break;
 
-				case OCLogLevelInfo:
-					logLevelName = OCLogger.coloredLogging ? @"🔵" : @"[info]";
-				break;
+		case OCLogLevelWarning:
+			logLevelName = OCLogger.coloredLogging ? @"⚠️" : @"[WARN]";
+		break;
 
-				case OCLogLevelWarning:
-					logLevelName = OCLogger.coloredLogging ? @"⚠️" : @"[WARN]";
-				break;
+		case OCLogLevelError:
+			logLevelName = OCLogger.coloredLogging ? @"🛑" : @"[ERRO]";
+		break;
 
-				case OCLogLevelError:
-					logLevelName = OCLogger.coloredLogging ? @"🛑" : @"[ERRO]";
-				break;
+		case OCLogLevelOff:
+			return (nil);
+		break;
+	}
 
-				case OCLogLevelOff:
-					return;
-				break;
-			}
-		}
+	OCLogWriterComposeTags(tags, &leadingTags, &trailingTags);
 
-		if ((tags != nil) && (tags.count > 0))
-		{
-			if (tags.count < 3)
-			{
-				leadingTags = [[NSString alloc] initWithFormat:@"[%@] ", [tags componentsJoinedByString:@", "]];
-				trailingTags = @"";
-			}
-			else
-			{
-				leadingTags = [[NSString alloc] initWithFormat:@"[%@, …] ", [[tags subarrayWithRange:NSMakeRange(0, 2)] componentsJoinedByString:@", "]];
-				trailingTags = [[NSString alloc] initWithFormat:@" [… %@]", [[tags subarrayWithRange:NSMakeRange(2, tags.count-2)] componentsJoinedByString:@", "]];
-			}
-		}
-		else
+	if (flags & OCLogLineFlagSingleLinesModeEnabled)
+	{
+		if ((flags & (OCLogLineFlagLineFirst|OCLogLineFlagLineLast)) != (OCLogLineFlagLineFirst|OCLogLineFlagLineLast))
 		{
-			leadingTags = @"";
-			trailingTags = @"";
-		}
+			separator = @"┃";
 
-		if (logFormat == OCLogFormatText)
-		{
-			if (flags & OCLogLineFlagSingleLinesModeEnabled)
+			// if (flags & OCLogLineFlagTotalLineCountGreaterTwo)
 			{
-				if ((flags & (OCLogLineFlagLineFirst|OCLogLineFlagLineLast)) != (OCLogLineFlagLineFirst|OCLogLineFlagLineLast))
+				if (flags & OCLogLineFlagLineFirst)
 				{
-					separator = @"┃";
-
-					// if (flags & OCLogLineFlagTotalLineCountGreaterTwo)
-					{
-						if (flags & OCLogLineFlagLineFirst)
-						{
-							separator = @"┓";
-						}
-
-						if (flags & OCLogLineFlagLineLast)
-						{
-							separator = @"┛";
-						}
-					}
+					separator = @"┓";
 				}
-			}
 
-			timestampString = [dateFormatter stringFromDate:date];
-
-			if ((composedMessage = [[NSString alloc] initWithFormat:@"%@ %@[%d%@%06llu] %@ %@ %@%@%@ [%@:%lu|%@]\n", timestampString, processName, getpid(), (isMainThread ? @"." : @":"), threadID, logLevelName, separator, leadingTags, message, trailingTags, [file lastPathComponent], (unsigned long)line, (privacyMasked ? @"MASKED" : @"FULL")]) != nil)
-			{
-				NSData *messageData;
-
-				if ((messageData = [composedMessage dataUsingEncoding:NSUTF8StringEncoding]) != nil)
+				if (flags & OCLogLineFlagLineLast)
 				{
-					[self appendMessageData:messageData];
+					separator = @"┛";
 				}
 			}
 		}
-		else if (logFormat == OCLogFormatJSONComposed)
+	}
+
+	timestampString = [dateFormatter stringFromDate:date];
+
+	return ([[NSString alloc] initWithFormat:@"%@ %@[%d%@%06llu] %@ %@ %@%@%@ [%@:%lu|%@]\n", timestampString, logProcessName, processID, (isMainThread ? @"." : @":"), threadID, logLevelName, separator, leadingTags, message, trailingTags, [file lastPathComponent], (unsigned long)line, (privacyMasked ? @"MASKED" : @"FULL")]);
+}
+
+- (void)appendMessageWithLogLevel:(OCLogLevel)logLevel date:(NSDate *)date threadID:(uint64_t)threadID isMainThread:(BOOL)isMainThread privacyMasked:(BOOL)privacyMasked functionName:(NSString *)functionName file:(NSString *)file line:(NSUInteger)line tags:(nullable NSArray<OCLogTagName> *)tags flags:(OCLogLineFlag)flags message:(NSString *)message
+{
+	OCLogFormat logFormat = OCLogger.logFormat;
+	NSString *composedMessage = nil;
+
+	if ((logFormat == OCLogFormatText) || (logFormat == OCLogFormatBinary)) // Writers without support for binary messages log them as text
+	{
+		if ((composedMessage = [OCLogWriter composedTextLineWithLogLevel:logLevel date:date processName:processName processID:getpid() threadID:threadID isMainThread:isMainThread privacyMasked:privacyMasked file:file line:line tags:tags flags:flags message:message]) != nil)
 		{
-			composedMessage = [[NSString alloc] initWithFormat:@"%@[%d%@%06llu] | %@%@%@ [%@:%lu]", processName, getpid(), (isMainThread ? @"." : @":"), threadID, leadingTags, message, trailingTags, [file lastPathComponent], (unsigned long)line];
+			NSData *messageData;
+
+			if ((messageData = [composedMessage dataUsingEncoding:NSUTF8StringEncoding]) != nil)
+			{
+				[self appendMessageData:messageData];
+			}
 		}
+
+		return;
+	}
+
+	if (logFormat == OCLogFormatJSONComposed)
+	{
+		NSString *leadingTags = nil, *trailingTags = nil;
+
+		OCLogWriterComposeTags(tags, &leadingTags, &trailingTags);
+
+		composedMessage = [[NSString alloc] initWithFormat:@"%@[%d%@%06llu] | %@%@%@ [%@:%lu]", processName, getpid(), (isMainThread ? @"." : @":"), threadID, leadingTags, message, trailingTags, [file lastPathComponent], (unsigned long)line];
 	}
 
 	if ((logFormat == OCLogFormatJSON) || (logFormat == OCLogFormatJSONComposed))
@@ -182,7 +193,9 @@ static NSDateFormatter *jsonDateFormatter;
 
 		switch (logFormat)
 		{
-			case OCLogFormatText: break;
+			case OCLogFormatText:
+			case OCLogFormatBinary:
+			break;
 
 			case OCLogFormatJSON:
 				jsonLineData = [NSJSONSerialization dataWithJSONObject:@{
@@ -217,6 +230,16 @@ static NSDateFormatter *jsonDateFormatter;
 	}
 }
 
+- (BOOL)supportsBinaryMessages
+{
+	return (NO);
+}
+
+- (void)appendBinaryMessage:(OCLogBinaryMessage *)message
+{
+	[self appendMessageWithLogLevel:message.logLevel date:message.date threadID:message.threadID isMainThread:message.isMainThread privacyMasked:message.privacyMasked functionName:message.functionName file:message.file line:message.line tags:message.tags flags:(OCLogLineFlagLineFirst|OCLogLineFlagLineLast) message:message.message];
+}
+
 - (void)appendMessageData:(NSData *)messageData
 {
 	if ((_writeHandler != nil) && (messageData != nil))
@@ -49,6 +49,8 @@ typedef NSString* OCMeasurementIdentifier;
 
 @property(assign) BOOL autoSummarize;
 
+@property(readonly,strong) NSArray<OCMeasurementEvent *> *events;
+
 + (nullable instancetype)measurementWithTitle:(nullable NSString *)title;
 
 - (OCMeasurementEventReference)emitEvent:(OCMeasurementEvent *)event;
@@ -57,6 +59,10 @@ typedef NSString* OCMeasurementIdentifier;
 - (void)terminate;
 - (void)logIfNeeded:(BOOL)ifNeeded;
 
+#pragma mark - Evaluation
+- (NSDictionary<OCMeasurementEventIdentifier, NSNumber *> *)durationsByEventIdentifier; //!< Total duration (in seconds) of all completed events, by event identifier. Based on monotonic timestamps.
+- (nullable NSData *)chromeTraceEventJSONData; //!< Events in the Chrome Trace Event Format, for viewing in chrome://tracing or Perfetto. Completed events are exported as complete ("X") events, all others as instant events.
+
 @end
 
 @interface NSObject (MeasurementExtractor)
@@ -193,6 +193,133 @@
 	}
 }
 
+#pragma mark - Evaluation
+- (NSArray<OCMeasurementEvent *> *)events
+{
+	@synchronized(self)
+	{
+		return ([_events copy]);
+	}
+}
+
+- (nullable OCMeasurementEvent *)_startEventForEvent:(OCMeasurementEvent *)completeEvent inEvents:(NSArray<OCMeasurementEvent *> *)events
+{
+	for (OCMeasurementEvent *event in events)
+	{
+		if ((event.progress == OCMeasurementEventProgressStarted) && (event.timestamp == completeEvent.relatedEventReference) && [event.identifier isEqual:completeEvent.identifier])
+		{
+			return (event);
+		}
+	}
+
+	return (nil);
+}
+
+- (NSDictionary<OCMeasurementEventIdentifier, NSNumber *> *)durationsByEventIdentifier
+{
+	NSArray<OCMeasurementEvent *> *events = self.events;
+	NSMutableDictionary<OCMeasurementEventIdentifier, NSNumber *> *durationsByEvent = [NSMutableDictionary new];
+
+	for (OCMeasurementEvent *event in events)
+	{
+		if (event.progress == OCMeasurementEventProgressComplete)
+		{
+			OCMeasurementEvent *startEvent = [self _startEventForEvent:event inEvents:events];
+			NSTimeInterval duration = (startEvent != nil) ? (event.monotonicTimestamp - startEvent.monotonicTimestamp) : (event.timestamp - event.relatedEventReference);
+
+			durationsByEvent[event.identifier] = @(durationsByEvent[event.identifier].doubleValue + duration);
+		}
+	}
+
+	return (durationsByEvent);
+}
+
+static NSNumber *OCMeasurementTraceMicroseconds(NSTimeInterval seconds)
+{
+	return (@((long long)(seconds * 1000000.0)));
+}
+
+- (nullable NSData *)chromeTraceEventJSONData
+{
+	NSArray<OCMeasurementEvent *> *events = self.events;
+	NSMutableArray<NSDictionary<NSString *, id> *> *traceEvents = [NSMutableArray new];
+	NSMapTable<OCMeasurementEvent *, OCMeasurementEvent *> *startEventsByCompleteEvent = [NSMapTable strongToStrongObjectsMapTable];
+	NSMutableSet<OCMeasurementEvent *> *pairedStartEvents = [NSMutableSet new];
+	NSNumber *processID = @(NSProcessInfo.processInfo.processIdentifier);
+	NSTimeInterval baseTimestamp = events.firstObject.monotonicTimestamp;
+
+	[traceEvents addObject:@{
+		@"name" : @"process_name",
+		@"ph"	: @"M",
+		@"pid"	: processID,
+		@"args"	: @{ @"name" : ((self.title != nil) ? self.title : _identifier) }
+	}];
+
+	// Pair completed events with their start events
+	for (OCMeasurementEvent *event in events)
+	{
+		if (event.progress == OCMeasurementEventProgressComplete)
+		{
+			OCMeasurementEvent *startEvent;
+
+			if ((startEvent = [self _startEventForEvent:event inEvents:events]) != nil)
+			{
+				[startEventsByCompleteEvent setObject:startEvent forKey:event];
+				[pairedStartEvents addObject:startEvent];
+			}
+		}
+	}
+
+	for (OCMeasurementEvent *event in events)
+	{
+		OCMeasurementEvent *startEvent;
+
+		if ([pairedStartEvents containsObject:event])
+		{
+			// Part of a complete event
+			continue;
+		}
+
+		if ((startEvent = [startEventsByCompleteEvent objectForKey:event]) != nil)
+		{
+			[traceEvents addObject:@{
+				@"name"	: event.identifier,
+				@"cat"	: @"measurement",
+				@"ph"	: @"X",
+				@"ts"	: OCMeasurementTraceMicroseconds(startEvent.monotonicTimestamp - baseTimestamp),
+				@"dur"	: OCMeasurementTraceMicroseconds(event.monotonicTimestamp - startEvent.monotonicTimestamp),
+				@"pid"	: processID,
+				@"tid"	: @(startEvent.threadID),
+				@"args"	: @{
+					@"begin" : ((startEvent.message != nil) ? startEvent.message : @""),
+					@"end"	 : ((event.message != nil) ? event.message : @"")
+				}
+			}];
+
+			continue;
+		}
+
+		[traceEvents addObject:@{
+			@"name"	: event.identifier,
+			@"cat"	: @"measurement",
+			@"ph"	: @"i",
+			@"s"	: @"t",
+			@"ts"	: OCMeasurementTraceMicroseconds(event.monotonicTimestamp - baseTimestamp),
+			@"pid"	: processID,
+			@"tid"	: @(event.threadID),
+			@"args"	: @{
+				@"message"  : ((event.message != nil) ? event.message : @""),
+				@"progress" : @(event.progress)
+			}
+		}];
+	}
+
+	return ([NSJSONSerialization dataWithJSONObject:@{
+		@"traceEvents" 	   : traceEvents,
+		@"displayTimeUnit" : @"ms"
+	} options:NSJSONWritingSortedKeys error:NULL]);
+}
+
 + (NSArray<OCLogTagName> *)logTags
 {
 	return (@[@"Measure"]);
@@ -33,6 +33,8 @@ NS_ASSUME_NONNULL_BEGIN
 @interface OCMeasurementEvent : NSObject
 
 @property(readonly) NSTimeInterval timestamp;
+@property(readonly) NSTimeInterval monotonicTimestamp; //!< Seconds on a monotonic clock, unaffected by changes to the system clock
+@property(readonly) uint64_t threadID; //!< ID of the thread the event was created on
 @property(readonly) OCMeasurementEventIdentifier identifier;
 @property(readonly,nullable) NSString *message;
 @property(readonly) OCMeasurementEventProgress progress;
@@ -16,6 +16,8 @@
  *
  */
 
+#import <time.h>
+#import <pthread.h>
 #import "OCMeasurementEvent.h"
 
 @implementation OCMeasurementEvent
@@ -40,6 +42,9 @@
 	if ((self = [super init]) != nil)
 	{
 		_timestamp = NSDate.timeIntervalSinceReferenceDate;
+		_monotonicTimestamp = ((NSTimeInterval)clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW)) / (NSTimeInterval)NSEC_PER_SEC;
+
+		pthread_threadid_np(NULL, &_threadID);
 
 		_identifier = eventIdentifier;
 		_message = message;
@@ -172,6 +172,7 @@ FOUNDATION_EXPORT const unsigned char OpenCloudSDKVersionString[];
 #import <OpenCloudSDK/OCSQLiteResultSet.h>
 #import <OpenCloudSDK/OCSQLiteCollation.h>
 #import <OpenCloudSDK/OCSQLiteCollationLocalized.h>
+#import <OpenCloudSDK/OCSQLiteOnlineMigration.h>
 
 #import <OpenCloudSDK/OCBookmark+Prepopulation.h>
 #import <OpenCloudSDK/OCVault+Prepopulation.h>
@@ -215,9 +216,11 @@ FOUNDATION_EXPORT const unsigned char OpenCloudSDKVersionString[];
 #import <OpenCloudSDK/OCDataSourceArray.h>
 #import <OpenCloudSDK/OCDataSourceComposition.h>
 #import <OpenCloudSDK/OCDataSourceKVO.h>
+#import <OpenCloudSDK/OCDataSourceDatabaseWindow.h>
 #import <OpenCloudSDK/OCDataSourceMapped.h>
 #import <OpenCloudSDK/OCDataSourceSubscription.h>
 #import <OpenCloudSDK/OCDataSourceSnapshot.h>
+#import <OpenCloudSDK/OCDataSourceChangeSet.h>
 #import <OpenCloudSDK/OCDataItemRecord.h>
 #import <OpenCloudSDK/OCDataConverter.h>
 #import <OpenCloudSDK/OCDataConverterPipeline.h>
@@ -228,6 +231,7 @@ FOUNDATION_EXPORT const unsigned char OpenCloudSDKVersionString[];
 
 #import <OpenCloudSDK/OCQuery.h>
 #import <OpenCloudSDK/OCQueryFilter.h>
+#import <OpenCloudSDK/OCQuerySortDescriptor.h>
 #import <OpenCloudSDK/OCQueryCondition.h>
 #import <OpenCloudSDK/OCQueryCondition+Item.h>
 #import <OpenCloudSDK/OCQueryCondition+KQLBuilder.h>
@@ -311,6 +315,7 @@ FOUNDATION_EXPORT const unsigned char OpenCloudSDKVersionString[];
 #import <OpenCloudSDK/OCLogComponent.h>
 #import <OpenCloudSDK/OCLogToggle.h>
 #import <OpenCloudSDK/OCLogFileRecord.h>
+#import <OpenCloudSDK/OCLogBinaryMessage.h>
 #import <OpenCloudSDK/OCLogWriter.h>
 #import <OpenCloudSDK/OCLogFileWriter.h>
 #import <OpenCloudSDK/OCLogTag.h>
@@ -19,6 +19,7 @@
 #import "OCQueryCondition+Item.h"
 #import "OCLogger.h"
 #import "OCMacros.h"
+#import "OCQuerySortDescriptor.h"
 
 @implementation OCQueryCondition (Item)
 
@@ -196,11 +197,8 @@
 {
 	if (self.sortBy != nil)
 	{
-		NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:self.sortBy ascending:self.sortAscending];
-
-		return (^(id obj1, id obj2){
-			return ([sortDescriptor compareObject:obj1 toObject:obj2]);
-		});
+		// Use the same order as the database
+		return ([OCQuerySortDescriptor sortDescriptorWithPropertyName:self.sortBy ascending:self.sortAscending].comparator);
 	}
 
 	return (nil);
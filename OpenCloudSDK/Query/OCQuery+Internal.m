@@ -21,6 +21,105 @@
 #import "OCStatistic.h"
 #import "OCLogger.h"
 
+/*
+	Returns the items in the order determined by comparator. Instead of sorting from scratch, makes use of the
+	existing order of items that are already (mostly) sorted - f.ex. because they were returned pre-sorted by the
+	database, or sorted in a previous run and since then only changed by a few additions or updates:
+
+	- splits the items into an ordered sequence and the items that are displaced relative to it, in a single pass
+	- returns the items as-is if none are displaced (no copy needed)
+	- otherwise sorts only the displaced items and merges them into the ordered sequence
+	- falls back to a full sort if too many items are displaced for merging to pay off
+*/
+static NSMutableArray<OCItem *> *OCQueryOrderItems(NSMutableArray<OCItem *> *items, NSComparator comparator)
+{
+	NSUInteger itemCount = items.count;
+	NSMutableArray<OCItem *> *orderedItems, *displacedItems = nil, *mergedItems;
+	NSUInteger orderedIdx = 0, orderedCount, displacedIdx = 0, displacedCount;
+
+	if (itemCount < 2)
+	{
+		return (items);
+	}
+
+	orderedItems = [[NSMutableArray alloc] initWithCapacity:itemCount];
+
+	for (OCItem *item in items)
+	{
+		OCItem *lastOrderedItem = orderedItems.lastObject;
+		NSUInteger lastOrderedCount;
+
+		if ((lastOrderedItem == nil) || (comparator(lastOrderedItem, item) != NSOrderedDescending))
+		{
+			[orderedItems addObject:item];
+			continue;
+		}
+
+		if (displacedItems == nil)
+		{
+			displacedItems = [NSMutableArray new];
+		}
+
+		if (((lastOrderedCount = orderedItems.count) < 2) || (comparator(orderedItems[lastOrderedCount-2], item) != NSOrderedDescending))
+		{
+			// The last ordered item is out of place (f.ex. an item updated in place with a new name)
+			[displacedItems addObject:lastOrderedItem];
+			[orderedItems removeLastObject];
+			[orderedItems addObject:item];
+		}
+		else
+		{
+			// The item itself is out of place (f.ex. a new item appended at the end)
+			[displacedItems addObject:item];
+		}
+	}
+
+	if (displacedItems == nil)
+	{
+		// Items already in order
+		return (items);
+	}
+
+	if ((displacedCount = displacedItems.count) > (itemCount / 4))
+	{
+		// Too many displaced items for merging to pay off
+		NSMutableArray<OCItem *> *sortedItems = [[NSMutableArray alloc] initWithArray:items];
+
+		[sortedItems sortUsingComparator:comparator];
+
+		return (sortedItems);
+	}
+
+	[displacedItems sortUsingComparator:comparator];
+
+	mergedItems = [[NSMutableArray alloc] initWithCapacity:itemCount];
+	orderedCount = orderedItems.count;
+
+	while ((orderedIdx < orderedCount) && (displacedIdx < displacedCount))
+	{
+		if (comparator(displacedItems[displacedIdx], orderedItems[orderedIdx]) == NSOrderedAscending)
+		{
+			[mergedItems addObject:displacedItems[displacedIdx++]];
+		}
+		else
+		{
+			[mergedItems addObject:orderedItems[orderedIdx++]];
+		}
+	}
+
+	if (orderedIdx < orderedCount)
+	{
+		[mergedItems addObjectsFromArray:[orderedItems subarrayWithRange:NSMakeRange(orderedIdx, orderedCount - orderedIdx)]];
+	}
+
+	if (displacedIdx < displacedCount)
+	{
+		[mergedItems addObjectsFromArray:[displacedItems subarrayWithRange:NSMakeRange(displacedIdx, displacedCount - displacedIdx)]];
+	}
+
+	return (mergedItems);
+}
+
 @implementation OCQuery (Internal)
 
 #pragma mark - Update full results
@@ -120,7 +219,16 @@
 	{
 		if (!ifNeeded || (_needsRecomputation && ifNeeded))
 		{
-			NSMutableArray *newProcessedResults = [[NSMutableArray alloc] initWithArray:_fullQueryResults];
+			NSMutableArray *newProcessedResults;
+
+			// Bring full results in order. Replaces (rather than modifies) the array, as it may be shared with other queries.
+			// Since the full results are kept ordered, subsequent updates only need to merge in changed items.
+			if ((_sortComparator != nil) && (_fullQueryResults != nil))
+			{
+				_fullQueryResults = OCQueryOrderItems(_fullQueryResults, _sortComparator);
+			}
+
+			newProcessedResults = [[NSMutableArray alloc] initWithArray:_fullQueryResults];
 
 			// Apply filter(s)
 			if (_filters.count > 0)
@@ -148,11 +256,7 @@
 				}
 			}
 
-			// Apply comparator
-			if (_sortComparator != nil)
-			{
-				[newProcessedResults sortUsingComparator:_sortComparator];
-			}
+			// Filtering preserves the order of the full results, so no further sorting is needed here
 
 			// We just recomputed
 			_processedQueryResults = newProcessedResults;
@@ -20,6 +20,7 @@
 #import "OCCoreQuery.h"
 #import "OCTypes.h"
 #import "OCQueryFilter.h"
+#import "OCQuerySortDescriptor.h"
 #import "OCItem.h"
 #import "OCQueryChangeSet.h"
 #import "OCCoreItemList.h"
@@ -70,7 +71,7 @@ typedef void(^OCQueryCustomSource)(OCCore *core, OCQuery *query, OCQueryCustomRe
 	BOOL _includeRootItem;
 	OCItem *_rootItem;
 
-	NSMutableArray <OCItem *> *_fullQueryResults; 	  		// All items matching the query, before applying filters and sorting.
+	NSMutableArray <OCItem *> *_fullQueryResults; 	  		// All items matching the query, before applying filters. Kept in sort order once the query results have been computed.
 	NSMutableArray <OCItem *> *_processedQueryResults; 		// Like full query results, but after applying sorting and filtering.
 	BOOL _fullQueryResultsSetOnce;					// YES if fullQueryResults have been set at least once
 	OCDataSourceArray *_queryResultsDataSource;
@@ -83,6 +84,7 @@ typedef void(^OCQueryCustomSource)(OCCore *core, OCQuery *query, OCQueryCustomRe
 	NSMutableDictionary <OCQueryFilterIdentifier, id<OCQueryFilter>> *_filtersByIdentifier; // Filters to be applied on the query results, by identifier
 
 	NSComparator _sortComparator;
+	OCQuerySortDescriptor *_sortDescriptor;
 
 	dispatch_queue_t _queue;
 
@@ -133,7 +135,8 @@ typedef void(^OCQueryCustomSource)(OCCore *core, OCQuery *query, OCQueryCustomRe
 @property(strong,nullable) OCCancelAction *stopAction; //!< Cancel action thats invoked when the query is stopped
 
 #pragma mark - Sorting
-@property(nullable,copy,nonatomic) NSComparator sortComparator;	//!< Comparator used to sort the query results
+@property(nullable,copy,nonatomic) NSComparator sortComparator;	//!< Comparator used to sort the query results. Use .sortDescriptor instead where possible. Setting a comparator resets .sortDescriptor to nil.
+@property(nullable,strong,nonatomic) OCQuerySortDescriptor *sortDescriptor; //!< Declarative sort order of the query results. Queries with a condition retrieve their results from the database already in this order if it is supported by an index (see .isDatabaseBacked). Also sets .sortComparator to the descriptor's comparator.
 
 #pragma mark - Filtering
 @property(nullable,strong) NSArray <id<OCQueryFilter>> *filters; //!< (Output) filters to be applied on the query results.
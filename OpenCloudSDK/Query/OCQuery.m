@@ -40,6 +40,7 @@
 
 #pragma mark - Sorting
 @synthesize sortComparator = _sortComparator;
+@synthesize sortDescriptor = _sortDescriptor;
 
 #pragma mark - Filtering
 @synthesize filters = _filters;
@@ -124,9 +125,21 @@
 {
 	OCCancelAction *cancelAction = [OCCancelAction new];
 	OCQueryCustomSource customSource = ^(OCCore *core, OCQuery *query, OCQueryCustomResultHandler resultHandler) {
-		[core.vault.database retrieveCacheItemsForQueryCondition:condition cancelAction:cancelAction completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
-			resultHandler(error, items);
-		}];
+		OCQuerySortDescriptor *sortDescriptor = query.sortDescriptor;
+
+		if (sortDescriptor.isDatabaseBacked)
+		{
+			// Let the database return the items pre-sorted, so they don't need to be sorted again in memory
+			[core.vault.database retrieveCacheItemsForQueryCondition:condition sortedBy:sortDescriptor.propertyName ascending:sortDescriptor.ascending cancelAction:cancelAction completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+				resultHandler(error, items);
+			}];
+		}
+		else
+		{
+			[core.vault.database retrieveCacheItemsForQueryCondition:condition cancelAction:cancelAction completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+				resultHandler(error, items);
+			}];
+		}
 	};
 	OCQuery *query;
 
@@ -140,7 +153,11 @@
 	if ((query = [self queryWithCustomSource:customSource inputFilter:inputFilter]) != nil)
 	{
 		query.stopAction = cancelAction;
-		query.sortComparator = condition.itemComparator;
+
+		if (condition.sortBy != nil)
+		{
+			query.sortDescriptor = [OCQuerySortDescriptor sortDescriptorWithPropertyName:condition.sortBy ascending:condition.sortAscending];
+		}
 	}
 
 	if (OCQueryPerformMeasurement)
@@ -317,6 +334,18 @@
 	@synchronized(self)
 	{
 		_sortComparator = [sortComparator copy];
+		_sortDescriptor = nil;
+	}
+
+	[self setNeedsRecomputation];
+}
+
+- (void)setSortDescriptor:(OCQuerySortDescriptor *)sortDescriptor
+{
+	@synchronized(self)
+	{
+		_sortDescriptor = sortDescriptor;
+		_sortComparator = sortDescriptor.comparator;
 	}
 
 	[self setNeedsRecomputation];
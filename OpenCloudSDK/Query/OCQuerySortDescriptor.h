@@ -0,0 +1,37 @@
+//
+//  OCQuerySortDescriptor.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCItem.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCQuerySortDescriptor : NSObject <NSCopying>
+
++ (instancetype)sortDescriptorWithPropertyName:(OCItemPropertyName)propertyName ascending:(BOOL)ascending; //!< Returns a sort descriptor sorting items by the provided property.
+
+@property(strong,readonly) OCItemPropertyName propertyName; //!< Property by which items are sorted
+@property(assign,readonly) BOOL ascending; //!< YES if items are sorted in ascending order, NO for descending order.
+
+@property(readonly,nonatomic) BOOL isDatabaseBacked; //!< YES if the database can return items already ordered by this sort descriptor (see +[OCDatabase supportsSortingByPropertyName:]).
+
+@property(copy,readonly,nonatomic) NSComparator comparator; //!< Comparator for OCItems producing the same order as the database: names are compared using localized standard comparison (like OCSQLiteCollationLocalized), items without a value are ordered first (ascending) and the database ID serves as tie breaker.
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,148 @@
+//
+//  OCQuerySortDescriptor.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCQuerySortDescriptor.h"
+#import "OCDatabase.h"
+#import "OCMacros.h"
+
+@implementation OCQuerySortDescriptor
+
++ (instancetype)sortDescriptorWithPropertyName:(OCItemPropertyName)propertyName ascending:(BOOL)ascending
+{
+	return ([[self alloc] initWithPropertyName:propertyName ascending:ascending]);
+}
+
+- (instancetype)initWithPropertyName:(OCItemPropertyName)propertyName ascending:(BOOL)ascending
+{
+	if ((self = [super init]) != nil)
+	{
+		_propertyName = propertyName;
+		_ascending = ascending;
+
+		_comparator = [self _makeComparator];
+	}
+
+	return (self);
+}
+
+#pragma mark - Database
+- (BOOL)isDatabaseBacked
+{
+	return ([OCDatabase supportsSortingByPropertyName:_propertyName]);
+}
+
+#pragma mark - Comparator
++ (NSComparisonResult)_compareValue:(id)value1 toValue:(id)value2
+{
+	// Order items without value first - like SQLite does with NULL values
+	if (value1 == value2) { return (NSOrderedSame); }
+	if (value1 == nil) { return (NSOrderedAscending); }
+	if (value2 == nil) { return (NSOrderedDescending); }
+
+	return ([value1 compare:value2]);
+}
+
+- (NSComparator)_makeComparator
+{
+	OCItemPropertyName propertyName = _propertyName;
+	BOOL ascending = _ascending;
+	NSComparisonResult(^compareItems)(OCItem *item1, OCItem *item2);
+
+	if ([propertyName isEqual:OCItemPropertyNameName])
+	{
+		compareItems = ^NSComparisonResult(OCItem *item1, OCItem *item2) {
+			NSString *name1 = item1.name, *name2 = item2.name;
+
+			if ((name1 != nil) && (name2 != nil))
+			{
+				return ([name1 localizedStandardCompare:name2]);
+			}
+
+			return ([OCQuerySortDescriptor _compareValue:name1 toValue:name2]);
+		};
+	}
+	else if ([propertyName isEqual:OCItemPropertyNameSize])
+	{
+		compareItems = ^NSComparisonResult(OCItem *item1, OCItem *item2) {
+			NSInteger size1 = item1.size, size2 = item2.size;
+
+			return ((size1 < size2) ? NSOrderedAscending : ((size1 > size2) ? NSOrderedDescending : NSOrderedSame));
+		};
+	}
+	else if ([propertyName isEqual:OCItemPropertyNameLastModified])
+	{
+		compareItems = ^NSComparisonResult(OCItem *item1, OCItem *item2) {
+			return ([OCQuerySortDescriptor _compareValue:item1.lastModified toValue:item2.lastModified]);
+		};
+	}
+	else
+	{
+		compareItems = ^NSComparisonResult(OCItem *item1, OCItem *item2) {
+			return ([OCQuerySortDescriptor _compareValue:[item1 valueForKey:propertyName] toValue:[item2 valueForKey:propertyName]]);
+		};
+	}
+
+	return ([^NSComparisonResult(OCItem *item1, OCItem *item2) {
+		NSComparisonResult result;
+
+		if ((result = compareItems(item1, item2)) == NSOrderedSame)
+		{
+			// Use database ID as tie breaker (matching the database's ORDER BY clause)
+			result = [OCQuerySortDescriptor _compareValue:item1.databaseID toValue:item2.databaseID];
+		}
+
+		if (!ascending)
+		{
+			result = (NSComparisonResult)(-result);
+		}
+
+		return (result);
+	} copy]);
+}
+
+#pragma mark - Comparison
+- (BOOL)isEqual:(id)object
+{
+	OCQuerySortDescriptor *otherDescriptor;
+
+	if ((otherDescriptor = OCTypedCast(object, OCQuerySortDescriptor)) != nil)
+	{
+		return (OCNAIsEqual(_propertyName, otherDescriptor.propertyName) && (_ascending == otherDescriptor.ascending));
+	}
+
+	return (NO);
+}
+
+- (NSUInteger)hash
+{
+	return (_propertyName.hash ^ (_ascending ? 0x5A5A : 0));
+}
+
+#pragma mark - Copying
+- (id)copyWithZone:(NSZone *)zone
+{
+	return (self);
+}
+
+#pragma mark - Description
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, %@ %@>", NSStringFromClass(self.class), self, _propertyName, (_ascending ? @"ASC" : @"DESC")]);
+}
+
+@end
@@ -23,7 +23,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 typedef void(^OCCoreManagerOfflineOperation)(OCBookmark *bookmark, dispatch_block_t completionHandler); //!< Block performing an operation while no OCCore uses the bookmark. Call completionHandler when done.
 
-@interface OCCoreManager : NSObject <OCLogTagging, OCProgressResolver>
+@interface OCCoreManager : NSObject <OCClassSettingsSupport, OCLogTagging, OCProgressResolver>
 {
 	NSMutableDictionary <NSUUID *, OCCore *> *_coresByUUID;
 	NSMutableDictionary <NSUUID *, NSNumber *> *_requestCountByUUID;
@@ -36,6 +36,15 @@ typedef void(^OCCoreManagerOfflineOperation)(OCBookmark *bookmark, dispatch_bloc
 
 	NSMutableArray<OCCoreRunIdentifier> *_activeCoresRunIdentifiers;
 	NSArray<OCCoreRunIdentifier> *_activeCoresRunIdentifiersReadOnly;
+
+	NSMutableArray <NSUUID *> *_lingeringCoreUUIDs;
+	NSMutableDictionary <NSUUID *, NSNumber *> *_lingerGenerationByUUID;
+	NSMutableDictionary <NSUUID *, NSDate *> *_prewarmedUntilByUUID;
+
+	NSUInteger _coldStartCount;
+	NSUInteger _warmStartCount;
+	NSTimeInterval _coldStartTotalDuration;
+	NSTimeInterval _warmStartTotalDuration;
 }
 
 #pragma mark - Shared instance
@@ -48,7 +57,18 @@ typedef void(^OCCoreManagerOfflineOperation)(OCBookmark *bookmark, dispatch_bloc
 #pragma mark - Requesting and returning cores
 - (void)requestCoreForBookmark:(OCBookmark *)bookmark setup:(nullable void(^)(OCCore * _Nullable core, NSError * _Nullable error))setupHandler completionHandler:(void (^)(OCCore * _Nullable core, NSError * _Nullable  error))completionHandler; //!< Request the core for this bookmark. The core is started as the first user requests it. The core has completed starting once the completionHandler was called.
 
-- (void)returnCoreForBookmark:(OCBookmark *)bookmark completionHandler:(nullable dispatch_block_t)completionHandler; //!< Return the core for this bookmark. If all users have returned the core, it is stopped.
+- (void)returnCoreForBookmark:(OCBookmark *)bookmark completionHandler:(nullable dispatch_block_t)completionHandler; //!< Return the core for this bookmark. If all users have returned the core, it is stopped - or kept running for the linger duration, in which case the completionHandler is called right away.
+
+#pragma mark - Warm cores
+- (void)prewarmCoreForBookmark:(OCBookmark *)bookmark lingerDuration:(NSTimeInterval)lingerDuration completionHandler:(nullable void(^)(NSError * _Nullable error))completionHandler; //!< Starts the core for this bookmark without holding on to it and keeps it running for at least lingerDuration seconds after the last user returned it, so that a subsequent -requestCoreForBookmark: finds it warm. Does nothing if the memory configuration or the settings don't permit lingering cores.
+- (void)stopLingeringCoresWithCompletionHandler:(nullable dispatch_block_t)completionHandler; //!< Stops all cores that are no longer in use, but still kept running for their linger duration (f.ex. in response to memory pressure).
+
+@property(readonly,nonatomic) BOOL lingeringPermitted; //!< YES if cores may be kept running after their last user returned them.
+
+@property(readonly) NSUInteger coldStartCount; //!< Number of core requests that had to create and start a new core.
+@property(readonly) NSUInteger warmStartCount; //!< Number of core requests served by reclaiming a lingering (or prewarmed) core instead of creating and starting a new one. Requests for a core that is already in use are not counted.
+@property(readonly) NSTimeInterval averageColdStartDuration; //!< Average time (in seconds) from request to completionHandler for cold starts.
+@property(readonly) NSTimeInterval averageWarmStartDuration; //!< Average time (in seconds) from request to completionHandler for warm starts.
 
 #pragma mark - Background session recovery
 - (void)handleEventsForBackgroundURLSession:(NSString *)identifier completionHandler:(dispatch_block_t)completionHandler; //!< Call this from -[UIApplicationDelegate application:handleEventsForBackgroundURLSession:completionHandler:].
@@ -58,4 +78,9 @@ typedef void(^OCCoreManagerOfflineOperation)(OCBookmark *bookmark, dispatch_bloc
 
 @end
 
+extern OCClassSettingsIdentifier OCClassSettingsIdentifierCoreManager;
+
+extern OCClassSettingsKey OCCoreManagerLingerDuration; //!< Number of seconds a core is kept running after the last user returned it. 0 stops it immediately.
+extern OCClassSettingsKey OCCoreManagerMaximumLingeringCores; //!< Maximum number of unused cores kept running at the same time.
+
 NS_ASSUME_NONNULL_END
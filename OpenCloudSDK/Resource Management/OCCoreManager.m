@@ -25,6 +25,7 @@
 #import "OCCore+Internal.h"
 #import "OCMacros.h"
 #import "OCCoreProxy.h"
+#import "OCPlatform.h"
 
 @interface OCCoreManager ()
 {
@@ -38,6 +39,41 @@
 
 @synthesize postFileProviderNotifications = _postFileProviderNotifications;
 
+#pragma mark - Class settings
+INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCoreManager)
+
++ (OCClassSettingsIdentifier)classSettingsIdentifier
+{
+	return (OCClassSettingsIdentifierCoreManager);
+}
+
++ (NSDictionary<NSString *,id> *)defaultSettingsForIdentifier:(OCClassSettingsIdentifier)identifier
+{
+	return (@{
+		OCCoreManagerLingerDuration : @(0), // Stop cores as soon as the last user returns them
+		OCCoreManagerMaximumLingeringCores : @(2)
+	});
+}
+
++ (OCClassSettingsMetadataCollection)classSettingsMetadata
+{
+	return (@{
+		OCCoreManagerLingerDuration : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Number of seconds a core is kept running after the last user returned it, so that it can be re-used without starting it again. A value of 0 stops cores immediately. Ignored in the minimum memory configuration.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		OCCoreManagerMaximumLingeringCores : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Maximum number of unused cores kept running at the same time. If the limit is exceeded, the core that has been lingering the longest is stopped.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		}
+	});
+}
+
 #pragma mark - Shared instance
 + (instancetype)sharedCoreManager
 {
@@ -65,6 +101,10 @@
 
 		_activeCoresRunIdentifiers = [NSMutableArray new];
 
+		_lingeringCoreUUIDs = [NSMutableArray new];
+		_lingerGenerationByUUID = [NSMutableDictionary new];
+		_prewarmedUntilByUUID = [NSMutableDictionary new];
+
 		// _useCoreProxies = YES; // Uncomment to use core proxies and enable zombie core detection 
 		_coreProxiesByCore = [NSMapTable weakToStrongObjectsMapTable];
 	}
@@ -127,6 +167,9 @@
 
 - (void)_requestCoreForBookmark:(OCBookmark *)bookmark setup:(nullable void(^)(OCCore *core, NSError *))setupHandler completionHandler:(void (^)(OCCore *core, NSError *error))completionHandler
 {
+	NSTimeInterval requestTime = NSDate.timeIntervalSinceReferenceDate;
+	OCCore *lingeringCore = nil;
+
 	OCLogDebug(@"core requested for bookmark %@", bookmark);
 
 	NSNumber *requestCount = _requestCountByUUID[bookmark.uuid];
@@ -134,7 +177,23 @@
 	requestCount = @(requestCount.integerValue + 1);
 	_requestCountByUUID[bookmark.uuid] = requestCount;
 
-	if (requestCount.integerValue == 1)
+	if ((requestCount.integerValue == 1) && ((lingeringCore = [self _reclaimLingeringCoreForBookmark:bookmark]) != nil))
+	{
+		OCLog(@"re-using lingering core for bookmark %@", bookmark);
+
+		if (setupHandler != nil)
+		{
+			setupHandler([self protectedCoreForCore:lingeringCore], nil);
+		}
+
+		[self _recordStartOfCoreForBookmark:bookmark requestedAt:requestTime warm:YES];
+
+		if (completionHandler != nil)
+		{
+			completionHandler([self protectedCoreForCore:lingeringCore], nil);
+		}
+	}
+	else if (requestCount.integerValue == 1)
 	{
 		OCCore *core;
 
@@ -168,6 +227,11 @@
 				[core startWithCompletionHandler:^(OCCore *sender, NSError *error) {
 					OCLog(@"core=%@ started for bookmark=%@ with error=%@", sender, bookmark, error);
 
+					if (error == nil)
+					{
+						[self _recordStartOfCoreForBookmark:bookmark requestedAt:requestTime warm:NO];
+					}
+
 					if (completionHandler != nil)
 					{
 						if (error != nil)
@@ -263,61 +327,311 @@
 
 	if (requestCount.integerValue == 0)
 	{
-		// Stop and release core
-		OCCore *core;
+		if ([self _beginLingeringOfCoreForBookmark:bookmark])
+		{
+			if (completionHandler != nil)
+			{
+				completionHandler();
+			}
+		}
+		else
+		{
+			[self _stopCoreForBookmark:bookmark completionHandler:completionHandler];
+		}
+	}
+	else
+	{
+		OCLog(@"core still in use for bookmark %@", bookmark);
 
-		OCLog(@"shutting down core for bookmark %@", bookmark);
+		if (completionHandler != nil)
+		{
+			completionHandler();
+		}
+	}
+}
 
+- (void)_stopCoreForBookmark:(OCBookmark *)bookmark completionHandler:(dispatch_block_t)completionHandler
+{
+	// Stop and release core
+	OCCore *core;
+
+	OCLog(@"shutting down core for bookmark %@", bookmark);
+
+	@synchronized(self)
+	{
+		core = _coresByUUID[bookmark.uuid];
+
+		[_prewarmedUntilByUUID removeObjectForKey:bookmark.uuid];
+	}
+
+	if (core != nil)
+	{
+		OCLog(@"stopping core for bookmark %@", bookmark);
+
+		// Remove core from LUT
 		@synchronized(self)
 		{
-			core = _coresByUUID[bookmark.uuid];
+			[_coresByUUID removeObjectForKey:bookmark.uuid];
+			[_activeCoresRunIdentifiers removeObject:core.runIdentifier];
+			_activeCoresRunIdentifiersReadOnly = nil;
 		}
 
-		if (core != nil)
+		// Stop core
+		OCSyncExec(waitForCoreStop, {
+			[core stopWithCompletionHandler:^(id sender, NSError *error) {
+				[core unregisterEventHandler];
+
+				if (self->_useCoreProxies)
+				{
+					[self->_coreProxiesByCore objectForKey:core].core = nil;
+				}
+
+				OCLog(@"core stopped for bookmark %@", bookmark);
+
+				if (completionHandler != nil)
+				{
+					completionHandler();
+				}
+
+				OCSyncExecDone(waitForCoreStop);
+			}];
+		});
+
+		// Run offline operation
+		[self _runNextOfflineOperationForBookmark:bookmark];
+	}
+	else
+	{
+		OCLogError(@"no core found for bookmark %@, although one should exist", bookmark);
+	}
+}
+
+#pragma mark - Warm cores
+- (BOOL)lingeringPermitted
+{
+	if (OCPlatform.current.memoryConfiguration == OCPlatformMemoryConfigurationMinimum)
+	{
+		return (NO);
+	}
+
+	return ([[self classSettingForOCClassSettingsKey:OCCoreManagerMaximumLingeringCores] unsignedIntegerValue] > 0);
+}
+
+- (void)prewarmCoreForBookmark:(OCBookmark *)bookmark lingerDuration:(NSTimeInterval)lingerDuration completionHandler:(void (^)(NSError * _Nullable))completionHandler
+{
+	if (!self.lingeringPermitted || (lingerDuration <= 0))
+	{
+		OCLogDebug(@"not prewarming core for bookmark %@ (lingering not permitted or no linger duration)", bookmark);
+
+		if (completionHandler != nil)
+		{
+			completionHandler(nil);
+		}
+		return;
+	}
+
+	OCLogDebug(@"queuing core prewarm for bookmark %@", bookmark);
+
+	dispatch_async([self _adminQueueForBookmark:bookmark], ^{
+		__block NSError *prewarmError = nil;
+		__block BOOL acquiredCore = NO;
+
+		@synchronized(self)
 		{
-			OCLog(@"stopping core for bookmark %@", bookmark);
+			NSDate *prewarmedUntil = [NSDate dateWithTimeIntervalSinceNow:lingerDuration];
 
-			// Remove core from LUT
+			if ((self->_prewarmedUntilByUUID[bookmark.uuid] == nil) || ([self->_prewarmedUntilByUUID[bookmark.uuid] compare:prewarmedUntil] == NSOrderedAscending))
+			{
+				self->_prewarmedUntilByUUID[bookmark.uuid] = prewarmedUntil;
+			}
+		}
+
+		// Cold starts complete synchronously on the admin queue, so the core is running (or has failed to start) once this returns
+		[self _requestCoreForBookmark:bookmark setup:nil completionHandler:^(OCCore * _Nullable core, NSError * _Nullable error) {
+			prewarmError = error;
+			acquiredCore = (core != nil);
+		}];
+
+		if (acquiredCore)
+		{
+			[self _returnCoreForBookmark:bookmark completionHandler:nil];
+		}
+		else
+		{
 			@synchronized(self)
 			{
-				[_coresByUUID removeObjectForKey:bookmark.uuid];
-				[_activeCoresRunIdentifiers removeObject:core.runIdentifier];
-				_activeCoresRunIdentifiersReadOnly = nil;
+				[self->_prewarmedUntilByUUID removeObjectForKey:bookmark.uuid];
 			}
+		}
 
-			// Stop core
-			OCSyncExec(waitForCoreStop, {
-				[core stopWithCompletionHandler:^(id sender, NSError *error) {
-					[core unregisterEventHandler];
+		if (completionHandler != nil)
+		{
+			completionHandler(prewarmError);
+		}
+	});
+}
 
-					if (self->_useCoreProxies)
-					{
-						[self->_coreProxiesByCore objectForKey:core].core = nil;
-					}
+- (void)stopLingeringCoresWithCompletionHandler:(dispatch_block_t)completionHandler
+{
+	dispatch_group_t stopGroup = dispatch_group_create();
+	NSMutableArray<OCBookmark *> *lingeringBookmarks = [NSMutableArray new];
 
-					OCLog(@"core stopped for bookmark %@", bookmark);
+	@synchronized(self)
+	{
+		for (NSUUID *uuid in _lingeringCoreUUIDs)
+		{
+			OCBookmark *bookmark;
 
-					if (completionHandler != nil)
-					{
-						completionHandler();
-					}
+			if ((bookmark = _coresByUUID[uuid].bookmark) != nil)
+			{
+				[lingeringBookmarks addObject:bookmark];
+			}
+		}
+	}
 
-					OCSyncExecDone(waitForCoreStop);
-				}];
-			});
+	OCLog(@"stopping %lu lingering cores", (unsigned long)lingeringBookmarks.count);
 
-			// Run offline operation
-			[self _runNextOfflineOperationForBookmark:bookmark];
+	for (OCBookmark *bookmark in lingeringBookmarks)
+	{
+		dispatch_group_enter(stopGroup);
+
+		dispatch_async([self _adminQueueForBookmark:bookmark], ^{
+			[self _endLingeringOfCoreForBookmark:bookmark generation:nil completionHandler:^{
+				dispatch_group_leave(stopGroup);
+			}];
+		});
+	}
+
+	dispatch_group_notify(stopGroup, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+		if (completionHandler != nil)
+		{
+			completionHandler();
 		}
-		else
+	});
+}
+
+- (NSTimeInterval)_lingerDurationForBookmark:(OCBookmark *)bookmark
+{
+	NSTimeInterval lingerDuration = [[self classSettingForOCClassSettingsKey:OCCoreManagerLingerDuration] doubleValue];
+	NSDate *prewarmedUntil;
+
+	@synchronized(self)
+	{
+		prewarmedUntil = _prewarmedUntilByUUID[bookmark.uuid];
+	}
+
+	if ((prewarmedUntil != nil) && (prewarmedUntil.timeIntervalSinceNow > lingerDuration))
+	{
+		lingerDuration = prewarmedUntil.timeIntervalSinceNow;
+	}
+
+	return (lingerDuration);
+}
+
+- (BOOL)_beginLingeringOfCoreForBookmark:(OCBookmark *)bookmark
+{
+	NSTimeInterval lingerDuration;
+	NSUInteger maximumLingeringCores;
+	NSNumber *lingerGeneration;
+	OCBookmark *evictBookmark = nil;
+
+	if (!self.lingeringPermitted || ((lingerDuration = [self _lingerDurationForBookmark:bookmark]) <= 0))
+	{
+		return (NO);
+	}
+
+	maximumLingeringCores = [[self classSettingForOCClassSettingsKey:OCCoreManagerMaximumLingeringCores] unsignedIntegerValue];
+
+	@synchronized(self)
+	{
+		if (_coresByUUID[bookmark.uuid] == nil)
 		{
-			OCLogError(@"no core found for bookmark %@, although one should exist", bookmark);
+			return (NO);
+		}
+
+		if (_queuedOfflineOperationsByUUID[bookmark.uuid].count > 0)
+		{
+			// Offline operations require the core to be stopped
+			return (NO);
+		}
+
+		[_lingeringCoreUUIDs removeObject:bookmark.uuid];
+		[_lingeringCoreUUIDs addObject:bookmark.uuid];
+
+		lingerGeneration = @(_lingerGenerationByUUID[bookmark.uuid].unsignedIntegerValue + 1);
+		_lingerGenerationByUUID[bookmark.uuid] = lingerGeneration;
+
+		if (_lingeringCoreUUIDs.count > maximumLingeringCores)
+		{
+			evictBookmark = _coresByUUID[_lingeringCoreUUIDs.firstObject].bookmark;
 		}
 	}
-	else
+
+	OCLog(@"keeping core for bookmark %@ running for %.1f seconds", bookmark, lingerDuration);
+
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(lingerDuration * NSEC_PER_SEC)), [self _adminQueueForBookmark:bookmark], ^{
+		[self _endLingeringOfCoreForBookmark:bookmark generation:lingerGeneration completionHandler:nil];
+	});
+
+	if (evictBookmark != nil)
 	{
-		OCLog(@"core still in use for bookmark %@", bookmark);
+		OCLog(@"maximum number of lingering cores exceeded - stopping core for bookmark %@", evictBookmark);
+
+		dispatch_async([self _adminQueueForBookmark:evictBookmark], ^{
+			[self _endLingeringOfCoreForBookmark:evictBookmark generation:nil completionHandler:nil];
+		});
+	}
+
+	return (YES);
+}
+
+- (nullable OCCore *)_reclaimLingeringCoreForBookmark:(OCBookmark *)bookmark
+{
+	@synchronized(self)
+	{
+		if ([_lingeringCoreUUIDs containsObject:bookmark.uuid])
+		{
+			[_lingeringCoreUUIDs removeObject:bookmark.uuid];
+
+			// Invalidate the pending linger timer
+			_lingerGenerationByUUID[bookmark.uuid] = @(_lingerGenerationByUUID[bookmark.uuid].unsignedIntegerValue + 1);
+
+			return (_coresByUUID[bookmark.uuid]);
+		}
+	}
+
+	return (nil);
+}
 
+- (BOOL)_isCoreLingeringForBookmark:(OCBookmark *)bookmark
+{
+	@synchronized(self)
+	{
+		return ([_lingeringCoreUUIDs containsObject:bookmark.uuid]);
+	}
+}
+
+- (void)_endLingeringOfCoreForBookmark:(OCBookmark *)bookmark generation:(nullable NSNumber *)lingerGeneration completionHandler:(nullable dispatch_block_t)completionHandler
+{
+	BOOL stopCore = NO;
+
+	@synchronized(self)
+	{
+		if ([_lingeringCoreUUIDs containsObject:bookmark.uuid] && ((lingerGeneration == nil) || [_lingerGenerationByUUID[bookmark.uuid] isEqual:lingerGeneration]))
+		{
+			[_lingeringCoreUUIDs removeObject:bookmark.uuid];
+			stopCore = YES;
+		}
+	}
+
+	if (stopCore && (_requestCountByUUID[bookmark.uuid].integerValue == 0))
+	{
+		OCLog(@"linger period ended for core for bookmark %@", bookmark);
+
+		[self _stopCoreForBookmark:bookmark completionHandler:completionHandler];
+	}
+	else
+	{
 		if (completionHandler != nil)
 		{
 			completionHandler();
@@ -325,6 +639,60 @@
 	}
 }
 
+#pragma mark - Startup latency
+- (void)_recordStartOfCoreForBookmark:(OCBookmark *)bookmark requestedAt:(NSTimeInterval)requestTime warm:(BOOL)warm
+{
+	NSTimeInterval startDuration = NSDate.timeIntervalSinceReferenceDate - requestTime;
+
+	@synchronized(self)
+	{
+		if (warm)
+		{
+			_warmStartCount++;
+			_warmStartTotalDuration += startDuration;
+		}
+		else
+		{
+			_coldStartCount++;
+			_coldStartTotalDuration += startDuration;
+		}
+	}
+
+	OCLog(@"%@ start of core for bookmark %@ took %.3f sec", (warm ? @"warm" : @"cold"), bookmark, startDuration);
+}
+
+- (NSUInteger)coldStartCount
+{
+	@synchronized(self)
+	{
+		return (_coldStartCount);
+	}
+}
+
+- (NSUInteger)warmStartCount
+{
+	@synchronized(self)
+	{
+		return (_warmStartCount);
+	}
+}
+
+- (NSTimeInterval)averageColdStartDuration
+{
+	@synchronized(self)
+	{
+		return ((_coldStartCount > 0) ? (_coldStartTotalDuration / (NSTimeInterval)_coldStartCount) : 0);
+	}
+}
+
+- (NSTimeInterval)averageWarmStartDuration
+{
+	@synchronized(self)
+	{
+		return ((_warmStartCount > 0) ? (_warmStartTotalDuration / (NSTimeInterval)_warmStartCount) : 0);
+	}
+}
+
 #pragma mark - Background session recovery
 - (void)handleEventsForBackgroundURLSession:(NSString *)identifier completionHandler:(dispatch_block_t)completionHandler
 {
@@ -362,6 +730,15 @@
 
 	OCLogDebug(@"trying to run next offline operation for bookmark %@", bookmark);
 
+	if ((_requestCountByUUID[bookmark.uuid].integerValue == 0) && [self _isCoreLingeringForBookmark:bookmark])
+	{
+		// Stop the lingering core first - which will then run the offline operation
+		OCLogDebug(@"stopping lingering core to run offline operation for bookmark %@", bookmark);
+
+		[self _endLingeringOfCoreForBookmark:bookmark generation:nil completionHandler:nil];
+		return;
+	}
+
 	if (_requestCountByUUID[bookmark.uuid].integerValue == 0)
 	{
 		@synchronized(self)
@@ -437,3 +814,8 @@
 }
 
 @end
+
+OCClassSettingsIdentifier OCClassSettingsIdentifierCoreManager = @"core-manager";
+
+OCClassSettingsKey OCCoreManagerLingerDuration = @"linger-duration";
+OCClassSettingsKey OCCoreManagerMaximumLingeringCores = @"maximum-lingering-cores";
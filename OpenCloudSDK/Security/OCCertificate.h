@@ -61,6 +61,8 @@ typedef NSString* OCCertificateAcceptanceReason NS_TYPED_ENUM;
 	NSData *_sha1FingerPrint;
 	NSData *_sha256FingerPrint;
 
+	NSDate *_validUntilDate;
+
 	OCCertificate *_parentCertificate;
 }
 
@@ -107,6 +109,9 @@ typedef NSString* OCCertificateAcceptanceReason NS_TYPED_ENUM;
 - (nullable NSData *)sha1Fingerprint;
 - (nullable NSData *)sha256Fingerprint;
 
+#pragma mark - Validity
+- (nullable NSDate *)validUntilDate; //!< The end of the certificate's validity period (X.509 notAfter), as parsed from the certificate's DER representation. Returns nil if it can't be determined.
+
 #pragma mark - Chain
 - (OCCertificate *)rootCertificate; //!< Returns the root certificate from the certificate's chain - or, if it has no chain, the instance itself.
 - (NSArray <OCCertificate *> *)chainInReverse:(BOOL)inReverse; //!< Returns the certificate chain, starting with the root certificate (inReverse=YES) or the certificate itself (inReverse=NO).
@@ -642,6 +642,8 @@ static NSString *OCCertificateKeychainPath = @"UserAcceptedCertificates";
 	_md5FingerPrint = nil;
 	_sha1FingerPrint = nil;
 	_sha256FingerPrint = nil;
+
+	_validUntilDate = nil;
 }
 
 - (NSData *)md5Fingerprint
@@ -683,6 +685,140 @@ static NSString *OCCertificateKeychainPath = @"UserAcceptedCertificates";
 	}
 }
 
+#pragma mark - Validity
+static BOOL OCCertificateDERReadElement(const uint8_t *bytes, NSUInteger length, NSUInteger *offset, uint8_t *outTag, NSUInteger *outContentOffset, NSUInteger *outContentLength)
+{
+	NSUInteger pos = *offset, contentLength = 0;
+
+	if ((pos + 2) > length) { return (NO); }
+
+	*outTag = bytes[pos++];
+
+	if ((bytes[pos] & 0x80) == 0)
+	{
+		// Short form length
+		contentLength = bytes[pos++];
+	}
+	else
+	{
+		// Long form length
+		NSUInteger lengthBytes = (bytes[pos++] & 0x7F);
+
+		if ((lengthBytes == 0) || (lengthBytes > sizeof(NSUInteger)) || ((pos + lengthBytes) > length)) { return (NO); }
+
+		while (lengthBytes-- > 0)
+		{
+			contentLength = (contentLength << 8) | bytes[pos++];
+		}
+	}
+
+	if ((contentLength > length) || ((pos + contentLength) > length)) { return (NO); }
+
+	*outContentOffset = pos;
+	*outContentLength = contentLength;
+	*offset = pos + contentLength;
+
+	return (YES);
+}
+
+static NSDate *OCCertificateDateFromDERTime(uint8_t tag, const uint8_t *bytes, NSUInteger length)
+{
+	static NSDateFormatter *dateFormatter;
+	static dispatch_once_t onceToken;
+	NSString *timeString;
+
+	dispatch_once(&onceToken, ^{
+		dateFormatter = [NSDateFormatter new];
+		dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+		dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+		dateFormatter.dateFormat = @"yyyyMMddHHmmss'Z'";
+	});
+
+	if ((timeString = [[NSString alloc] initWithBytes:bytes length:length encoding:NSASCIIStringEncoding]) == nil)
+	{
+		return (nil);
+	}
+
+	switch (tag)
+	{
+		case 0x17: // UTCTime (YYMMDDHHMMSSZ) - RFC 5280: YY >= 50 -> 19YY, else 20YY
+			if (timeString.length != 13) { return (nil); }
+
+			timeString = [(([timeString substringToIndex:2].integerValue >= 50) ? @"19" : @"20") stringByAppendingString:timeString];
+		break;
+
+		case 0x18: // GeneralizedTime (YYYYMMDDHHMMSSZ)
+			if (timeString.length != 15) { return (nil); }
+		break;
+
+		default:
+			return (nil);
+		break;
+	}
+
+	@synchronized(dateFormatter)
+	{
+		return ([dateFormatter dateFromString:timeString]);
+	}
+}
+
+- (NSDate *)validUntilDate
+{
+	@synchronized(self)
+	{
+		if (_validUntilDate == nil)
+		{
+			NSData *certificateData;
+
+			if ((certificateData = [self certificateData]) != nil)
+			{
+				// Certificate ::= SEQUENCE { tbsCertificate, signatureAlgorithm, signatureValue }
+				// TBSCertificate ::= SEQUENCE { [0] version OPTIONAL, serialNumber, signature, issuer, validity, .. }
+				// Validity ::= SEQUENCE { notBefore, notAfter }
+				const uint8_t *bytes = (const uint8_t *)certificateData.bytes;
+				NSUInteger length = certificateData.length;
+				NSUInteger offset = 0, contentOffset = 0, contentLength = 0;
+				uint8_t tag = 0;
+
+				// Certificate
+				if (!OCCertificateDERReadElement(bytes, length, &offset, &tag, &contentOffset, &contentLength) || (tag != 0x30)) { return (nil); }
+				offset = contentOffset;
+
+				// TBSCertificate
+				if (!OCCertificateDERReadElement(bytes, length, &offset, &tag, &contentOffset, &contentLength) || (tag != 0x30)) { return (nil); }
+				offset = contentOffset;
+
+				// Skip [0] version (if present), serialNumber, signature and issuer
+				for (NSUInteger element=0; element<4; element++)
+				{
+					NSUInteger elementOffset = offset;
+
+					if (!OCCertificateDERReadElement(bytes, length, &offset, &tag, &contentOffset, &contentLength)) { return (nil); }
+
+					if ((element == 0) && (tag != 0xA0))
+					{
+						// No explicit version -> element is the serialNumber
+						offset = elementOffset;
+					}
+				}
+
+				// Validity
+				if (!OCCertificateDERReadElement(bytes, length, &offset, &tag, &contentOffset, &contentLength) || (tag != 0x30)) { return (nil); }
+				offset = contentOffset;
+
+				// notBefore
+				if (!OCCertificateDERReadElement(bytes, length, &offset, &tag, &contentOffset, &contentLength)) { return (nil); }
+
+				// notAfter
+				if (!OCCertificateDERReadElement(bytes, length, &offset, &tag, &contentOffset, &contentLength)) { return (nil); }
+
+				_validUntilDate = OCCertificateDateFromDERTime(tag, &bytes[contentOffset], contentLength);
+			}
+		}
+
+		return (_validUntilDate);
+	}
+}
 
 #pragma mark - NSSecureCoding
 + (BOOL)supportsSecureCoding
@@ -21,6 +21,8 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class OCIPNotificationCenter;
+@class OCRateLimiter;
+@class OCIPNotificationStatistics;
 
 typedef NSString* OCIPCNotificationName;
 typedef void(^OCIPNotificationHandler)(OCIPNotificationCenter *notificationCenter, id observer, OCIPCNotificationName notificationName);
@@ -31,6 +33,11 @@ typedef void(^OCIPNotificationHandler)(OCIPNotificationCenter *notificationCente
 	NSMutableDictionary <OCIPCNotificationName, NSMapTable<id, OCIPNotificationHandler> *> *_handlersByObserverByNotificationName;
 
 	NSMutableDictionary <OCIPCNotificationName, NSNumber *> *_ignoreCountsByNotificationName;
+
+	NSMutableDictionary <OCIPCNotificationName, OCRateLimiter *> *_rateLimitersByNotificationName;
+	NSMutableSet <OCIPCNotificationName> *_coalescedSelfDeliveryNotificationNames;
+
+	NSMutableDictionary <OCIPCNotificationName, OCIPNotificationStatistics *> *_statisticsByNotificationName;
 }
 
 @property(class,assign) BOOL loggingEnabled;
@@ -44,7 +51,28 @@ typedef void(^OCIPNotificationHandler)(OCIPNotificationCenter *notificationCente
 - (void)removeAllObserversForName:(OCIPCNotificationName)name;
 
 #pragma mark - Post notifications
-- (void)postNotificationForName:(OCIPCNotificationName)name ignoreSelf:(BOOL)ignoreSelf;
+- (void)postNotificationForName:(OCIPCNotificationName)name ignoreSelf:(BOOL)ignoreSelf; //!< Posts the notification. If a minimum interval is set for the name, bursts of posts are coalesced into a single post at the leading and one at the trailing edge. The trailing post is delivered to self if any of the coalesced posts was made with ignoreSelf:NO.
+
+#pragma mark - Coalescing
+- (void)setMinimumInterval:(NSTimeInterval)minimumInterval forName:(OCIPCNotificationName)name; //!< Sets the minimum interval (in seconds) between two posts of the named notification. A value of 0 turns coalescing off.
+- (NSTimeInterval)minimumIntervalForName:(OCIPCNotificationName)name; //!< Returns the minimum interval set for the named notification, 0 if none is set.
+
+#pragma mark - Statistics
+- (nullable OCIPNotificationStatistics *)statisticsForName:(OCIPCNotificationName)name; //!< Returns a snapshot of the counters for the named notification.
+@property(readonly,strong,nonatomic) NSDictionary<OCIPCNotificationName, OCIPNotificationStatistics *> *statistics; //!< Snapshot of the counters for all notification names.
+- (void)resetStatistics;
+
+@end
+
+@interface OCIPNotificationStatistics : NSObject <NSCopying>
+
+@property(assign) NSUInteger postRequestCount; //!< Number of times -postNotificationForName:ignoreSelf: was called
+@property(assign) NSUInteger postCount; //!< Number of Darwin notifications actually posted
+@property(readonly,nonatomic) NSUInteger coalescedCount; //!< Number of post requests that were merged into other posts (= saved wakeups for every other observing process)
+
+@property(assign) NSUInteger receivedCount; //!< Number of Darwin notifications received
+@property(assign) NSUInteger ignoredCount; //!< Number of received notifications that were dropped because they were posted with ignoreSelf:YES
+@property(assign) NSUInteger deliveredCount; //!< Number of received notifications that were delivered to observers
 
 @end
 
@@ -18,6 +18,7 @@
 
 #import "OCIPNotificationCenter.h"
 #import "OCLogger.h"
+#import "OCRateLimiter.h"
 
 static BOOL sOCIPNotificationCenterLoggingEnabled = NO;
 
@@ -57,6 +58,11 @@ static BOOL sOCIPNotificationCenterLoggingEnabled = NO;
 
 		_handlersByObserverByNotificationName = [NSMutableDictionary new];
 		_ignoreCountsByNotificationName = [NSMutableDictionary new];
+
+		_rateLimitersByNotificationName = [NSMutableDictionary new];
+		_coalescedSelfDeliveryNotificationNames = [NSMutableSet new];
+
+		_statisticsByNotificationName = [NSMutableDictionary new];
 	}
 
 	return(self);
@@ -175,10 +181,15 @@ static void OCIPNotificationCenterCallback(CFNotificationCenterRef center, void
 	{
 		NSMapTable<id, OCIPNotificationHandler> *handlersByObserver;
 		NSNumber *ignoreCountNumber = _ignoreCountsByNotificationName[name];
+		OCIPNotificationStatistics *statistics = [self _statisticsForName:name];
 		NSUInteger ignoreCount;
 
+		statistics.receivedCount++;
+
 		if ((ignoreCount = ignoreCountNumber.unsignedIntegerValue) > 0)
 		{
+			statistics.ignoredCount++;
+
 			if (ignoreCount > 1)
 			{
 				_ignoreCountsByNotificationName[name] = @(ignoreCount - 1);
@@ -191,6 +202,8 @@ static void OCIPNotificationCenterCallback(CFNotificationCenterRef center, void
 			return;
 		}
 
+		statistics.deliveredCount++;
+
 		if ((handlersByObserver = _handlersByObserverByNotificationName[name]) != nil)
 		{
 			observers = NSAllMapTableKeys(handlersByObserver); // Simple enumeration could fail due to mutation while enumeration, so we grab an array of the observers and iterate over that
@@ -224,6 +237,50 @@ static void OCIPNotificationCenterCallback(CFNotificationCenterRef center, void
 
 #pragma mark - Post notifications
 - (void)postNotificationForName:(OCIPCNotificationName)name ignoreSelf:(BOOL)ignoreSelf
+{
+	OCRateLimiter *rateLimiter;
+
+	@synchronized (self)
+	{
+		[self _statisticsForName:name].postRequestCount++;
+
+		if ((rateLimiter = _rateLimitersByNotificationName[name]) != nil)
+		{
+			if (!ignoreSelf)
+			{
+				// Remember that at least one of the coalesced posts should also be delivered to self
+				[_coalescedSelfDeliveryNotificationNames addObject:name];
+			}
+		}
+	}
+
+	if (rateLimiter != nil)
+	{
+		__weak OCIPNotificationCenter *weakSelf = self;
+
+		[rateLimiter runRateLimitedBlock:^{
+			OCIPNotificationCenter *strongSelf;
+			BOOL coalescedIgnoreSelf;
+
+			if ((strongSelf = weakSelf) != nil)
+			{
+				@synchronized (strongSelf)
+				{
+					coalescedIgnoreSelf = ![strongSelf->_coalescedSelfDeliveryNotificationNames containsObject:name];
+					[strongSelf->_coalescedSelfDeliveryNotificationNames removeObject:name];
+				}
+
+				[strongSelf _postNotificationForName:name ignoreSelf:coalescedIgnoreSelf];
+			}
+		}];
+	}
+	else
+	{
+		[self _postNotificationForName:name ignoreSelf:ignoreSelf];
+	}
+}
+
+- (void)_postNotificationForName:(OCIPCNotificationName)name ignoreSelf:(BOOL)ignoreSelf
 {
 	if (OCIPNotificationCenter.loggingEnabled)
 	{
@@ -239,10 +296,119 @@ static void OCIPNotificationCenterCallback(CFNotificationCenterRef center, void
 			_ignoreCountsByNotificationName[name] = @([existingIgnoreCount unsignedIntegerValue] + 1);
 		}
 
+		[self _statisticsForName:name].postCount++;
+
 		CFNotificationCenterPostNotification(_darwinNotificationCenter, (__bridge CFNotificationName)name, NULL, NULL, false);
 	}
 }
 
+#pragma mark - Coalescing
+- (void)setMinimumInterval:(NSTimeInterval)minimumInterval forName:(OCIPCNotificationName)name
+{
+	@synchronized (self)
+	{
+		if (minimumInterval > 0)
+		{
+			OCRateLimiter *rateLimiter;
+
+			if ((rateLimiter = _rateLimitersByNotificationName[name]) != nil)
+			{
+				rateLimiter.minimumTime = minimumInterval;
+			}
+			else
+			{
+				_rateLimitersByNotificationName[name] = [[OCRateLimiter alloc] initWithMinimumTime:minimumInterval];
+			}
+		}
+		else
+		{
+			// A trailing post that is already scheduled will still be performed by the (now removed) rate limiter
+			[_rateLimitersByNotificationName removeObjectForKey:name];
+		}
+	}
+}
+
+- (NSTimeInterval)minimumIntervalForName:(OCIPCNotificationName)name
+{
+	@synchronized (self)
+	{
+		return (_rateLimitersByNotificationName[name].minimumTime);
+	}
+}
+
+#pragma mark - Statistics
+- (OCIPNotificationStatistics *)_statisticsForName:(OCIPCNotificationName)name
+{
+	// Must be called from within @synchronized(self)
+	OCIPNotificationStatistics *statistics;
+
+	if ((statistics = _statisticsByNotificationName[name]) == nil)
+	{
+		statistics = [OCIPNotificationStatistics new];
+		_statisticsByNotificationName[name] = statistics;
+	}
+
+	return (statistics);
+}
+
+- (OCIPNotificationStatistics *)statisticsForName:(OCIPCNotificationName)name
+{
+	@synchronized (self)
+	{
+		return ([_statisticsByNotificationName[name] copy]);
+	}
+}
+
+- (NSDictionary<OCIPCNotificationName,OCIPNotificationStatistics *> *)statistics
+{
+	NSMutableDictionary<OCIPCNotificationName,OCIPNotificationStatistics *> *statistics = [NSMutableDictionary new];
+
+	@synchronized (self)
+	{
+		[_statisticsByNotificationName enumerateKeysAndObjectsUsingBlock:^(OCIPCNotificationName name, OCIPNotificationStatistics *nameStatistics, BOOL * _Nonnull stop) {
+			statistics[name] = [nameStatistics copy];
+		}];
+	}
+
+	return (statistics);
+}
+
+- (void)resetStatistics
+{
+	@synchronized (self)
+	{
+		[_statisticsByNotificationName removeAllObjects];
+	}
+}
+
+@end
+
+@implementation OCIPNotificationStatistics
+
+- (NSUInteger)coalescedCount
+{
+	return ((_postRequestCount > _postCount) ? (_postRequestCount - _postCount) : 0);
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	OCIPNotificationStatistics *statistics = [OCIPNotificationStatistics new];
+
+	statistics->_postRequestCount = _postRequestCount;
+	statistics->_postCount = _postCount;
+
+	statistics->_receivedCount = _receivedCount;
+	statistics->_ignoredCount = _ignoredCount;
+	statistics->_deliveredCount = _deliveredCount;
+
+	return (statistics);
+}
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, postRequests: %lu, posts: %lu, coalesced: %lu, received: %lu, ignored: %lu, delivered: %lu>", NSStringFromClass(self.class), self, (unsigned long)_postRequestCount, (unsigned long)_postCount, (unsigned long)self.coalescedCount, (unsigned long)_receivedCount, (unsigned long)_ignoredCount, (unsigned long)_deliveredCount]);
+}
+
 @end
 
 #pragma mark - Log tagging
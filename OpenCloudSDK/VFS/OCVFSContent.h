@@ -21,6 +21,7 @@
 
 @class OCCore;
 @class OCQuery;
+@class OCItem;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -36,6 +37,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property(assign) BOOL isSnapshot; //!< If YES, content is not self-refreshing and needs to be re-requested to get the latest version
 
+#pragma mark - Paged content
+@property(strong,nullable) NSArray<OCItem *> *items; //!< Items of the requested page (paged content only)
+@property(strong,nullable) OCVFSContentCursor nextCursor; //!< Cursor to retrieve the next page with, nil if this is the last page (paged content only)
+@property(strong,nullable) OCSyncAnchor syncAnchor; //!< Sync anchor to enumerate subsequent changes from (paged content only)
+
 @end
 
 NS_ASSUME_NONNULL_END
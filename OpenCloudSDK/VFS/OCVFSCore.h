@@ -52,6 +52,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property(readonly,nonatomic,nullable) OCVFSNode *rootNode;
 
 - (void)provideContentForContainerItemID:(nullable OCVFSItemID)containerItemID changesFromSyncAnchor:(nullable OCSyncAnchor)sinceSyncAnchor completionHandler:(void(^)(NSError * _Nullable error, OCVFSContent * _Nullable content))completionHandler;
+- (void)provideContentPageForContainerItemID:(nullable OCVFSItemID)containerItemID changesFromSyncAnchor:(nullable OCSyncAnchor)sinceSyncAnchor cursor:(nullable OCVFSContentCursor)cursor pageSize:(NSUInteger)pageSize completionHandler:(void(^)(NSError * _Nullable error, OCVFSContent * _Nullable content))completionHandler; //!< Provides a single page of at most pageSize items (0 for the default page size) via OCVFSContent.items, read from the database with indexed range queries rather than a query over the whole container. Pass nil for cursor to retrieve the first page (which also includes the virtual child nodes) and OCVFSContent.nextCursor for subsequent pages. OCVFSContent.syncAnchor reflects the state at the start of the enumeration (container contents) or the latest returned change (changes).
 
 + (nullable OCVFSItemID)composeVFSItemIDForOCItemWithBookmarkUUID:(OCBookmarkUUIDString)bookmarkUUIDString driveID:(OCDriveID)driveID localID:(OCLocalID)localID;
 
@@ -21,15 +21,29 @@
 #import "OCVaultLocation.h"
 #import "OCBookmarkManager.h"
 #import "OCCoreManager.h"
-#import "NSArray+OCFiltering.h"
 #import "NSString+OCPath.h"
 #import "OCMacros.h"
 #import "OCCore+FileProvider.h"
+#import "OCVFSIndex.h"
+#import "OCDatabase.h"
+#import "NSError+OCError.h"
+
+#define OCVFSCoreDefaultPageSize 200
+
+typedef NSString* OCVFSContentCursorKey;
+
+static OCVFSContentCursorKey OCVFSContentCursorKeyVersion = @"v";
+static OCVFSContentCursorKey OCVFSContentCursorKeyChanges = @"c"; //!< YES for change enumerations, NO for container content enumerations
+static OCVFSContentCursorKey OCVFSContentCursorKeyName = @"n"; //!< name of the last item of the previous page (container content)
+static OCVFSContentCursorKey OCVFSContentCursorKeyDatabaseID = @"i"; //!< database ID of the last item of the previous page
+static OCVFSContentCursorKey OCVFSContentCursorKeySyncAnchor = @"a"; //!< sync anchor at the start of the enumeration (container content) or of the last item of the previous page (changes)
 
 @interface OCVFSCore ()
 {
 	NSMutableArray<OCVFSNode *> *_nodes;
 	NSMapTable<OCVFSNodeID, OCVFSNode *> *_nodesByID;
+
+	OCVFSIndex *_index;
 }
 @end
 
@@ -41,6 +55,7 @@
 	{
 		_nodes = [NSMutableArray new];
 		_nodesByID = [NSMapTable weakToWeakObjectsMapTable];
+		_index = [OCVFSIndex new];
 	}
 
 	return (self);
@@ -57,6 +72,8 @@
 			node.vfsCore = self;
 			[_nodesByID setObject:node forKey:node.identifier];
 		}
+
+		[_index setNodes:_nodes];
 	}
 
 	[self _recreateVirtualFillNodes];
@@ -72,6 +89,8 @@
 			node.vfsCore = nil;
 		}
 		[_nodes removeObjectsInArray:nodes];
+
+		[_index setNodes:_nodes];
 	}
 	[self _recreateVirtualFillNodes];
 }
@@ -201,30 +220,40 @@
 			// Other item
 			if ((location.bookmarkUUID != nil) && (location.localID != nil))
 			{
-				NSError *coreError = nil;
-				OCCore *core = [self _acquireCoreForVaultLocation:location error:&coreError];
-
-				if (core != nil)
+				// Try index first
+				if ((item = (id<OCVFSItem>)[_index itemForLocalID:location.localID bookmarkUUID:location.bookmarkUUID]) == nil)
 				{
-					if (coreError != nil)
-					{
-						returnError = coreError;
-					}
-					else
-					{
-						OCSyncExec(itemRetrieval, {
-							[core retrieveItemFromDatabaseForLocalID:location.localID completionHandler:^(NSError *error, OCSyncAnchor syncAnchor, OCItem *itemFromDatabase) {
-								itemFromDatabase.bookmarkUUID = location.bookmarkUUID.UUIDString;
-								item = (id<OCVFSItem>)itemFromDatabase;
-								returnError = error;
+					NSError *coreError = nil;
+					NSUInteger itemGeneration = [_index itemGenerationForBookmarkUUID:location.bookmarkUUID];
+					OCCore *core = [self _acquireCoreForVaultLocation:location error:&coreError];
 
-								OCSyncExecDone(itemRetrieval);
-							}];
-						});
+					if (core != nil)
+					{
+						if (coreError != nil)
+						{
+							returnError = coreError;
+						}
+						else
+						{
+							OCSyncExec(itemRetrieval, {
+								[core retrieveItemFromDatabaseForLocalID:location.localID completionHandler:^(NSError *error, OCSyncAnchor syncAnchor, OCItem *itemFromDatabase) {
+									itemFromDatabase.bookmarkUUID = location.bookmarkUUID.UUIDString;
+									item = (id<OCVFSItem>)itemFromDatabase;
+									returnError = error;
+
+									if (itemFromDatabase != nil)
+									{
+										[self->_index addItem:itemFromDatabase bookmarkUUID:location.bookmarkUUID generation:itemGeneration];
+									}
+
+									OCSyncExecDone(itemRetrieval);
+								}];
+							});
+
+							[self _relinquishCore:core];
+						}
 
-						[self _relinquishCore:core];
 					}
-
 				}
 			}
 		}
@@ -279,11 +308,9 @@
 	return (item);
 }
 
-- (void)provideContentForContainerItemID:(nullable OCVFSItemID)containerItemID changesFromSyncAnchor:(nullable OCSyncAnchor)sinceSyncAnchor completionHandler:(void(^)(NSError * _Nullable error, OCVFSContent * _Nullable content))completionHandler
+- (void)_resolveContainerItemID:(nullable OCVFSItemID)containerItemID containerNode:(OCVFSNode * _Nullable __autoreleasing *)outContainerNode vfsContainerPath:(OCPath _Nullable __autoreleasing *)outVFSContainerPath queryLocation:(OCLocation * _Nullable __autoreleasing *)outQueryLocation
 {
 	OCVFSNode *containerNode = nil;
-	OCQuery *query = nil;
-	NSArray<OCVFSNode *> *vfsChildNodes = nil;
 	OCPath vfsContainerPath = nil;
 	OCLocation *queryLocation = nil;
 
@@ -337,6 +364,21 @@
 		}
 	}
 
+	*outContainerNode = containerNode;
+	*outVFSContainerPath = vfsContainerPath;
+	*outQueryLocation = queryLocation;
+}
+
+- (void)provideContentForContainerItemID:(nullable OCVFSItemID)containerItemID changesFromSyncAnchor:(nullable OCSyncAnchor)sinceSyncAnchor completionHandler:(void(^)(NSError * _Nullable error, OCVFSContent * _Nullable content))completionHandler
+{
+	OCVFSNode *containerNode = nil;
+	OCQuery *query = nil;
+	NSArray<OCVFSNode *> *vfsChildNodes = nil;
+	OCPath vfsContainerPath = nil;
+	OCLocation *queryLocation = nil;
+
+	[self _resolveContainerItemID:containerItemID containerNode:&containerNode vfsContainerPath:&vfsContainerPath queryLocation:&queryLocation];
+
 	if (vfsContainerPath != nil)
 	{
 		vfsChildNodes = [self childNodesOf:vfsContainerPath];
@@ -398,6 +440,154 @@
 	completionHandler(nil, content);
 }
 
+#pragma mark - Paged content
++ (OCVFSContentCursor)_cursorForChanges:(BOOL)changes name:(nullable NSString *)name databaseID:(nullable OCDatabaseID)databaseID syncAnchor:(nullable OCSyncAnchor)syncAnchor
+{
+	NSMutableDictionary<OCVFSContentCursorKey, id> *cursorDict = [NSMutableDictionary new];
+
+	cursorDict[OCVFSContentCursorKeyVersion] = @(1);
+	cursorDict[OCVFSContentCursorKeyChanges] = @(changes);
+	cursorDict[OCVFSContentCursorKeyName] = name;
+	cursorDict[OCVFSContentCursorKeyDatabaseID] = databaseID;
+	cursorDict[OCVFSContentCursorKeySyncAnchor] = syncAnchor;
+
+	return ([NSJSONSerialization dataWithJSONObject:cursorDict options:0 error:NULL]);
+}
+
++ (nullable NSDictionary<OCVFSContentCursorKey, id> *)_decodeCursor:(OCVFSContentCursor)cursor forChanges:(BOOL)changes
+{
+	NSDictionary<OCVFSContentCursorKey, id> *cursorDict;
+
+	if ((cursorDict = OCTypedCast([NSJSONSerialization JSONObjectWithData:cursor options:0 error:NULL], NSDictionary)) != nil)
+	{
+		if ([cursorDict[OCVFSContentCursorKeyVersion] isEqual:@(1)] &&
+		    ([cursorDict[OCVFSContentCursorKeyChanges] boolValue] == changes) &&
+		    (OCTypedCast(cursorDict[OCVFSContentCursorKeyDatabaseID], NSNumber) != nil))
+		{
+			return (cursorDict);
+		}
+	}
+
+	return (nil);
+}
+
+- (void)provideContentPageForContainerItemID:(nullable OCVFSItemID)containerItemID changesFromSyncAnchor:(nullable OCSyncAnchor)sinceSyncAnchor cursor:(nullable OCVFSContentCursor)cursor pageSize:(NSUInteger)pageSize completionHandler:(void(^)(NSError * _Nullable error, OCVFSContent * _Nullable content))completionHandler
+{
+	OCVFSNode *containerNode = nil;
+	NSArray<OCVFSNode *> *vfsChildNodes = nil;
+	OCPath vfsContainerPath = nil;
+	OCLocation *queryLocation = nil;
+	NSDictionary<OCVFSContentCursorKey, id> *cursorDict = nil;
+	BOOL changes = (sinceSyncAnchor != nil);
+	OCBookmark *bookmark = nil;
+
+	if (pageSize == 0)
+	{
+		pageSize = OCVFSCoreDefaultPageSize;
+	}
+
+	if ((cursor != nil) && ((cursorDict = [OCVFSCore _decodeCursor:cursor forChanges:changes]) == nil))
+	{
+		// Invalid or outdated cursor
+		completionHandler(OCError(OCErrorInvalidParameter), nil);
+		return;
+	}
+
+	[self _resolveContainerItemID:containerItemID containerNode:&containerNode vfsContainerPath:&vfsContainerPath queryLocation:&queryLocation];
+
+	if ((vfsContainerPath != nil) && (cursor == nil))
+	{
+		// Virtual child nodes are only returned as part of the first page
+		vfsChildNodes = [self childNodesOf:vfsContainerPath];
+	}
+
+	if (queryLocation.bookmarkUUID != nil)
+	{
+		bookmark = [OCBookmarkManager.sharedBookmarkManager bookmarkForUUID:queryLocation.bookmarkUUID];
+	}
+
+	if (bookmark == nil)
+	{
+		OCVFSContent *content = [[OCVFSContent alloc] init];
+
+		content.vfsChildNodes = vfsChildNodes;
+		content.isSnapshot = YES;
+		content.containerNode = containerNode;
+
+		completionHandler(nil, content);
+		return;
+	}
+
+	[OCCoreManager.sharedCoreManager requestCoreForBookmark:bookmark setup:nil completionHandler:^(OCCore * _Nullable core, NSError * _Nullable error) {
+		if (error != nil)
+		{
+			completionHandler(error, nil);
+			return;
+		}
+
+		OCVFSContent *content = [[OCVFSContent alloc] init];
+		OCDatabaseID afterDatabaseID = cursorDict[OCVFSContentCursorKeyDatabaseID];
+
+		content.bookmark = bookmark;
+		content.core = core; // the core is returned when content is deallocated
+
+		content.vfsChildNodes = vfsChildNodes;
+		content.isSnapshot = YES;
+		content.containerNode = containerNode;
+
+		if (changes)
+		{
+			OCSyncAnchor afterSyncAnchor = (cursorDict != nil) ? OCTypedCast(cursorDict[OCVFSContentCursorKeySyncAnchor], NSNumber) : sinceSyncAnchor;
+
+			if (afterSyncAnchor == nil)
+			{
+				completionHandler(OCError(OCErrorInvalidParameter), nil);
+				return;
+			}
+
+			[core.vault.database retrieveCacheItemsUpdatedAfterSyncAnchor:afterSyncAnchor databaseID:afterDatabaseID limit:pageSize completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+				if (error != nil)
+				{
+					completionHandler(error, nil);
+					return;
+				}
+
+				content.items = items;
+				content.syncAnchor = (syncAnchor != nil) ? syncAnchor : afterSyncAnchor;
+
+				if (items.count >= pageSize)
+				{
+					content.nextCursor = [OCVFSCore _cursorForChanges:YES name:nil databaseID:items.lastObject.databaseID syncAnchor:content.syncAnchor];
+				}
+
+				completionHandler(nil, content);
+			}];
+		}
+		else
+		{
+			OCSyncAnchor enumerationSyncAnchor = (cursorDict != nil) ? OCTypedCast(cursorDict[OCVFSContentCursorKeySyncAnchor], NSNumber) : core.latestSyncAnchor;
+
+			[core.vault.database retrieveCacheItemsAtLocation:queryLocation afterName:OCTypedCast(cursorDict[OCVFSContentCursorKeyName], NSString) databaseID:afterDatabaseID limit:pageSize completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+				if (error != nil)
+				{
+					completionHandler(error, nil);
+					return;
+				}
+
+				content.items = items;
+				content.syncAnchor = enumerationSyncAnchor;
+
+				if (items.count >= pageSize)
+				{
+					content.nextCursor = [OCVFSCore _cursorForChanges:NO name:items.lastObject.path.lastPathComponent databaseID:items.lastObject.databaseID syncAnchor:enumerationSyncAnchor];
+				}
+
+				completionHandler(nil, content);
+			}];
+		}
+	}];
+}
+
 - (OCVFSNode *)rootNode
 {
 	return ([self nodeAtPath:@"/"]);
@@ -405,36 +595,23 @@
 
 - (OCVFSNode *)driveRootNodeForLocation:(OCLocation *)location
 {
-	if (location == nil) { return (nil); }
+	if ((location == nil) || (location.bookmarkUUID == nil)) { return (nil); }
 
-	@synchronized(_nodes)
-	{
-		return ([_nodes firstObjectMatching:^BOOL(OCVFSNode * _Nonnull node) {
-			return ([node.location.bookmarkUUID isEqual:location.bookmarkUUID] && OCNAIsEqual(node.location.driveID, location.driveID) && node.location.path.isRootPath);
-		}]);
-	}
+	return ([_index driveRootNodeForBookmarkUUID:location.bookmarkUUID driveID:location.driveID]);
 }
 
 - (OCVFSNode *)nodeAtPath:(OCPath)vfsPath
 {
 	if (vfsPath == nil) { return (nil); }
 
-	@synchronized(_nodes)
-	{
-		return ([_nodes firstObjectMatching:^BOOL(OCVFSNode * _Nonnull node) {
-			return ([node.path isEqual:vfsPath]);
-		}]);
-	}
+	return ([_index nodeAtPath:vfsPath]);
 }
 
 - (NSArray<OCVFSNode *> *)childNodesOf:(OCPath)path
 {
-	@synchronized(_nodes)
-	{
-		return ([_nodes filteredArrayUsingBlock:^BOOL(OCVFSNode * _Nonnull node, BOOL * _Nonnull stop) {
-			return ([node.path.parentPath isEqual:path] && ![node.path isEqual:path]);
-		}]);
-	}
+	if (path == nil) { return (@[]); }
+
+	return ([_index childNodesOf:path]);
 }
 
 - (nullable OCVFSNode *)nodeForID:(OCVFSNodeID)nodeID
@@ -0,0 +1,53 @@
+//
+//  OCVFSIndex.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCVFSNode.h"
+#import "OCBookmark.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	In-memory index used by OCVFSCore to answer lookups without walking the node list, acquiring a core or querying a database:
+
+	- nodes: by path, child nodes by parent path and drive root nodes by bookmark UUID + drive ID. Rebuilt whenever the nodes change.
+	- items: OCItems resolved from VFS item IDs, by bookmark UUID and localID. Entries are dropped when their database rows are written
+	  (in-process: OCDatabaseCacheItemsChanged, other processes: the bookmark's coreUpdateNotificationName) and evicted under memory pressure.
+	  The index stores and returns copies, so items handed out can be modified without affecting the index.
+*/
+
+@interface OCVFSIndex : NSObject
+
+#pragma mark - Nodes
+- (void)setNodes:(NSArray<OCVFSNode *> *)nodes; //!< Rebuilds the node index for nodes. Where more than one node has the same path, the first one wins.
+
+- (nullable OCVFSNode *)nodeAtPath:(OCPath)path;
+- (NSArray<OCVFSNode *> *)childNodesOf:(OCPath)path;
+- (nullable OCVFSNode *)driveRootNodeForBookmarkUUID:(OCBookmarkUUID)bookmarkUUID driveID:(nullable OCDriveID)driveID;
+
+#pragma mark - Items
+- (nullable OCItem *)itemForLocalID:(OCLocalID)localID bookmarkUUID:(OCBookmarkUUID)bookmarkUUID; //!< Returns a copy of the indexed item
+
+- (NSUInteger)itemGenerationForBookmarkUUID:(OCBookmarkUUID)bookmarkUUID; //!< Returns the current generation of the bookmark's items. Retrieve it before fetching an item and pass it to -addItem:bookmarkUUID:generation:.
+- (void)addItem:(OCItem *)item bookmarkUUID:(OCBookmarkUUID)bookmarkUUID generation:(NSUInteger)generation; //!< Adds the item to the index - unless items of the bookmark changed since generation was retrieved (in which case item may already be outdated).
+
+- (void)invalidateItemsWithLocalIDs:(nullable NSArray<OCLocalID> *)localIDs bookmarkUUID:(OCBookmarkUUID)bookmarkUUID; //!< Removes the items with localIDs from the index - or all items of the bookmark if localIDs is nil.
+
+@end
+
+NS_ASSUME_NONNULL_END
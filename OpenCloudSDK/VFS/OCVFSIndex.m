@@ -0,0 +1,275 @@
+//
+//  OCVFSIndex.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCVFSIndex.h"
+#import "OCCore.h"
+#import "OCDatabase.h"
+#import "OCBookmarkManager.h"
+#import "OCBookmark+IPNotificationNames.h"
+#import "OCIPNotificationCenter.h"
+#import "NSString+OCPath.h"
+#import "OCMacros.h"
+
+#define OCVFSIndexMaximumItemsPerBookmark 10000
+
+@interface OCVFSIndexItemCache : NSObject
+
+@property(strong) NSCache<OCLocalID, OCItem *> *itemsByLocalID;
+@property(assign) NSUInteger generation;
+@property(strong,nullable) OCIPCNotificationName coreUpdateNotificationName;
+
+@end
+
+@implementation OCVFSIndexItemCache
+@end
+
+@interface OCVFSIndex ()
+{
+	NSDictionary<OCPath, OCVFSNode *> *_nodesByPath;
+	NSDictionary<OCPath, NSArray<OCVFSNode *> *> *_childNodesByParentPath;
+	NSDictionary<NSString *, OCVFSNode *> *_driveRootNodesByKey;
+
+	NSMutableDictionary<OCBookmarkUUID, OCVFSIndexItemCache *> *_itemCachesByBookmarkUUID;
+}
+@end
+
+@implementation OCVFSIndex
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_nodesByPath = @{};
+		_childNodesByParentPath = @{};
+		_driveRootNodesByKey = @{};
+
+		_itemCachesByBookmarkUUID = [NSMutableDictionary new];
+
+		[NSNotificationCenter.defaultCenter addObserver:self selector:@selector(_databaseCacheItemsChanged:) name:OCDatabaseCacheItemsChanged object:nil];
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	[NSNotificationCenter.defaultCenter removeObserver:self name:OCDatabaseCacheItemsChanged object:nil];
+
+	for (OCVFSIndexItemCache *itemCache in _itemCachesByBookmarkUUID.allValues)
+	{
+		if (itemCache.coreUpdateNotificationName != nil)
+		{
+			[OCIPNotificationCenter.sharedNotificationCenter removeObserver:self forName:itemCache.coreUpdateNotificationName];
+		}
+	}
+}
+
+#pragma mark - Nodes
++ (NSString *)_driveRootKeyForBookmarkUUID:(OCBookmarkUUID)bookmarkUUID driveID:(OCDriveID)driveID
+{
+	return ([NSString stringWithFormat:@"%@\\%@", bookmarkUUID.UUIDString, ((driveID != nil) ? driveID : @"")]);
+}
+
+- (void)setNodes:(NSArray<OCVFSNode *> *)nodes
+{
+	NSMutableDictionary<OCPath, OCVFSNode *> *nodesByPath = [NSMutableDictionary new];
+	NSMutableDictionary<OCPath, NSMutableArray<OCVFSNode *> *> *childNodesByParentPath = [NSMutableDictionary new];
+	NSMutableDictionary<NSString *, OCVFSNode *> *driveRootNodesByKey = [NSMutableDictionary new];
+
+	for (OCVFSNode *node in nodes)
+	{
+		OCPath path = node.path;
+		OCLocation *location = node.location;
+
+		if (path != nil)
+		{
+			OCPath parentPath;
+
+			if (nodesByPath[path] == nil)
+			{
+				nodesByPath[path] = node;
+			}
+
+			if (((parentPath = path.parentPath) != nil) && ![parentPath isEqual:path])
+			{
+				NSMutableArray<OCVFSNode *> *childNodes;
+
+				if ((childNodes = childNodesByParentPath[parentPath]) == nil)
+				{
+					childNodes = [NSMutableArray new];
+					childNodesByParentPath[parentPath] = childNodes;
+				}
+
+				[childNodes addObject:node];
+			}
+		}
+
+		if ((location.bookmarkUUID != nil) && location.path.isRootPath)
+		{
+			NSString *driveRootKey = [OCVFSIndex _driveRootKeyForBookmarkUUID:location.bookmarkUUID driveID:location.driveID];
+
+			if (driveRootNodesByKey[driveRootKey] == nil)
+			{
+				driveRootNodesByKey[driveRootKey] = node;
+			}
+		}
+	}
+
+	@synchronized(self)
+	{
+		_nodesByPath = nodesByPath;
+		_childNodesByParentPath = (NSDictionary<OCPath, NSArray<OCVFSNode *> *> *)childNodesByParentPath;
+		_driveRootNodesByKey = driveRootNodesByKey;
+	}
+}
+
+- (OCVFSNode *)nodeAtPath:(OCPath)path
+{
+	@synchronized(self)
+	{
+		return (_nodesByPath[path]);
+	}
+}
+
+- (NSArray<OCVFSNode *> *)childNodesOf:(OCPath)path
+{
+	NSArray<OCVFSNode *> *childNodes;
+
+	@synchronized(self)
+	{
+		childNodes = [_childNodesByParentPath[path] copy];
+	}
+
+	return ((childNodes != nil) ? childNodes : @[]);
+}
+
+- (OCVFSNode *)driveRootNodeForBookmarkUUID:(OCBookmarkUUID)bookmarkUUID driveID:(OCDriveID)driveID
+{
+	NSString *driveRootKey = [OCVFSIndex _driveRootKeyForBookmarkUUID:bookmarkUUID driveID:driveID];
+
+	@synchronized(self)
+	{
+		return (_driveRootNodesByKey[driveRootKey]);
+	}
+}
+
+#pragma mark - Items
+- (OCVFSIndexItemCache *)_itemCacheForBookmarkUUID:(OCBookmarkUUID)bookmarkUUID create:(BOOL)create
+{
+	OCVFSIndexItemCache *itemCache;
+
+	@synchronized(_itemCachesByBookmarkUUID)
+	{
+		if (((itemCache = _itemCachesByBookmarkUUID[bookmarkUUID]) == nil) && create)
+		{
+			OCBookmark *bookmark;
+
+			itemCache = [OCVFSIndexItemCache new];
+			itemCache.itemsByLocalID = [NSCache new];
+			itemCache.itemsByLocalID.countLimit = OCVFSIndexMaximumItemsPerBookmark;
+
+			// Changes made by other processes only come with the bookmark's notification name, so drop all of the bookmark's items
+			if ((bookmark = [OCBookmarkManager.sharedBookmarkManager bookmarkForUUID:bookmarkUUID]) != nil)
+			{
+				itemCache.coreUpdateNotificationName = bookmark.coreUpdateNotificationName;
+
+				[OCIPNotificationCenter.sharedNotificationCenter addObserver:self forName:itemCache.coreUpdateNotificationName withHandler:^(OCIPNotificationCenter * _Nonnull notificationCenter, OCVFSIndex * _Nonnull index, OCIPCNotificationName  _Nonnull notificationName) {
+					[index invalidateItemsWithLocalIDs:nil bookmarkUUID:bookmarkUUID];
+				}];
+			}
+
+			_itemCachesByBookmarkUUID[bookmarkUUID] = itemCache;
+		}
+	}
+
+	return (itemCache);
+}
+
+- (OCItem *)itemForLocalID:(OCLocalID)localID bookmarkUUID:(OCBookmarkUUID)bookmarkUUID
+{
+	if ((localID == nil) || (bookmarkUUID == nil)) { return (nil); }
+
+	// Return a copy, so changes made by the caller don't leak into the index
+	return ([[[self _itemCacheForBookmarkUUID:bookmarkUUID create:NO].itemsByLocalID objectForKey:localID] copy]);
+}
+
+- (NSUInteger)itemGenerationForBookmarkUUID:(OCBookmarkUUID)bookmarkUUID
+{
+	OCVFSIndexItemCache *itemCache = [self _itemCacheForBookmarkUUID:bookmarkUUID create:YES];
+
+	@synchronized(itemCache)
+	{
+		return (itemCache.generation);
+	}
+}
+
+- (void)addItem:(OCItem *)item bookmarkUUID:(OCBookmarkUUID)bookmarkUUID generation:(NSUInteger)generation
+{
+	OCVFSIndexItemCache *itemCache;
+
+	if ((item.localID == nil) || (bookmarkUUID == nil)) { return; }
+
+	if ((itemCache = [self _itemCacheForBookmarkUUID:bookmarkUUID create:YES]) != nil)
+	{
+		@synchronized(itemCache)
+		{
+			if (itemCache.generation == generation)
+			{
+				[itemCache.itemsByLocalID setObject:[item copy] forKey:item.localID];
+			}
+		}
+	}
+}
+
+- (void)invalidateItemsWithLocalIDs:(NSArray<OCLocalID> *)localIDs bookmarkUUID:(OCBookmarkUUID)bookmarkUUID
+{
+	OCVFSIndexItemCache *itemCache;
+
+	if ((itemCache = [self _itemCacheForBookmarkUUID:bookmarkUUID create:NO]) != nil)
+	{
+		@synchronized(itemCache)
+		{
+			// Bump the generation, so items fetched before the change aren't added afterwards
+			itemCache.generation++;
+
+			if (localIDs != nil)
+			{
+				for (OCLocalID localID in localIDs)
+				{
+					[itemCache.itemsByLocalID removeObjectForKey:localID];
+				}
+			}
+			else
+			{
+				[itemCache.itemsByLocalID removeAllObjects];
+			}
+		}
+	}
+}
+
+- (void)_databaseCacheItemsChanged:(NSNotification *)notification
+{
+	OCBookmarkUUID bookmarkUUID;
+
+	if ((bookmarkUUID = OCTypedCast(notification.object, OCDatabase).bookmarkUUID) != nil)
+	{
+		[self invalidateItemsWithLocalIDs:OCTypedCast(notification.userInfo[OCDatabaseCacheItemsChangedLocalIDsKey], NSArray) bookmarkUUID:bookmarkUUID];
+	}
+}
+
+@end
@@ -30,6 +30,8 @@ typedef NS_ENUM(NSInteger, OCVFSNodeType)
 //typedef id<NSObject> OCVFSOpaqueItem;
 typedef NSString* OCVFSNodeID;
 
+typedef NSData* OCVFSContentCursor; //!< Opaque cursor pointing to the next page of a paged content enumeration (suitable for use as NSFileProviderPage)
+
 typedef NSString* OCVFSItemID NS_TYPED_EXTENSIBLE_ENUM; // The Virtual File System Item ID, used as NSFileProviderItemIdentifier (with OCVFSItemIDRoot being mapped to NSFileProviderRootContainerItemIdentifier)
 /**
 	Supported OCVFSItemID formats:
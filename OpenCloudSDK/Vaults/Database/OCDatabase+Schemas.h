@@ -29,6 +29,7 @@ extern OCDatabaseTableName OCDatabaseTableNameMetaData;
 extern OCDatabaseTableName OCDatabaseTableNameSyncJournal;
 extern OCDatabaseTableName OCDatabaseTableNameSyncLanes;
 extern OCDatabaseTableName OCDatabaseTableNameUpdateJobs;
+extern OCDatabaseTableName OCDatabaseTableNamePrefetchedItemLists;
 extern OCDatabaseTableName OCDatabaseTableNameThumbnails;
 extern OCDatabaseTableName OCDatabaseTableNameResources;
 extern OCDatabaseTableName OCDatabaseTableNameCounters;
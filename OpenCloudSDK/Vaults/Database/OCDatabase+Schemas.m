@@ -42,6 +42,7 @@
 	[self addOrUpdateItemPoliciesSchema];
 
 	[self addOrUpdateUpdateJobs];
+	[self addOrUpdatePrefetchedItemListsSchema];
 }
 
 - (void)addOrUpdateMetaDataSchema
@@ -1341,6 +1342,91 @@
 			}]];
 		}]
 	];
+
+	// Version 20
+	/*
+		Add composite indexes over parentPath and the columns folder listings are most commonly sorted by, so that
+		sorted (windowed) folder contents can be retrieved straight from the index, without sorting in a temporary B-tree.
+	*/
+	[self.sqlDB addTableSchema:[OCSQLiteTableSchema
+		schemaWithTableName:OCDatabaseTableNameMetaData
+		version:20
+		creationQueries:@[
+			/*
+				mdID : INTEGER	  		- unique ID used to uniquely identify and efficiently update a row
+				type : INTEGER    		- OCItemType value to indicate if this is a file or a collection/folder
+				syncAnchor: INTEGER		- sync anchor, a number that increases its value with every change to an entry. For files, higher sync anchor values indicate the file changed (incl. creation, content or meta data changes). For collections/folders, higher sync anchor values indicate the list of items in the collection/folder changed in a way not covered by file entries (i.e. rename, deletion, but not creation of files).
+				removed : INTEGER		- value indicating if this file or folder has been removed: 1 if it was, 0 if not (default). Removed entries are kept around until their delta to the latest syncAnchor value exceeds -[OCDatabase removedItemRetentionLength].
+				mdTimestamp: INTEGER		- NSDate.timeIntervalSinceReferenceDate value of creation or last update of this record
+				locallyModified: INTEGER	- value indicating if this is a file that's been created or modified locally
+				localRelativePath: TEXT		- path of the local copy of the item, relative to the rootURL of the vault that stores it
+				locationString : TEXT		- OCLocation.string, built from driveID + path, can be used to find all items inside a folder on a drive
+				path : TEXT	  		- full path of the item (e.g. "/example/file.txt")
+				parentPath : TEXT 		- parent path of the item. (e.g. "/example" for an item at "/example/file.txt")
+				name : TEXT 	  		- name of the item (e.g. "file.txt" for an item at "/example/file.txt")
+				mimeType : TEXT			- MIME type of the item (OCMIMEType)
+				typeAlias : TEXT		- Type alias of the item (OCTypeAlias)
+				size : INTEGER			- size of the item
+				favorite : INTEGER		- BOOL indicating if the item is favorite (OCItem.isFavorite)
+				cloudStatus : INTEGER 		- Cloud status of the item (OCItem.cloudStatus)
+				downloadTrigger : TEXT		- What triggered the download of the item (OCItemDownloadTriggerID)
+				hasLocalAttributes : INTEGER 	- BOOL indicating an item with local attributes (OCItem.hasLocalAttributes)
+				lastUsedDate : REAL 		- NSDate.timeIntervalSince1970 value of OCItem.lastUsed
+				lastModifiedDate : REAL		- NSDate.timeIntervalSince1970 value of OCItem.lastModified
+				syncActivity : INTEGER 		- OCSyncActivity mask indicating which sync activity the item has (0 for none) (OCItem.syncActivity)
+				ownerUserName : TEXT		- User name of the owner of this item (OCItem.user.userName)
+				driveID : TEXT			- OCDriveID identifying the drive the item is located on
+				fileID : TEXT			- OCFileID identifying the item
+				localID : TEXT			- OCLocalID identifying the item
+				itemData : BLOB	  		- data of the serialized OCItem
+			*/
+			@"CREATE TABLE metaData (mdID INTEGER PRIMARY KEY AUTOINCREMENT, type INTEGER NOT NULL, syncAnchor INTEGER NOT NULL, removed INTEGER NOT NULL, mdTimestamp INTEGER NOT NULL, locallyModified INTEGER NOT NULL, localRelativePath TEXT NULL, locationString TEXT NOT NULL, path TEXT NOT NULL, parentPath TEXT NOT NULL, name TEXT NOT NULL COLLATE OCLOCALIZED, mimeType TEXT NULL, typeAlias TEXT NULL, size INTEGER NOT NULL, favorite INTEGER NOT NULL, cloudStatus INTEGER NOT NULL, downloadTrigger TEXT NULL, hasLocalAttributes INTEGER NOT NULL, lastUsedDate REAL NULL, lastModifiedDate REAL NULL, syncActivity INTEGER NULL, ownerUserName TEXT, driveID TEXT, fileID TEXT, localID TEXT, itemData BLOB NOT NULL)",
+
+			// Create indexes over path and parentPath
+			@"CREATE INDEX idx_metaData_locationString ON metaData (locationString)",
+			@"CREATE INDEX idx_metaData_path ON metaData (path)",
+			@"CREATE INDEX idx_metaData_parentPath ON metaData (parentPath)",
+			@"CREATE INDEX idx_metaData_synchAnchor ON metaData (syncAnchor)",
+			@"CREATE INDEX idx_metaData_localID ON metaData (localID)",
+			@"CREATE INDEX idx_metaData_driveID ON metaData (driveID)",
+			@"CREATE INDEX idx_metaData_fileID ON metaData (fileID)",
+			@"CREATE INDEX idx_metaData_typeAlias ON metaData (typeAlias)",
+			@"CREATE INDEX idx_metaData_removed ON metaData (removed)",
+			@"CREATE INDEX idx_metaData_downloadTrigger ON metaData (downloadTrigger)",
+			@"CREATE INDEX idx_metaData_cloudStatus ON metaData (cloudStatus)",
+
+			// Create indexes for sorted folder listings
+			@"CREATE INDEX idx_metaData_parentPath_name ON metaData (parentPath, name)",
+			@"CREATE INDEX idx_metaData_parentPath_lastModifiedDate ON metaData (parentPath, lastModifiedDate)",
+			@"CREATE INDEX idx_metaData_parentPath_size ON metaData (parentPath, size)",
+		]
+		openStatements:@[
+			// Create trigger to delete thumbnails alongside metadata entries
+			@"CREATE TEMPORARY TRIGGER temp_delete_associated_thumbnails AFTER DELETE ON metaData BEGIN DELETE FROM thumb.thumbnails WHERE fileID = OLD.fileID; END" // relatedTo:OCDatabaseTableNameThumbnails
+		]
+		upgradeMigrator:^(OCSQLiteDB *db, OCSQLiteTableSchema *schema, void (^completionHandler)(NSError *error)) {
+			// Migrate to version 20
+			[db executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError *(OCSQLiteDB *db, OCSQLiteTransaction *transaction) {
+				INSTALL_TRANSACTION_ERROR_COLLECTION_RESULT_HANDLER
+
+				// Create "parentPath, name" index
+				[db executeQuery:[OCSQLiteQuery query:@"CREATE INDEX idx_metaData_parentPath_name ON metaData (parentPath, name)" resultHandler:resultHandler]];
+				if (transactionError != nil) { return(transactionError); }
+
+				// Create "parentPath, lastModifiedDate" index
+				[db executeQuery:[OCSQLiteQuery query:@"CREATE INDEX idx_metaData_parentPath_lastModifiedDate ON metaData (parentPath, lastModifiedDate)" resultHandler:resultHandler]];
+				if (transactionError != nil) { return(transactionError); }
+
+				// Create "parentPath, size" index
+				[db executeQuery:[OCSQLiteQuery query:@"CREATE INDEX idx_metaData_parentPath_size ON metaData (parentPath, size)" resultHandler:resultHandler]];
+				if (transactionError != nil) { return(transactionError); }
+
+				return (transactionError);
+			} type:OCSQLiteTransactionTypeDeferred completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+				completionHandler(error);
+			}]];
+		}]
+	];
 }
 
 - (void)addOrUpdateSyncLanesSchema
@@ -1698,6 +1784,32 @@
 	];
 }
 
+- (void)addOrUpdatePrefetchedItemListsSchema
+{
+	/*** Prefetched item lists ***/
+
+	// Version 1
+	[self.sqlDB addTableSchema:[OCSQLiteTableSchema
+		schemaWithTableName:OCDatabaseTableNamePrefetchedItemLists
+		version:1
+		creationQueries:@[
+			/*
+				listID : INTEGER	- unique ID used to uniquely identify and efficiently update a row
+				location : TEXT		- OCLocationString of the folder the item list was retrieved for
+				retrievalID : TEXT	- ID of the subtree retrieval that stored the item list
+				expiry : REAL		- NSDate.timeIntervalSinceReferenceDate after which the item list is discarded
+				listData : BLOB		- archived array of the serialized items (folder item first, followed by its immediate children)
+			*/
+			@"CREATE TABLE prefetchedItemLists (listID INTEGER PRIMARY KEY AUTOINCREMENT, location TEXT NOT NULL UNIQUE, retrievalID TEXT NOT NULL, expiry REAL NOT NULL, listData BLOB NOT NULL)",
+
+			// Create index over retrievalID
+			@"CREATE INDEX idx_prefetchedItemLists_retrievalID ON prefetchedItemLists (retrievalID)"
+		]
+		openStatements:nil
+		upgradeMigrator:nil]
+	];
+}
+
 - (void)addOrUpdateEvents
 {
 	/*** Sync Events ***/
@@ -2010,6 +2122,7 @@ OCDatabaseTableName OCDatabaseTableNameMetaData = @"metaData";
 OCDatabaseTableName OCDatabaseTableNameSyncLanes = @"syncLanes";
 OCDatabaseTableName OCDatabaseTableNameSyncJournal = @"syncJournal";
 OCDatabaseTableName OCDatabaseTableNameUpdateJobs = @"updateJobs";
+OCDatabaseTableName OCDatabaseTableNamePrefetchedItemLists = @"prefetchedItemLists";
 OCDatabaseTableName OCDatabaseTableNameThumbnails = @"thumb.thumbnails"; // Places that need to be changed as well if this is changed are annotated with relatedTo:OCDatabaseTableNameThumbnails
 OCDatabaseTableName OCDatabaseTableNameResources = @"thumb.resources"; // Places that need to be changed as well if this is changed are annotated with relatedTo:OCDatabaseTableNameThumbnails or relatedTo:OCDatabaseTableNameResources
 OCDatabaseTableName OCDatabaseTableNameEvents = @"events";
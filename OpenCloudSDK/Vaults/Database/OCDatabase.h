@@ -43,6 +43,7 @@
 typedef void(^OCDatabaseCompletionHandler)(OCDatabase *db, NSError *error);
 typedef void(^OCDatabaseRetrieveCompletionHandler)(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray <OCItem *> *items);
 typedef void(^OCDatabaseRetrieveItemCompletionHandler)(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, OCItem *item);
+typedef void(^OCDatabaseRetrievePathsCompletionHandler)(OCDatabase *db, NSError *error, NSSet<OCPath> *paths);
 typedef void(^OCDatabaseRetrieveThumbnailCompletionHandler)(OCDatabase *db, NSError *error, CGSize maximumSizeInPixels, NSString *mimeType, NSData *thumbnailData);
 typedef void(^OCDatabaseRetrieveSyncRecordCompletionHandler)(OCDatabase *db, NSError *error, OCSyncRecord *syncRecord);
 typedef void(^OCDatabaseRetrieveSyncRecordsCompletionHandler)(OCDatabase *db, NSError *error, NSArray <OCSyncRecord *> *syncRecords);
@@ -56,6 +57,7 @@ typedef void(^OCDatabaseRetrieveDirectoryUpdateJobsCompletionHandler)(OCDatabase
 typedef void(^OCDatabaseProtectedBlockCompletionHandler)(NSError *error, NSNumber *previousCounterValue, NSNumber *newCounterValue);
 typedef void(^OCDatabaseRetrieveItemPoliciesCompletionHandler)(OCDatabase *db, NSError *error, NSArray<OCItemPolicy *> *itemPolicies);
 typedef void(^OCDatabaseItemIterator)(NSError *error, OCSyncAnchor syncAnchor, OCItem *item, BOOL *stop);
+typedef void(^OCDatabaseRetrieveDatabaseIDsCompletionHandler)(OCDatabase *db, NSError *error, NSArray<OCDatabaseID> *databaseIDs, NSArray<OCDatabaseTimestamp> *databaseTimestamps);
 
 typedef NSArray<OCItem *> *(^OCDatabaseItemFilter)(NSArray <OCItem *> *items);
 
@@ -91,6 +93,8 @@ typedef NSString* OCDatabaseCounterIdentifier;
 
 @property(strong) OCSQLiteDB *sqlDB;
 
+@property(strong) NSUUID *bookmarkUUID; //!< UUID of the bookmark whose items are stored in the database. Allows observers of OCDatabaseCacheItemsChanged to attribute changes to a bookmark.
+
 #pragma mark - Initialization
 - (instancetype)initWithURL:(NSURL *)databaseURL;
 
@@ -103,6 +107,7 @@ typedef NSString* OCDatabaseCounterIdentifier;
 
 #pragma mark - Meta data interface
 - (void)addCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler;
+- (void)addCacheItems:(NSArray <OCItem *> *)items serializedItemData:(nullable NSArray<NSData *> *)serializedItemData syncAnchor:(OCSyncAnchor)syncAnchor transactionSize:(NSUInteger)transactionSize completionHandler:(OCDatabaseCompletionHandler)completionHandler; //!< Variant for bulk loads: serializedItemData can provide the already serialized items (in the same order as items, f.ex. encoded on another thread), transactionSize determines the number of items inserted per transaction.
 - (void)updateCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler;
 - (void)removeCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler;
 - (void)removeCacheItemsWithDriveID:(OCDriveID)driveID syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler;
@@ -119,21 +124,39 @@ typedef NSString* OCDatabaseCounterIdentifier;
 
 - (void)retrieveCacheItemsAtLocation:(OCLocation *)location itemOnly:(BOOL)itemOnly completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler;
 - (NSArray <OCItem *> *)retrieveCacheItemsSyncAtLocation:(OCLocation *)location itemOnly:(BOOL)itemOnly error:(NSError * __autoreleasing *)outError syncAnchor:(OCSyncAnchor __autoreleasing *)outSyncAnchor;
+- (void)retrieveCacheItemPathsInParentLocation:(OCLocation *)parentLocation withNamePrefix:(NSString *)namePrefix completionHandler:(OCDatabaseRetrievePathsCompletionHandler)completionHandler; //!< Retrieves the paths of all (non-removed) items directly inside parentLocation whose name starts with namePrefix (case-insensitive for ASCII characters). Only reads the path column, using the parentPath index.
 
 - (void)retrieveCacheItemsRecursivelyBelowLocation:(OCLocation *)location includingPathItself:(BOOL)includingPathItself includingRemoved:(BOOL)includingRemoved completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler;
 
 - (void)retrieveCacheItemsUpdatedSinceSyncAnchor:(OCSyncAnchor)synchAnchor foldersOnly:(BOOL)foldersOnly completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler;
 
 - (void)retrieveCacheItemsForQueryCondition:(OCQueryCondition *)queryCondition cancelAction:(OCCancelAction *)cancelAction completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler;
+- (void)retrieveCacheItemsForQueryCondition:(OCQueryCondition *)queryCondition sortedBy:(OCItemPropertyName)sortPropertyName ascending:(BOOL)ascending cancelAction:(OCCancelAction *)cancelAction completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler; //!< Like -retrieveCacheItemsForQueryCondition:cancelAction:completionHandler:, but returns the items already ordered by sortPropertyName, which must be supported by an index (see +supportsSortingByPropertyName:). The order matches that of -[OCQuerySortDescriptor comparator].
 
 - (void)iterateCacheItemsWithIterator:(OCDatabaseItemIterator)iterator; //!< Iterates through all cache items using the passed iterator block. The last invocation of the iterator will be with nil values for syncAnchor, item; NULL for stop.
 - (void)iterateCacheItemsForQueryCondition:(OCQueryCondition *)queryCondition excludeRemoved:(BOOL)excludeRemoved withIterator:(OCDatabaseItemIterator)iterator; //!< Iterates through matching cache items using the passed iterator block. The last invocation of the iterator will be with nil values for syncAnchor, item; NULL for stop.
 
+#pragma mark - Sorted / windowed meta data interface
++ (BOOL)supportsSortingByPropertyName:(OCItemPropertyName)propertyName; //!< Returns YES if sorting by the property is backed by an index of the metaData table
++ (NSString *)sqlOrderByClauseForSortPropertyName:(OCItemPropertyName)propertyName ascending:(BOOL)ascending; //!< Returns an ORDER BY clause (f.ex. "ORDER BY name ASC, mdID ASC") for an indexed sort property - or nil if the property isn't supported
+
+- (void)retrieveCacheItemDatabaseIDsAtLocation:(OCLocation *)location queryCondition:(OCQueryCondition *)queryCondition sortedBy:(OCItemPropertyName)sortPropertyName ascending:(BOOL)ascending completionHandler:(OCDatabaseRetrieveDatabaseIDsCompletionHandler)completionHandler; //!< Retrieves only the database IDs and timestamps of the non-removed items located in location (if provided) and matching queryCondition (if provided), in the order determined by sortPropertyName, which must be supported by an index (see +supportsSortingByPropertyName:). Pass nil for sortPropertyName to retrieve the IDs in database order.
+- (void)retrieveCacheItemsForDatabaseIDs:(NSArray<OCDatabaseID> *)databaseIDs completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler; //!< Retrieves the items with the provided database IDs. The order of the returned items is undefined. Items no longer in the database are omitted.
+
+#pragma mark - Paged meta data interface
+- (void)retrieveCacheItemsAtLocation:(OCLocation *)location afterName:(nullable NSString *)afterName databaseID:(nullable OCDatabaseID)afterDatabaseID limit:(NSUInteger)limit completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler; //!< Retrieves up to limit non-removed children of location, ordered by (binary) name and database ID, starting after the item with afterName and afterDatabaseID (pass nil for both to start with the first page). Backed by the (parentPath, name) index.
+- (void)retrieveCacheItemsUpdatedAfterSyncAnchor:(OCSyncAnchor)syncAnchor databaseID:(nullable OCDatabaseID)afterDatabaseID limit:(NSUInteger)limit completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler; //!< Retrieves up to limit items (including removed ones) changed after syncAnchor, ordered by sync anchor and database ID. Pass the sync anchor and database ID of the last item of the previous page to retrieve the next page. Backed by the syncAnchor index.
+
 #pragma mark - Update Scan interface
 - (void)addDirectoryUpdateJob:(OCCoreDirectoryUpdateJob *)updateScanPath completionHandler:(OCDatabaseDirectoryUpdateJobCompletionHandler)completionHandler;
 - (void)retrieveDirectoryUpdateJobsAfter:(OCCoreDirectoryUpdateJobID)jobID forLocation:(OCLocation *)location maximumJobs:(NSUInteger)maximumJobs completionHandler:(OCDatabaseRetrieveDirectoryUpdateJobsCompletionHandler)completionHandler;
 - (void)removeDirectoryUpdateJobWithID:(OCCoreDirectoryUpdateJobID)jobID completionHandler:(OCDatabaseCompletionHandler)completionHandler;
 
+#pragma mark - Prefetched item list interface
+- (void)addPrefetchedItemLists:(NSDictionary<OCLocationString, NSArray<OCItem *> *> *)itemListsByLocationString retrievalID:(NSString *)retrievalID lifetime:(NSTimeInterval)lifetime completionHandler:(OCDatabaseCompletionHandler)completionHandler; //!< Stores item lists retrieved by a subtree retrieval in a single transaction, replacing lists stored for the same locations. An empty list removes the list stored for its location. The lists expire after lifetime seconds.
+- (NSArray<OCItem *> *)consumePrefetchedItemListForLocationString:(OCLocationString)locationString lifetime:(NSTimeInterval)lifetime remainingCount:(NSUInteger *)outRemainingCount; //!< Synchronously returns and removes the item list stored for locationString - or nil if there is none. Expired lists are removed first. If a list is returned, the remaining lists expire lifetime seconds from now.
+- (void)removePrefetchedItemListsForRetrievalID:(NSString *)retrievalID completionHandler:(OCDatabaseCompletionHandler)completionHandler; //!< Removes the item lists stored by the retrieval with retrievalID - or all item lists if retrievalID is nil.
+
 #pragma mark - Sync Lane interface
 - (void)addSyncLane:(OCSyncLane *)lane completionHandler:(OCDatabaseCompletionHandler)completionHandler;
 - (void)updateSyncLane:(OCSyncLane *)lane completionHandler:(OCDatabaseCompletionHandler)completionHandler;
@@ -141,6 +164,7 @@ typedef NSString* OCDatabaseCounterIdentifier;
 - (void)retrieveSyncLaneForID:(OCSyncLaneID)laneID completionHandler:(OCDatabaseRetrieveSyncLaneCompletionHandler)completionHandler;
 - (void)retrieveSyncLanesWithCompletionHandler:(OCDatabaseRetrieveSyncLanesCompletionHandler)completionHandler;
 - (OCSyncLane *)laneForTags:(NSSet <OCSyncLaneTag> *)tags updatedLanes:(BOOL *)outUpdatedLanes readOnly:(BOOL)readOnly;
+- (NSArray *)lanesForTagSets:(NSArray<NSSet <OCSyncLaneTag> *> *)tagSets updatedLanes:(BOOL *)outUpdatedLanes; //!< Returns (and, where needed, creates) the lanes for an array of tag sets in a single pass over the sync lanes table. The returned array has the same order as tagSets and contains NSNull for tag sets without lane.
 
 #pragma mark - Sync Journal interface
 - (void)addSyncRecords:(NSArray <OCSyncRecord *> *)syncRecords completionHandler:(OCDatabaseCompletionHandler)completionHandler;
@@ -178,4 +202,7 @@ typedef NSString* OCDatabaseCounterIdentifier;
 
 @end
 
+extern NSNotificationName OCDatabaseCacheItemsChanged; //!< Notification sent (in-process only) after cache items were added, updated, removed or purged - regardless of who wrote them. The object is the OCDatabase. The localIDs of the affected items are provided via OCDatabaseCacheItemsChangedLocalIDsKey. If the key is missing, any item may have changed.
+extern NSString *OCDatabaseCacheItemsChangedLocalIDsKey; //!< userInfo key for OCDatabaseCacheItemsChanged, providing an NSArray<OCLocalID> of the affected items.
+
 #import "OCDatabase+Schemas.h"
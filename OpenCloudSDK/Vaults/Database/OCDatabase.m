@@ -39,6 +39,7 @@
 #import "OCPlatform.h"
 #import "NSArray+OCSegmentedProcessing.h"
 #import "OCSQLiteDB+Internal.h"
+#import "OCMeasurement.h"
 
 #import <objc/runtime.h>
 
@@ -124,7 +125,11 @@
 			return;
 		}
 
+		OCMeasureEventBegin(self, @"db.open", dbOpenRef, @"Opening database");
+
 		[self.sqlDB openWithFlags:OCSQLiteOpenFlagsDefault completionHandler:^(OCSQLiteDB *db, NSError *error) {
+			OCMeasureEventEnd(self, @"db.open", dbOpenRef, @"Opened database");
+
 			db.maxBusyRetryTimeInterval = 10; // Avoid busy timeout if another process performs large changes
 			[db executeQueryString:@"PRAGMA synchronous=FULL"]; // Force checkpoint / synchronization after every transaction
 
@@ -137,13 +142,25 @@
 				[self.sqlDB executeQuery:[OCSQLiteQuery query:@"ATTACH DATABASE ? AS 'thumb'" withParameters:@[ thumbnailsDBPath ] resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) { // relatedTo:OCDatabaseTableNameThumbnails
 					if (error == nil)
 					{
+						OCMeasureEventBegin(self, @"db.schemas", dbSchemasRef, @"Applying table schemas and migrations");
+
 						[self.sqlDB applyTableSchemasWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+							OCMeasureEventEnd(self, @"db.schemas", dbSchemasRef, @"Applied table schemas and migrations");
+
 							if (error == nil)
 							{
 								[self.sqlDB executeQueryString:@"PRAGMA journal_mode"];
 
 								[self.sqlDB dropTableSchemas]; //!< Table schemas no longer needed, save memory
 
+								// Recreate indexes left deferred by an interrupted bulk load
+								[self.sqlDB restoreDeferredIndexesWithCompletionHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error) {
+									if (error != nil)
+									{
+										OCLogError(@"Error restoring deferred indexes: %@", error);
+									}
+								}];
+
 								if (completionHandler!=nil)
 								{
 									completionHandler(self, error);
@@ -268,12 +285,24 @@
 }
 
 - (void)addCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler
+{
+	[self addCacheItems:items serializedItemData:nil syncAnchor:syncAnchor transactionSize:((_memoryConfiguration == OCPlatformMemoryConfigurationMinimum) ? 10 : 200) completionHandler:completionHandler];
+}
+
+- (void)addCacheItems:(NSArray <OCItem *> *)items serializedItemData:(NSArray<NSData *> *)serializedItemData syncAnchor:(OCSyncAnchor)syncAnchor transactionSize:(NSUInteger)transactionSize completionHandler:(OCDatabaseCompletionHandler)completionHandler
 {
 	OCDatabaseTimestamp mdTimestamp = [self _timestampForSyncAnchor:syncAnchor];
 
 	if (_itemFilter != nil)
 	{
+		// The filter may drop or modify items, so serialized data provided for them can't be used
 		items = _itemFilter(items);
+		serializedItemData = nil;
+	}
+
+	if ((serializedItemData != nil) && (serializedItemData.count != items.count))
+	{
+		serializedItemData = nil;
 	}
 
 	[items enumerateObjectsWithTransformer:^id _Nullable(OCItem * _Nonnull item, NSUInteger idx, BOOL * _Nonnull stop) {
@@ -314,7 +343,7 @@
 			@"fileID"		: OCSQLiteNullProtect(item.fileID),
 			@"localID"		: OCSQLiteNullProtect(item.localID),
 			@"ownerUserName"	: OCSQLiteNullProtect(item.ownerUserName),
-			@"itemData"		: [item serializedData]
+			@"itemData"		: ((serializedItemData != nil) ? serializedItemData[idx] : [item serializedData])
 		} resultHandler:^(OCSQLiteDB *db, NSError *error, NSNumber *rowID) {
 			item.databaseID = rowID;
 			item.databaseTimestamp = mdTimestamp;
@@ -333,16 +362,19 @@
 
 			if ((processed == total) || (error != nil))
 			{
+				[self _postCacheItemsChangedNotificationForItems:items];
+
 				completionHandler(self, error);
 			}
 		}]];
-	} segmentSize:((_memoryConfiguration == OCPlatformMemoryConfigurationMinimum) ? 10 : 200)];
+	} segmentSize:((transactionSize > 0) ? transactionSize : 200)];
 }
 
 - (void)updateCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler
 {
 	OCDatabaseTimestamp mdTimestamp = [self _timestampForSyncAnchor:syncAnchor];
 	__block NSMutableSet<OCLocationString> *removedLocations = nil;
+	__block BOOL removedFolders = NO;
 
 	if (_itemFilter != nil)
 	{
@@ -436,6 +468,7 @@
 			}
 
 			removedLocations = nil;
+			removedFolders = YES;
 		}
 
 		[self.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithQueries:combinedQueries type:OCSQLiteTransactionTypeDeferred completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
@@ -449,6 +482,9 @@
 
 			if ((processed == total) || (error != nil))
 			{
+				// Items inside removed folders are updated without knowing their localIDs
+				[self _postCacheItemsChangedNotificationForItems:(removedFolders ? nil : items)];
+
 				completionHandler(self, error);
 			}
 		}]];
@@ -497,6 +533,8 @@
 		}
 
 		[self.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithQueries:queries type:OCSQLiteTransactionTypeDeferred completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+			[self _postCacheItemsChangedNotificationForItems:nil];
+
 			if (completionHandler != nil)
 			{
 				completionHandler(self, error);
@@ -525,6 +563,8 @@
 			@"syncAnchor" 	: syncAnchor,
 			@"mdTimestamp"	: mdTimestamp
 		} completionHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error) {
+			[self _postCacheItemsChangedNotificationForItems:nil];
+
 			if (completionHandler != nil)
 			{
 				completionHandler(self, error);
@@ -547,6 +587,8 @@
 	else
 	{
 		OCSQLiteQuery *query = [OCSQLiteQuery queryDeletingRowsWhere:@{ @"driveID" : driveID } fromTable:OCDatabaseTableNameMetaData completionHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error) {
+			[self _postCacheItemsChangedNotificationForItems:nil];
+
 			if (completionHandler != nil)
 			{
 				completionHandler(self, error);
@@ -557,6 +599,33 @@
 	}
 }
 
+- (void)_postCacheItemsChangedNotificationForItems:(NSArray<OCItem *> *)items
+{
+	NSMutableArray<OCLocalID> *localIDs = nil;
+
+	if (items != nil)
+	{
+		localIDs = [[NSMutableArray alloc] initWithCapacity:items.count];
+
+		for (OCItem *item in items)
+		{
+			if (item.localID != nil)
+			{
+				[localIDs addObject:item.localID];
+			}
+		}
+
+		if (localIDs.count == 0)
+		{
+			return;
+		}
+	}
+
+	[NSNotificationCenter.defaultCenter postNotificationName:OCDatabaseCacheItemsChanged object:self userInfo:((localIDs != nil) ? @{
+		OCDatabaseCacheItemsChangedLocalIDsKey : localIDs
+	} : nil)];
+}
+
 - (OCItem *)_itemFromResultDict:(NSDictionary<NSString *,id<NSObject>> *)resultDict
 {
 	NSData *itemData;
@@ -818,6 +887,50 @@
 	[self _retrieveCacheItemsForSQLQuery:sqlQueryString parameters:parameters cancelAction:nil completionHandler:completionHandler];
 }
 
+- (void)retrieveCacheItemPathsInParentLocation:(OCLocation *)parentLocation withNamePrefix:(NSString *)namePrefix completionHandler:(OCDatabaseRetrievePathsCompletionHandler)completionHandler
+{
+	NSString *sqlQueryString = @"SELECT path FROM metaData WHERE parentPath=? AND name LIKE ? AND removed=0";
+	NSArray *parameters = nil;
+
+	if (parentLocation.path == nil)
+	{
+		completionHandler(self, OCError(OCErrorInsufficientParameters), nil);
+		return;
+	}
+
+	parameters = @[ parentLocation.path.normalizedDirectoryPath, [((namePrefix != nil) ? namePrefix.stringBySQLLikeEscaping : @"") stringByAppendingString:@"%"] ];
+
+	if (parentLocation.driveID == nil)
+	{
+		sqlQueryString = [sqlQueryString stringByAppendingString:@" AND driveID IS NULL"];
+	}
+	else
+	{
+		sqlQueryString = [sqlQueryString stringByAppendingString:@" AND driveID=?"];
+		parameters = [parameters arrayByAddingObject:parentLocation.driveID];
+	}
+
+	[self.sqlDB executeQuery:[OCSQLiteQuery query:sqlQueryString withParameters:parameters resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+		NSMutableSet<OCPath> *paths = nil;
+
+		if (error == nil)
+		{
+			paths = [NSMutableSet new];
+
+			[resultSet iterateUsing:^(OCSQLiteResultSet * _Nonnull resultSet, NSUInteger line, OCSQLiteRowDictionary  _Nonnull rowDictionary, BOOL * _Nonnull stop) {
+				OCPath path;
+
+				if ((path = (OCPath)rowDictionary[@"path"]) != nil)
+				{
+					[paths addObject:path];
+				}
+			} error:&error];
+		}
+
+		completionHandler(self, error, paths);
+	}]];
+}
+
 - (NSArray <OCItem *> *)retrieveCacheItemsSyncAtLocation:(OCLocation *)location itemOnly:(BOOL)itemOnly error:(NSError * __autoreleasing *)outError syncAnchor:(OCSyncAnchor __autoreleasing *)outSyncAnchor
 {
 	__block NSArray <OCItem *> *items = nil;
@@ -909,6 +1022,45 @@
 	}
 }
 
+- (void)retrieveCacheItemsForQueryCondition:(OCQueryCondition *)queryCondition sortedBy:(OCItemPropertyName)sortPropertyName ascending:(BOOL)ascending cancelAction:(OCCancelAction *)cancelAction completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler
+{
+	NSString *orderByClause = nil;
+	NSString *sqlQueryString = nil;
+	NSString *sqlWhereString = nil;
+	NSArray *parameters = nil;
+	NSError *error = nil;
+
+	if (sortPropertyName == nil)
+	{
+		[self retrieveCacheItemsForQueryCondition:queryCondition cancelAction:cancelAction completionHandler:completionHandler];
+		return;
+	}
+
+	if ((orderByClause = [OCDatabase sqlOrderByClauseForSortPropertyName:sortPropertyName ascending:ascending]) == nil)
+	{
+		completionHandler(self, OCError(OCErrorInvalidParameter), nil, nil);
+		return;
+	}
+
+	if ((sqlWhereString = [queryCondition buildSQLQueryWithPropertyColumnNameMap:[[self class] columnNameByPropertyName] parameters:&parameters error:&error]) == nil)
+	{
+		completionHandler(self, error, nil, nil);
+		return;
+	}
+
+	if ((queryCondition.sortBy == nil) && (queryCondition.maxResultCount == nil))
+	{
+		sqlQueryString = [_selectItemRowsSQLQueryPrefix stringByAppendingFormat:@", removed FROM metaData WHERE removed=0 AND %@ %@", sqlWhereString, orderByClause];
+	}
+	else
+	{
+		// The condition comes with its own ORDER BY / LIMIT: determine the matching rows in a subquery and order the result
+		sqlQueryString = [_selectItemRowsSQLQueryPrefix stringByAppendingFormat:@", removed FROM metaData WHERE mdID IN (SELECT mdID FROM metaData WHERE removed=0 AND %@) %@", sqlWhereString, orderByClause];
+	}
+
+	[self _retrieveCacheItemsForSQLQuery:sqlQueryString parameters:parameters cancelAction:cancelAction completionHandler:completionHandler];
+}
+
 - (void)iterateCacheItemsWithIterator:(void(^)(NSError *error, OCSyncAnchor syncAnchor, OCItem *item, BOOL *stop))iterator
 {
 	NSString *sqlQueryString = [_selectItemRowsSQLQueryPrefix stringByAppendingString:@", removed FROM metaData ORDER BY mdID ASC"];
@@ -972,6 +1124,239 @@
 	}]];
 }
 
+#pragma mark - Sorted / windowed meta data interface
++ (NSDictionary<OCItemPropertyName, NSString *> *)indexedSortColumnNameByPropertyName
+{
+	static dispatch_once_t onceToken;
+	static NSDictionary<OCItemPropertyName, NSString *> *indexedSortColumnNameByPropertyName;
+
+	dispatch_once(&onceToken, ^{
+		// Only include columns for which an index exists (see metaData schema version 20)
+		indexedSortColumnNameByPropertyName = @{
+			OCItemPropertyNameName 		: @"name",
+			OCItemPropertyNameLastModified 	: @"lastModifiedDate",
+			OCItemPropertyNameSize 		: @"size"
+		};
+	});
+
+	return (indexedSortColumnNameByPropertyName);
+}
+
++ (BOOL)supportsSortingByPropertyName:(OCItemPropertyName)propertyName
+{
+	return ((propertyName != nil) && (self.indexedSortColumnNameByPropertyName[propertyName] != nil));
+}
+
++ (NSString *)sqlOrderByClauseForSortPropertyName:(OCItemPropertyName)propertyName ascending:(BOOL)ascending
+{
+	NSString *columnName;
+
+	if ((propertyName != nil) && ((columnName = self.indexedSortColumnNameByPropertyName[propertyName]) != nil))
+	{
+		// Use mdID as tie breaker to achieve a stable order
+		NSString *direction = ascending ? @"ASC" : @"DESC";
+
+		return ([NSString stringWithFormat:@"ORDER BY %@ %@, mdID %@", columnName, direction, direction]);
+	}
+
+	return (nil);
+}
+
+- (void)retrieveCacheItemDatabaseIDsAtLocation:(OCLocation *)location queryCondition:(OCQueryCondition *)queryCondition sortedBy:(OCItemPropertyName)sortPropertyName ascending:(BOOL)ascending completionHandler:(OCDatabaseRetrieveDatabaseIDsCompletionHandler)completionHandler
+{
+	NSMutableString *sqlQueryString = [@"SELECT mdID, mdTimestamp FROM metaData WHERE removed=0" mutableCopy];
+	NSMutableArray *parameters = [NSMutableArray new];
+	NSString *orderByClause = nil;
+
+	if ((location == nil) && (queryCondition == nil))
+	{
+		completionHandler(self, OCError(OCErrorInsufficientParameters), nil, nil);
+		return;
+	}
+
+	if (location != nil)
+	{
+		if (location.path == nil)
+		{
+			completionHandler(self, OCError(OCErrorInsufficientParameters), nil, nil);
+			return;
+		}
+
+		// Children only, excluding the location itself
+		[sqlQueryString appendString:@" AND parentPath=? AND path!=?"];
+		[parameters addObject:location.path];
+		[parameters addObject:location.path];
+
+		if (location.driveID == nil)
+		{
+			[sqlQueryString appendString:@" AND driveID IS NULL"];
+		}
+		else
+		{
+			[sqlQueryString appendString:@" AND driveID=?"];
+			[parameters addObject:location.driveID];
+		}
+	}
+
+	if (queryCondition != nil)
+	{
+		NSString *sqlWhereString = nil;
+		NSArray *conditionParameters = nil;
+		NSError *error = nil;
+
+		if ((sqlWhereString = [queryCondition buildSQLQueryWithPropertyColumnNameMap:[[self class] columnNameByPropertyName] parameters:&conditionParameters error:&error]) == nil)
+		{
+			completionHandler(self, error, nil, nil);
+			return;
+		}
+
+		[sqlQueryString appendFormat:@" AND (%@)", sqlWhereString];
+
+		if (conditionParameters != nil)
+		{
+			[parameters addObjectsFromArray:conditionParameters];
+		}
+	}
+
+	if (sortPropertyName != nil)
+	{
+		if ((orderByClause = [OCDatabase sqlOrderByClauseForSortPropertyName:sortPropertyName ascending:ascending]) == nil)
+		{
+			OCLogError(@"Sorting by %@ is not supported by an index", sortPropertyName);
+			completionHandler(self, OCError(OCErrorInvalidParameter), nil, nil);
+			return;
+		}
+	}
+	else
+	{
+		orderByClause = @"ORDER BY mdID ASC";
+	}
+
+	[sqlQueryString appendFormat:@" %@", orderByClause];
+
+	[self.sqlDB executeQuery:[OCSQLiteQuery query:sqlQueryString withParameters:parameters resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+		NSMutableArray<OCDatabaseID> *databaseIDs = nil;
+		NSMutableArray<OCDatabaseTimestamp> *databaseTimestamps = nil;
+		NSError *returnError = error;
+
+		if (returnError == nil)
+		{
+			databaseIDs = [NSMutableArray new];
+			databaseTimestamps = [NSMutableArray new];
+
+			[resultSet iterateUsing:^(OCSQLiteResultSet *resultSet, NSUInteger line, NSDictionary<NSString *,id<NSObject>> *resultDict, BOOL *stop) {
+				NSNumber *databaseID, *databaseTimestamp;
+
+				if (((databaseID = (NSNumber *)resultDict[@"mdID"]) != nil) && ((databaseTimestamp = (NSNumber *)resultDict[@"mdTimestamp"]) != nil))
+				{
+					[databaseIDs addObject:databaseID];
+					[databaseTimestamps addObject:databaseTimestamp];
+				}
+			} error:&returnError];
+		}
+
+		if (returnError != nil)
+		{
+			completionHandler(self, returnError, nil, nil);
+		}
+		else
+		{
+			completionHandler(self, nil, databaseIDs, databaseTimestamps);
+		}
+	}]];
+}
+
+- (void)retrieveCacheItemsForDatabaseIDs:(NSArray<OCDatabaseID> *)databaseIDs completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler
+{
+	NSMutableArray<NSString *> *idStrings;
+
+	if (databaseIDs.count == 0)
+	{
+		completionHandler(self, nil, nil, @[]);
+		return;
+	}
+
+	// Database IDs are integers and can therefore safely be inlined, avoiding the limit on the number of parameters
+	idStrings = [[NSMutableArray alloc] initWithCapacity:databaseIDs.count];
+
+	for (OCDatabaseID databaseID in databaseIDs)
+	{
+		NSNumber *databaseIDNumber;
+
+		if ((databaseIDNumber = OCTypedCast(databaseID, NSNumber)) != nil)
+		{
+			[idStrings addObject:[NSString stringWithFormat:@"%lld", databaseIDNumber.longLongValue]];
+		}
+	}
+
+	[self _retrieveCacheItemsForSQLQuery:[_selectItemRowsSQLQueryPrefix stringByAppendingFormat:@", removed FROM metaData WHERE mdID IN (%@)", [idStrings componentsJoinedByString:@","]] parameters:nil cancelAction:nil completionHandler:completionHandler];
+}
+
+#pragma mark - Paged meta data interface
+- (void)retrieveCacheItemsAtLocation:(OCLocation *)location afterName:(nullable NSString *)afterName databaseID:(nullable OCDatabaseID)afterDatabaseID limit:(NSUInteger)limit completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler
+{
+	NSMutableString *sqlQueryString = [[_selectItemRowsSQLQueryPrefix stringByAppendingString:@", removed FROM metaData WHERE parentPath=? AND path!=? AND removed=0"] mutableCopy];
+	NSMutableArray *parameters = [NSMutableArray new];
+
+	if ((location.path == nil) || (limit == 0))
+	{
+		completionHandler(self, OCError(OCErrorInsufficientParameters), nil, nil);
+		return;
+	}
+
+	[parameters addObject:location.path];
+	[parameters addObject:location.path];
+
+	if (location.driveID == nil)
+	{
+		[sqlQueryString appendString:@" AND driveID IS NULL"];
+	}
+	else
+	{
+		[sqlQueryString appendString:@" AND driveID=?"];
+		[parameters addObject:location.driveID];
+	}
+
+	if ((afterName != nil) && (afterDatabaseID != nil))
+	{
+		// Continue after the last item of the previous page
+		[sqlQueryString appendString:@" AND (name > ? OR (name = ? AND mdID > ?))"];
+		[parameters addObject:afterName];
+		[parameters addObject:afterName];
+		[parameters addObject:afterDatabaseID];
+	}
+
+	[sqlQueryString appendFormat:@" ORDER BY name ASC, mdID ASC LIMIT %lu", (unsigned long)limit];
+
+	[self _retrieveCacheItemsForSQLQuery:sqlQueryString parameters:parameters cancelAction:nil completionHandler:completionHandler];
+}
+
+- (void)retrieveCacheItemsUpdatedAfterSyncAnchor:(OCSyncAnchor)syncAnchor databaseID:(nullable OCDatabaseID)afterDatabaseID limit:(NSUInteger)limit completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler
+{
+	NSString *sqlQueryString = nil;
+	NSArray *parameters = nil;
+
+	if ((syncAnchor == nil) || (limit == 0))
+	{
+		completionHandler(self, OCError(OCErrorInsufficientParameters), nil, nil);
+		return;
+	}
+
+	if (afterDatabaseID != nil)
+	{
+		// Continue after the last item of the previous page
+		sqlQueryString = [_selectItemRowsSQLQueryPrefix stringByAppendingFormat:@", removed FROM metaData WHERE (syncAnchor > ? OR (syncAnchor = ? AND mdID > ?)) ORDER BY syncAnchor ASC, mdID ASC LIMIT %lu", (unsigned long)limit];
+		parameters = @[ syncAnchor, syncAnchor, afterDatabaseID ];
+	}
+	else
+	{
+		sqlQueryString = [_selectItemRowsSQLQueryPrefix stringByAppendingFormat:@", removed FROM metaData WHERE syncAnchor > ? ORDER BY syncAnchor ASC, mdID ASC LIMIT %lu", (unsigned long)limit];
+		parameters = @[ syncAnchor ];
+	}
+
+	[self _retrieveCacheItemsForSQLQuery:sqlQueryString parameters:parameters cancelAction:nil completionHandler:completionHandler];
+}
+
 #pragma mark - Directory Update Job interface
 - (void)addDirectoryUpdateJob:(OCCoreDirectoryUpdateJob *)updateJob completionHandler:(OCDatabaseDirectoryUpdateJobCompletionHandler)completionHandler
 {
@@ -1049,6 +1434,163 @@
 	}
 }
 
+#pragma mark - Prefetched item list interface
+- (void)addPrefetchedItemLists:(NSDictionary<OCLocationString, NSArray<OCItem *> *> *)itemListsByLocationString retrievalID:(NSString *)retrievalID lifetime:(NSTimeInterval)lifetime completionHandler:(OCDatabaseCompletionHandler)completionHandler
+{
+	NSMutableArray<OCSQLiteQuery *> *queries = [NSMutableArray new];
+	NSNumber *expiry = @(NSDate.timeIntervalSinceReferenceDate + lifetime);
+
+	[itemListsByLocationString enumerateKeysAndObjectsUsingBlock:^(OCLocationString locationString, NSArray<OCItem *> *items, BOOL * _Nonnull stop) {
+		NSMutableArray<NSData *> *serializedItems = [NSMutableArray arrayWithCapacity:items.count];
+		NSData *listData;
+
+		if (items.count == 0)
+		{
+			// Empty list: discard the list stored for the location (if any)
+			[queries addObject:[OCSQLiteQuery queryDeletingRowsWhere:@{
+				@"location" : locationString
+			} fromTable:OCDatabaseTableNamePrefetchedItemLists completionHandler:nil]];
+			return;
+		}
+
+		for (OCItem *item in items)
+		{
+			NSData *itemData;
+
+			if ((itemData = [item serializedData]) != nil)
+			{
+				[serializedItems addObject:itemData];
+			}
+		}
+
+		if ((listData = [NSKeyedArchiver archivedDataWithRootObject:serializedItems requiringSecureCoding:YES error:NULL]) != nil)
+		{
+			[queries addObject:[OCSQLiteQuery queryInsertingOrReplacingIntoTable:OCDatabaseTableNamePrefetchedItemLists rowValues:@{
+				@"location"	: locationString,
+				@"retrievalID"	: retrievalID,
+				@"expiry"	: expiry,
+				@"listData"	: listData
+			} resultHandler:nil]];
+		}
+	}];
+
+	if (queries.count == 0)
+	{
+		completionHandler(self, nil);
+		return;
+	}
+
+	[self.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithQueries:queries type:OCSQLiteTransactionTypeDeferred completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+		completionHandler(self, error);
+	}]];
+}
+
+- (NSArray<OCItem *> *)consumePrefetchedItemListForLocationString:(OCLocationString)locationString lifetime:(NSTimeInterval)lifetime remainingCount:(NSUInteger *)outRemainingCount
+{
+	__block NSMutableArray<OCItem *> *items = nil;
+	__block NSUInteger remainingCount = 0;
+
+	if (locationString == nil)
+	{
+		return (nil);
+	}
+
+	OCSyncExec(prefetchedItemListRetrieval, {
+		[self.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError * _Nullable(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction) {
+			NSTimeInterval now = NSDate.timeIntervalSinceReferenceDate;
+			__block NSError *transactionError = nil;
+			__block NSNumber *listID = nil;
+
+			// Remove expired lists - the server-side contents may have changed since
+			[db executeQuery:[OCSQLiteQuery query:@"DELETE FROM prefetchedItemLists WHERE expiry < ?" withParameters:@[ @(now) ] resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+				transactionError = error;
+			}]];
+			if (transactionError != nil) { return (transactionError); }
+
+			// Retrieve list for location
+			[db executeQuery:[OCSQLiteQuery querySelectingColumns:@[ @"listID", @"listData" ] fromTable:OCDatabaseTableNamePrefetchedItemLists where:@{
+				@"location" : locationString
+			} resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+				OCSQLiteRowDictionary rowDictionary;
+
+				if ((transactionError = error) != nil) { return; }
+
+				if ((rowDictionary = [resultSet nextRowDictionaryWithError:&transactionError]) != nil)
+				{
+					NSArray<NSData *> *serializedItems;
+
+					listID = (NSNumber *)rowDictionary[@"listID"];
+
+					if ((serializedItems = [NSKeyedUnarchiver unarchivedObjectOfClasses:[NSSet setWithObjects:NSArray.class, NSData.class, nil] fromData:(NSData *)rowDictionary[@"listData"] error:NULL]) != nil)
+					{
+						items = [NSMutableArray arrayWithCapacity:serializedItems.count];
+
+						for (NSData *itemData in serializedItems)
+						{
+							OCItem *item;
+
+							if ((item = [OCItem itemFromSerializedData:itemData]) != nil)
+							{
+								[items addObject:item];
+							}
+						}
+					}
+				}
+			}]];
+			if (transactionError != nil) { return (transactionError); }
+
+			if (listID != nil)
+			{
+				// Remove list and keep the remaining lists around while they are being used
+				[db executeQuery:[OCSQLiteQuery queryDeletingRowWithID:listID fromTable:OCDatabaseTableNamePrefetchedItemLists completionHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error) {
+					transactionError = error;
+				}]];
+				if (transactionError != nil) { return (transactionError); }
+
+				[db executeQuery:[OCSQLiteQuery query:@"UPDATE prefetchedItemLists SET expiry = ?" withParameters:@[ @(now + lifetime) ] resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+					transactionError = error;
+				}]];
+				if (transactionError != nil) { return (transactionError); }
+			}
+
+			// Count remaining lists
+			[db executeQuery:[OCSQLiteQuery query:@"SELECT COUNT(*) AS remainingCount FROM prefetchedItemLists" resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+				if ((transactionError = error) == nil)
+				{
+					remainingCount = ((NSNumber *)[resultSet nextRowDictionaryWithError:&transactionError][@"remainingCount"]).unsignedIntegerValue;
+				}
+			}]];
+
+			return (transactionError);
+		} type:OCSQLiteTransactionTypeImmediate completionHandler:^(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction, NSError * _Nullable error) {
+			if (error != nil)
+			{
+				OCLogError(@"Error consuming prefetched item list for %@: %@", locationString, error);
+				items = nil;
+			}
+
+			OCSyncExecDone(prefetchedItemListRetrieval);
+		}]];
+	});
+
+	if (outRemainingCount != NULL)
+	{
+		*outRemainingCount = remainingCount;
+	}
+
+	return (items);
+}
+
+- (void)removePrefetchedItemListsForRetrievalID:(NSString *)retrievalID completionHandler:(OCDatabaseCompletionHandler)completionHandler
+{
+	[self.sqlDB executeQuery:[OCSQLiteQuery queryDeletingRowsWhere:((retrievalID != nil) ? @{ @"retrievalID" : retrievalID } : @{}) fromTable:OCDatabaseTableNamePrefetchedItemLists completionHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error) {
+		if (completionHandler != nil)
+		{
+			completionHandler(self, error);
+		}
+	}]];
+}
+
 #pragma mark - Sync Lane interface
 - (void)addSyncLane:(OCSyncLane *)lane completionHandler:(OCDatabaseCompletionHandler)completionHandler
 {
@@ -1194,68 +1736,151 @@
 	return (returnLane);
 }
 
-- (void)_laneForTags:(NSSet <OCSyncLaneTag> *)tags updatedLanes:(BOOL *)outUpdatedLanes readOnly:(BOOL)readOnly completionHandler:(void(^)(OCSyncLane *lane, BOOL updatedLanes))completionHandler
+- (NSArray *)lanesForTagSets:(NSArray<NSSet <OCSyncLaneTag> *> *)tagSets updatedLanes:(BOOL *)outUpdatedLanes
 {
-	if (tags.count == 0)
+	__block NSArray *returnLanes = nil;
+	__block BOOL updatedLanes = NO;
+
+	if (tagSets.count == 0)
 	{
-		completionHandler(nil, NO);
+		return (@[]);
 	}
 
-	[self retrieveSyncLanesWithCompletionHandler:^(OCDatabase *db, NSError *error, NSArray<OCSyncLane *> *syncLanes) {
-		NSMutableSet <OCSyncLaneID> *afterLaneIDs = nil;
-		__block OCSyncLane *returnLane = nil;
-		__block BOOL updatedLanes = NO;
-
-		for (OCSyncLane *lane in syncLanes)
-		{
-			NSUInteger prefixMatches=0, identicalTags=0;
+	OCSyncExec(waitForDatabase, {
+		[self retrieveSyncLanesWithCompletionHandler:^(OCDatabase *db, NSError *error, NSArray<OCSyncLane *> *syncLanes) {
+			NSMutableArray<OCSyncLane *> *lanes = (syncLanes != nil) ? [syncLanes mutableCopy] : [NSMutableArray new];
+			NSMutableArray *lanesForTagSets = [[NSMutableArray alloc] initWithCapacity:tagSets.count];
+			NSMutableDictionary<NSString *, OCSyncLane *> *lanesByTagSetKey = [NSMutableDictionary new]; // (NSSet's -hash is its count, so use a string key instead)
 
-			if ([lane coversTags:tags prefixMatches:&prefixMatches identicalTags:&identicalTags])
+			for (NSSet<OCSyncLaneTag> *tags in tagSets)
 			{
-				if (identicalTags == tags.count)
+				OCSyncLane *lane;
+				NSString *tagSetKey;
+
+				if (tags.count == 0)
 				{
-					// Tags are identical => use existing lane
-					returnLane = lane;
+					// Records without tags are not assigned to a lane
+					[lanesForTagSets addObject:NSNull.null];
+					continue;
 				}
-				else
+
+				tagSetKey = [[tags.allObjects sortedArrayUsingSelector:@selector(compare:)] componentsJoinedByString:@"\n"];
+
+				if ((lane = lanesByTagSetKey[tagSetKey]) == nil)
 				{
-					// Tags overlap with lane => create new, dependant lane => add afterLaneIDs
-					if (!readOnly)
+					BOOL createdLane = NO;
+
+					if ((lane = [db _laneForTags:tags inLanes:lanes readOnly:NO createdLane:&createdLane]) != nil)
 					{
-						if (afterLaneIDs == nil) { afterLaneIDs = [NSMutableSet new]; }
+						lanesByTagSetKey[tagSetKey] = lane;
+					}
 
-						[afterLaneIDs addObject:lane.identifier];
+					if (createdLane)
+					{
+						updatedLanes = YES;
 					}
 				}
+
+				[lanesForTagSets addObject:((lane != nil) ? (id)lane : (id)NSNull.null)];
 			}
-		}
 
-		// Create new lane if no matching one was found
-		if ((returnLane == nil) && (!readOnly))
-		{
-			OCSyncLane *lane;
+			returnLanes = lanesForTagSets;
+
+			OCSyncExecDone(waitForDatabase);
+		}];
+	});
+
+	if (outUpdatedLanes != NULL)
+	{
+		*outUpdatedLanes = updatedLanes;
+	}
+
+	return (returnLanes);
+}
+
+- (void)_laneForTags:(NSSet <OCSyncLaneTag> *)tags updatedLanes:(BOOL *)outUpdatedLanes readOnly:(BOOL)readOnly completionHandler:(void(^)(OCSyncLane *lane, BOOL updatedLanes))completionHandler
+{
+	if (tags.count == 0)
+	{
+		completionHandler(nil, NO);
+	}
+
+	[self retrieveSyncLanesWithCompletionHandler:^(OCDatabase *db, NSError *error, NSArray<OCSyncLane *> *syncLanes) {
+		BOOL updatedLanes = NO;
+		OCSyncLane *returnLane;
+
+		returnLane = [db _laneForTags:tags inLanes:syncLanes readOnly:readOnly createdLane:&updatedLanes];
+
+		completionHandler(returnLane, updatedLanes);
+	}];
+}
+
+- (OCSyncLane *)_laneForTags:(NSSet <OCSyncLaneTag> *)tags inLanes:(NSArray<OCSyncLane *> *)syncLanes readOnly:(BOOL)readOnly createdLane:(BOOL *)outCreatedLane
+{
+	NSMutableSet <OCSyncLaneID> *afterLaneIDs = nil;
+	__block OCSyncLane *returnLane = nil;
+	__block BOOL createdLane = NO;
+
+	for (OCSyncLane *lane in syncLanes)
+	{
+		NSUInteger prefixMatches=0, identicalTags=0;
 
-			if ((lane = [OCSyncLane new]) != nil)
+		if ([lane coversTags:tags prefixMatches:&prefixMatches identicalTags:&identicalTags])
+		{
+			if (identicalTags == tags.count)
+			{
+				// Tags are identical => use existing lane
+				returnLane = lane;
+			}
+			else
 			{
-				[lane extendWithTags:tags];
-				lane.afterLanes = afterLaneIDs;
+				// Tags overlap with lane => create new, dependant lane => add afterLaneIDs
+				if (!readOnly)
+				{
+					if (afterLaneIDs == nil) { afterLaneIDs = [NSMutableSet new]; }
 
-				[db addSyncLane:lane completionHandler:^(OCDatabase *db, NSError *error) {
-					if (error != nil)
-					{
-						OCLogError(@"Error adding lane=%@: %@", lane, error);
-					}
-					else
-					{
-						returnLane = lane;
-						updatedLanes = YES;
-					}
-				}];
+					[afterLaneIDs addObject:lane.identifier];
+				}
 			}
 		}
+	}
 
-		completionHandler(returnLane, updatedLanes);
-	}];
+	// Create new lane if no matching one was found
+	if ((returnLane == nil) && (!readOnly))
+	{
+		OCSyncLane *lane;
+
+		if ((lane = [OCSyncLane new]) != nil)
+		{
+			[lane extendWithTags:tags];
+			lane.afterLanes = afterLaneIDs;
+
+			[self addSyncLane:lane completionHandler:^(OCDatabase *db, NSError *error) {
+				if (error != nil)
+				{
+					OCLogError(@"Error adding lane=%@: %@", lane, error);
+				}
+				else
+				{
+					returnLane = lane;
+					createdLane = YES;
+				}
+			}];
+		}
+	}
+
+	if (createdLane && [syncLanes isKindOfClass:NSMutableArray.class])
+	{
+		// Make new lane known to subsequent lookups using the same lanes array
+		[(NSMutableArray<OCSyncLane *> *)syncLanes addObject:returnLane];
+	}
+
+	if (outCreatedLane != NULL)
+	{
+		*outCreatedLane = createdLane;
+	}
+
+	return (returnLane);
 }
 
 #pragma mark - Sync Journal interface
@@ -2159,3 +2784,6 @@
 }
 
 @end
+
+NSNotificationName OCDatabaseCacheItemsChanged = @"OCDatabaseCacheItemsChanged";
+NSString *OCDatabaseCacheItemsChangedLocalIDsKey = @"localIDs";
@@ -108,6 +108,7 @@ typedef void(^OCSQLiteDBBusyStatusHandler)(NSProgress * _Nullable progress); //!
 
 @property(assign) BOOL allowMigrations;
 @property(copy,nullable) OCSQLiteDBBusyStatusHandler busyStatusHandler;
+@property(copy,nullable) OCSQLiteDBCompletionHandler onlineMigrationsCompletionHandler; //!< Called after the online migrations started by -applyTableSchemasWithCompletionHandler: have completed or stopped with an error
 
 #if OCSQLITE_RAWLOG_ENABLED
 @property(assign) BOOL logStatements;
@@ -151,6 +152,10 @@ typedef void(^OCSQLiteDBBusyStatusHandler)(NSProgress * _Nullable progress); //!
 - (void)registerCollation:(OCSQLiteCollation *)collation;
 - (nullable OCSQLiteCollation *)collationForName:(OCSQLiteCollationName)name;
 
+#pragma mark - Deferred indexes
+- (void)deferIndexesOfTable:(NSString *)tableName completionHandler:(nullable OCSQLiteDBCompletionHandler)completionHandler; //!< Drops the non-unique indexes of a table to speed up bulk inserts. Their definitions are kept in the database, so that -restoreDeferredIndexesWithCompletionHandler: can recreate them - even if the process was terminated in between.
+- (void)restoreDeferredIndexesWithCompletionHandler:(nullable OCSQLiteDBCompletionHandler)completionHandler; //!< Recreates all indexes dropped by -deferIndexesOfTable:completionHandler: that haven't been re-created in the meantime.
+
 #pragma mark - Miscellaneous
 - (void)shrinkMemory; //!< Tells SQLite to release as much memory as it can.
 - (void)flushCache; //!< Tells SQLite to flush its in-memory cache to disk.
@@ -502,7 +502,10 @@ static void collationProvider(void *dbObj, sqlite3 *db, int eTextRep, const char
 							}
 						}
 
-						if ((migration.applicableSchemas.count > 0) && 		// Schemas need to be applied
+						// Online migrations run in the background and don't hold up opening the database
+						NSUInteger blockingSchemaCount = [migration.applicableSchemas filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"onlineMigration == nil"]].count;
+
+						if ((blockingSchemaCount > 0) && 			// Schemas need to be applied
 						    (migration.versionsByTableName.count > 0) &&	// The database has been initialized before (otherwise that table is empty)
 						    !db.allowMigrations)				// DB migrations are not allowed
 						{
@@ -512,7 +515,9 @@ static void collationProvider(void *dbObj, sqlite3 *db, int eTextRep, const char
 						else
 						{
 							// Apply schemas (if any)
-							if (db.busyStatusHandler != nil)
+							BOOL reportBusyStatus = (db.busyStatusHandler != nil) && (blockingSchemaCount > 0);
+
+							if (reportBusyStatus)
 							{
 								migration.progress = NSProgress.indeterminateProgress;
 								migration.progress.cancellable = NO;
@@ -522,12 +527,25 @@ static void collationProvider(void *dbObj, sqlite3 *db, int eTextRep, const char
 							}
 
 							[migration applySchemasToDatabase:self completionHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error) {
-								if (db.busyStatusHandler != nil)
+								if (reportBusyStatus)
 								{
 									db.busyStatusHandler(nil);
 								}
 
 								completionHandler(db, error);
+
+								if ((error == nil) && (migration.onlineMigrationSchemas.count > 0))
+								{
+									// Continue online migrations in the background
+									[migration runOnlineMigrationsInDatabase:db completionHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error) {
+										OCSQLiteDBCompletionHandler onlineMigrationsCompletionHandler;
+
+										if ((onlineMigrationsCompletionHandler = db.onlineMigrationsCompletionHandler) != nil)
+										{
+											onlineMigrationsCompletionHandler(db, error);
+										}
+									}];
+								}
 							}];
 						}
 					}
@@ -1216,6 +1234,125 @@ static void collationProvider(void *dbObj, sqlite3 *db, int eTextRep, const char
 	return (collation);
 }
 
+#pragma mark - Deferred indexes
+- (void)deferIndexesOfTable:(NSString *)tableName completionHandler:(OCSQLiteDBCompletionHandler)completionHandler
+{
+	[self executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError * _Nullable(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction) {
+		__block NSError *error = nil;
+		NSMutableArray<OCSQLiteRowDictionary> *indexes = [NSMutableArray new];
+
+		[db executeQuery:[OCSQLiteQuery query:@"CREATE TABLE IF NOT EXISTS deferredIndexes (name TEXT PRIMARY KEY, sql TEXT NOT NULL)" resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable queryError, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+			error = queryError;
+		}]];
+
+		if (error == nil)
+		{
+			// Unique indexes enforce constraints and are kept
+			[db executeQuery:[OCSQLiteQuery query:@"SELECT name, sql FROM sqlite_master WHERE type='index' AND tbl_name=? AND sql IS NOT NULL AND sql NOT LIKE 'CREATE UNIQUE %'" withParameters:@[ tableName ] resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable queryError, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+				if ((error = queryError) == nil)
+				{
+					[resultSet iterateUsing:^(OCSQLiteResultSet * _Nonnull resultSet, NSUInteger line, OCSQLiteRowDictionary  _Nonnull rowDictionary, BOOL * _Nonnull stop) {
+						[indexes addObject:rowDictionary];
+					} error:&error];
+				}
+			}]];
+		}
+
+		for (OCSQLiteRowDictionary index in indexes)
+		{
+			if (error != nil) { break; }
+
+			[db executeQuery:[OCSQLiteQuery query:@"INSERT OR REPLACE INTO deferredIndexes (name, sql) VALUES (?, ?)" withParameters:@[ index[@"name"], index[@"sql"] ] resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable queryError, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+				error = queryError;
+			}]];
+
+			if (error == nil)
+			{
+				[db executeQuery:[OCSQLiteQuery query:[NSString stringWithFormat:@"DROP INDEX \"%@\"", index[@"name"]] resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable queryError, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+					error = queryError;
+				}]];
+			}
+		}
+
+		if (error != nil)
+		{
+			transaction.commit = NO;
+		}
+		else
+		{
+			OCLogDebug(@"Deferred %lu indexes of %@", (unsigned long)indexes.count, tableName);
+		}
+
+		return (error);
+	} type:OCSQLiteTransactionTypeImmediate completionHandler:^(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction, NSError * _Nullable error) {
+		if (completionHandler != nil)
+		{
+			completionHandler(db, error);
+		}
+	}]];
+}
+
+- (void)restoreDeferredIndexesWithCompletionHandler:(OCSQLiteDBCompletionHandler)completionHandler
+{
+	[self executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError * _Nullable(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction) {
+		__block NSError *error = nil;
+		__block BOOL hasDeferredIndexes = NO;
+		NSMutableArray<NSString *> *indexCreationQueries = [NSMutableArray new];
+
+		[db executeQuery:[OCSQLiteQuery query:@"SELECT COUNT(*) AS tableCount FROM sqlite_master WHERE type='table' AND name='deferredIndexes'" resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable queryError, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+			if ((error = queryError) == nil)
+			{
+				hasDeferredIndexes = ([((NSNumber *)[resultSet nextRowDictionaryWithError:&error][@"tableCount"]) integerValue] > 0);
+			}
+		}]];
+
+		if ((error == nil) && hasDeferredIndexes)
+		{
+			// Skip indexes that were re-created in the meantime (f.ex. by a schema's CREATE INDEX IF NOT EXISTS open statement)
+			[db executeQuery:[OCSQLiteQuery query:@"SELECT sql FROM deferredIndexes WHERE name NOT IN (SELECT name FROM sqlite_master WHERE type='index')" resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable queryError, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+				if ((error = queryError) == nil)
+				{
+					[resultSet iterateUsing:^(OCSQLiteResultSet * _Nonnull resultSet, NSUInteger line, OCSQLiteRowDictionary  _Nonnull rowDictionary, BOOL * _Nonnull stop) {
+						[indexCreationQueries addObject:(NSString *)rowDictionary[@"sql"]];
+					} error:&error];
+				}
+			}]];
+
+			for (NSString *indexCreationQuery in indexCreationQueries)
+			{
+				if (error != nil) { break; }
+
+				[db executeQuery:[OCSQLiteQuery query:indexCreationQuery resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable queryError, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+					error = queryError;
+				}]];
+			}
+
+			if (error == nil)
+			{
+				[db executeQuery:[OCSQLiteQuery query:@"DROP TABLE deferredIndexes" resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable queryError, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+					error = queryError;
+				}]];
+			}
+		}
+
+		if (error != nil)
+		{
+			transaction.commit = NO;
+		}
+		else if (indexCreationQueries.count > 0)
+		{
+			OCLogDebug(@"Restored %lu deferred indexes", (unsigned long)indexCreationQueries.count);
+		}
+
+		return (error);
+	} type:OCSQLiteTransactionTypeImmediate completionHandler:^(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction, NSError * _Nullable error) {
+		if (completionHandler != nil)
+		{
+			completionHandler(db, error);
+		}
+	}]];
+}
+
 #pragma mark - Miscellaneous
 - (void)shrinkMemory
 {
@@ -28,16 +28,20 @@ NS_ASSUME_NONNULL_BEGIN
 @interface OCSQLiteMigration : NSObject <OCLogTagging>
 {
 	NSUInteger _appliedSchemas;
+
+	NSMutableSet<NSString *> *_deferredTableNames;
 }
 
 @property(strong) NSMutableDictionary<NSString *,NSNumber *> *versionsByTableName;
 
 @property(strong) NSMutableArray<OCSQLiteTableSchema *> *applicableSchemas;
+@property(strong) NSMutableArray<OCSQLiteTableSchema *> *onlineMigrationSchemas; //!< Schemas whose online migration was started or resumed by -applySchemasToDatabase:completionHandler:
 
 @property(nullable,strong) NSProgress *progress;
 @property(nullable,strong) NSError *error;
 
 - (void)applySchemasToDatabase:(OCSQLiteDB *)database completionHandler:(nullable OCSQLiteDBCompletionHandler)completionHandler;
+- (void)runOnlineMigrationsInDatabase:(OCSQLiteDB *)database completionHandler:(nullable OCSQLiteDBCompletionHandler)completionHandler; //!< Runs the online migrations in onlineMigrationSchemas batch by batch, until all are completed or an error occurs
 
 @end
 
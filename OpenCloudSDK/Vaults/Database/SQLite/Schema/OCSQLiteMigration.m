@@ -18,6 +18,7 @@
 
 #import "OCSQLiteMigration.h"
 #import "OCSQLiteTableSchema.h"
+#import "OCSQLiteOnlineMigration.h"
 #import "OCLogger.h"
 
 @implementation OCSQLiteMigration
@@ -29,6 +30,8 @@
 	{
 		_applicableSchemas = [NSMutableArray new];
 		_versionsByTableName = [NSMutableDictionary new];
+		_onlineMigrationSchemas = [NSMutableArray new];
+		_deferredTableNames = [NSMutableSet new];
 	}
 
 	return(self);
@@ -95,7 +98,50 @@
 			}
 		};
 
-		if (_versionsByTableName[applySchema.tableName] != nil)
+		if ([_deferredTableNames containsObject:applySchema.tableName])
+		{
+			// Table is migrated online - later versions are applied on a subsequent open, after the online migration has completed
+			OCLog(@"Deferring migration of '%@' to version %lu until online migration has completed", applySchema.tableName, (unsigned long)applySchema.version);
+
+			_appliedSchemas++;
+			[self applySchemasToDatabase:db completionHandler:completionHandler];
+		}
+		else if ((_versionsByTableName[applySchema.tableName] != nil) && (applySchema.onlineMigration != nil))
+		{
+			// Start or resume online migration - the table keeps its current version until the migration has completed
+			[_deferredTableNames addObject:applySchema.tableName];
+
+			if (db.allowMigrations)
+			{
+				[db executeOperation:^NSError *(OCSQLiteDB *db) {
+					return ([applySchema.onlineMigration prepareForSchema:applySchema inDatabase:db]);
+				} completionHandler:^(OCSQLiteDB *db, NSError *error) {
+					if (error == nil)
+					{
+						[self.onlineMigrationSchemas addObject:applySchema];
+
+						self->_appliedSchemas++;
+						[self applySchemasToDatabase:db completionHandler:completionHandler];
+					}
+					else
+					{
+						OCLogError(@"Error preparing online migration of '%@' to version %lu: %@", applySchema.tableName, (unsigned long)applySchema.version, error);
+
+						if (completionHandler != nil)
+						{
+							completionHandler(db, error);
+						}
+					}
+				}];
+			}
+			else
+			{
+				// Keep using the current version and leave the migration to a process that allows it
+				_appliedSchemas++;
+				[self applySchemasToDatabase:db completionHandler:completionHandler];
+			}
+		}
+		else if (_versionsByTableName[applySchema.tableName] != nil)
 		{
 			// Migrate to new version
 			OCLog(@"Migrating '%@' to version %lu", applySchema.tableName, (unsigned long)applySchema.version);
@@ -144,6 +190,51 @@
 	}
 }
 
+- (void)runOnlineMigrationsInDatabase:(OCSQLiteDB *)db completionHandler:(OCSQLiteDBCompletionHandler)completionHandler
+{
+	OCSQLiteTableSchema *migrateSchema;
+
+	if ((migrateSchema = _onlineMigrationSchemas.firstObject) == nil)
+	{
+		// All online migrations completed
+		if (completionHandler != nil)
+		{
+			completionHandler(db, nil);
+		}
+
+		return;
+	}
+
+	// Run one batch per operation, so that other queries can be executed between batches
+	__block BOOL completed = NO;
+
+	[db executeOperation:^NSError *(OCSQLiteDB *db) {
+		return ([migrateSchema.onlineMigration performBatchForSchema:migrateSchema inDatabase:db completed:&completed]);
+	} completionHandler:^(OCSQLiteDB *db, NSError *error) {
+		if (error != nil)
+		{
+			// Stop here - the migration resumes from its last committed batch on the next open
+			OCLogError(@"Online migration of '%@' to version %lu interrupted by error: %@", migrateSchema.tableName, (unsigned long)migrateSchema.version, error);
+
+			if (completionHandler != nil)
+			{
+				completionHandler(db, error);
+			}
+
+			return;
+		}
+
+		if (completed)
+		{
+			OCLog(@"Completed online migration of '%@' to version %lu", migrateSchema.tableName, (unsigned long)migrateSchema.version);
+
+			[self.onlineMigrationSchemas removeObjectAtIndex:0];
+		}
+
+		[self runOnlineMigrationsInDatabase:db completionHandler:completionHandler];
+	}];
+}
+
 + (nonnull NSArray<OCLogTagName> *)logTags {
 	return (@[ @"SQL", @"Migration" ]);
 }
@@ -0,0 +1,70 @@
+//
+//  OCSQLiteOnlineMigration.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCSQLiteDB.h"
+
+@class OCSQLiteTableSchema;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NSError * _Nullable (^OCSQLiteOnlineMigrationBatchHandler)(OCSQLiteDB *db, NSNumber *highWaterMark); //!< Called after a batch has been committed, with the high-water mark after the batch. Returning an error stops the migration, which then resumes from the committed state on the next open.
+typedef NSDictionary<NSString *, id<NSObject>> * _Nullable (^OCSQLiteOnlineMigrationRowTransformer)(OCSQLiteDB *db, NSDictionary<NSString *, id<NSObject>> *rowValues, NSError * _Nullable * _Nullable outError); //!< Transforms the values of a row (keyed by target column name) before they're inserted into the target table. Return nil and set outError to abort the batch.
+
+/*
+	Online migrations copy the rows of a table into a new table in small, individually committed batches,
+	while the database remains open and the old table keeps serving reads and writes:
+
+	- on the first open after the upgrade, the target table is created and a state row with a high-water mark
+	  (the highest key already copied) is added to the "onlineMigrations" table, all in one transaction
+	- triggers on the source table record changes to rows below the high-water mark in "onlineMigrationDirtyRows"
+	- batches copy the next rows above the high-water mark and advance it in the same transaction, so that work
+	  resumes where it left off if the process is killed
+	- once all rows are copied, a final transaction catches up with remaining and changed rows, replaces the
+	  source table with the target table and bumps the schema version
+
+	Since the source table is used until cut-over, online migrations are only suitable for schema versions whose
+	preceding table layout remains fully usable by the current code (f.ex. re-encoding values, changing collations
+	or adding columns that are only read once available).
+*/
+
+@interface OCSQLiteOnlineMigration : NSObject
+
+@property(strong) NSString *targetTableName; //!< Name of the table the rows are copied to. Renamed to the schema's table name on cut-over.
+@property(strong) NSString *keyColumn; //!< Name of an INTEGER column that uniquely identifies a row and is assigned in ascending order (typically the INTEGER PRIMARY KEY)
+
+@property(strong) NSArray<NSString *> *targetCreationQueries; //!< Queries creating the target table. Run once, when the migration is started.
+@property(strong) NSArray<NSString *> *targetColumns; //!< Columns of the target table to fill
+@property(strong) NSArray<NSString *> *sourceColumnExpressions; //!< SQL expressions computing the values for targetColumns (in the same order) from a row of the source table
+@property(nullable,copy) OCSQLiteOnlineMigrationRowTransformer rowTransformer; //!< Optional block transforming the values computed by sourceColumnExpressions before insertion (f.ex. to re-encode archived data). If nil, rows are copied with a single INSERT … SELECT per batch.
+
+@property(nullable,strong) NSArray<NSString *> *cutOverQueries; //!< Queries to run after the target table replaced the source table (f.ex. to create indexes)
+
+@property(assign) NSUInteger batchSize; //!< Number of rows copied per transaction (defaults to 500)
+@property(nullable,copy) OCSQLiteOnlineMigrationBatchHandler batchHandler; //!< Optional block called after every committed batch that didn't complete the migration, from within the same database operation (f.ex. to modify rows between batches or interrupt the migration in tests).
+
++ (instancetype)migrationToTable:(NSString *)targetTableName keyColumn:(NSString *)keyColumn creationQueries:(NSArray<NSString *> *)targetCreationQueries columns:(NSArray<NSString *> *)targetColumns fromExpressions:(NSArray<NSString *> *)sourceColumnExpressions cutOverQueries:(nullable NSArray<NSString *> *)cutOverQueries;
+
+#pragma mark - Execution
+// All methods must be called from within -[OCSQLiteDB executeOperation:completionHandler:]
+- (nullable NSError *)prepareForSchema:(OCSQLiteTableSchema *)schema inDatabase:(OCSQLiteDB *)db; //!< Starts the migration - or resumes it if it has been started before.
+- (nullable NSError *)performBatchForSchema:(OCSQLiteTableSchema *)schema inDatabase:(OCSQLiteDB *)db completed:(BOOL *)outCompleted; //!< Copies the next batch of rows. Performs the cut-over once all rows have been copied and sets outCompleted to YES when done.
+
+@end
+
+NS_ASSUME_NONNULL_END
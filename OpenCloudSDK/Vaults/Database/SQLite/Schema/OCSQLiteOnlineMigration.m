@@ -0,0 +1,347 @@
+//
+//  OCSQLiteOnlineMigration.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCSQLiteOnlineMigration.h"
+#import "OCSQLiteTableSchema.h"
+#import "OCSQLiteTransaction.h"
+#import "OCSQLiteQuery.h"
+#import "OCLogger.h"
+
+@implementation OCSQLiteOnlineMigration
+
++ (instancetype)migrationToTable:(NSString *)targetTableName keyColumn:(NSString *)keyColumn creationQueries:(NSArray<NSString *> *)targetCreationQueries columns:(NSArray<NSString *> *)targetColumns fromExpressions:(NSArray<NSString *> *)sourceColumnExpressions cutOverQueries:(NSArray<NSString *> *)cutOverQueries
+{
+	OCSQLiteOnlineMigration *migration = [self new];
+
+	migration.targetTableName = targetTableName;
+	migration.keyColumn = keyColumn;
+	migration.targetCreationQueries = targetCreationQueries;
+	migration.targetColumns = targetColumns;
+	migration.sourceColumnExpressions = sourceColumnExpressions;
+	migration.cutOverQueries = cutOverQueries;
+
+	return (migration);
+}
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_batchSize = 500;
+	}
+
+	return (self);
+}
+
+#pragma mark - Tools
+- (NSString *)_identifierForSchema:(OCSQLiteTableSchema *)schema
+{
+	return ([NSString stringWithFormat:@"%@.%lu", schema.tableName, (unsigned long)schema.version]);
+}
+
+- (NSString *)_triggerNameForSchema:(OCSQLiteTableSchema *)schema event:(NSString *)event
+{
+	return ([NSString stringWithFormat:@"onlineMigration_%@_%lu_%@", schema.tableName, (unsigned long)schema.version, event]);
+}
+
+- (nullable NSError *)_executeQuery:(NSString *)sqlQuery withParameters:(nullable NSArray<id<NSObject>> *)parameters inDatabase:(OCSQLiteDB *)db
+{
+	__block NSError *queryError = nil;
+
+	[db executeQuery:[OCSQLiteQuery query:sqlQuery withParameters:parameters resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+		queryError = error;
+	}]];
+
+	return (queryError);
+}
+
+- (nullable NSNumber *)_valueOfQuery:(NSString *)sqlQuery withParameters:(nullable NSArray<id<NSObject>> *)parameters inDatabase:(OCSQLiteDB *)db error:(NSError **)outError
+{
+	__block NSNumber *value = nil;
+	__block NSError *queryError = nil;
+
+	[db executeQuery:[OCSQLiteQuery query:sqlQuery withParameters:parameters resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+		queryError = error;
+
+		if (error == nil)
+		{
+			id rowValue = [resultSet nextRowDictionaryWithError:&queryError][@"value"];
+
+			if ([rowValue isKindOfClass:NSNumber.class])
+			{
+				value = rowValue;
+			}
+		}
+	}]];
+
+	if (outError != NULL)
+	{
+		*outError = queryError;
+	}
+
+	return (value);
+}
+
+- (nullable NSNumber *)_highWaterMarkForSchema:(OCSQLiteTableSchema *)schema inDatabase:(OCSQLiteDB *)db error:(NSError **)outError
+{
+	return ([self _valueOfQuery:@"SELECT highWaterMark AS value FROM onlineMigrations WHERE identifier=?" withParameters:@[ [self _identifierForSchema:schema] ] inDatabase:db error:outError]);
+}
+
+- (nullable NSError *)_copyRowsOfSchema:(OCSQLiteTableSchema *)schema where:(NSString *)whereClause parameters:(NSArray<id<NSObject>> *)parameters inDatabase:(OCSQLiteDB *)db
+{
+	if (_rowTransformer == nil)
+	{
+		// Copy in SQLite
+		return ([self _executeQuery:[NSString stringWithFormat:@"INSERT OR REPLACE INTO %@ (%@) SELECT %@ FROM %@ WHERE %@", _targetTableName, [_targetColumns componentsJoinedByString:@", "], [_sourceColumnExpressions componentsJoinedByString:@", "], schema.tableName, whereClause] withParameters:parameters inDatabase:db]);
+	}
+	else
+	{
+		// Read, transform and insert rows
+		NSMutableArray<NSString *> *selectColumns = [NSMutableArray new];
+		NSMutableArray<NSDictionary<NSString *, id<NSObject>> *> *rows = [NSMutableArray new];
+		__block NSError *copyError = nil;
+
+		[_targetColumns enumerateObjectsUsingBlock:^(NSString *targetColumn, NSUInteger idx, BOOL * _Nonnull stop) {
+			[selectColumns addObject:[NSString stringWithFormat:@"%@ AS %@", self->_sourceColumnExpressions[idx], targetColumn]];
+		}];
+
+		[db executeQuery:[OCSQLiteQuery query:[NSString stringWithFormat:@"SELECT %@ FROM %@ WHERE %@", [selectColumns componentsJoinedByString:@", "], schema.tableName, whereClause] withParameters:parameters resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+			if ((copyError = error) == nil)
+			{
+				[resultSet iterateUsing:^(OCSQLiteResultSet *resultSet, NSUInteger line, OCSQLiteRowDictionary rowDictionary, BOOL *stop) {
+					[rows addObject:rowDictionary];
+				} error:&copyError];
+			}
+		}]];
+
+		for (NSDictionary<NSString *, id<NSObject>> *row in rows)
+		{
+			NSDictionary<NSString *, id<NSObject>> *rowValues;
+
+			if (copyError != nil) { break; }
+
+			if ((rowValues = _rowTransformer(db, row, &copyError)) != nil)
+			{
+				[db executeQuery:[OCSQLiteQuery queryInsertingOrReplacingIntoTable:_targetTableName rowValues:rowValues resultHandler:^(OCSQLiteDB *db, NSError *error, NSNumber *rowID) {
+					copyError = error;
+				}]];
+			}
+			else if (copyError == nil)
+			{
+				copyError = OCSQLiteDBError(OCSQLiteDBErrorInsufficientParameters);
+			}
+		}
+
+		return (copyError);
+	}
+}
+
+#pragma mark - Transactions
+- (nullable NSError *)_startOrResumeForSchema:(OCSQLiteTableSchema *)schema inDatabase:(OCSQLiteDB *)db
+{
+	NSError *error = nil;
+	NSNumber *highWaterMark = [self _highWaterMarkForSchema:schema inDatabase:db error:&error];
+	NSString *identifier = [self _identifierForSchema:schema];
+	NSString *quotedIdentifier = [identifier stringByReplacingOccurrencesOfString:@"'" withString:@"''"];
+
+	if (error != nil) { return (error); }
+
+	if (highWaterMark == nil)
+	{
+		// Start migration: create target table and state
+		OCLog(@"Starting online migration of '%@' to version %lu", schema.tableName, (unsigned long)schema.version);
+
+		if ((error = [self _executeQuery:[NSString stringWithFormat:@"DROP TABLE IF EXISTS %@", _targetTableName] withParameters:nil inDatabase:db]) != nil) { return (error); }
+
+		for (NSString *creationQuery in _targetCreationQueries)
+		{
+			if ((error = [self _executeQuery:creationQuery withParameters:nil inDatabase:db]) != nil) { return (error); }
+		}
+
+		if ((error = [self _executeQuery:[NSString stringWithFormat:@"INSERT INTO onlineMigrations (identifier, tableName, version, highWaterMark) SELECT ?, ?, ?, COALESCE(MIN(%@), 1) - 1 FROM %@", _keyColumn, schema.tableName] withParameters:@[ identifier, schema.tableName, @(schema.version) ] inDatabase:db]) != nil) { return (error); }
+	}
+	else
+	{
+		OCLog(@"Resuming online migration of '%@' to version %lu from %@=%@", schema.tableName, (unsigned long)schema.version, _keyColumn, highWaterMark);
+	}
+
+	// Track changes to rows that have already been copied
+	for (NSString *event in @[ @"INSERT", @"UPDATE", @"DELETE" ])
+	{
+		NSString *rowReference = [event isEqual:@"INSERT"] ? @"NEW" : @"OLD";
+
+		if ((error = [self _executeQuery:[NSString stringWithFormat:@"CREATE TRIGGER IF NOT EXISTS %@ AFTER %@ ON %@ WHEN %@.%@ <= (SELECT highWaterMark FROM onlineMigrations WHERE identifier='%@') BEGIN INSERT OR IGNORE INTO onlineMigrationDirtyRows (identifier, rowID) VALUES ('%@', %@.%@); END",
+			[self _triggerNameForSchema:schema event:event.lowercaseString], event, schema.tableName,
+			rowReference, _keyColumn, quotedIdentifier,
+			quotedIdentifier, rowReference, _keyColumn] withParameters:nil inDatabase:db]) != nil)
+		{
+			return (error);
+		}
+	}
+
+	return (nil);
+}
+
+- (nullable NSError *)_copyBatchForSchema:(OCSQLiteTableSchema *)schema inDatabase:(OCSQLiteDB *)db completed:(BOOL *)outCompleted
+{
+	NSError *error = nil;
+	NSNumber *highWaterMark, *batchEnd, *dirtyRowCount;
+	NSString *dirtyRowsWhereClause;
+	NSString *identifier = [self _identifierForSchema:schema];
+	NSUInteger batchSize = (_batchSize > 0) ? _batchSize : 500;
+
+	if ((highWaterMark = [self _highWaterMarkForSchema:schema inDatabase:db error:&error]) == nil)
+	{
+		// No state (anymore) - f.ex. because another process has completed the migration
+		*outCompleted = (error == nil);
+		return (error);
+	}
+
+	// Copy the next batch of rows above the high-water mark
+	batchEnd = [self _valueOfQuery:[NSString stringWithFormat:@"SELECT MAX(%@) AS value FROM (SELECT %@ FROM %@ WHERE %@ > ? ORDER BY %@ LIMIT %lu)", _keyColumn, _keyColumn, schema.tableName, _keyColumn, _keyColumn, (unsigned long)batchSize] withParameters:@[ highWaterMark ] inDatabase:db error:&error];
+
+	if (error != nil) { return (error); }
+
+	if (batchEnd != nil)
+	{
+		if ((error = [self _copyRowsOfSchema:schema where:[NSString stringWithFormat:@"%@ > ? AND %@ <= ?", _keyColumn, _keyColumn] parameters:@[ highWaterMark, batchEnd ] inDatabase:db]) != nil) { return (error); }
+
+		return ([self _executeQuery:@"UPDATE onlineMigrations SET highWaterMark=? WHERE identifier=?" withParameters:@[ batchEnd, identifier ] inDatabase:db]);
+	}
+
+	// All rows copied - re-copy rows that changed after they had been copied
+	dirtyRowCount = [self _valueOfQuery:[NSString stringWithFormat:@"SELECT COUNT(*) AS value FROM (SELECT rowID FROM onlineMigrationDirtyRows WHERE identifier=? LIMIT %lu)", (unsigned long)(batchSize + 1)] withParameters:@[ identifier ] inDatabase:db error:&error];
+
+	if (error != nil) { return (error); }
+
+	if (dirtyRowCount.unsignedIntegerValue > batchSize)
+	{
+		// More than a batch: re-copy a batch and leave the rest to the next transaction
+		NSNumber *dirtyBatchEnd = [self _valueOfQuery:[NSString stringWithFormat:@"SELECT MAX(rowID) AS value FROM (SELECT rowID FROM onlineMigrationDirtyRows WHERE identifier=? ORDER BY rowID LIMIT %lu)", (unsigned long)batchSize] withParameters:@[ identifier ] inDatabase:db error:&error];
+
+		if (error != nil) { return (error); }
+
+		dirtyRowsWhereClause = [NSString stringWithFormat:@"%@ IN (SELECT rowID FROM onlineMigrationDirtyRows WHERE identifier=? AND rowID <= ?)", _keyColumn];
+
+		if ((error = [self _executeQuery:[NSString stringWithFormat:@"DELETE FROM %@ WHERE %@", _targetTableName, dirtyRowsWhereClause] withParameters:@[ identifier, dirtyBatchEnd ] inDatabase:db]) != nil) { return (error); }
+		if ((error = [self _copyRowsOfSchema:schema where:dirtyRowsWhereClause parameters:@[ identifier, dirtyBatchEnd ] inDatabase:db]) != nil) { return (error); }
+
+		return ([self _executeQuery:@"DELETE FROM onlineMigrationDirtyRows WHERE identifier=? AND rowID <= ?" withParameters:@[ identifier, dirtyBatchEnd ] inDatabase:db]);
+	}
+
+	// Cut-over: re-copy the remaining changed rows, then replace the source table with the target table
+	OCLog(@"Cutting over online migration of '%@' to version %lu", schema.tableName, (unsigned long)schema.version);
+
+	dirtyRowsWhereClause = [NSString stringWithFormat:@"%@ IN (SELECT rowID FROM onlineMigrationDirtyRows WHERE identifier=?)", _keyColumn];
+
+	if ((error = [self _executeQuery:[NSString stringWithFormat:@"DELETE FROM %@ WHERE %@", _targetTableName, dirtyRowsWhereClause] withParameters:@[ identifier ] inDatabase:db]) != nil) { return (error); }
+	if ((error = [self _copyRowsOfSchema:schema where:dirtyRowsWhereClause parameters:@[ identifier ] inDatabase:db]) != nil) { return (error); }
+
+	for (NSString *event in @[ @"insert", @"update", @"delete" ])
+	{
+		if ((error = [self _executeQuery:[NSString stringWithFormat:@"DROP TRIGGER IF EXISTS %@", [self _triggerNameForSchema:schema event:event]] withParameters:nil inDatabase:db]) != nil) { return (error); }
+	}
+
+	if ((error = [self _executeQuery:[NSString stringWithFormat:@"DROP TABLE %@", schema.tableName] withParameters:nil inDatabase:db]) != nil) { return (error); }
+	if ((error = [self _executeQuery:[NSString stringWithFormat:@"ALTER TABLE %@ RENAME TO %@", _targetTableName, schema.tableName] withParameters:nil inDatabase:db]) != nil) { return (error); }
+
+	for (NSString *cutOverQuery in _cutOverQueries)
+	{
+		if ((error = [self _executeQuery:cutOverQuery withParameters:nil inDatabase:db]) != nil) { return (error); }
+	}
+
+	if ((error = [self _executeQuery:@"UPDATE tableSchemas SET version=? WHERE tableName=?" withParameters:@[ @(schema.version), schema.tableName ] inDatabase:db]) != nil) { return (error); }
+	if ((error = [self _executeQuery:@"DELETE FROM onlineMigrationDirtyRows WHERE identifier=?" withParameters:@[ identifier ] inDatabase:db]) != nil) { return (error); }
+	if ((error = [self _executeQuery:@"DELETE FROM onlineMigrations WHERE identifier=?" withParameters:@[ identifier ] inDatabase:db]) != nil) { return (error); }
+
+	*outCompleted = YES;
+
+	return (nil);
+}
+
+#pragma mark - Execution
+- (nullable NSError *)prepareForSchema:(OCSQLiteTableSchema *)schema inDatabase:(OCSQLiteDB *)db
+{
+	__block NSError *prepareError = nil;
+
+	if ((prepareError = [self _executeQuery:@"CREATE TABLE IF NOT EXISTS onlineMigrations (identifier TEXT PRIMARY KEY, tableName TEXT NOT NULL, version INTEGER NOT NULL, highWaterMark INTEGER NOT NULL)" withParameters:nil inDatabase:db]) != nil)
+	{
+		return (prepareError);
+	}
+
+	if ((prepareError = [self _executeQuery:@"CREATE TABLE IF NOT EXISTS onlineMigrationDirtyRows (identifier TEXT NOT NULL, rowID INTEGER NOT NULL, PRIMARY KEY (identifier, rowID))" withParameters:nil inDatabase:db]) != nil)
+	{
+		return (prepareError);
+	}
+
+	[db executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError * _Nullable(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction) {
+		NSError *error = [self _startOrResumeForSchema:schema inDatabase:db];
+
+		if (error != nil)
+		{
+			transaction.commit = NO;
+		}
+
+		return (error);
+	} type:OCSQLiteTransactionTypeImmediate completionHandler:^(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction, NSError * _Nullable error) {
+		prepareError = error;
+	}]];
+
+	return (prepareError);
+}
+
+- (nullable NSError *)performBatchForSchema:(OCSQLiteTableSchema *)schema inDatabase:(OCSQLiteDB *)db completed:(BOOL *)outCompleted
+{
+	__block NSError *batchError = nil;
+	__block BOOL completed = NO;
+
+	[db executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError * _Nullable(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction) {
+		BOOL batchCompleted = NO;
+		NSError *error = [self _copyBatchForSchema:schema inDatabase:db completed:&batchCompleted];
+
+		if (error != nil)
+		{
+			transaction.commit = NO;
+		}
+
+		completed = batchCompleted;
+
+		return (error);
+	} type:OCSQLiteTransactionTypeImmediate completionHandler:^(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction, NSError * _Nullable error) {
+		batchError = error;
+	}]];
+
+	if ((batchError == nil) && !completed && (_batchHandler != nil))
+	{
+		NSNumber *highWaterMark;
+
+		if ((highWaterMark = [self _highWaterMarkForSchema:schema inDatabase:db error:&batchError]) != nil)
+		{
+			batchError = _batchHandler(db, highWaterMark);
+		}
+	}
+
+	if (outCompleted != NULL)
+	{
+		*outCompleted = (batchError == nil) && completed;
+	}
+
+	return (batchError);
+}
+
+@end
@@ -20,6 +20,7 @@
 
 @class OCSQLiteDB;
 @class OCSQLiteTableSchema;
+@class OCSQLiteOnlineMigration;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -36,6 +37,7 @@ typedef void(^OCSQLiteTableSchemaMigrator)(OCSQLiteDB *db, OCSQLiteTableSchema *
 
 @property(nullable,strong) NSProgress *migrationProgress; //!< Progress object that's injected during migration if progress should be reported
 @property(nullable,strong) OCSQLiteTableSchemaMigrator upgradeMigrator; //!< Migrator block used to migrate table from preceding version
+@property(nullable,strong) OCSQLiteOnlineMigration *onlineMigration; //!< Online migration used to migrate the table from the preceding version in the background, without blocking the opening of the database. If set, upgradeMigrator is not used.
 
 + (instancetype)schemaWithTableName:(NSString *)tableName version:(NSUInteger)version creationQueries:(NSArray<NSString *> *)creationQueries openStatements:(nullable NSArray<NSString *> *)openStatements upgradeMigrator:(nullable OCSQLiteTableSchemaMigrator)migrator;
 
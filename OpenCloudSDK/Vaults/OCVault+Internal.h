@@ -21,8 +21,13 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class OCVaultChangeJournal;
+
 @interface OCVault (Internal) <NSFileManagerDelegate>
 
+#pragma mark - Change journal
+@property(nullable,readonly,nonatomic) OCVaultChangeJournal *changeJournal; //!< Journal of item changes, shared with other processes using the vault (lazily allocated)
+
 #pragma mark - Compacting
 - (void)compactInContext:(nullable void(^)(void(^blockToRunInContext)(OCSyncAnchor syncAnchor, void(^updateHandler)(NSSet<OCLocalID> *updateDirectoryLocalIDs))))runInContext withSelector:(OCVaultCompactSelector)selector completionHandler:(nullable OCCompletionHandler)completionHandler; //!< Compacts the vault's contents using the selector to determine which items' files to delete. If the vault is used by an online core, make sure to pass a block for runInContext that runs the passed block inside -[OCCore performProtectedSyncBlock:..] to guarantee integrity.
 
@@ -23,9 +23,24 @@
 #import "OCLogger.h"
 #import "NSString+OCPath.h"
 #import "OCFeatureAvailability.h"
+#import "OCVaultChangeJournal.h"
 
 @implementation OCVault (Internal)
 
+#pragma mark - Change journal
+- (OCVaultChangeJournal *)changeJournal
+{
+	@synchronized(self)
+	{
+		if ((_changeJournal == nil) && (self.rootURL != nil) && [NSFileManager.defaultManager fileExistsAtPath:self.rootURL.path])
+		{
+			_changeJournal = [[OCVaultChangeJournal alloc] initWithURL:[self.rootURL URLByAppendingPathComponent:@"changes.journal"] capacity:OCVaultChangeJournalDefaultCapacity];
+		}
+	}
+
+	return (_changeJournal);
+}
+
 #pragma mark - Compacting
 - (void)compactInContext:(nullable void(^)(void(^blockToRunInContext)(OCSyncAnchor syncAnchor, void(^updateHandler)(NSSet<OCLocalID> *updateDirectoryLocalIDs))))runInContext withSelector:(OCVaultCompactSelector)selector completionHandler:(nullable OCCompletionHandler)completionHandler
 {
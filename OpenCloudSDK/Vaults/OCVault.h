@@ -32,6 +32,7 @@
 @class OCDatabase;
 @class OCItem;
 @class OCResourceManager;
+@class OCVaultChangeJournal;
 
 /*
 	# Filesystem layout						# API
@@ -43,6 +44,7 @@
 				[Bookmark UUID].tdb			  + (thumbnail part of .database)
 
 				[Bookmark UUID].ockvs			- OCVault.keyValueStoreURL
+				"changes.journal"			- OCVault.changeJournal (memory-mapped journal of item changes, shared across processes)
 
 				"BookmarkMetadata"/			- OCVault.bookmarkMetadataURL and +bookmarkMetadataURLForVaultUUID: (folder where (larger) bookmark metadata blobs are stored)
 				"Erasure"/				- OCVault.wipeContainerRootURL (folder whose contents should be erased)
@@ -125,6 +127,7 @@ typedef BOOL(^OCVaultCompactSelector)(OCSyncAnchor _Nullable syncAnchor, OCItem
 	OCVFSCore *_vfsCore;
 
 	OCDatabase *_database;
+	OCVaultChangeJournal *_changeJournal;
 }
 
 @property(class,nonatomic,readonly) BOOL hostHasFileProvider;
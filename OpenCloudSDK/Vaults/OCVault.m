@@ -314,6 +314,7 @@
 	if (_database == nil)
 	{
 		_database = [[OCDatabase alloc] initWithURL:self.databaseURL];
+		_database.bookmarkUUID = self.bookmark.uuid;
 	}
 
 	return (_database);
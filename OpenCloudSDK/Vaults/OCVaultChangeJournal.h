@@ -0,0 +1,72 @@
+//
+//  OCVaultChangeJournal.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCTypes.h"
+
+@class OCItem;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(uint8_t, OCVaultChangeKind)
+{
+	OCVaultChangeKindAdded = 1,	//!< Item was added
+	OCVaultChangeKindUpdated,	//!< Item was updated in place
+	OCVaultChangeKindRemoved,	//!< Item was removed
+	OCVaultChangeKindMoved		//!< Item was updated and moved to a different parent folder. The entry carries the previous path.
+};
+
+@interface OCVaultChangeJournalEntry : NSObject
+
+@property(readonly,strong) OCSyncAnchor syncAnchor; //!< Sync anchor the change was made with
+@property(readonly) OCVaultChangeKind kind;
+@property(readonly,strong) OCLocalID localID;
+@property(readonly,strong,nullable) OCPath previousPath; //!< Path of the item before it was moved (OCVaultChangeKindMoved only)
+
+@end
+
+/*
+	Memory-mapped, append-only journal of item changes, shared by all processes using a vault.
+
+	Processes append an entry for every item they add, update or remove, tagged with the sync anchor of the change. Other processes read only
+	the entries appended since they last looked, which tells them f.ex. where moved items came from without having to compare the new items
+	against the results of every running query.
+
+	When the journal is full, it is reset and starts over. Readers detect resets (via a generation counter) and whether the journal still
+	covers the range of changes they are interested in - if it doesn't, they need to fall back to other means.
+
+	Entries are appended after the changes were committed to the database. To detect changes that never made it into the journal (f.ex.
+	because the process was terminated in between), the journal also records the latest sync anchor it was updated for. Readers pass the
+	latest sync anchor of the database and treat the journal as incomplete if it lags behind.
+*/
+@interface OCVaultChangeJournal : NSObject
+
+@property(readonly,strong) NSURL *url;
+
+- (instancetype)init NS_UNAVAILABLE;
+- (instancetype)initWithURL:(NSURL *)url capacity:(size_t)capacity NS_DESIGNATED_INITIALIZER; //!< Opens (or creates) the journal at url. capacity is only used when creating the journal file.
+
+- (nullable NSError *)appendChangesForAddedItems:(nullable NSArray<OCItem *> *)addedItems removedItems:(nullable NSArray<OCItem *> *)removedItems updatedItems:(nullable NSArray<OCItem *> *)updatedItems syncAnchor:(OCSyncAnchor)syncAnchor; //!< Appends entries for all passed items. Must be called from within the protected block that made the changes with syncAnchor.
+
+- (nullable NSArray<OCVaultChangeJournalEntry *> *)entriesSinceSyncAnchor:(OCSyncAnchor)syncAnchor untilSyncAnchor:(OCSyncAnchor)untilSyncAnchor; //!< Returns all entries with a sync anchor newer than syncAnchor, in the order they were made - or nil if the journal doesn't (or no longer) cover all changes from syncAnchor up to (and including) untilSyncAnchor, the latest sync anchor of the database.
+
+@end
+
+extern const size_t OCVaultChangeJournalDefaultCapacity;
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,408 @@
+//
+//  OCVaultChangeJournal.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <sys/mman.h>
+#import <sys/file.h>
+#import <stdatomic.h>
+
+#import "OCVaultChangeJournal.h"
+#import "OCItem.h"
+#import "OCLogger.h"
+#import "NSError+OCError.h"
+
+#define OCVaultChangeJournalMagic	0x4A43434F /* "OCCJ" */
+#define OCVaultChangeJournalVersion	2
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t version;
+
+	_Atomic uint64_t generation;	//!< Incremented on every reset, before the record area is overwritten
+	_Atomic uint64_t length;	//!< Number of bytes of committed records following the header
+	_Atomic uint64_t baseSyncAnchor; //!< All changes with a sync anchor newer than this are contained in the journal
+	_Atomic uint64_t lastSyncAnchor; //!< ..up to and including the changes with this sync anchor
+
+	uint8_t reserved[24];
+} OCVaultChangeJournalHeader;
+
+typedef struct
+{
+	uint32_t length;		//!< Total length of the record, including this header and padding
+	uint8_t kind;			//!< OCVaultChangeKind
+	uint8_t reserved;
+	uint16_t localIDLength;
+	uint64_t syncAnchor;
+	uint32_t previousPathLength;
+	uint32_t reserved2;
+
+	// followed by localID and previousPath (UTF-8)
+} OCVaultChangeJournalRecord;
+
+#define OCVaultChangeJournalAlign(length) (((length) + 7) & ~((size_t)7))
+
+@interface OCVaultChangeJournalEntry ()
+{
+	@public
+	OCSyncAnchor _syncAnchor;
+	OCVaultChangeKind _kind;
+	OCLocalID _localID;
+	OCPath _previousPath;
+}
+@end
+
+@implementation OCVaultChangeJournalEntry
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, syncAnchor: %@, kind: %d, localID: %@%@>", NSStringFromClass(self.class), self, _syncAnchor, _kind, _localID, ((_previousPath != nil) ? [@", previousPath: " stringByAppendingString:_previousPath] : @"")]);
+}
+
+@end
+
+@interface OCVaultChangeJournal ()
+{
+	int _fd;
+
+	OCVaultChangeJournalHeader *_header;
+	uint8_t *_records;
+	size_t _mappedSize;
+	size_t _recordsCapacity;
+
+	// Read cursor: all records before _cursorOffset have a sync anchor <= _cursorSyncAnchor
+	uint64_t _cursorGeneration;
+	uint64_t _cursorOffset;
+	uint64_t _cursorSyncAnchor;
+}
+@end
+
+@implementation OCVaultChangeJournal
+
+- (instancetype)initWithURL:(NSURL *)url capacity:(size_t)capacity
+{
+	if ((self = [super init]) != nil)
+	{
+		struct stat fileStat;
+
+		_url = url;
+		_fd = -1;
+
+		if ((_fd = open(url.path.fileSystemRepresentation, O_RDWR|O_CREAT|O_CLOEXEC, S_IRUSR|S_IWUSR)) == -1)
+		{
+			OCLogError(@"Error opening change journal at %@: %@", url.path, [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil]);
+			return (nil);
+		}
+
+		// Initialize new journals
+		flock(_fd, LOCK_EX);
+
+		if ((fstat(_fd, &fileStat) == 0) && (fileStat.st_size < (off_t)sizeof(OCVaultChangeJournalHeader)))
+		{
+			if (ftruncate(_fd, (off_t)(sizeof(OCVaultChangeJournalHeader) + OCVaultChangeJournalAlign(capacity))) != 0)
+			{
+				OCLogError(@"Error sizing change journal at %@: %@", url.path, [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil]);
+			}
+		}
+
+		if (fstat(_fd, &fileStat) == 0)
+		{
+			_mappedSize = (size_t)fileStat.st_size;
+		}
+
+		if ((_mappedSize > sizeof(OCVaultChangeJournalHeader)) &&
+		    ((_header = mmap(NULL, _mappedSize, PROT_READ|PROT_WRITE, MAP_SHARED, _fd, 0)) != MAP_FAILED))
+		{
+			_records = ((uint8_t *)_header) + sizeof(OCVaultChangeJournalHeader);
+			_recordsCapacity = _mappedSize - sizeof(OCVaultChangeJournalHeader);
+
+			if ((_header->magic != OCVaultChangeJournalMagic) || (_header->version != OCVaultChangeJournalVersion))
+			{
+				// New journal or unknown format: start over. A base sync anchor of UINT64_MAX means nothing is covered until the first changes are appended.
+				_header->version = OCVaultChangeJournalVersion;
+				atomic_store(&_header->length, 0);
+				atomic_store(&_header->baseSyncAnchor, UINT64_MAX);
+				atomic_store(&_header->lastSyncAnchor, 0);
+				atomic_fetch_add(&_header->generation, 1);
+				_header->magic = OCVaultChangeJournalMagic;
+			}
+		}
+		else
+		{
+			OCLogError(@"Error mapping change journal at %@: %@", url.path, [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil]);
+			_header = NULL;
+		}
+
+		flock(_fd, LOCK_UN);
+
+		if (_header == NULL)
+		{
+			close(_fd);
+			_fd = -1;
+			return (nil);
+		}
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	if (_header != NULL)
+	{
+		munmap(_header, _mappedSize);
+		_header = NULL;
+	}
+
+	if (_fd != -1)
+	{
+		close(_fd);
+		_fd = -1;
+	}
+}
+
+#pragma mark - Writing
+static size_t OCVaultChangeJournalRecordLength(NSData *localIDData, NSData *previousPathData)
+{
+	return (OCVaultChangeJournalAlign(sizeof(OCVaultChangeJournalRecord) + localIDData.length + previousPathData.length));
+}
+
+- (NSError *)appendChangesForAddedItems:(NSArray<OCItem *> *)addedItems removedItems:(NSArray<OCItem *> *)removedItems updatedItems:(NSArray<OCItem *> *)updatedItems syncAnchor:(OCSyncAnchor)syncAnchor
+{
+	NSMutableData *recordsData = [NSMutableData new];
+	uint64_t syncAnchorValue = syncAnchor.unsignedLongLongValue;
+
+	void (^AppendRecord)(OCVaultChangeKind kind, OCItem *item, OCPath previousPath) = ^(OCVaultChangeKind kind, OCItem *item, OCPath previousPath) {
+		NSData *localIDData = [item.localID dataUsingEncoding:NSUTF8StringEncoding];
+		NSData *previousPathData = [previousPath dataUsingEncoding:NSUTF8StringEncoding];
+		OCVaultChangeJournalRecord record;
+		size_t recordLength;
+
+		if ((localIDData == nil) || (localIDData.length > UINT16_MAX))
+		{
+			return;
+		}
+
+		recordLength = OCVaultChangeJournalRecordLength(localIDData, previousPathData);
+
+		memset(&record, 0, sizeof(record));
+
+		record.length = (uint32_t)recordLength;
+		record.kind = kind;
+		record.localIDLength = (uint16_t)localIDData.length;
+		record.syncAnchor = syncAnchorValue;
+		record.previousPathLength = (uint32_t)previousPathData.length;
+
+		[recordsData appendBytes:&record length:sizeof(record)];
+		[recordsData appendData:localIDData];
+
+		if (previousPathData != nil)
+		{
+			[recordsData appendData:previousPathData];
+		}
+
+		[recordsData increaseLengthBy:(recordLength - sizeof(record) - localIDData.length - previousPathData.length)];
+	};
+
+	for (OCItem *item in addedItems)
+	{
+		AppendRecord(OCVaultChangeKindAdded, item, nil);
+	}
+
+	for (OCItem *item in removedItems)
+	{
+		AppendRecord(OCVaultChangeKindRemoved, item, nil);
+	}
+
+	for (OCItem *item in updatedItems)
+	{
+		OCPath previousPath = item.previousPath;
+
+		if (item.removed)
+		{
+			AppendRecord(OCVaultChangeKindRemoved, item, nil);
+		}
+		else if ((previousPath != nil) && ![previousPath.stringByDeletingLastPathComponent isEqual:item.path.stringByDeletingLastPathComponent])
+		{
+			AppendRecord(OCVaultChangeKindMoved, item, previousPath);
+		}
+		else
+		{
+			AppendRecord(OCVaultChangeKindUpdated, item, nil);
+		}
+	}
+
+	flock(_fd, LOCK_EX);
+
+	if (recordsData.length == 0)
+	{
+		// No entries, but the journal still covers the changes made with syncAnchor
+		if (atomic_load_explicit(&_header->baseSyncAnchor, memory_order_acquire) != UINT64_MAX)
+		{
+			[self _recordLastSyncAnchor:syncAnchorValue];
+		}
+
+		flock(_fd, LOCK_UN);
+
+		return (nil);
+	}
+
+	uint64_t length = atomic_load_explicit(&_header->length, memory_order_acquire);
+
+	if ((length + recordsData.length) > _recordsCapacity)
+	{
+		// Journal full: start over. Bump the generation first, so readers can tell their data may have been overwritten.
+		atomic_fetch_add_explicit(&_header->generation, 1, memory_order_seq_cst);
+		atomic_store_explicit(&_header->length, 0, memory_order_seq_cst);
+
+		length = 0;
+
+		if (recordsData.length > _recordsCapacity)
+		{
+			// Changes don't fit at all: journal only covers changes after this one
+			atomic_store_explicit(&_header->baseSyncAnchor, syncAnchorValue, memory_order_release);
+			atomic_store_explicit(&_header->lastSyncAnchor, syncAnchorValue, memory_order_release);
+			flock(_fd, LOCK_UN);
+
+			OCLogWarning(@"Changes for sync anchor %@ exceed change journal capacity", syncAnchor);
+
+			return (OCError(OCErrorInsufficientStorage));
+		}
+
+		atomic_store_explicit(&_header->baseSyncAnchor, syncAnchorValue - 1, memory_order_release);
+	}
+	else if (atomic_load_explicit(&_header->baseSyncAnchor, memory_order_acquire) == UINT64_MAX)
+	{
+		// First changes written to a new journal
+		atomic_store_explicit(&_header->baseSyncAnchor, syncAnchorValue - 1, memory_order_release);
+	}
+
+	memcpy(_records + length, recordsData.bytes, recordsData.length);
+
+	// Publish the records
+	atomic_store_explicit(&_header->length, length + recordsData.length, memory_order_release);
+	[self _recordLastSyncAnchor:syncAnchorValue];
+
+	flock(_fd, LOCK_UN);
+
+	return (nil);
+}
+
+- (void)_recordLastSyncAnchor:(uint64_t)syncAnchorValue
+{
+	// Must be called with the file lock held. Processes append after committing, so appends for consecutive sync anchors can arrive out of order.
+	if (syncAnchorValue > atomic_load_explicit(&_header->lastSyncAnchor, memory_order_acquire))
+	{
+		atomic_store_explicit(&_header->lastSyncAnchor, syncAnchorValue, memory_order_release);
+	}
+}
+
+#pragma mark - Reading
+- (NSArray<OCVaultChangeJournalEntry *> *)entriesSinceSyncAnchor:(OCSyncAnchor)syncAnchor untilSyncAnchor:(OCSyncAnchor)untilSyncAnchor
+{
+	NSMutableArray<OCVaultChangeJournalEntry *> *entries = [NSMutableArray new];
+	uint64_t syncAnchorValue = syncAnchor.unsignedLongLongValue;
+	uint64_t generation, length, offset = 0, baseSyncAnchor, lastSyncAnchor;
+	uint64_t newCursorOffset, newCursorSyncAnchor = 0;
+
+	@synchronized(self)
+	{
+		generation = atomic_load_explicit(&_header->generation, memory_order_acquire);
+		baseSyncAnchor = atomic_load_explicit(&_header->baseSyncAnchor, memory_order_acquire);
+		lastSyncAnchor = atomic_load_explicit(&_header->lastSyncAnchor, memory_order_acquire);
+		length = atomic_load_explicit(&_header->length, memory_order_acquire);
+
+		if ((syncAnchor == nil) || (baseSyncAnchor == UINT64_MAX) || (syncAnchorValue < baseSyncAnchor) || (length > _recordsCapacity))
+		{
+			// Journal doesn't cover all changes since syncAnchor
+			return (nil);
+		}
+
+		if ((untilSyncAnchor == nil) || (lastSyncAnchor < untilSyncAnchor.unsignedLongLongValue))
+		{
+			// Changes were committed to the database, but not appended to the journal (f.ex. due to process termination in between)
+			OCLogDebug(@"Change journal lags behind database (%llu < %@)", lastSyncAnchor, untilSyncAnchor);
+			return (nil);
+		}
+
+		// Only read the tail if possible
+		if ((generation == _cursorGeneration) && (_cursorSyncAnchor <= syncAnchorValue) && (_cursorOffset <= length))
+		{
+			offset = _cursorOffset;
+			newCursorSyncAnchor = _cursorSyncAnchor;
+		}
+
+		newCursorOffset = offset;
+
+		while ((offset + sizeof(OCVaultChangeJournalRecord)) <= length)
+		{
+			OCVaultChangeJournalRecord *record = (OCVaultChangeJournalRecord *)(_records + offset);
+			uint32_t recordLength = record->length;
+
+			if ((recordLength < sizeof(OCVaultChangeJournalRecord)) || ((offset + recordLength) > length) ||
+			    ((sizeof(OCVaultChangeJournalRecord) + record->localIDLength + record->previousPathLength) > recordLength))
+			{
+				// Corrupt or overwritten record
+				return (nil);
+			}
+
+			if (record->syncAnchor > syncAnchorValue)
+			{
+				OCVaultChangeJournalEntry *entry = [OCVaultChangeJournalEntry new];
+				const uint8_t *payload = ((const uint8_t *)record) + sizeof(OCVaultChangeJournalRecord);
+
+				entry->_syncAnchor = @(record->syncAnchor);
+				entry->_kind = record->kind;
+				entry->_localID = [[NSString alloc] initWithBytes:payload length:record->localIDLength encoding:NSUTF8StringEncoding];
+
+				if (record->previousPathLength > 0)
+				{
+					entry->_previousPath = [[NSString alloc] initWithBytes:(payload + record->localIDLength) length:record->previousPathLength encoding:NSUTF8StringEncoding];
+				}
+
+				if (entry->_localID != nil)
+				{
+					[entries addObject:entry];
+				}
+			}
+			else
+			{
+				// Records are appended in sync anchor order, so the cursor can skip everything up to here next time
+				newCursorOffset = offset + recordLength;
+				newCursorSyncAnchor = MAX(newCursorSyncAnchor, record->syncAnchor);
+			}
+
+			offset += recordLength;
+		}
+
+		// Discard the result if the journal was reset while reading
+		if (atomic_load_explicit(&_header->generation, memory_order_acquire) != generation)
+		{
+			return (nil);
+		}
+
+		_cursorGeneration = generation;
+		_cursorOffset = newCursorOffset;
+		_cursorSyncAnchor = newCursorSyncAnchor;
+	}
+
+	return (entries);
+}
+
+@end
+
+const size_t OCVaultChangeJournalDefaultCapacity = 1024 * 1024;
@@ -24,6 +24,7 @@
 #import "OCDatabase.h"
 #import "NSError+OCError.h"
 #import "OCCoreDirectoryUpdateJob.h"
+#import "OCPlatform.h"
 
 @implementation OCVault (Prepopulation)
 
@@ -104,28 +105,77 @@
 		parseCancelled = YES;
 	};
 
-	[self.database.sqlDB queueBlock:^{
+	// Parsing (and serializing items) happens on the parse queue, while the SQLite thread inserts the batches
+	// parsed before. The number of batches waiting for insertion is limited, so memory usage stays bounded
+	// when parsing is faster than inserting.
+	dispatch_async(dispatch_queue_create("OCVault prepopulation parse queue", DISPATCH_QUEUE_SERIAL_WITH_AUTORELEASE_POOL), ^{
 		OCXMLParser *parser;
-		NSMutableArray<OCItem *> *queuedItems = [NSMutableArray new];
+		BOOL lowMemory = (OCPlatform.current.memoryConfiguration == OCPlatformMemoryConfigurationMinimum);
+		NSUInteger batchSize = lowMemory ? 100 : 5000;
+		dispatch_semaphore_t batchSlots = dispatch_semaphore_create(lowMemory ? 1 : 4);
+		__block NSMutableArray<OCItem *> *batchItems = [NSMutableArray new];
+		__block NSMutableArray<NSData *> *batchItemData = [NSMutableArray new];
 		__block NSUInteger itemCount = 0, folderCount = 0, errorCount = 0;
 		__block NSError *completionError = nil;
-		NSUInteger commitSize = 200;
+		NSObject *completionErrorLock = [NSObject new];
+		NSTimeInterval startTime = NSDate.timeIntervalSinceReferenceDate;
+
+		NSError *(^CompletionError)(void) = ^{
+			@synchronized(completionErrorLock)
+			{
+				return (completionError);
+			}
+		};
+
+		void (^SetCompletionError)(NSError *error) = ^(NSError *error) {
+			@synchronized(completionErrorLock)
+			{
+				if (completionError == nil)
+				{
+					completionError = error;
+				}
+			}
+		};
 
 		void (^StoreItem)(OCItem *item, BOOL flush) = ^(OCItem *item, BOOL flush) {
 			if (item != nil)
 			{
-				[queuedItems addObject:item];
+				NSData *itemData;
+
+				if ((itemData = [item serializedData]) == nil)
+				{
+					SetCompletionError(OCErrorWithInfo(OCErrorInternal, ([NSString stringWithFormat:@"Could not serialize item %@.", item.path])));
+					return;
+				}
+
+				[batchItems addObject:item];
+				[batchItemData addObject:itemData];
 			}
 
-			if ((queuedItems.count >= commitSize) || flush)
+			if (((batchItems.count >= batchSize) || flush) && (batchItems.count > 0))
 			{
-				[db addCacheItems:queuedItems syncAnchor:@(0) completionHandler:^(OCDatabase *db, NSError *error) {
-					if (error != nil)
+				NSArray<OCItem *> *items = batchItems;
+				NSArray<NSData *> *itemsData = batchItemData;
+
+				batchItems = [NSMutableArray new];
+				batchItemData = [NSMutableArray new];
+
+				// Wait for a free slot
+				dispatch_semaphore_wait(batchSlots, DISPATCH_TIME_FOREVER);
+
+				[db.sqlDB queueBlock:^{
+					if (CompletionError() == nil)
 					{
-						completionError = error;
+						// Insert the entire batch in a single transaction
+						[db addCacheItems:items serializedItemData:itemsData syncAnchor:@(0) transactionSize:items.count completionHandler:^(OCDatabase *db, NSError *error) {
+							if (error != nil)
+							{
+								SetCompletionError(error);
+							}
+						}];
 					}
 
-					[queuedItems removeAllObjects];
+					dispatch_semaphore_signal(batchSlots);
 				}];
 			}
 		};
@@ -137,20 +187,28 @@
 			NSMutableDictionary<OCPath, OCItem *> *openItemByPath = [NSMutableDictionary new];
 			NSMutableArray<OCPath> *openPaths = [NSMutableArray new];
 
+			// Drop the secondary metaData indexes during the bulk load and rebuild them once at the end
+			[db.sqlDB deferIndexesOfTable:OCDatabaseTableNameMetaData completionHandler:^(OCSQLiteDB * _Nonnull sqlDB, NSError * _Nullable error) {
+				if (error != nil)
+				{
+					SetCompletionError(error);
+				}
+			}];
+
 			parser.parsedObjectStreamConsumer = ^(OCXMLParser *parser, NSError *error, id parsedObject) {
-				if (completionError == nil)
+				if (CompletionError() == nil)
 				{
 					if (error != nil)
 					{
-						completionError = error;
+						SetCompletionError(error);
 					}
 					else if (parseCancelled)
 					{
-						completionError = OCError(OCErrorCancelled);
+						SetCompletionError(OCError(OCErrorCancelled));
 					}
 				}
 
-				if (completionError != nil)
+				if (CompletionError() != nil)
 				{
 					errorCount++;
 
@@ -180,7 +238,7 @@
 							// the parent folder of every item should always have been received before the items it contains
 							OCLogError(@"Unexpectedly missing: parent folder item for %@", item);
 
-							completionError = OCErrorWithInfo(OCErrorInternal, ([NSString stringWithFormat:@"Unexpectedly missing parent item for %@.", item.path]));
+							SetCompletionError(OCErrorWithInfo(OCErrorInternal, ([NSString stringWithFormat:@"Unexpectedly missing parent item for %@.", item.path])));
 							[parser abort];
 
 							return;
@@ -255,21 +313,39 @@
 				[openPaths removeObject:@"/"];
 			}
 
-			for (OCPath openPath in openPaths)
-			{
-				[db addDirectoryUpdateJob:[OCCoreDirectoryUpdateJob withLocation:[OCLocation legacyRootPath:openPath]] completionHandler:^(OCDatabase *db, NSError *error, OCCoreDirectoryUpdateJob *updateJob) {
+			// Finish on the SQLite thread, after all queued batches have been inserted
+			[db.sqlDB queueBlock:^{
+				// Rebuild indexes (also after errors, so the database remains usable)
+				[db.sqlDB restoreDeferredIndexesWithCompletionHandler:^(OCSQLiteDB * _Nonnull sqlDB, NSError * _Nullable error) {
 					if (error != nil)
 					{
-						completionError = error;
+						SetCompletionError(error);
 					}
 				}];
-			}
 
-			OCLogDebug(@"Error: %@, Items: %lu (folders: %lu, files: %lu), Open Paths: %@", completionError, itemCount, folderCount, (itemCount-folderCount), openPaths);
-		}
+				for (OCPath openPath in openPaths)
+				{
+					[db addDirectoryUpdateJob:[OCCoreDirectoryUpdateJob withLocation:[OCLocation legacyRootPath:openPath]] completionHandler:^(OCDatabase *db, NSError *error, OCCoreDirectoryUpdateJob *updateJob) {
+						if (error != nil)
+						{
+							SetCompletionError(error);
+						}
+					}];
+				}
 
-		completionHandler(completionError);
-	}];
+				NSTimeInterval duration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+				OCLog(@"Prepopulated %lu items (folders: %lu, files: %lu) in %.2f sec (%.0f rows/sec), error: %@", itemCount, folderCount, (itemCount-folderCount), duration, ((duration > 0) ? (itemCount / duration) : 0), CompletionError());
+				OCLogDebug(@"Open Paths: %@", openPaths);
+
+				completionHandler(CompletionError());
+			}];
+		}
+		else
+		{
+			completionHandler(CompletionError());
+		}
+	});
 
 	return (parseProgress);
 }
@@ -0,0 +1,38 @@
+//
+//  OCXMLItemScanner.h
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "OCItem.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCXMLItemScanner : NSObject <NSXMLParserDelegate>
+
+@property(readonly,nonatomic) NSUInteger responseCount; //!< Number of d:response elements found
+@property(readonly,strong,nonatomic) NSIndexSet *changedResponseIndexes; //!< Indexes of the d:response elements without an unchanged known item
+
+- (instancetype)initWithData:(NSData *)xmlData basePath:(nullable NSString *)basePath knownItemsByFileID:(NSDictionary<OCFileID, OCItem *> *)knownItemsByFileID;
+
+- (BOOL)scan; //!< Scans the multistatus response, extracting only the values needed to tell if a d:response matches a known item
+
+- (nullable OCItem *)knownItemForResponseAtIndex:(NSUInteger)responseIndex; //!< Returns a copy of the known item matching the d:response at the index, or nil if the item is new or has changed
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,293 @@
+//
+//  OCXMLItemScanner.m
+//  OpenCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://opencloud.eu/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCXMLItemScanner.h"
+#import "OCItem+OCXMLObjectCreation.h"
+#import "OCHTTPStatus.h"
+#import "OCMacros.h"
+
+@interface OCXMLItemScanner ()
+{
+	NSXMLParser *_xmlParser;
+	NSString *_basePath;
+	NSDictionary<OCFileID, OCItem *> *_knownItemsByFileID;
+
+	NSMutableArray *_knownItemByResponseIndex;
+	NSMutableIndexSet *_changedResponseIndexes;
+
+	OCItem *_scanItem;
+	NSString *_href;
+
+	NSMutableDictionary<NSString *, NSString *> *_propstatValues;
+	NSMutableArray<NSString *> *_propstatShareTypes;
+	NSInteger _propstatStatusCode;
+	BOOL _propstatIsCollection;
+
+	NSMutableString *_characters;
+	BOOL _collectCharacters;
+}
+@end
+
+@implementation OCXMLItemScanner
+
++ (NSSet<NSString *> *)_scannedElementNames
+{
+	static dispatch_once_t onceToken;
+	static NSSet<NSString *> *scannedElementNames;
+
+	dispatch_once(&onceToken, ^{
+		// Only the values compared when merging retrieved items with cached items
+		scannedElementNames = [[NSSet alloc] initWithObjects:
+			@"d:href",
+			@"d:status",
+			@"d:getetag",
+			@"oc:id",
+			@"oc:permissions",
+			@"oc:favorite",
+			@"oc:share-type",
+		nil];
+	});
+
+	return (scannedElementNames);
+}
+
+- (instancetype)initWithData:(NSData *)xmlData basePath:(NSString *)basePath knownItemsByFileID:(NSDictionary<OCFileID,OCItem *> *)knownItemsByFileID
+{
+	if ((self = [super init]) != nil)
+	{
+		_xmlParser = [[NSXMLParser alloc] initWithData:xmlData];
+		_xmlParser.delegate = self;
+
+		_basePath = basePath;
+		_knownItemsByFileID = knownItemsByFileID;
+
+		_knownItemByResponseIndex = [NSMutableArray new];
+		_changedResponseIndexes = [NSMutableIndexSet new];
+
+		_scanItem = [OCItem new];
+
+		_propstatValues = [NSMutableDictionary new];
+		_propstatShareTypes = [NSMutableArray new];
+
+		_characters = [NSMutableString new];
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	_xmlParser.delegate = nil;
+}
+
+#pragma mark - Scan
+- (BOOL)scan
+{
+	return ([_xmlParser parse]);
+}
+
+- (NSUInteger)responseCount
+{
+	return (_knownItemByResponseIndex.count);
+}
+
+- (NSIndexSet *)changedResponseIndexes
+{
+	return (_changedResponseIndexes);
+}
+
+- (OCItem *)knownItemForResponseAtIndex:(NSUInteger)responseIndex
+{
+	if (responseIndex < _knownItemByResponseIndex.count)
+	{
+		return ([OCTypedCast(_knownItemByResponseIndex[responseIndex], OCItem) copy]); // known items are owned by the core and may be mutated on its queue
+	}
+
+	return (nil);
+}
+
+#pragma mark - Matching
+- (void)_resetScanItem
+{
+	_href = nil;
+
+	_scanItem.type = OCItemTypeFile;
+	_scanItem.eTag = nil;
+	_scanItem.fileID = nil;
+	_scanItem.permissions = 0;
+	_scanItem.isFavorite = nil;
+	_scanItem.shareTypesMask = OCShareTypesMaskNone;
+	_scanItem.state = OCItemStateNormal;
+}
+
+- (nullable OCItem *)_knownItemMatchingScanItem
+{
+	OCItem *knownItem;
+	OCPath path;
+
+	if ((_scanItem.fileID == nil) || (_scanItem.eTag == nil) || (_href == nil))
+	{
+		return (nil);
+	}
+
+	if ((knownItem = _knownItemsByFileID[_scanItem.fileID]) == nil)
+	{
+		// New item
+		return (nil);
+	}
+
+	if ((knownItem.locallyModified && (knownItem.localRelativePath != nil)) || (knownItem.activeSyncRecordIDs.count > 0) || (knownItem.remoteItem != nil))
+	{
+		// Items with local changes need a separate server version for merging
+		return (nil);
+	}
+
+	// Same conditions as used by the item list merge to determine if an item has changed
+	if (![knownItem.eTag isEqual:_scanItem.eTag] ||
+	    (knownItem.type != _scanItem.type) ||
+	    (knownItem.permissions != _scanItem.permissions) ||
+	    (knownItem.shareTypesMask != _scanItem.shareTypesMask) ||
+	    (knownItem.isFavorite.boolValue != _scanItem.isFavorite.boolValue) ||
+	    (knownItem.state != _scanItem.state))
+	{
+		return (nil);
+	}
+
+	// Compare path last, as it requires decoding the href
+	path = [_href stringByRemovingPercentEncoding];
+
+	if ((_basePath != nil) && [path hasPrefix:_basePath])
+	{
+		path = [path substringFromIndex:_basePath.length];
+	}
+
+	if (![knownItem.path isEqual:path])
+	{
+		return (nil);
+	}
+
+	return (knownItem);
+}
+
+#pragma mark - Parser delegate
+- (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName attributes:(NSDictionary<NSString *,NSString *> *)attributeDict
+{
+	if ([elementName isEqualToString:@"d:response"])
+	{
+		[self _resetScanItem];
+	}
+	else if ([elementName isEqualToString:@"d:propstat"])
+	{
+		[_propstatValues removeAllObjects];
+		[_propstatShareTypes removeAllObjects];
+		_propstatStatusCode = 0;
+		_propstatIsCollection = NO;
+	}
+	else if ([elementName isEqualToString:@"d:collection"])
+	{
+		_propstatIsCollection = YES;
+	}
+	else if ([OCXMLItemScanner._scannedElementNames containsObject:elementName])
+	{
+		_collectCharacters = YES;
+		[_characters setString:@""];
+	}
+}
+
+- (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string
+{
+	if (_collectCharacters)
+	{
+		[_characters appendString:string];
+	}
+}
+
+- (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName
+{
+	if (_collectCharacters)
+	{
+		_collectCharacters = NO;
+
+		if (_characters.length > 0)
+		{
+			if ([elementName isEqualToString:@"d:href"])
+			{
+				_href = [_characters copy];
+			}
+			else if ([elementName isEqualToString:@"d:status"])
+			{
+				// Format: "HTTP/1.1 200 OK"
+				if ([_characters hasPrefix:@"HTTP/"] && (_characters.length >= 12))
+				{
+					_propstatStatusCode = [_characters substringWithRange:NSMakeRange(9,3)].integerValue;
+				}
+			}
+			else if ([elementName isEqualToString:@"oc:share-type"])
+			{
+				[_propstatShareTypes addObject:[_characters copy]];
+			}
+			else
+			{
+				_propstatValues[elementName] = [_characters copy];
+			}
+		}
+	}
+	else if ([elementName isEqualToString:@"d:propstat"])
+	{
+		BOOL handleContainedTags = ((_propstatStatusCode >= 200) && (_propstatStatusCode < 300));
+
+		if (_propstatStatusCode == OCHTTPStatusCodeTOO_EARLY)
+		{
+			_scanItem.state = OCItemStateServerSideProcessing;
+			handleContainedTags = YES;
+		}
+
+		if (handleContainedTags)
+		{
+			OCXMLParserNodeKeyValueEnumeratorDictionary valueHandlers = [OCItem sharedKeyValueEnumeratorDict];
+
+			_scanItem.type = _propstatIsCollection ? OCItemTypeCollection : OCItemTypeFile;
+
+			[_propstatValues enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL * _Nonnull stop) {
+				valueHandlers[key](self->_scanItem, key, value);
+			}];
+
+			for (NSString *shareType in _propstatShareTypes)
+			{
+				valueHandlers[@"oc:share-type"](_scanItem, @"oc:share-type", shareType);
+			}
+		}
+	}
+	else if ([elementName isEqualToString:@"d:response"])
+	{
+		OCItem *knownItem;
+
+		if ((knownItem = [self _knownItemMatchingScanItem]) != nil)
+		{
+			[_knownItemByResponseIndex addObject:knownItem];
+		}
+		else
+		{
+			[_changedResponseIndexes addIndex:_knownItemByResponseIndex.count];
+			[_knownItemByResponseIndex addObject:NSNull.null];
+		}
+	}
+}
+
+@end
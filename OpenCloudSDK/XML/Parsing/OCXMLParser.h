@@ -32,6 +32,8 @@ typedef NSError *(^OCXMLParserElementValueConverter)(NSString *elementName, NSSt
 
 typedef void(^OCXMLParsedObjectStreamConsumer)(OCXMLParser *parser, NSError *error, id parsedObject);
 
+typedef BOOL(^OCXMLParserObjectCreationFilter)(OCXMLParser *parser, NSString *elementName);
+
 @interface OCXMLParser : NSObject <NSXMLParserDelegate>
 {
 	NSXMLParser *_xmlParser;
@@ -50,11 +52,13 @@ typedef void(^OCXMLParsedObjectStreamConsumer)(OCXMLParser *parser, NSError *err
 	NSInteger _elementContentsLastIndex;
 
 	NSInteger _objectCreationRetainDepth;
+	NSInteger _skipDepth;
 }
 
 @property(readonly,strong) NSMutableArray<NSError *> *errors;
 @property(readonly,strong) NSMutableArray *parsedObjects;
 @property(copy) OCXMLParsedObjectStreamConsumer parsedObjectStreamConsumer;
+@property(copy) OCXMLParserObjectCreationFilter objectCreationFilter; //!< If set, called at the start of every element for which objects are created. Returning NO skips the element and its children entirely, without building nodes or objects.
 
 @property(assign) BOOL forceRetain;
 @property(strong,nonatomic) NSMutableDictionary <NSString *, id> *options;
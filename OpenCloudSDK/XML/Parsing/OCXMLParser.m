@@ -196,8 +196,22 @@
 	OCXMLParserNode *elementNode = nil;
 	NSError *error = nil;
 
+	if (_skipDepth > 0)
+	{
+		// Inside a skipped element
+		_skipDepth++;
+		return;
+	}
+
 	if ([_objectCreationClassByElementName valueForKey:elementName] != nil)
 	{
+		if ((_objectCreationFilter != nil) && !_objectCreationFilter(self, elementName))
+		{
+			// Skip element
+			_skipDepth = 1;
+			return;
+		}
+
 		_objectCreationRetainDepth++;
 	}
 
@@ -223,6 +237,8 @@
 
 - (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string
 {
+	if (_skipDepth > 0) { return; }
+
 	[[_elementContents lastObject] appendString:string];
 	[_elementContentsEmptyIndexes removeIndex:_elementContentsLastIndex];
 }
@@ -230,7 +246,16 @@
 - (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName
 {
 	id elementContents = nil;
-	OCXMLParserNode *lastParserElementOnStack = _stack.lastObject;
+	OCXMLParserNode *lastParserElementOnStack;
+
+	if (_skipDepth > 0)
+	{
+		// End of a skipped element (or one of its children)
+		_skipDepth--;
+		return;
+	}
+
+	lastParserElementOnStack = _stack.lastObject;
 
 	if (![_elementContentsEmptyIndexes containsIndex:_elementContentsLastIndex])
 	{
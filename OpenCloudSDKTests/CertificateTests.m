@@ -62,6 +62,23 @@
 	[self waitForExpectationsWithTimeout:5 handler:nil];
 }
 
+- (void)testCertificateValidUntilDate
+{
+	OCCertificate *certificate = [self certificateNamed:@"demo-cert-new" hostName:@"demo.opencloud.eu"];
+	NSDateComponents *components = [[NSCalendar calendarWithIdentifier:NSCalendarIdentifierGregorian] componentsInTimeZone:[NSTimeZone timeZoneForSecondsFromGMT:0] fromDate:certificate.validUntilDate];
+
+	// notAfter=Feb  3 03:03:01 2021 GMT
+	XCTAssertNotNil(certificate.validUntilDate);
+	XCTAssertEqual(components.year, 2021);
+	XCTAssertEqual(components.month, 2);
+	XCTAssertEqual(components.day, 3);
+	XCTAssertEqual(components.hour, 3);
+	XCTAssertEqual(components.minute, 3);
+	XCTAssertEqual(components.second, 1);
+
+	XCTAssertNil([OCCertificate certificateWithCertificateData:[@"no certificate" dataUsingEncoding:NSUTF8StringEncoding] hostName:nil].validUntilDate);
+}
+
 - (void)testCertificateMetaDataParsingFromWeb
 {
 	NSArray <NSURL *> *urlsToTest = @[
@@ -21,9 +21,17 @@
 
 #import "OCTestTarget.h"
 
-@interface ConnectionTests : XCTestCase <OCEventHandler, OCClassSettingsSource>
+@interface OCConnection (FastConnectTesting)
+- (BOOL)_restoreCachedConnectionState;
+- (void)_reconcileCachedCapabilities:(OCCapabilities *)cachedCapabilities withRefreshedCapabilities:(nullable OCCapabilities *)capabilities error:(nullable NSError *)error;
+@end
+
+@interface ConnectionTests : XCTestCase <OCEventHandler, OCClassSettingsSource, OCConnectionDelegate>
 {
 	 OCConnection *newConnection;
+
+	 NSDictionary<OCClassSettingsKey, id> *connectionSettings;
+	 NSMutableArray<NSError *> *connectionErrors;
 }
 
 @end
@@ -404,6 +412,11 @@
 {
 	if ([identifier isEqual:[OCConnection classSettingsIdentifier]])
 	{
+		if (connectionSettings != nil)
+		{
+			return (connectionSettings);
+		}
+
 		return (@{
 			OCConnectionMinimumVersionRequired : @"100.0.0.0"
 		});
@@ -1209,6 +1222,138 @@
 	[self waitForExpectationsWithTimeout:120 handler:nil];
 }
 
+#pragma mark - Fast connect
+- (void)connection:(OCConnection *)connection handleError:(NSError *)error
+{
+	@synchronized(self)
+	{
+		[connectionErrors addObject:error];
+	}
+}
+
+- (NSMutableDictionary<NSString *, id> *)_capabilitiesJSONWithVersion:(nullable NSString *)version
+{
+	NSURL *capabilitiesURL = [[NSBundle bundleForClass:[self class]] URLForResource:@"capabilities" withExtension:@"json"];
+	NSMutableDictionary<NSString *, id> *jsonDict = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfURL:capabilitiesURL] options:NSJSONReadingMutableContainers error:NULL];
+
+	if (version != nil)
+	{
+		jsonDict[@"ocs"][@"data"][@"capabilities"][@"core"][@"status"][@"version"] = version;
+	}
+
+	return (jsonDict);
+}
+
+- (OCConnection *)_fastConnectConnectionWithCachedCapabilitiesData:(nullable NSData *)capabilitiesData user:(nullable OCUser *)user
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"https://demo.opencloud.eu"]];
+
+	bookmark.user = user;
+
+	if (capabilitiesData != nil)
+	{
+		bookmark.userInfo[OCBookmarkUserInfoKeyCapabilities] = capabilitiesData;
+	}
+
+	return ([[OCConnection alloc] initWithBookmark:bookmark]);
+}
+
+- (void)testFastConnectCachedStateRestore
+{
+	NSData *capabilitiesData = [NSJSONSerialization dataWithJSONObject:[self _capabilitiesJSONWithVersion:nil] options:NSJSONWritingSortedKeys error:NULL];
+	OCUser *user = [OCUser userWithUserName:@"admin" displayName:@"Admin"];
+	OCConnection *connection;
+
+	connectionSettings = @{ OCConnectionFastConnect : @(YES) };
+	[[OCClassSettings sharedSettings] addSource:self];
+
+	// Hit: cached capabilities and user are restored
+	connection = [self _fastConnectConnectionWithCachedCapabilitiesData:capabilitiesData user:user];
+	XCTAssert([connection _restoreCachedConnectionState]);
+	XCTAssertEqualObjects(connection.capabilities.version, @"10.1.0.4");
+	XCTAssertEqualObjects(connection.loggedInUser.userName, @"admin");
+
+	// Miss: no cached capabilities
+	connection = [self _fastConnectConnectionWithCachedCapabilitiesData:nil user:user];
+	XCTAssert(![connection _restoreCachedConnectionState]);
+	XCTAssertNil(connection.capabilities);
+	XCTAssertNil(connection.loggedInUser);
+
+	// Miss: no cached user
+	connection = [self _fastConnectConnectionWithCachedCapabilitiesData:capabilitiesData user:nil];
+	XCTAssert(![connection _restoreCachedConnectionState]);
+	XCTAssertNil(connection.capabilities);
+
+	// Corrupt cache: capabilities that can't be decoded
+	connection = [self _fastConnectConnectionWithCachedCapabilitiesData:[@"{ \"ocs\": " dataUsingEncoding:NSUTF8StringEncoding] user:user];
+	XCTAssert(![connection _restoreCachedConnectionState]);
+	XCTAssertNil(connection.capabilities);
+
+	// Cached capabilities of a server that doesn't meet the minimum version requirement
+	connectionSettings = @{ OCConnectionFastConnect : @(YES), OCConnectionMinimumVersionRequired : @"100.0.0.0" };
+	[[OCClassSettings sharedSettings] clearSourceCache];
+
+	connection = [self _fastConnectConnectionWithCachedCapabilitiesData:capabilitiesData user:user];
+	XCTAssert(![connection _restoreCachedConnectionState]);
+
+	[[OCClassSettings sharedSettings] removeSource:self];
+	connectionSettings = nil;
+
+	// Fast connect disabled (default)
+	connection = [self _fastConnectConnectionWithCachedCapabilitiesData:capabilitiesData user:user];
+	XCTAssert(![connection _restoreCachedConnectionState]);
+}
+
+- (void)testFastConnectServerBecomesUnsupportedDuringRefresh
+{
+	NSData *capabilitiesData = [NSJSONSerialization dataWithJSONObject:[self _capabilitiesJSONWithVersion:nil] options:NSJSONWritingSortedKeys error:NULL];
+	OCConnection *connection;
+	OCCapabilities *cachedCapabilities, *refreshedCapabilities;
+	NSError *minimumVersionError;
+
+	connectionSettings = @{ OCConnectionFastConnect : @(YES) };
+	connectionErrors = [NSMutableArray new];
+	[[OCClassSettings sharedSettings] addSource:self];
+
+	connection = [self _fastConnectConnectionWithCachedCapabilitiesData:capabilitiesData user:[OCUser userWithUserName:@"admin" displayName:@"Admin"]];
+	connection.delegate = self;
+
+	XCTAssert([connection _restoreCachedConnectionState]);
+	cachedCapabilities = connection.capabilities;
+
+	// Changed, but still supported server: observers are informed, the connection isn't touched
+	XCTNSNotificationExpectation *changeExpectation = [[XCTNSNotificationExpectation alloc] initWithName:OCConnectionCapabilitiesChangedNotification object:connection];
+
+	refreshedCapabilities = [[OCCapabilities alloc] initWithRawJSON:[self _capabilitiesJSONWithVersion:@"10.2.0.0"]];
+	[connection _reconcileCachedCapabilities:cachedCapabilities withRefreshedCapabilities:refreshedCapabilities error:nil];
+
+	[self waitForExpectations:@[ changeExpectation ] timeout:5];
+	XCTAssert(connectionErrors.count == 0);
+
+	// Server version dropped below the minimum during the background refresh: the connection disconnects and reports the error
+	connection.state = OCConnectionStateConnected;
+
+	refreshedCapabilities = [[OCCapabilities alloc] initWithRawJSON:[self _capabilitiesJSONWithVersion:@"0.0.1.0"]];
+	minimumVersionError = [connection supportsServerVersion:refreshedCapabilities.version product:refreshedCapabilities.productName longVersion:refreshedCapabilities.longProductVersionString allowHiddenVersion:NO];
+	XCTAssert([minimumVersionError isOCErrorWithCode:OCErrorServerVersionNotSupported]);
+
+	[connection _reconcileCachedCapabilities:cachedCapabilities withRefreshedCapabilities:refreshedCapabilities error:minimumVersionError];
+
+	XCTAssert(connection.state == OCConnectionStateDisconnected);
+	XCTAssert(connectionErrors.count == 1);
+	XCTAssert([connectionErrors.firstObject isOCErrorWithCode:OCErrorServerVersionNotSupported]);
+
+	// Other refresh errors keep the cached state
+	connection.state = OCConnectionStateConnected;
+
+	[connection _reconcileCachedCapabilities:cachedCapabilities withRefreshedCapabilities:nil error:OCError(OCErrorRequestTimeout)];
+
+	XCTAssert(connection.state == OCConnectionStateConnected);
+	XCTAssert(connectionErrors.count == 1);
+
+	[[OCClassSettings sharedSettings] removeSource:self];
+	connectionSettings = nil;
+}
 
 @end
 
@@ -125,4 +125,64 @@
 	XCTAssert(![core1RunID isEqual:core2RunID]);
 }
 
+- (void)testPrewarmedCoreIsReusedAndStoppedAfterLingering
+{
+	if (!OCCoreManager.sharedCoreManager.lingeringPermitted)
+	{
+		XCTSkip(@"Core lingering is not permitted in this environment");
+	}
+
+	XCTestExpectation *prewarmExpectation = [self expectationWithDescription:@"expect prewarm"];
+	XCTestExpectation *requestExpectation = [self expectationWithDescription:@"expect core request"];
+	XCTestExpectation *secondRequestExpectation = [self expectationWithDescription:@"expect second core request"];
+	XCTestExpectation *returnExpectation = [self expectationWithDescription:@"expect core return"];
+	__block __weak OCCore *warmCore = nil;
+	NSUInteger warmStartCount = OCCoreManager.sharedCoreManager.warmStartCount;
+
+	@autoreleasepool {
+		OCBookmark *bookmark = [OCTestTarget userBookmark];
+
+		[[OCCoreManager sharedCoreManager] prewarmCoreForBookmark:bookmark lingerDuration:2.0 completionHandler:^(NSError * _Nullable error) {
+			XCTAssert(error==nil);
+
+			[prewarmExpectation fulfill];
+
+			[[OCCoreManager sharedCoreManager] requestCoreForBookmark:bookmark setup:nil completionHandler:^(OCCore * _Nullable core, NSError * _Nullable error) {
+				warmCore = core;
+
+				XCTAssert(core!=nil);
+				XCTAssert(error==nil);
+				XCTAssert(OCCoreManager.sharedCoreManager.warmStartCount == warmStartCount + 1);
+
+				[requestExpectation fulfill];
+
+				// Requests for a core that is already in use are not counted as warm starts
+				[[OCCoreManager sharedCoreManager] requestCoreForBookmark:bookmark setup:nil completionHandler:^(OCCore * _Nullable core, NSError * _Nullable error) {
+					XCTAssert(core!=nil);
+					XCTAssert(error==nil);
+					XCTAssert(OCCoreManager.sharedCoreManager.warmStartCount == warmStartCount + 1);
+
+					[secondRequestExpectation fulfill];
+
+					[[OCCoreManager sharedCoreManager] returnCoreForBookmark:bookmark completionHandler:^{
+						[[OCCoreManager sharedCoreManager] returnCoreForBookmark:bookmark completionHandler:^{
+							[returnExpectation fulfill];
+						}];
+					}];
+				}];
+			}];
+		}];
+
+		[self waitForExpectationsWithTimeout:20 handler:nil];
+	}
+
+	// Core is kept running for the linger duration ..
+	XCTAssert(warmCore!=nil);
+
+	// .. and stopped after it
+	[[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:4.0]];
+
+	XCTAssert(warmCore==nil);
+}
+
 @end
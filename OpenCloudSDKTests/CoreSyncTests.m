@@ -13,6 +13,7 @@
 #import "TestTools.h"
 #import "OCTestTarget.h"
 #import "OCItem+OCItemCreationDebugging.h"
+#import "OCSyncLaneScheduler.h"
 
 @interface CoreSyncTestsIssueDismisser : NSObject <OCCoreDelegate>
 @end
@@ -1979,4 +1980,188 @@
 	}];
 }
 
+#pragma mark - Sync lane scheduling
+- (NSArray<OCSyncLane *> *)_syncLanesForMixedActionsBenchmarkWithRecordCounts:(NSMutableDictionary<OCSyncLaneID, NSNumber *> *)recordCountsByLaneID
+{
+	NSMutableArray<OCSyncLane *> *lanes = [NSMutableArray new];
+	NSUInteger laneID = 1;
+
+	// 1 lane for a large move of 5,000 items in /Archive/
+	OCSyncLane *moveLane = [OCSyncLane new];
+	moveLane.identifier = @(laneID++);
+	[moveLane extendWithTags:[NSSet setWithObjects:@"/Archive/", @"/Archive-Moved/", nil]];
+	[lanes addObject:moveLane];
+	recordCountsByLaneID[moveLane.identifier] = @(5000);
+
+	// 20 lanes waiting for the move to complete with 50 records each (1,000 records)
+	for (NSUInteger i=0; i<20; i++)
+	{
+		OCSyncLane *dependentLane = [OCSyncLane new];
+		dependentLane.identifier = @(laneID++);
+		dependentLane.afterLanes = [NSSet setWithObject:moveLane.identifier];
+		[dependentLane extendWithTags:[NSSet setWithObject:[NSString stringWithFormat:@"/Archive-Moved/%lu/", i]]];
+		[lanes addObject:dependentLane];
+		recordCountsByLaneID[dependentLane.identifier] = @(50);
+	}
+
+	// 100 independent upload lanes with 30 records each (3,000 records)
+	for (NSUInteger i=0; i<100; i++)
+	{
+		OCSyncLane *uploadLane = [OCSyncLane new];
+		uploadLane.identifier = @(laneID++);
+		[uploadLane extendWithTags:[NSSet setWithObjects:[NSString stringWithFormat:@"/Photos/%lu/", i], NSUUID.UUID.UUIDString, nil]];
+		[lanes addObject:uploadLane];
+		recordCountsByLaneID[uploadLane.identifier] = @(30);
+	}
+
+	// 100 independent download lanes with 10 records each (1,000 records)
+	for (NSUInteger i=0; i<100; i++)
+	{
+		OCSyncLane *downloadLane = [OCSyncLane new];
+		downloadLane.identifier = @(laneID++);
+		[downloadLane extendWithTags:[NSSet setWithObjects:[NSString stringWithFormat:@"/Documents/%lu.pdf", i], NSUUID.UUID.UUIDString, nil]];
+		[lanes addObject:downloadLane];
+		recordCountsByLaneID[downloadLane.identifier] = @(10);
+	}
+
+	return (lanes);
+}
+
+- (NSUInteger)_runSyncLaneScheduler:(OCSyncLaneScheduler *)scheduler recordCounts:(NSDictionary<OCSyncLaneID, NSNumber *> *)recordCountsByLaneID firstProcessedIndexOfLaneID:(OCSyncLaneID)watchedLaneID
+{
+	NSMutableDictionary<OCSyncLaneID, NSNumber *> *remainingRecordsByLaneID = [recordCountsByLaneID mutableCopy];
+	__block NSUInteger processedRecords = 0;
+	__block NSUInteger firstProcessedIndex = NSNotFound;
+
+	[scheduler runWithLaneProcessor:^OCSyncLaneSchedulerLaneStatus(OCSyncLane * _Nonnull lane, OCSyncLaneCursor * _Nonnull cursor, NSUInteger quantum) {
+		NSUInteger remaining = remainingRecordsByLaneID[lane.identifier].unsignedIntegerValue;
+		NSUInteger processNow = ((quantum > 0) && (remaining > quantum)) ? quantum : remaining;
+
+		if ((processNow > 0) && [lane.identifier isEqual:watchedLaneID] && (firstProcessedIndex == NSNotFound))
+		{
+			firstProcessedIndex = processedRecords;
+		}
+
+		processedRecords += processNow;
+		remaining -= processNow;
+		remainingRecordsByLaneID[lane.identifier] = @(remaining);
+
+		cursor.recordsOnLane += processNow;
+
+		return ((remaining > 0) ? OCSyncLaneSchedulerLaneStatusYield : OCSyncLaneSchedulerLaneStatusCompleted);
+	} laneCompletionHandler:^BOOL(OCSyncLane * _Nonnull lane, OCSyncLaneCursor * _Nonnull cursor) {
+		return (YES);
+	}];
+
+	XCTAssert(processedRecords == 10000, @"Processed %lu instead of 10000 records", processedRecords);
+
+	return (firstProcessedIndex);
+}
+
+- (void)testSyncLaneSharding
+{
+	NSMutableDictionary<OCSyncLaneID, NSNumber *> *recordCountsByLaneID = [NSMutableDictionary new];
+	NSArray<OCSyncLane *> *lanes = [self _syncLanesForMixedActionsBenchmarkWithRecordCounts:recordCountsByLaneID];
+	NSArray<OCSyncLaneShard *> *shards = [OCSyncLaneScheduler shardsForLanes:lanes];
+
+	// Move + dependent lanes form one shard, every upload and download lane its own
+	XCTAssert(shards.count == 201, @"Unexpected number of shards: %lu", shards.count);
+	XCTAssert(shards.firstObject.lanes.count == 21);
+	XCTAssert([shards.firstObject.lanes.firstObject.identifier isEqual:@(1)]);
+
+	// Lanes with overlapping tags end up in the same shard
+	OCSyncLane *overlappingLane = [OCSyncLane new];
+	overlappingLane.identifier = @(1000);
+	[overlappingLane extendWithTags:[NSSet setWithObjects:@"/Photos/1/", @"/Photos/2/", nil]];
+
+	shards = [OCSyncLaneScheduler shardsForLanes:[lanes arrayByAddingObject:overlappingLane]];
+	XCTAssert(shards.count == 200, @"Unexpected number of shards: %lu", shards.count);
+}
+
+- (void)testSyncLaneSchedulingPerformanceWith10kMixedActions
+{
+	NSMutableDictionary<OCSyncLaneID, NSNumber *> *recordCountsByLaneID = [NSMutableDictionary new];
+	NSArray<OCSyncLane *> *lanes = [self _syncLanesForMixedActionsBenchmarkWithRecordCounts:recordCountsByLaneID];
+	OCSyncLaneID lastUploadLaneID = @(121);
+	__block NSUInteger serialIndex = 0, shardedIndex = 0;
+
+	// Serial processing (quantum 0): the upload lane has to wait for the move lane to drain
+	[self measureBlock:^{
+		OCSyncLaneScheduler *scheduler = [[OCSyncLaneScheduler alloc] initWithLanes:lanes];
+		scheduler.quantum = 0;
+
+		serialIndex = [self _runSyncLaneScheduler:scheduler recordCounts:recordCountsByLaneID firstProcessedIndexOfLaneID:lastUploadLaneID];
+	}];
+
+	// Sharded processing: the upload lane gets its turn after one quantum per preceding shard
+	OCSyncLaneScheduler *scheduler = [[OCSyncLaneScheduler alloc] initWithLanes:lanes];
+	scheduler.quantum = 8;
+
+	NSTimeInterval startTime = NSDate.timeIntervalSinceReferenceDate;
+	shardedIndex = [self _runSyncLaneScheduler:scheduler recordCounts:recordCountsByLaneID firstProcessedIndexOfLaneID:lastUploadLaneID];
+	NSTimeInterval duration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	OCLog(@"10k mixed actions: sharded scheduling took %.04f sec; last upload lane first served after %lu records (serial: after %lu records)", duration, shardedIndex, serialIndex);
+
+	XCTAssert(serialIndex >= 5000);
+	XCTAssert(shardedIndex < (8 * 121));
+}
+
+- (void)testSyncLaneSchedulingRespectsMaximumActiveLanes
+{
+	NSMutableArray<OCSyncLane *> *lanes = [NSMutableArray new];
+	NSMutableDictionary<OCSyncLaneID, NSNumber *> *remainingRecordsByLaneID = [NSMutableDictionary new];
+	NSMutableSet<OCSyncLaneID> *startedLaneIDs = [NSMutableSet new];
+	__block NSUInteger inProgressLanes = 0, maxInProgressLanes = 0;
+
+	// 1 empty lane (doesn't count as active) and 5 independent lanes with 20 records each
+	for (NSUInteger i=0; i<6; i++)
+	{
+		OCSyncLane *lane = [OCSyncLane new];
+		lane.identifier = @(i+1);
+		[lane extendWithTags:[NSSet setWithObject:[NSString stringWithFormat:@"/Lane %lu/", i]]];
+		[lanes addObject:lane];
+		remainingRecordsByLaneID[lane.identifier] = @((i == 0) ? 0 : 20);
+	}
+
+	OCSyncLaneScheduler *scheduler = [[OCSyncLaneScheduler alloc] initWithLanes:lanes];
+	scheduler.quantum = 8;
+	scheduler.maximumActiveLanes = 2;
+
+	[scheduler runWithLaneProcessor:^OCSyncLaneSchedulerLaneStatus(OCSyncLane * _Nonnull lane, OCSyncLaneCursor * _Nonnull cursor, NSUInteger quantum) {
+		NSUInteger remaining = remainingRecordsByLaneID[lane.identifier].unsignedIntegerValue;
+		NSUInteger processNow = ((quantum > 0) && (remaining > quantum)) ? quantum : remaining;
+
+		if (![startedLaneIDs containsObject:lane.identifier])
+		{
+			[startedLaneIDs addObject:lane.identifier];
+			inProgressLanes++;
+			maxInProgressLanes = MAX(inProgressLanes, maxInProgressLanes);
+		}
+
+		remaining -= processNow;
+		remainingRecordsByLaneID[lane.identifier] = @(remaining);
+
+		// Records stay on the lane (as if their actions were still running)
+		cursor.recordsOnLane += processNow;
+
+		return ((remaining > 0) ? OCSyncLaneSchedulerLaneStatusYield : OCSyncLaneSchedulerLaneStatusCompleted);
+	} laneCompletionHandler:^BOOL(OCSyncLane * _Nonnull lane, OCSyncLaneCursor * _Nonnull cursor) {
+		if (cursor.recordsOnLane == 0)
+		{
+			inProgressLanes--;
+		}
+
+		return (YES);
+	}];
+
+	// Empty lane + 2 active lanes were started, the remaining 3 lanes were not
+	XCTAssertEqual(startedLaneIDs.count, 3);
+	XCTAssertEqual(maxInProgressLanes, 2);
+	XCTAssertEqual(inProgressLanes, 2);
+	XCTAssertEqualObjects(remainingRecordsByLaneID[@(4)], @(20));
+	XCTAssertEqualObjects(remainingRecordsByLaneID[@(5)], @(20));
+	XCTAssertEqualObjects(remainingRecordsByLaneID[@(6)], @(20));
+}
+
 @end
@@ -10,6 +10,7 @@
 #import <OpenCloudSDK/OpenCloudSDK.h>
 #import <OpenCloudMocking/OpenCloudMocking.h>
 #import "OCCore+Internal.h"
+#import "OCCore+SubtreeRetrieval.h"
 #import "TestTools.h"
 #import "XCTestCase+Tagging.h"
 
@@ -1612,6 +1613,17 @@
 				dispatch_group_leave(suggestionWaitGroups);
 			}];
 
+			// - style: bracketed, multiple names
+			dispatch_group_enter(suggestionWaitGroups);
+			[core suggestUnusedNames:3 basedOn:@"OpenCloud Manual.pdf" atLocation:OCLocation.legacyRootLocation isDirectory:NO usingNameStyle:OCCoreDuplicateNameStyleBracketed filteredBy:^BOOL(NSString * _Nonnull suggestedName) {
+				return (![suggestedName isEqual:@"OpenCloud Manual (2).pdf"]);
+			} resultHandler:^(NSArray<NSString *> * _Nullable suggestedNames, NSArray<NSString *> * _Nullable rejectedAndTakenNames) {
+				XCTAssertEqualObjects(suggestedNames, (@[ @"OpenCloud Manual (1).pdf", @"OpenCloud Manual (3).pdf", @"OpenCloud Manual (4).pdf" ]));
+				XCTAssert(rejectedAndTakenNames.count == 2);
+
+				dispatch_group_leave(suggestionWaitGroups);
+			}];
+
 			// Stop when returned
 			dispatch_group_notify(suggestionWaitGroups, dispatch_get_main_queue(), ^{
 				[core stopWithCompletionHandler:^(id sender, NSError *error) {
@@ -1731,6 +1743,153 @@
 	}];
 }
 
+- (NSData *)_subtreeResponseDataForPaths:(NSArray<NSString *> *)paths basePath:(NSString *)basePath
+{
+	NSMutableString *xmlString = [NSMutableString stringWithString:@"<?xml version=\"1.0\"?>\n<d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\">\n"];
+	NSUInteger fileID = 1;
+
+	for (NSString *path in paths)
+	{
+		BOOL isFolder = [path hasSuffix:@"/"];
+
+		[xmlString appendFormat:@"<d:response><d:href>%@%@</d:href><d:propstat><d:prop>%@<d:getlastmodified>Fri, 23 Nov 2018 09:43:58 GMT</d:getlastmodified><d:getetag>&quot;%lu&quot;</d:getetag><oc:size>100</oc:size><oc:id>%08luocsubtree</oc:id><oc:permissions>RDNVW</oc:permissions><oc:favorite>0</oc:favorite></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>\n",
+			basePath, path, (isFolder ? @"<d:resourcetype><d:collection/></d:resourcetype>" : @"<d:resourcetype/><d:getcontentlength>100</d:getcontentlength><d:getcontenttype>text/plain</d:getcontenttype>"), (unsigned long)fileID, (unsigned long)fileID];
+
+		fileID++;
+	}
+
+	[xmlString appendString:@"</d:multistatus>\n"];
+
+	return ([xmlString dataUsingEncoding:NSUTF8StringEncoding]);
+}
+
+- (void)testSubtreeResponseSplitting
+{
+	NSString *basePath = @"/remote.php/dav/files/admin";
+	NSData *responseData = [self _subtreeResponseDataForPaths:@[
+		@"/",
+		@"/A/",
+		@"/A/a1.txt",
+		@"/A/B/",
+		@"/A/B/b1.txt",
+		@"/A/B/b2.txt",
+		@"/A/a2.txt",
+		@"/C/",
+		@"/C/c1.txt"
+	] basePath:basePath];
+	NSMutableDictionary<OCPath, NSArray<OCItem *> *> *itemListsByPath = [NSMutableDictionary new];
+	__block NSUInteger batchCount = 0, lastFolderCount = 0, lastFileCount = 0;
+	NSError *error;
+
+	error = [OCCore splitSubtreeResponseStream:[NSInputStream inputStreamWithData:responseData] basePath:basePath driveID:nil batchSize:2 itemListsHandler:^BOOL(NSDictionary<OCPath,NSArray<OCItem *> *> * _Nullable batchItemListsByPath, NSUInteger folderCount, NSUInteger fileCount) {
+		if (batchItemListsByPath != nil)
+		{
+			// Every folder is handed over exactly once
+			for (OCPath path in batchItemListsByPath)
+			{
+				XCTAssertNil(itemListsByPath[path]);
+			}
+
+			[itemListsByPath addEntriesFromDictionary:batchItemListsByPath];
+			batchCount++;
+		}
+
+		lastFolderCount = folderCount;
+		lastFileCount = fileCount;
+
+		return (YES);
+	}];
+
+	XCTAssertNil(error);
+	XCTAssertGreaterThan(batchCount, 1); // lists are handed over in batches as folders complete, not all at the end
+	XCTAssertEqual(lastFolderCount, 4);
+	XCTAssertEqual(lastFileCount, 5);
+
+	NSDictionary<OCPath, NSArray<OCPath> *> *expectedPathsByFolderPath = @{
+		@"/" 		: @[ @"/", @"/A/", @"/C/" ],
+		@"/A/" 		: @[ @"/A/", @"/A/a1.txt", @"/A/B/", @"/A/a2.txt" ],
+		@"/A/B/" 	: @[ @"/A/B/", @"/A/B/b1.txt", @"/A/B/b2.txt" ],
+		@"/C/" 		: @[ @"/C/", @"/C/c1.txt" ]
+	};
+
+	XCTAssertEqualObjects([NSSet setWithArray:itemListsByPath.allKeys], [NSSet setWithArray:expectedPathsByFolderPath.allKeys]);
+
+	[expectedPathsByFolderPath enumerateKeysAndObjectsUsingBlock:^(OCPath folderPath, NSArray<OCPath> *expectedPaths, BOOL * _Nonnull stop) {
+		NSMutableArray<OCPath> *paths = [NSMutableArray new];
+
+		for (OCItem *item in itemListsByPath[folderPath])
+		{
+			[paths addObject:item.path];
+		}
+
+		// Folder item first, followed by its immediate children - just like in a Depth:1 response
+		XCTAssertEqualObjects(paths, expectedPaths);
+	}];
+
+	// Parsing is aborted when the handler returns NO
+	__block NSUInteger abortedBatchCount = 0;
+
+	error = [OCCore splitSubtreeResponseStream:[NSInputStream inputStreamWithData:responseData] basePath:basePath driveID:nil batchSize:2 itemListsHandler:^BOOL(NSDictionary<OCPath,NSArray<OCItem *> *> * _Nullable batchItemListsByPath, NSUInteger folderCount, NSUInteger fileCount) {
+		abortedBatchCount++;
+		return (NO);
+	}];
+
+	XCTAssert([error isOCErrorWithCode:OCErrorCancelled]);
+	XCTAssertEqual(abortedBatchCount, 1);
+}
+
+- (void)testSubtreeResponseSplittingWithNonDepthFirstOrder
+{
+	NSString *basePath = @"/remote.php/dav/files/admin";
+	NSData *responseData = [self _subtreeResponseDataForPaths:@[
+		@"/",
+		@"/A/",
+		@"/A/a1.txt",
+		@"/C/",
+		@"/C/c1.txt",
+		@"/A/a2.txt",	// arrives after /A/ was closed by /C/
+		@"/A/B/",
+		@"/A/B/b1.txt",
+		@"/A/a3.txt"
+	] basePath:basePath];
+	NSMutableDictionary<OCPath, NSArray<OCItem *> *> *itemListsByPath = [NSMutableDictionary new];
+	NSMutableArray<OCPath> *handedOverPaths = [NSMutableArray new];
+	NSError *error;
+
+	error = [OCCore splitSubtreeResponseStream:[NSInputStream inputStreamWithData:responseData] basePath:basePath driveID:nil batchSize:1 itemListsHandler:^BOOL(NSDictionary<OCPath,NSArray<OCItem *> *> * _Nullable batchItemListsByPath, NSUInteger folderCount, NSUInteger fileCount) {
+		if (batchItemListsByPath != nil)
+		{
+			[handedOverPaths addObjectsFromArray:batchItemListsByPath.allKeys];
+			[itemListsByPath addEntriesFromDictionary:batchItemListsByPath];
+		}
+
+		return (YES);
+	}];
+
+	XCTAssertNil(error);
+
+	// The incomplete list of /A/ is handed over first, then replaced with an empty list, so it is discarded
+	XCTAssertEqual([[handedOverPaths filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"SELF == %@", @"/A/"]] count], 2);
+	XCTAssertEqual(itemListsByPath[@"/A/"].count, 0);
+
+	NSDictionary<OCPath, NSArray<OCPath> *> *expectedPathsByFolderPath = @{
+		@"/" 		: @[ @"/", @"/A/", @"/C/" ],
+		@"/A/B/" 	: @[ @"/A/B/", @"/A/B/b1.txt" ],
+		@"/C/" 		: @[ @"/C/", @"/C/c1.txt" ]
+	};
+
+	[expectedPathsByFolderPath enumerateKeysAndObjectsUsingBlock:^(OCPath folderPath, NSArray<OCPath> *expectedPaths, BOOL * _Nonnull stop) {
+		NSMutableArray<OCPath> *paths = [NSMutableArray new];
+
+		for (OCItem *item in itemListsByPath[folderPath])
+		{
+			[paths addObject:item.path];
+		}
+
+		XCTAssertEqualObjects(paths, expectedPaths);
+	}];
+}
+
 - (void)testBookmarkItemResolution
 {
 	XCTestExpectation *expectCoreToFindItem = [self expectationWithDescription:@"Core finds item"];
@@ -1784,4 +1943,143 @@
 	[OCBookmarkManager.sharedBookmarkManager removeBookmark:bookmark];
 }
 
+#pragma mark - Paged VFS content
+- (OCVFSContent *)_contentPageOfVFSCore:(OCVFSCore *)vfsCore changesFromSyncAnchor:(OCSyncAnchor)syncAnchor cursor:(OCVFSContentCursor)cursor pageSize:(NSUInteger)pageSize error:(NSError **)outError
+{
+	XCTestExpectation *expectPage = [self expectationWithDescription:@"Page provided"];
+	__block OCVFSContent *pageContent = nil;
+	__block NSError *pageError = nil;
+
+	[vfsCore provideContentPageForContainerItemID:nil changesFromSyncAnchor:syncAnchor cursor:cursor pageSize:pageSize completionHandler:^(NSError * _Nullable error, OCVFSContent * _Nullable content) {
+		pageContent = content;
+		pageError = error;
+
+		[expectPage fulfill];
+	}];
+
+	[self waitForExpectations:@[ expectPage ] timeout:30];
+
+	if (outError != NULL)
+	{
+		*outError = pageError;
+	}
+
+	return (pageContent);
+}
+
+- (void)testVFSContentPaging
+{
+	XCTestExpectation *expectCore = [self expectationWithDescription:@"Core started"];
+	XCTestExpectation *expectItemsAdded = [self expectationWithDescription:@"Items added"];
+	XCTestExpectation *expectCoreToReturn = [self expectationWithDescription:@"Core returned"];
+	OCBookmark *bookmark = [OCTestTarget userBookmark];
+	NSString *folderPath = [NSString stringWithFormat:@"/VFSPagingTest-%@/", NSUUID.UUID.UUIDString];
+	OCLocation *folderLocation = [[OCLocation alloc] initWithBookmarkUUID:bookmark.uuid driveID:nil path:folderPath];
+	OCVFSCore *vfsCore = [OCVFSCore new];
+	NSMutableArray<NSString *> *expectedNames = [NSMutableArray new];
+	NSMutableArray<NSString *> *pagedNames = [NSMutableArray new];
+	NSMutableArray<OCItem *> *items = [NSMutableArray new];
+	const NSUInteger itemCount = 25, pageSize = 10;
+	__block OCCore *core = nil;
+	OCVFSContent *content;
+	OCVFSContentCursor cursor = nil, secondPageCursor = nil;
+	NSUInteger pageCount = 0;
+	NSError *error = nil;
+
+	// Root node backed by a folder of the account, with one virtual child node
+	[vfsCore setNodes:@[
+		[OCVFSNode virtualFolderAtPath:@"/" location:folderLocation],
+		[OCVFSNode virtualFolderInPath:@"/" withName:@"Virtual" location:nil]
+	]];
+
+	for (NSUInteger i=0; i<itemCount; i++)
+	{
+		OCItem *item = [OCItem new];
+
+		item.type = OCItemTypeFile;
+		item.path = [folderPath stringByAppendingFormat:@"File %02lu.txt", (unsigned long)i];
+		item.localID = NSUUID.UUID.UUIDString;
+
+		[items addObject:item];
+		[expectedNames addObject:item.name];
+	}
+
+	[OCBookmarkManager.sharedBookmarkManager addBookmark:bookmark];
+
+	[OCCoreManager.sharedCoreManager requestCoreForBookmark:bookmark setup:nil completionHandler:^(OCCore * _Nullable requestedCore, NSError * _Nullable error) {
+		XCTAssertNil(error);
+		core = requestedCore;
+
+		[expectCore fulfill];
+
+		[core.vault.database addCacheItems:items syncAnchor:((core.latestSyncAnchor != nil) ? core.latestSyncAnchor : @(0)) completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssertNil(error);
+			[expectItemsAdded fulfill];
+		}];
+	}];
+
+	[self waitForExpectations:@[ expectCore, expectItemsAdded ] timeout:30];
+
+	// Page through the folder, following the cursors
+	do
+	{
+		content = [self _contentPageOfVFSCore:vfsCore changesFromSyncAnchor:nil cursor:cursor pageSize:pageSize error:&error];
+
+		XCTAssertNil(error);
+		XCTAssertNotNil(content);
+		XCTAssert(content.items.count <= pageSize);
+
+		if (pageCount == 0)
+		{
+			// Virtual nodes are only part of the first page
+			XCTAssertEqual(content.vfsChildNodes.count, 1);
+			XCTAssertEqualObjects(content.vfsChildNodes.firstObject.name, @"Virtual");
+		}
+		else
+		{
+			XCTAssertEqual(content.vfsChildNodes.count, 0);
+		}
+
+		if (pageCount == 1)
+		{
+			secondPageCursor = cursor;
+		}
+
+		[pagedNames addObjectsFromArray:[content.items valueForKeyPath:@"name"]];
+		pageCount++;
+
+		cursor = content.nextCursor;
+	} while ((cursor != nil) && (pageCount < 10));
+
+	// All items were returned exactly once, in order - and the last page has no cursor
+	XCTAssertEqual(pageCount, 3);
+	XCTAssertEqualObjects(pagedNames, expectedNames);
+	XCTAssertNil(content.nextCursor);
+	XCTAssertEqual(content.items.count, itemCount - (2 * pageSize));
+
+	// Cursors can be reused and return the same page
+	content = [self _contentPageOfVFSCore:vfsCore changesFromSyncAnchor:nil cursor:secondPageCursor pageSize:pageSize error:&error];
+	XCTAssertNil(error);
+	XCTAssertEqualObjects([content.items valueForKeyPath:@"name"], [expectedNames subarrayWithRange:NSMakeRange(pageSize, pageSize)]);
+	XCTAssertNotNil(content.nextCursor);
+
+	// Invalid cursors are rejected
+	content = [self _contentPageOfVFSCore:vfsCore changesFromSyncAnchor:nil cursor:[@"not a cursor" dataUsingEncoding:NSUTF8StringEncoding] pageSize:pageSize error:&error];
+	XCTAssertNil(content);
+	XCTAssert([error isOCErrorWithCode:OCErrorInvalidParameter]);
+
+	// Container cursors can't be used to page through changes
+	content = [self _contentPageOfVFSCore:vfsCore changesFromSyncAnchor:@(0) cursor:secondPageCursor pageSize:pageSize error:&error];
+	XCTAssertNil(content);
+	XCTAssert([error isOCErrorWithCode:OCErrorInvalidParameter]);
+
+	[OCCoreManager.sharedCoreManager returnCoreForBookmark:bookmark completionHandler:^{
+		[expectCoreToReturn fulfill];
+	}];
+
+	[self waitForExpectations:@[ expectCoreToReturn ] timeout:30];
+
+	[OCBookmarkManager.sharedBookmarkManager removeBookmark:bookmark];
+}
+
 @end
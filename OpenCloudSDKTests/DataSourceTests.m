@@ -266,6 +266,373 @@ OCDataItemType DataTypeE = @"E";
 	XCTAssert( ([snapshot.removedItems isEqual:[NSSet set]]) );
 }
 
+- (void)testDataSourceChangeSetComputation
+{
+	for (NSUInteger iteration=0; iteration < 200; iteration++)
+	{
+		NSMutableArray<OCDataItemReference> *oldItemRefs = [NSMutableArray new];
+		NSMutableArray<OCDataItemReference> *newItemRefs = [NSMutableArray new];
+		NSMutableArray<OCDataItemReference> *appliedItemRefs;
+		OCDataSourceChangeSet *changeSet;
+
+		// Random old and new contents with some overlap and random order
+		for (NSUInteger i=0; i < 50; i++)
+		{
+			NSString *itemRef = @(i).stringValue;
+
+			if (arc4random_uniform(4) != 0) { [oldItemRefs addObject:itemRef]; }
+			if (arc4random_uniform(4) != 0) { [newItemRefs addObject:itemRef]; }
+		}
+
+		for (NSUInteger i=newItemRefs.count; i > 1; i--)
+		{
+			if (arc4random_uniform(5) == 0)
+			{
+				[newItemRefs exchangeObjectAtIndex:i-1 withObjectAtIndex:arc4random_uniform((uint32_t)i)];
+			}
+		}
+
+		changeSet = [OCDataSourceChangeSet changeSetFromItemReferences:oldItemRefs toItemReferences:newItemRefs updated:nil];
+		XCTAssert(changeSet != nil);
+
+		appliedItemRefs = [oldItemRefs mutableCopy];
+		XCTAssert([changeSet applyToItemReferences:appliedItemRefs]);
+		XCTAssert([appliedItemRefs isEqual:newItemRefs], @"%@ applied to %@ = %@ != %@", changeSet, oldItemRefs, appliedItemRefs, newItemRefs);
+
+		// Offsetting
+		appliedItemRefs = [oldItemRefs mutableCopy];
+		[appliedItemRefs insertObjects:@[ @"x", @"y" ] atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)]];
+		XCTAssert([[changeSet changeSetByOffsettingIndexesBy:2] applyToItemReferences:appliedItemRefs]);
+		XCTAssert([[appliedItemRefs subarrayWithRange:NSMakeRange(2, appliedItemRefs.count-2)] isEqual:newItemRefs]);
+	}
+
+	// Moving a single item is expressed as a single move
+	OCDataSourceChangeSet *changeSet = [OCDataSourceChangeSet changeSetFromItemReferences:@[@"a", @"b", @"c", @"d"] toItemReferences:@[@"b", @"c", @"d", @"a"] updated:[NSSet setWithObjects:@"b", @"f", nil]];
+	XCTAssert(changeSet.moves.count == 1);
+	XCTAssert([changeSet.moves.firstObject.itemRef isEqual:@"a"] && (changeSet.moves.firstObject.fromIndex == 0) && (changeSet.moves.firstObject.toIndex == 3));
+	XCTAssert((changeSet.deletedIndexes.count == 0) && (changeSet.insertedIndexes.count == 0));
+	XCTAssert([changeSet.updatedItemRefs isEqual:[NSSet setWithObject:@"b"]]);
+
+	// Change sets not matching the number of items are rejected
+	NSMutableArray<OCDataItemReference> *itemRefs = [@[ @"a" ] mutableCopy];
+	XCTAssert(![changeSet applyToItemReferences:itemRefs]);
+	XCTAssert([itemRefs isEqual:@[ @"a" ]]);
+
+	// Duplicates
+	XCTAssert([OCDataSourceChangeSet changeSetFromItemReferences:@[@"a", @"a"] toItemReferences:@[@"a"] updated:nil] == nil);
+}
+
+- (void)testDataSourceSnapshotChangeSets
+{
+	OCDataSource *source = [OCDataSource new];
+	OCDataSourceSnapshot *snapshot;
+	NSMutableArray<OCDataItemReference> *itemRefs;
+
+	[source setItemReferences:@[@"a", @"b", @"c"] updated:nil];
+
+	OCDataSourceSubscription *subscription = [source subscribeWithUpdateHandler:^(OCDataSourceSubscription * _Nonnull subscription) {
+	} onQueue:nil trackDifferences:YES performInitialUpdate:NO];
+
+	// The first snapshot can't provide change sets
+	snapshot = [subscription snapshotResettingChangeTracking:YES];
+	XCTAssert(snapshot.changeSets == nil);
+	itemRefs = [snapshot.items mutableCopy];
+
+	// Subsequent changes are provided as change sets that transform the previous snapshot's items into the current ones
+	[source setItemReferences:@[@"c", @"a", @"b", @"d"] updated:[NSSet setWithObject:@"a"]];
+	[source applyChangeSet:[[OCDataSourceChangeSet alloc] initWithDeletedIndexes:[NSIndexSet indexSetWithIndex:1] itemRefs:@[ @"a" ] insertedIndexes:[NSIndexSet indexSetWithIndex:0] itemRefs:@[ @"e" ] moves:nil updated:nil]];
+	XCTAssert(![source applyChangeSet:[[OCDataSourceChangeSet alloc] initWithDeletedIndexes:[NSIndexSet indexSetWithIndex:10] itemRefs:@[ @"x" ] insertedIndexes:nil itemRefs:nil moves:nil updated:nil]]);
+
+	snapshot = [subscription snapshotResettingChangeTracking:YES];
+	XCTAssert( ([snapshot.items isEqual:@[ @"e", @"c", @"b", @"d" ] ]) );
+	XCTAssert( ([snapshot.addedItems isEqual:[NSSet setWithObjects:@"d", @"e", nil]]) );
+	XCTAssert( ([snapshot.updatedItems isEqual:[NSSet set]]) );
+	XCTAssert( ([snapshot.removedItems isEqual:[NSSet setWithObject:@"a"]]) );
+	XCTAssert(snapshot.changeSets.count == 2);
+
+	for (OCDataSourceChangeSet *changeSet in snapshot.changeSets)
+	{
+		XCTAssert([changeSet applyToItemReferences:itemRefs]);
+	}
+
+	XCTAssert([itemRefs isEqual:snapshot.items]);
+
+	[subscription terminate];
+}
+
+- (void)testDataSourceMappedChangeSetApplication
+{
+	OCDataSourceArray *source = [[OCDataSourceArray alloc] initWithItems:nil];
+	NSMutableArray<OCDataItemReference> *destroyedItemRefs = [NSMutableArray new];
+	NSMutableArray<OCDataItemReference> *itemRefs;
+	OCDataSourceSnapshot *snapshot;
+
+	OCDataItemPresentable *(^presentable)(NSString *, NSString *) = ^(NSString *itemRef, NSString *title) {
+		OCDataItemPresentable *presentable = [[OCDataItemPresentable alloc] initWithReference:itemRef originalDataItemType:nil version:nil];
+		presentable.title = title;
+		return (presentable);
+	};
+
+	OCDataItemPresentable *itemA = presentable(@"a", @"A"), *itemB = presentable(@"b", @"B"), *itemC = presentable(@"c", @"C"), *itemD = presentable(@"d", @"D");
+
+	[source setItems:@[ itemA, itemB, itemC ] updated:nil];
+
+	OCDataSourceMapped *mappedSource = [[OCDataSourceMapped alloc] initWithSource:source creator:^id<OCDataItem> _Nullable(OCDataSourceMapped * _Nonnull mappedSource, id<OCDataItem>  _Nonnull fromItem) {
+		return (presentable([@"m-" stringByAppendingString:(NSString *)fromItem.dataItemReference], ((OCDataItemPresentable *)fromItem).title));
+	} updater:^id<OCDataItem> _Nonnull(OCDataSourceMapped * _Nonnull mappedSource, id<OCDataItem>  _Nonnull fromItem, id<OCDataItem>  _Nonnull mappedItem) {
+		((OCDataItemPresentable *)mappedItem).title = ((OCDataItemPresentable *)fromItem).title;
+		return (mappedItem);
+	} destroyer:^(OCDataSourceMapped * _Nonnull mappedSource, OCDataItemReference  _Nonnull fromItemReference, id<OCDataItem>  _Nonnull mappedItem) {
+		[destroyedItemRefs addObject:fromItemReference];
+	} queue:nil];
+
+	OCDataSourceSubscription *subscription = [mappedSource subscribeWithUpdateHandler:^(OCDataSourceSubscription * _Nonnull subscription) {
+	} onQueue:nil trackDifferences:YES performInitialUpdate:NO];
+
+	snapshot = [subscription snapshotResettingChangeTracking:YES];
+	XCTAssert( ([snapshot.items isEqual:@[ @"m-a", @"m-b", @"m-c" ] ]) );
+	itemRefs = [snapshot.items mutableCopy];
+
+	// Insert
+	[source setItems:@[ itemA, itemD, itemB, itemC ] updated:nil];
+
+	// Move
+	[source setItems:@[ itemD, itemB, itemC, itemA ] updated:nil];
+
+	snapshot = [subscription snapshotResettingChangeTracking:YES];
+	XCTAssert( ([snapshot.items isEqual:@[ @"m-d", @"m-b", @"m-c", @"m-a" ] ]) );
+	XCTAssert( ([snapshot.addedItems isEqual:[NSSet setWithObject:@"m-d"]]) );
+	XCTAssert(snapshot.changeSets.count > 0);
+
+	for (OCDataSourceChangeSet *changeSet in snapshot.changeSets)
+	{
+		XCTAssert([changeSet applyToItemReferences:itemRefs]);
+	}
+	XCTAssert([itemRefs isEqual:snapshot.items]);
+
+	// Update
+	OCDataItemPresentable *updatedItemB = presentable(@"b", @"B2");
+
+	[source setItems:@[ itemD, updatedItemB, itemC, itemA ] updated:[NSSet setWithObject:updatedItemB]];
+
+	snapshot = [subscription snapshotResettingChangeTracking:YES];
+	XCTAssert( ([snapshot.items isEqual:@[ @"m-d", @"m-b", @"m-c", @"m-a" ] ]) );
+	XCTAssert( ([snapshot.updatedItems isEqual:[NSSet setWithObject:@"m-b"]]) );
+	XCTAssert( ([((OCDataItemPresentable *)[mappedSource recordForItemRef:@"m-b" error:NULL].item).title isEqual:@"B2"]) );
+
+	for (OCDataSourceChangeSet *changeSet in snapshot.changeSets)
+	{
+		XCTAssert([changeSet applyToItemReferences:itemRefs]);
+	}
+	XCTAssert([itemRefs isEqual:snapshot.items]);
+
+	// Remove
+	[source setItems:@[ itemD, updatedItemB, itemA ] updated:nil];
+
+	snapshot = [subscription snapshotResettingChangeTracking:YES];
+	XCTAssert( ([snapshot.items isEqual:@[ @"m-d", @"m-b", @"m-a" ] ]) );
+	XCTAssert( ([snapshot.removedItems isEqual:[NSSet setWithObject:@"m-c"]]) );
+	XCTAssert( ([destroyedItemRefs isEqual:@[ @"c" ]]) );
+
+	for (OCDataSourceChangeSet *changeSet in snapshot.changeSets)
+	{
+		XCTAssert([changeSet applyToItemReferences:itemRefs]);
+	}
+	XCTAssert([itemRefs isEqual:snapshot.items]);
+
+	[subscription terminate];
+}
+
+- (void)testDataSourceCompositionChangeSetApplication
+{
+	OCDataSource *source1 = [OCDataSource new];
+	OCDataSource *source2 = [OCDataSource new];
+	__block NSMutableArray<OCDataItemReference> *itemRefs = nil;
+	NSMutableSet<OCDataItemReference> *updatedItemRefs = [NSMutableSet new];
+	__block BOOL(^condition)(void) = nil;
+	__block XCTestExpectation *expectation = nil;
+
+	[source1 setItemReferences:@[ @"a1", @"a2" ] updated:nil];
+	[source2 setItemReferences:@[ @"b1", @"b2", @"b3" ] updated:nil];
+
+	OCDataSourceComposition *composition = [[OCDataSourceComposition alloc] initWithSources:@[ source1, source2 ] applyCustomizations:nil];
+
+	// Without filter and sort comparator, source changes are applied to the composition as offset change sets
+	OCDataSourceSubscription *subscription = [composition subscribeWithUpdateHandler:^(OCDataSourceSubscription * _Nonnull subscription) {
+		OCDataSourceSnapshot *snapshot = [subscription snapshotResettingChangeTracking:YES];
+
+		if (itemRefs == nil)
+		{
+			itemRefs = [snapshot.items mutableCopy];
+		}
+		else
+		{
+			XCTAssert(snapshot.changeSets != nil);
+
+			for (OCDataSourceChangeSet *changeSet in snapshot.changeSets)
+			{
+				XCTAssert([changeSet applyToItemReferences:itemRefs]);
+			}
+
+			XCTAssert([itemRefs isEqual:snapshot.items], @"%@ != %@", itemRefs, snapshot.items);
+		}
+
+		[updatedItemRefs unionSet:snapshot.updatedItems];
+
+		if ((expectation != nil) && condition())
+		{
+			[expectation fulfill];
+			expectation = nil;
+		}
+	} onQueue:dispatch_get_main_queue() trackDifferences:YES performInitialUpdate:YES];
+
+	void(^waitFor)(NSString *, BOOL(^)(void)) = ^(NSString *description, BOOL(^waitCondition)(void)) {
+		condition = waitCondition;
+		expectation = [self expectationWithDescription:description];
+
+		[self waitForExpectationsWithTimeout:10 handler:nil];
+	};
+
+	waitFor(@"Initial composition", ^{
+		return ([itemRefs isEqual:@[ @"a1", @"a2", @"b1", @"b2", @"b3" ]]);
+	});
+
+	// Insert
+	[source1 setItemReferences:@[ @"a0", @"a1", @"a2" ] updated:nil];
+
+	waitFor(@"Insert", ^{
+		return ([itemRefs isEqual:@[ @"a0", @"a1", @"a2", @"b1", @"b2", @"b3" ]]);
+	});
+
+	// Move
+	[source2 setItemReferences:@[ @"b2", @"b3", @"b1" ] updated:nil];
+
+	waitFor(@"Move", ^{
+		return ([itemRefs isEqual:@[ @"a0", @"a1", @"a2", @"b2", @"b3", @"b1" ]]);
+	});
+
+	// Update
+	[source1 setItemReferences:@[ @"a0", @"a1", @"a2" ] updated:[NSSet setWithObject:@"a1"]];
+
+	waitFor(@"Update", ^{
+		return ([updatedItemRefs containsObject:@"a1"]);
+	});
+
+	XCTAssert( ([itemRefs isEqual:@[ @"a0", @"a1", @"a2", @"b2", @"b3", @"b1" ]]) );
+
+	// Remove
+	[source1 setItemReferences:@[ @"a0", @"a2" ] updated:nil];
+	[source2 setItemReferences:@[ @"b2", @"b1" ] updated:nil];
+
+	waitFor(@"Remove", ^{
+		return ([itemRefs isEqual:@[ @"a0", @"a2", @"b2", @"b1" ]]);
+	});
+
+	XCTAssert([composition dataSourceForItemReference:@"a2"] == source1);
+	XCTAssert([composition dataSourceForItemReference:@"b2"] == source2);
+
+	[subscription terminate];
+}
+
+- (NSArray<OCDataItemReference> *)_composeSources:(NSArray<OCDataSource *> *)sources concurrently:(BOOL)concurrently expectedCount:(NSUInteger)expectedCount
+{
+	XCTestExpectation *compositionExpectation = [self expectationWithDescription:@"Composition complete"];
+	__block NSArray<OCDataItemReference> *composedItems = nil;
+	__block BOOL comparatorPassedComposition = YES;
+
+	OCDataSourceComposition *composition = [[OCDataSourceComposition alloc] initWithSources:sources applyCustomizations:^(OCDataSourceComposition *composition) {
+		__weak OCDataSourceComposition *weakComposition = composition;
+
+		composition.allowsConcurrentProcessing = concurrently;
+
+		// Drop every third item
+		composition.filter = ^BOOL(OCDataSource *source, OCDataItemReference itemRef) {
+			return (([(NSString *)itemRef substringFromIndex:2].integerValue % 3) != 0);
+		};
+
+		// Sort by item number, ignoring the source prefix
+		composition.sortComparator = ^NSComparisonResult(OCDataSource *source1, OCDataItemReference itemRef1, OCDataSource *source2, OCDataItemReference itemRef2) {
+			if ((source1 != weakComposition) || (source2 != weakComposition))
+			{
+				comparatorPassedComposition = NO;
+			}
+
+			return ([[(NSString *)itemRef1 substringFromIndex:2] compare:[(NSString *)itemRef2 substringFromIndex:2]]);
+		};
+	}];
+
+	OCDataSourceSubscription *subscription = [composition subscribeWithUpdateHandler:^(OCDataSourceSubscription * _Nonnull subscription) {
+		OCDataSourceSnapshot *snapshot = [subscription snapshotResettingChangeTracking:YES];
+
+		if ((composedItems == nil) && (snapshot.items.count == expectedCount))
+		{
+			composedItems = snapshot.items;
+			[compositionExpectation fulfill];
+		}
+	} onQueue:nil trackDifferences:NO performInitialUpdate:YES];
+
+	[self waitForExpectationsWithTimeout:60 handler:nil];
+
+	[subscription terminate];
+
+	// Sort comparators are passed the composition, regardless of concurrent processing
+	XCTAssert(comparatorPassedComposition);
+
+	return (composedItems);
+}
+
+- (void)testDataSourceCompositionPerformanceWith10SourcesOf10kItems
+{
+	NSMutableArray<OCDataSource *> *sources = [NSMutableArray new];
+	NSMutableArray<OCDataItemReference> *expectedItems = [NSMutableArray new];
+	NSUInteger sourceCount = 10, itemsPerSource = 10000;
+
+	for (NSUInteger sourceIdx=0; sourceIdx<sourceCount; sourceIdx++)
+	{
+		NSMutableArray<OCDataItemReference> *itemRefs = [NSMutableArray new];
+		OCDataSource *source = [OCDataSource new];
+
+		for (NSUInteger itemIdx=0; itemIdx<itemsPerSource; itemIdx++)
+		{
+			[itemRefs addObject:[NSString stringWithFormat:@"%lu-%05lu", (unsigned long)sourceIdx, (unsigned long)((itemIdx * 7919) % itemsPerSource)]];
+		}
+
+		[source setItemReferences:itemRefs updated:nil];
+		[sources addObject:source];
+	}
+
+	// Items with equal sort order are expected in the order of their sources
+	for (NSUInteger itemIdx=0; itemIdx<itemsPerSource; itemIdx++)
+	{
+		if ((itemIdx % 3) != 0)
+		{
+			for (NSUInteger sourceIdx=0; sourceIdx<sourceCount; sourceIdx++)
+			{
+				[expectedItems addObject:[NSString stringWithFormat:@"%lu-%05lu", (unsigned long)sourceIdx, (unsigned long)itemIdx]];
+			}
+		}
+	}
+
+	// Sequential composition
+	NSTimeInterval startTime = NSDate.timeIntervalSinceReferenceDate;
+	NSArray<OCDataItemReference> *sequentialItems = [self _composeSources:sources concurrently:NO expectedCount:expectedItems.count];
+	NSTimeInterval sequentialDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	XCTAssert([sequentialItems isEqual:expectedItems]);
+
+	// Concurrent composition
+	__block NSArray<OCDataItemReference> *concurrentItems = nil;
+
+	[self measureBlock:^{
+		concurrentItems = [self _composeSources:sources concurrently:YES expectedCount:expectedItems.count];
+	}];
+
+	OCLog(@"10 sources x 10k items: sequential composition took %.04f sec", sequentialDuration);
+
+	// Concurrent processing yields the same, deterministic result
+	XCTAssert([concurrentItems isEqual:expectedItems]);
+}
+
 - (void)testDataConverterAssembly
 {
 	OCDataRenderer *renderer = [[OCDataRenderer alloc] initWithConverters:@[
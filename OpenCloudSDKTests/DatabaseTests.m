@@ -8,6 +8,9 @@
 
 #import <XCTest/XCTest.h>
 #import <OpenCloudSDK/OpenCloudSDK.h>
+#import "OCSyncLane.h"
+#import "OCSyncActionDelete.h"
+#import "OCVFSIndex.h"
 
 
 @interface DatabaseTests : XCTestCase
@@ -405,4 +408,532 @@
 	XCTAssert((preparationCalls==2));
 }
 
+- (void)testBulkLaneAssignment
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	XCTestExpectation *vaultEraseExpectation = [self expectationWithDescription:@"Vault erased"];
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		NSMutableArray<NSSet<OCSyncLaneTag> *> *tagSets = [NSMutableArray new];
+		NSArray *lanes;
+		BOOL updatedLanes = NO;
+
+		// 3,000 deletions in 30 folders, plus a deletion of a subfolder of the first folder
+		for (NSUInteger i=0; i<3000; i++)
+		{
+			[tagSets addObject:[NSSet setWithObject:[NSString stringWithFormat:@"/Folder %lu/", i % 30]]];
+		}
+		[tagSets addObject:[NSSet setWithObject:@"/Folder 0/Subfolder/"]];
+
+		NSTimeInterval startTime = NSDate.timeIntervalSinceReferenceDate;
+		lanes = [database lanesForTagSets:tagSets updatedLanes:&updatedLanes];
+		OCLog(@"Assigned lanes for %lu records in %.04f sec", tagSets.count, NSDate.timeIntervalSinceReferenceDate - startTime);
+
+		XCTAssert(updatedLanes);
+		XCTAssert(lanes.count == tagSets.count);
+		XCTAssert([NSSet setWithArray:lanes].count == 31);
+
+		// Identical tag sets share a lane
+		XCTAssert(lanes[0] == lanes[30]);
+		XCTAssert(lanes[0] != lanes[1]);
+
+		// Overlapping tag sets get a dependent lane
+		OCSyncLane *subfolderLane = lanes.lastObject;
+		XCTAssert([subfolderLane.afterLanes containsObject:((OCSyncLane *)lanes[0]).identifier]);
+
+		// Single lookups find the lanes created in bulk
+		XCTAssert([[database laneForTags:tagSets[1] updatedLanes:&updatedLanes readOnly:YES].identifier isEqual:((OCSyncLane *)lanes[1]).identifier]);
+
+		[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+			[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+				[vaultEraseExpectation fulfill];
+			}];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+- (void)testBulkSyncRecordEnqueuePerformance
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	NSUInteger recordCount = 2000;
+	NSTimeInterval perRecordDuration, bulkDuration, startTime;
+
+	NSArray<OCSyncRecord *> *(^CreateDeleteRecords)(void) = ^{
+		NSMutableArray<OCSyncRecord *> *records = [NSMutableArray new];
+
+		for (NSUInteger i=0; i<recordCount; i++)
+		{
+			OCItem *item = [OCItem new];
+
+			item.type = OCItemTypeFile;
+			item.path = [NSString stringWithFormat:@"/Folder %lu/File %lu.jpg", i % 20, i];
+			item.localID = NSUUID.UUID.UUIDString;
+
+			[records addObject:[[OCSyncRecord alloc] initWithAction:[[OCSyncActionDelete alloc] initWithItem:item requireMatch:YES] resultSignalUUID:nil]];
+		}
+
+		return (records);
+	};
+
+	OCSyncExec(waitForOpen, {
+		[vault openWithCompletionHandler:^(id sender, NSError *error) {
+			XCTAssertNil(error);
+			OCSyncExecDone(waitForOpen);
+		}];
+	});
+
+	// Per record (as -submitSyncRecord: does): insert, lane lookup and update for every record
+	NSArray<OCSyncRecord *> *perRecordRecords = CreateDeleteRecords();
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+
+	for (OCSyncRecord *record in perRecordRecords)
+	{
+		BOOL updatedLanes = NO;
+
+		OCSyncExec(waitForAdd, {
+			[database addSyncRecords:@[ record ] completionHandler:^(OCDatabase *db, NSError *error) {
+				OCSyncExecDone(waitForAdd);
+			}];
+		});
+
+		record.laneID = [database laneForTags:record.laneTags updatedLanes:&updatedLanes readOnly:NO].identifier;
+
+		OCSyncExec(waitForUpdate, {
+			[database updateSyncRecords:@[ record ] completionHandler:^(OCDatabase *db, NSError *error) {
+				OCSyncExecDone(waitForUpdate);
+			}];
+		});
+	}
+
+	perRecordDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	// Bulk (as -submitSyncRecords: does): one insert transaction, one lane assignment pass, one update transaction
+	NSArray<OCSyncRecord *> *bulkRecords = CreateDeleteRecords();
+	NSMutableArray<NSSet<OCSyncLaneTag> *> *tagSets = [NSMutableArray new];
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+
+	OCSyncExec(waitForBulkAdd, {
+		[database addSyncRecords:bulkRecords completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssertNil(error);
+			OCSyncExecDone(waitForBulkAdd);
+		}];
+	});
+
+	for (OCSyncRecord *record in bulkRecords)
+	{
+		[tagSets addObject:record.laneTags];
+	}
+
+	BOOL updatedLanes = NO;
+	NSArray *lanes = [database lanesForTagSets:tagSets updatedLanes:&updatedLanes];
+
+	[lanes enumerateObjectsUsingBlock:^(id lane, NSUInteger idx, BOOL * _Nonnull stop) {
+		bulkRecords[idx].laneID = OCTypedCast(lane, OCSyncLane).identifier;
+	}];
+
+	OCSyncExec(waitForBulkUpdate, {
+		[database updateSyncRecords:bulkRecords completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssertNil(error);
+			OCSyncExecDone(waitForBulkUpdate);
+		}];
+	});
+
+	bulkDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	OCLog(@"Enqueueing %lu sync records: per record %.04f sec (%.1f µs/record), bulk %.04f sec (%.1f µs/record)", recordCount, perRecordDuration, (perRecordDuration * 1000000.0 / recordCount), bulkDuration, (bulkDuration * 1000000.0 / recordCount));
+
+	XCTAssert(bulkRecords.lastObject.recordID != nil);
+	XCTAssert(bulkRecords.lastObject.laneID != nil);
+	XCTAssert(bulkDuration < perRecordDuration, @"Bulk enqueueing (%.04f sec) not faster than per-record enqueueing (%.04f sec)", bulkDuration, perRecordDuration);
+
+	OCSyncExec(waitForErase, {
+		[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+			[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+				OCSyncExecDone(waitForErase);
+			}];
+		}];
+	});
+}
+
+- (void)testPrefetchedItemLists
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	NSMutableDictionary<OCLocationString, NSArray<OCItem *> *> *itemListsByLocationString = [NSMutableDictionary new];
+	NSUInteger remainingCount = 0;
+	NSArray<OCItem *> *items;
+
+	NSArray<OCItem *> *(^CreateItemList)(OCPath folderPath, NSUInteger fileCount) = ^(OCPath folderPath, NSUInteger fileCount) {
+		NSMutableArray<OCItem *> *items = [NSMutableArray new];
+		OCItem *folderItem = [OCItem new];
+
+		folderItem.type = OCItemTypeCollection;
+		folderItem.path = folderPath;
+		[items addObject:folderItem];
+
+		for (NSUInteger i=0; i<fileCount; i++)
+		{
+			OCItem *fileItem = [OCItem new];
+
+			fileItem.type = OCItemTypeFile;
+			fileItem.path = [folderPath stringByAppendingFormat:@"file%lu.txt", (unsigned long)i];
+			[items addObject:fileItem];
+		}
+
+		return (items);
+	};
+
+	OCLocation *location1 = [[OCLocation alloc] initWithDriveID:nil path:@"/Folder 1/"];
+	OCLocation *location2 = [[OCLocation alloc] initWithDriveID:nil path:@"/Folder 2/"];
+	OCLocation *location3 = [[OCLocation alloc] initWithDriveID:nil path:@"/Folder 3/"];
+
+	OCSyncExec(waitForOpen, {
+		[vault openWithCompletionHandler:^(id sender, NSError *error) {
+			XCTAssertNil(error);
+			OCSyncExecDone(waitForOpen);
+		}];
+	});
+
+	// Store two lists in one batch and one in another
+	itemListsByLocationString[location1.string] = CreateItemList(location1.path, 3);
+	itemListsByLocationString[location2.string] = CreateItemList(location2.path, 2);
+
+	OCSyncExec(waitForAdd, {
+		[database addPrefetchedItemLists:itemListsByLocationString retrievalID:@"retrieval1" lifetime:60 completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssertNil(error);
+			OCSyncExecDone(waitForAdd);
+		}];
+	});
+
+	OCSyncExec(waitForAdd2, {
+		[database addPrefetchedItemLists:@{ location3.string : CreateItemList(location3.path, 1) } retrievalID:@"retrieval2" lifetime:60 completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssertNil(error);
+			OCSyncExecDone(waitForAdd2);
+		}];
+	});
+
+	// Consume returns the list (in order) exactly once
+	items = [database consumePrefetchedItemListForLocationString:location1.string lifetime:60 remainingCount:&remainingCount];
+	XCTAssertEqual(items.count, 4);
+	XCTAssertEqualObjects(items.firstObject.path, location1.path);
+	XCTAssertEqualObjects(items.lastObject.path, @"/Folder 1/file2.txt");
+	XCTAssertEqual(remainingCount, 2);
+
+	items = [database consumePrefetchedItemListForLocationString:location1.string lifetime:60 remainingCount:&remainingCount];
+	XCTAssertNil(items);
+	XCTAssertEqual(remainingCount, 2);
+
+	// Removing the lists of a retrieval leaves those of other retrievals untouched
+	OCSyncExec(waitForRemoval, {
+		[database removePrefetchedItemListsForRetrievalID:@"retrieval1" completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssertNil(error);
+			OCSyncExecDone(waitForRemoval);
+		}];
+	});
+
+	XCTAssertNil([database consumePrefetchedItemListForLocationString:location2.string lifetime:60 remainingCount:&remainingCount]);
+	XCTAssertEqual(remainingCount, 1);
+
+	// Expired lists are discarded
+	OCSyncExec(waitForExpiringAdd, {
+		[database addPrefetchedItemLists:@{ location3.string : CreateItemList(location3.path, 1) } retrievalID:@"retrieval3" lifetime:-1 completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssertNil(error);
+			OCSyncExecDone(waitForExpiringAdd);
+		}];
+	});
+
+	XCTAssertNil([database consumePrefetchedItemListForLocationString:location3.string lifetime:60 remainingCount:&remainingCount]);
+	XCTAssertEqual(remainingCount, 0);
+
+	OCSyncExec(waitForErase, {
+		[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+			[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+				OCSyncExecDone(waitForErase);
+			}];
+		}];
+	});
+}
+
+- (void)testWindowedDataSource
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	XCTestExpectation *vaultEraseExpectation = [self expectationWithDescription:@"Vault erased"];
+	NSUInteger itemCount = 10000;
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		NSMutableArray<OCItem *> *items = [NSMutableArray new];
+
+		// Add items in non-sorted order
+		for (NSUInteger i=0; i<itemCount; i++)
+		{
+			OCItem *item = [OCItem new];
+
+			item.type = OCItemTypeFile;
+			item.path = [NSString stringWithFormat:@"/Big/File %05lu.txt", (unsigned long)((i * 7919) % itemCount)];
+			item.localID = NSUUID.UUID.UUIDString;
+
+			[items addObject:item];
+		}
+
+		[database addCacheItems:items syncAnchor:@(1) completionHandler:^(OCDatabase *db, NSError *error) {
+			OCDataSourceDatabaseWindow *dataSource = [[OCDataSourceDatabaseWindow alloc] initWithDatabase:database location:[OCLocation legacyRootPath:@"/Big/"] queryCondition:nil sortedBy:OCItemPropertyNameName ascending:YES];
+
+			XCTAssert(error == nil);
+			XCTAssertNil([[OCDataSourceDatabaseWindow alloc] initWithDatabase:database location:[OCLocation legacyRootPath:@"/Big/"] queryCondition:nil sortedBy:OCItemPropertyNameMIMEType ascending:YES]); // not backed by an index
+
+			[dataSource setWindow:NSMakeRange(5000, 50) completionHandler:nil];
+
+			[dataSource reloadWithCompletionHandler:^(NSError * _Nullable error) {
+				XCTAssert(error == nil);
+				XCTAssert(dataSource.numberOfItems == itemCount);
+
+				// Only the window and its prefetch margins are materialized
+				XCTAssert(dataSource.numberOfMaterializedItems == 150, @"%lu materialized", (unsigned long)dataSource.numberOfMaterializedItems);
+
+				[dataSource subscribeWithUpdateHandler:^(OCDataSourceSubscription * _Nonnull subscription) {
+					OCDataSourceSnapshot *snapshot = [subscription snapshotResettingChangeTracking:YES];
+					OCDataItemRecord *record = [dataSource recordForItemRef:snapshot.items[5000] error:NULL];
+
+					XCTAssert(snapshot.items.count == itemCount);
+					XCTAssert([((OCItem *)record.item).name isEqual:@"File 05000.txt"]);
+
+					[subscription terminate];
+
+					// Moving the window evicts off-window items
+					[dataSource setWindow:NSMakeRange(0, 50) completionHandler:^(NSError * _Nullable error) {
+						XCTAssert(dataSource.numberOfMaterializedItems == 100, @"%lu materialized", (unsigned long)dataSource.numberOfMaterializedItems);
+
+						// Off-window items can still be retrieved
+						[dataSource retrieveItemForRef:snapshot.items.lastObject reusingRecord:nil completionHandler:^(NSError * _Nullable error, OCDataItemRecord * _Nullable record) {
+							XCTAssert([((OCItem *)record.item).name isEqual:@"File 09999.txt"]);
+							XCTAssert(dataSource.numberOfMaterializedItems == 100);
+
+							[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+								[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+									[vaultEraseExpectation fulfill];
+								}];
+							}];
+						}];
+					}];
+				} onQueue:nil trackDifferences:NO performInitialUpdate:YES];
+			}];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:60 handler:nil];
+}
+
+- (void)testSortedQueryConditionRetrieval
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	XCTestExpectation *vaultEraseExpectation = [self expectationWithDescription:@"Vault erased"];
+	NSArray<NSString *> *names = @[ @"File 10.txt", @"file 3.txt", @"File 2.txt", @"Apple.txt", @"zebra.txt", @"File 1.txt" ];
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		NSMutableArray<OCItem *> *items = [NSMutableArray new];
+		NSUInteger size = 0;
+
+		for (NSString *name in names)
+		{
+			OCItem *item = [OCItem new];
+
+			item.type = OCItemTypeFile;
+			item.path = [@"/Sorted/" stringByAppendingString:name];
+			item.localID = NSUUID.UUID.UUIDString;
+			item.size = ((size++) % 3) * 100; // include items of identical size
+
+			[items addObject:item];
+		}
+
+		[database addCacheItems:items syncAnchor:@(1) completionHandler:^(OCDatabase *db, NSError *error) {
+			OCQueryCondition *condition = [OCQueryCondition where:OCItemPropertyNameParentPath isEqualTo:@"/Sorted/"];
+			OCQuerySortDescriptor *nameDescriptor = [OCQuerySortDescriptor sortDescriptorWithPropertyName:OCItemPropertyNameName ascending:YES];
+			OCQuerySortDescriptor *sizeDescriptor = [OCQuerySortDescriptor sortDescriptorWithPropertyName:OCItemPropertyNameSize ascending:NO];
+
+			XCTAssert(error == nil);
+			XCTAssert(nameDescriptor.isDatabaseBacked);
+			XCTAssert(![OCQuerySortDescriptor sortDescriptorWithPropertyName:OCItemPropertyNameMIMEType ascending:YES].isDatabaseBacked);
+
+			// Localized collation
+			[database retrieveCacheItemsForQueryCondition:condition sortedBy:nameDescriptor.propertyName ascending:nameDescriptor.ascending cancelAction:nil completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+				NSArray<NSString *> *expectedNames = @[ @"Apple.txt", @"File 1.txt", @"File 2.txt", @"file 3.txt", @"File 10.txt", @"zebra.txt" ];
+
+				XCTAssert(error == nil);
+				XCTAssert([[items valueForKeyPath:@"name"] isEqual:expectedNames], @"%@", [items valueForKeyPath:@"name"]);
+
+				// The in-memory comparator produces the same order as the database
+				XCTAssert([[items sortedArrayUsingComparator:nameDescriptor.comparator] isEqual:items]);
+			}];
+
+			// Ties and a condition with its own sort order and limit
+			[database retrieveCacheItemsForQueryCondition:[[condition sortedBy:OCItemPropertyNameName ascending:YES] limitedToMaxResultCount:4] sortedBy:sizeDescriptor.propertyName ascending:sizeDescriptor.ascending cancelAction:nil completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+				XCTAssert(error == nil);
+				XCTAssert(items.count == 4);
+				XCTAssert([[items sortedArrayUsingComparator:sizeDescriptor.comparator] isEqual:items]);
+
+				[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+					[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+						[vaultEraseExpectation fulfill];
+					}];
+				}];
+			}];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:60 handler:nil];
+}
+
+- (void)testCacheItemWritesInvalidateVFSIndex
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	OCVFSIndex *index = [OCVFSIndex new];
+	XCTestExpectation *vaultEraseExpectation = [self expectationWithDescription:@"Vault erased"];
+
+	XCTAssertEqualObjects(database.bookmarkUUID, bookmark.uuid);
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		OCItem *item1 = [OCItem new], *item2 = [OCItem new];
+
+		item1.type = item2.type = OCItemTypeFile;
+		item1.path = @"/Index/file1.txt";
+		item2.path = @"/Index/file2.txt";
+		item1.localID = NSUUID.UUID.UUIDString;
+		item2.localID = NSUUID.UUID.UUIDString;
+
+		[database addCacheItems:@[ item1, item2 ] syncAnchor:@(1) completionHandler:^(OCDatabase *db, NSError *error) {
+			NSUInteger generation = [index itemGenerationForBookmarkUUID:bookmark.uuid];
+
+			XCTAssert(error == nil);
+
+			[index addItem:item1 bookmarkUUID:bookmark.uuid generation:generation];
+			[index addItem:item2 bookmarkUUID:bookmark.uuid generation:generation];
+
+			XCTAssertNotNil([index itemForLocalID:item1.localID bookmarkUUID:bookmark.uuid]);
+
+			// Direct writes (f.ex. by vault compaction) that bypass the core invalidate the affected items
+			[item1 clearLocalCopyProperties];
+
+			[database updateCacheItems:@[ item1 ] syncAnchor:@(2) completionHandler:^(OCDatabase *db, NSError *error) {
+				XCTAssert(error == nil);
+
+				XCTAssertNil([index itemForLocalID:item1.localID bookmarkUUID:bookmark.uuid]);
+				XCTAssertNotNil([index itemForLocalID:item2.localID bookmarkUUID:bookmark.uuid]);
+
+				// Items fetched before the write aren't added afterwards
+				[index addItem:item1 bookmarkUUID:bookmark.uuid generation:generation];
+				XCTAssertNil([index itemForLocalID:item1.localID bookmarkUUID:bookmark.uuid]);
+
+				// Purges can't name the affected items and invalidate all items of the bookmark
+				[database purgeCacheItemsWithDatabaseIDs:@[ item2.databaseID ] completionHandler:^(OCDatabase *db, NSError *error) {
+					XCTAssert(error == nil);
+					XCTAssertNil([index itemForLocalID:item2.localID bookmarkUUID:bookmark.uuid]);
+
+					[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+						[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+							[vaultEraseExpectation fulfill];
+						}];
+					}];
+				}];
+			}];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:60 handler:nil];
+}
+
+- (void)testPagedRetrieval
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	XCTestExpectation *vaultEraseExpectation = [self expectationWithDescription:@"Vault erased"];
+	NSArray<NSString *> *names = @[ @"e.txt", @"b.txt", @"d.txt", @"a.txt", @"c.txt" ];
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		NSMutableArray<OCItem *> *items = [NSMutableArray new];
+
+		for (NSString *name in names)
+		{
+			OCItem *item = [OCItem new];
+
+			item.type = OCItemTypeFile;
+			item.path = [@"/Paged/" stringByAppendingString:name];
+			item.localID = NSUUID.UUID.UUIDString;
+
+			[items addObject:item];
+		}
+
+		[database addCacheItems:items syncAnchor:@(1) completionHandler:^(OCDatabase *db, NSError *error) {
+			OCLocation *location = [[OCLocation alloc] initWithBookmarkUUID:nil driveID:nil path:@"/Paged/"];
+			NSMutableArray<NSString *> *pagedNames = [NSMutableArray new];
+			__block NSUInteger pageCount = 0;
+			__block void (^retrievePageAfterItem)(OCItem *lastItem) = nil;
+
+			void (^pageThroughChanges)(void) = ^{
+				XCTAssert(pageCount == 4);
+				XCTAssertEqualObjects(pagedNames, (@[ @"a.txt", @"b.txt", @"c.txt", @"d.txt", @"e.txt" ]));
+
+				// Page through changes
+				[database retrieveCacheItemsUpdatedAfterSyncAnchor:@(0) databaseID:nil limit:3 completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *firstPageItems) {
+					XCTAssert(error == nil);
+					XCTAssert(firstPageItems.count == 3);
+
+					[database retrieveCacheItemsUpdatedAfterSyncAnchor:syncAnchor databaseID:firstPageItems.lastObject.databaseID limit:3 completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *secondPageItems) {
+						XCTAssert(error == nil);
+						XCTAssert(secondPageItems.count == 2);
+
+						[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+							[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+								[vaultEraseExpectation fulfill];
+							}];
+						}];
+					}];
+				}];
+			};
+
+			XCTAssert(error == nil);
+
+			// Page through the folder, two items at a time
+			retrievePageAfterItem = ^(OCItem *lastItem) {
+				[database retrieveCacheItemsAtLocation:location afterName:lastItem.name databaseID:lastItem.databaseID limit:2 completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+					XCTAssert(error == nil);
+					XCTAssert(items.count <= 2);
+
+					[pagedNames addObjectsFromArray:[items valueForKeyPath:@"name"]];
+					pageCount++;
+
+					if ((items.count > 0) && (pageCount < 10))
+					{
+						retrievePageAfterItem(items.lastObject);
+					}
+					else
+					{
+						retrievePageAfterItem = nil;
+						pageThroughChanges();
+					}
+				}];
+			};
+
+			retrievePageAfterItem(nil);
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:60 handler:nil];
+}
+
 @end
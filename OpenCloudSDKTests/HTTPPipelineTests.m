@@ -185,6 +185,36 @@ typedef void(^PartitionSimulatorHandleResult)(OCHTTPRequest *request, OCHTTPResp
 
 @end
 
+#pragma mark - Certificate evaluation helpers
+@interface OCHTTPPipeline (CertificateEvaluationTesting)
+- (void)_evaluateCertificate:(OCCertificate *)certificate withCompletionHandler:(void(^)(OCCertificate *certificate, OCCertificateValidationResult validationResult, NSError *validationError))completionHandler;
+@end
+
+@interface OCIPNotificationCenter (CertificateEvaluationTesting)
+- (void)deliverNotificationForName:(OCIPCNotificationName)name;
+@end
+
+@interface StubEvaluationCertificate : OCCertificate
+
+@property(strong,nullable) NSDate *stubValidUntilDate;
+@property(assign) OCCertificateValidationResult stubValidationResult;
+
+@end
+
+@implementation StubEvaluationCertificate
+
+- (NSDate *)validUntilDate
+{
+	return (_stubValidUntilDate);
+}
+
+- (void)evaluateWithCompletionHandler:(void (^)(OCCertificate *, OCCertificateValidationResult, NSError *))completionHandler
+{
+	completionHandler(self, _stubValidationResult, nil);
+}
+
+@end
+
 #pragma mark - Pipeline tests
 @interface HTTPPipelineTests : XCTestCase
 {
@@ -2545,6 +2575,103 @@ typedef void(^PartitionSimulatorHandleResult)(OCHTTPRequest *request, OCHTTPResp
 	progressObserver = nil;
 }
 
+#pragma mark - Certificate evaluation cache
+- (StubEvaluationCertificate *)_stubEvaluationCertificateWithResult:(OCCertificateValidationResult)validationResult validUntil:(NSDate *)validUntilDate
+{
+	NSURL *certURL = [[NSBundle bundleForClass:[self class]] URLForResource:@"fake-demo_opencloud_org" withExtension:@"cer"];
+	StubEvaluationCertificate *certificate = [StubEvaluationCertificate certificateWithCertificateData:[NSData dataWithContentsOfURL:certURL] hostName:@"demo.opencloud.eu"];
+
+	certificate.stubValidationResult = validationResult;
+	certificate.stubValidUntilDate = validUntilDate;
+
+	return (certificate);
+}
+
+- (OCCertificateValidationResult)_evaluateCertificate:(OCCertificate *)certificate withPipeline:(OCHTTPPipeline *)pipeline
+{
+	__block OCCertificateValidationResult result = OCCertificateValidationResultNone;
+
+	// Stub certificates complete synchronously
+	[pipeline _evaluateCertificate:certificate withCompletionHandler:^(OCCertificate *certificate, OCCertificateValidationResult validationResult, NSError *validationError) {
+		result = validationResult;
+	}];
+
+	return (result);
+}
+
+- (void)testCertificateEvaluationCacheHitsAndExpiry
+{
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:[NSURLSessionConfiguration ephemeralSessionConfiguration]];
+	StubEvaluationCertificate *certificate = [self _stubEvaluationCertificateWithResult:OCCertificateValidationResultPassed validUntil:[NSDate dateWithTimeIntervalSinceNow:2.0]];
+
+	// First evaluation is performed in full, the second one is answered from the cache
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultPassed);
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultPassed);
+
+	XCTAssert(pipeline.certificateEvaluationCount == 1);
+	XCTAssert(pipeline.certificateEvaluationCacheHits == 1);
+
+	// Cached result expires at the certificate's notAfter date
+	[NSThread sleepForTimeInterval:2.5];
+
+	certificate.stubValidUntilDate = [NSDate dateWithTimeIntervalSinceNow:3600];
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultPassed);
+
+	XCTAssert(pipeline.certificateEvaluationCount == 2);
+	XCTAssert(pipeline.certificateEvaluationCacheHits == 1);
+
+	// Certificates past their notAfter date aren't cached at all
+	certificate = [self _stubEvaluationCertificateWithResult:OCCertificateValidationResultPromptUser validUntil:[NSDate dateWithTimeIntervalSinceNow:-60]];
+
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultPromptUser);
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultPromptUser);
+
+	XCTAssert(pipeline.certificateEvaluationCount == 4);
+	XCTAssert(pipeline.certificateEvaluationCacheHits == 1);
+
+	// Errors are never cached
+	certificate = [self _stubEvaluationCertificateWithResult:OCCertificateValidationResultError validUntil:[NSDate dateWithTimeIntervalSinceNow:3600]];
+
+	[self _evaluateCertificate:certificate withPipeline:pipeline];
+	[self _evaluateCertificate:certificate withPipeline:pipeline];
+
+	XCTAssert(pipeline.certificateEvaluationCount == 6);
+	XCTAssert(pipeline.certificateEvaluationCacheHits == 1);
+}
+
+- (void)testCertificateEvaluationCacheFlushOnAcceptanceChange
+{
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:[NSURLSessionConfiguration ephemeralSessionConfiguration]];
+	StubEvaluationCertificate *certificate = [self _stubEvaluationCertificateWithResult:OCCertificateValidationResultUserAccepted validUntil:[NSDate dateWithTimeIntervalSinceNow:3600]];
+
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultUserAccepted);
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultUserAccepted);
+
+	XCTAssert(pipeline.certificateEvaluationCount == 1);
+	XCTAssert(pipeline.certificateEvaluationCacheHits == 1);
+
+	// Change of user-accepted certificates in this process
+	[[NSNotificationCenter defaultCenter] postNotificationName:OCCertificateUserAcceptanceDidChangeNotification object:certificate];
+
+	certificate.stubValidationResult = OCCertificateValidationResultPromptUser;
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultPromptUser);
+
+	XCTAssert(pipeline.certificateEvaluationCount == 2);
+	XCTAssert(pipeline.certificateEvaluationCacheHits == 1);
+
+	// Change of bookmarks (and their accepted certificates) in another process
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultPromptUser);
+	XCTAssert(pipeline.certificateEvaluationCacheHits == 2);
+
+	[OCIPNotificationCenter.sharedNotificationCenter deliverNotificationForName:OCIPCNotificationNameBookmarkManagerListChanged];
+
+	certificate.stubValidationResult = OCCertificateValidationResultUserAccepted;
+	XCTAssert([self _evaluateCertificate:certificate withPipeline:pipeline] == OCCertificateValidationResultUserAccepted);
+
+	XCTAssert(pipeline.certificateEvaluationCount == 3);
+	XCTAssert(pipeline.certificateEvaluationCacheHits == 2);
+}
+
 /*
 	Test scenarios currently not covered:
 	- test certificate issue handling (including a non-response to the certificate callback and restart (test for handling of app crashes/terminations))
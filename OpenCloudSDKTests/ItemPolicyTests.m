@@ -230,6 +230,15 @@
 							XCTAssert([core availableOfflinePolicyCoverageOfItem:item] == OCCoreAvailableOfflineCoverageNone);
 						}
 					}
+
+					// Batch coverage must match per-item coverage
+					NSArray<NSNumber *> *coverages = [core availableOfflinePolicyCoverageOfItems:changeset.queryResult];
+
+					XCTAssert(coverages.count == changeset.queryResult.count);
+
+					[changeset.queryResult enumerateObjectsUsingBlock:^(OCItem * _Nonnull item, NSUInteger idx, BOOL * _Nonnull stop) {
+						XCTAssert(coverages[idx].unsignedIntegerValue == [core availableOfflinePolicyCoverageOfItem:item]);
+					}];
 				}
 			}
 		}];
@@ -173,4 +173,129 @@
 	NSLog(@"LockManager 1: %@, LockManager 2: %@", lockManager1, lockManager2);
 }
 
+- (void)testFileLockConcurrency
+{
+	XCTestExpectation *expectLock1 = [self expectationWithDescription:@"Lock 1 acquired"];
+	XCTestExpectation *expectTryFailure = [self expectationWithDescription:@"Try-acquire failed"];
+	XCTestExpectation *expectLock2 = [self expectationWithDescription:@"Lock 2 acquired"];
+	__block BOOL lock1Released = NO;
+
+	// Each lock manager uses its own file descriptors, so the kernel arbitrates between them just like between processes
+	OCLockManager *lockManager1 = [[OCLockManager alloc] initWithLockDirectoryURL:_keyValueStoreURL];
+	OCLockManager *lockManager2 = [[OCLockManager alloc] initWithLockDirectoryURL:_keyValueStoreURL];
+
+	XCTAssertEqualObjects(lockManager1.backend, OCLockManagerBackendFileLock);
+
+	[lockManager1 requestLock:[[OCLockRequest alloc] initWithResourceIdentifier:@"resource/1" acquiredHandler:^(NSError * _Nullable error, OCLock * _Nullable lock1) {
+		XCTAssertNil(error);
+		XCTAssert(lock1.isValid);
+
+		[expectLock1 fulfill];
+
+		[lockManager2 requestLock:[[OCLockRequest alloc] initWithResourceIdentifier:@"resource/1" tryAcquireHandler:^(NSError * _Nullable error, OCLock * _Nullable lock) {
+			XCTAssert([error isOCErrorWithCode:OCErrorLockInvalidated]);
+			XCTAssertNil(lock);
+
+			[expectTryFailure fulfill];
+
+			[lockManager2 requestLock:[[OCLockRequest alloc] initWithResourceIdentifier:@"resource/1" acquiredHandler:^(NSError * _Nullable error, OCLock * _Nullable lock) {
+				XCTAssertNil(error);
+				XCTAssert(lock1Released);
+
+				[expectLock2 fulfill];
+			}]];
+
+			dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+				lock1Released = YES;
+				[lock1 releaseLock];
+			});
+		}]];
+	}]];
+
+	[self waitForExpectationsWithTimeout:10.0 handler:nil];
+}
+
+- (NSTimeInterval)_measureContentionWithLockManagers:(NSArray<OCLockManager *> *)lockManagers acquisitionsPerManager:(NSUInteger)acquisitionCount
+{
+	XCTestExpectation *expectAcquisitions = [self expectationWithDescription:@"All acquisitions done"];
+	NSObject *holderSync = [NSObject new];
+	__block NSInteger holderCount = 0;
+	NSTimeInterval startTime = NSDate.timeIntervalSinceReferenceDate;
+
+	expectAcquisitions.expectedFulfillmentCount = lockManagers.count;
+
+	for (OCLockManager *lockManager in lockManagers)
+	{
+		__block NSUInteger remainingAcquisitions = acquisitionCount;
+		__block dispatch_block_t acquireNext = nil;
+
+		acquireNext = ^{
+			[lockManager requestLock:[[OCLockRequest alloc] initWithResourceIdentifier:@"contended-resource" acquiredHandler:^(NSError * _Nullable error, OCLock * _Nullable lock) {
+				NSInteger concurrentHolders;
+
+				XCTAssertNil(error);
+
+				// Verify mutual exclusion: no other manager may hold the lock until it is released below
+				@synchronized(holderSync)
+				{
+					concurrentHolders = ++holderCount;
+				}
+
+				XCTAssertEqual(concurrentHolders, 1);
+
+				// Hold the lock briefly, giving the other managers a chance to (wrongly) acquire it
+				dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(2 * NSEC_PER_MSEC)), dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+					@synchronized(holderSync)
+					{
+						holderCount--;
+					}
+
+					[lock releaseLock];
+
+					if (--remainingAcquisitions > 0)
+					{
+						acquireNext();
+					}
+					else
+					{
+						acquireNext = nil;
+						[expectAcquisitions fulfill];
+					}
+				});
+			}]];
+		};
+
+		acquireNext();
+	}
+
+	[self waitForExpectations:@[ expectAcquisitions ] timeout:120.0];
+
+	return (NSDate.timeIntervalSinceReferenceDate - startTime);
+}
+
+- (void)testLockContentionBenchmark
+{
+	NSUInteger managerCount = 4, acquisitionCount = 25;
+	NSMutableArray<OCLockManager *> *kvsLockManagers = [NSMutableArray new];
+	NSMutableArray<OCLockManager *> *fileLockManagers = [NSMutableArray new];
+	NSURL *lockDirectoryURL = [_keyValueStoreURL URLByAppendingPathExtension:@"locks"];
+
+	// Lock managers with separate stores/file descriptors stand in for separate processes
+	for (NSUInteger idx=0; idx < managerCount; idx++)
+	{
+		[kvsLockManagers addObject:[[OCLockManager alloc] initWithKeyValueStore:[[OCKeyValueStore alloc] initWithURL:_keyValueStoreURL identifier:@"lockTestKVS"]]];
+		[fileLockManagers addObject:[[OCLockManager alloc] initWithLockDirectoryURL:lockDirectoryURL]];
+	}
+
+	NSTimeInterval kvsDuration = [self _measureContentionWithLockManagers:kvsLockManagers acquisitionsPerManager:acquisitionCount];
+	NSTimeInterval fileLockDuration = [self _measureContentionWithLockManagers:fileLockManagers acquisitionsPerManager:acquisitionCount];
+
+	XCTAttachment *attachment = [XCTAttachment attachmentWithString:[NSString stringWithFormat:@"%lu managers, %lu acquisitions each\nKey-value store: %.3f sec, %.0f acquisitions/sec\nFile lock: %.3f sec, %.0f acquisitions/sec", (unsigned long)managerCount, (unsigned long)acquisitionCount, kvsDuration, (double)(managerCount * acquisitionCount) / kvsDuration, fileLockDuration, (double)(managerCount * acquisitionCount) / fileLockDuration]];
+	attachment.name = @"Lock contention";
+	attachment.lifetime = XCTAttachmentLifetimeKeepAlways;
+	[self addAttachment:attachment];
+
+	[[NSFileManager defaultManager] removeItemAtURL:lockDirectoryURL error:NULL];
+}
+
 @end
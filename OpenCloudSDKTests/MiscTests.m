@@ -8,6 +8,12 @@
 
 #import <XCTest/XCTest.h>
 #import <OpenCloudSDK/OpenCloudSDK.h>
+#import "OCRangedDownloadJob.h"
+#import "OCXMLItemScanner.h"
+#import "OCLogBinaryRecorder.h"
+#import "OCLogBinaryCoder.h"
+#import "OCVaultChangeJournal.h"
+#import "OCVFSIndex.h"
 
 @interface MiscTests : XCTestCase
 
@@ -403,6 +409,56 @@
 	[self waitForExpectations:@[ darwinMessageSentExpectation, observerExpectation, secondObserverExpectation ] timeout:3 enforceOrder:YES];
 }
 
+- (void)testIPNotificationCoalescing
+{
+	OCIPNotificationCenter *notificationCenter = [OCIPNotificationCenter new];
+	OCIPCNotificationName coalescedName = @"hello-coalesced";
+	XCTestExpectation *trailingDeliveryExpectation = [self expectationWithDescription:@"Received trailing notification"];
+	NSUInteger uploadCount = 5000;
+	__block NSUInteger receivedCount = 0;
+
+	[notificationCenter setMinimumInterval:0.25 forName:coalescedName];
+	XCTAssert([notificationCenter minimumIntervalForName:coalescedName] == 0.25);
+
+	[notificationCenter addObserver:self forName:coalescedName withHandler:^(OCIPNotificationCenter * _Nonnull notificationCenter, id  _Nonnull observer, OCIPCNotificationName  _Nonnull notificationName) {
+		receivedCount++;
+
+		if (receivedCount == 2)
+		{
+			// Leading and trailing edge
+			[trailingDeliveryExpectation fulfill];
+		}
+	}];
+
+	// Simulate the notifications posted for a bulk upload, with only the last one delivered to self
+	for (NSUInteger i=0; i<uploadCount; i++)
+	{
+		[notificationCenter postNotificationForName:coalescedName ignoreSelf:(i != 0) && (i != (uploadCount-1))];
+	}
+
+	[self waitForExpectationsWithTimeout:3 handler:nil];
+
+	OCIPNotificationStatistics *statistics = [notificationCenter statisticsForName:coalescedName];
+
+	OCLog(@"Coalescing statistics for %lu posts: %@", (unsigned long)uploadCount, statistics);
+
+	XCTAssert(statistics.postRequestCount == uploadCount);
+	XCTAssert(statistics.postCount < (uploadCount / 100));
+	XCTAssert(statistics.coalescedCount == (uploadCount - statistics.postCount));
+	XCTAssert(statistics.deliveredCount == 2);
+
+	// Turning coalescing off posts every notification again
+	[notificationCenter setMinimumInterval:0 forName:coalescedName];
+	[notificationCenter resetStatistics];
+
+	[notificationCenter postNotificationForName:coalescedName ignoreSelf:YES];
+	[notificationCenter postNotificationForName:coalescedName ignoreSelf:YES];
+
+	XCTAssert([notificationCenter statisticsForName:coalescedName].postCount == 2);
+
+	[notificationCenter removeObserver:self forName:coalescedName];
+}
+
 #pragma mark - OCAsyncSequentialQueue
 - (void)testAsyncSequentialQueue
 {
@@ -822,4 +878,517 @@
 
 }
 
+
+#pragma mark - OCRangedDownloadJob
+- (void)testRangedDownloadJobCheckpoints
+{
+	NSURL *targetURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+	NSURL *rangeFileURL = [targetURL URLByAppendingPathExtension:@"range"];
+	OCItem *item = [OCItem new];
+	NSError *error = nil;
+
+	item.path = @"/large.bin";
+	item.eTag = @"\"etag-1\"";
+	item.size = 10;
+
+	OCRangedDownloadJob *job = [[OCRangedDownloadJob alloc] initWithItem:item targetURL:targetURL rangeSize:4];
+
+	// Range layout: [0-3] [4-7] [8-9]
+	XCTAssert(job.rangeCount == 3);
+	XCTAssert(NSEqualRanges([job byteRangeForRangeIndex:2], NSMakeRange(8, 2)));
+	XCTAssert([job preallocateTargetWithError:&error]);
+
+	// Write last range first
+	[[@"89" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:rangeFileURL atomically:YES];
+	XCTAssert([job writeRangeAtIndex:2 fromFileURL:rangeFileURL error:&error]);
+
+	[[@"0123" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:rangeFileURL atomically:YES];
+	XCTAssert([job writeRangeAtIndex:0 fromFileURL:rangeFileURL error:&error]);
+
+	// Truncated range is rejected
+	[[@"45" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:rangeFileURL atomically:YES];
+	XCTAssertFalse([job writeRangeAtIndex:1 fromFileURL:rangeFileURL error:&error]);
+	XCTAssert(!job.isComplete);
+
+	// Resume from checkpoint: only the middle range is missing
+	OCRangedDownloadJob *resumedJob = [OCRangedDownloadJob checkpointedJobForItem:item targetURL:targetURL];
+
+	XCTAssert(resumedJob != nil);
+	XCTAssert(![resumedJob.jobID isEqual:job.jobID]);
+	XCTAssert([resumedJob.missingRanges isEqual:[NSIndexSet indexSetWithIndex:1]]);
+	XCTAssert(resumedJob.completedBytes == 6);
+
+	[[@"4567" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:rangeFileURL atomically:YES];
+	XCTAssert([resumedJob writeRangeAtIndex:1 fromFileURL:rangeFileURL error:&error]);
+	XCTAssert(resumedJob.isComplete);
+	XCTAssert([[NSString stringWithContentsOfURL:targetURL encoding:NSUTF8StringEncoding error:NULL] isEqual:@"0123456789"]);
+
+	// Changed ETag discards the checkpoint
+	item.eTag = @"\"etag-2\"";
+
+	XCTAssert([OCRangedDownloadJob checkpointedJobForItem:item targetURL:targetURL] == nil);
+	XCTAssert(![NSFileManager.defaultManager fileExistsAtPath:targetURL.path]);
+	XCTAssert(![NSFileManager.defaultManager fileExistsAtPath:[OCRangedDownloadJob checkpointURLForTargetURL:targetURL].path]);
+
+	[NSFileManager.defaultManager removeItemAtURL:rangeFileURL error:NULL];
+}
+
+- (void)testRangedDownloadJobScheduling
+{
+	NSURL *targetURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+	OCItem *item = [OCItem new];
+	NSError *error = nil;
+
+	item.path = @"/large.bin";
+	item.eTag = @"\"etag-1\"";
+	item.size = 10;
+
+	OCRangedDownloadJob *job = [[OCRangedDownloadJob alloc] initWithItem:item targetURL:targetURL rangeSize:4];
+	OCHTTPRequest *request0 = [OCHTTPRequest requestWithURL:[NSURL URLWithString:@"https://demo.opencloud.eu/0"]];
+	OCHTTPRequest *request2 = [OCHTTPRequest requestWithURL:[NSURL URLWithString:@"https://demo.opencloud.eu/2"]];
+
+	XCTAssert([job preallocateTargetWithError:&error]);
+
+	// Scheduled ranges are returned as copy
+	[job addScheduledRequest:request0 forRangeIndex:0];
+
+	NSIndexSet *scheduledRanges = job.scheduledRanges;
+
+	[job addScheduledRequest:request2 forRangeIndex:2];
+
+	XCTAssert([scheduledRanges isEqual:[NSIndexSet indexSetWithIndex:0]]);
+	XCTAssert(job.scheduledRanges.count == 2);
+	XCTAssert([job.missingRanges isEqual:[NSIndexSet indexSetWithIndex:1]]);
+
+	[job removeScheduledRequestForRangeIndex:0];
+	XCTAssert([job.scheduledRanges isEqual:[NSIndexSet indexSetWithIndex:2]]);
+
+	// Removing all scheduled requests returns the requests in flight
+	NSArray<OCHTTPRequest *> *requests = [job removeAllScheduledRequests];
+
+	XCTAssert(requests.count == 1);
+	XCTAssert(requests.firstObject == request2);
+	XCTAssert(job.scheduledRanges.count == 0);
+
+	// Ended state is persisted with the checkpoint - and reset when resuming
+	job.ended = YES;
+	XCTAssert([job saveCheckpointWithError:&error]);
+
+	OCRangedDownloadJob *decodedJob = [NSKeyedUnarchiver unarchivedObjectOfClass:OCRangedDownloadJob.class fromData:[NSData dataWithContentsOfURL:job.checkpointURL] error:NULL];
+	XCTAssert(decodedJob.ended);
+
+	OCRangedDownloadJob *resumedJob = [OCRangedDownloadJob checkpointedJobForItem:item targetURL:targetURL];
+	XCTAssert(resumedJob != nil);
+	XCTAssert(!resumedJob.ended);
+	XCTAssert(!resumedJob.rangeSupportConfirmed);
+	XCTAssert(!resumedJob.singleDownload);
+
+	[job reset];
+}
+
+#pragma mark - OCXMLItemScanner
+- (void)testXMLItemScannerUnchangedItems
+{
+	NSURL *xmlResponseDataURL = [[NSBundle bundleForClass:[self class]] URLForResource:@"largePropFindResponse1000" withExtension:@"xml"];
+	NSData *xmlResponseData = [NSData dataWithContentsOfURL:xmlResponseDataURL];
+	NSString *basePath = @"/remote.php/dav/files/manyfiles";
+	NSMutableDictionary<OCFileID, OCItem *> *knownItemsByFileID = [NSMutableDictionary new];
+	OCXMLItemScanner *scanner;
+	OCXMLParser *xmlParser;
+
+	// Parse response fully to obtain the known items
+	xmlParser = [[OCXMLParser alloc] initWithData:xmlResponseData];
+	xmlParser.options = [@{ @"basePath" : basePath } mutableCopy];
+	[xmlParser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+	XCTAssert([xmlParser parse]);
+	XCTAssert(xmlParser.parsedObjects.count > 1);
+
+	for (OCItem *item in xmlParser.parsedObjects)
+	{
+		knownItemsByFileID[item.fileID] = item;
+	}
+
+	// All items unchanged
+	scanner = [[OCXMLItemScanner alloc] initWithData:xmlResponseData basePath:basePath knownItemsByFileID:knownItemsByFileID];
+
+	XCTAssert([scanner scan]);
+	XCTAssertEqual(scanner.responseCount, xmlParser.parsedObjects.count);
+	XCTAssertEqual(scanner.changedResponseIndexes.count, 0);
+
+	// Known items are returned as copies, so later changes to the known item don't affect the result
+	OCItem *returnedKnownItem = [scanner knownItemForResponseAtIndex:1];
+
+	XCTAssertNotEqual(returnedKnownItem, xmlParser.parsedObjects[1]);
+	XCTAssertEqualObjects(returnedKnownItem.fileID, ((OCItem *)xmlParser.parsedObjects[1]).fileID);
+	XCTAssertEqualObjects(returnedKnownItem.eTag, ((OCItem *)xmlParser.parsedObjects[1]).eTag);
+
+	// One changed item, one unknown item
+	OCFileID changedFileID = ((OCItem *)xmlParser.parsedObjects[1]).fileID;
+	OCFileID unknownFileID = ((OCItem *)xmlParser.parsedObjects[2]).fileID;
+
+	knownItemsByFileID[changedFileID].eTag = @"changed";
+	[knownItemsByFileID removeObjectForKey:unknownFileID];
+
+	scanner = [[OCXMLItemScanner alloc] initWithData:xmlResponseData basePath:basePath knownItemsByFileID:knownItemsByFileID];
+
+	XCTAssert([scanner scan]);
+	XCTAssertEqualObjects(scanner.changedResponseIndexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)]);
+	XCTAssertNil([scanner knownItemForResponseAtIndex:1]);
+	XCTAssertNil([scanner knownItemForResponseAtIndex:2]);
+	XCTAssertNotNil([scanner knownItemForResponseAtIndex:3]);
+
+	// Only build items for the changed responses
+	__block NSUInteger responseIndex = 0;
+	NSIndexSet *changedResponseIndexes = scanner.changedResponseIndexes;
+
+	xmlParser = [[OCXMLParser alloc] initWithData:xmlResponseData];
+	xmlParser.options = [@{ @"basePath" : basePath } mutableCopy];
+	xmlParser.objectCreationFilter = ^BOOL(OCXMLParser *parser, NSString *elementName) {
+		return ([changedResponseIndexes containsIndex:responseIndex++]);
+	};
+	[xmlParser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+	XCTAssert([xmlParser parse]);
+	XCTAssertEqual(xmlParser.parsedObjects.count, 2);
+	XCTAssertEqualObjects(((OCItem *)xmlParser.parsedObjects[0]).fileID, changedFileID);
+	XCTAssertEqualObjects(((OCItem *)xmlParser.parsedObjects[1]).fileID, unknownFileID);
+}
+
+#pragma mark - Binary logging
+static BOOL RecordLogMessage(OCLogBinaryRecorder *recorder, NSString *format, ...) NS_FORMAT_FUNCTION(2,3);
+static BOOL RecordLogMessage(OCLogBinaryRecorder *recorder, NSString *format, ...)
+{
+	va_list args;
+	BOOL recorded;
+
+	va_start(args, format);
+	recorded = [recorder recordLogLevel:OCLogLevelInfo functionName:@(__PRETTY_FUNCTION__) file:@(__FILE__) line:__LINE__ tags:@[@"Test", @"Binary"] format:format arguments:args];
+	va_end(args);
+
+	return (recorded);
+}
+
+- (void)testLogBinaryRecordingRoundtrip
+{
+	dispatch_queue_t flushQueue = dispatch_queue_create("binary log flush queue", DISPATCH_QUEUE_SERIAL);
+	NSMutableArray<OCLogBinaryMessage *> *flushedMessages = [NSMutableArray new];
+	OCLogBinaryRecorder *recorder = [[OCLogBinaryRecorder alloc] initWithBufferSize:(64 * 1024) flushQueue:flushQueue flushHandler:^(NSArray<OCLogBinaryMessage *> * _Nonnull messages) {
+		[flushedMessages addObjectsFromArray:messages];
+	}];
+	NSMutableString *mutableString = [@"before" mutableCopy];
+	NSArray<NSString *> *expectedMessages = @[
+		[NSString stringWithFormat:@"int=%d long=%ld ull=%llu hex=%08x", -42, (long)-1234567, 18446744073709551615ull, 0xBEEFu],
+		[NSString stringWithFormat:@"double=%.3f width=[%*d] char=%c cstr=%s null=%@ 100%%", 3.14159, 6, 42, 'x', "c string", nil],
+		[NSString stringWithFormat:@"mutable=%@ array=%@ ptr=%p", mutableString, @[@1, @2], (void *)0x1234]
+	];
+
+	XCTAssert(RecordLogMessage(recorder, @"int=%d long=%ld ull=%llu hex=%08x", -42, (long)-1234567, 18446744073709551615ull, 0xBEEFu));
+	XCTAssert(RecordLogMessage(recorder, @"double=%.3f width=[%*d] char=%c cstr=%s null=%@ 100%%", 3.14159, 6, 42, 'x', "c string", nil));
+	XCTAssert(RecordLogMessage(recorder, @"mutable=%@ array=%@ ptr=%p", mutableString, @[@1, @2], (void *)0x1234));
+
+	// Changes after the log call must not affect the recorded message
+	[mutableString setString:@"after"];
+
+	// Formats without direct access to ASCII characters are left to the caller
+	XCTAssertFalse(RecordLogMessage(recorder, @"non-ASCII – %d", 1));
+
+	dispatch_sync(flushQueue, ^{
+		[recorder flush];
+	});
+
+	XCTAssertEqual(flushedMessages.count, expectedMessages.count);
+
+	for (NSUInteger idx=0; idx < flushedMessages.count; idx++)
+	{
+		XCTAssertEqualObjects(flushedMessages[idx].message, expectedMessages[idx]);
+		XCTAssertEqualObjects(flushedMessages[idx].tags, (@[@"Test", @"Binary"]));
+	}
+
+	// Encode and decode
+	OCLogBinaryEncoder *encoder = [OCLogBinaryEncoder new];
+	NSMutableData *logData = [[encoder sessionHeaderDataWithProcessName:@"MiscTests" processID:42] mutableCopy];
+	NSMutableArray<OCLogBinaryMessage *> *decodedMessages = [NSMutableArray new];
+
+	for (OCLogBinaryMessage *message in flushedMessages)
+	{
+		[logData appendData:[encoder dataForMessage:message]];
+	}
+
+	XCTAssert([OCLogBinaryDecoder isBinaryLogData:logData]);
+	XCTAssertFalse([OCLogBinaryDecoder isBinaryLogData:[@"2026-10-23 12:00:00 text log" dataUsingEncoding:NSUTF8StringEncoding]]);
+
+	[[[OCLogBinaryDecoder alloc] initWithData:logData] enumerateMessagesUsingBlock:^(OCLogBinaryMessage * _Nonnull message, NSString * _Nonnull processName, pid_t processID, BOOL * _Nonnull stop) {
+		XCTAssertEqualObjects(processName, @"MiscTests");
+		XCTAssertEqual(processID, 42);
+		[decodedMessages addObject:message];
+	}];
+
+	XCTAssertEqual(decodedMessages.count, expectedMessages.count);
+
+	for (NSUInteger idx=0; idx < decodedMessages.count; idx++)
+	{
+		XCTAssertEqualObjects(decodedMessages[idx].message, expectedMessages[idx]);
+		XCTAssertEqualObjects(decodedMessages[idx].tags, flushedMessages[idx].tags);
+		XCTAssertEqual(decodedMessages[idx].line, flushedMessages[idx].line);
+		XCTAssertEqual(decodedMessages[idx].timestamp, flushedMessages[idx].timestamp);
+	}
+
+	// Truncated data (f.ex. after a crash) decodes up to the last complete message
+	__block NSUInteger truncatedMessageCount = 0;
+
+	[[[OCLogBinaryDecoder alloc] initWithData:[logData subdataWithRange:NSMakeRange(0, logData.length - 3)]] enumerateMessagesUsingBlock:^(OCLogBinaryMessage * _Nonnull message, NSString * _Nonnull processName, pid_t processID, BOOL * _Nonnull stop) {
+		truncatedMessageCount++;
+	}];
+
+	XCTAssertEqual(truncatedMessageCount, expectedMessages.count - 1);
+
+	// Text export
+	NSString *text = [[NSString alloc] initWithData:[[[OCLogBinaryDecoder alloc] initWithData:logData] composedTextData] encoding:NSUTF8StringEncoding];
+
+	XCTAssert([text containsString:@"MiscTests[42:"]);
+	XCTAssert([text containsString:expectedMessages[0]]);
+}
+
+- (void)testLogCallPerformanceTextVersusBinary
+{
+	OCLogLevel previousLogLevel = OCLogger.logLevel;
+	NSUInteger callCount = 20000;
+
+	NSTimeInterval (^MeasureLogCalls)(OCLogger *logger) = ^(OCLogger *logger) {
+		XCTestExpectation *drainedExpectation = [self expectationWithDescription:@"Write queue drained"];
+		NSTimeInterval startTime, duration;
+
+		[logger addWriter:[[OCLogWriter alloc] initWithWriteHandler:^(NSData * _Nonnull messageData) {
+		}]];
+
+		startTime = NSDate.timeIntervalSinceReferenceDate;
+
+		for (NSUInteger idx=0; idx < callCount; idx++)
+		{
+			[logger appendLogLevel:OCLogLevelDebug functionName:@(__PRETTY_FUNCTION__) file:@(__FILE__) line:__LINE__ tags:@[@"Benchmark"] message:@"Processed item %lu of %lu at %@ (%.2f%%)", (unsigned long)idx, (unsigned long)callCount, @"/Documents/Folder/File.txt", (double)idx * 100.0 / (double)callCount];
+		}
+
+		duration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+		// Let the write queue catch up before the next measurement
+		[logger flushBinaryRecordingWithCompletionHandler:^{
+			[drainedExpectation fulfill];
+		}];
+
+		[self waitForExpectations:@[ drainedExpectation ] timeout:60];
+
+		return (duration);
+	};
+
+	OCLogger.logLevel = OCLogLevelDebug;
+
+	OCLogger *textLogger = [OCLogger new];
+	OCLogger *binaryLogger = [OCLogger new];
+
+	[binaryLogger startBinaryRecordingWithBufferSize:(4 * 1024 * 1024)];
+
+	NSTimeInterval textDuration = MeasureLogCalls(textLogger);
+	NSTimeInterval binaryDuration = MeasureLogCalls(binaryLogger);
+
+	OCLogger.logLevel = previousLogLevel;
+
+	NSLog(@"Log calls in text mode: %.0f calls/sec, %.3f µs/call", (double)callCount / textDuration, textDuration * 1000000.0 / (double)callCount);
+	NSLog(@"Log calls in binary mode: %.0f calls/sec, %.3f µs/call", (double)callCount / binaryDuration, binaryDuration * 1000000.0 / (double)callCount);
+
+	XCTAssert((textDuration > 0) && (binaryDuration > 0));
+}
+
+- (void)testLogArchiveCompressionRoundtrip
+{
+	NSURL *temporaryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:NSUUID.UUID.UUIDString];
+	NSURL *logURL = [temporaryURL URLByAppendingPathComponent:@"test.log.2026-10-23"];
+	NSURL *compressedURL = [logURL URLByAppendingPathExtension:OCLogFileRecordCompressedPathExtension];
+	NSMutableString *logText = [NSMutableString new];
+	uint64_t inputSize = 0, outputSize = 0;
+
+	[[NSFileManager defaultManager] createDirectoryAtURL:temporaryURL withIntermediateDirectories:YES attributes:nil error:NULL];
+
+	// Multiple compression buffers worth of log lines
+	for (NSUInteger idx=0; idx < 20000; idx++)
+	{
+		[logText appendFormat:@"2026-10-23 12:00:%02lu.%03lu MiscTests[42:%lu] [info] Processed item %lu\n", (unsigned long)(idx % 60), (unsigned long)(idx % 1000), (unsigned long)(idx % 7), (unsigned long)idx];
+	}
+
+	XCTAssert([[logText dataUsingEncoding:NSUTF8StringEncoding] writeToURL:logURL atomically:YES]);
+
+	XCTAssertNil([OCLogFileRecord compressFileAtURL:logURL toURL:compressedURL inputSize:&inputSize outputSize:&outputSize]);
+	XCTAssertEqual(inputSize, [logText lengthOfBytesUsingEncoding:NSUTF8StringEncoding]);
+	XCTAssert((outputSize > 0) && (outputSize < inputSize / 4));
+
+	OCLogFileRecord *record = [[OCLogFileRecord alloc] initWithURL:compressedURL];
+
+	XCTAssert(record.isCompressed);
+	XCTAssertFalse(record.isBinary);
+	XCTAssertEqualObjects(record.name, logURL.lastPathComponent);
+	XCTAssertEqualObjects([[NSString alloc] initWithData:[record textDataWithError:NULL] encoding:NSUTF8StringEncoding], logText);
+
+	NSURL *sharableURL = [record sharableURLWithError:NULL];
+	XCTAssertNotNil(sharableURL);
+	XCTAssertEqualObjects([NSString stringWithContentsOfURL:sharableURL encoding:NSUTF8StringEncoding error:NULL], logText);
+
+	XCTAssertFalse([[OCLogFileRecord alloc] initWithURL:logURL].isCompressed);
+
+	[[NSFileManager defaultManager] removeItemAtURL:sharableURL error:NULL];
+	[[NSFileManager defaultManager] removeItemAtURL:temporaryURL error:NULL];
+}
+
+- (void)testLogArchiveCompressionCancellation
+{
+	NSURL *temporaryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:NSUUID.UUID.UUIDString];
+	NSURL *logURL = [temporaryURL URLByAppendingPathComponent:@"test.log.2026-10-23"];
+	NSURL *partialURL = [logURL URLByAppendingPathExtension:@"lzfse.partial"];
+	NSMutableData *logData = [NSMutableData dataWithLength:1024 * 1024];
+	__block NSUInteger continueChecks = 0;
+	NSError *error;
+
+	[[NSFileManager defaultManager] createDirectoryAtURL:temporaryURL withIntermediateDirectories:YES attributes:nil error:NULL];
+
+	// Random data doesn't compress, so compression produces output long before the input ends
+	arc4random_buf(logData.mutableBytes, logData.length);
+
+	XCTAssert([logData writeToURL:logURL atomically:YES]);
+
+	error = [OCLogFileRecord compressFileAtURL:logURL toURL:partialURL inputSize:NULL outputSize:NULL shouldContinue:^BOOL{
+		continueChecks++;
+		return (NO);
+	}];
+
+	XCTAssert([error isOCErrorWithCode:OCErrorCancelled]);
+	XCTAssertEqual(continueChecks, 1);
+	XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:partialURL.path]); // no partial archive is left behind
+	XCTAssert([[NSFileManager defaultManager] fileExistsAtPath:logURL.path]); // source remains untouched
+
+	[[NSFileManager defaultManager] removeItemAtURL:temporaryURL error:NULL];
+}
+
+- (void)testVaultChangeJournal
+{
+	NSURL *journalURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:NSUUID.UUID.UUIDString];
+	OCItem *(^MakeItem)(OCLocalID localID, OCPath path, OCPath previousPath) = ^(OCLocalID localID, OCPath path, OCPath previousPath) {
+		OCItem *item = [OCItem new];
+
+		item.localID = localID;
+		item.path = path;
+		item.previousPath = previousPath;
+
+		return (item);
+	};
+
+	// Two journal instances on the same file stand in for two processes
+	OCVaultChangeJournal *writer = [[OCVaultChangeJournal alloc] initWithURL:journalURL capacity:1024];
+	OCVaultChangeJournal *reader = [[OCVaultChangeJournal alloc] initWithURL:journalURL capacity:1024];
+
+	// Nothing covered yet
+	XCTAssertNil([reader entriesSinceSyncAnchor:@(0) untilSyncAnchor:@(0)]);
+
+	XCTAssertNil([writer appendChangesForAddedItems:@[ MakeItem(@"lid-1", @"/a.txt", nil) ] removedItems:nil updatedItems:nil syncAnchor:@(10)]);
+	XCTAssertNil([writer appendChangesForAddedItems:nil removedItems:@[ MakeItem(@"lid-2", @"/b.txt", nil) ] updatedItems:@[ MakeItem(@"lid-3", @"/folder/c.txt", @"/c.txt"), MakeItem(@"lid-1", @"/a2.txt", @"/a.txt") ] syncAnchor:@(11)]);
+
+	NSArray<OCVaultChangeJournalEntry *> *entries = [reader entriesSinceSyncAnchor:@(9) untilSyncAnchor:@(11)];
+
+	XCTAssertEqual(entries.count, 4);
+	XCTAssertEqual(entries[0].kind, OCVaultChangeKindAdded);
+	XCTAssertEqualObjects(entries[0].syncAnchor, @(10));
+	XCTAssertEqual(entries[1].kind, OCVaultChangeKindRemoved);
+	XCTAssertEqual(entries[2].kind, OCVaultChangeKindMoved);
+	XCTAssertEqualObjects(entries[2].localID, @"lid-3");
+	XCTAssertEqualObjects(entries[2].previousPath, @"/c.txt");
+	XCTAssertEqual(entries[3].kind, OCVaultChangeKindUpdated); // Renamed in the same folder
+	XCTAssertNil(entries[3].previousPath);
+
+	// Tail only
+	XCTAssertEqual([reader entriesSinceSyncAnchor:@(10) untilSyncAnchor:@(11)].count, 3);
+	XCTAssertEqual([reader entriesSinceSyncAnchor:@(11) untilSyncAnchor:@(11)].count, 0);
+
+	// Changes committed to the database, but missing from the journal, are detected
+	XCTAssertNil([reader entriesSinceSyncAnchor:@(10) untilSyncAnchor:@(12)]);
+
+	// Changes without entries still advance what the journal covers
+	XCTAssertNil([writer appendChangesForAddedItems:nil removedItems:nil updatedItems:nil syncAnchor:@(12)]);
+	XCTAssertEqual([reader entriesSinceSyncAnchor:@(10) untilSyncAnchor:@(12)].count, 3);
+
+	// Changes before the first entry are not covered
+	XCTAssertNil([reader entriesSinceSyncAnchor:@(5) untilSyncAnchor:@(11)]);
+
+	// Filling the journal resets it - and it no longer covers older changes
+	for (NSUInteger syncAnchor=13; syncAnchor < 40; syncAnchor++)
+	{
+		XCTAssertNil([writer appendChangesForAddedItems:@[ MakeItem(NSUUID.UUID.UUIDString, @"/d.txt", nil) ] removedItems:nil updatedItems:nil syncAnchor:@(syncAnchor)]);
+	}
+
+	XCTAssertNil([reader entriesSinceSyncAnchor:@(11) untilSyncAnchor:@(39)]);
+	XCTAssertEqual([reader entriesSinceSyncAnchor:@(38) untilSyncAnchor:@(39)].count, 1);
+
+	writer = nil;
+	reader = nil;
+
+	[[NSFileManager defaultManager] removeItemAtURL:journalURL error:NULL];
+}
+
+#pragma mark - OCVFSIndex
+- (void)testVFSIndex
+{
+	OCVFSCore *vfsCore = [OCVFSCore new];
+	OCVFSIndex *index = [OCVFSIndex new];
+	OCBookmarkUUID bookmarkUUID = NSUUID.UUID;
+	OCLocation *driveRootLocation = [[OCLocation alloc] initWithBookmarkUUID:bookmarkUUID driveID:@"drive1" path:@"/"];
+	OCVFSNode *rootNode = [OCVFSNode virtualFolderAtPath:@"/" location:nil];
+	OCVFSNode *accountNode = [OCVFSNode virtualFolderInPath:@"/" withName:@"Account" location:nil];
+	OCVFSNode *driveNode = [OCVFSNode virtualFolderInPath:@"/Account/" withName:@"Drive" location:driveRootLocation];
+	OCItem *item1 = [OCItem new], *item2 = [OCItem new];
+	NSUInteger generation;
+
+	// Nodes
+	[vfsCore setNodes:@[ rootNode, accountNode, driveNode ]];
+
+	XCTAssertEqual(vfsCore.rootNode, rootNode);
+	XCTAssertEqual([vfsCore nodeAtPath:@"/Account/Drive/"], driveNode);
+	XCTAssertEqual(driveNode.parentNode, accountNode);
+	XCTAssertEqual([vfsCore driveRootNodeForLocation:driveRootLocation], driveNode);
+	XCTAssertNil([vfsCore driveRootNodeForLocation:[[OCLocation alloc] initWithBookmarkUUID:bookmarkUUID driveID:@"drive2" path:@"/"]]);
+
+	[vfsCore removeNodes:@[ driveNode ]];
+	XCTAssertNil([vfsCore nodeAtPath:@"/Account/Drive/"]);
+	XCTAssertNil([vfsCore driveRootNodeForLocation:driveRootLocation]);
+
+	// Items
+	item1.localID = @"local1";
+	item2.localID = @"local2";
+
+	generation = [index itemGenerationForBookmarkUUID:bookmarkUUID];
+	[index addItem:item1 bookmarkUUID:bookmarkUUID generation:generation];
+	[index addItem:item2 bookmarkUUID:bookmarkUUID generation:generation];
+
+	XCTAssertEqualObjects([index itemForLocalID:@"local1" bookmarkUUID:bookmarkUUID].localID, @"local1");
+	XCTAssertNil([index itemForLocalID:@"local1" bookmarkUUID:NSUUID.UUID]);
+
+	// Items are stored and returned as copies
+	XCTAssertNotEqual([index itemForLocalID:@"local1" bookmarkUUID:bookmarkUUID], item1);
+	item1.mimeType = @"text/plain";
+	[index itemForLocalID:@"local1" bookmarkUUID:bookmarkUUID].mimeType = @"image/png";
+	XCTAssertNil([index itemForLocalID:@"local1" bookmarkUUID:bookmarkUUID].mimeType);
+
+	// Changes written to the database only remove the affected items
+	OCDatabase *database = [[OCDatabase alloc] initWithURL:[NSURL fileURLWithPath:@"/dev/null"]];
+	database.bookmarkUUID = bookmarkUUID;
+
+	[NSNotificationCenter.defaultCenter postNotificationName:OCDatabaseCacheItemsChanged object:database userInfo:@{ OCDatabaseCacheItemsChangedLocalIDsKey : @[ @"local1" ] }];
+
+	XCTAssertNil([index itemForLocalID:@"local1" bookmarkUUID:bookmarkUUID]);
+	XCTAssertEqualObjects([index itemForLocalID:@"local2" bookmarkUUID:bookmarkUUID].localID, @"local2");
+
+	// Items retrieved before a change aren't added
+	[index addItem:item1 bookmarkUUID:bookmarkUUID generation:generation];
+	XCTAssertNil([index itemForLocalID:@"local1" bookmarkUUID:bookmarkUUID]);
+
+	[index invalidateItemsWithLocalIDs:nil bookmarkUUID:bookmarkUUID];
+	XCTAssertNil([index itemForLocalID:@"local2" bookmarkUUID:bookmarkUUID]);
+}
+
 @end
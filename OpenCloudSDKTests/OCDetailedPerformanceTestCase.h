@@ -7,7 +7,16 @@
 //
 
 #import <XCTest/XCTest.h>
+#import <OpenCloudSDK/OpenCloudSDK.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NSDictionary<OCMeasurementEventIdentifier, NSNumber *> *OCPerformanceBudgets; //!< Maximum durations (in seconds) by measurement event identifier
 
 @interface OCDetailedPerformanceTestCase : XCTestCase
 
+- (void)assertMeasurement:(nullable OCMeasurement *)measurement withinBudgets:(OCPerformanceBudgets)budgets; //!< Fails the test if any of the phases listed in budgets is missing from the measurement or took longer than its budget. Attaches the measurement as Chrome trace to the test results.
+
 @end
+
+NS_ASSUME_NONNULL_END
@@ -25,3 +25,45 @@
 //}
 //
 //@end
+
+@implementation OCDetailedPerformanceTestCase
+
+- (void)assertMeasurement:(OCMeasurement *)measurement withinBudgets:(OCPerformanceBudgets)budgets
+{
+	NSDictionary<OCMeasurementEventIdentifier, NSNumber *> *durationsByEventIdentifier;
+	NSData *traceData;
+
+	XCTAssertNotNil(measurement, @"No measurement available - are measurements enabled?");
+
+	if (measurement == nil)
+	{
+		return;
+	}
+
+	if ((traceData = measurement.chromeTraceEventJSONData) != nil)
+	{
+		XCTAttachment *traceAttachment = [XCTAttachment attachmentWithData:traceData uniformTypeIdentifier:@"public.json"];
+
+		traceAttachment.name = [NSString stringWithFormat:@"%@.trace.json", ((measurement.title != nil) ? measurement.title : measurement.identifier)];
+		traceAttachment.lifetime = XCTAttachmentLifetimeKeepAlways;
+
+		[self addAttachment:traceAttachment];
+	}
+
+	durationsByEventIdentifier = measurement.durationsByEventIdentifier;
+
+	for (OCMeasurementEventIdentifier eventIdentifier in budgets)
+	{
+		NSNumber *duration = durationsByEventIdentifier[eventIdentifier];
+		NSTimeInterval budget = budgets[eventIdentifier].doubleValue;
+
+		XCTAssertNotNil(duration, @"Phase %@ was not recorded", eventIdentifier);
+
+		if (duration != nil)
+		{
+			XCTAssertLessThanOrEqual(duration.doubleValue, budget, @"Phase %@ took %.3f sec, exceeding its budget of %.3f sec", eventIdentifier, duration.doubleValue, budget);
+		}
+	}
+}
+
+@end
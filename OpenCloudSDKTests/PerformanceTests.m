@@ -10,6 +10,7 @@
 #import <OpenCloudSDK/OpenCloudSDK.h>
 
 #import "OCDetailedPerformanceTestCase.h"
+#import "OCTestTarget.h"
 
 //@interface PerformanceTests : OCDetailedPerformanceTestCase
 //
@@ -36,3 +37,211 @@
 //}
 //
 //@end
+
+@interface CoreStartupPerformanceTests : OCDetailedPerformanceTestCase
+
+@end
+
+@implementation CoreStartupPerformanceTests
+
+#pragma mark - Core startup phase budgets
++ (OCPerformanceBudgets)coreStartupBudgets
+{
+	// Maximum durations (in seconds) of the core startup phases. Adjust deliberately when a phase is expected to get slower.
+	return (@{
+		@"core.start" 			: @(5.0),
+		@"core.start.queue"		: @(0.5),
+		@"core.start.vault-open"	: @(2.0),
+		@"db.open"			: @(0.5),
+		@"db.schemas"			: @(1.5),
+		@"core.start.stuck-sync-records"	: @(0.5),
+		@"core.start.sync-anchor"	: @(0.25),
+		@"core.start.drives"		: @(0.5),
+		@"core.start.sync-engine"	: @(0.5),
+		@"core.start.item-policies"	: @(0.5),
+		@"core.start.message-queue"	: @(0.5),
+		@"core.connect"			: @(15.0)
+	});
+}
+
+- (void)testMeasurementChromeTraceExport
+{
+	OCMeasurement *measurement = [OCMeasurement measurementWithTitle:@"Trace export"];
+
+	if (measurement == nil)
+	{
+		return;
+	}
+
+	OCMeasureEventBegin(measurement, @"phase", phaseRef, @"Begin");
+	OCMeasureEvent(measurement, @"marker", @"Marker");
+	OCMeasureEventEnd(measurement, @"phase", phaseRef, @"End");
+
+	NSDictionary *trace = [NSJSONSerialization JSONObjectWithData:measurement.chromeTraceEventJSONData options:0 error:NULL];
+	NSArray<NSDictionary *> *traceEvents = trace[@"traceEvents"];
+
+	XCTAssertEqual(traceEvents.count, 3); // process name metadata, marker, phase
+	XCTAssertEqualObjects(traceEvents[1][@"ph"], @"i");
+	XCTAssertEqualObjects(traceEvents[2][@"ph"], @"X");
+	XCTAssertEqualObjects(traceEvents[2][@"name"], @"phase");
+	XCTAssertGreaterThanOrEqual([traceEvents[2][@"dur"] longLongValue], 0);
+
+	XCTAssertNotNil(measurement.durationsByEventIdentifier[@"phase"]);
+	XCTAssertNil(measurement.durationsByEventIdentifier[@"marker"]);
+}
+
+- (void)testCoreStartupPhaseBudgets
+{
+	XCTestExpectation *coreStartedExpectation = [self expectationWithDescription:@"Core started"];
+	XCTestExpectation *coreRunningExpectation = [self expectationWithDescription:@"Core running"];
+	XCTestExpectation *coreStoppedExpectation = [self expectationWithDescription:@"Core stopped"];
+	OCBookmark *bookmark = [OCTestTarget userBookmark];
+	OCCore *core;
+	__block BOOL isRunning = NO;
+
+	core = [[OCCore alloc] initWithBookmark:bookmark];
+	core.automaticItemListUpdatesEnabled = NO;
+
+	core.stateChangedHandler = ^(OCCore *core) {
+		if ((core.state == OCCoreStateRunning) && !isRunning)
+		{
+			isRunning = YES;
+
+			[self assertMeasurement:core.startupMeasurement withinBudgets:CoreStartupPerformanceTests.coreStartupBudgets];
+
+			[coreRunningExpectation fulfill];
+
+			[core stopWithCompletionHandler:^(id sender, NSError *error) {
+				[core.vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+					[coreStoppedExpectation fulfill];
+				}];
+			}];
+		}
+	};
+
+	[core startWithCompletionHandler:^(OCCore *core, NSError *error) {
+		XCTAssert((error==nil), @"Started with error: %@", error);
+
+		[coreStartedExpectation fulfill];
+	}];
+
+	[self waitForExpectationsWithTimeout:60 handler:nil];
+}
+
+@end
+
+@interface VaultPrepopulationPerformanceTests : OCDetailedPerformanceTestCase
+
+@end
+
+@implementation VaultPrepopulationPerformanceTests
+
+#pragma mark - Prepopulation throughput
+- (NSURL *)writeSyntheticPropFindResponseWithFolders:(NSUInteger)folderCount filesPerFolder:(NSUInteger)fileCount basePath:(NSString *)basePath
+{
+	NSURL *responseURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSString stringWithFormat:@"syntheticPropFind-%@.xml", NSUUID.UUID.UUIDString]];
+	FILE *file;
+	NSUInteger fileID = 1;
+
+	if ((file = fopen(responseURL.fileSystemRepresentation, "w")) == NULL)
+	{
+		return (nil);
+	}
+
+	const char *base = basePath.UTF8String;
+	const char *folderProps = "<d:resourcetype><d:collection/></d:resourcetype><d:getlastmodified>Fri, 23 Nov 2018 09:43:58 GMT</d:getlastmodified>";
+	const char *fileProps = "<d:resourcetype/><d:getlastmodified>Fri, 23 Nov 2018 09:27:39 GMT</d:getlastmodified><d:getcontentlength>100</d:getcontentlength><d:getcontenttype>text/plain</d:getcontenttype>";
+
+	#define WriteResponse(pathFormat, props, ...) fprintf(file, "<d:response><d:href>%s" pathFormat "</d:href><d:propstat><d:prop>%s<d:getetag>&quot;%lu&quot;</d:getetag><oc:size>100</oc:size><oc:id>%08luocsynth</oc:id><oc:permissions>RDNVW</oc:permissions><oc:favorite>0</oc:favorite></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>\n", base, ##__VA_ARGS__, props, fileID, fileID); fileID++
+
+	fprintf(file, "<?xml version=\"1.0\"?>\n<d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\">\n");
+
+	WriteResponse("/", folderProps);
+
+	for (NSUInteger folder=0; folder < folderCount; folder++)
+	{
+		WriteResponse("/folder%lu/", folderProps, (unsigned long)folder);
+
+		for (NSUInteger fileIndex=0; fileIndex < fileCount; fileIndex++)
+		{
+			WriteResponse("/folder%lu/file%lu.txt", fileProps, (unsigned long)folder, (unsigned long)fileIndex);
+		}
+	}
+
+	#undef WriteResponse
+
+	fprintf(file, "</d:multistatus>\n");
+	fclose(file);
+
+	return (responseURL);
+}
+
+- (void)testPrepopulationThroughputWithOneMillionItems
+{
+	XCTestExpectation *expectPrepopulation = [self expectationWithDescription:@"Prepopulation done"];
+	XCTestExpectation *expectErase = [self expectationWithDescription:@"Vault erased"];
+	NSString *basePath = @"/remote.php/dav/files/admin";
+	OCVault *vault = [[OCVault alloc] initWithBookmark:[OCBookmark bookmarkForURL:OCTestTarget.secureTargetURL]];
+	OCDAVRawResponse *rawResponse = [OCDAVRawResponse new];
+	NSUInteger expectedItemCount = 1 + 1000 + (1000 * 999);
+
+	rawResponse.basePath = basePath;
+	rawResponse.responseDataURL = [self writeSyntheticPropFindResponseWithFolders:1000 filesPerFolder:999 basePath:basePath];
+
+	XCTAssertNotNil(rawResponse.responseDataURL);
+
+	NSString *indexListQuery = @"SELECT GROUP_CONCAT(name || ': ' || sql, '\n') AS indexes FROM (SELECT name, sql FROM sqlite_master WHERE type='index' AND tbl_name='metaData' AND sql IS NOT NULL ORDER BY name)";
+	__block NSString *indexesBeforeLoad = nil;
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssertNil(error);
+
+		// Remember the indexes before the load, which defers them
+		OCSyncExec(waitForIndexes, {
+			[vault.database.sqlDB executeQuery:[OCSQLiteQuery query:indexListQuery resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+				indexesBeforeLoad = (NSString *)[resultSet nextRowDictionaryWithError:NULL][@"indexes"];
+				OCSyncExecDone(waitForIndexes);
+			}]];
+		});
+
+		XCTAssertGreaterThan(indexesBeforeLoad.length, 0);
+
+		NSTimeInterval startTime = NSDate.timeIntervalSinceReferenceDate;
+
+		[vault prepopulateDatabaseWithRawResponse:rawResponse progressHandler:nil completionHandler:^(NSError * _Nullable error) {
+			NSTimeInterval duration = NSDate.timeIntervalSinceReferenceDate - startTime;
+			NSString *throughput = [NSString stringWithFormat:@"%lu rows in %.2f sec: %.0f rows/sec", (unsigned long)expectedItemCount, duration, (expectedItemCount / duration)];
+
+			XCTAssertNil(error);
+
+			OCLog(@"Prepopulation throughput: %@", throughput);
+
+			XCTAttachment *attachment = [XCTAttachment attachmentWithString:throughput];
+			attachment.name = @"Prepopulation throughput";
+			attachment.lifetime = XCTAttachmentLifetimeKeepAlways;
+			[self addAttachment:attachment];
+
+			// Verify all rows were inserted and exactly the indexes from before the load were restored
+			[vault.database.sqlDB executeQuery:[OCSQLiteQuery query:[NSString stringWithFormat:@"SELECT (SELECT COUNT(*) FROM metaData) AS rowCount, (%@) AS indexes, (SELECT COUNT(*) FROM sqlite_master WHERE type='table' AND name='deferredIndexes') AS deferredIndexesTableCount", indexListQuery] resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+				NSDictionary<NSString *, id<NSObject>> *rowDictionary = [resultSet nextRowDictionaryWithError:NULL];
+
+				XCTAssertEqualObjects(rowDictionary[@"rowCount"], @(expectedItemCount));
+				XCTAssertEqualObjects(rowDictionary[@"indexes"], indexesBeforeLoad);
+				XCTAssertEqualObjects(rowDictionary[@"deferredIndexesTableCount"], @(0));
+
+				[expectPrepopulation fulfill];
+
+				[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+					[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+						[NSFileManager.defaultManager removeItemAtURL:rawResponse.responseDataURL error:NULL];
+						[expectErase fulfill];
+					}];
+				}];
+			}]];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:600 handler:nil];
+}
+
+@end
@@ -649,6 +649,315 @@
 	});
 }
 
+- (void)testSQLiteOnlineTableUpgrade
+{
+	XCTestExpectation *expectSchemaCallback1 = [self expectationWithDescription:@"Expect receiving schema callback 1"];
+	XCTestExpectation *expectSchemaCallback2 = [self expectationWithDescription:@"Expect receiving schema callback 2"];
+	XCTestExpectation *expectOnlineMigrationCompletion = [self expectationWithDescription:@"Expect online migration to complete"];
+	XCTestExpectation *expectMatchingContent = [self expectationWithDescription:@"Expect content to match"];
+	OCSQLiteDB *sqlDB;
+
+	if ((sqlDB = [OCSQLiteDB new]) != nil)
+	{
+		// Version 1
+		[sqlDB addTableSchema:[OCSQLiteTableSchema schemaWithTableName:@"products" version:1 creationQueries:@[@"CREATE TABLE IF NOT EXISTS products (productID integer PRIMARY KEY, name TEXT NOT NULL)"] openStatements:nil upgradeMigrator:nil]];
+
+		[sqlDB openWithFlags:OCSQLiteOpenFlagsDefault completionHandler:^(OCSQLiteDB *db, NSError *error) {
+			[sqlDB applyTableSchemasWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+				XCTAssert((error==nil), @"Creation succeeded without errors");
+				[expectSchemaCallback1 fulfill];
+
+				// Add 1000 rows
+				[db executeQuery:[OCSQLiteQuery query:@"WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n+1 FROM seq WHERE n < 1000) INSERT INTO products (productID, name) SELECT n, 'Product ' || n FROM seq" resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+					XCTAssert((error==nil), @"Rows inserted without errors");
+				}]];
+
+				// Version 2, migrated online in batches of 100 rows
+				OCSQLiteTableSchema *schemaV2 = [OCSQLiteTableSchema schemaWithTableName:@"products" version:2 creationQueries:@[@"CREATE TABLE IF NOT EXISTS products (productID integer PRIMARY KEY, name TEXT NOT NULL, version TEXT)"] openStatements:nil upgradeMigrator:^(OCSQLiteDB *db, OCSQLiteTableSchema *schema, void (^completionHandler)(NSError *error)) {
+					XCTFail(@"Upgrade migrator shouldn't be called for schemas with an online migration");
+					completionHandler(nil);
+				}];
+
+				schemaV2.onlineMigration = [OCSQLiteOnlineMigration migrationToTable:@"products_v2" keyColumn:@"productID" creationQueries:@[@"CREATE TABLE products_v2 (productID integer PRIMARY KEY, name TEXT NOT NULL, version TEXT)"] columns:@[@"productID", @"name", @"version"] fromExpressions:@[@"productID", @"name", @"'1.0'"] cutOverQueries:nil];
+				schemaV2.onlineMigration.batchSize = 100;
+
+				// Modify rows while the migration is running, right after the first batch
+				schemaV2.onlineMigration.batchHandler = ^NSError *(OCSQLiteDB *db, NSNumber *highWaterMark) {
+					if ([highWaterMark isEqual:@(100)])
+					{
+						[db executeQuery:[OCSQLiteQuery query:@"UPDATE products SET name='Renamed' WHERE productID=1" resultHandler:nil]]; // already copied
+						[db executeQuery:[OCSQLiteQuery query:@"DELETE FROM products WHERE productID=2" resultHandler:nil]]; // already copied
+						[db executeQuery:[OCSQLiteQuery query:@"INSERT INTO products (productID, name) VALUES (1001, 'Added')" resultHandler:nil]]; // not yet copied
+					}
+
+					return (nil);
+				};
+
+				[sqlDB addTableSchema:schemaV2];
+
+				sqlDB.onlineMigrationsCompletionHandler = ^(OCSQLiteDB *db, NSError *error) {
+					XCTAssert((error==nil), @"Online migration succeeded without errors");
+					[expectOnlineMigrationCompletion fulfill];
+
+					// Verify content and version
+					[db executeQuery:[OCSQLiteQuery query:@"SELECT (SELECT COUNT(*) FROM products) AS rowCount, (SELECT COUNT(*) FROM products WHERE version='1.0') AS versionCount, (SELECT name FROM products WHERE productID=1) AS name1, (SELECT COUNT(*) FROM products WHERE productID=2) AS count2, (SELECT version FROM tableSchemas WHERE tableName='products') AS schemaVersion, (SELECT COUNT(*) FROM onlineMigrations) AS migrationCount" resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+						NSDictionary<NSString *, id<NSObject>> *rowDictionary = [resultSet nextRowDictionaryWithError:NULL];
+
+						OCLog(@"%@", rowDictionary);
+
+						if ([rowDictionary[@"rowCount"] isEqual:@(1000)] &&
+						    [rowDictionary[@"versionCount"] isEqual:@(1000)] &&
+						    [rowDictionary[@"name1"] isEqual:@"Renamed"] &&
+						    [rowDictionary[@"count2"] isEqual:@(0)] &&
+						    [rowDictionary[@"schemaVersion"] isEqual:@(2)] &&
+						    [rowDictionary[@"migrationCount"] isEqual:@(0)])
+						{
+							[expectMatchingContent fulfill];
+						}
+					}]];
+				};
+
+				[sqlDB applyTableSchemasWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+					XCTAssert((error==nil), @"Schemas applied without errors");
+					[expectSchemaCallback2 fulfill];
+				}];
+			}];
+		}];
+	}
+
+	[self waitForExpectationsWithTimeout:10 handler:NULL];
+
+	OCSyncExec(waitSQL, {
+		[sqlDB closeWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+			OCSyncExecDone(waitSQL);
+		}];
+	});
+}
+
+- (void)testSQLiteOnlineTableUpgradeResume
+{
+	NSURL *dbURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID.UUID.UUIDString stringByAppendingPathExtension:@"sqlite"]];
+	__block NSUInteger batchCount = 0;
+	__block NSNumber *firstResumedHighWaterMark = nil;
+	__block NSError *migrationError = nil;
+	NSDictionary<NSString *, id<NSObject>> *rowDictionary;
+	OCSQLiteDB *sqlDB;
+
+	OCSQLiteTableSchema *(^MakeSchemaV1)(void) = ^{
+		return ([OCSQLiteTableSchema schemaWithTableName:@"products" version:1 creationQueries:@[@"CREATE TABLE IF NOT EXISTS products (productID integer PRIMARY KEY, name TEXT NOT NULL)"] openStatements:nil upgradeMigrator:nil]);
+	};
+
+	OCSQLiteTableSchema *(^MakeSchemaV2)(OCSQLiteOnlineMigrationBatchHandler batchHandler) = ^(OCSQLiteOnlineMigrationBatchHandler batchHandler) {
+		OCSQLiteTableSchema *schemaV2 = [OCSQLiteTableSchema schemaWithTableName:@"products" version:2 creationQueries:@[@"CREATE TABLE IF NOT EXISTS products (productID integer PRIMARY KEY, name TEXT NOT NULL, version TEXT)"] openStatements:nil upgradeMigrator:nil];
+
+		schemaV2.onlineMigration = [OCSQLiteOnlineMigration migrationToTable:@"products_v2" keyColumn:@"productID" creationQueries:@[@"CREATE TABLE products_v2 (productID integer PRIMARY KEY, name TEXT NOT NULL, version TEXT)"] columns:@[@"productID", @"name", @"version"] fromExpressions:@[@"productID", @"name", @"'1.0'"] cutOverQueries:nil];
+		schemaV2.onlineMigration.batchSize = 100;
+		schemaV2.onlineMigration.batchHandler = batchHandler;
+
+		return (schemaV2);
+	};
+
+	NSError *(^OpenAndApplySchemas)(OCSQLiteDB *db) = ^(OCSQLiteDB *db) {
+		__block NSError *openError = nil;
+
+		OCSyncExec(waitOpen, {
+			[db openWithFlags:OCSQLiteOpenFlagsDefault completionHandler:^(OCSQLiteDB *db, NSError *error) {
+				openError = error;
+
+				[db applyTableSchemasWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+					if (openError == nil) { openError = error; }
+					OCSyncExecDone(waitOpen);
+				}];
+			}];
+		});
+
+		return (openError);
+	};
+
+	NSDictionary<NSString *, id<NSObject>> *(^QueryRow)(OCSQLiteDB *db, NSString *sqlQuery) = ^(OCSQLiteDB *db, NSString *sqlQuery) {
+		__block NSDictionary<NSString *, id<NSObject>> *row = nil;
+
+		OCSyncExec(waitQuery, {
+			[db executeQuery:[OCSQLiteQuery query:sqlQuery resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+				XCTAssertNil(error);
+				row = [resultSet nextRowDictionaryWithError:NULL];
+				OCSyncExecDone(waitQuery);
+			}]];
+		});
+
+		OCLog(@"%@", row);
+
+		return (row);
+	};
+
+	void (^CloseDB)(OCSQLiteDB *db) = ^(OCSQLiteDB *db) {
+		OCSyncExec(waitClose, {
+			[db closeWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+				OCSyncExecDone(waitClose);
+			}];
+		});
+	};
+
+	// Version 1 with 1000 rows
+	sqlDB = [[OCSQLiteDB alloc] initWithURL:dbURL];
+	[sqlDB addTableSchema:MakeSchemaV1()];
+
+	XCTAssertNil(OpenAndApplySchemas(sqlDB));
+
+	QueryRow(sqlDB, @"WITH RECURSIVE seq(n) AS (SELECT 1 UNION ALL SELECT n+1 FROM seq WHERE n < 1000) INSERT INTO products (productID, name) SELECT n, 'Product ' || n FROM seq");
+
+	CloseDB(sqlDB);
+
+	// Version 2: modify rows after the first batch and stop the migration after the third batch
+	XCTestExpectation *expectMigrationInterruption = [self expectationWithDescription:@"Expect online migration to be interrupted"];
+
+	sqlDB = [[OCSQLiteDB alloc] initWithURL:dbURL];
+	[sqlDB addTableSchema:MakeSchemaV1()];
+	[sqlDB addTableSchema:MakeSchemaV2(^NSError *(OCSQLiteDB *db, NSNumber *highWaterMark) {
+		batchCount++;
+
+		if ([highWaterMark isEqual:@(100)])
+		{
+			[db executeQuery:[OCSQLiteQuery query:@"UPDATE products SET name='Renamed' WHERE productID=1" resultHandler:nil]]; // already copied
+			[db executeQuery:[OCSQLiteQuery query:@"DELETE FROM products WHERE productID=2" resultHandler:nil]]; // already copied
+			[db executeQuery:[OCSQLiteQuery query:@"UPDATE products SET name='Changed' WHERE productID=500" resultHandler:nil]]; // not yet copied
+			[db executeQuery:[OCSQLiteQuery query:@"INSERT INTO products (productID, name) VALUES (1001, 'Added')" resultHandler:nil]]; // not yet copied
+		}
+
+		if (batchCount == 3)
+		{
+			return (OCError(OCErrorCancelled));
+		}
+
+		return (nil);
+	})];
+
+	sqlDB.onlineMigrationsCompletionHandler = ^(OCSQLiteDB *db, NSError *error) {
+		migrationError = error;
+		[expectMigrationInterruption fulfill];
+	};
+
+	XCTAssertNil(OpenAndApplySchemas(sqlDB));
+
+	[self waitForExpectations:@[ expectMigrationInterruption ] timeout:10];
+
+	XCTAssert([migrationError isOCErrorWithCode:OCErrorCancelled]);
+
+	// Committed state: three batches copied, two copied rows changed afterwards, table still at version 1
+	rowDictionary = QueryRow(sqlDB, @"SELECT (SELECT highWaterMark FROM onlineMigrations WHERE tableName='products') AS highWaterMark, (SELECT COUNT(*) FROM onlineMigrationDirtyRows) AS dirtyCount, (SELECT COUNT(*) FROM products_v2) AS copiedCount, (SELECT version FROM tableSchemas WHERE tableName='products') AS schemaVersion");
+
+	XCTAssertEqualObjects(rowDictionary[@"highWaterMark"], @(300));
+	XCTAssertEqualObjects(rowDictionary[@"dirtyCount"], @(2));
+	XCTAssertEqualObjects(rowDictionary[@"copiedCount"], @(300));
+	XCTAssertEqualObjects(rowDictionary[@"schemaVersion"], @(1));
+
+	CloseDB(sqlDB);
+
+	// Reopen: the migration resumes above the high-water mark and re-copies the changed rows
+	XCTestExpectation *expectMigrationCompletion = [self expectationWithDescription:@"Expect online migration to complete"];
+
+	migrationError = nil;
+
+	sqlDB = [[OCSQLiteDB alloc] initWithURL:dbURL];
+	[sqlDB addTableSchema:MakeSchemaV1()];
+	[sqlDB addTableSchema:MakeSchemaV2(^NSError *(OCSQLiteDB *db, NSNumber *highWaterMark) {
+		if (firstResumedHighWaterMark == nil)
+		{
+			firstResumedHighWaterMark = highWaterMark;
+		}
+
+		return (nil);
+	})];
+
+	sqlDB.onlineMigrationsCompletionHandler = ^(OCSQLiteDB *db, NSError *error) {
+		migrationError = error;
+		[expectMigrationCompletion fulfill];
+	};
+
+	XCTAssertNil(OpenAndApplySchemas(sqlDB));
+
+	[self waitForExpectations:@[ expectMigrationCompletion ] timeout:10];
+
+	XCTAssertNil(migrationError);
+	XCTAssertEqualObjects(firstResumedHighWaterMark, @(400));
+
+	rowDictionary = QueryRow(sqlDB, @"SELECT (SELECT COUNT(*) FROM products) AS rowCount, (SELECT COUNT(*) FROM products WHERE version='1.0') AS versionCount, (SELECT name FROM products WHERE productID=1) AS name1, (SELECT COUNT(*) FROM products WHERE productID=2) AS count2, (SELECT name FROM products WHERE productID=500) AS name500, (SELECT name FROM products WHERE productID=1001) AS name1001, (SELECT version FROM tableSchemas WHERE tableName='products') AS schemaVersion, (SELECT COUNT(*) FROM onlineMigrations) AS migrationCount, (SELECT COUNT(*) FROM onlineMigrationDirtyRows) AS dirtyCount");
+
+	XCTAssertEqualObjects(rowDictionary[@"rowCount"], @(1000));
+	XCTAssertEqualObjects(rowDictionary[@"versionCount"], @(1000));
+	XCTAssertEqualObjects(rowDictionary[@"name1"], @"Renamed");
+	XCTAssertEqualObjects(rowDictionary[@"count2"], @(0));
+	XCTAssertEqualObjects(rowDictionary[@"name500"], @"Changed");
+	XCTAssertEqualObjects(rowDictionary[@"name1001"], @"Added");
+	XCTAssertEqualObjects(rowDictionary[@"schemaVersion"], @(2));
+	XCTAssertEqualObjects(rowDictionary[@"migrationCount"], @(0));
+	XCTAssertEqualObjects(rowDictionary[@"dirtyCount"], @(0));
+
+	CloseDB(sqlDB);
+
+	[[NSFileManager defaultManager] removeItemAtURL:dbURL error:NULL];
+}
+
+- (void)testSQLiteDeferredIndexRestoreSkipsExistingIndexes
+{
+	OCSQLiteDB *sqlDB = [OCSQLiteDB new];
+	NSString *indexListQuery = @"SELECT GROUP_CONCAT(name, ',') AS indexes FROM (SELECT name FROM sqlite_master WHERE type='index' AND tbl_name='products' ORDER BY name)";
+	__block NSString *indexesBeforeDeferral = nil, *indexesAfterRestore = nil;
+	__block NSNumber *deferredIndexesTableCount = nil;
+	__block NSError *restoreError = nil;
+
+	[sqlDB addTableSchema:[OCSQLiteTableSchema schemaWithTableName:@"products" version:1 creationQueries:@[
+		@"CREATE TABLE IF NOT EXISTS products (productID integer PRIMARY KEY, name TEXT NOT NULL, vendor TEXT)",
+		@"CREATE INDEX IF NOT EXISTS idx_products_name ON products (name)",
+		@"CREATE INDEX IF NOT EXISTS idx_products_vendor ON products (vendor)"
+	] openStatements:nil upgradeMigrator:nil]];
+
+	OCSyncExec(waitForRestore, {
+		[sqlDB openWithFlags:OCSQLiteOpenFlagsDefault completionHandler:^(OCSQLiteDB *db, NSError *error) {
+			[db applyTableSchemasWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+				XCTAssertNil(error);
+
+				[db executeQuery:[OCSQLiteQuery query:indexListQuery resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+					indexesBeforeDeferral = (NSString *)[resultSet nextRowDictionaryWithError:NULL][@"indexes"];
+				}]];
+
+				[db deferIndexesOfTable:@"products" completionHandler:^(OCSQLiteDB *db, NSError *error) {
+					XCTAssertNil(error);
+
+					// Re-create one of the deferred indexes before the restore
+					[db executeQuery:[OCSQLiteQuery query:@"CREATE INDEX IF NOT EXISTS idx_products_name ON products (name)" resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+						XCTAssertNil(error);
+					}]];
+
+					[db restoreDeferredIndexesWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+						restoreError = error;
+
+						[db executeQuery:[OCSQLiteQuery query:[NSString stringWithFormat:@"SELECT (%@) AS indexes, (SELECT COUNT(*) FROM sqlite_master WHERE type='table' AND name='deferredIndexes') AS deferredIndexesTableCount", indexListQuery] resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+							NSDictionary<NSString *, id<NSObject>> *rowDictionary = [resultSet nextRowDictionaryWithError:NULL];
+
+							indexesAfterRestore = (NSString *)rowDictionary[@"indexes"];
+							deferredIndexesTableCount = (NSNumber *)rowDictionary[@"deferredIndexesTableCount"];
+
+							OCSyncExecDone(waitForRestore);
+						}]];
+					}];
+				}];
+			}];
+		}];
+	});
+
+	XCTAssertNil(restoreError);
+	XCTAssertEqualObjects(indexesBeforeDeferral, @"idx_products_name,idx_products_vendor");
+	XCTAssertEqualObjects(indexesAfterRestore, indexesBeforeDeferral);
+	XCTAssertEqualObjects(deferredIndexesTableCount, @(0));
+
+	OCSyncExec(waitSQL, {
+		[sqlDB closeWithCompletionHandler:^(OCSQLiteDB *db, NSError *error) {
+			OCSyncExecDone(waitSQL);
+		}];
+	});
+}
+
 - (void)testSQLiteTableCreation
 {
 	XCTestExpectation *expectSchemaCallback1 = [self expectationWithDescription:@"Expect receiving schema callback 1"];